@@ -77,6 +77,7 @@ LOCAL const struct
   {"link",     ARCHIVE_ENTRY_TYPE_LINK     },
   {"hardlink", ARCHIVE_ENTRY_TYPE_HARDLINK },
   {"special",  ARCHIVE_ENTRY_TYPE_SPECIAL  },
+  {"solid",    ARCHIVE_ENTRY_TYPE_SOLID    },
 
   {"meta",     ARCHIVE_ENTRY_TYPE_META     },
   {"salt",     ARCHIVE_ENTRY_TYPE_SALT     },
@@ -95,12 +96,42 @@ LOCAL const struct
 // default alignment
 #define DEFAULT_ALIGNMENT 4
 
+/* size of buffer for streaming archive files directly into storage or
+   into signed temporary archive files and size of data kept in buffer
+   when storing
+   Note: chunk headers of entries written directly into the archive
+         (directory, link, special) are updated inside the kept data
+*/
+#define STREAM_BUFFER_SIZE (4*1024*1024)
+#define STREAM_KEEP_SIZE   (1024*1024)
+
 // used message authentication code algorithm for signatures (currently fixed)
 #define SIGNATURE_HASH_ALGORITHM CRYPT_HASH_ALGORITHM_SHA2_512
 
 // max. size of hash value
 #define MAX_HASH_SIZE 1024
 
+/* size of read data kept without updating signature hash
+   Note: the signature chunk is read before the signature hash of the
+         data in front of it is calculated
+*/
+#define SIGNATURE_HASH_KEEP_SIZE (4*1024)
+/* max. size of skipped data which is read to continue signature hash
+   Note: e. g. unread parts of chunks; larger skipped data is read when
+         the signature is checked
+*/
+#define SIGNATURE_HASH_MAX_SKIP_SIZE (64*1024)
+
+// size of data blocks and max. number of queued data blocks of signature hash thread
+#define SIGNATURE_HASH_BLOCK_SIZE (1024*1024)
+#define MAX_SIGNATURE_HASH_MSGS   8
+
+/* max. number of table of contents entries of an archive file
+   Note: the table of contents is collected in memory; no table of
+         contents is written for archive files with more entries
+*/
+#define MAX_TOC_ENTRIES (256*1024)
+
 static inline Errors ChunkIOFile_seek(uint64 offset, void *userData)
 {
   return File_seek((FileHandle*)userData,offset);
@@ -210,6 +241,7 @@ typedef struct ArchiveIndexNode
   LIST_NODE_HEADER(struct ArchiveIndexNode);
 
   ArchiveEntryTypes type;
+  uint64            archiveOffset;  // offset of entry chunks in archive [bytes]
   union
   {
     struct
@@ -284,6 +316,26 @@ typedef struct ArchiveIndexNode
   };
 } ArchiveIndexNode;
 
+// solid block member
+typedef struct ArchiveSolidMemberNode
+{
+  LIST_NODE_HEADER(struct ArchiveSolidMemberNode);
+
+  String                    name;
+  FileInfo                  fileInfo;
+  FileExtendedAttributeList fileExtendedAttributeList;
+  uint64                    offset;                                    // offset of data in solid block [bytes]
+  uint64                    size;                                      // size of data [bytes]
+  uint64                    chunkOffset;                               // offset of file chunk behind solid block [bytes]
+} ArchiveSolidMemberNode;
+
+// signature hash message, send to signature hash thread
+typedef struct
+{
+  byte  *data;                                                         // data block
+  ulong length;                                                        // length of data [bytes]
+} SignatureHashMsg;
+
 /***************************** Variables *******************************/
 
 // list with all known decryption passwords
@@ -1440,6 +1492,266 @@ LOCAL void findNextArchivePart(ArchiveHandle *archiveHandle)
   }
 }
 
+/***********************************************************************\
+* Name   : flushArchiveStream
+* Purpose: store buffered data of archive stream
+* Input  : archiveStream - archive stream
+*          keepLength    - number of bytes to keep in buffer
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : stored data is added to signature hash; kept data at the end
+*          of the buffer can still be modified
+\***********************************************************************/
+
+LOCAL Errors flushArchiveStream(ArchiveStream *archiveStream, ulong keepLength)
+{
+  Errors error;
+
+  assert(archiveStream != NULL);
+  assert(archiveStream->buffer != NULL);
+
+  if (archiveStream->bufferLength > keepLength)
+  {
+    ulong n = archiveStream->bufferLength-keepLength;
+
+    // store data
+    if (archiveStream->fileHandle != NULL)
+    {
+      error = File_write(archiveStream->fileHandle,archiveStream->buffer,n);
+    }
+    else
+    {
+      error = Storage_write(&archiveStream->storageHandle,archiveStream->buffer,n);
+    }
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    if (archiveStream->signatureHashFlag)
+    {
+      Crypt_updateHash(&archiveStream->signatureHash,archiveStream->buffer,n);
+    }
+    if (archiveStream->fileHandle == NULL)
+    {
+      (void)atomicIncrement64(&archiveStream->storageHandle.storageInfo->progress.storageDoneBytes,(int)n);
+    }
+
+    // keep rest of data
+    memmove(archiveStream->buffer,archiveStream->buffer+n,keepLength);
+    archiveStream->bufferOffset += (uint64)n;
+    archiveStream->bufferLength = keepLength;
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : ChunkIOStream_eof
+* Purpose: check end of archive stream
+* Input  : userData - archive stream
+* Output : -
+* Return : TRUE iff end of archive stream
+* Notes  : -
+\***********************************************************************/
+
+LOCAL bool ChunkIOStream_eof(void *userData)
+{
+  const ArchiveStream *archiveStream = (const ArchiveStream*)userData;
+  assert(archiveStream != NULL);
+
+  return archiveStream->offset >= (archiveStream->bufferOffset+archiveStream->bufferLength);
+}
+
+/***********************************************************************\
+* Name   : ChunkIOStream_read
+* Purpose: read buffered data from archive stream
+* Input  : userData - archive stream
+*          length   - number of bytes to read
+* Output : buffer    - data
+*          bytesRead - number of read bytes (can be NULL)
+* Return : ERROR_NONE or error code
+* Notes  : only data which is not stored yet can be read
+\***********************************************************************/
+
+LOCAL Errors ChunkIOStream_read(void *userData, void *buffer, ulong length, ulong *bytesRead)
+{
+  ArchiveStream *archiveStream = (ArchiveStream*)userData;
+  assert(archiveStream != NULL);
+  assert(archiveStream->offset >= archiveStream->bufferOffset);
+  assert(buffer != NULL);
+
+  ulong index = (ulong)(archiveStream->offset-archiveStream->bufferOffset);
+  if ((index+length) > archiveStream->bufferLength)
+  {
+    return ERROR_FUNCTION_NOT_SUPPORTED;
+  }
+
+  memcpy(buffer,archiveStream->buffer+index,length);
+  archiveStream->offset += (uint64)length;
+  if (bytesRead != NULL) (*bytesRead) = length;
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : ChunkIOStream_write
+* Purpose: write data to archive stream
+* Input  : userData - archive stream
+*          buffer   - data
+*          length   - length of data [bytes]
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : data is stored when the buffer is full
+\***********************************************************************/
+
+LOCAL Errors ChunkIOStream_write(void *userData, const void *buffer, ulong length)
+{
+  Errors error;
+
+  ArchiveStream *archiveStream = (ArchiveStream*)userData;
+  assert(archiveStream != NULL);
+  assert(archiveStream->offset >= archiveStream->bufferOffset);
+  assert(buffer != NULL);
+
+  const byte *data = (const byte*)buffer;
+  while (length > 0L)
+  {
+    // store data if buffer is full
+    if ((archiveStream->offset-archiveStream->bufferOffset) >= (uint64)archiveStream->bufferSize)
+    {
+      assert(archiveStream->bufferLength == archiveStream->bufferSize);
+
+      error = flushArchiveStream(archiveStream,STREAM_KEEP_SIZE);
+      if (error != ERROR_NONE)
+      {
+        return error;
+      }
+    }
+
+    // copy data into buffer
+    ulong index = (ulong)(archiveStream->offset-archiveStream->bufferOffset);
+    ulong n     = MIN(length,archiveStream->bufferSize-index);
+    memcpy(archiveStream->buffer+index,data,n);
+    archiveStream->offset += (uint64)n;
+    if ((index+n) > archiveStream->bufferLength) archiveStream->bufferLength = index+n;
+
+    data   += n;
+    length -= n;
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : ChunkIOStream_tell
+* Purpose: get current offset in archive stream
+* Input  : userData - archive stream
+* Output : offset - offset
+* Return : ERROR_NONE
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors ChunkIOStream_tell(void *userData, uint64 *offset)
+{
+  const ArchiveStream *archiveStream = (const ArchiveStream*)userData;
+  assert(archiveStream != NULL);
+  assert(offset != NULL);
+
+  (*offset) = archiveStream->offset;
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : ChunkIOStream_seek
+* Purpose: seek in archive stream
+* Input  : userData - archive stream
+*          offset   - offset
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : only data which is not stored yet can be reached
+\***********************************************************************/
+
+LOCAL Errors ChunkIOStream_seek(void *userData, uint64 offset)
+{
+  ArchiveStream *archiveStream = (ArchiveStream*)userData;
+  assert(archiveStream != NULL);
+
+  if (   (offset < archiveStream->bufferOffset)
+      || (offset > (archiveStream->bufferOffset+archiveStream->bufferLength))
+     )
+  {
+    return ERROR_FUNCTION_NOT_SUPPORTED;
+  }
+
+  archiveStream->offset = offset;
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : ChunkIOStream_getSize
+* Purpose: get size of archive stream
+* Input  : userData - archive stream
+* Output : -
+* Return : size of stored and buffered data [bytes]
+* Notes  : -
+\***********************************************************************/
+
+LOCAL int64 ChunkIOStream_getSize(void *userData)
+{
+  const ArchiveStream *archiveStream = (const ArchiveStream*)userData;
+  assert(archiveStream != NULL);
+
+  return (int64)(archiveStream->bufferOffset+archiveStream->bufferLength);
+}
+
+// i/o via archive stream
+LOCAL const ChunkIO CHUNK_IO_STREAM =
+{
+  ChunkIOStream_eof,
+  ChunkIOStream_read,
+  ChunkIOStream_write,
+  ChunkIOStream_tell,
+  ChunkIOStream_seek,
+  ChunkIOStream_getSize
+};
+
+/***********************************************************************\
+* Name   : closeArchiveStream
+* Purpose: close storage or temporary file of archive stream
+* Input  : archiveHandle - archive handle
+*          deleteFlag    - TRUE to delete incomplete archive file in
+*                          storage
+* Output : -
+* Return : -
+* Notes  : a temporary file is only closed
+\***********************************************************************/
+
+LOCAL void closeArchiveStream(ArchiveHandle *archiveHandle, bool deleteFlag)
+{
+  assert(archiveHandle != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_CREATE);
+  assert(archiveHandle->chunkIO == &CHUNK_IO_STREAM);
+
+  if (archiveHandle->create.stream.fileHandle != NULL)
+  {
+    (void)File_close(archiveHandle->create.stream.fileHandle);
+  }
+  else
+  {
+    Storage_close(&archiveHandle->create.stream.storageHandle);
+    if (deleteFlag)
+    {
+      (void)Storage_delete(archiveHandle->storageInfo,archiveHandle->create.stream.archiveName);
+    }
+  }
+  if (archiveHandle->create.stream.signatureHashFlag)
+  {
+    Crypt_doneHash(&archiveHandle->create.stream.signatureHash);
+  }
+}
+
 // ----------------------------------------------------------------------
 
 /***********************************************************************\
@@ -1536,2518 +1848,4467 @@ LOCAL Errors calculateHash(const ChunkIO *chunkIO,
   #undef BUFFER_SIZE
 }
 
-// ----------------------------------------------------------------------
-
 /***********************************************************************\
-* Name   : freeArchiveIndexNode
-* Purpose: free archive index node
-* Input  : archiveIndexNode - archive index node
+* Name   : freeSignatureHashMsg
+* Purpose: free signature hash message
+* Input  : signatureHashMsg - signature hash message
 *          userData         - user data (not used)
 * Output : -
 * Return : -
 * Notes  : -
 \***********************************************************************/
 
-LOCAL void freeArchiveIndexNode(ArchiveIndexNode *archiveIndexNode, void *userData)
+LOCAL void freeSignatureHashMsg(SignatureHashMsg *signatureHashMsg, void *userData)
 {
-  assert(archiveIndexNode != NULL);
+  assert(signatureHashMsg != NULL);
 
   UNUSED_VARIABLE(userData);
 
-  switch (archiveIndexNode->type)
+  free(signatureHashMsg->data);
+}
+
+/***********************************************************************\
+* Name   : signatureHashThreadCode
+* Purpose: signature hash thread: hash read data blocks in-order
+* Input  : archiveHandle - archive handle
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void signatureHashThreadCode(ArchiveHandle *archiveHandle)
+{
+  assert(archiveHandle != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_READ);
+
+  SignatureHashMsg signatureHashMsg;
+  while (MsgQueue_get(&archiveHandle->read.signatureHashMsgQueue,&signatureHashMsg,NULL,sizeof(signatureHashMsg),WAIT_FOREVER))
   {
-    case ARCHIVE_ENTRY_TYPE_NONE:
-      break;
-    case ARCHIVE_ENTRY_TYPE_FILE:
-      String_delete(archiveIndexNode->file.name);
-      break;
-    case ARCHIVE_ENTRY_TYPE_IMAGE:
-      String_delete(archiveIndexNode->image.name);
-      break;
-    case ARCHIVE_ENTRY_TYPE_DIRECTORY:
-      String_delete(archiveIndexNode->directory.name);
-      break;
-    case ARCHIVE_ENTRY_TYPE_LINK:
-      String_delete(archiveIndexNode->link.destinationName);
-      String_delete(archiveIndexNode->link.name);
-      break;
-    case ARCHIVE_ENTRY_TYPE_HARDLINK:
-      String_delete(archiveIndexNode->hardlink.name);
-      break;
-    case ARCHIVE_ENTRY_TYPE_SPECIAL:
-      String_delete(archiveIndexNode->special.name);
-      break;
-    case ARCHIVE_ENTRY_TYPE_META:
-      HALT_INTERNAL_ERROR("wrong archive index node type");
-      break;
-    case ARCHIVE_ENTRY_TYPE_SIGNATURE:
-      break;
-    default:
-      #ifndef NDEBUG
-        HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
-      #endif /* NDEBUG */
-      break; /* not reached */
+    Crypt_updateHash(&archiveHandle->read.signatureHash,signatureHashMsg.data,signatureHashMsg.length);
+
+    SEMAPHORE_LOCKED_DO(&archiveHandle->read.signatureHashLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+    {
+      archiveHandle->read.signatureHashDoneBytes += (uint64)signatureHashMsg.length;
+      Semaphore_signalModified(&archiveHandle->read.signatureHashLock,SEMAPHORE_SIGNAL_MODIFY_ALL);
+    }
+
+    freeSignatureHashMsg(&signatureHashMsg,NULL);
   }
 }
 
 /***********************************************************************\
-* Name   : deleteArchiveIndexNode
-* Purpose: delete archive index node
-* Input  : archiveIndexNode - archive index node to delete
+* Name   : initSignatureHashThread
+* Purpose: start signature hash thread
+* Input  : archiveHandle - archive handle
 * Output : -
 * Return : -
 * Notes  : -
 \***********************************************************************/
 
-LOCAL void deleteArchiveIndexNode(ArchiveIndexNode *archiveIndexNode)
+LOCAL void initSignatureHashThread(ArchiveHandle *archiveHandle)
 {
-  assert(archiveIndexNode != NULL);
+  assert(archiveHandle != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_READ);
+  assert(archiveHandle->read.signatureHashFlag);
 
-  freeArchiveIndexNode(archiveIndexNode,NULL);
-  LIST_DELETE_NODE(archiveIndexNode);
+  archiveHandle->read.signatureHashBlock = (byte*)malloc(SIGNATURE_HASH_BLOCK_SIZE);
+  if (archiveHandle->read.signatureHashBlock == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  archiveHandle->read.signatureHashBlockLength = 0L;
+  archiveHandle->read.signatureHashPostedBytes = 0LL;
+  archiveHandle->read.signatureHashDoneBytes   = 0LL;
+  Semaphore_init(&archiveHandle->read.signatureHashLock,SEMAPHORE_TYPE_BINARY);
+  if (!MsgQueue_init(&archiveHandle->read.signatureHashMsgQueue,
+                     MAX_SIGNATURE_HASH_MSGS,
+                     CALLBACK_((MsgQueueMsgFreeFunction)freeSignatureHashMsg,NULL)
+                    )
+     )
+  {
+    HALT_FATAL_ERROR("Cannot initialize signature hash message queue!");
+  }
+  if (!Thread_init(&archiveHandle->read.signatureHashThread,"BAR signature hash",globalOptions.niceLevel,signatureHashThreadCode,archiveHandle))
+  {
+    HALT_FATAL_ERROR("Cannot initialize signature hash thread!");
+  }
+  archiveHandle->read.signatureHashThreadFlag = TRUE;
 }
 
 /***********************************************************************\
-* Name   : flushArchiveIndexList
-* Purpose: flush archive index list and write to index database
-* Input  : archiveHandle   - archive handle
-*          entityId        - entity index id
-*          storageId       - storage index id
-*          maxIndexEntries - max. entries in list to do flush (0 to
-*                            force flush)
+* Name   : doneSignatureHashThread
+* Purpose: stop signature hash thread
+* Input  : archiveHandle - archive handle
 * Output : -
-* Return : ERROR_NONE or error code
+* Return : -
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors flushArchiveIndexList(ArchiveHandle *archiveHandle,
-                                   IndexId       uuidId,
-                                   IndexId       entityId,
-                                   IndexId       storageId,
-                                   uint          maxIndexEntries
-                                  )
+LOCAL void doneSignatureHashThread(ArchiveHandle *archiveHandle)
 {
-  Errors           error;
-
   assert(archiveHandle != NULL);
-  assertx(INDEX_TYPE(storageId) == INDEX_TYPE_STORAGE,"storageId=%"PRIi64"",storageId.data);
-
-  error = ERROR_NONE;
+  assert(archiveHandle->mode == ARCHIVE_MODE_READ);
+  assert(archiveHandle->read.signatureHashThreadFlag);
 
-  if (Index_isAvailable())
+  MsgQueue_setEndOfMsg(&archiveHandle->read.signatureHashMsgQueue);
+  if (!Thread_join(&archiveHandle->read.signatureHashThread))
   {
-    // init variables
-    ArchiveIndexList archiveIndexList;
-    List_init(&archiveIndexList,CALLBACK_(NULL,NULL),CALLBACK_((ListNodeFreeFunction)freeArchiveIndexNode,NULL));
+    HALT_INTERNAL_ERROR("Cannot stop signature hash thread!");
+  }
+  Thread_done(&archiveHandle->read.signatureHashThread);
+  MsgQueue_done(&archiveHandle->read.signatureHashMsgQueue);
+  Semaphore_done(&archiveHandle->read.signatureHashLock);
+  free(archiveHandle->read.signatureHashBlock);
+  archiveHandle->read.signatureHashThreadFlag = FALSE;
+}
 
-    // get list to flush
-    SEMAPHORE_LOCKED_DO(&archiveHandle->archiveIndexList.lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
-    {
-      if (List_count(&archiveHandle->archiveIndexList) >= maxIndexEntries)
-      {
-        List_move(&archiveIndexList,NULL,&archiveHandle->archiveIndexList,NULL,NULL);
-      }
-    }
+/***********************************************************************\
+* Name   : updateSignatureHash
+* Purpose: update signature hash of read data
+* Input  : archiveHandle - archive handle
+*          buffer        - data
+*          length        - length of data [bytes]
+* Output : -
+* Return : -
+* Notes  : with hash thread the data is collected into blocks which are
+*          hashed by the hash thread
+\***********************************************************************/
 
-    // flush list
-    if (!List_isEmpty(&archiveIndexList))
+LOCAL void updateSignatureHash(ArchiveHandle *archiveHandle, const void *buffer, ulong length)
+{
+  assert(archiveHandle != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_READ);
+  assert(buffer != NULL);
+
+  if (archiveHandle->read.signatureHashThreadFlag)
+  {
+    const byte *data = (const byte*)buffer;
+    while (length > 0L)
     {
-      SEMAPHORE_LOCKED_DO(&archiveHandle->indexLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+      // collect data
+      ulong n = MIN(length,SIGNATURE_HASH_BLOCK_SIZE-archiveHandle->read.signatureHashBlockLength);
+      memcpy(archiveHandle->read.signatureHashBlock+archiveHandle->read.signatureHashBlockLength,data,n);
+      archiveHandle->read.signatureHashBlockLength += n;
+      data   += n;
+      length -= n;
+
+      // send full block to hash thread
+      if (archiveHandle->read.signatureHashBlockLength >= SIGNATURE_HASH_BLOCK_SIZE)
       {
-        // start transaction
-        error = Index_beginTransaction(&archiveHandle->indexHandle,INDEX_TIMEOUT);
-        if (error == ERROR_NONE)
+        SignatureHashMsg signatureHashMsg;
+        signatureHashMsg.data   = archiveHandle->read.signatureHashBlock;
+        signatureHashMsg.length = archiveHandle->read.signatureHashBlockLength;
+        archiveHandle->read.signatureHashPostedBytes += (uint64)signatureHashMsg.length;
+        if (!MsgQueue_put(&archiveHandle->read.signatureHashMsgQueue,&signatureHashMsg,sizeof(signatureHashMsg)))
         {
-          // add to index
-          while (!List_isEmpty(&archiveIndexList) && (error == ERROR_NONE))
-          {
-            ArchiveIndexNode *archiveIndexNode = (ArchiveIndexNode*)List_removeFirst(&archiveIndexList);
-
-            switch (archiveIndexNode->type)
-            {
-              case ARCHIVE_ENTRY_TYPE_FILE:
-                error = IndexEntry_addFile(&archiveHandle->indexHandle,
-                                           uuidId,
-                                           entityId,
-                                           storageId,
-                                           archiveIndexNode->file.name,
-                                           archiveIndexNode->file.size,
-                                           archiveIndexNode->file.timeLastAccess,
-                                           archiveIndexNode->file.timeModified,
-                                           archiveIndexNode->file.timeLastChanged,
-                                           archiveIndexNode->file.userId,
-                                           archiveIndexNode->file.groupId,
-                                           archiveIndexNode->file.permission,
-                                           archiveIndexNode->file.fragmentOffset,
-                                           archiveIndexNode->file.fragmentSize
-                                          );
-                break;
-              case ARCHIVE_ENTRY_TYPE_IMAGE:
-                error = IndexEntry_addImage(&archiveHandle->indexHandle,
-                                            uuidId,
-                                            entityId,
-                                            storageId,
-                                            archiveIndexNode->image.name,
-                                            archiveIndexNode->image.fileSystemType,
-                                            archiveIndexNode->image.size,
-                                            archiveIndexNode->image.blockSize,
-                                            archiveIndexNode->image.blockOffset,
-                                            archiveIndexNode->image.blockCount
-                                           );
-                break;
-              case ARCHIVE_ENTRY_TYPE_DIRECTORY:
-                error = IndexEntry_addDirectory(&archiveHandle->indexHandle,
-                                                uuidId,
-                                                entityId,
-                                                storageId,
-                                                archiveIndexNode->directory.name,
-                                                archiveIndexNode->directory.timeLastAccess,
-                                                archiveIndexNode->directory.timeModified,
-                                                archiveIndexNode->directory.timeLastChanged,
-                                                archiveIndexNode->directory.userId,
-                                                archiveIndexNode->directory.groupId,
-                                                archiveIndexNode->directory.permission
-                                               );
-                break;
-              case ARCHIVE_ENTRY_TYPE_LINK:
-                error = IndexEntry_addLink(&archiveHandle->indexHandle,
-                                           uuidId,
-                                           entityId,
-                                           storageId,
-                                           archiveIndexNode->link.name,
-                                           archiveIndexNode->link.destinationName,
-                                           archiveIndexNode->link.timeLastAccess,
-                                           archiveIndexNode->link.timeModified,
-                                           archiveIndexNode->link.timeLastChanged,
-                                           archiveIndexNode->link.userId,
-                                           archiveIndexNode->link.groupId,
-                                           archiveIndexNode->link.permission
-                                          );
-                break;
-              case ARCHIVE_ENTRY_TYPE_HARDLINK:
-                error = IndexEntry_addHardlink(&archiveHandle->indexHandle,
-                                               uuidId,
-                                               entityId,
-                                               storageId,
-                                               archiveIndexNode->hardlink.name,
-                                               archiveIndexNode->hardlink.size,
-                                               archiveIndexNode->hardlink.timeLastAccess,
-                                               archiveIndexNode->hardlink.timeModified,
-                                               archiveIndexNode->hardlink.timeLastChanged,
-                                               archiveIndexNode->hardlink.userId,
-                                               archiveIndexNode->hardlink.groupId,
-                                               archiveIndexNode->hardlink.permission,
-                                               archiveIndexNode->hardlink.fragmentOffset,
-                                               archiveIndexNode->hardlink.fragmentSize
-                                              );
-                break;
-              case ARCHIVE_ENTRY_TYPE_SPECIAL:
-                error = IndexEntry_addSpecial(&archiveHandle->indexHandle,
-                                              uuidId,
-                                              entityId,
-                                              storageId,
-                                              archiveIndexNode->special.name,
-                                              archiveIndexNode->special.specialType,
-                                              archiveIndexNode->special.timeLastAccess,
-                                              archiveIndexNode->special.timeModified,
-                                              archiveIndexNode->special.timeLastChanged,
-                                              archiveIndexNode->special.userId,
-                                              archiveIndexNode->special.groupId,
-                                              archiveIndexNode->special.permission,
-                                              archiveIndexNode->special.major,
-                                              archiveIndexNode->special.minor
-                                             );
-                break;
-              default:
-                #ifndef NDEBUG
-                  HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
-                #endif /* NDEBUG */
-                break;
-            }
-
-            deleteArchiveIndexNode(archiveIndexNode);
-          }
+          HALT_INTERNAL_ERROR("Send message to signature hash thread fail!");
+        }
 
-          // end/abort transaction
-          if (error == ERROR_NONE)
-          {
-            (void)Index_endTransaction(&archiveHandle->indexHandle);
-          }
-          else
-          {
-            (void)Index_rollbackTransaction(&archiveHandle->indexHandle);
-          }
+        archiveHandle->read.signatureHashBlock = (byte*)malloc(SIGNATURE_HASH_BLOCK_SIZE);
+        if (archiveHandle->read.signatureHashBlock == NULL)
+        {
+          HALT_INSUFFICIENT_MEMORY();
         }
+        archiveHandle->read.signatureHashBlockLength = 0L;
       }
     }
-
-    // free resources
-    List_done(&archiveIndexList);
   }
-
-  return error;
+  else
+  {
+    Crypt_updateHash(&archiveHandle->read.signatureHash,buffer,length);
+  }
 }
 
 /***********************************************************************\
-* Name   : autoFlushArchiveIndexList
-* Purpose: auto flush archive index list and write to index database
+* Name   : syncSignatureHash
+* Purpose: wait until all data is hashed
 * Input  : archiveHandle - archive handle
-*          entityId      - entity index id
-*          storageId     - storage index id
 * Output : -
-* Return : ERROR_NONE or error code
-* Notes  : -
+* Return : -
+* Notes  : must be called before the signature hash is get or reset
 \***********************************************************************/
 
-LOCAL Errors autoFlushArchiveIndexList(ArchiveHandle *archiveHandle,
-                                       IndexId       uuidId,
-                                       IndexId       entityId,
-                                       IndexId       storageId
-                                      )
+LOCAL void syncSignatureHash(ArchiveHandle *archiveHandle)
 {
   assert(archiveHandle != NULL);
-  assertx(INDEX_TYPE(storageId) == INDEX_TYPE_STORAGE,"storageId=%"PRIi64"",storageId.data);
+  assert(archiveHandle->mode == ARCHIVE_MODE_READ);
 
-  return flushArchiveIndexList(archiveHandle,uuidId,entityId,storageId,MAX_INDEX_LIST);
+  if (archiveHandle->read.signatureHashThreadFlag)
+  {
+    // wait for hash thread
+    SEMAPHORE_LOCKED_DO(&archiveHandle->read.signatureHashLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+    {
+      while (archiveHandle->read.signatureHashDoneBytes < archiveHandle->read.signatureHashPostedBytes)
+      {
+        Semaphore_waitModified(&archiveHandle->read.signatureHashLock,WAIT_FOREVER);
+      }
+    }
+
+    // hash collected data (Note: hash thread is idle)
+    Crypt_updateHash(&archiveHandle->read.signatureHash,
+                     archiveHandle->read.signatureHashBlock,
+                     archiveHandle->read.signatureHashBlockLength
+                    );
+    archiveHandle->read.signatureHashBlockLength = 0L;
+  }
 }
 
 /***********************************************************************\
-* Name   : addArchiveIndexNode
-* Purpose: add archive index node and flush
-* Input  : archiveHandle    - archive handle
-*          archiveIndexNode - archive index node
+* Name   : updateReadSignatureHash
+* Purpose: update signature hash with read data
+* Input  : archiveHandle - archive handle
+*          offset        - archive offset of read data
+*          buffer        - read data
+*          length        - length of read data [bytes]
 * Output : -
 * Return : -
-* Notes  : -
+* Notes  : only data following the already hashed or kept data is
+*          hashed; the last SIGNATURE_HASH_KEEP_SIZE bytes are kept
+*          and hashed later, because the signature chunk itself is read
+*          before the signature hash is calculated
 \***********************************************************************/
 
-LOCAL void addArchiveIndexNode(ArchiveHandle *archiveHandle, ArchiveIndexNode *archiveIndexNode)
+LOCAL void updateReadSignatureHash(ArchiveHandle *archiveHandle, uint64 offset, const void *buffer, ulong length)
 {
   assert(archiveHandle != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_READ);
+  assert(archiveHandle->read.signatureHashFlag);
+  assert(archiveHandle->read.signatureHashBuffer != NULL);
+  assert(buffer != NULL);
 
-  SEMAPHORE_LOCKED_DO(&archiveHandle->archiveIndexList.lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  uint64 end = archiveHandle->read.signatureHashOffset+(uint64)archiveHandle->read.signatureHashBufferLength;
+  if ((offset <= end) && ((offset+(uint64)length) > end))
   {
-    List_append(&archiveHandle->archiveIndexList,archiveIndexNode);
+    // get new data
+    const byte *data = (const byte*)buffer+(ulong)(end-offset);
+    ulong      n     = length-(ulong)(end-offset);
+
+    // hash kept and new data in front of data to keep
+    if ((archiveHandle->read.signatureHashBufferLength+n) > SIGNATURE_HASH_KEEP_SIZE)
+    {
+      ulong hashLength = archiveHandle->read.signatureHashBufferLength+n-SIGNATURE_HASH_KEEP_SIZE;
+
+      ulong m = MIN(hashLength,archiveHandle->read.signatureHashBufferLength);
+      updateSignatureHash(archiveHandle,archiveHandle->read.signatureHashBuffer,m);
+      memmove(archiveHandle->read.signatureHashBuffer,
+              archiveHandle->read.signatureHashBuffer+m,
+              archiveHandle->read.signatureHashBufferLength-m
+             );
+      archiveHandle->read.signatureHashBufferLength -= m;
+      archiveHandle->read.signatureHashOffset       += (uint64)m;
+      hashLength -= m;
+
+      updateSignatureHash(archiveHandle,data,hashLength);
+      archiveHandle->read.signatureHashOffset += (uint64)hashLength;
+      data += hashLength;
+      n    -= hashLength;
+    }
+
+    // keep rest of data
+    assert((archiveHandle->read.signatureHashBufferLength+n) <= SIGNATURE_HASH_KEEP_SIZE);
+    memcpy(archiveHandle->read.signatureHashBuffer+archiveHandle->read.signatureHashBufferLength,data,n);
+    archiveHandle->read.signatureHashBufferLength += n;
   }
 }
 
 /***********************************************************************\
-* Name   : indexAddFile
-* Purpose: add file index node
-* Input  : archiveHandle   - archive handle
-*          name            - name
-*          size            - size [bytes]
-*          timeLastAccess  - last access date/time stamp [s]
-*          timeModified    - modified date/time stamp [s]
-*          timeLastChanged - last changed date/time stamp [s]
-*          userId          - user id
-*          groupId         - group id
-*          permission      - permission flags
-*          fragmentOffset  - fragment offset [bytes]
-*          fragmentSize    - fragment size [bytes]
+* Name   : fillReadSignatureHash
+* Purpose: update signature hash with skipped data
+* Input  : archiveHandle - archive handle
+*          offset        - archive offset to read data up to
 * Output : -
 * Return : ERROR_NONE or error code
-* Notes  : -
+* Notes  : data which was not read or skipped by seeking forward is
+*          read to complete the signature hash
 \***********************************************************************/
 
-LOCAL Errors indexAddFile(ArchiveHandle *archiveHandle,
-                          ConstString   name,
-                          uint64        size,
-                          uint64        timeLastAccess,
-                          uint64        timeModified,
-                          uint64        timeLastChanged,
-                          uint32        userId,
-                          uint32        groupId,
-                          uint32        permission,
-                          uint64        fragmentOffset,
-                          uint64        fragmentSize
-                         )
+LOCAL Errors fillReadSignatureHash(ArchiveHandle *archiveHandle, uint64 offset)
 {
+  #define BUFFER_SIZE (64*1024)
+
+  Errors error;
+
   assert(archiveHandle != NULL);
-  assert(name != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_READ);
+  assert(archiveHandle->read.signatureHashFlag);
 
-  ArchiveIndexNode *archiveIndexNode = LIST_NEW_NODE(ArchiveIndexNode);
-  if (archiveIndexNode == NULL)
+  uint64 end = archiveHandle->read.signatureHashOffset+(uint64)archiveHandle->read.signatureHashBufferLength;
+  if (offset > end)
   {
-    HALT_INSUFFICIENT_MEMORY();
-  }
-  archiveIndexNode->type                 = ARCHIVE_ENTRY_TYPE_FILE;
-  archiveIndexNode->file.name            = String_duplicate(name);
-  archiveIndexNode->file.size            = size;
-  archiveIndexNode->file.timeLastAccess  = timeLastAccess;
-  archiveIndexNode->file.timeModified    = timeModified;
-  archiveIndexNode->file.timeLastChanged = timeLastChanged;
-  archiveIndexNode->file.userId          = userId;
-  archiveIndexNode->file.groupId         = groupId;
-  archiveIndexNode->file.permission      = permission;
-  archiveIndexNode->file.fragmentOffset  = fragmentOffset;
-  archiveIndexNode->file.fragmentSize    = fragmentSize;
-  addArchiveIndexNode(archiveHandle,archiveIndexNode);
+    // init variables
+    void *buffer = malloc(BUFFER_SIZE);
+    if (buffer == NULL)
+    {
+      HALT_INSUFFICIENT_MEMORY();
+    }
 
-  return ERROR_NONE;
-}
+    // save current index
+    uint64 index;
+    error = Storage_tell(&archiveHandle->read.storageHandle,&index);
+    if (error != ERROR_NONE)
+    {
+      free(buffer);
+      return error;
+    }
 
-/***********************************************************************\
-* Name   : indexAddImage
-* Purpose: add image index node
-* Input  : archiveHandle  - archive handle
-*          imageName      - image name
-*          fileSystemType - file system type
-*          size           - size [bytes]
-*          blockSize      - block size [bytes]
-*          blockOffset    - block offset [blocks]
-*          blockCount     - number of blocks
-* Output : -
-* Return : ERROR_NONE or error code
-* Notes  : -
-\***********************************************************************/
+    // read skipped data
+    error = Storage_seek(&archiveHandle->read.storageHandle,end);
+    while (   (end < offset)
+           && (error == ERROR_NONE)
+          )
+    {
+      ulong n = (ulong)MIN(offset-end,BUFFER_SIZE);
 
-LOCAL Errors indexAddImage(ArchiveHandle   *archiveHandle,
-                           ConstString     name,
-                           FileSystemTypes fileSystemType,
-                           int64           size,
-                           ulong           blockSize,
-                           uint64          blockOffset,
-                           uint64          blockCount
-                          )
-{
-  assert(archiveHandle != NULL);
-  assert(name != NULL);
+      error = Storage_read(&archiveHandle->read.storageHandle,buffer,n,NULL);
+      if (error == ERROR_NONE)
+      {
+        updateReadSignatureHash(archiveHandle,end,buffer,n);
 
-  ArchiveIndexNode *archiveIndexNode = LIST_NEW_NODE(ArchiveIndexNode);
-  if (archiveIndexNode == NULL)
-  {
-    HALT_INSUFFICIENT_MEMORY();
+        end += (uint64)n;
+      }
+    }
+    if (error != ERROR_NONE)
+    {
+      (void)Storage_seek(&archiveHandle->read.storageHandle,index);
+      free(buffer);
+      return error;
+    }
+
+    // restore index
+    error = Storage_seek(&archiveHandle->read.storageHandle,index);
+    if (error != ERROR_NONE)
+    {
+      free(buffer);
+      return error;
+    }
+
+    // free resources
+    free(buffer);
   }
-  archiveIndexNode->type                  = ARCHIVE_ENTRY_TYPE_IMAGE;
-  archiveIndexNode->image.name            = String_duplicate(name);
-  archiveIndexNode->image.fileSystemType  = fileSystemType;
-  archiveIndexNode->image.size            = size;
-  archiveIndexNode->image.blockSize       = blockSize;
-  archiveIndexNode->image.blockOffset     = blockOffset;
-  archiveIndexNode->image.blockCount      = blockCount;
-  addArchiveIndexNode(archiveHandle,archiveIndexNode);
 
   return ERROR_NONE;
+
+  #undef BUFFER_SIZE
 }
 
 /***********************************************************************\
-* Name   : indexAddDirectory
-* Purpose: add directory index node
-* Input  : archiveHandle   - archive handle
-*          directoryName   - name
-*          timeLastAccess  - last access date/time stamp [s]
-*          timeModified    - modified date/time stamp [s]
-*          timeLastChanged - last changed date/time stamp [s]
-*          userId          - user id
-*          groupId         - group id
-*          permission      - permission flags
+* Name   : restartReadSignatureHash
+* Purpose: restart signature hash of read data
+* Input  : archiveHandle - archive handle
+*          offset        - archive offset of new signature hash begin
 * Output : -
-* Return : ERROR_NONE or error code
+* Return : -
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors indexAddDirectory(ArchiveHandle *archiveHandle,
-                               String        name,
-                               uint64        timeLastAccess,
-                               uint64        timeModified,
-                               uint64        timeLastChanged,
-                               uint32        userId,
-                               uint32        groupId,
-                               uint32        permission
-                              )
+LOCAL void restartReadSignatureHash(ArchiveHandle *archiveHandle, uint64 offset)
 {
   assert(archiveHandle != NULL);
-  assert(name != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_READ);
 
-  ArchiveIndexNode *archiveIndexNode = LIST_NEW_NODE(ArchiveIndexNode);
-  if (archiveIndexNode == NULL)
+  if (archiveHandle->read.signatureHashFlag)
   {
-    HALT_INSUFFICIENT_MEMORY();
-  }
-  archiveIndexNode->type                      = ARCHIVE_ENTRY_TYPE_DIRECTORY;
-  archiveIndexNode->directory.name            = String_duplicate(name);
-  archiveIndexNode->directory.timeLastAccess  = timeLastAccess;
-  archiveIndexNode->directory.timeModified    = timeModified;
-  archiveIndexNode->directory.timeLastChanged = timeLastChanged;
-  archiveIndexNode->directory.userId          = userId;
-  archiveIndexNode->directory.groupId         = groupId;
-  archiveIndexNode->directory.permission      = permission;
-  addArchiveIndexNode(archiveHandle,archiveIndexNode);
+    syncSignatureHash(archiveHandle);
+    Crypt_resetHash(&archiveHandle->read.signatureHash);
 
-  return ERROR_NONE;
+    // keep data behind new begin
+    if (   (offset >= archiveHandle->read.signatureHashOffset)
+        && (offset <= archiveHandle->read.signatureHashOffset+(uint64)archiveHandle->read.signatureHashBufferLength)
+       )
+    {
+      ulong n = (ulong)(offset-archiveHandle->read.signatureHashOffset);
+      memmove(archiveHandle->read.signatureHashBuffer,
+              archiveHandle->read.signatureHashBuffer+n,
+              archiveHandle->read.signatureHashBufferLength-n
+             );
+      archiveHandle->read.signatureHashBufferLength -= n;
+    }
+    else
+    {
+      archiveHandle->read.signatureHashBufferLength = 0L;
+    }
+
+    archiveHandle->read.signatureHashStart  = offset;
+    archiveHandle->read.signatureHashOffset = offset;
+  }
 }
 
 /***********************************************************************\
-* Name   : indexAddLink
-* Purpose: add link index node
-* Input  : archiveHandle   - archive handle
-*          name            - link name
-*          destinationName - destination name
-*          timeLastAccess  - last access date/time stamp [s]
-*          timeModified    - modified date/time stamp [s]
-*          timeLastChanged - last changed date/time stamp [s]
-*          userId          - user id
-*          groupId         - group id
-*          permission      - permission flags
-* Output : -
+* Name   : calculateSignatureHash
+* Purpose: calculate signature hash of read archive
+* Input  : archiveHandle - archive handle
+*          start,end     - start/end offset of signed data
+*          hash          - hash variable
+*          maxHashLength - max. length of hash
+* Output : hash       - hash value
+*          hashLength - length of hash value
 * Return : ERROR_NONE or error code
-* Notes  : -
+* Notes  : the signature hash calculated while reading is used if it
+*          starts at the given offset; only data which was not read
+*          before (e.g. skipped entries) is read
 \***********************************************************************/
 
-LOCAL Errors indexAddLink(ArchiveHandle *archiveHandle,
-                          ConstString   name,
-                          ConstString   destinationName,
-                          uint64        timeLastAccess,
-                          uint64        timeModified,
-                          uint64        timeLastChanged,
-                          uint32        userId,
-                          uint32        groupId,
-                          uint32        permission
-                         )
+LOCAL Errors calculateSignatureHash(ArchiveHandle *archiveHandle,
+                                    uint64        start,
+                                    uint64        end,
+                                    void          *hash,
+                                    uint          maxHashLength,
+                                    uint          *hashLength
+                                   )
 {
+  Errors error;
+
   assert(archiveHandle != NULL);
-  assert(name != NULL);
-  assert(destinationName != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_READ);
+  assert(hash != NULL);
+  assert(hashLength != NULL);
+  assert(end >= start);
 
-  ArchiveIndexNode *archiveIndexNode = LIST_NEW_NODE(ArchiveIndexNode);
-  if (archiveIndexNode == NULL)
+  if (   archiveHandle->read.signatureHashFlag
+      && (archiveHandle->read.signatureHashStart == start)
+      && (archiveHandle->read.signatureHashOffset <= end)
+     )
   {
-    HALT_INSUFFICIENT_MEMORY();
+    // read data which was not read (e.g. skipped entries)
+    error = fillReadSignatureHash(archiveHandle,end);
+    if (error != ERROR_NONE)
+    {
+      restartReadSignatureHash(archiveHandle,end);
+      return error;
+    }
+
+    // hash kept data
+    ulong n = (ulong)(end-archiveHandle->read.signatureHashOffset);
+    assert(n <= archiveHandle->read.signatureHashBufferLength);
+    updateSignatureHash(archiveHandle,archiveHandle->read.signatureHashBuffer,n);
+    memmove(archiveHandle->read.signatureHashBuffer,
+            archiveHandle->read.signatureHashBuffer+n,
+            archiveHandle->read.signatureHashBufferLength-n
+           );
+    archiveHandle->read.signatureHashBufferLength -= n;
+    archiveHandle->read.signatureHashOffset       = end;
+
+    // get hash
+    syncSignatureHash(archiveHandle);
+    (void)Crypt_getHash(&archiveHandle->read.signatureHash,hash,maxHashLength,hashLength);
+
+    // restart signature hash: hash cannot be updated anymore
+    restartReadSignatureHash(archiveHandle,end);
+  }
+  else
+  {
+    // init hash
+    CryptHash signatureHash;
+    error = Crypt_initHash(&signatureHash,SIGNATURE_HASH_ALGORITHM);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+
+    // calculate hash
+    error = calculateHash(archiveHandle->chunkIO,
+                          archiveHandle->chunkIOUserData,
+                          &signatureHash,
+                          start,
+                          end
+                         );
+    if (error != ERROR_NONE)
+    {
+      Crypt_doneHash(&signatureHash);
+      return error;
+    }
+
+    // get hash
+    (void)Crypt_getHash(&signatureHash,hash,maxHashLength,hashLength);
+
+    // free resources
+    Crypt_doneHash(&signatureHash);
   }
-  archiveIndexNode->type                 = ARCHIVE_ENTRY_TYPE_LINK;
-  archiveIndexNode->link.name            = String_duplicate(name);
-  archiveIndexNode->link.destinationName = String_duplicate(destinationName);
-  archiveIndexNode->link.timeLastAccess  = timeLastAccess;
-  archiveIndexNode->link.timeModified    = timeModified;
-  archiveIndexNode->link.timeLastChanged = timeLastChanged;
-  archiveIndexNode->link.userId          = userId;
-  archiveIndexNode->link.groupId         = groupId;
-  archiveIndexNode->link.permission      = permission;
-  addArchiveIndexNode(archiveHandle,archiveIndexNode);
 
   return ERROR_NONE;
 }
 
 /***********************************************************************\
-* Name   : indexAddHardlink
-* Purpose: add hardlink index node
-* Input  : archiveHandle   - archive handle
-*          name            - name
-*          size            - size [bytes]
-*          timeLastAccess  - last access date/time stamp [s]
-*          timeModified    - modified date/time stamp [s]
-*          timeLastChanged - last changed date/time stamp [s]
-*          userId          - user id
-*          groupId         - group id
-*          permission      - permission flags
-*          fragmentOffset  - fragment offset [bytes]
-*          fragmentSize    - fragment size [bytes]
+* Name   : ChunkIORead_eof
+* Purpose: check end of read archive
+* Input  : userData - archive handle
 * Output : -
+* Return : TRUE iff end of archive
+* Notes  : -
+\***********************************************************************/
+
+LOCAL bool ChunkIORead_eof(void *userData)
+{
+  ArchiveHandle *archiveHandle = (ArchiveHandle*)userData;
+  assert(archiveHandle != NULL);
+
+  return Storage_eof(&archiveHandle->read.storageHandle);
+}
+
+/***********************************************************************\
+* Name   : ChunkIORead_read
+* Purpose: read data from archive and update signature hash
+* Input  : userData - archive handle
+*          length   - number of bytes to read
+* Output : buffer    - data
+*          bytesRead - number of read bytes (can be NULL)
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors indexAddHardlink(ArchiveHandle *archiveHandle,
-                              ConstString   name,
-                              uint64        size,
-                              uint64        timeLastAccess,
-                              uint64        timeModified,
-                              uint64        timeLastChanged,
-                              uint32        userId,
-                              uint32        groupId,
-                              uint32        permission,
-                              uint64        fragmentOffset,
-                              uint64        fragmentSize
-                             )
+LOCAL Errors ChunkIORead_read(void *userData, void *buffer, ulong length, ulong *bytesRead)
 {
+  Errors error;
+
+  ArchiveHandle *archiveHandle = (ArchiveHandle*)userData;
   assert(archiveHandle != NULL);
-  assert(name != NULL);
 
-  ArchiveIndexNode *archiveIndexNode = LIST_NEW_NODE(ArchiveIndexNode);
-  if (archiveIndexNode == NULL)
+  if (archiveHandle->read.signatureHashFlag)
   {
-    HALT_INSUFFICIENT_MEMORY();
+    uint64 offset;
+    error = Storage_tell(&archiveHandle->read.storageHandle,&offset);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+
+    ulong n;
+    if (bytesRead != NULL)
+    {
+      error = Storage_read(&archiveHandle->read.storageHandle,buffer,length,bytesRead);
+      n = (*bytesRead);
+    }
+    else
+    {
+      error = Storage_read(&archiveHandle->read.storageHandle,buffer,length,NULL);
+      n = length;
+    }
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+
+    // read skipped data to continue signature hash (small skipped data or all when verifying signatures while reading)
+    uint64 end = archiveHandle->read.signatureHashOffset+(uint64)archiveHandle->read.signatureHashBufferLength;
+    if (   (offset > end)
+        && (   ((offset-end) <= SIGNATURE_HASH_MAX_SKIP_SIZE)
+            || IS_SET(archiveHandle->archiveFlags,ARCHIVE_FLAG_VERIFY_SIGNATURES)
+           )
+       )
+    {
+      error = fillReadSignatureHash(archiveHandle,offset);
+      if (error != ERROR_NONE)
+      {
+        return error;
+      }
+    }
+
+    // update signature hash
+    updateReadSignatureHash(archiveHandle,offset,buffer,n);
+  }
+  else
+  {
+    error = Storage_read(&archiveHandle->read.storageHandle,buffer,length,bytesRead);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
   }
-  archiveIndexNode->type                     = ARCHIVE_ENTRY_TYPE_HARDLINK;
-  archiveIndexNode->hardlink.name            = String_duplicate(name);
-  archiveIndexNode->hardlink.size            = size;
-  archiveIndexNode->hardlink.timeLastAccess  = timeLastAccess;
-  archiveIndexNode->hardlink.timeModified    = timeModified;
-  archiveIndexNode->hardlink.timeLastChanged = timeLastChanged;
-  archiveIndexNode->hardlink.userId          = userId;
-  archiveIndexNode->hardlink.groupId         = groupId;
-  archiveIndexNode->hardlink.permission      = permission;
-  archiveIndexNode->hardlink.fragmentOffset  = fragmentOffset;
-  archiveIndexNode->hardlink.fragmentSize    = fragmentSize;
-  addArchiveIndexNode(archiveHandle,archiveIndexNode);
 
   return ERROR_NONE;
 }
 
 /***********************************************************************\
-* Name   : indexAddSpecial
-* Purpose: add special index node
-* Input  : archiveHandle   - archive handle
-*          name            - name
-*          specialType     - special type; see FileSpecialTypes
-*          timeLastAccess  - last access date/time stamp [s]
-*          timeModified    - modified date/time stamp [s]
-*          timeLastChanged - last changed date/time stamp [s]
-*          userId          - user id
-*          groupId         - group id
-*          permission      - permission flags
-*          major,minor     - major,minor number
+* Name   : ChunkIORead_write
+* Purpose: write data to archive
+* Input  : userData - archive handle
+*          buffer   - data
+*          length   - length of data [bytes]
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors indexAddSpecial(ArchiveHandle    *archiveHandle,
-                             ConstString      name,
-                             FileSpecialTypes specialType,
-                             uint64           timeLastAccess,
-                             uint64           timeModified,
-                             uint64           timeLastChanged,
-                             uint32           userId,
-                             uint32           groupId,
-                             uint32           permission,
-                             uint32           major,
-                             uint32           minor
-                            )
+LOCAL Errors ChunkIORead_write(void *userData, const void *buffer, ulong length)
 {
+  ArchiveHandle *archiveHandle = (ArchiveHandle*)userData;
   assert(archiveHandle != NULL);
-  assert(name != NULL);
-
-  ArchiveIndexNode *archiveIndexNode = LIST_NEW_NODE(ArchiveIndexNode);
-  if (archiveIndexNode == NULL)
-  {
-    HALT_INSUFFICIENT_MEMORY();
-  }
-  archiveIndexNode->type                    = ARCHIVE_ENTRY_TYPE_SPECIAL;
-  archiveIndexNode->special.name            = String_duplicate(name);
-  archiveIndexNode->special.specialType     = specialType;
-  archiveIndexNode->special.timeLastAccess  = timeLastAccess;
-  archiveIndexNode->special.timeModified    = timeModified;
-  archiveIndexNode->special.timeLastChanged = timeLastChanged;
-  archiveIndexNode->special.userId          = userId;
-  archiveIndexNode->special.groupId         = groupId;
-  archiveIndexNode->special.permission      = permission;
-  archiveIndexNode->special.major           = major;
-  archiveIndexNode->special.minor           = minor;
-  addArchiveIndexNode(archiveHandle,archiveIndexNode);
 
-  return ERROR_NONE;
+  return Storage_write(&archiveHandle->read.storageHandle,buffer,length);
 }
 
-// ----------------------------------------------------------------------
-
 /***********************************************************************\
-* Name   : readHeader
-* Purpose: read header
-* Input  : archiveHandle - archive handle
-*          chunkHeader - key chunk header
-* Output : -
+* Name   : ChunkIORead_tell
+* Purpose: get current offset in read archive
+* Input  : userData - archive handle
+* Output : offset - offset
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors readHeader(ArchiveHandle     *archiveHandle,
-                        const ChunkHeader *chunkHeader
-                       )
+LOCAL Errors ChunkIORead_tell(void *userData, uint64 *offset)
 {
-  Errors error;
-
+  ArchiveHandle *archiveHandle = (ArchiveHandle*)userData;
   assert(archiveHandle != NULL);
-  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
-  assert(chunkHeader != NULL);
-  assert(chunkHeader->id == CHUNK_ID_BAR);
-
-  // init BAR chunk
-  ChunkBAR chunkBAR;
-  error = Chunk_init(&chunkBAR.info,
-                     NULL,  // parentChunkInfo
-                     archiveHandle->chunkIO,
-                     archiveHandle->chunkIOUserData,
-                     CHUNK_ID_BAR,
-                     CHUNK_DEFINITION_BAR,
-//TODO: DEFAULT_ALIGNMENT
-                     0,  // alignment
-                     NULL,  // cryptInfo
-                     &chunkBAR
-                    );
-  if (error != ERROR_NONE)
-  {
-    return error;
-  }
-
-  // init new crypt info (Note: older BAR version use CTS+simple key derivation)
-  error = initArchiveCryptInfo(archiveHandle,
-                               CRYPT_TYPE_NONE,
-                               CRYPT_MODE_CTS_,
-                               CRYPT_KEY_DERIVE_SIMPLE
-                              );
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkBAR.info);
-    return error;
-  }
-
-  // read BAR chunk
-  error = Chunk_open(&chunkBAR.info,
-                     chunkHeader,
-                     chunkHeader->size,
-                     archiveHandle
-                    );
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkBAR.info);
-    return error;
-  }
-
-  // close chunk
-  error = Chunk_close(&chunkBAR.info);
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkBAR.info);
-    return error;
-  }
-  Chunk_done(&chunkBAR.info);
 
-  return ERROR_NONE;
+  return Storage_tell(&archiveHandle->read.storageHandle,offset);
 }
 
 /***********************************************************************\
-* Name   : readSalt
-* Purpose: read salt
-* Input  : archiveHandle - archive handle
-*          chunkHeader   - key chunk header
+* Name   : ChunkIORead_seek
+* Purpose: seek in read archive
+* Input  : userData - archive handle
+*          offset   - offset
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors readSalt(ArchiveHandle     *archiveHandle,
-                      const ChunkHeader *chunkHeader
-                     )
+LOCAL Errors ChunkIORead_seek(void *userData, uint64 offset)
 {
-  Errors error;
-
+  ArchiveHandle *archiveHandle = (ArchiveHandle*)userData;
   assert(archiveHandle != NULL);
-  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
-  assert(chunkHeader != NULL);
-  assert(chunkHeader->id == CHUNK_ID_SALT);
 
-  // check size
-  if (chunkHeader->size < CHUNK_FIXED_SIZE_SALT)
-  {
-    return ERROR_INVALID_CHUNK_SIZE;
-  }
+  return Storage_seek(&archiveHandle->read.storageHandle,offset);
+}
 
-  // init salt chunk
-  ChunkSalt chunkSalt;
-  error = Chunk_init(&chunkSalt.info,
-                     NULL,  // parentChunkInfo
-                     archiveHandle->chunkIO,
-                     archiveHandle->chunkIOUserData,
-                     CHUNK_ID_SALT,
-                     CHUNK_DEFINITION_SALT,
-//TODO: DEFAULT_ALIGNMENT
-                     0,  // alignment
-                     NULL,  // cryptInfo
-                     &chunkSalt
-                    );
-  if (error != ERROR_NONE)
-  {
-    return error;
-  }
+/***********************************************************************\
+* Name   : ChunkIORead_getSize
+* Purpose: get size of read archive
+* Input  : userData - archive handle
+* Output : -
+* Return : size of archive [bytes]
+* Notes  : -
+\***********************************************************************/
 
-  // open salt chunk
-  error = Chunk_open(&chunkSalt.info,
-                     chunkHeader,
-                     CHUNK_FIXED_SIZE_SALT,
-                     archiveHandle
-                    );
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkSalt.info);
-    return error;
-  }
+LOCAL int64 ChunkIORead_getSize(void *userData)
+{
+  ArchiveHandle *archiveHandle = (ArchiveHandle*)userData;
+  assert(archiveHandle != NULL);
 
-  // check if all data read
-  if (!Chunk_eofSub(&chunkSalt.info))
-  {
-    Chunk_close(&chunkSalt.info);
-    Chunk_done(&chunkSalt.info);
-    return ERRORX_(CORRUPT_DATA,0,"%s",String_cString(archiveHandle->printableStorageName));
-  }
+  return (int64)Storage_getSize(&archiveHandle->read.storageHandle);
+}
 
-  // add new crypt info
-  error = initArchiveCryptInfo(archiveHandle,
-                               CRYPT_TYPE_NONE,
-                               CRYPT_MODE_NONE,
-                               CRYPT_KEY_DERIVE_FUNCTION
-                              );
-  if (error != ERROR_NONE)
-  {
-    Chunk_close(&chunkSalt.info);
-    Chunk_done(&chunkSalt.info);
-    return error;
-  }
+// i/o via storage functions with signature hash calculated while reading
+LOCAL const ChunkIO CHUNK_IO_READ =
+{
+  ChunkIORead_eof,
+  ChunkIORead_read,
+  ChunkIORead_write,
+  ChunkIORead_tell,
+  ChunkIORead_seek,
+  ChunkIORead_getSize
+};
 
-  // set crypt salt
-  Crypt_setSalt(&archiveHandle->archiveCryptInfo->cryptSalt,
-                chunkSalt.salt,
-                sizeof(chunkSalt.salt)
-               );
+// ----------------------------------------------------------------------
 
-  // close chunk
-  error = Chunk_close(&chunkSalt.info);
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkSalt.info);
-    return error;
-  }
-  Chunk_done(&chunkSalt.info);
+/***********************************************************************\
+* Name   : freeTOCNode
+* Purpose: free table of contents node
+* Input  : tocNode  - table of contents node
+*          userData - user data (not used)
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
 
-  // free resources
+LOCAL void freeTOCNode(ArchiveTOCNode *tocNode, void *userData)
+{
+  assert(tocNode != NULL);
 
-  return ERROR_NONE;
+  UNUSED_VARIABLE(userData);
+
+  String_delete(tocNode->name);
 }
 
 /***********************************************************************\
-* Name   : readEncryptionKey
-* Purpose: read asymmetric encryption key and decrypt with private key
-* Input  : archiveHandle   - archive handle
-*          chunkHeader     - key chunk header
-*          privateCryptKey - private decryption key
+* Name   : freeArchiveIndexNode
+* Purpose: free archive index node
+* Input  : archiveIndexNode - archive index node
+*          userData         - user data (not used)
 * Output : -
-* Return : ERROR_NONE or error code
+* Return : -
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors readEncryptionKey(ArchiveHandle     *archiveHandle,
-                               const ChunkHeader *chunkHeader,
-                               const CryptKey    *privateCryptKey
-                              )
+LOCAL void freeArchiveIndexNode(ArchiveIndexNode *archiveIndexNode, void *userData)
 {
-  Errors error;
+  assert(archiveIndexNode != NULL);
 
-  assert(archiveHandle != NULL);
-  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
-  assert(archiveHandle->archiveCryptInfo != NULL);
-  assert(chunkHeader != NULL);
-  assert(chunkHeader->id == CHUNK_ID_KEY);
+  UNUSED_VARIABLE(userData);
 
-  // check size
-  if (chunkHeader->size < CHUNK_FIXED_SIZE_KEY)
+  switch (archiveIndexNode->type)
   {
-    return ERROR_INVALID_CHUNK_SIZE;
+    case ARCHIVE_ENTRY_TYPE_NONE:
+      break;
+    case ARCHIVE_ENTRY_TYPE_FILE:
+      String_delete(archiveIndexNode->file.name);
+      break;
+    case ARCHIVE_ENTRY_TYPE_IMAGE:
+      String_delete(archiveIndexNode->image.name);
+      break;
+    case ARCHIVE_ENTRY_TYPE_DIRECTORY:
+      String_delete(archiveIndexNode->directory.name);
+      break;
+    case ARCHIVE_ENTRY_TYPE_LINK:
+      String_delete(archiveIndexNode->link.destinationName);
+      String_delete(archiveIndexNode->link.name);
+      break;
+    case ARCHIVE_ENTRY_TYPE_HARDLINK:
+      String_delete(archiveIndexNode->hardlink.name);
+      break;
+    case ARCHIVE_ENTRY_TYPE_SPECIAL:
+      String_delete(archiveIndexNode->special.name);
+      break;
+    case ARCHIVE_ENTRY_TYPE_META:
+      HALT_INTERNAL_ERROR("wrong archive index node type");
+      break;
+    case ARCHIVE_ENTRY_TYPE_SIGNATURE:
+      break;
+    default:
+      #ifndef NDEBUG
+        HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+      #endif /* NDEBUG */
+      break; /* not reached */
   }
-
-  // get last archive crypt info
-  ArchiveCryptInfoNode *archiveCryptInfoNode = LIST_TAIL(&archiveHandle->archiveCryptInfoList);
-  assert(archiveCryptInfoNode != NULL);
-
-  // init key chunk
-  ChunkKey chunkKey;
-  error = Chunk_init(&chunkKey.info,
-                     NULL,  // parentChunkInfo
-                     archiveHandle->chunkIO,
-                     archiveHandle->chunkIOUserData,
-                     CHUNK_ID_KEY,
-                     CHUNK_DEFINITION_KEY,
-//TODO: DEFAULT_ALIGNMENT
-                     0,  // alignment
-                     NULL,  // cryptInfo
-                     &chunkKey
-                    );
-  if (error != ERROR_NONE)
-  {
-    return error;
-  }
-
-  // open key chunk
-  error = Chunk_open(&chunkKey.info,
-                     chunkHeader,
-                     CHUNK_FIXED_SIZE_KEY,
-                     archiveHandle
-                    );
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkKey.info);
-    return error;
-  }
-
-  // read key chunk
-  uint encryptedKeyDataLength = chunkHeader->size-CHUNK_FIXED_SIZE_KEY;
-  void *encryptedKeyData      = malloc(encryptedKeyDataLength);
-  if (encryptedKeyData == NULL)
-  {
-    HALT_INSUFFICIENT_MEMORY();
-  }
-  error = Chunk_readData(&chunkKey.info,
-                         encryptedKeyData,
-                         encryptedKeyDataLength,
-                         NULL  // bytesRead: read all
-                        );
-  if (error != ERROR_NONE)
-  {
-    free(encryptedKeyData);
-    Chunk_close(&chunkKey.info);
-    Chunk_done(&chunkKey.info);
-    return error;
-  }
-
-  // check if all data read
-  if (!Chunk_eofSub(&chunkKey.info))
-  {
-    free(encryptedKeyData);
-    Chunk_close(&chunkKey.info);
-    Chunk_done(&chunkKey.info);
-    return ERRORX_(CORRUPT_DATA,0,"%s",String_cString(archiveHandle->printableStorageName));
-  }
-
-  // close chunk
-  error = Chunk_close(&chunkKey.info);
-  if (error != ERROR_NONE)
-  {
-    free(encryptedKeyData);
-    Chunk_done(&chunkKey.info);
-    return error;
-  }
-  Chunk_done(&chunkKey.info);
-
-  // get decrypt key
-  error = Crypt_getDecryptKey(&archiveCryptInfoNode->archiveCryptInfo.cryptKey,
-                              0,  // keyLength
-                              privateCryptKey,
-                              encryptedKeyData,
-                              encryptedKeyDataLength
-                             );
-  if (error != ERROR_NONE)
-  {
-    free(encryptedKeyData);
-    return error;
-  }
-
-//TODO: not required to store encrypted key when reading archives
-  // set crypt data
-  if (archiveHandle->encryptedKeyData != NULL) free(archiveHandle->encryptedKeyData);
-  archiveHandle->encryptedKeyData       = encryptedKeyData;
-  archiveHandle->encryptedKeyDataLength = encryptedKeyDataLength;
-
-  // set asymmetric crypt type
-  archiveCryptInfoNode->archiveCryptInfo.cryptType = CRYPT_TYPE_ASYMMETRIC;
-
-  // free resources
-
-  return ERROR_NONE;
-}
+}
 
 /***********************************************************************\
-* Name   : writeHeader
-* Purpose: write archive header chunks
-* Input  : archiveHandle - archive handle
+* Name   : freeArchiveSolidMemberNode
+* Purpose: free archive solid block member node
+* Input  : archiveSolidMemberNode - archive solid block member node
+*          userData               - user data (not used)
 * Output : -
-* Return : ERROR_NONE or error code
+* Return : -
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors writeHeader(ArchiveHandle *archiveHandle)
+LOCAL void freeArchiveSolidMemberNode(ArchiveSolidMemberNode *archiveSolidMemberNode, void *userData)
 {
-  Errors error;
-
-  assert(archiveHandle != NULL);
-  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
-  assert(archiveHandle->storageInfo != NULL);
-  assert(archiveHandle->storageInfo->jobOptions != NULL);
-
-  // init BAR chunk
-  ChunkBAR chunkBAR;
-  error = Chunk_init(&chunkBAR.info,
-                     NULL,  // parentChunkInfo
-                     archiveHandle->chunkIO,
-                     archiveHandle->chunkIOUserData,
-                     CHUNK_ID_BAR,
-                     CHUNK_DEFINITION_BAR,
-                     DEFAULT_ALIGNMENT,
-                     NULL,  // cryptInfo
-                     &chunkBAR
-                    );
-  if (error != ERROR_NONE)
-  {
-    return error;
-  }
-
-  // write header chunks
-  error = Chunk_create(&chunkBAR.info);
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkBAR.info);
-    return error;
-  }
-
-  // close chunks
-  error = Chunk_close(&chunkBAR.info);
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkBAR.info);
-    return error;
-  }
+  assert(archiveSolidMemberNode != NULL);
 
-  // free resources
-  Chunk_done(&chunkBAR.info);
+  UNUSED_VARIABLE(userData);
 
-  return ERROR_NONE;
+  File_doneExtendedAttributes(&archiveSolidMemberNode->fileExtendedAttributeList);
+  String_delete(archiveSolidMemberNode->name);
 }
 
 /***********************************************************************\
-* Name   : writeSalt
-* Purpose: write new salt chunk
-* Input  : archiveHandle - archive handle
+* Name   : deleteArchiveIndexNode
+* Purpose: delete archive index node
+* Input  : archiveIndexNode - archive index node to delete
 * Output : -
-* Return : ERROR_NONE or error code
+* Return : -
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors writeSalt(ArchiveHandle   *archiveHandle,
-                       const CryptSalt *cryptSalt
-                      )
+LOCAL void deleteArchiveIndexNode(ArchiveIndexNode *archiveIndexNode)
 {
-  Errors error;
-
-  assert(archiveHandle != NULL);
-  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
-  assert(Semaphore_isOwned(&archiveHandle->lock));
-  assert(archiveHandle->archiveCryptInfo != NULL);
-  assert(cryptSalt != NULL);
-
-  // init key chunk
-  ChunkSalt chunkSalt;
-  error = Chunk_init(&chunkSalt.info,
-                     NULL,  // parentChunkInfo
-                     archiveHandle->chunkIO,
-                     archiveHandle->chunkIOUserData,
-                     CHUNK_ID_SALT,
-                     CHUNK_DEFINITION_SALT,
-//TODO: DEFAULT_ALIGNMENT
-                     0,  // alignment
-                     NULL,  // cryptInfo
-                     &chunkSalt
-                    );
-  if (error != ERROR_NONE)
-  {
-    return error;
-  }
-
-  // get salt
-  assert(sizeof(chunkSalt.salt) == cryptSalt->dataLength);
-  Crypt_getSalt(chunkSalt.salt,sizeof(chunkSalt.salt),cryptSalt);
-
-  // write salt
-  error = Chunk_create(&chunkSalt.info);
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkSalt.info);
-    return error;
-  }
-
-  // close chunk
-  error = Chunk_close(&chunkSalt.info);
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkSalt.info);
-    return error;
-  }
-
-  // free resources
-  Chunk_done(&chunkSalt.info);
+  assert(archiveIndexNode != NULL);
 
-  return ERROR_NONE;
+  freeArchiveIndexNode(archiveIndexNode,NULL);
+  LIST_DELETE_NODE(archiveIndexNode);
 }
 
 /***********************************************************************\
-* Name   : writeEncryptionKey
-* Purpose: write new encryption key chunk
-* Input  : archiveHandle - archive handle
+* Name   : flushArchiveIndexList
+* Purpose: flush archive index list and write to index database
+* Input  : archiveHandle   - archive handle
+*          entityId        - entity index id
+*          storageId       - storage index id
+*          maxIndexEntries - max. entries in list to do flush (0 to
+*                            force flush)
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors writeEncryptionKey(ArchiveHandle *archiveHandle)
+LOCAL Errors flushArchiveIndexList(ArchiveHandle *archiveHandle,
+                                   IndexId       uuidId,
+                                   IndexId       entityId,
+                                   IndexId       storageId,
+                                   uint          maxIndexEntries
+                                  )
 {
-  Errors error;
+  Errors           error;
 
   assert(archiveHandle != NULL);
-  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
-  assert(Semaphore_isOwned(&archiveHandle->lock));
+  assertx(INDEX_TYPE(storageId) == INDEX_TYPE_STORAGE,"storageId=%"PRIi64"",storageId.data);
 
-  // init key chunk
-  ChunkKey chunkKey;
-  error = Chunk_init(&chunkKey.info,
-                     NULL,  // parentChunkInfo
-                     archiveHandle->chunkIO,
-                     archiveHandle->chunkIOUserData,
-                     CHUNK_ID_KEY,
-                     CHUNK_DEFINITION_KEY,
-//TODO: DEFAULT_ALIGNMENT
-                     0,  // alignment
-                     NULL,  // cryptInfo
-                     &chunkKey
-                    );
-  if (error != ERROR_NONE)
-  {
-    return error;
-  }
+  error = ERROR_NONE;
 
-  // write encrypted encryption key
-  error = Chunk_create(&chunkKey.info);
-  if (error != ERROR_NONE)
+  if (Index_isAvailable())
   {
-    Chunk_done(&chunkKey.info);
-    return error;
-  }
-  error = Chunk_writeData(&chunkKey.info,
-                          archiveHandle->encryptedKeyData,
-                          archiveHandle->encryptedKeyDataLength
-                         );
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkKey.info);
-    return error;
-  }
+    // init variables
+    ArchiveIndexList archiveIndexList;
+    List_init(&archiveIndexList,CALLBACK_(NULL,NULL),CALLBACK_((ListNodeFreeFunction)freeArchiveIndexNode,NULL));
 
-  // close chunk
-  error = Chunk_close(&chunkKey.info);
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkKey.info);
-    return error;
-  }
+    // get list to flush
+    SEMAPHORE_LOCKED_DO(&archiveHandle->archiveIndexList.lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+    {
+      if (List_count(&archiveHandle->archiveIndexList) >= maxIndexEntries)
+      {
+        List_move(&archiveIndexList,NULL,&archiveHandle->archiveIndexList,NULL,NULL);
+      }
+    }
 
-  // free resources
-  Chunk_done(&chunkKey.info);
+    // flush list
+    if (!List_isEmpty(&archiveIndexList))
+    {
+      SEMAPHORE_LOCKED_DO(&archiveHandle->indexLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+      {
+        // start transaction
+        error = Index_beginTransaction(&archiveHandle->indexHandle,INDEX_TIMEOUT);
+        if (error == ERROR_NONE)
+        {
+          // add to index
+          while (!List_isEmpty(&archiveIndexList) && (error == ERROR_NONE))
+          {
+            ArchiveIndexNode *archiveIndexNode = (ArchiveIndexNode*)List_removeFirst(&archiveIndexList);
 
-  return ERROR_NONE;
+            switch (archiveIndexNode->type)
+            {
+              case ARCHIVE_ENTRY_TYPE_FILE:
+                error = IndexEntry_addFile(&archiveHandle->indexHandle,
+                                           uuidId,
+                                           entityId,
+                                           storageId,
+                                           archiveIndexNode->file.name,
+                                           archiveIndexNode->file.size,
+                                           archiveIndexNode->file.timeLastAccess,
+                                           archiveIndexNode->file.timeModified,
+                                           archiveIndexNode->file.timeLastChanged,
+                                           archiveIndexNode->file.userId,
+                                           archiveIndexNode->file.groupId,
+                                           archiveIndexNode->file.permission,
+                                           archiveIndexNode->file.fragmentOffset,
+                                           archiveIndexNode->file.fragmentSize,
+                                           archiveIndexNode->archiveOffset
+                                          );
+                break;
+              case ARCHIVE_ENTRY_TYPE_IMAGE:
+                error = IndexEntry_addImage(&archiveHandle->indexHandle,
+                                            uuidId,
+                                            entityId,
+                                            storageId,
+                                            archiveIndexNode->image.name,
+                                            archiveIndexNode->image.fileSystemType,
+                                            archiveIndexNode->image.size,
+                                            archiveIndexNode->image.blockSize,
+                                            archiveIndexNode->image.blockOffset,
+                                            archiveIndexNode->image.blockCount,
+                                            archiveIndexNode->archiveOffset
+                                           );
+                break;
+              case ARCHIVE_ENTRY_TYPE_DIRECTORY:
+                error = IndexEntry_addDirectory(&archiveHandle->indexHandle,
+                                                uuidId,
+                                                entityId,
+                                                storageId,
+                                                archiveIndexNode->directory.name,
+                                                archiveIndexNode->directory.timeLastAccess,
+                                                archiveIndexNode->directory.timeModified,
+                                                archiveIndexNode->directory.timeLastChanged,
+                                                archiveIndexNode->directory.userId,
+                                                archiveIndexNode->directory.groupId,
+                                                archiveIndexNode->directory.permission,
+                                                archiveIndexNode->archiveOffset
+                                               );
+                break;
+              case ARCHIVE_ENTRY_TYPE_LINK:
+                error = IndexEntry_addLink(&archiveHandle->indexHandle,
+                                           uuidId,
+                                           entityId,
+                                           storageId,
+                                           archiveIndexNode->link.name,
+                                           archiveIndexNode->link.destinationName,
+                                           archiveIndexNode->link.timeLastAccess,
+                                           archiveIndexNode->link.timeModified,
+                                           archiveIndexNode->link.timeLastChanged,
+                                           archiveIndexNode->link.userId,
+                                           archiveIndexNode->link.groupId,
+                                           archiveIndexNode->link.permission,
+                                           archiveIndexNode->archiveOffset
+                                          );
+                break;
+              case ARCHIVE_ENTRY_TYPE_HARDLINK:
+                error = IndexEntry_addHardlink(&archiveHandle->indexHandle,
+                                               uuidId,
+                                               entityId,
+                                               storageId,
+                                               archiveIndexNode->hardlink.name,
+                                               archiveIndexNode->hardlink.size,
+                                               archiveIndexNode->hardlink.timeLastAccess,
+                                               archiveIndexNode->hardlink.timeModified,
+                                               archiveIndexNode->hardlink.timeLastChanged,
+                                               archiveIndexNode->hardlink.userId,
+                                               archiveIndexNode->hardlink.groupId,
+                                               archiveIndexNode->hardlink.permission,
+                                               archiveIndexNode->hardlink.fragmentOffset,
+                                               archiveIndexNode->hardlink.fragmentSize,
+                                               archiveIndexNode->archiveOffset
+                                              );
+                break;
+              case ARCHIVE_ENTRY_TYPE_SPECIAL:
+                error = IndexEntry_addSpecial(&archiveHandle->indexHandle,
+                                              uuidId,
+                                              entityId,
+                                              storageId,
+                                              archiveIndexNode->special.name,
+                                              archiveIndexNode->special.specialType,
+                                              archiveIndexNode->special.timeLastAccess,
+                                              archiveIndexNode->special.timeModified,
+                                              archiveIndexNode->special.timeLastChanged,
+                                              archiveIndexNode->special.userId,
+                                              archiveIndexNode->special.groupId,
+                                              archiveIndexNode->special.permission,
+                                              archiveIndexNode->special.major,
+                                              archiveIndexNode->special.minor,
+                                              archiveIndexNode->archiveOffset
+                                             );
+                break;
+              default:
+                #ifndef NDEBUG
+                  HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+                #endif /* NDEBUG */
+                break;
+            }
+
+            deleteArchiveIndexNode(archiveIndexNode);
+          }
+
+          // end/abort transaction
+          if (error == ERROR_NONE)
+          {
+            (void)Index_endTransaction(&archiveHandle->indexHandle);
+          }
+          else
+          {
+            (void)Index_rollbackTransaction(&archiveHandle->indexHandle);
+          }
+        }
+      }
+    }
+
+    // free resources
+    List_done(&archiveIndexList);
+  }
+
+  return error;
 }
 
 /***********************************************************************\
-* Name   : writeMeta
-* Purpose: write archive meta chunks
-* Input  : archiveHandle  - archive handle
-*          cryptAlgorithm - crypt algorithm
+* Name   : autoFlushArchiveIndexList
+* Purpose: auto flush archive index list and write to index database
+* Input  : archiveHandle - archive handle
+*          entityId      - entity index id
+*          storageId     - storage index id
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors writeMeta(ArchiveHandle   *archiveHandle,
-// TODO: multi-crypt
-                       CryptAlgorithms cryptAlgorithm
-                      )
+LOCAL Errors autoFlushArchiveIndexList(ArchiveHandle *archiveHandle,
+                                       IndexId       uuidId,
+                                       IndexId       entityId,
+                                       IndexId       storageId
+                                      )
 {
-  Errors error;
-
   assert(archiveHandle != NULL);
-  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
-  assert(archiveHandle->storageInfo != NULL);
-  assert(archiveHandle->storageInfo->jobOptions != NULL);
-  assert(archiveHandle->archiveCryptInfo != NULL);
+  assertx(INDEX_TYPE(storageId) == INDEX_TYPE_STORAGE,"storageId=%"PRIi64"",storageId.data);
 
-  // get crypt block length
-  uint blockLength = Crypt_getBlockLength(cryptAlgorithm);
+  return flushArchiveIndexList(archiveHandle,uuidId,entityId,storageId,MAX_INDEX_LIST);
+}
 
-  // init meta chunk
-  ChunkMeta chunkMeta;
-  error = Chunk_init(&chunkMeta.info,
-                     NULL,  // parentChunkInfo
-                     archiveHandle->chunkIO,
-                     archiveHandle->chunkIOUserData,
-                     CHUNK_ID_META,
-                     CHUNK_DEFINITION_META,
-                     DEFAULT_ALIGNMENT,
-                     NULL,  // cryptInfo,
-                     &chunkMeta
-                    );
-  if (error != ERROR_NONE)
-  {
-    return error;
-  }
-#ifdef MULTI_CRYPT
-  chunkMeta.cryptAlgorithms[0] = CRYPT_ALGORITHM_TO_CONSTANT(archiveHandle->jobOptions->cryptAlgorithms[0]);
-  chunkMeta.cryptAlgorithms[1] = CRYPT_ALGORITHM_TO_CONSTANT(archiveHandle->jobOptions->cryptAlgorithms[1]);
-  chunkMeta.cryptAlgorithms[2] = CRYPT_ALGORITHM_TO_CONSTANT(archiveHandle->jobOptions->cryptAlgorithms[2]);
-  chunkMeta.cryptAlgorithms[3] = CRYPT_ALGORITHM_TO_CONSTANT(archiveHandle->jobOptions->cryptAlgorithms[3]);
-#else
-  chunkMeta.cryptAlgorithms[0] = CRYPT_ALGORITHM_TO_CONSTANT(cryptAlgorithm);
-  chunkMeta.cryptAlgorithms[1] = CRYPT_ALGORITHM_NONE;
-  chunkMeta.cryptAlgorithms[2] = CRYPT_ALGORITHM_NONE;
-  chunkMeta.cryptAlgorithms[3] = CRYPT_ALGORITHM_NONE;
-#endif
+/***********************************************************************\
+* Name   : addArchiveIndexNode
+* Purpose: add archive index node and flush
+* Input  : archiveHandle    - archive handle
+*          archiveIndexNode - archive index node
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
 
-  // init crypt
-  CryptInfo cryptInfo;
-  error = Crypt_init(&cryptInfo,
-//TODO: MULTI_CRYPT
-                     archiveHandle->storageInfo->jobOptions->cryptAlgorithms[0],
-                     CRYPT_MODE_CBC_,
-                     &archiveHandle->archiveCryptInfo->cryptSalt,
-                     &archiveHandle->archiveCryptInfo->cryptKey
-                    );
-  if (error != ERROR_NONE)
+LOCAL void addArchiveIndexNode(ArchiveHandle *archiveHandle, ArchiveIndexNode *archiveIndexNode)
+{
+  assert(archiveHandle != NULL);
+
+  SEMAPHORE_LOCKED_DO(&archiveHandle->archiveIndexList.lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
   {
-    Chunk_done(&chunkMeta.info);
-    return error;
+    List_append(&archiveHandle->archiveIndexList,archiveIndexNode);
   }
-  DEBUG_TESTCODE() { Crypt_done(&cryptInfo); return DEBUG_TESTCODE_ERROR(); }
-
-  // init meta entry chunk
-  ChunkMetaEntry chunkMetaEntry;
-  error = Chunk_init(&chunkMetaEntry.info,
-                     &chunkMeta.info,
-                     CHUNK_USE_PARENT,
-                     CHUNK_USE_PARENT,
-                     CHUNK_ID_META_ENTRY,
-                     CHUNK_DEFINITION_META_ENTRY,
-                     blockLength,
-                     &cryptInfo,
-                     &chunkMetaEntry
-                    );
-  if (error != ERROR_NONE)
-  {
-    Crypt_done(&cryptInfo);
-    Chunk_done(&chunkMeta.info);
-    return error;
-  }
-  Network_getHostName(chunkMetaEntry.hostName);
-  Misc_getCurrentUserName(chunkMetaEntry.userName);
-  String_set(chunkMetaEntry.jobUUID,archiveHandle->jobUUID);
-  String_set(chunkMetaEntry.entityUUID,archiveHandle->entityUUID);
-  chunkMetaEntry.archiveType     = archiveHandle->archiveType;
-  chunkMetaEntry.createdDateTime = Misc_getCurrentDateTime();
-  convertSystemToUTF8Encoding(chunkMetaEntry.comment,archiveHandle->storageInfo->jobOptions->comment);
-
-  // write meta chunks
-  error = Chunk_create(&chunkMeta.info);
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkMetaEntry.info);
-    Crypt_done(&cryptInfo);
-    Chunk_done(&chunkMeta.info);
-    return error;
-  }
-  error = Chunk_create(&chunkMetaEntry.info);
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkMetaEntry.info);
-    Crypt_done(&cryptInfo);
-    Chunk_done(&chunkMeta.info);
-    return error;
-  }
-
-  // close chunks
-  error = Chunk_close(&chunkMetaEntry.info);
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkMetaEntry.info);
-    Crypt_done(&cryptInfo);
-    Chunk_done(&chunkMeta.info);
-    return error;
-  }
-  error = Chunk_close(&chunkMeta.info);
-  if (error != ERROR_NONE)
-  {
-    Chunk_done(&chunkMetaEntry.info);
-    Crypt_done(&cryptInfo);
-    Chunk_done(&chunkMeta.info);
-    return error;
-  }
-
-  // free resources
-  Chunk_done(&chunkMetaEntry.info);
-  Crypt_done(&cryptInfo);
-  Chunk_done(&chunkMeta.info);
-
-  return ERROR_NONE;
-}
+}
 
 /***********************************************************************\
-* Name   : writeSignature
-* Purpose: write new signature chunk
-* Input  : archiveHandle - archive handle
+* Name   : indexAddFile
+* Purpose: add file index node
+* Input  : archiveHandle   - archive handle
+*          name            - name
+*          size            - size [bytes]
+*          timeLastAccess  - last access date/time stamp [s]
+*          timeModified    - modified date/time stamp [s]
+*          timeLastChanged - last changed date/time stamp [s]
+*          userId          - user id
+*          groupId         - group id
+*          permission      - permission flags
+*          fragmentOffset  - fragment offset [bytes]
+*          fragmentSize    - fragment size [bytes]
+*          archiveOffset   - offset of entry chunks in archive [bytes]
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors writeSignature(ArchiveHandle *archiveHandle,
-                            const Key     *signaturePrivateKey
-                           )
+LOCAL Errors indexAddFile(ArchiveHandle *archiveHandle,
+                          ConstString   name,
+                          uint64        size,
+                          uint64        timeLastAccess,
+                          uint64        timeModified,
+                          uint64        timeLastChanged,
+                          uint32        userId,
+                          uint32        groupId,
+                          uint32        permission,
+                          uint64        fragmentOffset,
+                          uint64        fragmentSize,
+                          uint64        archiveOffset
+                         )
 {
-  Errors error;
-
   assert(archiveHandle != NULL);
-  assert(archiveHandle->chunkIO != NULL);
-  assert(archiveHandle->chunkIO->tell != NULL);
-  assert(signaturePrivateKey != NULL);
+  assert(name != NULL);
 
-  if (Configuration_isKeyAvailable(signaturePrivateKey))
+  ArchiveIndexNode *archiveIndexNode = LIST_NEW_NODE(ArchiveIndexNode);
+  if (archiveIndexNode == NULL)
   {
-    // init variables
-    AutoFreeList autoFreeList;
-    AutoFree_init(&autoFreeList);
-
-    // init signature hash
-    CryptHash signatureHash;
-    error = Crypt_initHash(&signatureHash,SIGNATURE_HASH_ALGORITHM);
-    if (error != ERROR_NONE)
-    {
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-    AUTOFREE_ADD(&autoFreeList,&signatureHash,{ Crypt_doneHash(&signatureHash); });
-
-    // get signature hash (Note: signature is also calculate from begin of archive)
-    uint64 index;
-    error = archiveHandle->chunkIO->tell(archiveHandle->chunkIOUserData,&index);
-    if (error != ERROR_NONE)
-    {
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-    error = calculateHash(archiveHandle->chunkIO,
-                          archiveHandle->chunkIOUserData,
-                          &signatureHash,
-                          0LL,  // start
-                          index
-                         );
-    if (error != ERROR_NONE)
-    {
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-/*
-TODO: support dynamic hash length?
-    hashLength = Crypt_getHashLength(&signatureHash);
-    hash = malloc(hashLength);
-    if (hash == NULL)
-    {
-      AutoFree_cleanup(&autoFreeList);
-      return ERROR_INSUFFICIENT_MEMORY;
-    }
-    AUTOFREE_ADD(&autoFreeList,hash,{ free(hash); });
-*/
-    byte hash[MAX_HASH_SIZE];
-    uint hashLength;
-    Crypt_getHash(&signatureHash,hash,sizeof(hash),&hashLength);
-//fprintf(stderr,"%s, %d: write signature\n",__FILE__,__LINE__); debugDumpMemory(hash,hashLength,0);
-
-    // get signature
-    CryptKey privateSignatureKey;
-    byte     signature[MAX_HASH_SIZE];
-    uint     signatureLength;
-    Crypt_initKey(&privateSignatureKey,CRYPT_PADDING_TYPE_NONE);
-    error = Crypt_setPublicPrivateKeyData(&privateSignatureKey,
-                                          signaturePrivateKey->data,
-                                          signaturePrivateKey->length,
-                                          CRYPT_MODE_CBC_|CRYPT_MODE_CTS_,
-                                          CRYPT_KEY_DERIVE_NONE,
-                                          NULL,  // salt
-                                          NULL  // password
-                                         );
-    if (error == ERROR_NONE)
-    {
-      error = Crypt_getSignature(signature,
-                                 sizeof(signature),
-                                 &signatureLength,
-                                 &privateSignatureKey,
-                                 hash,
-                                 hashLength
-                                );
-    }
-    Crypt_doneKey(&privateSignatureKey);
-    if (error != ERROR_NONE)
-    {
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-    assert(signatureLength <= sizeof(signature));
-
-    // init signature chunk
-    ChunkSignature chunkSignature;
-    error = Chunk_init(&chunkSignature.info,
-                       NULL,  // parentChunkInfo
-                       archiveHandle->chunkIO,
-                       archiveHandle->chunkIOUserData,
-                       CHUNK_ID_SIGNATURE,
-                       CHUNK_DEFINITION_SIGNATURE,
-                       DEFAULT_ALIGNMENT,
-                       NULL,  // cryptInfo
-                       &chunkSignature
-                      );
-    if (error != ERROR_NONE)
-    {
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-    chunkSignature.hashAlgorithm = SIGNATURE_HASH_ALGORITHM;
-    chunkSignature.value.data    = signature;
-    chunkSignature.value.length  = signatureLength;
-    AUTOFREE_ADD(&autoFreeList,&chunkSignature.info,{ Chunk_done(&chunkSignature.info); });
-
-    // write signature chunk
-    error = Chunk_create(&chunkSignature.info);
-    if (error != ERROR_NONE)
-    {
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-    error = Chunk_close(&chunkSignature.info);
-    if (error != ERROR_NONE)
-    {
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-
-    // free resources
-    Chunk_done(&chunkSignature.info);
-    Crypt_doneHash(&signatureHash);
-    AutoFree_done(&autoFreeList);
+    HALT_INSUFFICIENT_MEMORY();
   }
+  archiveIndexNode->type                 = ARCHIVE_ENTRY_TYPE_FILE;
+  archiveIndexNode->archiveOffset        = archiveOffset;
+  archiveIndexNode->file.name            = String_duplicate(name);
+  archiveIndexNode->file.size            = size;
+  archiveIndexNode->file.timeLastAccess  = timeLastAccess;
+  archiveIndexNode->file.timeModified    = timeModified;
+  archiveIndexNode->file.timeLastChanged = timeLastChanged;
+  archiveIndexNode->file.userId          = userId;
+  archiveIndexNode->file.groupId         = groupId;
+  archiveIndexNode->file.permission      = permission;
+  archiveIndexNode->file.fragmentOffset  = fragmentOffset;
+  archiveIndexNode->file.fragmentSize    = fragmentSize;
+  addArchiveIndexNode(archiveHandle,archiveIndexNode);
 
   return ERROR_NONE;
 }
 
 /***********************************************************************\
-* Name   : createArchiveFile
-* Purpose: create and open new archive file
-* Input  : archiveHandle - archive handle
+* Name   : indexAddImage
+* Purpose: add image index node
+* Input  : archiveHandle  - archive handle
+*          imageName      - image name
+*          fileSystemType - file system type
+*          size           - size [bytes]
+*          blockSize      - block size [bytes]
+*          blockOffset    - block offset [blocks]
+*          blockCount     - number of blocks
+*          archiveOffset  - offset of entry chunks in archive [bytes]
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors createArchiveFile(ArchiveHandle *archiveHandle)
+LOCAL Errors indexAddImage(ArchiveHandle   *archiveHandle,
+                           ConstString     name,
+                           FileSystemTypes fileSystemType,
+                           int64           size,
+                           ulong           blockSize,
+                           uint64          blockOffset,
+                           uint64          blockCount,
+                           uint64          archiveOffset
+                          )
 {
-  Errors error;
-
   assert(archiveHandle != NULL);
-  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
-  assert(archiveHandle->storageInfo != NULL);
-  assert(archiveHandle->storageInfo->jobOptions != NULL);
-  assert(archiveHandle->archiveCryptInfo != NULL);
-  assert(archiveHandle->mode == ARCHIVE_MODE_CREATE);
-  assert(Semaphore_isOwned(&archiveHandle->lock));
+  assert(name != NULL);
 
-  if (!archiveHandle->create.openFlag)
+  ArchiveIndexNode *archiveIndexNode = LIST_NEW_NODE(ArchiveIndexNode);
+  if (archiveIndexNode == NULL)
   {
-    // init variables
-    AutoFreeList autoFreeList;
-    AutoFree_init(&autoFreeList);
-
-    SEMAPHORE_LOCKED_DO(&archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
-    {
-      AUTOFREE_ADD(&autoFreeList,&archiveHandle->lock,{ Semaphore_unlock(&archiveHandle->lock); });
-
-      // create intermediate data filename
-      error = File_getTmpFileName(archiveHandle->create.tmpFileName,"archive",tmpDirectory);
-      if (error != ERROR_NONE)
-      {
-        AutoFree_cleanup(&autoFreeList);
-        return error;
-      }
-      AUTOFREE_ADD(&autoFreeList,&archiveHandle->create.tmpFileName,{ File_delete(archiveHandle->create.tmpFileName,FALSE); });
-      DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
-
-      // create temporary file
-      error = File_open(&archiveHandle->create.tmpFileHandle,
-                        archiveHandle->create.tmpFileName,
-                        FILE_OPEN_CREATE
-                       );
-      if (error != ERROR_NONE)
-      {
-        AutoFree_cleanup(&autoFreeList);
-        return error;
-      }
-      AUTOFREE_ADD(&autoFreeList,&archiveHandle->create.tmpFileHandle,{ File_close(&archiveHandle->create.tmpFileHandle); });
-      DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
-
-      // write header
-      error = writeHeader(archiveHandle);
-      if (error != ERROR_NONE)
-      {
-        AutoFree_cleanup(&autoFreeList);
-        return error;
-      }
-      DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
-
-      // write salt if encryption enabled
-      if (   IS_SET(archiveHandle->archiveFlags,ARCHIVE_FLAG_CREATE_SALT)
-          && (archiveHandle->archiveCryptInfo->cryptType != CRYPT_TYPE_NONE)
-         )
-      {
-        // write salt
-        error = writeSalt(archiveHandle,
-                          &archiveHandle->archiveCryptInfo->cryptSalt
-                         );
-        if (error != ERROR_NONE)
-        {
-          AutoFree_cleanup(&autoFreeList);
-          return error;
-        }
-        DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
-      }
-
-      // write encrypted key if asymmetric encryption enabled
-      if (   IS_SET(archiveHandle->archiveFlags,ARCHIVE_FLAG_CREATE_KEY)
-          && (archiveHandle->archiveCryptInfo->cryptType == CRYPT_TYPE_ASYMMETRIC)
-         )
-      {
-        // write encrypted key
-        error = writeEncryptionKey(archiveHandle);
-        if (error != ERROR_NONE)
-        {
-          AutoFree_cleanup(&autoFreeList);
-          return error;
-        }
-        DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
-      }
-
-      if (IS_SET(archiveHandle->archiveFlags,ARCHIVE_FLAG_CREATE_META))
-      {
-        // write meta data
-        error = writeMeta(archiveHandle,
-                          archiveHandle->storageInfo->jobOptions->cryptAlgorithms[0]
-                         );
-        if (error != ERROR_NONE)
-        {
-          AutoFree_cleanup(&autoFreeList);
-          return error;
-        }
-        DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
-      }
-
-      if (   Index_isAvailable()
-          && !archiveHandle->storageInfo->jobOptions->noIndexDatabaseFlag
-          && !archiveHandle->storageInfo->jobOptions->noStorage
-          && !archiveHandle->storageInfo->jobOptions->dryRun
-         )
-      {
-        // create storage index
-        SEMAPHORE_LOCKED_DO(&archiveHandle->indexLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
-        {
-          error = IndexStorage_new(&archiveHandle->indexHandle,
-                                   archiveHandle->uuidId,
-                                   archiveHandle->entityId,
-                                   archiveHandle->hostName,
-                                   archiveHandle->userName,
-                                   NULL,  // storageName
-                                   Misc_getCurrentDateTime(),  // created
-                                   0LL,  // size
-                                   INDEX_STATE_CREATE,
-                                   INDEX_MODE_AUTO,
-                                   &archiveHandle->storageId
-                                  );
-          if (error != ERROR_NONE)
-          {
-            Semaphore_unlock(&archiveHandle->indexLock);
-            AutoFree_cleanup(&autoFreeList);
-            return error;
-          }
-        }
-        AUTOFREE_ADD(&autoFreeList,&archiveHandle->storageId,
-        {
-          SEMAPHORE_LOCKED_DO(&archiveHandle->indexLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
-          {
-            (void)IndexStorage_purge(&archiveHandle->indexHandle,
-                                     archiveHandle->storageId,
-                                     NULL  // progressInfo
-                                    );
-          }
-        });
-      }
-      else
-      {
-        // no index
-        archiveHandle->storageId = INDEX_ID_NONE;
-      }
-
-      // call-back for init archive
-      if (archiveHandle->archiveInitFunction != NULL)
-      {
-        error = archiveHandle->archiveInitFunction(archiveHandle->storageInfo,
-                                                   archiveHandle->uuidId,
-                                                   archiveHandle->jobUUID,
-                                                   archiveHandle->entityUUID,
-                                                   archiveHandle->entityId,
-                                                   archiveHandle->archiveType,
-                                                   archiveHandle->storageId,
-                                                   isSplittedArchive(archiveHandle)
-                                                     ? (int)archiveHandle->partNumber
-                                                     : ARCHIVE_PART_NUMBER_NONE,
-                                                   archiveHandle->archiveInitUserData
-                                                  );
-        if (error != ERROR_NONE)
-        {
-          AutoFree_cleanup(&autoFreeList);
-          return error;
-        }
-        DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
-      }
-
-      // mark create archive file "open"
-      archiveHandle->create.openFlag = TRUE;
-    }
-
-    // free resources
-    AutoFree_done(&autoFreeList);
+    HALT_INSUFFICIENT_MEMORY();
   }
+  archiveIndexNode->type                  = ARCHIVE_ENTRY_TYPE_IMAGE;
+  archiveIndexNode->archiveOffset         = archiveOffset;
+  archiveIndexNode->image.name            = String_duplicate(name);
+  archiveIndexNode->image.fileSystemType  = fileSystemType;
+  archiveIndexNode->image.size            = size;
+  archiveIndexNode->image.blockSize       = blockSize;
+  archiveIndexNode->image.blockOffset     = blockOffset;
+  archiveIndexNode->image.blockCount      = blockCount;
+  addArchiveIndexNode(archiveHandle,archiveIndexNode);
 
   return ERROR_NONE;
 }
 
 /***********************************************************************\
-* Name   : closeArchiveFile
-* Purpose: close archive file
-* Input  : archiveHandle - archive handle
-* Output : storageId            - storage index id
-*          intermediateFileName - intermediate file name
-*          partNumber           - part number
-*          archiveSize          - archive size [bytes]
+* Name   : indexAddDirectory
+* Purpose: add directory index node
+* Input  : archiveHandle   - archive handle
+*          directoryName   - name
+*          timeLastAccess  - last access date/time stamp [s]
+*          timeModified    - modified date/time stamp [s]
+*          timeLastChanged - last changed date/time stamp [s]
+*          userId          - user id
+*          groupId         - group id
+*          permission      - permission flags
+*          archiveOffset   - offset of entry chunks in archive [bytes]
+* Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors closeArchiveFile(ArchiveHandle *archiveHandle,
-                              IndexId       *storageId,
-                              String        intermediateFileName,
-                              int           *partNumber,
-                              uint64        *archiveSize
-                             )
+LOCAL Errors indexAddDirectory(ArchiveHandle *archiveHandle,
+                               String        name,
+                               uint64        timeLastAccess,
+                               uint64        timeModified,
+                               uint64        timeLastChanged,
+                               uint32        userId,
+                               uint32        groupId,
+                               uint32        permission,
+                               uint64        archiveOffset
+                              )
 {
-  Errors error;
-
   assert(archiveHandle != NULL);
-  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
-  assert(archiveHandle->storageInfo != NULL);
-  assert(archiveHandle->storageInfo->jobOptions != NULL);
-  assert(archiveHandle->mode == ARCHIVE_MODE_CREATE);
-  assert(Semaphore_isOwned(&archiveHandle->lock));
-  assert(storageId != NULL);
-  assert(intermediateFileName != NULL);
-  assert(partNumber != NULL);
-  assert(archiveSize != NULL);
-
-  // init variables
-  (*storageId)   = INDEX_ID_NONE;
-  String_clear(intermediateFileName);
-  (*partNumber)  = ARCHIVE_PART_NUMBER_NONE;
-  (*archiveSize) = 0LL;
+  assert(name != NULL);
 
-  // flush index entries
-  if (!INDEX_ID_IS_NONE(archiveHandle->storageId))
+  ArchiveIndexNode *archiveIndexNode = LIST_NEW_NODE(ArchiveIndexNode);
+  if (archiveIndexNode == NULL)
   {
-    error = flushArchiveIndexList(archiveHandle,
-                                  archiveHandle->uuidId,
-                                  archiveHandle->entityId,
-                                  archiveHandle->storageId,
-                                  0
-                                 );
-    if (error != ERROR_NONE)
-    {
-      (void)File_close(&archiveHandle->create.tmpFileHandle);
-      archiveHandle->create.openFlag = FALSE;
-      return error;
-    }
+    HALT_INSUFFICIENT_MEMORY();
   }
+  archiveIndexNode->type                      = ARCHIVE_ENTRY_TYPE_DIRECTORY;
+  archiveIndexNode->archiveOffset             = archiveOffset;
+  archiveIndexNode->directory.name            = String_duplicate(name);
+  archiveIndexNode->directory.timeLastAccess  = timeLastAccess;
+  archiveIndexNode->directory.timeModified    = timeModified;
+  archiveIndexNode->directory.timeLastChanged = timeLastChanged;
+  archiveIndexNode->directory.userId          = userId;
+  archiveIndexNode->directory.groupId         = groupId;
+  archiveIndexNode->directory.permission      = permission;
+  addArchiveIndexNode(archiveHandle,archiveIndexNode);
 
-  if (archiveHandle->create.openFlag)
-  {
-    // add signature
-    if (!archiveHandle->storageInfo->jobOptions->noSignatureFlag)
-    {
-      error = writeSignature(archiveHandle,
-                             &globalOptions.signaturePrivateKey
-                            );
-      if (error != ERROR_NONE)
-      {
-        (void)File_close(&archiveHandle->create.tmpFileHandle);
-        archiveHandle->create.openFlag = FALSE;
-        return error;
-      }
-    }
-
-    // get size
-    (*archiveSize) = Archive_getSize(archiveHandle);
-
-    // close file
-    (void)File_close(&archiveHandle->create.tmpFileHandle);
+  return ERROR_NONE;
+}
 
-    // mark created archive file "closed"
-    archiveHandle->create.openFlag = FALSE;
+/***********************************************************************\
+* Name   : indexAddLink
+* Purpose: add link index node
+* Input  : archiveHandle   - archive handle
+*          name            - link name
+*          destinationName - destination name
+*          timeLastAccess  - last access date/time stamp [s]
+*          timeModified    - modified date/time stamp [s]
+*          timeLastChanged - last changed date/time stamp [s]
+*          userId          - user id
+*          groupId         - group id
+*          permission      - permission flags
+*          archiveOffset   - offset of entry chunks in archive [bytes]
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
 
-    // get archive file data, increment part number
-    (*storageId) = archiveHandle->storageId;
-    String_set(intermediateFileName,archiveHandle->create.tmpFileName);
-    if (isSplittedArchive(archiveHandle))
-    {
-      (*partNumber) = archiveHandle->partNumber;
-      archiveHandle->partNumber++;
-    }
+LOCAL Errors indexAddLink(ArchiveHandle *archiveHandle,
+                          ConstString   name,
+                          ConstString   destinationName,
+                          uint64        timeLastAccess,
+                          uint64        timeModified,
+                          uint64        timeLastChanged,
+                          uint32        userId,
+                          uint32        groupId,
+                          uint32        permission,
+                          uint64        archiveOffset
+                         )
+{
+  assert(archiveHandle != NULL);
+  assert(name != NULL);
+  assert(destinationName != NULL);
+
+  ArchiveIndexNode *archiveIndexNode = LIST_NEW_NODE(ArchiveIndexNode);
+  if (archiveIndexNode == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
   }
+  archiveIndexNode->type                 = ARCHIVE_ENTRY_TYPE_LINK;
+  archiveIndexNode->archiveOffset        = archiveOffset;
+  archiveIndexNode->link.name            = String_duplicate(name);
+  archiveIndexNode->link.destinationName = String_duplicate(destinationName);
+  archiveIndexNode->link.timeLastAccess  = timeLastAccess;
+  archiveIndexNode->link.timeModified    = timeModified;
+  archiveIndexNode->link.timeLastChanged = timeLastChanged;
+  archiveIndexNode->link.userId          = userId;
+  archiveIndexNode->link.groupId         = groupId;
+  archiveIndexNode->link.permission      = permission;
+  addArchiveIndexNode(archiveHandle,archiveIndexNode);
 
   return ERROR_NONE;
 }
 
 /***********************************************************************\
-* Name   : storeArchiveFile
-* Purpose: store archive file
-* Input  : archiveHandle        - archive handle
-*          storageId            - storage index id
-*          intermediateFileName - intermediate file name
-*          partNumber           - part number
-*          archiveSize          - archive size [bytes]
+* Name   : indexAddHardlink
+* Purpose: add hardlink index node
+* Input  : archiveHandle   - archive handle
+*          name            - name
+*          size            - size [bytes]
+*          timeLastAccess  - last access date/time stamp [s]
+*          timeModified    - modified date/time stamp [s]
+*          timeLastChanged - last changed date/time stamp [s]
+*          userId          - user id
+*          groupId         - group id
+*          permission      - permission flags
+*          fragmentOffset  - fragment offset [bytes]
+*          fragmentSize    - fragment size [bytes]
+*          archiveOffset   - offset of entry chunks in archive [bytes]
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors storeArchiveFile(ArchiveHandle *archiveHandle,
-                              IndexId       storageId,
-                              ConstString   intermediateFileName,
-                              int           partNumber,
-                              uint64        archiveSize
+LOCAL Errors indexAddHardlink(ArchiveHandle *archiveHandle,
+                              ConstString   name,
+                              uint64        size,
+                              uint64        timeLastAccess,
+                              uint64        timeModified,
+                              uint64        timeLastChanged,
+                              uint32        userId,
+                              uint32        groupId,
+                              uint32        permission,
+                              uint64        fragmentOffset,
+                              uint64        fragmentSize,
+                              uint64        archiveOffset
                              )
 {
-  Errors error;
-
   assert(archiveHandle != NULL);
+  assert(name != NULL);
 
-  // call-back to test intermediate archive
-  if (archiveHandle->archiveTestFunction != NULL)
+  ArchiveIndexNode *archiveIndexNode = LIST_NEW_NODE(ArchiveIndexNode);
+  if (archiveIndexNode == NULL)
   {
-    error = archiveHandle->archiveTestFunction(archiveHandle->storageInfo,
-                                                archiveHandle->jobUUID,
-                                                archiveHandle->entityUUID,
-                                                partNumber,
-                                                intermediateFileName,
-                                                archiveSize,
-                                                archiveHandle->archiveTestUserData
-                                               );
-    if (error != ERROR_NONE)
-    {
-      return error;
-    }
-    DEBUG_TESTCODE() { return DEBUG_TESTCODE_ERROR(); }
+    HALT_INSUFFICIENT_MEMORY();
   }
+  archiveIndexNode->type                     = ARCHIVE_ENTRY_TYPE_HARDLINK;
+  archiveIndexNode->archiveOffset            = archiveOffset;
+  archiveIndexNode->hardlink.name            = String_duplicate(name);
+  archiveIndexNode->hardlink.size            = size;
+  archiveIndexNode->hardlink.timeLastAccess  = timeLastAccess;
+  archiveIndexNode->hardlink.timeModified    = timeModified;
+  archiveIndexNode->hardlink.timeLastChanged = timeLastChanged;
+  archiveIndexNode->hardlink.userId          = userId;
+  archiveIndexNode->hardlink.groupId         = groupId;
+  archiveIndexNode->hardlink.permission      = permission;
+  archiveIndexNode->hardlink.fragmentOffset  = fragmentOffset;
+  archiveIndexNode->hardlink.fragmentSize    = fragmentSize;
+  addArchiveIndexNode(archiveHandle,archiveIndexNode);
 
-  // call-back to store archive
-  if (archiveHandle->archiveStoreFunction != NULL)
-  {
-    error = archiveHandle->archiveStoreFunction(archiveHandle->storageInfo,
-                                                archiveHandle->uuidId,
-                                                archiveHandle->jobUUID,
-                                                archiveHandle->entityUUID,
-                                                archiveHandle->entityId,
-                                                storageId,
-                                                partNumber,
-                                                intermediateFileName,
-                                                archiveSize,
-                                                archiveHandle->archiveStoreUserData
-                                               );
-    if (error != ERROR_NONE)
-    {
-      return error;
-    }
-    DEBUG_TESTCODE() { return DEBUG_TESTCODE_ERROR(); }
-  }
+  return ERROR_NONE;
+}
 
-  // call-back for done archive
-  if (archiveHandle->archiveDoneFunction != NULL)
+/***********************************************************************\
+* Name   : indexAddSpecial
+* Purpose: add special index node
+* Input  : archiveHandle   - archive handle
+*          name            - name
+*          specialType     - special type; see FileSpecialTypes
+*          timeLastAccess  - last access date/time stamp [s]
+*          timeModified    - modified date/time stamp [s]
+*          timeLastChanged - last changed date/time stamp [s]
+*          userId          - user id
+*          groupId         - group id
+*          permission      - permission flags
+*          major,minor     - major,minor number
+*          archiveOffset   - offset of entry chunks in archive [bytes]
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors indexAddSpecial(ArchiveHandle    *archiveHandle,
+                             ConstString      name,
+                             FileSpecialTypes specialType,
+                             uint64           timeLastAccess,
+                             uint64           timeModified,
+                             uint64           timeLastChanged,
+                             uint32           userId,
+                             uint32           groupId,
+                             uint32           permission,
+                             uint32           major,
+                             uint32           minor,
+                             uint64           archiveOffset
+                            )
+{
+  assert(archiveHandle != NULL);
+  assert(name != NULL);
+
+  ArchiveIndexNode *archiveIndexNode = LIST_NEW_NODE(ArchiveIndexNode);
+  if (archiveIndexNode == NULL)
   {
-    error = archiveHandle->archiveDoneFunction(archiveHandle->storageInfo,
-                                               archiveHandle->uuidId,
-                                               archiveHandle->jobUUID,
-                                               archiveHandle->entityUUID,
-                                               archiveHandle->entityId,
-                                               archiveHandle->archiveType,
-                                               storageId,
-                                               partNumber,
-                                               archiveHandle->archiveDoneUserData
-                                              );
-    if (error != ERROR_NONE)
-    {
-      return error;
-    }
-    DEBUG_TESTCODE() { return DEBUG_TESTCODE_ERROR(); }
+    HALT_INSUFFICIENT_MEMORY();
   }
+  archiveIndexNode->type                    = ARCHIVE_ENTRY_TYPE_SPECIAL;
+  archiveIndexNode->archiveOffset           = archiveOffset;
+  archiveIndexNode->special.name            = String_duplicate(name);
+  archiveIndexNode->special.specialType     = specialType;
+  archiveIndexNode->special.timeLastAccess  = timeLastAccess;
+  archiveIndexNode->special.timeModified    = timeModified;
+  archiveIndexNode->special.timeLastChanged = timeLastChanged;
+  archiveIndexNode->special.userId          = userId;
+  archiveIndexNode->special.groupId         = groupId;
+  archiveIndexNode->special.permission      = permission;
+  archiveIndexNode->special.major           = major;
+  archiveIndexNode->special.minor           = minor;
+  addArchiveIndexNode(archiveHandle,archiveIndexNode);
 
   return ERROR_NONE;
 }
 
+// ----------------------------------------------------------------------
+
 /***********************************************************************\
-* Name   : ensureArchiveSpace
-* Purpose: ensure space is available in archive for not fragmented
-*          writing
+* Name   : readHeader
+* Purpose: read header
 * Input  : archiveHandle - archive handle
-*          minBytes      - minimal number of bytes
+*          chunkHeader - key chunk header
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors ensureArchiveSpace(ArchiveHandle *archiveHandle,
-                                ulong         minBytes
-                               )
+LOCAL Errors readHeader(ArchiveHandle     *archiveHandle,
+                        const ChunkHeader *chunkHeader
+                       )
 {
   Errors error;
 
   assert(archiveHandle != NULL);
   DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
-  assert(archiveHandle->mode == ARCHIVE_MODE_CREATE);
-  assert(Semaphore_isOwned(&archiveHandle->lock));
+  assert(chunkHeader != NULL);
+  assert(chunkHeader->id == CHUNK_ID_BAR);
 
-  // check if split is necessary
-  if (isNewPartNeeded(archiveHandle,
-                      minBytes
-                     )
-     )
+  // init BAR chunk
+  ChunkBAR chunkBAR;
+  error = Chunk_init(&chunkBAR.info,
+                     NULL,  // parentChunkInfo
+                     archiveHandle->chunkIO,
+                     archiveHandle->chunkIOUserData,
+                     CHUNK_ID_BAR,
+                     CHUNK_DEFINITION_BAR,
+//TODO: DEFAULT_ALIGNMENT
+                     0,  // alignment
+                     NULL,  // cryptInfo
+                     &chunkBAR
+                    );
+  if (error != ERROR_NONE)
   {
-    // split needed -> close created archive file
-    if (archiveHandle->create.openFlag)
-    {
-      // init variables
-      String intermediateFileName = String_new();
+    return error;
+  }
 
-      // close archive file
-      IndexId storageId;
-      int     partNumber;
-      uint64  archiveSize;
-      error = closeArchiveFile(archiveHandle,
-                               &storageId,
-                               intermediateFileName,
-                               &partNumber,
-                               &archiveSize
+  // init new crypt info (Note: older BAR version use CTS+simple key derivation)
+  error = initArchiveCryptInfo(archiveHandle,
+                               CRYPT_TYPE_NONE,
+                               CRYPT_MODE_CTS_,
+                               CRYPT_KEY_DERIVE_SIMPLE
                               );
-      if (error != ERROR_NONE)
-      {
-        String_delete(intermediateFileName);
-        return error;
-      }
-
-// TODO: activate when removed IndexStorage_updateInfos() from commands_create.c
-#if 0
-      // update index aggregates
-      if (archiveHandle->indexHandle != NULL)
-      {
-      error = IndexStorage_updateInfos(archiveHandle->indexHandle,
-                                       storageId
-                                      );
-      if (error != ERROR_NONE)
-      {
-        String_delete(intermediateFileName);
-        return error;
-      }
-      }
-#endif
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkBAR.info);
+    return error;
+  }
 
-      // store archive file
-      error = storeArchiveFile(archiveHandle,
-                               storageId,
-                               intermediateFileName,
-                               partNumber,
-                               archiveSize
-                              );
-      if (error != ERROR_NONE)
-      {
-        (void)File_delete(intermediateFileName,FALSE);
-        String_delete(intermediateFileName);
-        return error;
-      }
+  // read BAR chunk
+  error = Chunk_open(&chunkBAR.info,
+                     chunkHeader,
+                     chunkHeader->size,
+                     archiveHandle
+                    );
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkBAR.info);
+    return error;
+  }
 
-      // free resources
-      String_delete(intermediateFileName);
-    }
+  // close chunk
+  error = Chunk_close(&chunkBAR.info);
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkBAR.info);
+    return error;
   }
+  Chunk_done(&chunkBAR.info);
 
   return ERROR_NONE;
 }
 
 /***********************************************************************\
-* Name   : transferToArchive
-* Purpose: transfer file data from temporary file to archive, update
-*          signature hash
+* Name   : readSalt
+* Purpose: read salt
 * Input  : archiveHandle - archive handle
-*          fileHandle    - file handle of temporary file
+*          chunkHeader   - key chunk header
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors transferToArchive(const ArchiveHandle *archiveHandle,
-                               FileHandle          *fileHandle
-                              )
+LOCAL Errors readSalt(ArchiveHandle     *archiveHandle,
+                      const ChunkHeader *chunkHeader
+                     )
 {
-  #define TRANSFER_BUFFER_SIZE (1024*1024)
-
   Errors error;
 
   assert(archiveHandle != NULL);
   DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
-  assert(archiveHandle->chunkIO != NULL);
-  assert(archiveHandle->chunkIO->write != NULL);
-  assert(fileHandle != NULL);
-  assert(Semaphore_isOwned(&archiveHandle->lock));
+  assert(chunkHeader != NULL);
+  assert(chunkHeader->id == CHUNK_ID_SALT);
 
-  // init variables
-  void *buffer = malloc(TRANSFER_BUFFER_SIZE);
-  if (buffer == NULL)
+  // check size
+  if (chunkHeader->size < CHUNK_FIXED_SIZE_SALT)
   {
-    HALT_INSUFFICIENT_MEMORY();
+    return ERROR_INVALID_CHUNK_SIZE;
   }
 
-  // seek to begin of file
-  error = File_seek(fileHandle,0LL);
+  // init salt chunk
+  ChunkSalt chunkSalt;
+  error = Chunk_init(&chunkSalt.info,
+                     NULL,  // parentChunkInfo
+                     archiveHandle->chunkIO,
+                     archiveHandle->chunkIOUserData,
+                     CHUNK_ID_SALT,
+                     CHUNK_DEFINITION_SALT,
+//TODO: DEFAULT_ALIGNMENT
+                     0,  // alignment
+                     NULL,  // cryptInfo
+                     &chunkSalt
+                    );
   if (error != ERROR_NONE)
   {
-    free(buffer);
     return error;
   }
 
-  // get length
-  uint64 length = File_getSize(fileHandle);
+  // open salt chunk
+  error = Chunk_open(&chunkSalt.info,
+                     chunkHeader,
+                     CHUNK_FIXED_SIZE_SALT,
+                     archiveHandle
+                    );
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkSalt.info);
+    return error;
+  }
 
-  // transfer data
-  while (length > 0LL)
+  // check if all data read
+  if (!Chunk_eofSub(&chunkSalt.info))
   {
-    ulong n = MIN(length,TRANSFER_BUFFER_SIZE);
+    Chunk_close(&chunkSalt.info);
+    Chunk_done(&chunkSalt.info);
+    return ERRORX_(CORRUPT_DATA,0,"%s",String_cString(archiveHandle->printableStorageName));
+  }
 
-    // read data
-    error = File_read(fileHandle,buffer,n,NULL);
-    if (error != ERROR_NONE)
-    {
-      free(buffer);
-      return error;
-    }
+  // add new crypt info
+  error = initArchiveCryptInfo(archiveHandle,
+                               CRYPT_TYPE_NONE,
+                               CRYPT_MODE_NONE,
+                               CRYPT_KEY_DERIVE_FUNCTION
+                              );
+  if (error != ERROR_NONE)
+  {
+    Chunk_close(&chunkSalt.info);
+    Chunk_done(&chunkSalt.info);
+    return error;
+  }
 
-    // write to storage
-    error = archiveHandle->chunkIO->write(archiveHandle->chunkIOUserData,buffer,n);
-    if (error != ERROR_NONE)
-    {
-      free(buffer);
-      return error;
-    }
+  // set crypt salt
+  Crypt_setSalt(&archiveHandle->archiveCryptInfo->cryptSalt,
+                chunkSalt.salt,
+                sizeof(chunkSalt.salt)
+               );
 
-    length -= (uint64)n;
+  // close chunk
+  error = Chunk_close(&chunkSalt.info);
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkSalt.info);
+    return error;
   }
+  Chunk_done(&chunkSalt.info);
 
   // free resources
-  free(buffer);
-
-  // truncate file for reusage
-  File_truncate(fileHandle,0LL);
 
   return ERROR_NONE;
-
-  #undef TRANSFER_BUFFER_SIZE
 }
 
 /***********************************************************************\
-* Name   : writeFileChunks
-* Purpose: write file chunks
-* Input  : archiveEntryInfo - archive file entry info
+* Name   : readEncryptionKey
+* Purpose: read asymmetric encryption key and decrypt with private key
+* Input  : archiveHandle   - archive handle
+*          chunkHeader     - key chunk header
+*          privateCryptKey - private decryption key
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors writeFileChunks(ArchiveEntryInfo *archiveEntryInfo)
+LOCAL Errors readEncryptionKey(ArchiveHandle     *archiveHandle,
+                               const ChunkHeader *chunkHeader,
+                               const CryptKey    *privateCryptKey
+                              )
 {
   Errors error;
 
-  assert(archiveEntryInfo != NULL);
-  assert(archiveEntryInfo->archiveHandle != NULL);
-  DEBUG_CHECK_RESOURCE_TRACE(archiveEntryInfo->archiveHandle);
-  assert(!archiveEntryInfo->file.headerWrittenFlag);
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+  assert(archiveHandle->archiveCryptInfo != NULL);
+  assert(chunkHeader != NULL);
+  assert(chunkHeader->id == CHUNK_ID_KEY);
 
-  // create file chunk
-  error = Chunk_create(&archiveEntryInfo->file.chunkFile.info);
-  if (error != ERROR_NONE)
+  // check size
+  if (chunkHeader->size < CHUNK_FIXED_SIZE_KEY)
   {
-    return error;
+    return ERROR_INVALID_CHUNK_SIZE;
   }
 
-  // create file entry chunk
-  error = Chunk_create(&archiveEntryInfo->file.chunkFileEntry.info);
+  // get last archive crypt info
+  ArchiveCryptInfoNode *archiveCryptInfoNode = LIST_TAIL(&archiveHandle->archiveCryptInfoList);
+  assert(archiveCryptInfoNode != NULL);
+
+  // init key chunk
+  ChunkKey chunkKey;
+  error = Chunk_init(&chunkKey.info,
+                     NULL,  // parentChunkInfo
+                     archiveHandle->chunkIO,
+                     archiveHandle->chunkIOUserData,
+                     CHUNK_ID_KEY,
+                     CHUNK_DEFINITION_KEY,
+//TODO: DEFAULT_ALIGNMENT
+                     0,  // alignment
+                     NULL,  // cryptInfo
+                     &chunkKey
+                    );
   if (error != ERROR_NONE)
   {
     return error;
   }
 
-  // create extended attribute chunks
-  FileExtendedAttributeNode *fileExtendedAttributeNode;
-  LIST_ITERATE(archiveEntryInfo->file.fileExtendedAttributeList,fileExtendedAttributeNode)
+  // open key chunk
+  error = Chunk_open(&chunkKey.info,
+                     chunkHeader,
+                     CHUNK_FIXED_SIZE_KEY,
+                     archiveHandle
+                    );
+  if (error != ERROR_NONE)
   {
-    String_set(archiveEntryInfo->file.chunkFileExtendedAttribute.name,fileExtendedAttributeNode->name);
-    archiveEntryInfo->file.chunkFileExtendedAttribute.value.data   = fileExtendedAttributeNode->data;
-    archiveEntryInfo->file.chunkFileExtendedAttribute.value.length = fileExtendedAttributeNode->dataLength;
-
-    error = Chunk_create(&archiveEntryInfo->file.chunkFileExtendedAttribute.info);
-    if (error != ERROR_NONE)
-    {
-      return error;
-    }
-    error = Chunk_close(&archiveEntryInfo->file.chunkFileExtendedAttribute.info);
-    if (error != ERROR_NONE)
-    {
-      return error;
-    }
+    Chunk_done(&chunkKey.info);
+    return error;
   }
 
-  // create file delta chunk
-  if (Compress_isCompressed(archiveEntryInfo->file.deltaCompressAlgorithm))
+  // read key chunk
+  uint encryptedKeyDataLength = chunkHeader->size-CHUNK_FIXED_SIZE_KEY;
+  void *encryptedKeyData      = malloc(encryptedKeyDataLength);
+  if (encryptedKeyData == NULL)
   {
-    assert(Compress_isDeltaCompressed(archiveEntryInfo->file.deltaCompressAlgorithm));
-
-    archiveEntryInfo->file.chunkFileDelta.deltaAlgorithm = COMPRESS_ALGORITHM_TO_CONSTANT(archiveEntryInfo->file.deltaCompressAlgorithm);
-    String_set(archiveEntryInfo->file.chunkFileDelta.name,DeltaSource_getName(&archiveEntryInfo->file.deltaSourceHandle));
-    archiveEntryInfo->file.chunkFileDelta.size           = DeltaSource_getSize(&archiveEntryInfo->file.deltaSourceHandle);
-
-    error = Chunk_create(&archiveEntryInfo->file.chunkFileDelta.info);
-    if (error != ERROR_NONE)
-    {
-      return error;
-    }
-    error = Chunk_close(&archiveEntryInfo->file.chunkFileDelta.info);
-    if (error != ERROR_NONE)
-    {
-      return error;
-    }
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  error = Chunk_readData(&chunkKey.info,
+                         encryptedKeyData,
+                         encryptedKeyDataLength,
+                         NULL  // bytesRead: read all
+                        );
+  if (error != ERROR_NONE)
+  {
+    free(encryptedKeyData);
+    Chunk_close(&chunkKey.info);
+    Chunk_done(&chunkKey.info);
+    return error;
   }
 
-  // create file data chunk
-  error = Chunk_create(&archiveEntryInfo->file.chunkFileData.info);
+  // check if all data read
+  if (!Chunk_eofSub(&chunkKey.info))
+  {
+    free(encryptedKeyData);
+    Chunk_close(&chunkKey.info);
+    Chunk_done(&chunkKey.info);
+    return ERRORX_(CORRUPT_DATA,0,"%s",String_cString(archiveHandle->printableStorageName));
+  }
+
+  // close chunk
+  error = Chunk_close(&chunkKey.info);
   if (error != ERROR_NONE)
   {
+    free(encryptedKeyData);
+    Chunk_done(&chunkKey.info);
     return error;
   }
+  Chunk_done(&chunkKey.info);
 
-  // mark header "written"
-  archiveEntryInfo->file.headerWrittenFlag = TRUE;
+  // get decrypt key
+  error = Crypt_getDecryptKey(&archiveCryptInfoNode->archiveCryptInfo.cryptKey,
+                              0,  // keyLength
+                              privateCryptKey,
+                              encryptedKeyData,
+                              encryptedKeyDataLength
+                             );
+  if (error != ERROR_NONE)
+  {
+    free(encryptedKeyData);
+    return error;
+  }
+
+//TODO: not required to store encrypted key when reading archives
+  // set crypt data
+  if (archiveHandle->encryptedKeyData != NULL) free(archiveHandle->encryptedKeyData);
+  archiveHandle->encryptedKeyData       = encryptedKeyData;
+  archiveHandle->encryptedKeyDataLength = encryptedKeyDataLength;
+
+  // set asymmetric crypt type
+  archiveCryptInfoNode->archiveCryptInfo.cryptType = CRYPT_TYPE_ASYMMETRIC;
+
+  // free resources
 
   return ERROR_NONE;
 }
 
 /***********************************************************************\
-* Name   : flushFileDataBlocks
-* Purpose: flush file data blocks
-* Input  : archiveEntryInfo  - archive file entry info data
-*          compressBlockType - compress block type; see CompressBlockTypes
+* Name   : readHeaderChunks
+* Purpose: read header chunks (BAR, salt, key) at beginning of archive
+* Input  : archiveHandle - archive handle
 * Output : -
 * Return : ERROR_NONE or error code
-* Notes  : -
+* Notes  : afterwards crypt info of archive is available and read
+*          position is behind the header of the first entry
 \***********************************************************************/
 
-LOCAL Errors flushFileDataBlocks(ArchiveEntryInfo   *archiveEntryInfo,
-                                 CompressBlockTypes compressBlockType
-                                )
+LOCAL Errors readHeaderChunks(ArchiveHandle *archiveHandle)
 {
   Errors error;
 
-  assert(archiveEntryInfo != NULL);
-  assert(archiveEntryInfo->archiveHandle != NULL);
-  DEBUG_CHECK_RESOURCE_TRACE(archiveEntryInfo->archiveHandle);
-  assert(archiveEntryInfo->file.byteCompressInfo.blockLength != 0);
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+  assert(archiveHandle->mode == ARCHIVE_MODE_READ);
 
-  uint blockCount;
-  do
+  error = Archive_seek(archiveHandle,0LL);
+  if ((error == ERROR_NONE) && Archive_eof(archiveHandle))
   {
-    error = Compress_getAvailableCompressedBlocks(&archiveEntryInfo->file.byteCompressInfo,
-                                                  compressBlockType,
-                                                  &blockCount
-                                                 );
-    if (error != ERROR_NONE)
-    {
-      return error;
-    }
+    error = (archiveHandle->pendingError != ERROR_NONE) ? archiveHandle->pendingError : ERROR_END_OF_ARCHIVE;
+    archiveHandle->pendingError = ERROR_NONE;
+  }
+  if (error == ERROR_NONE)
+  {
+    error = Archive_getNextArchiveEntry(archiveHandle,
+                                        NULL,  // archiveEntryType
+                                        NULL,  // archiveCryptInfo
+                                        NULL,  // offset
+                                        NULL  // size
+                                       );
+  }
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+  assert(archiveHandle->archiveCryptInfo != NULL);
 
-    if (blockCount > 0)
-    {
-      // write file header (if not already written)
-      if (!archiveEntryInfo->file.headerWrittenFlag)
-      {
-        error = writeFileChunks(archiveEntryInfo);
-        if (error != ERROR_NONE)
-        {
-          return error;
-        }
-      }
-      assert(archiveEntryInfo->file.headerWrittenFlag);
+  return ERROR_NONE;
+}
 
-      // get max. number of byte-compressed data blocks to write
-      ulong maxBlockCount = MIN(archiveEntryInfo->file.byteBufferSize/archiveEntryInfo->file.byteCompressInfo.blockLength,
-                                blockCount
-                               );
+/***********************************************************************\
+* Name   : writeHeader
+* Purpose: write archive header chunks
+* Input  : archiveHandle - archive handle
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
 
-      // get byte-compressed data blocks
-      ulong byteLength;
-      Compress_getCompressedData(&archiveEntryInfo->file.byteCompressInfo,
-                                 archiveEntryInfo->file.byteBuffer,
-                                 maxBlockCount*archiveEntryInfo->file.byteCompressInfo.blockLength,
-                                 &byteLength
-                                );
-      assert(byteLength > 0);
-      assert((byteLength%archiveEntryInfo->file.byteCompressInfo.blockLength) == 0);
+LOCAL Errors writeHeader(ArchiveHandle *archiveHandle)
+{
+  Errors error;
 
-      // encrypt block
-//fprintf(stderr,"%s, %d: cryptBytes=%d\n",__FILE__,__LINE__,byteLength); debugDumpMemory(archiveEntryInfo->file.byteBuffer,byteLength,FALSE);
-      error = Crypt_encryptBytes(&archiveEntryInfo->file.cryptInfo,
-                                 archiveEntryInfo->file.byteBuffer,
-                                 byteLength
-                                );
-      if (error != ERROR_NONE)
-      {
-        return error;
-      }
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+  assert(archiveHandle->storageInfo != NULL);
+  assert(archiveHandle->storageInfo->jobOptions != NULL);
 
-      #ifdef DEBUG_ENCODED_DATA_FILENAME
-        {
-          int handle = open64(DEBUG_ENCODED_DATA_FILENAME,O_CREAT|O_WRONLY|O_APPEND|O_LARGEFILE,0664);
-          write(handle,archiveEntryInfo->file.byteBuffer,byteLength);
-          close(handle);
-        }
-      #endif /* DEBUG_ENCODED_DATA_FILENAME */
+  // init BAR chunk
+  ChunkBAR chunkBAR;
+  error = Chunk_init(&chunkBAR.info,
+                     NULL,  // parentChunkInfo
+                     archiveHandle->chunkIO,
+                     archiveHandle->chunkIOUserData,
+                     CHUNK_ID_BAR,
+                     CHUNK_DEFINITION_BAR,
+                     DEFAULT_ALIGNMENT,
+                     NULL,  // cryptInfo
+                     &chunkBAR
+                    );
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
 
-      // write data block
-      error = Chunk_writeData(&archiveEntryInfo->file.chunkFileData.info,
-                              archiveEntryInfo->file.byteBuffer,
-                              byteLength
-                             );
-      if (error != ERROR_NONE)
-      {
-        return error;
-      }
-    }
+  // write header chunks
+  error = Chunk_create(&chunkBAR.info);
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkBAR.info);
+    return error;
+  }
+
+  // close chunks
+  error = Chunk_close(&chunkBAR.info);
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkBAR.info);
+    return error;
   }
-  while (blockCount > 0);
+
+  // free resources
+  Chunk_done(&chunkBAR.info);
 
   return ERROR_NONE;
 }
 
 /***********************************************************************\
-* Name   : writeFileDataBlocks
-* Purpose: encrypt and write file blocks, split archive
-* Input  : archiveEntryInfo - archive file entry info data
-*          allowNewPartFlag - TRUE iff new archive part can be created
+* Name   : writeSalt
+* Purpose: write new salt chunk
+* Input  : archiveHandle - archive handle
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors writeFileDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
-                                 bool             allowNewPartFlag
-                                )
+LOCAL Errors writeSalt(ArchiveHandle   *archiveHandle,
+                       const CryptSalt *cryptSalt
+                      )
 {
   Errors error;
 
-  assert(archiveEntryInfo != NULL);
-  assert(archiveEntryInfo->archiveHandle != NULL);
-  DEBUG_CHECK_RESOURCE_TRACE(archiveEntryInfo->archiveHandle);
-  assert(archiveEntryInfo->archiveHandle->mode == ARCHIVE_MODE_CREATE);
-  assert(archiveEntryInfo->file.byteCompressInfo.blockLength != 0);
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+  assert(Semaphore_isOwned(&archiveHandle->lock));
+  assert(archiveHandle->archiveCryptInfo != NULL);
+  assert(cryptSalt != NULL);
 
-  uint blockCount;
-  do
+  // init key chunk
+  ChunkSalt chunkSalt;
+  error = Chunk_init(&chunkSalt.info,
+                     NULL,  // parentChunkInfo
+                     archiveHandle->chunkIO,
+                     archiveHandle->chunkIOUserData,
+                     CHUNK_ID_SALT,
+                     CHUNK_DEFINITION_SALT,
+//TODO: DEFAULT_ALIGNMENT
+                     0,  // alignment
+                     NULL,  // cryptInfo
+                     &chunkSalt
+                    );
+  if (error != ERROR_NONE)
   {
-    error = Compress_getAvailableCompressedBlocks(&archiveEntryInfo->file.byteCompressInfo,
-                                                  COMPRESS_BLOCK_TYPE_FULL,
-                                                  &blockCount
-                                                );
-    if (error != ERROR_NONE)
-    {
-      return error;
-    }
+    return error;
+  }
+
+  // get salt
+  assert(sizeof(chunkSalt.salt) == cryptSalt->dataLength);
+  Crypt_getSalt(chunkSalt.salt,sizeof(chunkSalt.salt),cryptSalt);
+
+  // write salt
+  error = Chunk_create(&chunkSalt.info);
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkSalt.info);
+    return error;
+  }
+
+  // close chunk
+  error = Chunk_close(&chunkSalt.info);
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkSalt.info);
+    return error;
+  }
+
+  // free resources
+  Chunk_done(&chunkSalt.info);
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : writeEncryptionKey
+* Purpose: write new encryption key chunk
+* Input  : archiveHandle - archive handle
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors writeEncryptionKey(ArchiveHandle *archiveHandle)
+{
+  Errors error;
+
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+  assert(Semaphore_isOwned(&archiveHandle->lock));
+
+  // init key chunk
+  ChunkKey chunkKey;
+  error = Chunk_init(&chunkKey.info,
+                     NULL,  // parentChunkInfo
+                     archiveHandle->chunkIO,
+                     archiveHandle->chunkIOUserData,
+                     CHUNK_ID_KEY,
+                     CHUNK_DEFINITION_KEY,
+//TODO: DEFAULT_ALIGNMENT
+                     0,  // alignment
+                     NULL,  // cryptInfo
+                     &chunkKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  // write encrypted encryption key
+  error = Chunk_create(&chunkKey.info);
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkKey.info);
+    return error;
+  }
+  error = Chunk_writeData(&chunkKey.info,
+                          archiveHandle->encryptedKeyData,
+                          archiveHandle->encryptedKeyDataLength
+                         );
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkKey.info);
+    return error;
+  }
+
+  // close chunk
+  error = Chunk_close(&chunkKey.info);
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkKey.info);
+    return error;
+  }
+
+  // free resources
+  Chunk_done(&chunkKey.info);
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : writeMeta
+* Purpose: write archive meta chunks
+* Input  : archiveHandle  - archive handle
+*          cryptAlgorithm - crypt algorithm
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors writeMeta(ArchiveHandle   *archiveHandle,
+// TODO: multi-crypt
+                       CryptAlgorithms cryptAlgorithm
+                      )
+{
+  Errors error;
+
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+  assert(archiveHandle->storageInfo != NULL);
+  assert(archiveHandle->storageInfo->jobOptions != NULL);
+  assert(archiveHandle->archiveCryptInfo != NULL);
+
+  // get crypt block length
+  uint blockLength = Crypt_getBlockLength(cryptAlgorithm);
+
+  // init meta chunk
+  ChunkMeta chunkMeta;
+  error = Chunk_init(&chunkMeta.info,
+                     NULL,  // parentChunkInfo
+                     archiveHandle->chunkIO,
+                     archiveHandle->chunkIOUserData,
+                     CHUNK_ID_META,
+                     CHUNK_DEFINITION_META,
+                     DEFAULT_ALIGNMENT,
+                     NULL,  // cryptInfo,
+                     &chunkMeta
+                    );
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+#ifdef MULTI_CRYPT
+  chunkMeta.cryptAlgorithms[0] = CRYPT_ALGORITHM_TO_CONSTANT(archiveHandle->jobOptions->cryptAlgorithms[0]);
+  chunkMeta.cryptAlgorithms[1] = CRYPT_ALGORITHM_TO_CONSTANT(archiveHandle->jobOptions->cryptAlgorithms[1]);
+  chunkMeta.cryptAlgorithms[2] = CRYPT_ALGORITHM_TO_CONSTANT(archiveHandle->jobOptions->cryptAlgorithms[2]);
+  chunkMeta.cryptAlgorithms[3] = CRYPT_ALGORITHM_TO_CONSTANT(archiveHandle->jobOptions->cryptAlgorithms[3]);
+#else
+  chunkMeta.cryptAlgorithms[0] = CRYPT_ALGORITHM_TO_CONSTANT(cryptAlgorithm);
+  chunkMeta.cryptAlgorithms[1] = CRYPT_ALGORITHM_NONE;
+  chunkMeta.cryptAlgorithms[2] = CRYPT_ALGORITHM_NONE;
+  chunkMeta.cryptAlgorithms[3] = CRYPT_ALGORITHM_NONE;
+#endif
+
+  // init crypt
+  CryptInfo cryptInfo;
+  error = Crypt_init(&cryptInfo,
+//TODO: MULTI_CRYPT
+                     archiveHandle->storageInfo->jobOptions->cryptAlgorithms[0],
+                     CRYPT_MODE_CBC_,
+                     &archiveHandle->archiveCryptInfo->cryptSalt,
+                     &archiveHandle->archiveCryptInfo->cryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkMeta.info);
+    return error;
+  }
+  DEBUG_TESTCODE() { Crypt_done(&cryptInfo); return DEBUG_TESTCODE_ERROR(); }
+
+  // init meta entry chunk
+  ChunkMetaEntry chunkMetaEntry;
+  error = Chunk_init(&chunkMetaEntry.info,
+                     &chunkMeta.info,
+                     CHUNK_USE_PARENT,
+                     CHUNK_USE_PARENT,
+                     CHUNK_ID_META_ENTRY,
+                     CHUNK_DEFINITION_META_ENTRY,
+                     blockLength,
+                     &cryptInfo,
+                     &chunkMetaEntry
+                    );
+  if (error != ERROR_NONE)
+  {
+    Crypt_done(&cryptInfo);
+    Chunk_done(&chunkMeta.info);
+    return error;
+  }
+  Network_getHostName(chunkMetaEntry.hostName);
+  Misc_getCurrentUserName(chunkMetaEntry.userName);
+  String_set(chunkMetaEntry.jobUUID,archiveHandle->jobUUID);
+  String_set(chunkMetaEntry.entityUUID,archiveHandle->entityUUID);
+  chunkMetaEntry.archiveType     = archiveHandle->archiveType;
+  chunkMetaEntry.createdDateTime = Misc_getCurrentDateTime();
+  convertSystemToUTF8Encoding(chunkMetaEntry.comment,archiveHandle->storageInfo->jobOptions->comment);
+
+  // write meta chunks
+  error = Chunk_create(&chunkMeta.info);
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkMetaEntry.info);
+    Crypt_done(&cryptInfo);
+    Chunk_done(&chunkMeta.info);
+    return error;
+  }
+  error = Chunk_create(&chunkMetaEntry.info);
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkMetaEntry.info);
+    Crypt_done(&cryptInfo);
+    Chunk_done(&chunkMeta.info);
+    return error;
+  }
+
+  // close chunks
+  error = Chunk_close(&chunkMetaEntry.info);
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkMetaEntry.info);
+    Crypt_done(&cryptInfo);
+    Chunk_done(&chunkMeta.info);
+    return error;
+  }
+  error = Chunk_close(&chunkMeta.info);
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkMetaEntry.info);
+    Crypt_done(&cryptInfo);
+    Chunk_done(&chunkMeta.info);
+    return error;
+  }
+
+  // free resources
+  Chunk_done(&chunkMetaEntry.info);
+  Crypt_done(&cryptInfo);
+  Chunk_done(&chunkMeta.info);
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : addTOCEntry
+* Purpose: add entry to table of contents of current archive file
+* Input  : archiveHandle  - archive handle
+*          type           - archive entry type
+*          name           - entry name (UTF-8)
+*          offset         - offset of entry chunk in archive file
+*          fragmentOffset - fragment offset [bytes]
+*          fragmentSize   - fragment size [bytes]
+* Output : -
+* Return : -
+* Notes  : archive must be locked
+\***********************************************************************/
+
+LOCAL void addTOCEntry(ArchiveHandle     *archiveHandle,
+                       ArchiveEntryTypes type,
+                       ConstString       name,
+                       uint64            offset,
+                       uint64            fragmentOffset,
+                       uint64            fragmentSize
+                      )
+{
+  assert(archiveHandle != NULL);
+  assert(Semaphore_isOwned(&archiveHandle->lock));
+  assert(name != NULL);
+
+  // check max. number of entries
+  if (archiveHandle->tocOverflowFlag)
+  {
+    return;
+  }
+  if (List_count(&archiveHandle->tocList) >= MAX_TOC_ENTRIES)
+  {
+    List_clear(&archiveHandle->tocList);
+    archiveHandle->tocOverflowFlag = TRUE;
+    return;
+  }
+
+  ArchiveTOCNode *tocNode = LIST_NEW_NODE(ArchiveTOCNode);
+  if (tocNode == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  tocNode->type           = type;
+  tocNode->name           = String_duplicate(name);
+  tocNode->offset         = offset;
+  tocNode->fragmentOffset = fragmentOffset;
+  tocNode->fragmentSize   = fragmentSize;
+  List_append(&archiveHandle->tocList,tocNode);
+}
+
+/***********************************************************************\
+* Name   : addTOCEntries
+* Purpose: add entry written into archive file to table of contents
+* Input  : archiveEntryInfo - archive entry info
+*          offset           - offset of entry chunks in archive file
+* Output : -
+* Return : -
+* Notes  : archive must be locked
+\***********************************************************************/
+
+LOCAL void addTOCEntries(ArchiveEntryInfo *archiveEntryInfo,
+                         uint64           offset
+                        )
+{
+  assert(archiveEntryInfo != NULL);
+  assert(archiveEntryInfo->archiveHandle != NULL);
+
+  if (!globalOptions.tableOfContentsFlag)
+  {
+    return;
+  }
+
+  String name = String_new();
+  switch (archiveEntryInfo->archiveEntryType)
+  {
+    case ARCHIVE_ENTRY_TYPE_FILE:
+      addTOCEntry(archiveEntryInfo->archiveHandle,
+                  ARCHIVE_ENTRY_TYPE_FILE,
+                  archiveEntryInfo->file.chunkFileEntry.name,
+                  offset,
+                  archiveEntryInfo->file.chunkFileData.fragmentOffset,
+                  archiveEntryInfo->file.chunkFileData.fragmentSize
+                 );
+      break;
+    case ARCHIVE_ENTRY_TYPE_IMAGE:
+      addTOCEntry(archiveEntryInfo->archiveHandle,
+                  ARCHIVE_ENTRY_TYPE_IMAGE,
+                  archiveEntryInfo->image.chunkImageEntry.name,
+                  offset,
+                  archiveEntryInfo->image.chunkImageData.blockOffset*(uint64)archiveEntryInfo->image.chunkImageEntry.blockSize,
+                  archiveEntryInfo->image.chunkImageData.blockCount*(uint64)archiveEntryInfo->image.chunkImageEntry.blockSize
+                 );
+      break;
+    case ARCHIVE_ENTRY_TYPE_DIRECTORY:
+      addTOCEntry(archiveEntryInfo->archiveHandle,
+                  ARCHIVE_ENTRY_TYPE_DIRECTORY,
+                  archiveEntryInfo->directory.chunkDirectoryEntry.name,
+                  offset,
+                  0LL,
+                  0LL
+                 );
+      break;
+    case ARCHIVE_ENTRY_TYPE_LINK:
+      addTOCEntry(archiveEntryInfo->archiveHandle,
+                  ARCHIVE_ENTRY_TYPE_LINK,
+                  archiveEntryInfo->link.chunkLinkEntry.name,
+                  offset,
+                  0LL,
+                  0LL
+                 );
+      break;
+    case ARCHIVE_ENTRY_TYPE_HARDLINK:
+      {
+        ConstString fileName;
+        STRINGLIST_ITERATE(archiveEntryInfo->hardLink.fileNameList,fileName)
+        {
+          convertSystemToUTF8Encoding(name,fileName);
+          addTOCEntry(archiveEntryInfo->archiveHandle,
+                      ARCHIVE_ENTRY_TYPE_HARDLINK,
+                      name,
+                      offset,
+                      archiveEntryInfo->hardLink.chunkHardLinkData.fragmentOffset,
+                      archiveEntryInfo->hardLink.chunkHardLinkData.fragmentSize
+                     );
+        }
+      }
+      break;
+    case ARCHIVE_ENTRY_TYPE_SPECIAL:
+      addTOCEntry(archiveEntryInfo->archiveHandle,
+                  ARCHIVE_ENTRY_TYPE_SPECIAL,
+                  archiveEntryInfo->special.chunkSpecialEntry.name,
+                  offset,
+                  0LL,
+                  0LL
+                 );
+      break;
+    case ARCHIVE_ENTRY_TYPE_SOLID:
+      {
+        // members: offset of file chunk behind solid block
+        const ArchiveSolidMemberNode *archiveSolidMemberNode;
+        LIST_ITERATE(&archiveEntryInfo->solid.memberList,archiveSolidMemberNode)
+        {
+          convertSystemToUTF8Encoding(name,archiveSolidMemberNode->name);
+          addTOCEntry(archiveEntryInfo->archiveHandle,
+                      ARCHIVE_ENTRY_TYPE_FILE,
+                      name,
+                      offset+archiveSolidMemberNode->chunkOffset,
+                      0LL,
+                      archiveSolidMemberNode->size
+                     );
+        }
+      }
+      break;
+    default:
+      #ifndef NDEBUG
+        HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+      #endif /* NDEBUG */
+      break; /* not reached */
+  }
+  String_delete(name);
+}
+
+/***********************************************************************\
+* Name   : writeTOC
+* Purpose: write table of contents chunks of current archive file
+* Input  : archiveHandle  - archive handle
+*          cryptAlgorithm - crypt algorithm
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors writeTOC(ArchiveHandle   *archiveHandle,
+// TODO: multi-crypt
+                      CryptAlgorithms cryptAlgorithm
+                     )
+{
+  Errors error;
+
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+  assert(archiveHandle->storageInfo != NULL);
+  assert(archiveHandle->storageInfo->jobOptions != NULL);
+  assert(archiveHandle->archiveCryptInfo != NULL);
+
+  // init variables
+  AutoFreeList autoFreeList;
+  AutoFree_init(&autoFreeList);
+
+  // get crypt block length
+  uint blockLength = Crypt_getBlockLength(cryptAlgorithm);
+
+  // init table of contents chunk
+  ChunkTOC chunkTOC;
+  error = Chunk_init(&chunkTOC.info,
+                     NULL,  // parentChunkInfo
+                     archiveHandle->chunkIO,
+                     archiveHandle->chunkIOUserData,
+                     CHUNK_ID_TOC,
+                     CHUNK_DEFINITION_TOC,
+                     DEFAULT_ALIGNMENT,
+                     NULL,  // cryptInfo,
+                     &chunkTOC
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&chunkTOC.info,{ Chunk_done(&chunkTOC.info); });
+  chunkTOC.cryptAlgorithms[0] = CRYPT_ALGORITHM_TO_CONSTANT(cryptAlgorithm);
+  chunkTOC.cryptAlgorithms[1] = CRYPT_ALGORITHM_NONE;
+  chunkTOC.cryptAlgorithms[2] = CRYPT_ALGORITHM_NONE;
+  chunkTOC.cryptAlgorithms[3] = CRYPT_ALGORITHM_NONE;
+
+  // init crypt
+  CryptInfo cryptInfo;
+  error = Crypt_init(&cryptInfo,
+                     cryptAlgorithm,
+                     CRYPT_MODE_CBC_,
+                     &archiveHandle->archiveCryptInfo->cryptSalt,
+                     &archiveHandle->archiveCryptInfo->cryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&cryptInfo,{ Crypt_done(&cryptInfo); });
+
+  // init table of contents entry chunk
+  ChunkTOCEntry chunkTOCEntry;
+  error = Chunk_init(&chunkTOCEntry.info,
+                     &chunkTOC.info,
+                     CHUNK_USE_PARENT,
+                     CHUNK_USE_PARENT,
+                     CHUNK_ID_TOC_ENTRY,
+                     CHUNK_DEFINITION_TOC_ENTRY,
+                     blockLength,
+                     &cryptInfo,
+                     &chunkTOCEntry
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&chunkTOCEntry.info,{ Chunk_done(&chunkTOCEntry.info); });
+
+  // write table of contents chunks
+  error = Chunk_create(&chunkTOC.info);
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  const ArchiveTOCNode *tocNode;
+  LIST_ITERATEX(&archiveHandle->tocList,tocNode,error == ERROR_NONE)
+  {
+    chunkTOCEntry.entryType      = (uint16)tocNode->type;
+    chunkTOCEntry.offset         = tocNode->offset;
+    chunkTOCEntry.fragmentOffset = tocNode->fragmentOffset;
+    chunkTOCEntry.fragmentSize   = tocNode->fragmentSize;
+    String_set(chunkTOCEntry.name,tocNode->name);
+
+    error = Chunk_create(&chunkTOCEntry.info);
+    if (error == ERROR_NONE)
+    {
+      error = Chunk_close(&chunkTOCEntry.info);
+    }
+  }
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  error = Chunk_close(&chunkTOC.info);
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+
+  // free resources
+  Chunk_done(&chunkTOCEntry.info);
+  Crypt_done(&cryptInfo);
+  Chunk_done(&chunkTOC.info);
+  AutoFree_done(&autoFreeList);
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : writeTOCLocator
+* Purpose: write table of contents locator chunk
+* Input  : archiveHandle - archive handle
+*          tocOffset     - offset of table of contents chunk
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : the locator chunk has a fixed size and is the last chunk of
+*          an archive file
+\***********************************************************************/
+
+LOCAL Errors writeTOCLocator(ArchiveHandle *archiveHandle,
+                             uint64        tocOffset
+                            )
+{
+  Errors error;
+
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+
+  // init table of contents locator chunk
+  ChunkTOCLocator chunkTOCLocator;
+  error = Chunk_init(&chunkTOCLocator.info,
+                     NULL,  // parentChunkInfo
+                     archiveHandle->chunkIO,
+                     archiveHandle->chunkIOUserData,
+                     CHUNK_ID_TOC_LOCATOR,
+                     CHUNK_DEFINITION_TOC_LOCATOR,
+                     DEFAULT_ALIGNMENT,
+                     NULL,  // cryptInfo
+                     &chunkTOCLocator
+                    );
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+  chunkTOCLocator.offset = tocOffset;
+
+  // write table of contents locator chunk
+  error = Chunk_create(&chunkTOCLocator.info);
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkTOCLocator.info);
+    return error;
+  }
+  error = Chunk_close(&chunkTOCLocator.info);
+  if (error != ERROR_NONE)
+  {
+    Chunk_done(&chunkTOCLocator.info);
+    return error;
+  }
+
+  // free resources
+  Chunk_done(&chunkTOCLocator.info);
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : writeSignature
+* Purpose: write new signature chunk
+* Input  : archiveHandle - archive handle
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors writeSignature(ArchiveHandle *archiveHandle,
+                            const Key     *signaturePrivateKey
+                           )
+{
+  Errors error;
+
+  assert(archiveHandle != NULL);
+  assert(archiveHandle->chunkIO != NULL);
+  assert(archiveHandle->chunkIO->tell != NULL);
+  assert(signaturePrivateKey != NULL);
+
+  if (Configuration_isKeyAvailable(signaturePrivateKey))
+  {
+    // init variables
+    AutoFreeList autoFreeList;
+    AutoFree_init(&autoFreeList);
+
+    // init signature hash
+    CryptHash signatureHash;
+    error = Crypt_initHash(&signatureHash,SIGNATURE_HASH_ALGORITHM);
+    if (error != ERROR_NONE)
+    {
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
+    AUTOFREE_ADD(&autoFreeList,&signatureHash,{ Crypt_doneHash(&signatureHash); });
+
+/*
+TODO: support dynamic hash length?
+    hashLength = Crypt_getHashLength(&signatureHash);
+    hash = malloc(hashLength);
+    if (hash == NULL)
+    {
+      AutoFree_cleanup(&autoFreeList);
+      return ERROR_INSUFFICIENT_MEMORY;
+    }
+    AUTOFREE_ADD(&autoFreeList,hash,{ free(hash); });
+*/
+    byte hash[MAX_HASH_SIZE];
+    uint hashLength;
+    if (   (archiveHandle->mode == ARCHIVE_MODE_CREATE)
+        && (archiveHandle->chunkIO == &CHUNK_IO_STREAM)
+       )
+    {
+      assert(archiveHandle->create.stream.signatureHashFlag);
+
+      // store buffered data: signature hash is calculated while storing
+      error = flushArchiveStream(&archiveHandle->create.stream,0);
+      if (error != ERROR_NONE)
+      {
+        AutoFree_cleanup(&autoFreeList);
+        return error;
+      }
+      Crypt_getHash(&archiveHandle->create.stream.signatureHash,hash,sizeof(hash),&hashLength);
+    }
+    else
+    {
+      // get signature hash (Note: signature is also calculate from begin of archive)
+      uint64 index;
+      error = archiveHandle->chunkIO->tell(archiveHandle->chunkIOUserData,&index);
+      if (error != ERROR_NONE)
+      {
+        AutoFree_cleanup(&autoFreeList);
+        return error;
+      }
+      error = calculateHash(archiveHandle->chunkIO,
+                            archiveHandle->chunkIOUserData,
+                            &signatureHash,
+                            0LL,  // start
+                            index
+                           );
+      if (error != ERROR_NONE)
+      {
+        AutoFree_cleanup(&autoFreeList);
+        return error;
+      }
+      Crypt_getHash(&signatureHash,hash,sizeof(hash),&hashLength);
+    }
+//fprintf(stderr,"%s, %d: write signature\n",__FILE__,__LINE__); debugDumpMemory(hash,hashLength,0);
+
+    // get signature
+    CryptKey privateSignatureKey;
+    byte     signature[MAX_HASH_SIZE];
+    uint     signatureLength;
+    Crypt_initKey(&privateSignatureKey,CRYPT_PADDING_TYPE_NONE);
+    error = Crypt_setPublicPrivateKeyData(&privateSignatureKey,
+                                          signaturePrivateKey->data,
+                                          signaturePrivateKey->length,
+                                          CRYPT_MODE_CBC_|CRYPT_MODE_CTS_,
+                                          CRYPT_KEY_DERIVE_NONE,
+                                          NULL,  // salt
+                                          NULL  // password
+                                         );
+    if (error == ERROR_NONE)
+    {
+      error = Crypt_getSignature(signature,
+                                 sizeof(signature),
+                                 &signatureLength,
+                                 &privateSignatureKey,
+                                 hash,
+                                 hashLength
+                                );
+    }
+    Crypt_doneKey(&privateSignatureKey);
+    if (error != ERROR_NONE)
+    {
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
+    assert(signatureLength <= sizeof(signature));
+
+    // init signature chunk
+    ChunkSignature chunkSignature;
+    error = Chunk_init(&chunkSignature.info,
+                       NULL,  // parentChunkInfo
+                       archiveHandle->chunkIO,
+                       archiveHandle->chunkIOUserData,
+                       CHUNK_ID_SIGNATURE,
+                       CHUNK_DEFINITION_SIGNATURE,
+                       DEFAULT_ALIGNMENT,
+                       NULL,  // cryptInfo
+                       &chunkSignature
+                      );
+    if (error != ERROR_NONE)
+    {
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
+    chunkSignature.hashAlgorithm = SIGNATURE_HASH_ALGORITHM;
+    chunkSignature.value.data    = signature;
+    chunkSignature.value.length  = signatureLength;
+    AUTOFREE_ADD(&autoFreeList,&chunkSignature.info,{ Chunk_done(&chunkSignature.info); });
+
+    // write signature chunk
+    error = Chunk_create(&chunkSignature.info);
+    if (error != ERROR_NONE)
+    {
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
+    error = Chunk_close(&chunkSignature.info);
+    if (error != ERROR_NONE)
+    {
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
+
+    // free resources
+    Chunk_done(&chunkSignature.info);
+    Crypt_doneHash(&signatureHash);
+    AutoFree_done(&autoFreeList);
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : createArchiveFile
+* Purpose: create and open new archive file
+* Input  : archiveHandle - archive handle
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors createArchiveFile(ArchiveHandle *archiveHandle)
+{
+  Errors error;
+
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+  assert(archiveHandle->storageInfo != NULL);
+  assert(archiveHandle->storageInfo->jobOptions != NULL);
+  assert(archiveHandle->archiveCryptInfo != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_CREATE);
+  assert(Semaphore_isOwned(&archiveHandle->lock));
+
+  if (!archiveHandle->create.openFlag)
+  {
+    // init variables
+    AutoFreeList autoFreeList;
+    AutoFree_init(&autoFreeList);
+
+    SEMAPHORE_LOCKED_DO(&archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+    {
+      AUTOFREE_ADD(&autoFreeList,&archiveHandle->lock,{ Semaphore_unlock(&archiveHandle->lock); });
+
+      if (archiveHandle->create.streamFlag)
+      {
+        assert(archiveHandle->archiveStreamFunction != NULL);
+        assert(archiveHandle->create.stream.buffer != NULL);
+
+        // get storage archive name
+        error = archiveHandle->archiveStreamFunction(archiveHandle->storageInfo,
+                                                     isSplittedArchive(archiveHandle)
+                                                       ? (int)archiveHandle->partNumber
+                                                       : ARCHIVE_PART_NUMBER_NONE,
+                                                     archiveHandle->create.stream.archiveName,
+                                                     archiveHandle->archiveStreamUserData
+                                                    );
+        if (error != ERROR_NONE)
+        {
+          AutoFree_cleanup(&autoFreeList);
+          return error;
+        }
+
+        // create storage file (Note: size is not known yet)
+        error = Storage_create(&archiveHandle->create.stream.storageHandle,
+                               archiveHandle->storageInfo,
+                               archiveHandle->create.stream.archiveName,
+                               0LL,  // archiveSize
+                               FALSE  // forceFlag
+                              );
+        if (error != ERROR_NONE)
+        {
+          AutoFree_cleanup(&autoFreeList);
+          return error;
+        }
+        AUTOFREE_ADD(&autoFreeList,&archiveHandle->create.stream.storageHandle,
+        {
+          Storage_close(&archiveHandle->create.stream.storageHandle);
+          (void)Storage_delete(archiveHandle->storageInfo,archiveHandle->create.stream.archiveName);
+        });
+        DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
+      }
+      else
+      {
+        // create intermediate data filename
+        error = File_getTmpFileName(archiveHandle->create.tmpFileName,"archive",tmpDirectory);
+        if (error != ERROR_NONE)
+        {
+          AutoFree_cleanup(&autoFreeList);
+          return error;
+        }
+        AUTOFREE_ADD(&autoFreeList,&archiveHandle->create.tmpFileName,{ File_delete(archiveHandle->create.tmpFileName,FALSE); });
+        DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
+
+        // create temporary file
+        error = File_open(&archiveHandle->create.tmpFileHandle,
+                          archiveHandle->create.tmpFileName,
+                          FILE_OPEN_CREATE
+                         );
+        if (error != ERROR_NONE)
+        {
+          AutoFree_cleanup(&autoFreeList);
+          return error;
+        }
+        AUTOFREE_ADD(&autoFreeList,&archiveHandle->create.tmpFileHandle,{ File_close(&archiveHandle->create.tmpFileHandle); });
+        DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
+      }
+
+      if (archiveHandle->chunkIO == &CHUNK_IO_STREAM)
+      {
+        // init signature hash: signature hash is calculated while storing data
+        archiveHandle->create.stream.signatureHashFlag =    !archiveHandle->storageInfo->jobOptions->noSignatureFlag
+                                                         && Configuration_isKeyAvailable(&globalOptions.signaturePrivateKey);
+        if (archiveHandle->create.stream.signatureHashFlag)
+        {
+          error = Crypt_initHash(&archiveHandle->create.stream.signatureHash,SIGNATURE_HASH_ALGORITHM);
+          if (error != ERROR_NONE)
+          {
+            AutoFree_cleanup(&autoFreeList);
+            return error;
+          }
+          AUTOFREE_ADD(&autoFreeList,&archiveHandle->create.stream.signatureHash,{ Crypt_doneHash(&archiveHandle->create.stream.signatureHash); });
+        }
+
+        // init stream
+        archiveHandle->create.stream.bufferOffset = 0LL;
+        archiveHandle->create.stream.bufferLength = 0L;
+        archiveHandle->create.stream.offset       = 0LL;
+      }
+
+      // write header
+      error = writeHeader(archiveHandle);
+      if (error != ERROR_NONE)
+      {
+        AutoFree_cleanup(&autoFreeList);
+        return error;
+      }
+      DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
+
+      // write salt if encryption enabled
+      if (   IS_SET(archiveHandle->archiveFlags,ARCHIVE_FLAG_CREATE_SALT)
+          && (archiveHandle->archiveCryptInfo->cryptType != CRYPT_TYPE_NONE)
+         )
+      {
+        // write salt
+        error = writeSalt(archiveHandle,
+                          &archiveHandle->archiveCryptInfo->cryptSalt
+                         );
+        if (error != ERROR_NONE)
+        {
+          AutoFree_cleanup(&autoFreeList);
+          return error;
+        }
+        DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
+      }
+
+      // write encrypted key if asymmetric encryption enabled
+      if (   IS_SET(archiveHandle->archiveFlags,ARCHIVE_FLAG_CREATE_KEY)
+          && (archiveHandle->archiveCryptInfo->cryptType == CRYPT_TYPE_ASYMMETRIC)
+         )
+      {
+        // write encrypted key
+        error = writeEncryptionKey(archiveHandle);
+        if (error != ERROR_NONE)
+        {
+          AutoFree_cleanup(&autoFreeList);
+          return error;
+        }
+        DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
+      }
+
+      if (IS_SET(archiveHandle->archiveFlags,ARCHIVE_FLAG_CREATE_META))
+      {
+        // write meta data
+        error = writeMeta(archiveHandle,
+                          archiveHandle->storageInfo->jobOptions->cryptAlgorithms[0]
+                         );
+        if (error != ERROR_NONE)
+        {
+          AutoFree_cleanup(&autoFreeList);
+          return error;
+        }
+        DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
+      }
+
+      if (   Index_isAvailable()
+          && !archiveHandle->storageInfo->jobOptions->noIndexDatabaseFlag
+          && !archiveHandle->storageInfo->jobOptions->noStorage
+          && !archiveHandle->storageInfo->jobOptions->dryRun
+         )
+      {
+        // create storage index
+        SEMAPHORE_LOCKED_DO(&archiveHandle->indexLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+        {
+          error = IndexStorage_new(&archiveHandle->indexHandle,
+                                   archiveHandle->uuidId,
+                                   archiveHandle->entityId,
+                                   archiveHandle->hostName,
+                                   archiveHandle->userName,
+                                   NULL,  // storageName
+                                   Misc_getCurrentDateTime(),  // created
+                                   0LL,  // size
+                                   INDEX_STATE_CREATE,
+                                   INDEX_MODE_AUTO,
+                                   &archiveHandle->storageId
+                                  );
+          if (error != ERROR_NONE)
+          {
+            Semaphore_unlock(&archiveHandle->indexLock);
+            AutoFree_cleanup(&autoFreeList);
+            return error;
+          }
+        }
+        AUTOFREE_ADD(&autoFreeList,&archiveHandle->storageId,
+        {
+          SEMAPHORE_LOCKED_DO(&archiveHandle->indexLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+          {
+            (void)IndexStorage_purge(&archiveHandle->indexHandle,
+                                     archiveHandle->storageId,
+                                     NULL  // progressInfo
+                                    );
+          }
+        });
+      }
+      else
+      {
+        // no index
+        archiveHandle->storageId = INDEX_ID_NONE;
+      }
+
+      // call-back for init archive
+      if (archiveHandle->archiveInitFunction != NULL)
+      {
+        error = archiveHandle->archiveInitFunction(archiveHandle->storageInfo,
+                                                   archiveHandle->uuidId,
+                                                   archiveHandle->jobUUID,
+                                                   archiveHandle->entityUUID,
+                                                   archiveHandle->entityId,
+                                                   archiveHandle->archiveType,
+                                                   archiveHandle->storageId,
+                                                   isSplittedArchive(archiveHandle)
+                                                     ? (int)archiveHandle->partNumber
+                                                     : ARCHIVE_PART_NUMBER_NONE,
+                                                   archiveHandle->archiveInitUserData
+                                                  );
+        if (error != ERROR_NONE)
+        {
+          AutoFree_cleanup(&autoFreeList);
+          return error;
+        }
+        DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
+      }
+
+      // mark create archive file "open"
+      archiveHandle->create.openFlag = TRUE;
+    }
+
+    // free resources
+    AutoFree_done(&autoFreeList);
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : discardArchiveFile
+* Purpose: discard archive file after an error
+* Input  : archiveHandle - archive handle
+* Output : -
+* Return : -
+* Notes  : an incomplete streamed archive file is deleted in storage
+\***********************************************************************/
+
+LOCAL void discardArchiveFile(ArchiveHandle *archiveHandle)
+{
+  assert(archiveHandle != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_CREATE);
+
+  if (archiveHandle->create.openFlag)
+  {
+    if (archiveHandle->chunkIO == &CHUNK_IO_STREAM)
+    {
+      closeArchiveStream(archiveHandle,TRUE);
+    }
+    else
+    {
+      (void)File_close(&archiveHandle->create.tmpFileHandle);
+    }
+    archiveHandle->create.openFlag = FALSE;
+  }
+  List_clear(&archiveHandle->tocList);
+  archiveHandle->tocOverflowFlag = FALSE;
+}
+
+/***********************************************************************\
+* Name   : closeArchiveFile
+* Purpose: close archive file
+* Input  : archiveHandle - archive handle
+* Output : storageId            - storage index id
+*          intermediateFileName - intermediate file name or empty if
+*                                 archive file was streamed
+*          storedFlag           - TRUE iff archive file was streamed
+*                                 into storage
+*          partNumber           - part number
+*          archiveSize          - archive size [bytes]
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors closeArchiveFile(ArchiveHandle *archiveHandle,
+                              IndexId       *storageId,
+                              String        intermediateFileName,
+                              bool          *storedFlag,
+                              int           *partNumber,
+                              uint64        *archiveSize
+                             )
+{
+  Errors error;
+
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+  assert(archiveHandle->storageInfo != NULL);
+  assert(archiveHandle->storageInfo->jobOptions != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_CREATE);
+  assert(Semaphore_isOwned(&archiveHandle->lock));
+  assert(storageId != NULL);
+  assert(intermediateFileName != NULL);
+  assert(storedFlag != NULL);
+  assert(partNumber != NULL);
+  assert(archiveSize != NULL);
+
+  // init variables
+  (*storageId)   = INDEX_ID_NONE;
+  String_clear(intermediateFileName);
+  (*storedFlag)  = FALSE;
+  (*partNumber)  = ARCHIVE_PART_NUMBER_NONE;
+  (*archiveSize) = 0LL;
+
+  // flush index entries
+  if (!INDEX_ID_IS_NONE(archiveHandle->storageId))
+  {
+    error = flushArchiveIndexList(archiveHandle,
+                                  archiveHandle->uuidId,
+                                  archiveHandle->entityId,
+                                  archiveHandle->storageId,
+                                  0
+                                 );
+    if (error != ERROR_NONE)
+    {
+      discardArchiveFile(archiveHandle);
+      return error;
+    }
+  }
+
+  if (archiveHandle->create.openFlag)
+  {
+    // add table of contents
+    uint64 tocOffset = 0LL;
+    if (!List_isEmpty(&archiveHandle->tocList))
+    {
+      error = archiveHandle->chunkIO->tell(archiveHandle->chunkIOUserData,&tocOffset);
+      if (error == ERROR_NONE)
+      {
+        error = writeTOC(archiveHandle,
+                         archiveHandle->storageInfo->jobOptions->cryptAlgorithms[0]
+                        );
+      }
+      if (error != ERROR_NONE)
+      {
+        discardArchiveFile(archiveHandle);
+        return error;
+      }
+    }
+
+    // add signature
+    if (!archiveHandle->storageInfo->jobOptions->noSignatureFlag)
+    {
+      error = writeSignature(archiveHandle,
+                             &globalOptions.signaturePrivateKey
+                            );
+      if (error != ERROR_NONE)
+      {
+        discardArchiveFile(archiveHandle);
+        return error;
+      }
+    }
+
+    // add table of contents locator
+    if (!List_isEmpty(&archiveHandle->tocList))
+    {
+      error = writeTOCLocator(archiveHandle,tocOffset);
+      if (error != ERROR_NONE)
+      {
+        discardArchiveFile(archiveHandle);
+        return error;
+      }
+      List_clear(&archiveHandle->tocList);
+    }
+    archiveHandle->tocOverflowFlag = FALSE;
+
+    // get size
+    (*archiveSize) = Archive_getSize(archiveHandle);
+
+    if (archiveHandle->chunkIO == &CHUNK_IO_STREAM)
+    {
+      // store rest of buffered data
+      error = flushArchiveStream(&archiveHandle->create.stream,0);
+      if (error != ERROR_NONE)
+      {
+        discardArchiveFile(archiveHandle);
+        return error;
+      }
+
+      // close storage/file
+      closeArchiveStream(archiveHandle,FALSE);
+    }
+    else
+    {
+      // close file
+      (void)File_close(&archiveHandle->create.tmpFileHandle);
+    }
+
+    // mark created archive file "closed"
+    archiveHandle->create.openFlag = FALSE;
+
+    // get archive file data, increment part number
+    (*storageId) = archiveHandle->storageId;
+    if (archiveHandle->create.streamFlag)
+    {
+      (*storedFlag) = TRUE;
+    }
+    else
+    {
+      String_set(intermediateFileName,archiveHandle->create.tmpFileName);
+    }
+    if (isSplittedArchive(archiveHandle))
+    {
+      (*partNumber) = archiveHandle->partNumber;
+      archiveHandle->partNumber++;
+    }
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : storeArchiveFile
+* Purpose: store archive file
+* Input  : archiveHandle        - archive handle
+*          storageId            - storage index id
+*          intermediateFileName - intermediate file name or empty if
+*                                 archive file was streamed
+*          partNumber           - part number
+*          archiveSize          - archive size [bytes]
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors storeArchiveFile(ArchiveHandle *archiveHandle,
+                              IndexId       storageId,
+                              ConstString   intermediateFileName,
+                              int           partNumber,
+                              uint64        archiveSize
+                             )
+{
+  Errors error;
+
+  assert(archiveHandle != NULL);
+
+  // call-back to test intermediate archive
+  if (   (archiveHandle->archiveTestFunction != NULL)
+      && !String_isEmpty(intermediateFileName)
+     )
+  {
+    error = archiveHandle->archiveTestFunction(archiveHandle->storageInfo,
+                                                archiveHandle->jobUUID,
+                                                archiveHandle->entityUUID,
+                                                partNumber,
+                                                intermediateFileName,
+                                                archiveSize,
+                                                archiveHandle->archiveTestUserData
+                                               );
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    DEBUG_TESTCODE() { return DEBUG_TESTCODE_ERROR(); }
+  }
+
+  // call-back to store archive
+  if (archiveHandle->archiveStoreFunction != NULL)
+  {
+    error = archiveHandle->archiveStoreFunction(archiveHandle->storageInfo,
+                                                archiveHandle->uuidId,
+                                                archiveHandle->jobUUID,
+                                                archiveHandle->entityUUID,
+                                                archiveHandle->entityId,
+                                                storageId,
+                                                partNumber,
+                                                intermediateFileName,
+                                                archiveSize,
+                                                archiveHandle->archiveStoreUserData
+                                               );
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    DEBUG_TESTCODE() { return DEBUG_TESTCODE_ERROR(); }
+  }
+
+  // call-back for done archive
+  if (archiveHandle->archiveDoneFunction != NULL)
+  {
+    error = archiveHandle->archiveDoneFunction(archiveHandle->storageInfo,
+                                               archiveHandle->uuidId,
+                                               archiveHandle->jobUUID,
+                                               archiveHandle->entityUUID,
+                                               archiveHandle->entityId,
+                                               archiveHandle->archiveType,
+                                               storageId,
+                                               partNumber,
+                                               archiveHandle->archiveDoneUserData
+                                              );
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    DEBUG_TESTCODE() { return DEBUG_TESTCODE_ERROR(); }
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : ensureArchiveSpace
+* Purpose: ensure space is available in archive for not fragmented
+*          writing
+* Input  : archiveHandle - archive handle
+*          minBytes      - minimal number of bytes
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors ensureArchiveSpace(ArchiveHandle *archiveHandle,
+                                ulong         minBytes
+                               )
+{
+  Errors error;
+
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+  assert(archiveHandle->mode == ARCHIVE_MODE_CREATE);
+  assert(Semaphore_isOwned(&archiveHandle->lock));
+
+  // check if split is necessary
+  if (isNewPartNeeded(archiveHandle,
+                      minBytes
+                     )
+     )
+  {
+    // split needed -> close created archive file
+    if (archiveHandle->create.openFlag)
+    {
+      // init variables
+      String intermediateFileName = String_new();
+
+      // close archive file
+      IndexId storageId;
+      bool    storedFlag;
+      int     partNumber;
+      uint64  archiveSize;
+      error = closeArchiveFile(archiveHandle,
+                               &storageId,
+                               intermediateFileName,
+                               &storedFlag,
+                               &partNumber,
+                               &archiveSize
+                              );
+      if (error != ERROR_NONE)
+      {
+        String_delete(intermediateFileName);
+        return error;
+      }
+
+// TODO: activate when removed IndexStorage_updateInfos() from commands_create.c
+#if 0
+      // update index aggregates
+      if (archiveHandle->indexHandle != NULL)
+      {
+      error = IndexStorage_updateInfos(archiveHandle->indexHandle,
+                                       storageId
+                                      );
+      if (error != ERROR_NONE)
+      {
+        String_delete(intermediateFileName);
+        return error;
+      }
+      }
+#endif
+
+      // store archive file
+      error = storeArchiveFile(archiveHandle,
+                               storageId,
+                               intermediateFileName,
+                               partNumber,
+                               archiveSize
+                              );
+      if (error != ERROR_NONE)
+      {
+        if (storedFlag)
+        {
+          (void)Storage_delete(archiveHandle->storageInfo,archiveHandle->create.stream.archiveName);
+        }
+        else
+        {
+          (void)File_delete(intermediateFileName,FALSE);
+        }
+        String_delete(intermediateFileName);
+        return error;
+      }
+
+      // free resources
+      String_delete(intermediateFileName);
+    }
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : transferToArchive
+* Purpose: transfer file data from temporary file to archive, update
+*          signature hash
+* Input  : archiveHandle - archive handle
+*          fileHandle    - file handle of temporary file
+* Output : offset - offset of transferred data in archive file
+* Return : ERROR_NONE or error code
+* Notes  : archive must be locked; the transfer is serialized by the
+*          archive lock, so threads closing entries wait for each
+*          other while the data of one entry is copied into the
+*          archive (only compress/encrypt of the data blocks runs in
+*          parallel)
+\***********************************************************************/
+
+LOCAL Errors transferToArchive(const ArchiveHandle *archiveHandle,
+                               FileHandle          *fileHandle,
+                               uint64              *offset
+                              )
+{
+  #define TRANSFER_BUFFER_SIZE (1024*1024)
+
+  Errors error;
+
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+  assert(archiveHandle->chunkIO != NULL);
+  assert(archiveHandle->chunkIO->write != NULL);
+  assert(fileHandle != NULL);
+  assert(offset != NULL);
+  assert(Semaphore_isOwned(&archiveHandle->lock));
+
+  // get archive offset
+  error = archiveHandle->chunkIO->tell(archiveHandle->chunkIOUserData,offset);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  // seek to begin of file
+  error = File_seek(fileHandle,0LL);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  // get length
+  uint64 length = File_getSize(fileHandle);
+
+  if (archiveHandle->chunkIO == &CHUNK_IO_FILE)
+  {
+    // transfer data directly into local archive file (Note: archive is not signed)
+    error = File_transfer((FileHandle*)archiveHandle->chunkIOUserData,
+                          fileHandle,
+                          (int64)length,
+                          NULL
+                         );
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+  }
+  else
+  {
+    // init variables
+    void *buffer = malloc(TRANSFER_BUFFER_SIZE);
+    if (buffer == NULL)
+    {
+      HALT_INSUFFICIENT_MEMORY();
+    }
+
+    // transfer data
+    while (length > 0LL)
+    {
+      ulong n = MIN(length,TRANSFER_BUFFER_SIZE);
+
+      // read data
+      error = File_read(fileHandle,buffer,n,NULL);
+      if (error != ERROR_NONE)
+      {
+        free(buffer);
+        return error;
+      }
+
+      // write to archive stream (Note: signature hash is updated when data is stored)
+      error = archiveHandle->chunkIO->write(archiveHandle->chunkIOUserData,buffer,n);
+      if (error != ERROR_NONE)
+      {
+        free(buffer);
+        return error;
+      }
+
+      length -= (uint64)n;
+    }
+
+    // free resources
+    free(buffer);
+  }
+
+  // truncate file for reusage
+  File_truncate(fileHandle,0LL);
+
+  return ERROR_NONE;
+
+  #undef TRANSFER_BUFFER_SIZE
+}
+
+/***********************************************************************\
+* Name   : checkAdaptiveCompress
+* Purpose: check if first data block of an entry is compressible and
+*          disable byte compression if not
+* Input  : adaptiveCompressFlag   - adaptive compress flag
+*          deltaCompressAlgorithm - delta compress algorithm
+*          byteCompressAlgorithm  - byte compress algorithm
+*          byteCompressInfo       - byte compress info
+*          chunkInfo              - entry chunk info
+*          chunkCompressAlgorithm - compress algorithm of entry chunk
+*          buffer                 - first data block
+*          length                 - length of data block
+* Output : adaptiveCompressFlag   - FALSE
+*          byteCompressAlgorithm  - byte compress algorithm
+*          chunkCompressAlgorithm - compress algorithm of entry chunk
+* Return : ERROR_NONE or error code
+* Notes  : must be called before any data is written; the decision is
+*          stored in the already written entry chunk, thus restore is
+*          not affected
+\***********************************************************************/
+
+LOCAL Errors checkAdaptiveCompress(bool               *adaptiveCompressFlag,
+                                   CompressAlgorithms deltaCompressAlgorithm,
+                                   CompressAlgorithms *byteCompressAlgorithm,
+                                   CompressInfo       *byteCompressInfo,
+                                   ChunkInfo          *chunkInfo,
+                                   uint16             *chunkCompressAlgorithm,
+                                   const void         *buffer,
+                                   ulong              length
+                                  )
+{
+  assert(adaptiveCompressFlag != NULL);
+  assert(byteCompressAlgorithm != NULL);
+  assert(byteCompressInfo != NULL);
+  assert(chunkInfo != NULL);
+  assert(chunkCompressAlgorithm != NULL);
+
+  if (!(*adaptiveCompressFlag))
+  {
+    return ERROR_NONE;
+  }
+  (*adaptiveCompressFlag) = FALSE;
+
+  // byte compression of delta-compressed data cannot be estimated by source data
+  if (   !Compress_isCompressed(*byteCompressAlgorithm)
+      || Compress_isCompressed(deltaCompressAlgorithm)
+     )
+  {
+    return ERROR_NONE;
+  }
+
+  if (!Compress_isCompressible(buffer,length))
+  {
+    Errors error = Compress_disable(byteCompressInfo);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    (*byteCompressAlgorithm)  = COMPRESS_ALGORITHM_NONE;
+
+    // update entry chunk
+    (*chunkCompressAlgorithm) = COMPRESS_ALGORITHM_TO_CONSTANT(COMPRESS_ALGORITHM_NONE);
+    error = Chunk_update(chunkInfo);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : getFragmentSize
+* Purpose: get fragment size of written data
+* Input  : fileHoleList   - holes list or NULL
+*          fragmentOffset - fragment offset [bytes]
+*          dataSize       - size of written data [bytes]
+* Output : -
+* Return : fragment size [bytes]
+* Notes  : data of holes is not written; the fragment includes the
+*          holes inside and adjacent to the written data
+\***********************************************************************/
+
+LOCAL uint64 getFragmentSize(const FileHoleList *fileHoleList, uint64 fragmentOffset, uint64 dataSize)
+{
+  return (fileHoleList != NULL)
+           ? File_getRangeSize(fileHoleList,fragmentOffset,dataSize)
+           : dataSize;
+}
+
+/***********************************************************************\
+* Name   : writeFileChunks
+* Purpose: write file chunks
+* Input  : archiveEntryInfo - archive file entry info
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors writeFileChunks(ArchiveEntryInfo *archiveEntryInfo)
+{
+  Errors error;
+
+  assert(archiveEntryInfo != NULL);
+  assert(archiveEntryInfo->archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveEntryInfo->archiveHandle);
+  assert(!archiveEntryInfo->file.headerWrittenFlag);
+
+  // create file chunk
+  error = Chunk_create(&archiveEntryInfo->file.chunkFile.info);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  // create file entry chunk
+  error = Chunk_create(&archiveEntryInfo->file.chunkFileEntry.info);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  // create extended attribute chunks
+  FileExtendedAttributeNode *fileExtendedAttributeNode;
+  LIST_ITERATE(archiveEntryInfo->file.fileExtendedAttributeList,fileExtendedAttributeNode)
+  {
+    String_set(archiveEntryInfo->file.chunkFileExtendedAttribute.name,fileExtendedAttributeNode->name);
+    archiveEntryInfo->file.chunkFileExtendedAttribute.value.data   = fileExtendedAttributeNode->data;
+    archiveEntryInfo->file.chunkFileExtendedAttribute.value.length = fileExtendedAttributeNode->dataLength;
+
+    error = Chunk_create(&archiveEntryInfo->file.chunkFileExtendedAttribute.info);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    error = Chunk_close(&archiveEntryInfo->file.chunkFileExtendedAttribute.info);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+  }
+
+  // create file delta chunk
+  if (Compress_isCompressed(archiveEntryInfo->file.deltaCompressAlgorithm))
+  {
+    assert(Compress_isDeltaCompressed(archiveEntryInfo->file.deltaCompressAlgorithm));
+
+    archiveEntryInfo->file.chunkFileDelta.deltaAlgorithm = COMPRESS_ALGORITHM_TO_CONSTANT(archiveEntryInfo->file.deltaCompressAlgorithm);
+    String_set(archiveEntryInfo->file.chunkFileDelta.name,DeltaSource_getName(&archiveEntryInfo->file.deltaSourceHandle));
+    archiveEntryInfo->file.chunkFileDelta.size           = DeltaSource_getSize(&archiveEntryInfo->file.deltaSourceHandle);
+
+    error = Chunk_create(&archiveEntryInfo->file.chunkFileDelta.info);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    error = Chunk_close(&archiveEntryInfo->file.chunkFileDelta.info);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+  }
+
+  // create hole chunks
+  if (archiveEntryInfo->file.fileHoleList != NULL)
+  {
+    const FileHoleNode *fileHoleNode;
+    LIST_ITERATE(archiveEntryInfo->file.fileHoleList,fileHoleNode)
+    {
+      archiveEntryInfo->file.chunkFileHole.offset = fileHoleNode->offset;
+      archiveEntryInfo->file.chunkFileHole.size   = fileHoleNode->size;
+
+      error = Chunk_create(&archiveEntryInfo->file.chunkFileHole.info);
+      if (error != ERROR_NONE)
+      {
+        return error;
+      }
+      error = Chunk_close(&archiveEntryInfo->file.chunkFileHole.info);
+      if (error != ERROR_NONE)
+      {
+        return error;
+      }
+    }
+  }
+
+  // create file reference chunk
+  if (!String_isEmpty(archiveEntryInfo->file.referenceName))
+  {
+    error = Chunk_create(&archiveEntryInfo->file.chunkFileReference.info);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    error = Chunk_close(&archiveEntryInfo->file.chunkFileReference.info);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+  }
+
+  // create file data chunk
+  error = Chunk_create(&archiveEntryInfo->file.chunkFileData.info);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  // mark header "written"
+  archiveEntryInfo->file.headerWrittenFlag = TRUE;
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : flushFileDataBlocks
+* Purpose: flush file data blocks
+* Input  : archiveEntryInfo  - archive file entry info data
+*          compressBlockType - compress block type; see CompressBlockTypes
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors flushFileDataBlocks(ArchiveEntryInfo   *archiveEntryInfo,
+                                 CompressBlockTypes compressBlockType
+                                )
+{
+  Errors error;
+
+  assert(archiveEntryInfo != NULL);
+  assert(archiveEntryInfo->archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveEntryInfo->archiveHandle);
+  assert(archiveEntryInfo->file.byteCompressInfo.blockLength != 0);
+
+  uint blockCount;
+  do
+  {
+    error = Compress_getAvailableCompressedBlocks(&archiveEntryInfo->file.byteCompressInfo,
+                                                  compressBlockType,
+                                                  &blockCount
+                                                 );
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+
+    if (blockCount > 0)
+    {
+      // write file header (if not already written)
+      if (!archiveEntryInfo->file.headerWrittenFlag)
+      {
+        error = writeFileChunks(archiveEntryInfo);
+        if (error != ERROR_NONE)
+        {
+          return error;
+        }
+      }
+      assert(archiveEntryInfo->file.headerWrittenFlag);
+
+      // get max. number of byte-compressed data blocks to write
+      ulong maxBlockCount = MIN(archiveEntryInfo->file.byteBufferSize/archiveEntryInfo->file.byteCompressInfo.blockLength,
+                                blockCount
+                               );
+
+      // get byte-compressed data blocks
+      ulong byteLength;
+      Compress_getCompressedData(&archiveEntryInfo->file.byteCompressInfo,
+                                 archiveEntryInfo->file.byteBuffer,
+                                 maxBlockCount*archiveEntryInfo->file.byteCompressInfo.blockLength,
+                                 &byteLength
+                                );
+      assert(byteLength > 0);
+      assert((byteLength%archiveEntryInfo->file.byteCompressInfo.blockLength) == 0);
+
+      // encrypt block
+//fprintf(stderr,"%s, %d: cryptBytes=%d\n",__FILE__,__LINE__,byteLength); debugDumpMemory(archiveEntryInfo->file.byteBuffer,byteLength,FALSE);
+      error = Crypt_encryptBytes(&archiveEntryInfo->file.cryptInfo,
+                                 archiveEntryInfo->file.byteBuffer,
+                                 byteLength
+                                );
+      if (error != ERROR_NONE)
+      {
+        return error;
+      }
+
+      #ifdef DEBUG_ENCODED_DATA_FILENAME
+        {
+          int handle = open64(DEBUG_ENCODED_DATA_FILENAME,O_CREAT|O_WRONLY|O_APPEND|O_LARGEFILE,0664);
+          write(handle,archiveEntryInfo->file.byteBuffer,byteLength);
+          close(handle);
+        }
+      #endif /* DEBUG_ENCODED_DATA_FILENAME */
+
+      // write data block
+      error = Chunk_writeData(&archiveEntryInfo->file.chunkFileData.info,
+                              archiveEntryInfo->file.byteBuffer,
+                              byteLength
+                             );
+      if (error != ERROR_NONE)
+      {
+        return error;
+      }
+    }
+  }
+  while (blockCount > 0);
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : writeFileDataBlocks
+* Purpose: encrypt and write file blocks, split archive
+* Input  : archiveEntryInfo - archive file entry info data
+*          allowNewPartFlag - TRUE iff new archive part can be created
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors writeFileDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
+                                 bool             allowNewPartFlag
+                                )
+{
+  Errors error;
+
+  assert(archiveEntryInfo != NULL);
+  assert(archiveEntryInfo->archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveEntryInfo->archiveHandle);
+  assert(archiveEntryInfo->archiveHandle->mode == ARCHIVE_MODE_CREATE);
+  assert(archiveEntryInfo->file.byteCompressInfo.blockLength != 0);
+
+  uint blockCount;
+  do
+  {
+    error = Compress_getAvailableCompressedBlocks(&archiveEntryInfo->file.byteCompressInfo,
+                                                  COMPRESS_BLOCK_TYPE_FULL,
+                                                  &blockCount
+                                                );
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+
+    if (blockCount > 0)
+    {
+      // get byte-compressed data blocks
+      assert(archiveEntryInfo->file.byteBufferSize >= (blockCount*archiveEntryInfo->file.byteCompressInfo.blockLength));
+      ulong byteLength;
+      Compress_getCompressedData(&archiveEntryInfo->file.byteCompressInfo,
+                                 archiveEntryInfo->file.byteBuffer,
+                                 blockCount*archiveEntryInfo->file.byteCompressInfo.blockLength,
+                                 &byteLength
+                                );
+      assert(byteLength > 0);
+      assert((byteLength%archiveEntryInfo->file.byteCompressInfo.blockLength) == 0);
+
+      // calculate min. bytes to tramsfer to archive
+      ulong minBytes = (ulong)File_getSize(&archiveEntryInfo->file.intermediateFileHandle)+byteLength;
+
+      // lock (only needed for split, otherwise data is written into the intermediate file of the entry)
+      bool lockedFlag = allowNewPartFlag && isSplittedArchive(archiveEntryInfo->archiveHandle);
+      if (lockedFlag)
+      {
+        Semaphore_lock(&archiveEntryInfo->archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER);
+      }
+
+      // check if split is allowed and necessary
+      bool newPartFlag =    lockedFlag
+                         && isNewPartNeeded(archiveEntryInfo->archiveHandle,
+                                       (!archiveEntryInfo->file.headerWrittenFlag ? archiveEntryInfo->file.headerLength : 0) + minBytes
+                                      );
+
+      // split
+      if (newPartFlag)
+      {
+        // init variables
+        String intermediateFileName = String_new();
+
+        // write file header (if not already written)
+        if (!archiveEntryInfo->file.headerWrittenFlag)
+        {
+          error = writeFileChunks(archiveEntryInfo);
+          if (error != ERROR_NONE)
+          {
+            String_delete(intermediateFileName);
+            Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+            return error;
+          }
+        }
+        assert(archiveEntryInfo->file.headerWrittenFlag);
+
+        // write last compressed block (if any)
+        if (byteLength > 0L)
+        {
+          // encrypt block
+//fprintf(stderr,"%s, %d: cryptBytes=%d\n",__FILE__,__LINE__,byteLength); debugDumpMemory(archiveEntryInfo->file.byteBuffer,byteLength,FALSE);
+          error = Crypt_encryptBytes(&archiveEntryInfo->file.cryptInfo,
+                                     archiveEntryInfo->file.byteBuffer,
+                                     byteLength
+                                    );
+          if (error != ERROR_NONE)
+          {
+            String_delete(intermediateFileName);
+            Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+            return error;
+          }
+
+          #ifdef DEBUG_ENCODED_DATA_FILENAME
+            {
+              int handle = open64(DEBUG_ENCODED_DATA_FILENAME,O_CREAT|O_WRONLY|O_APPEND|O_LARGEFILE,0664);
+              write(handle,archiveEntryInfo->file.byteBuffer,byteLength);
+              close(handle);
+            }
+          #endif /* DEBUG_ENCODED_DATA_FILENAME */
+
+          // store block into chunk
+          error = Chunk_writeData(&archiveEntryInfo->file.chunkFileData.info,
+                                  archiveEntryInfo->file.byteBuffer,
+                                  byteLength
+                                );
+          if (error != ERROR_NONE)
+          {
+            String_delete(intermediateFileName);
+            Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+            return error;
+          }
+        }
+
+        // flush delta compress
+        error = Compress_flush(&archiveEntryInfo->file.deltaCompressInfo);
+        if (error != ERROR_NONE)
+        {
+          String_delete(intermediateFileName);
+          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+          return error;
+        }
+        bool eofDelta = FALSE;
+        do
+        {
+          // flush compressed full data blocks
+          error = flushFileDataBlocks(archiveEntryInfo,COMPRESS_BLOCK_TYPE_FULL);
+          if (error != ERROR_NONE)
+          {
+            String_delete(intermediateFileName);
+            Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+            return error;
+          }
+
+          // get next delta-compressed data
+          ulong deltaLength;
+          Compress_getCompressedData(&archiveEntryInfo->file.deltaCompressInfo,
+                                     archiveEntryInfo->file.deltaBuffer,
+                                     archiveEntryInfo->file.deltaBufferSize,
+                                     &deltaLength
+                                    );
+          if (deltaLength > 0)
+          {
+            // byte-compress data
+            error = Compress_deflate(&archiveEntryInfo->file.byteCompressInfo,
+                                     archiveEntryInfo->file.deltaBuffer,
+                                     deltaLength,
+                                     NULL
+                                    );
+            if (error != ERROR_NONE)
+            {
+              String_delete(intermediateFileName);
+              Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+              return error;
+            }
+          }
+          else
+          {
+            eofDelta = TRUE;
+          }
+        }
+        while (!eofDelta);
+
+        // flush byte compress
+        error = Compress_flush(&archiveEntryInfo->file.byteCompressInfo);
+        if (error != ERROR_NONE)
+        {
+          String_delete(intermediateFileName);
+          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+          return error;
+        }
+        error = flushFileDataBlocks(archiveEntryInfo,COMPRESS_BLOCK_TYPE_ANY);
+        if (error != ERROR_NONE)
+        {
+          String_delete(intermediateFileName);
+          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+          return error;
+        }
+
+        // update fragment size
+        archiveEntryInfo->file.chunkFileData.fragmentSize = getFragmentSize(archiveEntryInfo->file.fileHoleList,
+                                                                            archiveEntryInfo->file.chunkFileData.fragmentOffset,
+                                                                            Compress_getInputLength(&archiveEntryInfo->file.deltaCompressInfo)
+                                                                           );
+        error = Chunk_update(&archiveEntryInfo->file.chunkFileData.info);
+        if (error != ERROR_NONE)
+        {
+          String_delete(intermediateFileName);
+          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+          return error;
+        }
+
+        // close chunks
+        error = Chunk_close(&archiveEntryInfo->file.chunkFileData.info);
+        if (error != ERROR_NONE)
+        {
+          String_delete(intermediateFileName);
+          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+          return error;
+        }
+        error = Chunk_close(&archiveEntryInfo->file.chunkFileEntry.info);
+        if (error != ERROR_NONE)
+        {
+          String_delete(intermediateFileName);
+          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+          return error;
+        }
+        error = Chunk_close(&archiveEntryInfo->file.chunkFile.info);
+        if (error != ERROR_NONE)
+        {
+          String_delete(intermediateFileName);
+          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+          return error;
+        }
+
+        // reset header "written"
+        archiveEntryInfo->file.headerWrittenFlag = FALSE;
+
+        // create archive file (if not already created)
+        error = createArchiveFile(archiveEntryInfo->archiveHandle);
+        if (error != ERROR_NONE)
+        {
+          String_delete(intermediateFileName);
+          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+          return error;
+        }
+
+        // transfer intermediate data into archive
+        uint64 offset;
+        error = transferToArchive(archiveEntryInfo->archiveHandle,
+                                  &archiveEntryInfo->file.intermediateFileHandle,
+                                  &offset
+                                 );
+        if (error != ERROR_NONE)
+        {
+          String_delete(intermediateFileName);
+          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+          return error;
+        }
+
+        // add to table of contents
+        addTOCEntries(archiveEntryInfo,offset);
+
+        // add to index database
+        if (Index_isAvailable())
+        {
+          // add file entry
+          error = indexAddFile(archiveEntryInfo->archiveHandle,
+                               archiveEntryInfo->file.chunkFileEntry.name,
+                               archiveEntryInfo->file.chunkFileEntry.size,
+                               archiveEntryInfo->file.chunkFileEntry.timeLastAccess,
+                               archiveEntryInfo->file.chunkFileEntry.timeModified,
+                               archiveEntryInfo->file.chunkFileEntry.timeLastChanged,
+                               archiveEntryInfo->file.chunkFileEntry.userId,
+                               archiveEntryInfo->file.chunkFileEntry.groupId,
+                               archiveEntryInfo->file.chunkFileEntry.permissions,
+                               archiveEntryInfo->file.chunkFileData.fragmentOffset,
+                               archiveEntryInfo->file.chunkFileData.fragmentSize,
+                               offset
+                              );
+          if (error != ERROR_NONE)
+          {
+            String_delete(intermediateFileName);
+            Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+            return error;
+          }
+        }
+
+        // close archive
+        IndexId storageId;
+        bool    storedFlag;
+        int     partNumber;
+        uint64  archiveSize;
+        error = closeArchiveFile(archiveEntryInfo->archiveHandle,
+                                 &storageId,
+                                 intermediateFileName,
+                                 &storedFlag,
+                                 &partNumber,
+                                 &archiveSize
+                                );
+        if (error != ERROR_NONE)
+        {
+          String_delete(intermediateFileName);
+          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+          return error;
+        }
+
+        // update fragment offset for next fragment, reset size
+        archiveEntryInfo->file.chunkFileData.fragmentOffset += archiveEntryInfo->file.chunkFileData.fragmentSize;
+        archiveEntryInfo->file.chunkFileData.fragmentSize   =  0LL;
+
+        // set new delta base-offset
+        if (archiveEntryInfo->file.deltaSourceHandleInitFlag)
+        {
+          assert(Compress_isDeltaCompressed(archiveEntryInfo->file.deltaCompressAlgorithm));
+          DeltaSource_setBaseOffset(&archiveEntryInfo->file.deltaSourceHandle,
+                                    archiveEntryInfo->file.chunkFileData.fragmentSize
+                                   );
+        }
+
+        /* reset compress, encrypt (do it here because data if buffered and can be
+          processed before a new file is opened)
+        */
+        Compress_reset(&archiveEntryInfo->file.deltaCompressInfo);
+        Compress_reset(&archiveEntryInfo->file.byteCompressInfo);
+        Crypt_reset(&archiveEntryInfo->file.cryptInfo);
+
+        // find next suitable archive part
+        findNextArchivePart(archiveEntryInfo->archiveHandle);
+
+        // unlock
+        Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+
+// TODO: activate when removed IndexStorage_updateInfos() from commands_create.c
+#if 0
+        // update index aggregates
+        if (archiveHandle->indexHandle != NULL)
+        {
+        error = IndexStorage_updateInfos(archiveEntryInfo->archiveHandle->indexHandle,
+                                         storageId
+                                        );
+        if (error != ERROR_NONE)
+        {
+          String_delete(intermediateFileName);
+          return error;
+        }
+        }
+#endif
+
+        // store archive file
+        error = storeArchiveFile(archiveEntryInfo->archiveHandle,storageId,intermediateFileName,partNumber,archiveSize);
+        if (error != ERROR_NONE)
+        {
+          (void)File_delete(intermediateFileName,FALSE);
+          String_delete(intermediateFileName);
+          return error;
+        }
+
+        // free resources
+        String_delete(intermediateFileName);
+      }
+      else
+      {
+        // unlock
+        if (lockedFlag)
+        {
+          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+        }
+
+        // write file header (if not already written)
+        if (!archiveEntryInfo->file.headerWrittenFlag)
+        {
+          error = writeFileChunks(archiveEntryInfo);
+          if (error != ERROR_NONE)
+          {
+            return error;
+          }
+        }
+
+        // encrypt block
+//fprintf(stderr,"%s, %d: cryptBytes=%d\n",__FILE__,__LINE__,byteLength); debugDumpMemory(archiveEntryInfo->file.byteBuffer,byteLength,FALSE);
+        error = Crypt_encryptBytes(&archiveEntryInfo->file.cryptInfo,
+                                   archiveEntryInfo->file.byteBuffer,
+                                   byteLength
+                                  );
+        if (error != ERROR_NONE)
+        {
+          return error;
+        }
+
+        #ifdef DEBUG_ENCODED_DATA_FILENAME
+          {
+            int handle = open64(DEBUG_ENCODED_DATA_FILENAME,O_CREAT|O_WRONLY|O_APPEND|O_LARGEFILE,0664);
+            write(handle,archiveEntryInfo->file.byteBuffer,byteLength);
+            close(handle);
+          }
+        #endif /* DEBUG_ENCODED_DATA_FILENAME */
+
+        // write data block
+        error = Chunk_writeData(&archiveEntryInfo->file.chunkFileData.info,
+                                archiveEntryInfo->file.byteBuffer,
+                                byteLength
+                               );
+        if (error != ERROR_NONE)
+        {
+          return error;
+        }
+      }
+    }
+  }
+  while (blockCount > 0);
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : readFileDataBlock
+* Purpose: read file data block, decrypt
+* Input  : archiveEntryInfo - archive file entry info data
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors readFileDataBlock(ArchiveEntryInfo *archiveEntryInfo)
+{
+  Errors error;
+
+  assert(archiveEntryInfo != NULL);
+  assert(archiveEntryInfo->file.byteCompressInfo.blockLength != 0);
+
+  if      (!Chunk_eofSub(&archiveEntryInfo->file.chunkFileData.info))
+  {
+    // get max. bytes to read (always multiple of block length)
+    ulong maxBytes = FLOOR(MIN(Compress_getFreeCompressSpace(&archiveEntryInfo->file.byteCompressInfo),
+                               archiveEntryInfo->file.byteBufferSize
+                              ),
+                           archiveEntryInfo->file.byteCompressInfo.blockLength
+                          );
+    assert((maxBytes%archiveEntryInfo->file.byteCompressInfo.blockLength) == 0);
+
+    // read data from archive
+    ulong bytesRead;
+    error = Chunk_readData(&archiveEntryInfo->file.chunkFileData.info,
+                           archiveEntryInfo->file.byteBuffer,
+                           maxBytes,
+                           &bytesRead
+                          );
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    if (bytesRead <= 0L)
+    {
+      return ERROR_READ_FILE;
+    }
+    if ((bytesRead % archiveEntryInfo->file.byteCompressInfo.blockLength) != 0)
+    {
+      return ERROR_INCOMPLETE_ARCHIVE;
+    }
+
+    // decrypt data
+    error = Crypt_decryptBytes(&archiveEntryInfo->file.cryptInfo,
+                               archiveEntryInfo->file.byteBuffer,
+                               bytesRead
+                              );
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+//fprintf(stderr,"%s, %d: decryptBytes=%d\n",__FILE__,__LINE__,bytesRead); debugDumpMemory(archiveEntryInfo->file.byteBuffer,bytesRead,FALSE);
+
+    // put decrypted data into decompressor
+    Compress_putCompressedData(&archiveEntryInfo->file.byteCompressInfo,
+                               archiveEntryInfo->file.byteBuffer,
+                               bytesRead
+                              );
+  }
+  else if (!Compress_isFlush(&archiveEntryInfo->file.byteCompressInfo))
+  {
+    // no more data in archive -> flush byte-compress
+    error = Compress_flush(&archiveEntryInfo->file.byteCompressInfo);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+  }
+  else
+  {
+    // check for end-of-compressed byte-data
+    ulong n;
+    error = Compress_getAvailableDecompressedBytes(&archiveEntryInfo->file.byteCompressInfo,
+                                                   &n
+                                                  );
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    if (n <= 0)
+    {
+      return ERROR_COMPRESS_EOF;
+    }
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : flushSolidDataBlocks
+* Purpose: flush solid block data blocks
+* Input  : archiveEntryInfo  - archive solid entry info data
+*          compressBlockType - compress block type; see CompressBlockTypes
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors flushSolidDataBlocks(ArchiveEntryInfo   *archiveEntryInfo,
+                                  CompressBlockTypes compressBlockType
+                                 )
+{
+  Errors error;
+
+  assert(archiveEntryInfo != NULL);
+  assert(archiveEntryInfo->archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveEntryInfo->archiveHandle);
+  assert(archiveEntryInfo->solid.byteCompressInfo.blockLength != 0);
+
+  uint blockCount;
+  do
+  {
+    error = Compress_getAvailableCompressedBlocks(&archiveEntryInfo->solid.byteCompressInfo,
+                                                  compressBlockType,
+                                                  &blockCount
+                                                 );
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
 
     if (blockCount > 0)
     {
+      // get max. number of byte-compressed data blocks to write
+      ulong maxBlockCount = MIN(archiveEntryInfo->solid.byteBufferSize/archiveEntryInfo->solid.byteCompressInfo.blockLength,
+                                blockCount
+                               );
+
       // get byte-compressed data blocks
-      assert(archiveEntryInfo->file.byteBufferSize >= (blockCount*archiveEntryInfo->file.byteCompressInfo.blockLength));
       ulong byteLength;
-      Compress_getCompressedData(&archiveEntryInfo->file.byteCompressInfo,
-                                 archiveEntryInfo->file.byteBuffer,
-                                 blockCount*archiveEntryInfo->file.byteCompressInfo.blockLength,
+      Compress_getCompressedData(&archiveEntryInfo->solid.byteCompressInfo,
+                                 archiveEntryInfo->solid.byteBuffer,
+                                 maxBlockCount*archiveEntryInfo->solid.byteCompressInfo.blockLength,
                                  &byteLength
                                 );
       assert(byteLength > 0);
-      assert((byteLength%archiveEntryInfo->file.byteCompressInfo.blockLength) == 0);
-
-      // calculate min. bytes to tramsfer to archive
-      ulong minBytes = (ulong)File_getSize(&archiveEntryInfo->file.intermediateFileHandle)+byteLength;
+      assert((byteLength%archiveEntryInfo->solid.byteCompressInfo.blockLength) == 0);
 
-      // lock
-      Semaphore_lock(&archiveEntryInfo->archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER);
-
-      // check if split is allowed and necessary
-      bool newPartFlag =    allowNewPartFlag
-                         && isNewPartNeeded(archiveEntryInfo->archiveHandle,
-                                       (!archiveEntryInfo->file.headerWrittenFlag ? archiveEntryInfo->file.headerLength : 0) + minBytes
-                                      );
+      // encrypt block
+      error = Crypt_encryptBytes(&archiveEntryInfo->solid.cryptInfo,
+                                 archiveEntryInfo->solid.byteBuffer,
+                                 byteLength
+                                );
+      if (error != ERROR_NONE)
+      {
+        return error;
+      }
 
-      // split
-      if (newPartFlag)
+      // write data block (Note: whole solid block is written into the intermediate file, no split)
+      error = Chunk_writeData(&archiveEntryInfo->solid.chunkSolidData.info,
+                              archiveEntryInfo->solid.byteBuffer,
+                              byteLength
+                             );
+      if (error != ERROR_NONE)
       {
-        // init variables
-        String intermediateFileName = String_new();
+        return error;
+      }
+    }
+  }
+  while (blockCount > 0);
 
-        // write file header (if not already written)
-        if (!archiveEntryInfo->file.headerWrittenFlag)
-        {
-          error = writeFileChunks(archiveEntryInfo);
-          if (error != ERROR_NONE)
-          {
-            String_delete(intermediateFileName);
-            Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-            return error;
-          }
-        }
-        assert(archiveEntryInfo->file.headerWrittenFlag);
+  return ERROR_NONE;
+}
 
-        // write last compressed block (if any)
-        if (byteLength > 0L)
-        {
-          // encrypt block
-//fprintf(stderr,"%s, %d: cryptBytes=%d\n",__FILE__,__LINE__,byteLength); debugDumpMemory(archiveEntryInfo->file.byteBuffer,byteLength,FALSE);
-          error = Crypt_encryptBytes(&archiveEntryInfo->file.cryptInfo,
-                                     archiveEntryInfo->file.byteBuffer,
-                                     byteLength
-                                    );
-          if (error != ERROR_NONE)
-          {
-            String_delete(intermediateFileName);
-            Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-            return error;
-          }
+/***********************************************************************\
+* Name   : writeSolidMemberChunks
+* Purpose: write file chunks of solid block member
+* Input  : archiveEntryInfo       - archive solid entry info data
+*          archiveSolidMemberNode - solid block member
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
 
-          #ifdef DEBUG_ENCODED_DATA_FILENAME
-            {
-              int handle = open64(DEBUG_ENCODED_DATA_FILENAME,O_CREAT|O_WRONLY|O_APPEND|O_LARGEFILE,0664);
-              write(handle,archiveEntryInfo->file.byteBuffer,byteLength);
-              close(handle);
-            }
-          #endif /* DEBUG_ENCODED_DATA_FILENAME */
+LOCAL Errors writeSolidMemberChunks(ArchiveEntryInfo             *archiveEntryInfo,
+                                    const ArchiveSolidMemberNode *archiveSolidMemberNode
+                                   )
+{
+  Errors error;
 
-          // store block into chunk
-          error = Chunk_writeData(&archiveEntryInfo->file.chunkFileData.info,
-                                  archiveEntryInfo->file.byteBuffer,
-                                  byteLength
-                                );
-          if (error != ERROR_NONE)
-          {
-            String_delete(intermediateFileName);
-            Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-            return error;
-          }
-        }
+  assert(archiveEntryInfo != NULL);
+  assert(archiveEntryInfo->archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveEntryInfo->archiveHandle);
+  assert(archiveSolidMemberNode != NULL);
 
-        // flush delta compress
-        error = Compress_flush(&archiveEntryInfo->file.deltaCompressInfo);
-        if (error != ERROR_NONE)
-        {
-          String_delete(intermediateFileName);
-          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-          return error;
-        }
-        bool eofDelta = FALSE;
-        do
-        {
-          // flush compressed full data blocks
-          error = flushFileDataBlocks(archiveEntryInfo,COMPRESS_BLOCK_TYPE_FULL);
-          if (error != ERROR_NONE)
-          {
-            String_delete(intermediateFileName);
-            Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-            return error;
-          }
+  // create file chunk
+  error = Chunk_create(&archiveEntryInfo->solid.chunkFile.info);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
 
-          // get next delta-compressed data
-          ulong deltaLength;
-          Compress_getCompressedData(&archiveEntryInfo->file.deltaCompressInfo,
-                                     archiveEntryInfo->file.deltaBuffer,
-                                     archiveEntryInfo->file.deltaBufferSize,
-                                     &deltaLength
-                                    );
-          if (deltaLength > 0)
-          {
-            // byte-compress data
-            error = Compress_deflate(&archiveEntryInfo->file.byteCompressInfo,
-                                     archiveEntryInfo->file.deltaBuffer,
-                                     deltaLength,
-                                     NULL
-                                    );
-            if (error != ERROR_NONE)
-            {
-              String_delete(intermediateFileName);
-              Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-              return error;
-            }
-          }
-          else
-          {
-            eofDelta = TRUE;
-          }
-        }
-        while (!eofDelta);
+  // create file entry chunk
+  archiveEntryInfo->solid.chunkFileEntry.size            = archiveSolidMemberNode->fileInfo.size;
+  archiveEntryInfo->solid.chunkFileEntry.timeLastAccess  = archiveSolidMemberNode->fileInfo.timeLastAccess;
+  archiveEntryInfo->solid.chunkFileEntry.timeModified    = archiveSolidMemberNode->fileInfo.timeModified;
+  archiveEntryInfo->solid.chunkFileEntry.timeLastChanged = archiveSolidMemberNode->fileInfo.timeLastChanged;
+  archiveEntryInfo->solid.chunkFileEntry.userId          = archiveSolidMemberNode->fileInfo.userId;
+  archiveEntryInfo->solid.chunkFileEntry.groupId         = archiveSolidMemberNode->fileInfo.groupId;
+  archiveEntryInfo->solid.chunkFileEntry.permissions     = archiveSolidMemberNode->fileInfo.permissions;
+  convertSystemToUTF8Encoding(archiveEntryInfo->solid.chunkFileEntry.name,archiveSolidMemberNode->name);
+  error = Chunk_create(&archiveEntryInfo->solid.chunkFileEntry.info);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+  error = Chunk_close(&archiveEntryInfo->solid.chunkFileEntry.info);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
 
-        // flush byte compress
-        error = Compress_flush(&archiveEntryInfo->file.byteCompressInfo);
-        if (error != ERROR_NONE)
-        {
-          String_delete(intermediateFileName);
-          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-          return error;
-        }
-        error = flushFileDataBlocks(archiveEntryInfo,COMPRESS_BLOCK_TYPE_ANY);
-        if (error != ERROR_NONE)
-        {
-          String_delete(intermediateFileName);
-          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-          return error;
-        }
+  // create extended attribute chunks
+  const FileExtendedAttributeNode *fileExtendedAttributeNode;
+  LIST_ITERATE(&archiveSolidMemberNode->fileExtendedAttributeList,fileExtendedAttributeNode)
+  {
+    String_set(archiveEntryInfo->solid.chunkFileExtendedAttribute.name,fileExtendedAttributeNode->name);
+    archiveEntryInfo->solid.chunkFileExtendedAttribute.value.data   = fileExtendedAttributeNode->data;
+    archiveEntryInfo->solid.chunkFileExtendedAttribute.value.length = fileExtendedAttributeNode->dataLength;
 
-        // update fragment size
-        archiveEntryInfo->file.chunkFileData.fragmentSize = Compress_getInputLength(&archiveEntryInfo->file.deltaCompressInfo);
-        error = Chunk_update(&archiveEntryInfo->file.chunkFileData.info);
-        if (error != ERROR_NONE)
-        {
-          String_delete(intermediateFileName);
-          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-          return error;
-        }
+    error = Chunk_create(&archiveEntryInfo->solid.chunkFileExtendedAttribute.info);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    error = Chunk_close(&archiveEntryInfo->solid.chunkFileExtendedAttribute.info);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+  }
 
-        // close chunks
-        error = Chunk_close(&archiveEntryInfo->file.chunkFileData.info);
-        if (error != ERROR_NONE)
-        {
-          String_delete(intermediateFileName);
-          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-          return error;
-        }
-        error = Chunk_close(&archiveEntryInfo->file.chunkFileEntry.info);
-        if (error != ERROR_NONE)
-        {
-          String_delete(intermediateFileName);
-          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-          return error;
-        }
-        error = Chunk_close(&archiveEntryInfo->file.chunkFile.info);
-        if (error != ERROR_NONE)
-        {
-          String_delete(intermediateFileName);
-          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-          return error;
-        }
+  // create file solid chunk
+  assert(archiveEntryInfo->solid.chunkFile.info.offset > archiveEntryInfo->solid.chunkSolid.info.offset);
+  archiveEntryInfo->solid.chunkFileSolid.blockOffset = archiveEntryInfo->solid.chunkFile.info.offset-archiveEntryInfo->solid.chunkSolid.info.offset;
+  archiveEntryInfo->solid.chunkFileSolid.offset      = archiveSolidMemberNode->offset;
+  archiveEntryInfo->solid.chunkFileSolid.size        = archiveSolidMemberNode->size;
+  error = Chunk_create(&archiveEntryInfo->solid.chunkFileSolid.info);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+  error = Chunk_close(&archiveEntryInfo->solid.chunkFileSolid.info);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
 
-        // reset header "written"
-        archiveEntryInfo->file.headerWrittenFlag = FALSE;
+  // close file chunk
+  error = Chunk_close(&archiveEntryInfo->solid.chunkFile.info);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
 
-        // create archive file (if not already created)
-        error = createArchiveFile(archiveEntryInfo->archiveHandle);
-        if (error != ERROR_NONE)
-        {
-          String_delete(intermediateFileName);
-          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-          return error;
-        }
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : closeSolidData
+* Purpose: close data of current solid block
+* Input  : archiveHandle - archive handle
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
 
-        // transfer intermediate data into archive
-        error = transferToArchive(archiveEntryInfo->archiveHandle,
-                                  &archiveEntryInfo->file.intermediateFileHandle
-                                 );
-        if (error != ERROR_NONE)
-        {
-          String_delete(intermediateFileName);
-          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-          return error;
-        }
+LOCAL void closeSolidData(ArchiveHandle *archiveHandle)
+{
+  assert(archiveHandle != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_READ);
 
-        // add to index database
-        if (Index_isAvailable())
-        {
-          // add file entry
-          error = indexAddFile(archiveEntryInfo->archiveHandle,
-                               archiveEntryInfo->file.chunkFileEntry.name,
-                               archiveEntryInfo->file.chunkFileEntry.size,
-                               archiveEntryInfo->file.chunkFileEntry.timeLastAccess,
-                               archiveEntryInfo->file.chunkFileEntry.timeModified,
-                               archiveEntryInfo->file.chunkFileEntry.timeLastChanged,
-                               archiveEntryInfo->file.chunkFileEntry.userId,
-                               archiveEntryInfo->file.chunkFileEntry.groupId,
-                               archiveEntryInfo->file.chunkFileEntry.permissions,
-                               archiveEntryInfo->file.chunkFileData.fragmentOffset,
-                               archiveEntryInfo->file.chunkFileData.fragmentSize
-                              );
-          if (error != ERROR_NONE)
-          {
-            String_delete(intermediateFileName);
-            Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-            return error;
-          }
-        }
+  if (archiveHandle->read.solid.openFlag)
+  {
+    free(archiveHandle->read.solid.byteBuffer);
+    Compress_done(&archiveHandle->read.solid.byteCompressInfo);
+    Chunk_done(&archiveHandle->read.solid.chunkSolidData.info);
+    Chunk_done(&archiveHandle->read.solid.chunkSolid.info);
+    Crypt_done(&archiveHandle->read.solid.chunkSolidData.cryptInfo);
+    Crypt_done(&archiveHandle->read.solid.cryptInfo);
 
-        // close archive
-        IndexId storageId;
-        int     partNumber;
-        uint64  archiveSize;
-        error = closeArchiveFile(archiveEntryInfo->archiveHandle,
-                                 &storageId,
-                                 intermediateFileName,
-                                 &partNumber,
-                                 &archiveSize
-                                );
-        if (error != ERROR_NONE)
-        {
-          String_delete(intermediateFileName);
-          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
-          return error;
-        }
+    archiveHandle->read.solid.openFlag = FALSE;
+  }
+}
 
-        // update fragment offset for next fragment, reset size
-        archiveEntryInfo->file.chunkFileData.fragmentOffset += archiveEntryInfo->file.chunkFileData.fragmentSize;
-        archiveEntryInfo->file.chunkFileData.fragmentSize   =  0LL;
+/***********************************************************************\
+* Name   : openSolidData
+* Purpose: open data of solid block of a file entry
+* Input  : archiveEntryInfo - archive file entry info data
+*          archiveHandle    - archive handle
+*          decryptKey       - decrypt key or NULL
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : chunkFileSolid must be read; the data of the current solid
+*          block is kept open and reused if the data of the file entry
+*          is not before the current read position in the block, thus
+*          members of a solid block are decompressed only once when
+*          read in archive order
+\***********************************************************************/
 
-        // set new delta base-offset
-        if (archiveEntryInfo->file.deltaSourceHandleInitFlag)
-        {
-          assert(Compress_isDeltaCompressed(archiveEntryInfo->file.deltaCompressAlgorithm));
-          DeltaSource_setBaseOffset(&archiveEntryInfo->file.deltaSourceHandle,
-                                    archiveEntryInfo->file.chunkFileData.fragmentSize
-                                   );
-        }
+LOCAL Errors openSolidData(ArchiveEntryInfo *archiveEntryInfo,
+                           ArchiveHandle    *archiveHandle,
+                           const CryptKey   *decryptKey
+                          )
+{
+  AutoFreeList autoFreeList;
+  Errors       error;
 
-        /* reset compress, encrypt (do it here because data if buffered and can be
-          processed before a new file is opened)
-        */
-        Compress_reset(&archiveEntryInfo->file.deltaCompressInfo);
-        Compress_reset(&archiveEntryInfo->file.byteCompressInfo);
-        Crypt_reset(&archiveEntryInfo->file.cryptInfo);
+  assert(archiveEntryInfo != NULL);
+  assert(archiveHandle != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_READ);
+  assert(archiveHandle->chunkIO != NULL);
+  assert(archiveHandle->chunkIO->seek != NULL);
 
-        // find next suitable archive part
-        findNextArchivePart(archiveEntryInfo->archiveHandle);
+  // check offset of solid block
+  if (archiveEntryInfo->file.chunkFileSolid.blockOffset > archiveEntryInfo->file.chunkFile.info.offset)
+  {
+    return ERROR_INVALID_CHUNK_SIZE;
+  }
+  uint64 offset = archiveEntryInfo->file.chunkFile.info.offset-archiveEntryInfo->file.chunkFileSolid.blockOffset;
 
-        // unlock
-        Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+  // check if current solid block data can be used
+  if (   archiveHandle->read.solid.openFlag
+      && (archiveHandle->read.solid.offset == offset)
+      && (archiveHandle->read.solid.dataOffset <= archiveEntryInfo->file.chunkFileSolid.offset)
+     )
+  {
+    return ERROR_NONE;
+  }
 
-// TODO: activate when removed IndexStorage_updateInfos() from commands_create.c
-#if 0
-        // update index aggregates
-        if (archiveHandle->indexHandle != NULL)
-        {
-        error = IndexStorage_updateInfos(archiveEntryInfo->archiveHandle->indexHandle,
-                                         storageId
-                                        );
-        if (error != ERROR_NONE)
-        {
-          String_delete(intermediateFileName);
-          return error;
-        }
-        }
-#endif
+  // init variables
+  closeSolidData(archiveHandle);
+  AutoFree_init(&autoFreeList);
 
-        // store archive file
-        error = storeArchiveFile(archiveEntryInfo->archiveHandle,storageId,intermediateFileName,partNumber,archiveSize);
-        if (error != ERROR_NONE)
-        {
-          (void)File_delete(intermediateFileName,FALSE);
-          String_delete(intermediateFileName);
-          return error;
-        }
+  archiveHandle->read.solid.byteBufferSize = FLOOR(MAX_BUFFER_SIZE,archiveEntryInfo->blockLength);
+  archiveHandle->read.solid.byteBuffer     = (byte*)malloc(archiveHandle->read.solid.byteBufferSize);
+  if (archiveHandle->read.solid.byteBuffer == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  AUTOFREE_ADD(&autoFreeList,archiveHandle->read.solid.byteBuffer,{ free(archiveHandle->read.solid.byteBuffer); });
 
-        // free resources
-        String_delete(intermediateFileName);
-      }
-      else
-      {
-        // unlock
-        Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+  // init crypt
+  error = Crypt_init(&archiveHandle->read.solid.cryptInfo,
+                     archiveEntryInfo->cryptAlgorithms[0],
+                     archiveHandle->archiveCryptInfo->cryptMode|CRYPT_MODE_CBC_,
+                     &archiveHandle->archiveCryptInfo->cryptSalt,
+                     decryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveHandle->read.solid.cryptInfo,{ Crypt_done(&archiveHandle->read.solid.cryptInfo); });
+  error = Crypt_init(&archiveHandle->read.solid.chunkSolidData.cryptInfo,
+                     archiveEntryInfo->cryptAlgorithms[0],
+                     archiveHandle->archiveCryptInfo->cryptMode|CRYPT_MODE_CBC_,
+                     &archiveHandle->archiveCryptInfo->cryptSalt,
+                     decryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveHandle->read.solid.chunkSolidData.cryptInfo,{ Crypt_done(&archiveHandle->read.solid.chunkSolidData.cryptInfo); });
 
-        // write file header (if not already written)
-        if (!archiveEntryInfo->file.headerWrittenFlag)
-        {
-          error = writeFileChunks(archiveEntryInfo);
-          if (error != ERROR_NONE)
-          {
-            return error;
-          }
-        }
+  // init chunks
+  error = Chunk_init(&archiveHandle->read.solid.chunkSolid.info,
+                     NULL,  // parentChunkInfo
+                     archiveHandle->chunkIO,
+                     archiveHandle->chunkIOUserData,
+                     CHUNK_ID_SOLID,
+                     CHUNK_DEFINITION_SOLID,
+                     DEFAULT_ALIGNMENT,
+                     NULL,  // cryptInfo
+                     &archiveHandle->read.solid.chunkSolid
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveHandle->read.solid.chunkSolid.info,{ Chunk_done(&archiveHandle->read.solid.chunkSolid.info); });
+  error = Chunk_init(&archiveHandle->read.solid.chunkSolidData.info,
+                     &archiveHandle->read.solid.chunkSolid.info,
+                     CHUNK_USE_PARENT,
+                     CHUNK_USE_PARENT,
+                     CHUNK_ID_FILE_DATA,
+                     CHUNK_DEFINITION_FILE_DATA,
+                     archiveEntryInfo->blockLength,
+                     &archiveHandle->read.solid.chunkSolidData.cryptInfo,
+                     &archiveHandle->read.solid.chunkSolidData
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  Chunk_setDataCrypt(&archiveHandle->read.solid.chunkSolidData.info,&archiveHandle->read.solid.cryptInfo);
+  AUTOFREE_ADD(&autoFreeList,&archiveHandle->read.solid.chunkSolidData.info,{ Chunk_done(&archiveHandle->read.solid.chunkSolidData.info); });
 
-        // encrypt block
-//fprintf(stderr,"%s, %d: cryptBytes=%d\n",__FILE__,__LINE__,byteLength); debugDumpMemory(archiveEntryInfo->file.byteBuffer,byteLength,FALSE);
-        error = Crypt_encryptBytes(&archiveEntryInfo->file.cryptInfo,
-                                   archiveEntryInfo->file.byteBuffer,
-                                   byteLength
-                                  );
-        if (error != ERROR_NONE)
-        {
-          return error;
-        }
+  // read solid block chunk
+  error = archiveHandle->chunkIO->seek(archiveHandle->chunkIOUserData,offset);
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  ChunkHeader chunkHeader;
+  error = Chunk_next(archiveHandle->chunkIO,archiveHandle->chunkIOUserData,&chunkHeader);
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  if (chunkHeader.id != CHUNK_ID_SOLID)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return ERRORX_(NO_FILE_DATA,0,"%s",String_cString(archiveEntryInfo->file.chunkFileEntry.name));
+  }
+  error = Chunk_open(&archiveHandle->read.solid.chunkSolid.info,
+                     &chunkHeader,
+                     CHUNK_FIXED_SIZE_SOLID,
+                     archiveHandle
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
 
-        #ifdef DEBUG_ENCODED_DATA_FILENAME
-          {
-            int handle = open64(DEBUG_ENCODED_DATA_FILENAME,O_CREAT|O_WRONLY|O_APPEND|O_LARGEFILE,0664);
-            write(handle,archiveEntryInfo->file.byteBuffer,byteLength);
-            close(handle);
-          }
-        #endif /* DEBUG_ENCODED_DATA_FILENAME */
+  // read solid data chunk (only header)
+  ChunkHeader subChunkHeader;
+  error = Chunk_nextSub(&archiveHandle->read.solid.chunkSolid.info,&subChunkHeader);
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  if (subChunkHeader.id != CHUNK_ID_FILE_DATA)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return ERRORX_(NO_FILE_DATA,0,"%s",String_cString(archiveEntryInfo->file.chunkFileEntry.name));
+  }
+  error = Chunk_open(&archiveHandle->read.solid.chunkSolidData.info,
+                     &subChunkHeader,
+                     CHUNK_FIXED_SIZE_FILE_DATA,
+                     archiveHandle
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
 
-        // write data block
-        error = Chunk_writeData(&archiveEntryInfo->file.chunkFileData.info,
-                                archiveEntryInfo->file.byteBuffer,
-                                byteLength
-                               );
-        if (error != ERROR_NONE)
-        {
-          return error;
-        }
-      }
-    }
+  // init byte decompress
+  error = Compress_init(&archiveHandle->read.solid.byteCompressInfo,
+                        COMPRESS_MODE_INFLATE,
+                        archiveEntryInfo->file.byteCompressAlgorithm,
+                        archiveEntryInfo->blockLength,
+                        0,  // length (unknown)
+                        NULL  // deltaSourceHandle
+                       );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
   }
-  while (blockCount > 0);
+
+  archiveHandle->read.solid.openFlag   = TRUE;
+  archiveHandle->read.solid.offset     = offset;
+  archiveHandle->read.solid.dataOffset = 0LL;
+
+  // free resources
+  AutoFree_done(&autoFreeList);
 
   return ERROR_NONE;
 }
 
 /***********************************************************************\
-* Name   : readFileDataBlock
-* Purpose: read file data block, decrypt
-* Input  : archiveEntryInfo - archive file entry info data
+* Name   : readSolidDataBlock
+* Purpose: read data block of current solid block, decrypt
+* Input  : archiveHandle - archive handle
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors readFileDataBlock(ArchiveEntryInfo *archiveEntryInfo)
+LOCAL Errors readSolidDataBlock(ArchiveHandle *archiveHandle)
 {
   Errors error;
 
-  assert(archiveEntryInfo != NULL);
-  assert(archiveEntryInfo->file.byteCompressInfo.blockLength != 0);
+  assert(archiveHandle != NULL);
+  assert(archiveHandle->read.solid.openFlag);
+  assert(archiveHandle->read.solid.byteCompressInfo.blockLength != 0);
 
-  if      (!Chunk_eofSub(&archiveEntryInfo->file.chunkFileData.info))
+  if      (!Chunk_eofSub(&archiveHandle->read.solid.chunkSolidData.info))
   {
     // get max. bytes to read (always multiple of block length)
-    ulong maxBytes = FLOOR(MIN(Compress_getFreeCompressSpace(&archiveEntryInfo->file.byteCompressInfo),
-                               archiveEntryInfo->file.byteBufferSize
+    ulong maxBytes = FLOOR(MIN(Compress_getFreeCompressSpace(&archiveHandle->read.solid.byteCompressInfo),
+                               archiveHandle->read.solid.byteBufferSize
                               ),
-                           archiveEntryInfo->file.byteCompressInfo.blockLength
+                           archiveHandle->read.solid.byteCompressInfo.blockLength
                           );
-    assert((maxBytes%archiveEntryInfo->file.byteCompressInfo.blockLength) == 0);
+    assert((maxBytes%archiveHandle->read.solid.byteCompressInfo.blockLength) == 0);
 
     // read data from archive
     ulong bytesRead;
-    error = Chunk_readData(&archiveEntryInfo->file.chunkFileData.info,
-                           archiveEntryInfo->file.byteBuffer,
+    error = Chunk_readData(&archiveHandle->read.solid.chunkSolidData.info,
+                           archiveHandle->read.solid.byteBuffer,
                            maxBytes,
                            &bytesRead
                           );
@@ -4059,32 +6320,31 @@ LOCAL Errors readFileDataBlock(ArchiveEntryInfo *archiveEntryInfo)
     {
       return ERROR_READ_FILE;
     }
-    if ((bytesRead % archiveEntryInfo->file.byteCompressInfo.blockLength) != 0)
+    if ((bytesRead % archiveHandle->read.solid.byteCompressInfo.blockLength) != 0)
     {
       return ERROR_INCOMPLETE_ARCHIVE;
     }
 
     // decrypt data
-    error = Crypt_decryptBytes(&archiveEntryInfo->file.cryptInfo,
-                               archiveEntryInfo->file.byteBuffer,
+    error = Crypt_decryptBytes(&archiveHandle->read.solid.cryptInfo,
+                               archiveHandle->read.solid.byteBuffer,
                                bytesRead
                               );
     if (error != ERROR_NONE)
     {
       return error;
     }
-//fprintf(stderr,"%s, %d: decryptBytes=%d\n",__FILE__,__LINE__,bytesRead); debugDumpMemory(archiveEntryInfo->file.byteBuffer,bytesRead,FALSE);
 
     // put decrypted data into decompressor
-    Compress_putCompressedData(&archiveEntryInfo->file.byteCompressInfo,
-                               archiveEntryInfo->file.byteBuffer,
+    Compress_putCompressedData(&archiveHandle->read.solid.byteCompressInfo,
+                               archiveHandle->read.solid.byteBuffer,
                                bytesRead
                               );
   }
-  else if (!Compress_isFlush(&archiveEntryInfo->file.byteCompressInfo))
+  else if (!Compress_isFlush(&archiveHandle->read.solid.byteCompressInfo))
   {
     // no more data in archive -> flush byte-compress
-    error = Compress_flush(&archiveEntryInfo->file.byteCompressInfo);
+    error = Compress_flush(&archiveHandle->read.solid.byteCompressInfo);
     if (error != ERROR_NONE)
     {
       return error;
@@ -4094,7 +6354,7 @@ LOCAL Errors readFileDataBlock(ArchiveEntryInfo *archiveEntryInfo)
   {
     // check for end-of-compressed byte-data
     ulong n;
-    error = Compress_getAvailableDecompressedBytes(&archiveEntryInfo->file.byteCompressInfo,
+    error = Compress_getAvailableDecompressedBytes(&archiveHandle->read.solid.byteCompressInfo,
                                                    &n
                                                   );
     if (error != ERROR_NONE)
@@ -4110,6 +6370,146 @@ LOCAL Errors readFileDataBlock(ArchiveEntryInfo *archiveEntryInfo)
   return ERROR_NONE;
 }
 
+/***********************************************************************\
+* Name   : readSolidData
+* Purpose: read data of current solid block: decrypt+decompress
+* Input  : archiveHandle - archive handle
+*          buffer        - buffer for data
+*          length        - length of data to read [bytes]
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : the archive position is restored before reading, thus
+*          other chunks can be read between calls; only one member of
+*          a solid block can be read at the same time
+\***********************************************************************/
+
+LOCAL Errors readSolidData(ArchiveHandle *archiveHandle,
+                           void          *buffer,
+                           ulong         length
+                          )
+{
+  Errors error;
+
+  assert(archiveHandle != NULL);
+  assert(archiveHandle->read.solid.openFlag);
+  assert(buffer != NULL);
+
+  // seek to next data in solid block
+  error = Chunk_seek(&archiveHandle->read.solid.chunkSolidData.info,
+                     archiveHandle->read.solid.chunkSolidData.info.index
+                    );
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  // read data: decrypt+decompress
+  byte *p = (byte*)buffer;
+  while (length > 0L)
+  {
+    // check if byte-decompressor is empty
+    ulong availableBytes;
+    error = Compress_getAvailableDecompressedBytes(&archiveHandle->read.solid.byteCompressInfo,
+                                                   &availableBytes
+                                                  );
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    while (   (availableBytes <= 0L)
+           && !Compress_isEndOfData(&archiveHandle->read.solid.byteCompressInfo)
+          )
+    {
+      // no data in byte-decompressor -> read block, decrpyt and fill byte-decompressor
+      error = readSolidDataBlock(archiveHandle);
+      if (error != ERROR_NONE)
+      {
+        return error;
+      }
+      error = Compress_getAvailableDecompressedBytes(&archiveHandle->read.solid.byteCompressInfo,
+                                                     &availableBytes
+                                                    );
+      if (error != ERROR_NONE)
+      {
+        return error;
+      }
+    }
+    if (availableBytes <= 0L)
+    {
+      // no more data in solid block -> end of data
+      return ERROR_END_OF_DATA;
+    }
+
+    // decompress next byte-data into buffer
+    ulong inflatedBytes;
+    error = Compress_inflate(&archiveHandle->read.solid.byteCompressInfo,
+                             p,
+                             length,
+                             &inflatedBytes
+                            );
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    if (inflatedBytes <= 0L)
+    {
+      // no data decompressed -> error in inflate
+      return ERRORX_(INFLATE,0,"not data");
+    }
+    p      += inflatedBytes;
+    length -= inflatedBytes;
+    archiveHandle->read.solid.dataOffset += (uint64)inflatedBytes;
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : skipSolidData
+* Purpose: skip data of current solid block up to data of file entry
+* Input  : archiveEntryInfo - archive file entry info data
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : data in solid block is compressed/encrypted as a single
+*          stream; skip means decrypt and decompress data between the
+*          current position and the data of the file entry
+\***********************************************************************/
+
+LOCAL Errors skipSolidData(ArchiveEntryInfo *archiveEntryInfo)
+{
+  Errors error;
+
+  assert(archiveEntryInfo != NULL);
+  assert(archiveEntryInfo->file.solidFlag);
+  assert(archiveEntryInfo->archiveHandle->read.solid.openFlag);
+  assert(archiveEntryInfo->archiveHandle->read.solid.dataOffset <= archiveEntryInfo->file.chunkFileSolid.offset);
+
+  ArchiveHandle *archiveHandle = archiveEntryInfo->archiveHandle;
+  if (archiveHandle->read.solid.dataOffset >= archiveEntryInfo->file.chunkFileSolid.offset)
+  {
+    return ERROR_NONE;
+  }
+
+  void *buffer = malloc(MAX_BUFFER_SIZE);
+  if (buffer == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+
+  error = ERROR_NONE;
+  uint64 size = archiveEntryInfo->file.chunkFileSolid.offset-archiveHandle->read.solid.dataOffset;
+  while ((size > 0LL) && (error == ERROR_NONE))
+  {
+    ulong n = (ulong)MIN(size,MAX_BUFFER_SIZE);
+    error = readSolidData(archiveHandle,buffer,n);
+    size -= (uint64)n;
+  }
+
+  free(buffer);
+
+  return error;
+}
+
 /***********************************************************************\
 * Name   : fileSystemTypeToConstant
 * Purpose: convert file system type to chunk constant
@@ -4429,11 +6829,15 @@ LOCAL Errors writeImageDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
       // calculate min. bytes to tramsfer to archive
       ulong minBytes = (ulong)File_getSize(&archiveEntryInfo->image.intermediateFileHandle)+byteLength;
 
-      // lock
-      Semaphore_lock(&archiveEntryInfo->archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER);
+      // lock (only needed for split, otherwise data is written into the intermediate file of the entry)
+      bool lockedFlag = allowNewPartFlag && isSplittedArchive(archiveEntryInfo->archiveHandle);
+      if (lockedFlag)
+      {
+        Semaphore_lock(&archiveEntryInfo->archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER);
+      }
 
       // check if split is allowed and necessary
-      bool newPartFlag =    allowNewPartFlag
+      bool newPartFlag =    lockedFlag
                          && isNewPartNeeded(archiveEntryInfo->archiveHandle,
                                             (!archiveEntryInfo->image.headerWrittenFlag ? archiveEntryInfo->image.headerLength : 0) + minBytes
                                            );
@@ -4605,8 +7009,10 @@ LOCAL Errors writeImageDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
         }
 
         // transfer intermediate data into archive
+        uint64 offset;
         error = transferToArchive(archiveEntryInfo->archiveHandle,
-                                  &archiveEntryInfo->image.intermediateFileHandle
+                                  &archiveEntryInfo->image.intermediateFileHandle,
+                                  &offset
                                  );
         if (error != ERROR_NONE)
         {
@@ -4615,6 +7021,9 @@ LOCAL Errors writeImageDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
           return error;
         }
 
+        // add to table of contents
+        addTOCEntries(archiveEntryInfo,offset);
+
         // store in index database
         if (Index_isAvailable())
         {
@@ -4625,7 +7034,8 @@ LOCAL Errors writeImageDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
                                 archiveEntryInfo->image.chunkImageEntry.size,
                                 archiveEntryInfo->image.chunkImageEntry.blockSize,
                                 archiveEntryInfo->image.chunkImageData.blockOffset,
-                                archiveEntryInfo->image.chunkImageData.blockCount
+                                archiveEntryInfo->image.chunkImageData.blockCount,
+                                offset
                                );
           if (error != ERROR_NONE)
           {
@@ -4637,11 +7047,13 @@ LOCAL Errors writeImageDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
 
         // close archive
         IndexId storageId;
+        bool    storedFlag;
         int     partNumber;
         uint64  archiveSize;
         error = closeArchiveFile(archiveEntryInfo->archiveHandle,
                                  &storageId,
                                  intermediateFileName,
+                                 &storedFlag,
                                  &partNumber,
                                  &archiveSize
                                 );
@@ -4709,7 +7121,10 @@ LOCAL Errors writeImageDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
       else
       {
         // unlock
-        Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+        if (lockedFlag)
+        {
+          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+        }
 
         // write image header (if not already written)
         if (!archiveEntryInfo->image.headerWrittenFlag)
@@ -4936,6 +7351,28 @@ LOCAL Errors writeHardLinkChunks(ArchiveEntryInfo *archiveEntryInfo)
     }
   }
 
+  // create hole chunks
+  if (archiveEntryInfo->hardLink.fileHoleList != NULL)
+  {
+    const FileHoleNode *fileHoleNode;
+    LIST_ITERATE(archiveEntryInfo->hardLink.fileHoleList,fileHoleNode)
+    {
+      archiveEntryInfo->hardLink.chunkHardLinkHole.offset = fileHoleNode->offset;
+      archiveEntryInfo->hardLink.chunkHardLinkHole.size   = fileHoleNode->size;
+
+      error = Chunk_create(&archiveEntryInfo->hardLink.chunkHardLinkHole.info);
+      if (error != ERROR_NONE)
+      {
+        return error;
+      }
+      error = Chunk_close(&archiveEntryInfo->hardLink.chunkHardLinkHole.info);
+      if (error != ERROR_NONE)
+      {
+        return error;
+      }
+    }
+  }
+
   // create hard link data chunk
   error = Chunk_create(&archiveEntryInfo->hardLink.chunkHardLinkData.info);
   if (error != ERROR_NONE)
@@ -5095,11 +7532,15 @@ LOCAL Errors writeHardLinkDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
       // calculate min. bytes to tramsfer to archive
       ulong minBytes = (ulong)File_getSize(&archiveEntryInfo->hardLink.intermediateFileHandle)+byteLength;
 
-      // lock
-      Semaphore_lock(&archiveEntryInfo->archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER);
+      // lock (only needed for split, otherwise data is written into the intermediate file of the entry)
+      bool lockedFlag = allowNewPartFlag && isSplittedArchive(archiveEntryInfo->archiveHandle);
+      if (lockedFlag)
+      {
+        Semaphore_lock(&archiveEntryInfo->archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER);
+      }
 
       // check if split is allowed and necessary
-      bool newPartFlag =    allowNewPartFlag
+      bool newPartFlag =    lockedFlag
                          && isNewPartNeeded(archiveEntryInfo->archiveHandle,
                                             (!archiveEntryInfo->hardLink.headerWrittenFlag
                                                ? archiveEntryInfo->hardLink.headerLength
@@ -5228,7 +7669,10 @@ LOCAL Errors writeHardLinkDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
         }
 
         // update fragment size
-        archiveEntryInfo->hardLink.chunkHardLinkData.fragmentSize = Compress_getInputLength(&archiveEntryInfo->hardLink.deltaCompressInfo);
+        archiveEntryInfo->hardLink.chunkHardLinkData.fragmentSize = getFragmentSize(archiveEntryInfo->hardLink.fileHoleList,
+                                                                                    archiveEntryInfo->hardLink.chunkHardLinkData.fragmentOffset,
+                                                                                    Compress_getInputLength(&archiveEntryInfo->hardLink.deltaCompressInfo)
+                                                                                   );
         error = Chunk_update(&archiveEntryInfo->hardLink.chunkHardLinkData.info);
         if (error != ERROR_NONE)
         {
@@ -5273,8 +7717,10 @@ LOCAL Errors writeHardLinkDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
         }
 
         // transfer intermediate data into archive
+        uint64 offset;
         error = transferToArchive(archiveEntryInfo->archiveHandle,
-                                  &archiveEntryInfo->hardLink.intermediateFileHandle
+                                  &archiveEntryInfo->hardLink.intermediateFileHandle,
+                                  &offset
                                  );
         if (error != ERROR_NONE)
         {
@@ -5283,6 +7729,9 @@ LOCAL Errors writeHardLinkDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
           return error;
         }
 
+        // add to table of contents
+        addTOCEntries(archiveEntryInfo,offset);
+
         // store in index database
         if (Index_isAvailable())
         {
@@ -5300,7 +7749,8 @@ LOCAL Errors writeHardLinkDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
                                      archiveEntryInfo->hardLink.chunkHardLinkEntry.groupId,
                                      archiveEntryInfo->hardLink.chunkHardLinkEntry.permissions,
                                      archiveEntryInfo->hardLink.chunkHardLinkData.fragmentOffset,
-                                     archiveEntryInfo->hardLink.chunkHardLinkData.fragmentSize
+                                     archiveEntryInfo->hardLink.chunkHardLinkData.fragmentSize,
+                                     offset
                                     );
             if (error != ERROR_NONE) break;
           }
@@ -5314,11 +7764,13 @@ LOCAL Errors writeHardLinkDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
 
         // close archive
         IndexId storageId;
+        bool    storedFlag;
         int     partNumber;
         uint64  archiveSize;
         error = closeArchiveFile(archiveEntryInfo->archiveHandle,
                                  &storageId,
                                  intermediateFileName,
+                                 &storedFlag,
                                  &partNumber,
                                  &archiveSize
                                 );
@@ -5386,7 +7838,10 @@ LOCAL Errors writeHardLinkDataBlocks(ArchiveEntryInfo *archiveEntryInfo,
       else
       {
         // unlock
-        Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+        if (lockedFlag)
+        {
+          Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+        }
 
         // write header (if not already written)
         if (!archiveEntryInfo->hardLink.headerWrittenFlag)
@@ -5966,6 +8421,8 @@ bool Archive_waitDecryptPassword(Password *password, long timeout)
                         void                    *archiveTestUserData,
                         ArchiveStoreFunction    archiveStoreFunction,
                         void                    *archiveStoreUserData,
+                        ArchiveStreamFunction   archiveStreamFunction,
+                        void                    *archiveStreamUserData,
                         GetNamePasswordFunction getNamePasswordFunction,
                         void                    *getNamePasswordUserData,
                         LogHandle               *logHandle
@@ -5998,6 +8455,8 @@ bool Archive_waitDecryptPassword(Password *password, long timeout)
                           void                    *archiveTestUserData,
                           ArchiveStoreFunction    archiveStoreFunction,
                           void                    *archiveStoreUserData,
+                          ArchiveStreamFunction   archiveStreamFunction,
+                          void                    *archiveStreamUserData,
                           GetNamePasswordFunction getNamePasswordFunction,
                           void                    *getNamePasswordUserData,
                           LogHandle               *logHandle
@@ -6047,6 +8506,8 @@ UNUSED_VARIABLE(storageInfo);
   archiveHandle->archiveTestUserData     = archiveTestUserData;
   archiveHandle->archiveStoreFunction    = archiveStoreFunction;
   archiveHandle->archiveStoreUserData    = archiveStoreUserData;
+  archiveHandle->archiveStreamFunction   = archiveStreamFunction;
+  archiveHandle->archiveStreamUserData   = archiveStreamUserData;
   archiveHandle->getNamePasswordFunction = getNamePasswordFunction;
   archiveHandle->getNamePasswordUserData = getNamePasswordUserData;
   archiveHandle->logHandle               = logHandle;
@@ -6073,8 +8534,38 @@ UNUSED_VARIABLE(storageInfo);
   archiveHandle->create.tmpFileName      = String_new();
   AUTOFREE_ADD(&autoFreeList,&archiveHandle->create.tmpFileName,{ String_delete(archiveHandle->create.tmpFileName); });
   archiveHandle->create.openFlag         = FALSE;
-  archiveHandle->chunkIO                 = &CHUNK_IO_FILE;
-  archiveHandle->chunkIOUserData         = &archiveHandle->create.tmpFileHandle;
+  archiveHandle->create.streamFlag       = (archiveStreamFunction != NULL);
+  archiveHandle->create.stream.archiveName = String_new();
+  AUTOFREE_ADD(&autoFreeList,&archiveHandle->create.stream.archiveName,{ String_delete(archiveHandle->create.stream.archiveName); });
+  archiveHandle->create.stream.fileHandle = NULL;
+  archiveHandle->create.stream.buffer    = NULL;
+  archiveHandle->create.stream.bufferSize = 0L;
+  if (   (archiveStreamFunction != NULL)
+      || (   !storageInfo->jobOptions->noSignatureFlag
+          && Configuration_isKeyAvailable(&globalOptions.signaturePrivateKey)
+         )
+     )
+  {
+    // stream archive files directly into storage or write temporary archive files via buffer to calculate signature hash while storing
+    archiveHandle->create.stream.buffer = (byte*)malloc(STREAM_BUFFER_SIZE);
+    if (archiveHandle->create.stream.buffer == NULL)
+    {
+      HALT_INSUFFICIENT_MEMORY();
+    }
+    AUTOFREE_ADD(&autoFreeList,archiveHandle->create.stream.buffer,{ free(archiveHandle->create.stream.buffer); });
+    archiveHandle->create.stream.bufferSize = STREAM_BUFFER_SIZE;
+    archiveHandle->chunkIO                  = &CHUNK_IO_STREAM;
+    archiveHandle->chunkIOUserData          = &archiveHandle->create.stream;
+    if (archiveStreamFunction == NULL)
+    {
+      archiveHandle->create.stream.fileHandle = &archiveHandle->create.tmpFileHandle;
+    }
+  }
+  else
+  {
+    archiveHandle->chunkIO                  = &CHUNK_IO_FILE;
+    archiveHandle->chunkIOUserData          = &archiveHandle->create.tmpFileHandle;
+  }
 
   Semaphore_init(&archiveHandle->indexLock,SEMAPHORE_TYPE_BINARY);
   AUTOFREE_ADD(&autoFreeList,&archiveHandle->indexLock,{ Semaphore_done(&archiveHandle->indexLock); });
@@ -6083,6 +8574,9 @@ UNUSED_VARIABLE(storageInfo);
   AUTOFREE_ADD(&autoFreeList,&archiveHandle->archiveIndexList,{ List_done(&archiveHandle->archiveIndexList); });
   Semaphore_init(&archiveHandle->archiveIndexList.lock,SEMAPHORE_TYPE_BINARY);
   AUTOFREE_ADD(&autoFreeList,&archiveHandle->archiveIndexList.lock,{ Semaphore_done(&archiveHandle->archiveIndexList.lock); });
+  Archive_initTOCList(&archiveHandle->tocList);
+  AUTOFREE_ADD(&autoFreeList,&archiveHandle->tocList,{ Archive_doneTOCList(&archiveHandle->tocList); });
+  archiveHandle->tocOverflowFlag         = FALSE;
 
   archiveHandle->entries                 = 0LL;
   archiveHandle->archiveFileSize         = 0LL;
@@ -6339,8 +8833,42 @@ UNUSED_VARIABLE(storageInfo);
   archiveHandle->printableStorageName    = Storage_getPrintableName(String_new(),&storageInfo->storageSpecifier,archiveName);
   AUTOFREE_ADD(&autoFreeList,archiveHandle->printableStorageName,{ String_delete(archiveHandle->printableStorageName); });
   archiveHandle->read.storageFileName    = NULL;
-  archiveHandle->chunkIO                 = &CHUNK_IO_STORAGE;
-  archiveHandle->chunkIOUserData         = &archiveHandle->read.storageHandle;
+  archiveHandle->read.signatureHashFlag  = FALSE;
+  archiveHandle->read.signatureHashBuffer = NULL;
+  archiveHandle->read.signatureHashThreadFlag = FALSE;
+  archiveHandle->read.solid.openFlag     = FALSE;
+  archiveHandle->chunkIO                 = &CHUNK_IO_READ;
+  archiveHandle->chunkIOUserData         = archiveHandle;
+  if (   !storageInfo->jobOptions->skipVerifySignaturesFlag
+      && Configuration_isKeyAvailable(&globalOptions.signaturePublicKey)
+     )
+  {
+    // init signature hash: signature hash is calculated while reading
+    error = Crypt_initHash(&archiveHandle->read.signatureHash,SIGNATURE_HASH_ALGORITHM);
+    if (error != ERROR_NONE)
+    {
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
+    AUTOFREE_ADD(&autoFreeList,&archiveHandle->read.signatureHash,{ Crypt_doneHash(&archiveHandle->read.signatureHash); });
+    archiveHandle->read.signatureHashBuffer = (byte*)malloc(SIGNATURE_HASH_KEEP_SIZE);
+    if (archiveHandle->read.signatureHashBuffer == NULL)
+    {
+      HALT_INSUFFICIENT_MEMORY();
+    }
+    AUTOFREE_ADD(&autoFreeList,archiveHandle->read.signatureHashBuffer,{ free(archiveHandle->read.signatureHashBuffer); });
+    archiveHandle->read.signatureHashFlag  = TRUE;
+
+    // start signature hash thread: all data is hashed in-order while entries are read
+    if (IS_SET(archiveFlags,ARCHIVE_FLAG_VERIFY_SIGNATURES))
+    {
+      initSignatureHashThread(archiveHandle);
+      AUTOFREE_ADD(&autoFreeList,&archiveHandle->read.signatureHashThread,{ doneSignatureHashThread(archiveHandle); });
+    }
+  }
+  archiveHandle->read.signatureHashStart  = 0LL;
+  archiveHandle->read.signatureHashOffset = 0LL;
+  archiveHandle->read.signatureHashBufferLength = 0L;
 
   Semaphore_init(&archiveHandle->indexLock,SEMAPHORE_TYPE_BINARY);
   AUTOFREE_ADD(&autoFreeList,&archiveHandle->indexLock,{ Semaphore_done(&archiveHandle->indexLock); });
@@ -6349,6 +8877,9 @@ UNUSED_VARIABLE(storageInfo);
   AUTOFREE_ADD(&autoFreeList,&archiveHandle->archiveIndexList,{ List_done(&archiveHandle->archiveIndexList); });
   Semaphore_init(&archiveHandle->archiveIndexList.lock,SEMAPHORE_TYPE_BINARY);
   AUTOFREE_ADD(&autoFreeList,&archiveHandle->archiveIndexList.lock,{ Semaphore_done(&archiveHandle->archiveIndexList.lock); });
+  Archive_initTOCList(&archiveHandle->tocList);
+  AUTOFREE_ADD(&autoFreeList,&archiveHandle->tocList,{ Archive_doneTOCList(&archiveHandle->tocList); });
+  archiveHandle->tocOverflowFlag         = FALSE;
 
   archiveHandle->entries                 = 0LL;
   archiveHandle->archiveFileSize         = 0LL;
@@ -6489,8 +9020,15 @@ UNUSED_VARIABLE(storageInfo);
   archiveHandle->read.storageFileName    = NULL;
   Semaphore_init(&archiveHandle->lock,SEMAPHORE_TYPE_BINARY);
   AUTOFREE_ADD(&autoFreeList,&archiveHandle->lock,{ Semaphore_done(&archiveHandle->lock); });
-  archiveHandle->chunkIO                 = &CHUNK_IO_STORAGE;
-  archiveHandle->chunkIOUserData         = &archiveHandle->read.storageHandle;
+  archiveHandle->read.signatureHashFlag  = FALSE;
+  archiveHandle->read.signatureHashBuffer = NULL;
+  archiveHandle->read.signatureHashThreadFlag = FALSE;
+  archiveHandle->read.solid.openFlag     = FALSE;
+  archiveHandle->read.signatureHashStart  = 0LL;
+  archiveHandle->read.signatureHashOffset = 0LL;
+  archiveHandle->read.signatureHashBufferLength = 0L;
+  archiveHandle->chunkIO                 = &CHUNK_IO_READ;
+  archiveHandle->chunkIOUserData         = archiveHandle;
 
   Semaphore_init(&archiveHandle->indexLock,SEMAPHORE_TYPE_BINARY);
   AUTOFREE_ADD(&autoFreeList,&archiveHandle->indexLock,{ Semaphore_done(&archiveHandle->indexLock); });
@@ -6499,6 +9037,9 @@ UNUSED_VARIABLE(storageInfo);
   AUTOFREE_ADD(&autoFreeList,&archiveHandle->archiveIndexList,{ List_done(&archiveHandle->archiveIndexList); });
   Semaphore_init(&archiveHandle->archiveIndexList.lock,SEMAPHORE_TYPE_BINARY);
   AUTOFREE_ADD(&autoFreeList,&archiveHandle->archiveIndexList.lock,{ Semaphore_done(&archiveHandle->archiveIndexList.lock); });
+  Archive_initTOCList(&archiveHandle->tocList);
+  AUTOFREE_ADD(&autoFreeList,&archiveHandle->tocList,{ Archive_doneTOCList(&archiveHandle->tocList); });
+  archiveHandle->tocOverflowFlag         = FALSE;
 
   archiveHandle->entries                 = 0LL;
   archiveHandle->archiveFileSize         = 0LL;
@@ -6578,11 +9119,13 @@ UNUSED_VARIABLE(storageInfo);
 
           // close archive
           IndexId storageId;
+          bool    storedFlag;
           int     partNumber;
           uint64  archiveSize;
           error = closeArchiveFile(archiveHandle,
                                    &storageId,
                                    intermediateFileName,
+                                   &storedFlag,
                                    &partNumber,
                                    &archiveSize
                                   );
@@ -6602,14 +9145,43 @@ UNUSED_VARIABLE(storageInfo);
                                             );
             if (error != ERROR_NONE)
             {
-              (void)File_delete(intermediateFileName,FALSE);
+              if (storedFlag)
+              {
+                (void)Storage_delete(archiveHandle->storageInfo,archiveHandle->create.stream.archiveName);
+              }
+              else
+              {
+                (void)File_delete(intermediateFileName,FALSE);
+              }
               String_delete(intermediateFileName);
               break;
             }
           }
 
           // store
-          if (!String_isEmpty(intermediateFileName))
+          if (storedFlag)
+          {
+            if (storeFlag)
+            {
+              error = storeArchiveFile(archiveHandle,
+                                       storageId,
+                                       intermediateFileName,
+                                       partNumber,
+                                       archiveSize
+                                      );
+            }
+            if (!storeFlag || (error != ERROR_NONE))
+            {
+              // discard streamed archive file
+              (void)Storage_delete(archiveHandle->storageInfo,archiveHandle->create.stream.archiveName);
+            }
+            if (error != ERROR_NONE)
+            {
+              String_delete(intermediateFileName);
+              break;
+            }
+          }
+          else if (!String_isEmpty(intermediateFileName))
           {
             if (storeFlag)
             {
@@ -6641,6 +9213,20 @@ UNUSED_VARIABLE(storageInfo);
         // close storage
         Storage_close(&archiveHandle->read.storageHandle);
 
+        // free signature hash
+        if (archiveHandle->read.signatureHashFlag)
+        {
+          if (archiveHandle->read.signatureHashThreadFlag)
+          {
+            doneSignatureHashThread(archiveHandle);
+          }
+          free(archiveHandle->read.signatureHashBuffer);
+          Crypt_doneHash(&archiveHandle->read.signatureHash);
+        }
+
+        // close solid block data
+        closeSolidData(archiveHandle);
+
         error = ERROR_NONE;
         break;
       #ifndef NDEBUG
@@ -6666,12 +9252,15 @@ UNUSED_VARIABLE(storageInfo);
  }
 
   // free resources
+  Archive_doneTOCList(&archiveHandle->tocList);
   Semaphore_done(&archiveHandle->archiveIndexList.lock);
   List_done(&archiveHandle->archiveIndexList);
   Semaphore_done(&archiveHandle->indexLock);
   switch (archiveHandle->mode)
   {
     case ARCHIVE_MODE_CREATE:
+      if (archiveHandle->create.stream.buffer != NULL) free(archiveHandle->create.stream.buffer);
+      String_delete(archiveHandle->create.stream.archiveName);
       String_delete(archiveHandle->create.tmpFileName);
       break;
     case ARCHIVE_MODE_READ:
@@ -6973,6 +9562,23 @@ CRYPT_KEY_DERIVE_FUNCTION,//
       case CHUNK_ID_SIGNATURE:
         chunkHeaderFoundFlag = TRUE;
         break;
+      case CHUNK_ID_SOLID:
+        // skip solid block (data is read via file entries)
+        archiveHandle->pendingError = Chunk_skip(archiveHandle->chunkIO,archiveHandle->chunkIOUserData,&chunkHeader);
+        if (archiveHandle->pendingError != ERROR_NONE)
+        {
+          return FALSE;
+        }
+        break;
+      case CHUNK_ID_TOC:
+      case CHUNK_ID_TOC_LOCATOR:
+        // skip table of contents (read via Archive_readTOC())
+        archiveHandle->pendingError = Chunk_skip(archiveHandle->chunkIO,archiveHandle->chunkIOUserData,&chunkHeader);
+        if (archiveHandle->pendingError != ERROR_NONE)
+        {
+          return FALSE;
+        }
+        break;
       default:
         if (IS_SET(archiveHandle->archiveFlags,ARCHIVE_FLAG_SKIP_UNKNOWN_CHUNKS))
         {
@@ -7032,6 +9638,8 @@ CRYPT_KEY_DERIVE_FUNCTION,//
                               ConstString                     fileName,
                               const FileInfo                  *fileInfo,
                               const FileExtendedAttributeList *fileExtendedAttributeList,
+                              const FileHoleList              *fileHoleList,
+                              ConstString                     referenceName,
                               uint64                          fragmentOffset,
                               uint64                          fragmentSize,
                               ArchiveFlags                    archiveFlags
@@ -7049,6 +9657,8 @@ CRYPT_KEY_DERIVE_FUNCTION,//
                                 ConstString                     fileName,
                                 const FileInfo                  *fileInfo,
                                 const FileExtendedAttributeList *fileExtendedAttributeList,
+                                const FileHoleList              *fileHoleList,
+                                ConstString                     referenceName,
                                 uint64                          fragmentOffset,
                                 uint64                          fragmentSize,
                                 ArchiveFlags                    archiveFlags
@@ -7065,6 +9675,7 @@ CRYPT_KEY_DERIVE_FUNCTION,//
   assert(archiveHandle->archiveCryptInfo != NULL);
   assert(archiveHandle->mode == ARCHIVE_MODE_CREATE);
   assert(fileInfo != NULL);
+  assert(String_isEmpty(referenceName) || (fragmentSize == 0LL));
 
   // init variables
   AutoFreeList autoFreeList;
@@ -7086,9 +9697,12 @@ CRYPT_KEY_DERIVE_FUNCTION,//
   archiveEntryInfo->archiveEntryType               = ARCHIVE_ENTRY_TYPE_FILE;
 
   archiveEntryInfo->file.fileExtendedAttributeList = fileExtendedAttributeList;
+  archiveEntryInfo->file.fileHoleList              = fileHoleList;
+  archiveEntryInfo->file.referenceName             = referenceName;
 
   archiveEntryInfo->file.deltaCompressAlgorithm    = (archiveFlags & ARCHIVE_FLAG_TRY_DELTA_COMPRESS) ? deltaCompressAlgorithm : COMPRESS_ALGORITHM_NONE;
   archiveEntryInfo->file.byteCompressAlgorithm     = (archiveFlags & ARCHIVE_FLAG_TRY_BYTE_COMPRESS ) ? byteCompressAlgorithm  : COMPRESS_ALGORITHM_NONE;
+  archiveEntryInfo->file.adaptiveCompressFlag      = ((archiveFlags & ARCHIVE_FLAG_ADAPTIVE_COMPRESS) != 0);
 
   archiveEntryInfo->file.deltaSourceHandleInitFlag = FALSE;
 
@@ -7236,6 +9850,36 @@ CRYPT_KEY_DERIVE_FUNCTION,//
   DEBUG_TESTCODE() { Crypt_done(&archiveEntryInfo->file.chunkFileDelta.cryptInfo); AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
   AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->file.chunkFileDelta.cryptInfo,{ Crypt_done(&archiveEntryInfo->file.chunkFileDelta.cryptInfo); });
 
+  error = Crypt_init(&archiveEntryInfo->file.chunkFileHole.cryptInfo,
+//TODO MULTI_CRYPT
+                     archiveEntryInfo->cryptAlgorithms[0],
+                     CRYPT_MODE_CBC_,
+                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
+                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  DEBUG_TESTCODE() { Crypt_done(&archiveEntryInfo->file.chunkFileHole.cryptInfo); AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->file.chunkFileHole.cryptInfo,{ Crypt_done(&archiveEntryInfo->file.chunkFileHole.cryptInfo); });
+
+  error = Crypt_init(&archiveEntryInfo->file.chunkFileReference.cryptInfo,
+//TODO MULTI_CRYPT
+                     archiveEntryInfo->cryptAlgorithms[0],
+                     CRYPT_MODE_CBC_,
+                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
+                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  DEBUG_TESTCODE() { Crypt_done(&archiveEntryInfo->file.chunkFileReference.cryptInfo); AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->file.chunkFileReference.cryptInfo,{ Crypt_done(&archiveEntryInfo->file.chunkFileReference.cryptInfo); });
+
   error = Crypt_init(&archiveEntryInfo->file.chunkFileData.cryptInfo,
 //TODO MULTI_CRYPT
                      archiveEntryInfo->cryptAlgorithms[0],
@@ -7337,6 +9981,46 @@ CRYPT_KEY_DERIVE_FUNCTION,//
   }
   AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->file.chunkFileDelta.info,{ Chunk_done(&archiveEntryInfo->file.chunkFileDelta.info); });
 
+  error = Chunk_init(&archiveEntryInfo->file.chunkFileHole.info,
+                     &archiveEntryInfo->file.chunkFile.info,
+                     CHUNK_USE_PARENT,
+                     CHUNK_USE_PARENT,
+                     CHUNK_ID_FILE_HOLE,
+                     CHUNK_DEFINITION_FILE_HOLE,
+                     archiveEntryInfo->blockLength,
+                     &archiveEntryInfo->file.chunkFileHole.cryptInfo,
+                     &archiveEntryInfo->file.chunkFileHole
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  DEBUG_TESTCODE() { Chunk_done(&archiveEntryInfo->file.chunkFileHole.info); AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->file.chunkFileHole.info,{ Chunk_done(&archiveEntryInfo->file.chunkFileHole.info); });
+
+  error = Chunk_init(&archiveEntryInfo->file.chunkFileReference.info,
+                     &archiveEntryInfo->file.chunkFile.info,
+                     CHUNK_USE_PARENT,
+                     CHUNK_USE_PARENT,
+                     CHUNK_ID_FILE_REFERENCE,
+                     CHUNK_DEFINITION_FILE_REFERENCE,
+                     archiveEntryInfo->blockLength,
+                     &archiveEntryInfo->file.chunkFileReference.cryptInfo,
+                     &archiveEntryInfo->file.chunkFileReference
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  DEBUG_TESTCODE() { Chunk_done(&archiveEntryInfo->file.chunkFileReference.info); AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
+  if (!String_isEmpty(referenceName))
+  {
+    String_set(archiveEntryInfo->file.chunkFileReference.name,referenceName);
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->file.chunkFileReference.info,{ Chunk_done(&archiveEntryInfo->file.chunkFileReference.info); });
+
   error = Chunk_init(&archiveEntryInfo->file.chunkFileData.info,
                      &archiveEntryInfo->file.chunkFile.info,
                      CHUNK_USE_PARENT,
@@ -7355,6 +10039,7 @@ CRYPT_KEY_DERIVE_FUNCTION,//
   DEBUG_TESTCODE() { Chunk_done(&archiveEntryInfo->file.chunkFileData.info); AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
   archiveEntryInfo->file.chunkFileData.fragmentOffset = fragmentOffset;
   archiveEntryInfo->file.chunkFileData.fragmentSize   = 0LL;
+  Chunk_setDataCrypt(&archiveEntryInfo->file.chunkFileData.info,&archiveEntryInfo->file.cryptInfo);
   AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->file.chunkFileData.info,{ Chunk_done(&archiveEntryInfo->file.chunkFileData.info); });
 
   // init delta compress (if no delta-compression is enabled, use identity-compressor), byte compress
@@ -7416,6 +10101,24 @@ CRYPT_KEY_DERIVE_FUNCTION,//
                                                          0
                                                         );
   }
+  if (archiveEntryInfo->file.fileHoleList != NULL)
+  {
+    const FileHoleNode *fileHoleNode;
+    LIST_ITERATE(archiveEntryInfo->file.fileHoleList,fileHoleNode)
+    {
+      archiveEntryInfo->file.headerLength += Chunk_getSize(&archiveEntryInfo->file.chunkFileHole.info,
+                                                           &archiveEntryInfo->file.chunkFileHole,
+                                                           0
+                                                          );
+    }
+  }
+  if (!String_isEmpty(archiveEntryInfo->file.referenceName))
+  {
+    archiveEntryInfo->file.headerLength += Chunk_getSize(&archiveEntryInfo->file.chunkFileReference.info,
+                                                         &archiveEntryInfo->file.chunkFileReference,
+                                                         0
+                                                        );
+  }
 
   // find next suitable archive part
   findNextArchivePart(archiveHandle);
@@ -7511,6 +10214,7 @@ CRYPT_KEY_DERIVE_FUNCTION,//
 
   archiveEntryInfo->image.deltaCompressAlgorithm    = (archiveFlags & ARCHIVE_FLAG_TRY_DELTA_COMPRESS) ? deltaCompressAlgorithm : COMPRESS_ALGORITHM_NONE;
   archiveEntryInfo->image.byteCompressAlgorithm     = (archiveFlags & ARCHIVE_FLAG_TRY_BYTE_COMPRESS ) ? byteCompressAlgorithm  : COMPRESS_ALGORITHM_NONE;
+  archiveEntryInfo->image.adaptiveCompressFlag      = ((archiveFlags & ARCHIVE_FLAG_ADAPTIVE_COMPRESS) != 0);
 
   archiveEntryInfo->image.headerLength              = 0;
   archiveEntryInfo->image.headerWrittenFlag         = FALSE;
@@ -7738,6 +10442,7 @@ CRYPT_KEY_DERIVE_FUNCTION,//
   DEBUG_TESTCODE() { Crypt_done(&archiveEntryInfo->file.chunkFileData.cryptInfo); AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
   archiveEntryInfo->image.chunkImageData.blockOffset = blockOffset;
   archiveEntryInfo->image.chunkImageData.blockCount  = 0LL;
+  Chunk_setDataCrypt(&archiveEntryInfo->image.chunkImageData.info,&archiveEntryInfo->image.cryptInfo);
   AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->image.chunkImageData.info,{ Chunk_done(&archiveEntryInfo->image.chunkImageData.info); });
 
   // init delta compress (if no delta-compression is enabled, use identity-compressor), byte compress
@@ -7866,17 +10571,271 @@ CRYPT_KEY_DERIVE_FUNCTION,//
 
   archiveEntryInfo->archiveEntryType = ARCHIVE_ENTRY_TYPE_DIRECTORY;
 
-  // init directory entry chunk
-  error = Chunk_init(&archiveEntryInfo->directory.chunkDirectory.info,
+  // init directory entry chunk
+  error = Chunk_init(&archiveEntryInfo->directory.chunkDirectory.info,
+                     NULL,  // parentChunkInfo
+                     archiveHandle->chunkIO,
+                     archiveHandle->chunkIOUserData,
+                     CHUNK_ID_DIRECTORY,
+                     CHUNK_DEFINITION_DIRECTORY,
+//TODO: DEFAULT_ALIGNMENT
+                     0,  // alignment
+                     NULL,  // cryptInfo
+                     &archiveEntryInfo->directory.chunkDirectory
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+#ifdef MULTI_CRYPT
+  archiveEntryInfo->directory.chunkDirectory.cryptAlgorithms[0] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
+  archiveEntryInfo->directory.chunkDirectory.cryptAlgorithms[1] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[1]);
+  archiveEntryInfo->directory.chunkDirectory.cryptAlgorithms[2] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[2]);
+  archiveEntryInfo->directory.chunkDirectory.cryptAlgorithms[3] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[3]);
+#else
+  archiveEntryInfo->directory.chunkDirectory.cryptAlgorithm = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
+#endif
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->directory.chunkDirectory.info,{ Chunk_done(&archiveEntryInfo->directory.chunkDirectory.info); });
+
+  // init crypt
+  error = Crypt_init(&archiveEntryInfo->directory.chunkDirectoryEntry.cryptInfo,
+//TODO: multi crypt
+                     archiveEntryInfo->cryptAlgorithms[0],
+                     CRYPT_MODE_CBC_,
+                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
+                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->directory.chunkDirectoryEntry.cryptInfo,{ Crypt_done(&archiveEntryInfo->directory.chunkDirectoryEntry.cryptInfo); });
+
+  error = Crypt_init(&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.cryptInfo,
+//TODO: multi crypt
+                     archiveEntryInfo->cryptAlgorithms[0],
+                     CRYPT_MODE_CBC_,
+                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
+                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.cryptInfo,{ Crypt_done(&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.cryptInfo); });
+
+  // init sub-chunks
+  error = Chunk_init(&archiveEntryInfo->directory.chunkDirectoryEntry.info,
+                     &archiveEntryInfo->directory.chunkDirectory.info,
+                     CHUNK_USE_PARENT,
+                     CHUNK_USE_PARENT,
+                     CHUNK_ID_DIRECTORY_ENTRY,
+                     CHUNK_DEFINITION_DIRECTORY_ENTRY,
+                     MAX(archiveEntryInfo->blockLength,DEFAULT_ALIGNMENT),
+                     &archiveEntryInfo->directory.chunkDirectoryEntry.cryptInfo,
+                     &archiveEntryInfo->directory.chunkDirectoryEntry
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  archiveEntryInfo->directory.chunkDirectoryEntry.timeLastAccess  = fileInfo->timeLastAccess;
+  archiveEntryInfo->directory.chunkDirectoryEntry.timeModified    = fileInfo->timeModified;
+  archiveEntryInfo->directory.chunkDirectoryEntry.timeLastChanged = fileInfo->timeLastChanged;
+  archiveEntryInfo->directory.chunkDirectoryEntry.userId          = fileInfo->userId;
+  archiveEntryInfo->directory.chunkDirectoryEntry.groupId         = fileInfo->groupId;
+  archiveEntryInfo->directory.chunkDirectoryEntry.permissions     = fileInfo->permissions;
+  String utf8DirectoryName = convertSystemToUTF8Encoding(String_new(),directoryName);
+  String_set(archiveEntryInfo->directory.chunkDirectoryEntry.name,utf8DirectoryName);
+  String_delete(utf8DirectoryName);
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->directory.chunkDirectoryEntry.info,{ Chunk_done(&archiveEntryInfo->directory.chunkDirectoryEntry.info); });
+
+  error = Chunk_init(&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.info,
+                     &archiveEntryInfo->directory.chunkDirectory.info,
+                     CHUNK_USE_PARENT,
+                     CHUNK_USE_PARENT,
+                     CHUNK_ID_DIRECTORY_EXTENDED_ATTRIBUTE,
+                     CHUNK_DEFINITION_DIRECTORY_EXTENDED_ATTRIBUTE,
+                     MAX(archiveEntryInfo->blockLength,DEFAULT_ALIGNMENT),
+                     &archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.cryptInfo,
+                     &archiveEntryInfo->directory.chunkDirectoryExtendedAttribute
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.info,{ Chunk_done(&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.info); });
+
+  // calculate header size
+  ulong headerLength = Chunk_getSize(&archiveEntryInfo->directory.chunkDirectory.info,     &archiveEntryInfo->directory.chunkDirectory,     0)+
+                       Chunk_getSize(&archiveEntryInfo->directory.chunkDirectoryEntry.info,&archiveEntryInfo->directory.chunkDirectoryEntry,0);
+  const FileExtendedAttributeNode *fileExtendedAttributeNode;
+  LIST_ITERATE(fileExtendedAttributeList,fileExtendedAttributeNode)
+  {
+    String_set(archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.name,fileExtendedAttributeNode->name);
+
+    headerLength += Chunk_getSize(&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.info,
+                                  &archiveEntryInfo->directory.chunkDirectoryExtendedAttribute,
+                                  fileExtendedAttributeNode->dataLength
+                                 );
+  }
+
+  // find next suitable archive part
+  findNextArchivePart(archiveHandle);
+
+  if (!archiveHandle->dryRun)
+  {
+    // lock archive (Note: directory entries are created direct without intermediate file)
+    Semaphore_forceLock(&archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE);
+
+    // ensure space in archive
+    error = ensureArchiveSpace(archiveHandle,
+                               headerLength
+                              );
+    if (error != ERROR_NONE)
+    {
+      Semaphore_unlock(&archiveHandle->lock);
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
+
+    // create new archive file (if not already created)
+    error = createArchiveFile(archiveHandle);
+    if (error != ERROR_NONE)
+    {
+      Semaphore_unlock(&archiveHandle->lock);
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
+
+    // write directory chunk
+    error = Chunk_create(&archiveEntryInfo->directory.chunkDirectory.info);
+    if (error != ERROR_NONE)
+    {
+      Semaphore_unlock(&archiveHandle->lock);
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
+
+    // write directory entry chunk
+    error = Chunk_create(&archiveEntryInfo->directory.chunkDirectoryEntry.info);
+    if (error != ERROR_NONE)
+    {
+      Semaphore_unlock(&archiveHandle->lock);
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
+
+    // write extended attribute chunks
+    LIST_ITERATE(fileExtendedAttributeList,fileExtendedAttributeNode)
+    {
+      String_set(archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.name,fileExtendedAttributeNode->name);
+      archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.value.data   = fileExtendedAttributeNode->data;
+      archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.value.length = fileExtendedAttributeNode->dataLength;
+
+      error = Chunk_create(&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.info);
+      if (error != ERROR_NONE)
+      {
+        break;
+      }
+      error = Chunk_close(&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.info);
+      if (error != ERROR_NONE)
+      {
+        break;
+      }
+    }
+    if (error != ERROR_NONE)
+    {
+      Semaphore_unlock(&archiveHandle->lock);
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
+  }
+
+  // done resources
+  AutoFree_done(&autoFreeList);
+
+  #ifdef NDEBUG
+    DEBUG_ADD_RESOURCE_TRACE(archiveEntryInfo,ArchiveEntryInfo);
+  #else /* not NDEBUG */
+    DEBUG_ADD_RESOURCE_TRACEX(__fileName__,__lineNb__,archiveEntryInfo,ArchiveEntryInfo);
+  #endif /* NDEBUG */
+
+  return ERROR_NONE;
+}
+
+#ifdef NDEBUG
+  Errors Archive_newLinkEntry(ArchiveEntryInfo                *archiveEntryInfo,
+                              ArchiveHandle                   *archiveHandle,
+                              CryptAlgorithms                 cryptAlgorithm,
+                              const CryptSalt                 *cryptSalt,
+                              const CryptKey                  *cryptKey,
+                              ConstString                     linkName,
+                              ConstString                     destinationName,
+                              const FileInfo                  *fileInfo,
+                              const FileExtendedAttributeList *fileExtendedAttributeList
+                             )
+#else /* not NDEBUG */
+  Errors __Archive_newLinkEntry(const char                      *__fileName__,
+                                ulong                           __lineNb__,
+                                ArchiveEntryInfo                *archiveEntryInfo,
+                                ArchiveHandle                   *archiveHandle,
+                                CryptAlgorithms                 cryptAlgorithm,
+                                const CryptSalt                 *cryptSalt,
+                                const CryptKey                  *cryptKey,
+                                ConstString                     linkName,
+                                ConstString                     destinationName,
+                                const FileInfo                  *fileInfo,
+                                const FileExtendedAttributeList *fileExtendedAttributeList
+                               )
+#endif /* NDEBUG */
+{
+  Errors error;
+
+  assert(archiveEntryInfo != NULL);
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+  assert(archiveHandle->storageInfo != NULL);
+  assert(archiveHandle->storageInfo->jobOptions != NULL);
+  assert(archiveHandle->archiveCryptInfo != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_CREATE);
+  assert(fileInfo != NULL);
+
+  // init variables
+  AutoFreeList autoFreeList;
+  AutoFree_init(&autoFreeList);
+
+  // init archive entry info
+  archiveEntryInfo->archiveHandle    = archiveHandle;
+
+#ifdef MULTI_CRYPT
+  memCopyFast(&archiveEntryInfo->cryptAlgorithms,4*CryptAlgorithms),cryptAlgorithms,4*sizeof(CryptAlgorithms));
+#else
+  archiveEntryInfo->cryptAlgorithms[0] = cryptAlgorithm;
+  archiveEntryInfo->cryptAlgorithms[1] = CRYPT_ALGORITHM_NONE;
+  archiveEntryInfo->cryptAlgorithms[2] = CRYPT_ALGORITHM_NONE;
+  archiveEntryInfo->cryptAlgorithms[3] = CRYPT_ALGORITHM_NONE;
+#endif
+  archiveEntryInfo->blockLength      = Crypt_getBlockLength(cryptAlgorithm);
+
+  archiveEntryInfo->archiveEntryType = ARCHIVE_ENTRY_TYPE_LINK;
+
+  // init link chunk
+  error = Chunk_init(&archiveEntryInfo->link.chunkLink.info,
                      NULL,  // parentChunkInfo
                      archiveHandle->chunkIO,
                      archiveHandle->chunkIOUserData,
-                     CHUNK_ID_DIRECTORY,
-                     CHUNK_DEFINITION_DIRECTORY,
+                     CHUNK_ID_LINK,
+                     CHUNK_DEFINITION_LINK,
 //TODO: DEFAULT_ALIGNMENT
                      0,  // alignment
                      NULL,  // cryptInfo
-                     &archiveEntryInfo->directory.chunkDirectory
+                     &archiveEntryInfo->link.chunkLink
                     );
   if (error != ERROR_NONE)
   {
@@ -7884,17 +10843,17 @@ CRYPT_KEY_DERIVE_FUNCTION,//
     return error;
   }
 #ifdef MULTI_CRYPT
-  archiveEntryInfo->directory.chunkDirectory.cryptAlgorithms[0] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
-  archiveEntryInfo->directory.chunkDirectory.cryptAlgorithms[1] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[1]);
-  archiveEntryInfo->directory.chunkDirectory.cryptAlgorithms[2] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[2]);
-  archiveEntryInfo->directory.chunkDirectory.cryptAlgorithms[3] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[3]);
+  archiveEntryInfo->link.chunkLink.cryptAlgorithms[0] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
+  archiveEntryInfo->link.chunkLink.cryptAlgorithms[1] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[1]);
+  archiveEntryInfo->link.chunkLink.cryptAlgorithms[2] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[2]);
+  archiveEntryInfo->link.chunkLink.cryptAlgorithms[3] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[3]);
 #else
-  archiveEntryInfo->directory.chunkDirectory.cryptAlgorithm = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
+  archiveEntryInfo->link.chunkLink.cryptAlgorithm = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
 #endif
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->directory.chunkDirectory.info,{ Chunk_done(&archiveEntryInfo->directory.chunkDirectory.info); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->link.chunkLink.info,{ Chunk_done(&archiveEntryInfo->link.chunkLink.info); });
 
   // init crypt
-  error = Crypt_init(&archiveEntryInfo->directory.chunkDirectoryEntry.cryptInfo,
+  error = Crypt_init(&archiveEntryInfo->link.chunkLinkEntry.cryptInfo,
 //TODO: multi crypt
                      archiveEntryInfo->cryptAlgorithms[0],
                      CRYPT_MODE_CBC_,
@@ -7906,9 +10865,9 @@ CRYPT_KEY_DERIVE_FUNCTION,//
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->directory.chunkDirectoryEntry.cryptInfo,{ Crypt_done(&archiveEntryInfo->directory.chunkDirectoryEntry.cryptInfo); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->link.chunkLinkEntry.cryptInfo,{ Crypt_done(&archiveEntryInfo->link.chunkLinkEntry.cryptInfo); });
 
-  error = Crypt_init(&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.cryptInfo,
+  error = Crypt_init(&archiveEntryInfo->link.chunkLinkExtendedAttribute.cryptInfo,
 //TODO: multi crypt
                      archiveEntryInfo->cryptAlgorithms[0],
                      CRYPT_MODE_CBC_,
@@ -7920,72 +10879,69 @@ CRYPT_KEY_DERIVE_FUNCTION,//
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.cryptInfo,{ Crypt_done(&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.cryptInfo); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->link.chunkLinkExtendedAttribute.cryptInfo,{ Crypt_done(&archiveEntryInfo->link.chunkLinkExtendedAttribute.cryptInfo); });
 
   // init sub-chunks
-  error = Chunk_init(&archiveEntryInfo->directory.chunkDirectoryEntry.info,
-                     &archiveEntryInfo->directory.chunkDirectory.info,
+  error = Chunk_init(&archiveEntryInfo->link.chunkLinkEntry.info,
+                     &archiveEntryInfo->link.chunkLink.info,
                      CHUNK_USE_PARENT,
                      CHUNK_USE_PARENT,
-                     CHUNK_ID_DIRECTORY_ENTRY,
-                     CHUNK_DEFINITION_DIRECTORY_ENTRY,
-                     MAX(archiveEntryInfo->blockLength,DEFAULT_ALIGNMENT),
-                     &archiveEntryInfo->directory.chunkDirectoryEntry.cryptInfo,
-                     &archiveEntryInfo->directory.chunkDirectoryEntry
+                     CHUNK_ID_LINK_ENTRY,
+                     CHUNK_DEFINITION_LINK_ENTRY,
+                     archiveEntryInfo->blockLength,
+                     &archiveEntryInfo->link.chunkLinkEntry.cryptInfo,
+                     &archiveEntryInfo->link.chunkLinkEntry
                     );
   if (error != ERROR_NONE)
   {
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  archiveEntryInfo->directory.chunkDirectoryEntry.timeLastAccess  = fileInfo->timeLastAccess;
-  archiveEntryInfo->directory.chunkDirectoryEntry.timeModified    = fileInfo->timeModified;
-  archiveEntryInfo->directory.chunkDirectoryEntry.timeLastChanged = fileInfo->timeLastChanged;
-  archiveEntryInfo->directory.chunkDirectoryEntry.userId          = fileInfo->userId;
-  archiveEntryInfo->directory.chunkDirectoryEntry.groupId         = fileInfo->groupId;
-  archiveEntryInfo->directory.chunkDirectoryEntry.permissions     = fileInfo->permissions;
-  String utf8DirectoryName = convertSystemToUTF8Encoding(String_new(),directoryName);
-  String_set(archiveEntryInfo->directory.chunkDirectoryEntry.name,utf8DirectoryName);
-  String_delete(utf8DirectoryName);
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->directory.chunkDirectoryEntry.info,{ Chunk_done(&archiveEntryInfo->directory.chunkDirectoryEntry.info); });
+  archiveEntryInfo->link.chunkLinkEntry.timeLastAccess  = fileInfo->timeLastAccess;
+  archiveEntryInfo->link.chunkLinkEntry.timeModified    = fileInfo->timeModified;
+  archiveEntryInfo->link.chunkLinkEntry.timeLastChanged = fileInfo->timeLastChanged;
+  archiveEntryInfo->link.chunkLinkEntry.userId          = fileInfo->userId;
+  archiveEntryInfo->link.chunkLinkEntry.groupId         = fileInfo->groupId;
+  archiveEntryInfo->link.chunkLinkEntry.permissions     = fileInfo->permissions;
+  convertSystemToUTF8Encoding(archiveEntryInfo->link.chunkLinkEntry.name,linkName);
+  convertSystemToUTF8Encoding(archiveEntryInfo->link.chunkLinkEntry.destinationName,destinationName);
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->link.chunkLinkEntry.info,{ Chunk_done(&archiveEntryInfo->link.chunkLinkEntry.info); });
 
-  error = Chunk_init(&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.info,
-                     &archiveEntryInfo->directory.chunkDirectory.info,
+  error = Chunk_init(&archiveEntryInfo->link.chunkLinkExtendedAttribute.info,
+                     &archiveEntryInfo->link.chunkLink.info,
                      CHUNK_USE_PARENT,
                      CHUNK_USE_PARENT,
-                     CHUNK_ID_DIRECTORY_EXTENDED_ATTRIBUTE,
-                     CHUNK_DEFINITION_DIRECTORY_EXTENDED_ATTRIBUTE,
-                     MAX(archiveEntryInfo->blockLength,DEFAULT_ALIGNMENT),
-                     &archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.cryptInfo,
-                     &archiveEntryInfo->directory.chunkDirectoryExtendedAttribute
+                     CHUNK_ID_LINK_EXTENDED_ATTRIBUTE,
+                     CHUNK_DEFINITION_LINK_EXTENDED_ATTRIBUTE,
+                     archiveEntryInfo->blockLength,
+                     &archiveEntryInfo->link.chunkLinkExtendedAttribute.cryptInfo,
+                     &archiveEntryInfo->link.chunkLinkExtendedAttribute
                     );
   if (error != ERROR_NONE)
   {
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.info,{ Chunk_done(&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.info); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->link.chunkLinkExtendedAttribute.info,{ Chunk_done(&archiveEntryInfo->link.chunkLinkExtendedAttribute.info); });
 
-  // calculate header size
-  ulong headerLength = Chunk_getSize(&archiveEntryInfo->directory.chunkDirectory.info,     &archiveEntryInfo->directory.chunkDirectory,     0)+
-                       Chunk_getSize(&archiveEntryInfo->directory.chunkDirectoryEntry.info,&archiveEntryInfo->directory.chunkDirectoryEntry,0);
+  // calculate header length
+  ulong headerLength = Chunk_getSize(&archiveEntryInfo->link.chunkLink.info,     &archiveEntryInfo->link.chunkLink,     0)+
+                       Chunk_getSize(&archiveEntryInfo->link.chunkLinkEntry.info,&archiveEntryInfo->link.chunkLinkEntry,0);
   const FileExtendedAttributeNode *fileExtendedAttributeNode;
   LIST_ITERATE(fileExtendedAttributeList,fileExtendedAttributeNode)
   {
-    String_set(archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.name,fileExtendedAttributeNode->name);
+    String_set(archiveEntryInfo->link.chunkLinkExtendedAttribute.name,fileExtendedAttributeNode->name);
 
-    headerLength += Chunk_getSize(&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.info,
-                                  &archiveEntryInfo->directory.chunkDirectoryExtendedAttribute,
+    headerLength += Chunk_getSize(&archiveEntryInfo->link.chunkLinkExtendedAttribute.info,
+                                  &archiveEntryInfo->link.chunkLinkExtendedAttribute,
                                   fileExtendedAttributeNode->dataLength
                                  );
   }
 
-  // find next suitable archive part
-  findNextArchivePart(archiveHandle);
 
   if (!archiveHandle->dryRun)
   {
-    // lock archive (Note: directory entries are created direct without intermediate file)
+    // lock archive (Note: link entries are created direct without intermediate file)
     Semaphore_forceLock(&archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE);
 
     // ensure space in archive
@@ -8008,8 +10964,8 @@ CRYPT_KEY_DERIVE_FUNCTION,//
       return error;
     }
 
-    // write directory chunk
-    error = Chunk_create(&archiveEntryInfo->directory.chunkDirectory.info);
+    // write link chunk
+    error = Chunk_create(&archiveEntryInfo->link.chunkLink.info);
     if (error != ERROR_NONE)
     {
       Semaphore_unlock(&archiveHandle->lock);
@@ -8017,8 +10973,8 @@ CRYPT_KEY_DERIVE_FUNCTION,//
       return error;
     }
 
-    // write directory entry chunk
-    error = Chunk_create(&archiveEntryInfo->directory.chunkDirectoryEntry.info);
+    // write link entry chunk
+    error = Chunk_create(&archiveEntryInfo->link.chunkLinkEntry.info);
     if (error != ERROR_NONE)
     {
       Semaphore_unlock(&archiveHandle->lock);
@@ -8029,16 +10985,16 @@ CRYPT_KEY_DERIVE_FUNCTION,//
     // write extended attribute chunks
     LIST_ITERATE(fileExtendedAttributeList,fileExtendedAttributeNode)
     {
-      String_set(archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.name,fileExtendedAttributeNode->name);
-      archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.value.data   = fileExtendedAttributeNode->data;
-      archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.value.length = fileExtendedAttributeNode->dataLength;
+      String_set(archiveEntryInfo->link.chunkLinkExtendedAttribute.name,fileExtendedAttributeNode->name);
+      archiveEntryInfo->link.chunkLinkExtendedAttribute.value.data   = fileExtendedAttributeNode->data;
+      archiveEntryInfo->link.chunkLinkExtendedAttribute.value.length = fileExtendedAttributeNode->dataLength;
 
-      error = Chunk_create(&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.info);
+      error = Chunk_create(&archiveEntryInfo->link.chunkLinkExtendedAttribute.info);
       if (error != ERROR_NONE)
       {
         break;
       }
-      error = Chunk_close(&archiveEntryInfo->directory.chunkDirectoryExtendedAttribute.info);
+      error = Chunk_close(&archiveEntryInfo->link.chunkLinkExtendedAttribute.info);
       if (error != ERROR_NONE)
       {
         break;
@@ -8065,29 +11021,39 @@ CRYPT_KEY_DERIVE_FUNCTION,//
 }
 
 #ifdef NDEBUG
-  Errors Archive_newLinkEntry(ArchiveEntryInfo                *archiveEntryInfo,
-                              ArchiveHandle                   *archiveHandle,
-                              CryptAlgorithms                 cryptAlgorithm,
-                              const CryptSalt                 *cryptSalt,
-                              const CryptKey                  *cryptKey,
-                              ConstString                     linkName,
-                              ConstString                     destinationName,
-                              const FileInfo                  *fileInfo,
-                              const FileExtendedAttributeList *fileExtendedAttributeList
-                             )
+  Errors Archive_newHardLinkEntry(ArchiveEntryInfo                *archiveEntryInfo,
+                                  ArchiveHandle                   *archiveHandle,
+                                  CompressAlgorithms              deltaCompressAlgorithm,
+                                  CompressAlgorithms              byteCompressAlgorithm,
+                                  CryptAlgorithms                 cryptAlgorithm,
+                                  const CryptSalt                 *cryptSalt,
+                                  const CryptKey                  *cryptKey,
+                                  const StringList                *fileNameList,
+                                  const FileInfo                  *fileInfo,
+                                  const FileExtendedAttributeList *fileExtendedAttributeList,
+                                  const FileHoleList              *fileHoleList,
+                                  uint64                          fragmentOffset,
+                                  uint64                          fragmentSize,
+                                  ArchiveFlags                    archiveFlags
+                                 )
 #else /* not NDEBUG */
-  Errors __Archive_newLinkEntry(const char                      *__fileName__,
-                                ulong                           __lineNb__,
-                                ArchiveEntryInfo                *archiveEntryInfo,
-                                ArchiveHandle                   *archiveHandle,
-                                CryptAlgorithms                 cryptAlgorithm,
-                                const CryptSalt                 *cryptSalt,
-                                const CryptKey                  *cryptKey,
-                                ConstString                     linkName,
-                                ConstString                     destinationName,
-                                const FileInfo                  *fileInfo,
-                                const FileExtendedAttributeList *fileExtendedAttributeList
-                               )
+  Errors __Archive_newHardLinkEntry(const char                      *__fileName__,
+                                    ulong                           __lineNb__,
+                                    ArchiveEntryInfo                *archiveEntryInfo,
+                                    ArchiveHandle                   *archiveHandle,
+                                    CompressAlgorithms              deltaCompressAlgorithm,
+                                    CompressAlgorithms              byteCompressAlgorithm,
+                                    CryptAlgorithms                 cryptAlgorithm,
+                                    const CryptSalt                 *cryptSalt,
+                                    const CryptKey                  *cryptKey,
+                                    const StringList                *fileNameList,
+                                    const FileInfo                  *fileInfo,
+                                    const FileExtendedAttributeList *fileExtendedAttributeList,
+                                    const FileHoleList              *fileHoleList,
+                                    uint64                          fragmentOffset,
+                                    uint64                          fragmentSize,
+                                    ArchiveFlags                    archiveFlags
+                                   )
 #endif /* NDEBUG */
 {
   Errors error;
@@ -8099,6 +11065,7 @@ CRYPT_KEY_DERIVE_FUNCTION,//
   assert(archiveHandle->storageInfo->jobOptions != NULL);
   assert(archiveHandle->archiveCryptInfo != NULL);
   assert(archiveHandle->mode == ARCHIVE_MODE_CREATE);
+  assert(!StringList_isEmpty(fileNameList));
   assert(fileInfo != NULL);
 
   // init variables
@@ -8106,49 +11073,135 @@ CRYPT_KEY_DERIVE_FUNCTION,//
   AutoFree_init(&autoFreeList);
 
   // init archive entry info
-  archiveEntryInfo->archiveHandle    = archiveHandle;
+  archiveEntryInfo->archiveHandle                      = archiveHandle;
 
 #ifdef MULTI_CRYPT
-  memCopyFast(&archiveEntryInfo->cryptAlgorithms,4*CryptAlgorithms),cryptAlgorithms,4*sizeof(CryptAlgorithms));
+  memCopyFast(&archiveEntryInfo->cryptAlgorithms,4*sizeof(CryptAlgorithms),cryptAlgorithms,4*sizeof(CryptAlgorithms));
 #else
   archiveEntryInfo->cryptAlgorithms[0] = cryptAlgorithm;
   archiveEntryInfo->cryptAlgorithms[1] = CRYPT_ALGORITHM_NONE;
   archiveEntryInfo->cryptAlgorithms[2] = CRYPT_ALGORITHM_NONE;
   archiveEntryInfo->cryptAlgorithms[3] = CRYPT_ALGORITHM_NONE;
 #endif
-  archiveEntryInfo->blockLength      = Crypt_getBlockLength(cryptAlgorithm);
+  archiveEntryInfo->blockLength                        = Crypt_getBlockLength(cryptAlgorithm);
 
-  archiveEntryInfo->archiveEntryType = ARCHIVE_ENTRY_TYPE_LINK;
+  archiveEntryInfo->archiveEntryType                   = ARCHIVE_ENTRY_TYPE_HARDLINK;
+
+  archiveEntryInfo->hardLink.fileNameList              = fileNameList;
+  archiveEntryInfo->hardLink.fileExtendedAttributeList = fileExtendedAttributeList;
+  archiveEntryInfo->hardLink.fileHoleList              = fileHoleList;
+
+  archiveEntryInfo->hardLink.deltaCompressAlgorithm    = (archiveFlags & ARCHIVE_FLAG_TRY_DELTA_COMPRESS) ? deltaCompressAlgorithm : COMPRESS_ALGORITHM_NONE;
+  archiveEntryInfo->hardLink.byteCompressAlgorithm     = (archiveFlags & ARCHIVE_FLAG_TRY_BYTE_COMPRESS ) ? byteCompressAlgorithm  : COMPRESS_ALGORITHM_NONE;
+  archiveEntryInfo->hardLink.adaptiveCompressFlag      = ((archiveFlags & ARCHIVE_FLAG_ADAPTIVE_COMPRESS) != 0);
+
+  archiveEntryInfo->hardLink.deltaSourceHandleInitFlag = FALSE;
+
+  archiveEntryInfo->hardLink.headerLength              = 0;
+  archiveEntryInfo->hardLink.headerWrittenFlag         = FALSE;
+
+  archiveEntryInfo->hardLink.byteBuffer                = NULL;
+  archiveEntryInfo->hardLink.byteBufferSize            = 0L;
+  archiveEntryInfo->hardLink.deltaBuffer               = NULL;
+  archiveEntryInfo->hardLink.deltaBufferSize           = 0L;
+
+  // get intermediate output file
+  error = File_getTmpFile(&archiveEntryInfo->hardLink.intermediateFileHandle,NULL,tmpDirectory);
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  DEBUG_TESTCODE() { (void)File_close(&archiveEntryInfo->hardLink.intermediateFileHandle); AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.intermediateFileHandle,{ (void)File_close(&archiveEntryInfo->hardLink.intermediateFileHandle); });
+
+  // allocate buffers
+  archiveEntryInfo->hardLink.byteBufferSize = FLOOR(MAX_BUFFER_SIZE,archiveEntryInfo->blockLength);
+  archiveEntryInfo->hardLink.byteBuffer = (byte*)malloc(archiveEntryInfo->hardLink.byteBufferSize);
+  if (archiveEntryInfo->hardLink.byteBuffer == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.byteBuffer,{ free(archiveEntryInfo->hardLink.byteBuffer); });
+  archiveEntryInfo->hardLink.deltaBufferSize = MAX_BUFFER_SIZE;
+  archiveEntryInfo->hardLink.deltaBuffer = (byte*)malloc(archiveEntryInfo->hardLink.deltaBufferSize);
+  if (archiveEntryInfo->hardLink.deltaBuffer == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.deltaBuffer,{ free(archiveEntryInfo->hardLink.deltaBuffer); });
+
+  // get source for delta-compression
+  if ((archiveFlags & ARCHIVE_FLAG_TRY_DELTA_COMPRESS) && Compress_isCompressed(deltaCompressAlgorithm))
+  {
+    error = ERROR_NONE;
+    ConstString fileName;
+    STRINGLIST_ITERATE(fileNameList,fileName)
+    {
+      error = DeltaSource_openEntry(&archiveEntryInfo->hardLink.deltaSourceHandle,
+                                    archiveHandle->deltaSourceList,
+                                    NULL, // storageName
+                                    fileName,
+                                    SOURCE_SIZE_UNKNOWN,
+                                    archiveHandle->storageInfo->jobOptions
+                                   );
+      if (error == ERROR_NONE) break;
+    }
+    if      (error == ERROR_NONE)
+    {
+      // delta compress
+      archiveEntryInfo->hardLink.deltaSourceHandleInitFlag = TRUE;
+      AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.deltaSourceHandle,{ DeltaSource_closeEntry(&archiveEntryInfo->hardLink.deltaSourceHandle); });
+    }
+    else if (archiveHandle->storageInfo->jobOptions->forceDeltaCompressionFlag)
+    {
+      // no delta source -> error
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
+    else
+    {
+      // no delta source -> print warning and disable delta compress
+      printWarning(_("file '%s' not delta compressed (no source file found)"),String_cString(StringList_first(fileNameList,NULL)));
+      logMessage(archiveHandle->logHandle,
+                 LOG_TYPE_WARNING,
+                 "File '%s' not delta compressed (no source file found)",
+                 String_cString(StringList_first(fileNameList,NULL))
+                );
+      archiveEntryInfo->hardLink.deltaCompressAlgorithm = COMPRESS_ALGORITHM_NONE;
+    }
+  }
 
-  // init link chunk
-  error = Chunk_init(&archiveEntryInfo->link.chunkLink.info,
+  // init hard link chunk
+  error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLink.info,
                      NULL,  // parentChunkInfo
-                     archiveHandle->chunkIO,
-                     archiveHandle->chunkIOUserData,
-                     CHUNK_ID_LINK,
-                     CHUNK_DEFINITION_LINK,
+                     &CHUNK_IO_FILE,
+                     &archiveEntryInfo->hardLink.intermediateFileHandle,
+                     CHUNK_ID_HARDLINK,
+                     CHUNK_DEFINITION_HARDLINK,
 //TODO: DEFAULT_ALIGNMENT
                      0,  // alignment
                      NULL,  // cryptInfo
-                     &archiveEntryInfo->link.chunkLink
+                     &archiveEntryInfo->hardLink.chunkHardLink
                     );
   if (error != ERROR_NONE)
   {
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
+  archiveEntryInfo->hardLink.chunkHardLink.compressAlgorithm  = COMPRESS_ALGORITHM_TO_CONSTANT(archiveEntryInfo->hardLink.byteCompressAlgorithm);
 #ifdef MULTI_CRYPT
-  archiveEntryInfo->link.chunkLink.cryptAlgorithms[0] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
-  archiveEntryInfo->link.chunkLink.cryptAlgorithms[1] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[1]);
-  archiveEntryInfo->link.chunkLink.cryptAlgorithms[2] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[2]);
-  archiveEntryInfo->link.chunkLink.cryptAlgorithms[3] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[3]);
+  archiveEntryInfo->hardLink.chunkHardLink.cryptAlgorithms[0] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
+  archiveEntryInfo->hardLink.chunkHardLink.cryptAlgorithms[1] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[1]);
+  archiveEntryInfo->hardLink.chunkHardLink.cryptAlgorithms[2] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[2]);
+  archiveEntryInfo->hardLink.chunkHardLink.cryptAlgorithms[3] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[3]);
 #else
-  archiveEntryInfo->link.chunkLink.cryptAlgorithm = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
+  archiveEntryInfo->hardLink.chunkHardLink.cryptAlgorithm = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
 #endif
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->link.chunkLink.info,{ Chunk_done(&archiveEntryInfo->link.chunkLink.info); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLink.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLink.info); });
 
   // init crypt
-  error = Crypt_init(&archiveEntryInfo->link.chunkLinkEntry.cryptInfo,
+  error = Crypt_init(&archiveEntryInfo->hardLink.chunkHardLinkEntry.cryptInfo,
 //TODO: multi crypt
                      archiveEntryInfo->cryptAlgorithms[0],
                      CRYPT_MODE_CBC_,
@@ -8160,9 +11213,9 @@ CRYPT_KEY_DERIVE_FUNCTION,//
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->link.chunkLinkEntry.cryptInfo,{ Crypt_done(&archiveEntryInfo->link.chunkLinkEntry.cryptInfo); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkEntry.cryptInfo,{ Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkEntry.cryptInfo); });
 
-  error = Crypt_init(&archiveEntryInfo->link.chunkLinkExtendedAttribute.cryptInfo,
+  error = Crypt_init(&archiveEntryInfo->hardLink.chunkHardLinkName.cryptInfo,
 //TODO: multi crypt
                      archiveEntryInfo->cryptAlgorithms[0],
                      CRYPT_MODE_CBC_,
@@ -8174,138 +11227,294 @@ CRYPT_KEY_DERIVE_FUNCTION,//
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->link.chunkLinkExtendedAttribute.cryptInfo,{ Crypt_done(&archiveEntryInfo->link.chunkLinkExtendedAttribute.cryptInfo); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkName.cryptInfo,{ Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkName.cryptInfo); });
+
+  error = Crypt_init(&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.cryptInfo,
+//TODO: multi crypt
+                     archiveEntryInfo->cryptAlgorithms[0],
+                     CRYPT_MODE_CBC_,
+                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
+                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.cryptInfo,{ Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.cryptInfo); });
+
+  error = Crypt_init(&archiveEntryInfo->hardLink.chunkHardLinkDelta.cryptInfo,
+//TODO: multi crypt
+                     archiveEntryInfo->cryptAlgorithms[0],
+                     CRYPT_MODE_CBC_,
+                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
+                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkDelta.cryptInfo,{ Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkDelta.cryptInfo); });
+
+  error = Crypt_init(&archiveEntryInfo->hardLink.chunkHardLinkHole.cryptInfo,
+//TODO: multi crypt
+                     archiveEntryInfo->cryptAlgorithms[0],
+                     CRYPT_MODE_CBC_,
+                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
+                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkHole.cryptInfo,{ Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkHole.cryptInfo); });
+
+  error = Crypt_init(&archiveEntryInfo->hardLink.chunkHardLinkData.cryptInfo,
+//TODO: multi crypt
+                     archiveEntryInfo->cryptAlgorithms[0],
+                     CRYPT_MODE_CBC_,
+                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
+                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkData.cryptInfo,{ Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkData.cryptInfo); });
+
+  error = Crypt_init(&archiveEntryInfo->hardLink.cryptInfo,
+//TODO: multi crypt
+                     archiveEntryInfo->cryptAlgorithms[0],
+                     CRYPT_MODE_CBC_,
+                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
+                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.cryptInfo,{ Crypt_done(&archiveEntryInfo->hardLink.cryptInfo); });
 
   // init sub-chunks
-  error = Chunk_init(&archiveEntryInfo->link.chunkLinkEntry.info,
-                     &archiveEntryInfo->link.chunkLink.info,
+  error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLinkEntry.info,
+                     &archiveEntryInfo->hardLink.chunkHardLink.info,
                      CHUNK_USE_PARENT,
                      CHUNK_USE_PARENT,
-                     CHUNK_ID_LINK_ENTRY,
-                     CHUNK_DEFINITION_LINK_ENTRY,
+                     CHUNK_ID_HARDLINK_ENTRY,
+                     CHUNK_DEFINITION_HARDLINK_ENTRY,
                      archiveEntryInfo->blockLength,
-                     &archiveEntryInfo->link.chunkLinkEntry.cryptInfo,
-                     &archiveEntryInfo->link.chunkLinkEntry
+                     &archiveEntryInfo->hardLink.chunkHardLinkEntry.cryptInfo,
+                     &archiveEntryInfo->hardLink.chunkHardLinkEntry
                     );
   if (error != ERROR_NONE)
   {
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  archiveEntryInfo->link.chunkLinkEntry.timeLastAccess  = fileInfo->timeLastAccess;
-  archiveEntryInfo->link.chunkLinkEntry.timeModified    = fileInfo->timeModified;
-  archiveEntryInfo->link.chunkLinkEntry.timeLastChanged = fileInfo->timeLastChanged;
-  archiveEntryInfo->link.chunkLinkEntry.userId          = fileInfo->userId;
-  archiveEntryInfo->link.chunkLinkEntry.groupId         = fileInfo->groupId;
-  archiveEntryInfo->link.chunkLinkEntry.permissions     = fileInfo->permissions;
-  convertSystemToUTF8Encoding(archiveEntryInfo->link.chunkLinkEntry.name,linkName);
-  convertSystemToUTF8Encoding(archiveEntryInfo->link.chunkLinkEntry.destinationName,destinationName);
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->link.chunkLinkEntry.info,{ Chunk_done(&archiveEntryInfo->link.chunkLinkEntry.info); });
+  archiveEntryInfo->hardLink.chunkHardLinkEntry.size            = fileInfo->size;
+  archiveEntryInfo->hardLink.chunkHardLinkEntry.timeLastAccess  = fileInfo->timeLastAccess;
+  archiveEntryInfo->hardLink.chunkHardLinkEntry.timeModified    = fileInfo->timeModified;
+  archiveEntryInfo->hardLink.chunkHardLinkEntry.timeLastChanged = fileInfo->timeLastChanged;
+  archiveEntryInfo->hardLink.chunkHardLinkEntry.userId          = fileInfo->userId;
+  archiveEntryInfo->hardLink.chunkHardLinkEntry.groupId         = fileInfo->groupId;
+  archiveEntryInfo->hardLink.chunkHardLinkEntry.permissions     = fileInfo->permissions;
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkEntry.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkEntry.info); });
 
-  error = Chunk_init(&archiveEntryInfo->link.chunkLinkExtendedAttribute.info,
-                     &archiveEntryInfo->link.chunkLink.info,
+  error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLinkName.info,
+                     &archiveEntryInfo->hardLink.chunkHardLink.info,
                      CHUNK_USE_PARENT,
                      CHUNK_USE_PARENT,
-                     CHUNK_ID_LINK_EXTENDED_ATTRIBUTE,
-                     CHUNK_DEFINITION_LINK_EXTENDED_ATTRIBUTE,
+                     CHUNK_ID_HARDLINK_NAME,
+                     CHUNK_DEFINITION_HARDLINK_NAME,
                      archiveEntryInfo->blockLength,
-                     &archiveEntryInfo->link.chunkLinkExtendedAttribute.cryptInfo,
-                     &archiveEntryInfo->link.chunkLinkExtendedAttribute
+                     &archiveEntryInfo->hardLink.chunkHardLinkName.cryptInfo,
+                     &archiveEntryInfo->hardLink.chunkHardLinkName
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkName.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkName.info); });
+
+  error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.info,
+                     &archiveEntryInfo->hardLink.chunkHardLink.info,
+                     CHUNK_USE_PARENT,
+                     CHUNK_USE_PARENT,
+                     CHUNK_ID_HARDLINK_EXTENDED_ATTRIBUTE,
+                     CHUNK_DEFINITION_HARDLINK_EXTENDED_ATTRIBUTE,
+                     archiveEntryInfo->blockLength,
+                     &archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.cryptInfo,
+                     &archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.info); });
+
+  error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLinkDelta.info,
+                     &archiveEntryInfo->hardLink.chunkHardLink.info,
+                     CHUNK_USE_PARENT,
+                     CHUNK_USE_PARENT,
+                     CHUNK_ID_HARDLINK_DELTA,
+                     CHUNK_DEFINITION_HARDLINK_DELTA,
+                     archiveEntryInfo->blockLength,
+                     &archiveEntryInfo->hardLink.chunkHardLinkDelta.cryptInfo,
+                     &archiveEntryInfo->hardLink.chunkHardLinkDelta
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  if (Compress_isCompressed(archiveEntryInfo->hardLink.deltaCompressAlgorithm))
+  {
+    assert(Compress_isDeltaCompressed(archiveEntryInfo->hardLink.deltaCompressAlgorithm));
+
+    archiveEntryInfo->hardLink.chunkHardLinkDelta.deltaAlgorithm = COMPRESS_ALGORITHM_TO_CONSTANT(archiveEntryInfo->hardLink.deltaCompressAlgorithm);
+    String_set(archiveEntryInfo->hardLink.chunkHardLinkDelta.name,DeltaSource_getName(&archiveEntryInfo->hardLink.deltaSourceHandle));
+    archiveEntryInfo->hardLink.chunkHardLinkDelta.size = DeltaSource_getSize(&archiveEntryInfo->hardLink.deltaSourceHandle);
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkDelta.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkDelta.info); });
+
+  error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLinkHole.info,
+                     &archiveEntryInfo->hardLink.chunkHardLink.info,
+                     CHUNK_USE_PARENT,
+                     CHUNK_USE_PARENT,
+                     CHUNK_ID_HARDLINK_HOLE,
+                     CHUNK_DEFINITION_HARDLINK_HOLE,
+                     archiveEntryInfo->blockLength,
+                     &archiveEntryInfo->hardLink.chunkHardLinkHole.cryptInfo,
+                     &archiveEntryInfo->hardLink.chunkHardLinkHole
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  DEBUG_TESTCODE() { Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkHole.info); AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkHole.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkHole.info); });
+
+  error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLinkData.info,
+                     &archiveEntryInfo->hardLink.chunkHardLink.info,
+                     CHUNK_USE_PARENT,
+                     CHUNK_USE_PARENT,
+                     CHUNK_ID_HARDLINK_DATA,
+                     CHUNK_DEFINITION_HARDLINK_DATA,
+                     archiveEntryInfo->blockLength,
+                     &archiveEntryInfo->hardLink.chunkHardLinkData.cryptInfo,
+                     &archiveEntryInfo->hardLink.chunkHardLinkData
                     );
   if (error != ERROR_NONE)
   {
-    AutoFree_cleanup(&autoFreeList);
-    return error;
-  }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->link.chunkLinkExtendedAttribute.info,{ Chunk_done(&archiveEntryInfo->link.chunkLinkExtendedAttribute.info); });
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  archiveEntryInfo->hardLink.chunkHardLinkData.fragmentOffset = fragmentOffset;
+//TODO: multi crypt
+  archiveEntryInfo->hardLink.chunkHardLinkData.fragmentSize   = 0LL;
+  Chunk_setDataCrypt(&archiveEntryInfo->hardLink.chunkHardLinkData.info,&archiveEntryInfo->hardLink.cryptInfo);
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkData.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkData.info); });
+
+  // init delta compress (if no delta-compression is enabled, use identity-compressor), byte compress
+  error = Compress_init(&archiveEntryInfo->hardLink.deltaCompressInfo,
+                        COMPRESS_MODE_DEFLATE,
+                        archiveEntryInfo->hardLink.deltaCompressAlgorithm,
+                        1,  // blockLength
+                        0,  // length (unknown),
+                        &archiveEntryInfo->hardLink.deltaSourceHandle
+                       );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.deltaCompressInfo,{ Compress_done(&archiveEntryInfo->hardLink.deltaCompressInfo); });
+
+  // init byte compress (if no byte-compression is enabled, use identity-compressor)
+  error = Compress_init(&archiveEntryInfo->hardLink.byteCompressInfo,
+                        COMPRESS_MODE_DEFLATE,
+                        archiveEntryInfo->hardLink.byteCompressAlgorithm,
+                        archiveEntryInfo->blockLength,
+                        fragmentSize,
+                        NULL  // deltaSourceHandle
+                       );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.byteCompressInfo,{ Compress_done(&archiveEntryInfo->hardLink.byteCompressInfo); });
+
+  // calculate header size
+  archiveEntryInfo->hardLink.headerLength = Chunk_getSize(&archiveEntryInfo->hardLink.chunkHardLink.info,     &archiveEntryInfo->hardLink.chunkHardLink,     0)+
+                                            Chunk_getSize(&archiveEntryInfo->hardLink.chunkHardLinkEntry.info,&archiveEntryInfo->hardLink.chunkHardLinkEntry,0)+
+                                            Chunk_getSize(&archiveEntryInfo->hardLink.chunkHardLinkData.info, &archiveEntryInfo->hardLink.chunkHardLinkData, 0);
+  ConstString fileName;
+  STRINGLIST_ITERATE(archiveEntryInfo->hardLink.fileNameList,fileName)
+  {
+    convertSystemToUTF8Encoding(archiveEntryInfo->hardLink.chunkHardLinkName.name,fileName);
 
-  // calculate header length
-  ulong headerLength = Chunk_getSize(&archiveEntryInfo->link.chunkLink.info,     &archiveEntryInfo->link.chunkLink,     0)+
-                       Chunk_getSize(&archiveEntryInfo->link.chunkLinkEntry.info,&archiveEntryInfo->link.chunkLinkEntry,0);
+    archiveEntryInfo->hardLink.headerLength += Chunk_getSize(&archiveEntryInfo->hardLink.chunkHardLinkName.info,
+                                                             &archiveEntryInfo->hardLink.chunkHardLinkName,
+                                                             0
+                                                            );
+  }
   const FileExtendedAttributeNode *fileExtendedAttributeNode;
-  LIST_ITERATE(fileExtendedAttributeList,fileExtendedAttributeNode)
+  LIST_ITERATE(archiveEntryInfo->hardLink.fileExtendedAttributeList,fileExtendedAttributeNode)
   {
-    String_set(archiveEntryInfo->link.chunkLinkExtendedAttribute.name,fileExtendedAttributeNode->name);
+    String_set(archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.name,fileExtendedAttributeNode->name);
 
-    headerLength += Chunk_getSize(&archiveEntryInfo->link.chunkLinkExtendedAttribute.info,
-                                  &archiveEntryInfo->link.chunkLinkExtendedAttribute,
-                                  fileExtendedAttributeNode->dataLength
-                                 );
+    archiveEntryInfo->hardLink.headerLength += Chunk_getSize(&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.info,
+                                                             &archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute,
+                                                             fileExtendedAttributeNode->dataLength
+                                                            );
   }
-
-
-  if (!archiveHandle->dryRun)
+  if (Compress_isCompressed(archiveEntryInfo->hardLink.deltaCompressAlgorithm))
   {
-    // lock archive (Note: link entries are created direct without intermediate file)
-    Semaphore_forceLock(&archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE);
-
-    // ensure space in archive
-    error = ensureArchiveSpace(archiveHandle,
-                               headerLength
-                              );
-    if (error != ERROR_NONE)
-    {
-      Semaphore_unlock(&archiveHandle->lock);
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-
-    // create new archive file (if not already created)
-    error = createArchiveFile(archiveHandle);
-    if (error != ERROR_NONE)
-    {
-      Semaphore_unlock(&archiveHandle->lock);
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-
-    // write link chunk
-    error = Chunk_create(&archiveEntryInfo->link.chunkLink.info);
-    if (error != ERROR_NONE)
-    {
-      Semaphore_unlock(&archiveHandle->lock);
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-
-    // write link entry chunk
-    error = Chunk_create(&archiveEntryInfo->link.chunkLinkEntry.info);
-    if (error != ERROR_NONE)
-    {
-      Semaphore_unlock(&archiveHandle->lock);
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
+    assert(Compress_isDeltaCompressed(archiveEntryInfo->hardLink.deltaCompressAlgorithm));
 
-    // write extended attribute chunks
-    LIST_ITERATE(fileExtendedAttributeList,fileExtendedAttributeNode)
-    {
-      String_set(archiveEntryInfo->link.chunkLinkExtendedAttribute.name,fileExtendedAttributeNode->name);
-      archiveEntryInfo->link.chunkLinkExtendedAttribute.value.data   = fileExtendedAttributeNode->data;
-      archiveEntryInfo->link.chunkLinkExtendedAttribute.value.length = fileExtendedAttributeNode->dataLength;
+    archiveEntryInfo->hardLink.chunkHardLinkDelta.deltaAlgorithm = COMPRESS_ALGORITHM_TO_CONSTANT(archiveEntryInfo->hardLink.deltaCompressAlgorithm);
+    String_set(archiveEntryInfo->hardLink.chunkHardLinkDelta.name,DeltaSource_getName(&archiveEntryInfo->hardLink.deltaSourceHandle));
+    archiveEntryInfo->hardLink.chunkHardLinkDelta.size           = DeltaSource_getSize(&archiveEntryInfo->hardLink.deltaSourceHandle);
 
-      error = Chunk_create(&archiveEntryInfo->link.chunkLinkExtendedAttribute.info);
-      if (error != ERROR_NONE)
-      {
-        break;
-      }
-      error = Chunk_close(&archiveEntryInfo->link.chunkLinkExtendedAttribute.info);
-      if (error != ERROR_NONE)
-      {
-        break;
-      }
-    }
-    if (error != ERROR_NONE)
+    archiveEntryInfo->hardLink.headerLength += Chunk_getSize(&archiveEntryInfo->hardLink.chunkHardLinkDelta.info,
+                                                             &archiveEntryInfo->hardLink.chunkHardLinkDelta,
+                                                             0
+                                                            );
+  }
+  if (archiveEntryInfo->hardLink.fileHoleList != NULL)
+  {
+    const FileHoleNode *fileHoleNode;
+    LIST_ITERATE(archiveEntryInfo->hardLink.fileHoleList,fileHoleNode)
     {
-      Semaphore_unlock(&archiveHandle->lock);
-      AutoFree_cleanup(&autoFreeList);
-      return error;
+      archiveEntryInfo->hardLink.headerLength += Chunk_getSize(&archiveEntryInfo->hardLink.chunkHardLinkHole.info,
+                                                               &archiveEntryInfo->hardLink.chunkHardLinkHole,
+                                                               0
+                                                              );
     }
   }
 
+  // find next suitable archive part
+  findNextArchivePart(archiveHandle);
+
   // done resources
   AutoFree_done(&autoFreeList);
 
+  // write hardlink header
+  error = writeHardLinkChunks(archiveEntryInfo);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+  assert(archiveEntryInfo->hardLink.headerWrittenFlag);
+
   #ifdef NDEBUG
     DEBUG_ADD_RESOURCE_TRACE(archiveEntryInfo,ArchiveEntryInfo);
   #else /* not NDEBUG */
@@ -8316,37 +11525,27 @@ CRYPT_KEY_DERIVE_FUNCTION,//
 }
 
 #ifdef NDEBUG
-  Errors Archive_newHardLinkEntry(ArchiveEntryInfo                *archiveEntryInfo,
-                                  ArchiveHandle                   *archiveHandle,
-                                  CompressAlgorithms              deltaCompressAlgorithm,
-                                  CompressAlgorithms              byteCompressAlgorithm,
-                                  CryptAlgorithms                 cryptAlgorithm,
-                                  const CryptSalt                 *cryptSalt,
-                                  const CryptKey                  *cryptKey,
-                                  const StringList                *fileNameList,
-                                  const FileInfo                  *fileInfo,
-                                  const FileExtendedAttributeList *fileExtendedAttributeList,
-                                  uint64                          fragmentOffset,
-                                  uint64                          fragmentSize,
-                                  ArchiveFlags                    archiveFlags
-                                 )
+  Errors Archive_newSpecialEntry(ArchiveEntryInfo                *archiveEntryInfo,
+                                 ArchiveHandle                   *archiveHandle,
+                                 CryptAlgorithms                 cryptAlgorithm,
+                                 const CryptSalt                 *cryptSalt,
+                                 const CryptKey                  *cryptKey,
+                                 ConstString                     specialName,
+                                 const FileInfo                  *fileInfo,
+                                 const FileExtendedAttributeList *fileExtendedAttributeList
+                                )
 #else /* not NDEBUG */
-  Errors __Archive_newHardLinkEntry(const char                      *__fileName__,
-                                    ulong                           __lineNb__,
-                                    ArchiveEntryInfo                *archiveEntryInfo,
-                                    ArchiveHandle                   *archiveHandle,
-                                    CompressAlgorithms              deltaCompressAlgorithm,
-                                    CompressAlgorithms              byteCompressAlgorithm,
-                                    CryptAlgorithms                 cryptAlgorithm,
-                                    const CryptSalt                 *cryptSalt,
-                                    const CryptKey                  *cryptKey,
-                                    const StringList                *fileNameList,
-                                    const FileInfo                  *fileInfo,
-                                    const FileExtendedAttributeList *fileExtendedAttributeList,
-                                    uint64                          fragmentOffset,
-                                    uint64                          fragmentSize,
-                                    ArchiveFlags                    archiveFlags
-                                   )
+  Errors __Archive_newSpecialEntry(const char                      *__fileName__,
+                                   ulong                           __lineNb__,
+                                   ArchiveEntryInfo                *archiveEntryInfo,
+                                   ArchiveHandle                   *archiveHandle,
+                                   CryptAlgorithms                 cryptAlgorithm,
+                                   const CryptSalt                 *cryptSalt,
+                                   const CryptKey                  *cryptKey,
+                                   ConstString                     specialName,
+                                   const FileInfo                  *fileInfo,
+                                   const FileExtendedAttributeList *fileExtendedAttributeList
+                                  )
 #endif /* NDEBUG */
 {
   Errors error;
@@ -8358,7 +11557,6 @@ CRYPT_KEY_DERIVE_FUNCTION,//
   assert(archiveHandle->storageInfo->jobOptions != NULL);
   assert(archiveHandle->archiveCryptInfo != NULL);
   assert(archiveHandle->mode == ARCHIVE_MODE_CREATE);
-  assert(!StringList_isEmpty(fileNameList));
   assert(fileInfo != NULL);
 
   // init variables
@@ -8366,7 +11564,7 @@ CRYPT_KEY_DERIVE_FUNCTION,//
   AutoFree_init(&autoFreeList);
 
   // init archive entry info
-  archiveEntryInfo->archiveHandle                      = archiveHandle;
+  archiveEntryInfo->archiveHandle    = archiveHandle;
 
 #ifdef MULTI_CRYPT
   memCopyFast(&archiveEntryInfo->cryptAlgorithms,4*sizeof(CryptAlgorithms),cryptAlgorithms,4*sizeof(CryptAlgorithms));
@@ -8376,179 +11574,39 @@ CRYPT_KEY_DERIVE_FUNCTION,//
   archiveEntryInfo->cryptAlgorithms[2] = CRYPT_ALGORITHM_NONE;
   archiveEntryInfo->cryptAlgorithms[3] = CRYPT_ALGORITHM_NONE;
 #endif
-  archiveEntryInfo->blockLength                        = Crypt_getBlockLength(cryptAlgorithm);
-
-  archiveEntryInfo->archiveEntryType                   = ARCHIVE_ENTRY_TYPE_HARDLINK;
-
-  archiveEntryInfo->hardLink.fileNameList              = fileNameList;
-  archiveEntryInfo->hardLink.fileExtendedAttributeList = fileExtendedAttributeList;
-
-  archiveEntryInfo->hardLink.deltaCompressAlgorithm    = (archiveFlags & ARCHIVE_FLAG_TRY_DELTA_COMPRESS) ? deltaCompressAlgorithm : COMPRESS_ALGORITHM_NONE;
-  archiveEntryInfo->hardLink.byteCompressAlgorithm     = (archiveFlags & ARCHIVE_FLAG_TRY_BYTE_COMPRESS ) ? byteCompressAlgorithm  : COMPRESS_ALGORITHM_NONE;
-
-  archiveEntryInfo->hardLink.deltaSourceHandleInitFlag = FALSE;
-
-  archiveEntryInfo->hardLink.headerLength              = 0;
-  archiveEntryInfo->hardLink.headerWrittenFlag         = FALSE;
-
-  archiveEntryInfo->hardLink.byteBuffer                = NULL;
-  archiveEntryInfo->hardLink.byteBufferSize            = 0L;
-  archiveEntryInfo->hardLink.deltaBuffer               = NULL;
-  archiveEntryInfo->hardLink.deltaBufferSize           = 0L;
-
-  // get intermediate output file
-  error = File_getTmpFile(&archiveEntryInfo->hardLink.intermediateFileHandle,NULL,tmpDirectory);
-  if (error != ERROR_NONE)
-  {
-    AutoFree_cleanup(&autoFreeList);
-    return error;
-  }
-  DEBUG_TESTCODE() { (void)File_close(&archiveEntryInfo->hardLink.intermediateFileHandle); AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.intermediateFileHandle,{ (void)File_close(&archiveEntryInfo->hardLink.intermediateFileHandle); });
-
-  // allocate buffers
-  archiveEntryInfo->hardLink.byteBufferSize = FLOOR(MAX_BUFFER_SIZE,archiveEntryInfo->blockLength);
-  archiveEntryInfo->hardLink.byteBuffer = (byte*)malloc(archiveEntryInfo->hardLink.byteBufferSize);
-  if (archiveEntryInfo->hardLink.byteBuffer == NULL)
-  {
-    HALT_INSUFFICIENT_MEMORY();
-  }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.byteBuffer,{ free(archiveEntryInfo->hardLink.byteBuffer); });
-  archiveEntryInfo->hardLink.deltaBufferSize = MAX_BUFFER_SIZE;
-  archiveEntryInfo->hardLink.deltaBuffer = (byte*)malloc(archiveEntryInfo->hardLink.deltaBufferSize);
-  if (archiveEntryInfo->hardLink.deltaBuffer == NULL)
-  {
-    HALT_INSUFFICIENT_MEMORY();
-  }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.deltaBuffer,{ free(archiveEntryInfo->hardLink.deltaBuffer); });
+  archiveEntryInfo->blockLength      = Crypt_getBlockLength(cryptAlgorithm);
 
-  // get source for delta-compression
-  if ((archiveFlags & ARCHIVE_FLAG_TRY_DELTA_COMPRESS) && Compress_isCompressed(deltaCompressAlgorithm))
-  {
-    error = ERROR_NONE;
-    ConstString fileName;
-    STRINGLIST_ITERATE(fileNameList,fileName)
-    {
-      error = DeltaSource_openEntry(&archiveEntryInfo->hardLink.deltaSourceHandle,
-                                    archiveHandle->deltaSourceList,
-                                    NULL, // storageName
-                                    fileName,
-                                    SOURCE_SIZE_UNKNOWN,
-                                    archiveHandle->storageInfo->jobOptions
-                                   );
-      if (error == ERROR_NONE) break;
-    }
-    if      (error == ERROR_NONE)
-    {
-      // delta compress
-      archiveEntryInfo->hardLink.deltaSourceHandleInitFlag = TRUE;
-      AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.deltaSourceHandle,{ DeltaSource_closeEntry(&archiveEntryInfo->hardLink.deltaSourceHandle); });
-    }
-    else if (archiveHandle->storageInfo->jobOptions->forceDeltaCompressionFlag)
-    {
-      // no delta source -> error
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-    else
-    {
-      // no delta source -> print warning and disable delta compress
-      printWarning(_("file '%s' not delta compressed (no source file found)"),String_cString(StringList_first(fileNameList,NULL)));
-      logMessage(archiveHandle->logHandle,
-                 LOG_TYPE_WARNING,
-                 "File '%s' not delta compressed (no source file found)",
-                 String_cString(StringList_first(fileNameList,NULL))
-                );
-      archiveEntryInfo->hardLink.deltaCompressAlgorithm = COMPRESS_ALGORITHM_NONE;
-    }
-  }
+  archiveEntryInfo->archiveEntryType = ARCHIVE_ENTRY_TYPE_SPECIAL;
 
-  // init hard link chunk
-  error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLink.info,
+  // init special chunk
+  error = Chunk_init(&archiveEntryInfo->special.chunkSpecial.info,
                      NULL,  // parentChunkInfo
-                     &CHUNK_IO_FILE,
-                     &archiveEntryInfo->hardLink.intermediateFileHandle,
-                     CHUNK_ID_HARDLINK,
-                     CHUNK_DEFINITION_HARDLINK,
+                     archiveHandle->chunkIO,
+                     archiveHandle->chunkIOUserData,
+                     CHUNK_ID_SPECIAL,
+                     CHUNK_DEFINITION_SPECIAL,
 //TODO: DEFAULT_ALIGNMENT
                      0,  // alignment
                      NULL,  // cryptInfo
-                     &archiveEntryInfo->hardLink.chunkHardLink
+                     &archiveEntryInfo->special.chunkSpecial
                     );
   if (error != ERROR_NONE)
   {
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  archiveEntryInfo->hardLink.chunkHardLink.compressAlgorithm  = COMPRESS_ALGORITHM_TO_CONSTANT(archiveEntryInfo->hardLink.byteCompressAlgorithm);
 #ifdef MULTI_CRYPT
-  archiveEntryInfo->hardLink.chunkHardLink.cryptAlgorithms[0] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
-  archiveEntryInfo->hardLink.chunkHardLink.cryptAlgorithms[1] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[1]);
-  archiveEntryInfo->hardLink.chunkHardLink.cryptAlgorithms[2] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[2]);
-  archiveEntryInfo->hardLink.chunkHardLink.cryptAlgorithms[3] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[3]);
+  archiveEntryInfo->special.chunkSpecial.cryptAlgorithms[0] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
+  archiveEntryInfo->special.chunkSpecial.cryptAlgorithms[1] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[1]);
+  archiveEntryInfo->special.chunkSpecial.cryptAlgorithms[2] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[2]);
+  archiveEntryInfo->special.chunkSpecial.cryptAlgorithms[3] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[3]);
 #else
-  archiveEntryInfo->hardLink.chunkHardLink.cryptAlgorithm = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
+  archiveEntryInfo->special.chunkSpecial.cryptAlgorithm = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
 #endif
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLink.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLink.info); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->special.chunkSpecial.info,{ Chunk_done(&archiveEntryInfo->special.chunkSpecial.info); });
 
   // init crypt
-  error = Crypt_init(&archiveEntryInfo->hardLink.chunkHardLinkEntry.cryptInfo,
-//TODO: multi crypt
-                     archiveEntryInfo->cryptAlgorithms[0],
-                     CRYPT_MODE_CBC_,
-                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
-                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
-                    );
-  if (error != ERROR_NONE)
-  {
-    AutoFree_cleanup(&autoFreeList);
-    return error;
-  }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkEntry.cryptInfo,{ Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkEntry.cryptInfo); });
-
-  error = Crypt_init(&archiveEntryInfo->hardLink.chunkHardLinkName.cryptInfo,
-//TODO: multi crypt
-                     archiveEntryInfo->cryptAlgorithms[0],
-                     CRYPT_MODE_CBC_,
-                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
-                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
-                    );
-  if (error != ERROR_NONE)
-  {
-    AutoFree_cleanup(&autoFreeList);
-    return error;
-  }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkName.cryptInfo,{ Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkName.cryptInfo); });
-
-  error = Crypt_init(&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.cryptInfo,
-//TODO: multi crypt
-                     archiveEntryInfo->cryptAlgorithms[0],
-                     CRYPT_MODE_CBC_,
-                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
-                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
-                    );
-  if (error != ERROR_NONE)
-  {
-    AutoFree_cleanup(&autoFreeList);
-    return error;
-  }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.cryptInfo,{ Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.cryptInfo); });
-
-  error = Crypt_init(&archiveEntryInfo->hardLink.chunkHardLinkDelta.cryptInfo,
-//TODO: multi crypt
-                     archiveEntryInfo->cryptAlgorithms[0],
-                     CRYPT_MODE_CBC_,
-                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
-                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
-                    );
-  if (error != ERROR_NONE)
-  {
-    AutoFree_cleanup(&autoFreeList);
-    return error;
-  }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkDelta.cryptInfo,{ Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkDelta.cryptInfo); });
-
-  error = Crypt_init(&archiveEntryInfo->hardLink.chunkHardLinkData.cryptInfo,
+  error = Crypt_init(&archiveEntryInfo->special.chunkSpecialEntry.cryptInfo,
 //TODO: multi crypt
                      archiveEntryInfo->cryptAlgorithms[0],
                      CRYPT_MODE_CBC_,
@@ -8560,9 +11618,9 @@ CRYPT_KEY_DERIVE_FUNCTION,//
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkData.cryptInfo,{ Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkData.cryptInfo); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->special.chunkSpecialEntry.cryptInfo,{ Crypt_done(&archiveEntryInfo->special.chunkSpecialEntry.cryptInfo); });
 
-  error = Crypt_init(&archiveEntryInfo->hardLink.cryptInfo,
+  error = Crypt_init(&archiveEntryInfo->special.chunkSpecialExtendedAttribute.cryptInfo,
 //TODO: multi crypt
                      archiveEntryInfo->cryptAlgorithms[0],
                      CRYPT_MODE_CBC_,
@@ -8574,194 +11632,142 @@ CRYPT_KEY_DERIVE_FUNCTION,//
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.cryptInfo,{ Crypt_done(&archiveEntryInfo->hardLink.cryptInfo); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->special.chunkSpecialExtendedAttribute.cryptInfo,{ Crypt_done(&archiveEntryInfo->special.chunkSpecialExtendedAttribute.cryptInfo); });
 
   // init sub-chunks
-  error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLinkEntry.info,
-                     &archiveEntryInfo->hardLink.chunkHardLink.info,
-                     CHUNK_USE_PARENT,
-                     CHUNK_USE_PARENT,
-                     CHUNK_ID_HARDLINK_ENTRY,
-                     CHUNK_DEFINITION_HARDLINK_ENTRY,
-                     archiveEntryInfo->blockLength,
-                     &archiveEntryInfo->hardLink.chunkHardLinkEntry.cryptInfo,
-                     &archiveEntryInfo->hardLink.chunkHardLinkEntry
-                    );
-  if (error != ERROR_NONE)
-  {
-    AutoFree_cleanup(&autoFreeList);
-    return error;
-  }
-  archiveEntryInfo->hardLink.chunkHardLinkEntry.size            = fileInfo->size;
-  archiveEntryInfo->hardLink.chunkHardLinkEntry.timeLastAccess  = fileInfo->timeLastAccess;
-  archiveEntryInfo->hardLink.chunkHardLinkEntry.timeModified    = fileInfo->timeModified;
-  archiveEntryInfo->hardLink.chunkHardLinkEntry.timeLastChanged = fileInfo->timeLastChanged;
-  archiveEntryInfo->hardLink.chunkHardLinkEntry.userId          = fileInfo->userId;
-  archiveEntryInfo->hardLink.chunkHardLinkEntry.groupId         = fileInfo->groupId;
-  archiveEntryInfo->hardLink.chunkHardLinkEntry.permissions     = fileInfo->permissions;
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkEntry.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkEntry.info); });
-
-  error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLinkName.info,
-                     &archiveEntryInfo->hardLink.chunkHardLink.info,
+  error = Chunk_init(&archiveEntryInfo->special.chunkSpecialEntry.info,
+                     &archiveEntryInfo->special.chunkSpecial.info,
                      CHUNK_USE_PARENT,
                      CHUNK_USE_PARENT,
-                     CHUNK_ID_HARDLINK_NAME,
-                     CHUNK_DEFINITION_HARDLINK_NAME,
+                     CHUNK_ID_SPECIAL_ENTRY,
+                     CHUNK_DEFINITION_SPECIAL_ENTRY,
                      archiveEntryInfo->blockLength,
-                     &archiveEntryInfo->hardLink.chunkHardLinkName.cryptInfo,
-                     &archiveEntryInfo->hardLink.chunkHardLinkName
+                     &archiveEntryInfo->special.chunkSpecialEntry.cryptInfo,
+                     &archiveEntryInfo->special.chunkSpecialEntry
                     );
   if (error != ERROR_NONE)
   {
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkName.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkName.info); });
+  archiveEntryInfo->special.chunkSpecialEntry.specialType     = fileInfo->specialType;
+  archiveEntryInfo->special.chunkSpecialEntry.timeLastAccess  = fileInfo->timeLastAccess;
+  archiveEntryInfo->special.chunkSpecialEntry.timeModified    = fileInfo->timeModified;
+  archiveEntryInfo->special.chunkSpecialEntry.timeLastChanged = fileInfo->timeLastChanged;
+  archiveEntryInfo->special.chunkSpecialEntry.userId          = fileInfo->userId;
+  archiveEntryInfo->special.chunkSpecialEntry.groupId         = fileInfo->groupId;
+  archiveEntryInfo->special.chunkSpecialEntry.permissions     = fileInfo->permissions;
+  archiveEntryInfo->special.chunkSpecialEntry.major           = fileInfo->major;
+  archiveEntryInfo->special.chunkSpecialEntry.minor           = fileInfo->minor;
+  convertSystemToUTF8Encoding(archiveEntryInfo->special.chunkSpecialEntry.name,specialName);
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->special.chunkSpecialEntry.info,{ Chunk_done(&archiveEntryInfo->special.chunkSpecialEntry.info); });
 
-  error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.info,
-                     &archiveEntryInfo->hardLink.chunkHardLink.info,
+  error = Chunk_init(&archiveEntryInfo->special.chunkSpecialExtendedAttribute.info,
+                     &archiveEntryInfo->special.chunkSpecial.info,
                      CHUNK_USE_PARENT,
                      CHUNK_USE_PARENT,
-                     CHUNK_ID_HARDLINK_EXTENDED_ATTRIBUTE,
-                     CHUNK_DEFINITION_HARDLINK_EXTENDED_ATTRIBUTE,
+                     CHUNK_ID_SPECIAL_EXTENDED_ATTRIBUTE,
+                     CHUNK_DEFINITION_SPECIAL_EXTENDED_ATTRIBUTE,
                      archiveEntryInfo->blockLength,
-                     &archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.cryptInfo,
-                     &archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute
+                     &archiveEntryInfo->special.chunkSpecialExtendedAttribute.cryptInfo,
+                     &archiveEntryInfo->special.chunkSpecialExtendedAttribute
                     );
   if (error != ERROR_NONE)
   {
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.info); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->special.chunkSpecialExtendedAttribute.info,{ Chunk_done(&archiveEntryInfo->special.chunkSpecialExtendedAttribute.info); });
 
-  error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLinkDelta.info,
-                     &archiveEntryInfo->hardLink.chunkHardLink.info,
-                     CHUNK_USE_PARENT,
-                     CHUNK_USE_PARENT,
-                     CHUNK_ID_HARDLINK_DELTA,
-                     CHUNK_DEFINITION_HARDLINK_DELTA,
-                     archiveEntryInfo->blockLength,
-                     &archiveEntryInfo->hardLink.chunkHardLinkDelta.cryptInfo,
-                     &archiveEntryInfo->hardLink.chunkHardLinkDelta
-                    );
-  if (error != ERROR_NONE)
-  {
-    AutoFree_cleanup(&autoFreeList);
-    return error;
-  }
-  if (Compress_isCompressed(archiveEntryInfo->hardLink.deltaCompressAlgorithm))
+  // calculate header length
+  ulong headerLength = Chunk_getSize(&archiveEntryInfo->special.chunkSpecial.info,     &archiveEntryInfo->special.chunkSpecial,     0)+
+                       Chunk_getSize(&archiveEntryInfo->special.chunkSpecialEntry.info,&archiveEntryInfo->special.chunkSpecialEntry,0);
+  const FileExtendedAttributeNode *fileExtendedAttributeNode;
+  LIST_ITERATE(fileExtendedAttributeList,fileExtendedAttributeNode)
   {
-    assert(Compress_isDeltaCompressed(archiveEntryInfo->hardLink.deltaCompressAlgorithm));
+    String_set(archiveEntryInfo->special.chunkSpecialExtendedAttribute.name,fileExtendedAttributeNode->name);
 
-    archiveEntryInfo->hardLink.chunkHardLinkDelta.deltaAlgorithm = COMPRESS_ALGORITHM_TO_CONSTANT(archiveEntryInfo->hardLink.deltaCompressAlgorithm);
-    String_set(archiveEntryInfo->hardLink.chunkHardLinkDelta.name,DeltaSource_getName(&archiveEntryInfo->hardLink.deltaSourceHandle));
-    archiveEntryInfo->hardLink.chunkHardLinkDelta.size = DeltaSource_getSize(&archiveEntryInfo->hardLink.deltaSourceHandle);
+    headerLength += Chunk_getSize(&archiveEntryInfo->special.chunkSpecialExtendedAttribute.info,
+                                  &archiveEntryInfo->special.chunkSpecialExtendedAttribute,
+                                  fileExtendedAttributeNode->dataLength
+                                 );
   }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkDelta.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkDelta.info); });
 
-  error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLinkData.info,
-                     &archiveEntryInfo->hardLink.chunkHardLink.info,
-                     CHUNK_USE_PARENT,
-                     CHUNK_USE_PARENT,
-                     CHUNK_ID_HARDLINK_DATA,
-                     CHUNK_DEFINITION_HARDLINK_DATA,
-                     archiveEntryInfo->blockLength,
-                     &archiveEntryInfo->hardLink.chunkHardLinkData.cryptInfo,
-                     &archiveEntryInfo->hardLink.chunkHardLinkData
-                    );
-  if (error != ERROR_NONE)
-  {
-    AutoFree_cleanup(&autoFreeList);
-    return error;
-  }
-  archiveEntryInfo->hardLink.chunkHardLinkData.fragmentOffset = fragmentOffset;
-//TODO: multi crypt
-  archiveEntryInfo->hardLink.chunkHardLinkData.fragmentSize   = 0LL;
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.chunkHardLinkData.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkData.info); });
+  // find next suitable archive part
+  findNextArchivePart(archiveHandle);
 
-  // init delta compress (if no delta-compression is enabled, use identity-compressor), byte compress
-  error = Compress_init(&archiveEntryInfo->hardLink.deltaCompressInfo,
-                        COMPRESS_MODE_DEFLATE,
-                        archiveEntryInfo->hardLink.deltaCompressAlgorithm,
-                        1,  // blockLength
-                        0,  // length (unknown),
-                        &archiveEntryInfo->hardLink.deltaSourceHandle
-                       );
-  if (error != ERROR_NONE)
+  if (!archiveHandle->dryRun)
   {
-    AutoFree_cleanup(&autoFreeList);
-    return error;
-  }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.deltaCompressInfo,{ Compress_done(&archiveEntryInfo->hardLink.deltaCompressInfo); });
+    // lock archive (Note: special entries are created direct without intermediate file)
+    Semaphore_forceLock(&archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE);
 
-  // init byte compress (if no byte-compression is enabled, use identity-compressor)
-  error = Compress_init(&archiveEntryInfo->hardLink.byteCompressInfo,
-                        COMPRESS_MODE_DEFLATE,
-                        archiveEntryInfo->hardLink.byteCompressAlgorithm,
-                        archiveEntryInfo->blockLength,
-                        fragmentSize,
-                        NULL  // deltaSourceHandle
-                       );
-  if (error != ERROR_NONE)
-  {
-    AutoFree_cleanup(&autoFreeList);
-    return error;
-  }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->hardLink.byteCompressInfo,{ Compress_done(&archiveEntryInfo->hardLink.byteCompressInfo); });
+    // ensure space in archive
+    error = ensureArchiveSpace(archiveHandle,
+                               headerLength
+                              );
+    if (error != ERROR_NONE)
+    {
+      Semaphore_unlock(&archiveHandle->lock);
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
 
-  // calculate header size
-  archiveEntryInfo->hardLink.headerLength = Chunk_getSize(&archiveEntryInfo->hardLink.chunkHardLink.info,     &archiveEntryInfo->hardLink.chunkHardLink,     0)+
-                                            Chunk_getSize(&archiveEntryInfo->hardLink.chunkHardLinkEntry.info,&archiveEntryInfo->hardLink.chunkHardLinkEntry,0)+
-                                            Chunk_getSize(&archiveEntryInfo->hardLink.chunkHardLinkData.info, &archiveEntryInfo->hardLink.chunkHardLinkData, 0);
-  ConstString fileName;
-  STRINGLIST_ITERATE(archiveEntryInfo->hardLink.fileNameList,fileName)
-  {
-    convertSystemToUTF8Encoding(archiveEntryInfo->hardLink.chunkHardLinkName.name,fileName);
+    // create new archive file (if not already created)
+    error = createArchiveFile(archiveHandle);
+    if (error != ERROR_NONE)
+    {
+      Semaphore_unlock(&archiveHandle->lock);
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
 
-    archiveEntryInfo->hardLink.headerLength += Chunk_getSize(&archiveEntryInfo->hardLink.chunkHardLinkName.info,
-                                                             &archiveEntryInfo->hardLink.chunkHardLinkName,
-                                                             0
-                                                            );
-  }
-  const FileExtendedAttributeNode *fileExtendedAttributeNode;
-  LIST_ITERATE(archiveEntryInfo->hardLink.fileExtendedAttributeList,fileExtendedAttributeNode)
-  {
-    String_set(archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.name,fileExtendedAttributeNode->name);
+    // write special chunk
+    error = Chunk_create(&archiveEntryInfo->special.chunkSpecial.info);
+    if (error != ERROR_NONE)
+    {
+      Semaphore_unlock(&archiveHandle->lock);
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
 
-    archiveEntryInfo->hardLink.headerLength += Chunk_getSize(&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.info,
-                                                             &archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute,
-                                                             fileExtendedAttributeNode->dataLength
-                                                            );
-  }
-  if (Compress_isCompressed(archiveEntryInfo->hardLink.deltaCompressAlgorithm))
-  {
-    assert(Compress_isDeltaCompressed(archiveEntryInfo->hardLink.deltaCompressAlgorithm));
+    // write special entry chunk
+    error = Chunk_create(&archiveEntryInfo->special.chunkSpecialEntry.info);
+    if (error != ERROR_NONE)
+    {
+      Semaphore_unlock(&archiveHandle->lock);
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
 
-    archiveEntryInfo->hardLink.chunkHardLinkDelta.deltaAlgorithm = COMPRESS_ALGORITHM_TO_CONSTANT(archiveEntryInfo->hardLink.deltaCompressAlgorithm);
-    String_set(archiveEntryInfo->hardLink.chunkHardLinkDelta.name,DeltaSource_getName(&archiveEntryInfo->hardLink.deltaSourceHandle));
-    archiveEntryInfo->hardLink.chunkHardLinkDelta.size           = DeltaSource_getSize(&archiveEntryInfo->hardLink.deltaSourceHandle);
+    // write extended attribute chunks
+    LIST_ITERATE(fileExtendedAttributeList,fileExtendedAttributeNode)
+    {
+      String_set(archiveEntryInfo->special.chunkSpecialExtendedAttribute.name,fileExtendedAttributeNode->name);
+      archiveEntryInfo->special.chunkSpecialExtendedAttribute.value.data   = fileExtendedAttributeNode->data;
+      archiveEntryInfo->special.chunkSpecialExtendedAttribute.value.length = fileExtendedAttributeNode->dataLength;
 
-    archiveEntryInfo->hardLink.headerLength += Chunk_getSize(&archiveEntryInfo->hardLink.chunkHardLinkDelta.info,
-                                                             &archiveEntryInfo->hardLink.chunkHardLinkDelta,
-                                                             0
-                                                            );
+      error = Chunk_create(&archiveEntryInfo->special.chunkSpecialExtendedAttribute.info);
+      if (error != ERROR_NONE)
+      {
+        break;
+      }
+      error = Chunk_close(&archiveEntryInfo->special.chunkSpecialExtendedAttribute.info);
+      if (error != ERROR_NONE)
+      {
+        break;
+      }
+    }
+    if (error != ERROR_NONE)
+    {
+      Semaphore_unlock(&archiveHandle->lock);
+      AutoFree_cleanup(&autoFreeList);
+      return error;
+    }
   }
 
-  // find next suitable archive part
-  findNextArchivePart(archiveHandle);
-
   // done resources
   AutoFree_done(&autoFreeList);
 
-  // write hardlink header
-  error = writeHardLinkChunks(archiveEntryInfo);
-  if (error != ERROR_NONE)
-  {
-    return error;
-  }
-  assert(archiveEntryInfo->hardLink.headerWrittenFlag);
-
   #ifdef NDEBUG
     DEBUG_ADD_RESOURCE_TRACE(archiveEntryInfo,ArchiveEntryInfo);
   #else /* not NDEBUG */
@@ -8772,27 +11778,23 @@ CRYPT_KEY_DERIVE_FUNCTION,//
 }
 
 #ifdef NDEBUG
-  Errors Archive_newSpecialEntry(ArchiveEntryInfo                *archiveEntryInfo,
-                                 ArchiveHandle                   *archiveHandle,
-                                 CryptAlgorithms                 cryptAlgorithm,
-                                 const CryptSalt                 *cryptSalt,
-                                 const CryptKey                  *cryptKey,
-                                 ConstString                     specialName,
-                                 const FileInfo                  *fileInfo,
-                                 const FileExtendedAttributeList *fileExtendedAttributeList
-                                )
+  Errors Archive_newSolidEntry(ArchiveEntryInfo   *archiveEntryInfo,
+                               ArchiveHandle      *archiveHandle,
+                               CompressAlgorithms byteCompressAlgorithm,
+                               CryptAlgorithms    cryptAlgorithm,
+                               const CryptSalt    *cryptSalt,
+                               const CryptKey     *cryptKey
+                              )
 #else /* not NDEBUG */
-  Errors __Archive_newSpecialEntry(const char                      *__fileName__,
-                                   ulong                           __lineNb__,
-                                   ArchiveEntryInfo                *archiveEntryInfo,
-                                   ArchiveHandle                   *archiveHandle,
-                                   CryptAlgorithms                 cryptAlgorithm,
-                                   const CryptSalt                 *cryptSalt,
-                                   const CryptKey                  *cryptKey,
-                                   ConstString                     specialName,
-                                   const FileInfo                  *fileInfo,
-                                   const FileExtendedAttributeList *fileExtendedAttributeList
-                                  )
+  Errors __Archive_newSolidEntry(const char         *__fileName__,
+                                 ulong              __lineNb__,
+                                 ArchiveEntryInfo   *archiveEntryInfo,
+                                 ArchiveHandle      *archiveHandle,
+                                 CompressAlgorithms byteCompressAlgorithm,
+                                 CryptAlgorithms    cryptAlgorithm,
+                                 const CryptSalt    *cryptSalt,
+                                 const CryptKey     *cryptKey
+                                )
 #endif /* NDEBUG */
 {
   Errors error;
@@ -8804,57 +11806,51 @@ CRYPT_KEY_DERIVE_FUNCTION,//
   assert(archiveHandle->storageInfo->jobOptions != NULL);
   assert(archiveHandle->archiveCryptInfo != NULL);
   assert(archiveHandle->mode == ARCHIVE_MODE_CREATE);
-  assert(fileInfo != NULL);
 
   // init variables
   AutoFreeList autoFreeList;
   AutoFree_init(&autoFreeList);
 
   // init archive entry info
-  archiveEntryInfo->archiveHandle    = archiveHandle;
+  archiveEntryInfo->archiveHandle              = archiveHandle;
 
-#ifdef MULTI_CRYPT
-  memCopyFast(&archiveEntryInfo->cryptAlgorithms,4*sizeof(CryptAlgorithms),cryptAlgorithms,4*sizeof(CryptAlgorithms));
-#else
-  archiveEntryInfo->cryptAlgorithms[0] = cryptAlgorithm;
-  archiveEntryInfo->cryptAlgorithms[1] = CRYPT_ALGORITHM_NONE;
-  archiveEntryInfo->cryptAlgorithms[2] = CRYPT_ALGORITHM_NONE;
-  archiveEntryInfo->cryptAlgorithms[3] = CRYPT_ALGORITHM_NONE;
-#endif
-  archiveEntryInfo->blockLength      = Crypt_getBlockLength(cryptAlgorithm);
+  archiveEntryInfo->cryptAlgorithms[0]         = cryptAlgorithm;
+  archiveEntryInfo->cryptAlgorithms[1]         = CRYPT_ALGORITHM_NONE;
+  archiveEntryInfo->cryptAlgorithms[2]         = CRYPT_ALGORITHM_NONE;
+  archiveEntryInfo->cryptAlgorithms[3]         = CRYPT_ALGORITHM_NONE;
+  archiveEntryInfo->blockLength                = Crypt_getBlockLength(cryptAlgorithm);
 
-  archiveEntryInfo->archiveEntryType = ARCHIVE_ENTRY_TYPE_SPECIAL;
+  archiveEntryInfo->archiveEntryType           = ARCHIVE_ENTRY_TYPE_SOLID;
 
-  // init special chunk
-  error = Chunk_init(&archiveEntryInfo->special.chunkSpecial.info,
-                     NULL,  // parentChunkInfo
-                     archiveHandle->chunkIO,
-                     archiveHandle->chunkIOUserData,
-                     CHUNK_ID_SPECIAL,
-                     CHUNK_DEFINITION_SPECIAL,
-//TODO: DEFAULT_ALIGNMENT
-                     0,  // alignment
-                     NULL,  // cryptInfo
-                     &archiveEntryInfo->special.chunkSpecial
-                    );
+  archiveEntryInfo->solid.byteCompressAlgorithm = byteCompressAlgorithm;
+
+  archiveEntryInfo->solid.dataLength           = 0LL;
+  archiveEntryInfo->solid.byteBuffer           = NULL;
+  archiveEntryInfo->solid.byteBufferSize       = 0L;
+
+  List_init(&archiveEntryInfo->solid.memberList,CALLBACK_(NULL,NULL),CALLBACK_((ListNodeFreeFunction)freeArchiveSolidMemberNode,NULL));
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->solid.memberList,{ List_done(&archiveEntryInfo->solid.memberList); });
+
+  // get intermediate output file
+  error = File_getTmpFile(&archiveEntryInfo->solid.intermediateFileHandle,NULL,tmpDirectory);
   if (error != ERROR_NONE)
   {
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-#ifdef MULTI_CRYPT
-  archiveEntryInfo->special.chunkSpecial.cryptAlgorithms[0] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
-  archiveEntryInfo->special.chunkSpecial.cryptAlgorithms[1] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[1]);
-  archiveEntryInfo->special.chunkSpecial.cryptAlgorithms[2] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[2]);
-  archiveEntryInfo->special.chunkSpecial.cryptAlgorithms[3] = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[3]);
-#else
-  archiveEntryInfo->special.chunkSpecial.cryptAlgorithm = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
-#endif
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->special.chunkSpecial.info,{ Chunk_done(&archiveEntryInfo->special.chunkSpecial.info); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->solid.intermediateFileHandle,{ (void)File_close(&archiveEntryInfo->solid.intermediateFileHandle); });
+
+  // allocate buffers
+  archiveEntryInfo->solid.byteBufferSize = FLOOR(MAX_BUFFER_SIZE,archiveEntryInfo->blockLength);
+  archiveEntryInfo->solid.byteBuffer = (byte*)malloc(archiveEntryInfo->solid.byteBufferSize);
+  if (archiveEntryInfo->solid.byteBuffer == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  AUTOFREE_ADD(&autoFreeList,archiveEntryInfo->solid.byteBuffer,{ free(archiveEntryInfo->solid.byteBuffer); });
 
   // init crypt
-  error = Crypt_init(&archiveEntryInfo->special.chunkSpecialEntry.cryptInfo,
-//TODO: multi crypt
+  error = Crypt_init(&archiveEntryInfo->solid.chunkSolidData.cryptInfo,
                      archiveEntryInfo->cryptAlgorithms[0],
                      CRYPT_MODE_CBC_,
                      (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
@@ -8865,10 +11861,9 @@ CRYPT_KEY_DERIVE_FUNCTION,//
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->special.chunkSpecialEntry.cryptInfo,{ Crypt_done(&archiveEntryInfo->special.chunkSpecialEntry.cryptInfo); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->solid.chunkSolidData.cryptInfo,{ Crypt_done(&archiveEntryInfo->solid.chunkSolidData.cryptInfo); });
 
-  error = Crypt_init(&archiveEntryInfo->special.chunkSpecialExtendedAttribute.cryptInfo,
-//TODO: multi crypt
+  error = Crypt_init(&archiveEntryInfo->solid.chunkFileEntry.cryptInfo,
                      archiveEntryInfo->cryptAlgorithms[0],
                      CRYPT_MODE_CBC_,
                      (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
@@ -8879,137 +11874,188 @@ CRYPT_KEY_DERIVE_FUNCTION,//
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->special.chunkSpecialExtendedAttribute.cryptInfo,{ Crypt_done(&archiveEntryInfo->special.chunkSpecialExtendedAttribute.cryptInfo); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->solid.chunkFileEntry.cryptInfo,{ Crypt_done(&archiveEntryInfo->solid.chunkFileEntry.cryptInfo); });
 
-  // init sub-chunks
-  error = Chunk_init(&archiveEntryInfo->special.chunkSpecialEntry.info,
-                     &archiveEntryInfo->special.chunkSpecial.info,
+  error = Crypt_init(&archiveEntryInfo->solid.chunkFileExtendedAttribute.cryptInfo,
+                     archiveEntryInfo->cryptAlgorithms[0],
+                     CRYPT_MODE_CBC_,
+                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
+                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->solid.chunkFileExtendedAttribute.cryptInfo,{ Crypt_done(&archiveEntryInfo->solid.chunkFileExtendedAttribute.cryptInfo); });
+
+  error = Crypt_init(&archiveEntryInfo->solid.chunkFileSolid.cryptInfo,
+                     archiveEntryInfo->cryptAlgorithms[0],
+                     CRYPT_MODE_CBC_,
+                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
+                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->solid.chunkFileSolid.cryptInfo,{ Crypt_done(&archiveEntryInfo->solid.chunkFileSolid.cryptInfo); });
+
+  error = Crypt_init(&archiveEntryInfo->solid.cryptInfo,
+                     archiveEntryInfo->cryptAlgorithms[0],
+                     CRYPT_MODE_CBC_,
+                     (cryptSalt != NULL) ? cryptSalt : &archiveHandle->archiveCryptInfo->cryptSalt,
+                     (cryptKey != NULL) ? cryptKey : &archiveHandle->archiveCryptInfo->cryptKey
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->solid.cryptInfo,{ Crypt_done(&archiveEntryInfo->solid.cryptInfo); });
+
+  // init solid block chunks
+  error = Chunk_init(&archiveEntryInfo->solid.chunkSolid.info,
+                     NULL,  // parentChunkInfo
+                     &CHUNK_IO_FILE,
+                     &archiveEntryInfo->solid.intermediateFileHandle,
+                     CHUNK_ID_SOLID,
+                     CHUNK_DEFINITION_SOLID,
+                     DEFAULT_ALIGNMENT,
+                     NULL,  // cryptInfo
+                     &archiveEntryInfo->solid.chunkSolid
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  archiveEntryInfo->solid.chunkSolid.compressAlgorithm = COMPRESS_ALGORITHM_TO_CONSTANT(byteCompressAlgorithm);
+  archiveEntryInfo->solid.chunkSolid.cryptAlgorithm    = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->solid.chunkSolid.info,{ Chunk_done(&archiveEntryInfo->solid.chunkSolid.info); });
+
+  error = Chunk_init(&archiveEntryInfo->solid.chunkSolidData.info,
+                     &archiveEntryInfo->solid.chunkSolid.info,
                      CHUNK_USE_PARENT,
                      CHUNK_USE_PARENT,
-                     CHUNK_ID_SPECIAL_ENTRY,
-                     CHUNK_DEFINITION_SPECIAL_ENTRY,
+                     CHUNK_ID_FILE_DATA,
+                     CHUNK_DEFINITION_FILE_DATA,
                      archiveEntryInfo->blockLength,
-                     &archiveEntryInfo->special.chunkSpecialEntry.cryptInfo,
-                     &archiveEntryInfo->special.chunkSpecialEntry
+                     &archiveEntryInfo->solid.chunkSolidData.cryptInfo,
+                     &archiveEntryInfo->solid.chunkSolidData
                     );
   if (error != ERROR_NONE)
   {
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  archiveEntryInfo->special.chunkSpecialEntry.specialType     = fileInfo->specialType;
-  archiveEntryInfo->special.chunkSpecialEntry.timeLastAccess  = fileInfo->timeLastAccess;
-  archiveEntryInfo->special.chunkSpecialEntry.timeModified    = fileInfo->timeModified;
-  archiveEntryInfo->special.chunkSpecialEntry.timeLastChanged = fileInfo->timeLastChanged;
-  archiveEntryInfo->special.chunkSpecialEntry.userId          = fileInfo->userId;
-  archiveEntryInfo->special.chunkSpecialEntry.groupId         = fileInfo->groupId;
-  archiveEntryInfo->special.chunkSpecialEntry.permissions     = fileInfo->permissions;
-  archiveEntryInfo->special.chunkSpecialEntry.major           = fileInfo->major;
-  archiveEntryInfo->special.chunkSpecialEntry.minor           = fileInfo->minor;
-  convertSystemToUTF8Encoding(archiveEntryInfo->special.chunkSpecialEntry.name,specialName);
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->special.chunkSpecialEntry.info,{ Chunk_done(&archiveEntryInfo->special.chunkSpecialEntry.info); });
+  archiveEntryInfo->solid.chunkSolidData.fragmentOffset = 0LL;
+  archiveEntryInfo->solid.chunkSolidData.fragmentSize   = 0LL;
+  Chunk_setDataCrypt(&archiveEntryInfo->solid.chunkSolidData.info,&archiveEntryInfo->solid.cryptInfo);
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->solid.chunkSolidData.info,{ Chunk_done(&archiveEntryInfo->solid.chunkSolidData.info); });
+
+  // init member chunks
+  error = Chunk_init(&archiveEntryInfo->solid.chunkFile.info,
+                     NULL,  // parentChunkInfo
+                     &CHUNK_IO_FILE,
+                     &archiveEntryInfo->solid.intermediateFileHandle,
+                     CHUNK_ID_FILE,
+                     CHUNK_DEFINITION_FILE,
+                     DEFAULT_ALIGNMENT,
+                     NULL,  // cryptInfo
+                     &archiveEntryInfo->solid.chunkFile
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  archiveEntryInfo->solid.chunkFile.compressAlgorithm = COMPRESS_ALGORITHM_TO_CONSTANT(byteCompressAlgorithm);
+  archiveEntryInfo->solid.chunkFile.cryptAlgorithm    = CRYPT_ALGORITHM_TO_CONSTANT(archiveEntryInfo->cryptAlgorithms[0]);
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->solid.chunkFile.info,{ Chunk_done(&archiveEntryInfo->solid.chunkFile.info); });
+
+  error = Chunk_init(&archiveEntryInfo->solid.chunkFileEntry.info,
+                     &archiveEntryInfo->solid.chunkFile.info,
+                     CHUNK_USE_PARENT,
+                     CHUNK_USE_PARENT,
+                     CHUNK_ID_FILE_ENTRY,
+                     CHUNK_DEFINITION_FILE_ENTRY,
+                     archiveEntryInfo->blockLength,
+                     &archiveEntryInfo->solid.chunkFileEntry.cryptInfo,
+                     &archiveEntryInfo->solid.chunkFileEntry
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->solid.chunkFileEntry.info,{ Chunk_done(&archiveEntryInfo->solid.chunkFileEntry.info); });
+
+  error = Chunk_init(&archiveEntryInfo->solid.chunkFileExtendedAttribute.info,
+                     &archiveEntryInfo->solid.chunkFile.info,
+                     CHUNK_USE_PARENT,
+                     CHUNK_USE_PARENT,
+                     CHUNK_ID_FILE_EXTENDED_ATTRIBUTE,
+                     CHUNK_DEFINITION_FILE_EXTENDED_ATTRIBUTE,
+                     archiveEntryInfo->blockLength,
+                     &archiveEntryInfo->solid.chunkFileExtendedAttribute.cryptInfo,
+                     &archiveEntryInfo->solid.chunkFileExtendedAttribute
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->solid.chunkFileExtendedAttribute.info,{ Chunk_done(&archiveEntryInfo->solid.chunkFileExtendedAttribute.info); });
 
-  error = Chunk_init(&archiveEntryInfo->special.chunkSpecialExtendedAttribute.info,
-                     &archiveEntryInfo->special.chunkSpecial.info,
+  error = Chunk_init(&archiveEntryInfo->solid.chunkFileSolid.info,
+                     &archiveEntryInfo->solid.chunkFile.info,
                      CHUNK_USE_PARENT,
                      CHUNK_USE_PARENT,
-                     CHUNK_ID_SPECIAL_EXTENDED_ATTRIBUTE,
-                     CHUNK_DEFINITION_SPECIAL_EXTENDED_ATTRIBUTE,
+                     CHUNK_ID_FILE_SOLID,
+                     CHUNK_DEFINITION_FILE_SOLID,
                      archiveEntryInfo->blockLength,
-                     &archiveEntryInfo->special.chunkSpecialExtendedAttribute.cryptInfo,
-                     &archiveEntryInfo->special.chunkSpecialExtendedAttribute
+                     &archiveEntryInfo->solid.chunkFileSolid.cryptInfo,
+                     &archiveEntryInfo->solid.chunkFileSolid
                     );
   if (error != ERROR_NONE)
   {
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->special.chunkSpecialExtendedAttribute.info,{ Chunk_done(&archiveEntryInfo->special.chunkSpecialExtendedAttribute.info); });
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->solid.chunkFileSolid.info,{ Chunk_done(&archiveEntryInfo->solid.chunkFileSolid.info); });
 
-  // calculate header length
-  ulong headerLength = Chunk_getSize(&archiveEntryInfo->special.chunkSpecial.info,     &archiveEntryInfo->special.chunkSpecial,     0)+
-                       Chunk_getSize(&archiveEntryInfo->special.chunkSpecialEntry.info,&archiveEntryInfo->special.chunkSpecialEntry,0);
-  const FileExtendedAttributeNode *fileExtendedAttributeNode;
-  LIST_ITERATE(fileExtendedAttributeList,fileExtendedAttributeNode)
+  // init byte compress (if no byte-compression is enabled, use identity-compressor)
+  error = Compress_init(&archiveEntryInfo->solid.byteCompressInfo,
+                        COMPRESS_MODE_DEFLATE,
+                        archiveEntryInfo->solid.byteCompressAlgorithm,
+                        archiveEntryInfo->blockLength,
+                        0,  // length (unknown)
+                        NULL  // deltaSourceHandle
+                       );
+  if (error != ERROR_NONE)
   {
-    String_set(archiveEntryInfo->special.chunkSpecialExtendedAttribute.name,fileExtendedAttributeNode->name);
-
-    headerLength += Chunk_getSize(&archiveEntryInfo->special.chunkSpecialExtendedAttribute.info,
-                                  &archiveEntryInfo->special.chunkSpecialExtendedAttribute,
-                                  fileExtendedAttributeNode->dataLength
-                                 );
+    AutoFree_cleanup(&autoFreeList);
+    return error;
   }
+  AUTOFREE_ADD(&autoFreeList,&archiveEntryInfo->solid.byteCompressInfo,{ Compress_done(&archiveEntryInfo->solid.byteCompressInfo); });
 
   // find next suitable archive part
   findNextArchivePart(archiveHandle);
 
-  if (!archiveHandle->dryRun)
+  // write solid block header
+  error = Chunk_create(&archiveEntryInfo->solid.chunkSolid.info);
+  if (error != ERROR_NONE)
   {
-    // lock archive (Note: special entries are created direct without intermediate file)
-    Semaphore_forceLock(&archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE);
-
-    // ensure space in archive
-    error = ensureArchiveSpace(archiveHandle,
-                               headerLength
-                              );
-    if (error != ERROR_NONE)
-    {
-      Semaphore_unlock(&archiveHandle->lock);
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-
-    // create new archive file (if not already created)
-    error = createArchiveFile(archiveHandle);
-    if (error != ERROR_NONE)
-    {
-      Semaphore_unlock(&archiveHandle->lock);
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-
-    // write special chunk
-    error = Chunk_create(&archiveEntryInfo->special.chunkSpecial.info);
-    if (error != ERROR_NONE)
-    {
-      Semaphore_unlock(&archiveHandle->lock);
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-
-    // write special entry chunk
-    error = Chunk_create(&archiveEntryInfo->special.chunkSpecialEntry.info);
-    if (error != ERROR_NONE)
-    {
-      Semaphore_unlock(&archiveHandle->lock);
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
-
-    // write extended attribute chunks
-    LIST_ITERATE(fileExtendedAttributeList,fileExtendedAttributeNode)
-    {
-      String_set(archiveEntryInfo->special.chunkSpecialExtendedAttribute.name,fileExtendedAttributeNode->name);
-      archiveEntryInfo->special.chunkSpecialExtendedAttribute.value.data   = fileExtendedAttributeNode->data;
-      archiveEntryInfo->special.chunkSpecialExtendedAttribute.value.length = fileExtendedAttributeNode->dataLength;
-
-      error = Chunk_create(&archiveEntryInfo->special.chunkSpecialExtendedAttribute.info);
-      if (error != ERROR_NONE)
-      {
-        break;
-      }
-      error = Chunk_close(&archiveEntryInfo->special.chunkSpecialExtendedAttribute.info);
-      if (error != ERROR_NONE)
-      {
-        break;
-      }
-    }
-    if (error != ERROR_NONE)
-    {
-      Semaphore_unlock(&archiveHandle->lock);
-      AutoFree_cleanup(&autoFreeList);
-      return error;
-    }
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  error = Chunk_create(&archiveEntryInfo->solid.chunkSolidData.info);
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
   }
 
   // done resources
@@ -9024,6 +12070,60 @@ CRYPT_KEY_DERIVE_FUNCTION,//
   return ERROR_NONE;
 }
 
+void Archive_addSolidEntryFile(ArchiveEntryInfo                *archiveEntryInfo,
+                               ConstString                     fileName,
+                               const FileInfo                  *fileInfo,
+                               const FileExtendedAttributeList *fileExtendedAttributeList
+                              )
+{
+  assert(archiveEntryInfo != NULL);
+  assert(archiveEntryInfo->archiveEntryType == ARCHIVE_ENTRY_TYPE_SOLID);
+  assert(fileName != NULL);
+  assert(fileInfo != NULL);
+
+  // get current offset in solid block data
+  uint64 offset = archiveEntryInfo->solid.dataLength;
+
+  // data of previous member is complete
+  if (archiveEntryInfo->solid.memberList.tail != NULL)
+  {
+    archiveEntryInfo->solid.memberList.tail->size = offset-archiveEntryInfo->solid.memberList.tail->offset;
+  }
+
+  // add member
+  ArchiveSolidMemberNode *archiveSolidMemberNode = LIST_NEW_NODE(ArchiveSolidMemberNode);
+  if (archiveSolidMemberNode == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  archiveSolidMemberNode->name     = String_duplicate(fileName);
+  archiveSolidMemberNode->fileInfo = (*fileInfo);
+  File_initExtendedAttributes(&archiveSolidMemberNode->fileExtendedAttributeList);
+  if (fileExtendedAttributeList != NULL)
+  {
+    const FileExtendedAttributeNode *fileExtendedAttributeNode;
+    LIST_ITERATE(fileExtendedAttributeList,fileExtendedAttributeNode)
+    {
+      File_addExtendedAttribute(&archiveSolidMemberNode->fileExtendedAttributeList,
+                                fileExtendedAttributeNode->name,
+                                fileExtendedAttributeNode->data,
+                                fileExtendedAttributeNode->dataLength
+                               );
+    }
+  }
+  archiveSolidMemberNode->offset   = offset;
+  archiveSolidMemberNode->size     = 0LL;
+  List_append(&archiveEntryInfo->solid.memberList,archiveSolidMemberNode);
+}
+
+uint64 Archive_getSolidEntrySize(const ArchiveEntryInfo *archiveEntryInfo)
+{
+  assert(archiveEntryInfo != NULL);
+  assert(archiveEntryInfo->archiveEntryType == ARCHIVE_ENTRY_TYPE_SOLID);
+
+  return archiveEntryInfo->solid.dataLength;
+}
+
 #ifdef NDEBUG
   Errors Archive_newMetaEntry(ArchiveEntryInfo *archiveEntryInfo,
                               ArchiveHandle    *archiveHandle,
@@ -9449,6 +12549,27 @@ Errors Archive_getNextArchiveEntry(ArchiveHandle     *archiveHandle,
       case CHUNK_ID_HARDLINK:
       case CHUNK_ID_SPECIAL:
       case CHUNK_ID_SIGNATURE:
+        scanMode = FALSE;
+        break;
+      case CHUNK_ID_SOLID:
+        // skip solid block (data is read via file entries)
+        error = Chunk_skip(archiveHandle->chunkIO,archiveHandle->chunkIOUserData,&chunkHeader);
+        if (error != ERROR_NONE)
+        {
+          return error;
+        }
+
+        scanMode = FALSE;
+        break;
+      case CHUNK_ID_TOC:
+      case CHUNK_ID_TOC_LOCATOR:
+        // skip table of contents (read via Archive_readTOC())
+        error = Chunk_skip(archiveHandle->chunkIO,archiveHandle->chunkIOUserData,&chunkHeader);
+        if (error != ERROR_NONE)
+        {
+          return error;
+        }
+
         scanMode = FALSE;
         break;
       default:
@@ -9922,6 +13043,8 @@ Errors Archive_skipNextEntry(ArchiveHandle *archiveHandle)
                                String                    fileName,
                                FileInfo                  *fileInfo,
                                FileExtendedAttributeList *fileExtendedAttributeList,
+                               FileHoleList              *fileHoleList,
+                               String                    referenceName,
                                String                    deltaSourceName,
                                uint64                    *deltaSourceSize,
                                uint64                    *fragmentOffset,
@@ -9941,6 +13064,8 @@ Errors Archive_skipNextEntry(ArchiveHandle *archiveHandle)
                                  String                    fileName,
                                  FileInfo                  *fileInfo,
                                  FileExtendedAttributeList *fileExtendedAttributeList,
+                                 FileHoleList              *fileHoleList,
+                                 String                    referenceName,
                                  String                    deltaSourceName,
                                  uint64                    *deltaSourceSize,
                                  uint64                    *fragmentOffset,
@@ -9977,8 +13102,10 @@ Errors Archive_skipNextEntry(ArchiveHandle *archiveHandle)
   archiveEntryInfo->archiveEntryType               = ARCHIVE_ENTRY_TYPE_FILE;
 
   archiveEntryInfo->file.fileExtendedAttributeList = fileExtendedAttributeList;
+  archiveEntryInfo->file.fileHoleList              = fileHoleList;
 
   archiveEntryInfo->file.deltaSourceHandleInitFlag = FALSE;
+  archiveEntryInfo->file.solidFlag                 = FALSE;
 
   archiveEntryInfo->file.byteBuffer                = NULL;
   archiveEntryInfo->file.byteBufferSize            = 0L;
@@ -10142,6 +13269,8 @@ Errors Archive_skipNextEntry(ArchiveHandle *archiveHandle)
     // reset
     AutoFree_freeAll(&autoFreeList2);
     error = Chunk_seek(&archiveEntryInfo->file.chunkFile.info,index);
+    archiveEntryInfo->file.solidFlag = FALSE;
+    if (referenceName != NULL) String_clear(referenceName);
 
     // check decrypt key (if encrypted)
 //TODO: multi-crypt
@@ -10204,6 +13333,45 @@ NULL//                             password
       }
     }
     if (error == ERROR_NONE)
+    {
+      error = Crypt_init(&archiveEntryInfo->file.chunkFileHole.cryptInfo,
+                         archiveEntryInfo->cryptAlgorithms[0],
+                         archiveHandle->archiveCryptInfo->cryptMode|CRYPT_MODE_CBC_,
+                         &archiveHandle->archiveCryptInfo->cryptSalt,
+                         decryptKey
+                        );
+      if (error == ERROR_NONE)
+      {
+        AUTOFREE_ADD(&autoFreeList2,&archiveEntryInfo->file.chunkFileHole.cryptInfo,{ Crypt_done(&archiveEntryInfo->file.chunkFileHole.cryptInfo); });
+      }
+    }
+    if (error == ERROR_NONE)
+    {
+      error = Crypt_init(&archiveEntryInfo->file.chunkFileReference.cryptInfo,
+                         archiveEntryInfo->cryptAlgorithms[0],
+                         archiveHandle->archiveCryptInfo->cryptMode|CRYPT_MODE_CBC_,
+                         &archiveHandle->archiveCryptInfo->cryptSalt,
+                         decryptKey
+                        );
+      if (error == ERROR_NONE)
+      {
+        AUTOFREE_ADD(&autoFreeList2,&archiveEntryInfo->file.chunkFileReference.cryptInfo,{ Crypt_done(&archiveEntryInfo->file.chunkFileReference.cryptInfo); });
+      }
+    }
+    if (error == ERROR_NONE)
+    {
+      error = Crypt_init(&archiveEntryInfo->file.chunkFileSolid.cryptInfo,
+                         archiveEntryInfo->cryptAlgorithms[0],
+                         archiveHandle->archiveCryptInfo->cryptMode|CRYPT_MODE_CBC_,
+                         &archiveHandle->archiveCryptInfo->cryptSalt,
+                         decryptKey
+                        );
+      if (error == ERROR_NONE)
+      {
+        AUTOFREE_ADD(&autoFreeList2,&archiveEntryInfo->file.chunkFileSolid.cryptInfo,{ Crypt_done(&archiveEntryInfo->file.chunkFileSolid.cryptInfo); });
+      }
+    }
+    if (error == ERROR_NONE)
     {
       error = Crypt_init(&archiveEntryInfo->file.chunkFileData.cryptInfo,
                          archiveEntryInfo->cryptAlgorithms[0],
@@ -10283,6 +13451,57 @@ NULL//                             password
       }
     }
     if (error == ERROR_NONE)
+    {
+      error = Chunk_init(&archiveEntryInfo->file.chunkFileHole.info,
+                         &archiveEntryInfo->file.chunkFile.info,
+                         CHUNK_USE_PARENT,
+                         CHUNK_USE_PARENT,
+                         CHUNK_ID_FILE_HOLE,
+                         CHUNK_DEFINITION_FILE_HOLE,
+                         archiveEntryInfo->blockLength,
+                         &archiveEntryInfo->file.chunkFileHole.cryptInfo,
+                         &archiveEntryInfo->file.chunkFileHole
+                        );
+      if (error == ERROR_NONE)
+      {
+        AUTOFREE_ADD(&autoFreeList2,&archiveEntryInfo->file.chunkFileHole.info,{ Chunk_done(&archiveEntryInfo->file.chunkFileHole.info); });
+      }
+    }
+    if (error == ERROR_NONE)
+    {
+      error = Chunk_init(&archiveEntryInfo->file.chunkFileReference.info,
+                         &archiveEntryInfo->file.chunkFile.info,
+                         CHUNK_USE_PARENT,
+                         CHUNK_USE_PARENT,
+                         CHUNK_ID_FILE_REFERENCE,
+                         CHUNK_DEFINITION_FILE_REFERENCE,
+                         archiveEntryInfo->blockLength,
+                         &archiveEntryInfo->file.chunkFileReference.cryptInfo,
+                         &archiveEntryInfo->file.chunkFileReference
+                        );
+      if (error == ERROR_NONE)
+      {
+        AUTOFREE_ADD(&autoFreeList2,&archiveEntryInfo->file.chunkFileReference.info,{ Chunk_done(&archiveEntryInfo->file.chunkFileReference.info); });
+      }
+    }
+    if (error == ERROR_NONE)
+    {
+      error = Chunk_init(&archiveEntryInfo->file.chunkFileSolid.info,
+                         &archiveEntryInfo->file.chunkFile.info,
+                         CHUNK_USE_PARENT,
+                         CHUNK_USE_PARENT,
+                         CHUNK_ID_FILE_SOLID,
+                         CHUNK_DEFINITION_FILE_SOLID,
+                         archiveEntryInfo->blockLength,
+                         &archiveEntryInfo->file.chunkFileSolid.cryptInfo,
+                         &archiveEntryInfo->file.chunkFileSolid
+                        );
+      if (error == ERROR_NONE)
+      {
+        AUTOFREE_ADD(&autoFreeList2,&archiveEntryInfo->file.chunkFileSolid.info,{ Chunk_done(&archiveEntryInfo->file.chunkFileSolid.info); });
+      }
+    }
+    if (error == ERROR_NONE)
     {
       error = Chunk_init(&archiveEntryInfo->file.chunkFileData.info,
                          &archiveEntryInfo->file.chunkFile.info,
@@ -10296,6 +13515,7 @@ NULL//                             password
                         );
       if (error == ERROR_NONE)
       {
+        Chunk_setDataCrypt(&archiveEntryInfo->file.chunkFileData.info,&archiveEntryInfo->file.cryptInfo);
         AUTOFREE_ADD(&autoFreeList2,&archiveEntryInfo->file.chunkFileData.info,{ Chunk_done(&archiveEntryInfo->file.chunkFileData.info); });
       }
     }
@@ -10406,16 +13626,73 @@ NULL//                             password
                 || !Compress_isDeltaCompressed(archiveEntryInfo->file.deltaCompressAlgorithm)
                )
             {
-              (void)Chunk_close(&archiveEntryInfo->file.chunkFileDelta.info);
-              error = ERROR_INVALID_COMPRESS_ALGORITHM;
+              (void)Chunk_close(&archiveEntryInfo->file.chunkFileDelta.info);
+              error = ERROR_INVALID_COMPRESS_ALGORITHM;
+              break;
+            }
+// TODO: encoding
+            if (deltaSourceName != NULL) String_set(deltaSourceName,archiveEntryInfo->file.chunkFileDelta.name);
+            if (deltaSourceSize != NULL) (*deltaSourceSize) = archiveEntryInfo->file.chunkFileDelta.size;
+
+            // close file delta chunk
+            error = Chunk_close(&archiveEntryInfo->file.chunkFileDelta.info);
+            if (error != ERROR_NONE)
+            {
+              break;
+            }
+            break;
+          case CHUNK_ID_FILE_HOLE:
+            if (fileHoleList != NULL)
+            {
+              // read file hole chunk
+              error = Chunk_open(&archiveEntryInfo->file.chunkFileHole.info,
+                                 &subChunkHeader,
+                                 subChunkHeader.size,
+                                 archiveHandle
+                                );
+              if (error != ERROR_NONE)
+              {
+                break;
+              }
+
+              // add hole to list
+              File_addHole(fileHoleList,
+                           archiveEntryInfo->file.chunkFileHole.offset,
+                           archiveEntryInfo->file.chunkFileHole.size
+                          );
+
+              // close file hole chunk
+              error = Chunk_close(&archiveEntryInfo->file.chunkFileHole.info);
+              if (error != ERROR_NONE)
+              {
+                break;
+              }
+            }
+            else
+            {
+              // skip file hole chunk
+              error = Chunk_skipSub(&archiveEntryInfo->file.chunkFile.info,&subChunkHeader);
+              if (error != ERROR_NONE)
+              {
+                break;
+              }
+            }
+            break;
+          case CHUNK_ID_FILE_REFERENCE:
+            // read file reference chunk
+            error = Chunk_open(&archiveEntryInfo->file.chunkFileReference.info,
+                               &subChunkHeader,
+                               subChunkHeader.size,
+                               archiveHandle
+                              );
+            if (error != ERROR_NONE)
+            {
               break;
             }
-// TODO: encoding
-            if (deltaSourceName != NULL) String_set(deltaSourceName,archiveEntryInfo->file.chunkFileDelta.name);
-            if (deltaSourceSize != NULL) (*deltaSourceSize) = archiveEntryInfo->file.chunkFileDelta.size;
+            if (referenceName != NULL) String_set(referenceName,archiveEntryInfo->file.chunkFileReference.name);
 
-            // close file delta chunk
-            error = Chunk_close(&archiveEntryInfo->file.chunkFileDelta.info);
+            // close file reference chunk
+            error = Chunk_close(&archiveEntryInfo->file.chunkFileReference.info);
             if (error != ERROR_NONE)
             {
               break;
@@ -10439,6 +13716,37 @@ NULL//                             password
             if (fragmentOffset != NULL) (*fragmentOffset) = archiveEntryInfo->file.chunkFileData.fragmentOffset;
             if (fragmentSize   != NULL) (*fragmentSize)   = archiveEntryInfo->file.chunkFileData.fragmentSize;
 
+            foundFileDataFlag = TRUE;
+            break;
+          case CHUNK_ID_FILE_SOLID:
+            // read file solid chunk
+            error = Chunk_open(&archiveEntryInfo->file.chunkFileSolid.info,
+                               &subChunkHeader,
+                               subChunkHeader.size,
+                               archiveHandle
+                              );
+            if (error != ERROR_NONE)
+            {
+              break;
+            }
+            error = Chunk_close(&archiveEntryInfo->file.chunkFileSolid.info);
+            if (error != ERROR_NONE)
+            {
+              break;
+            }
+
+            // open data of solid block (Note: kept open in archive handle for following members)
+            error = openSolidData(archiveEntryInfo,archiveHandle,decryptKey);
+            if (error != ERROR_NONE)
+            {
+              break;
+            }
+            archiveEntryInfo->file.solidFlag = TRUE;
+
+            // get data meta data (Note: file data is always complete in a solid block)
+            if (fragmentOffset != NULL) (*fragmentOffset) = 0LL;
+            if (fragmentSize   != NULL) (*fragmentSize)   = archiveEntryInfo->file.chunkFileSolid.size;
+
             foundFileDataFlag = TRUE;
             break;
           default:
@@ -10535,6 +13843,18 @@ NULL//                             password
   }
   AUTOFREE_ADD(&autoFreeList1,&archiveEntryInfo->file.byteCompressInfo,{ Compress_done(&archiveEntryInfo->file.byteCompressInfo); });
 
+  // skip data of preceding files in solid block
+  if (archiveEntryInfo->file.solidFlag)
+  {
+    error = skipSolidData(archiveEntryInfo);
+    if (error != ERROR_NONE)
+    {
+      archiveHandle->pendingError = Chunk_skip(archiveHandle->chunkIO,archiveHandle->chunkIOUserData,&chunkHeader);
+      AutoFree_cleanup(&autoFreeList1);
+      return error;
+    }
+  }
+
   // init variables
   if (deltaCompressAlgorithm != NULL) (*deltaCompressAlgorithm) = archiveEntryInfo->file.deltaCompressAlgorithm;
   if (byteCompressAlgorithm  != NULL) (*byteCompressAlgorithm)  = archiveEntryInfo->file.byteCompressAlgorithm;
@@ -10894,6 +14214,7 @@ NULL//                             password
                         );
       if (error == ERROR_NONE)
       {
+        Chunk_setDataCrypt(&archiveEntryInfo->image.chunkImageData.info,&archiveEntryInfo->image.cryptInfo);
         AUTOFREE_ADD(&autoFreeList2,&archiveEntryInfo->image.chunkImageData.info,{ Chunk_done(&archiveEntryInfo->image.chunkImageData.info); });
       }
     }
@@ -11966,6 +15287,7 @@ NULL//                             password
                                    StringList                *fileNameList,
                                    FileInfo                  *fileInfo,
                                    FileExtendedAttributeList *fileExtendedAttributeList,
+                                   FileHoleList              *fileHoleList,
                                    String                    deltaSourceName,
                                    uint64                    *deltaSourceSize,
                                    uint64                    *fragmentOffset,
@@ -11985,6 +15307,7 @@ NULL//                             password
                                      StringList                *fileNameList,
                                      FileInfo                  *fileInfo,
                                      FileExtendedAttributeList *fileExtendedAttributeList,
+                                     FileHoleList              *fileHoleList,
                                      String                    deltaSourceName,
                                      uint64                    *deltaSourceSize,
                                      uint64                    *fragmentOffset,
@@ -12021,6 +15344,7 @@ NULL//                             password
 
   archiveEntryInfo->hardLink.fileNameList              = fileNameList;
   archiveEntryInfo->hardLink.fileExtendedAttributeList = fileExtendedAttributeList;
+  archiveEntryInfo->hardLink.fileHoleList              = fileHoleList;
 
   archiveEntryInfo->hardLink.deltaSourceHandleInitFlag = FALSE;
 
@@ -12250,6 +15574,19 @@ NULL//                             password
       }
     }
     if (error == ERROR_NONE)
+    {
+      error = Crypt_init(&archiveEntryInfo->hardLink.chunkHardLinkHole.cryptInfo,
+                         archiveEntryInfo->cryptAlgorithms[0],
+                         archiveHandle->archiveCryptInfo->cryptMode|CRYPT_MODE_CBC_,
+                         &archiveHandle->archiveCryptInfo->cryptSalt,
+                         decryptKey
+                        );
+      if (error == ERROR_NONE)
+      {
+        AUTOFREE_ADD(&autoFreeList2,&archiveEntryInfo->hardLink.chunkHardLinkHole.cryptInfo,{ Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkHole.cryptInfo); });
+      }
+    }
+    if (error == ERROR_NONE)
     {
       error = Crypt_init(&archiveEntryInfo->hardLink.chunkHardLinkData.cryptInfo,
                          archiveEntryInfo->cryptAlgorithms[0],
@@ -12346,6 +15683,23 @@ NULL//                             password
       }
     }
     if (error == ERROR_NONE)
+    {
+      error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLinkHole.info,
+                         &archiveEntryInfo->hardLink.chunkHardLink.info,
+                         CHUNK_USE_PARENT,
+                         CHUNK_USE_PARENT,
+                         CHUNK_ID_HARDLINK_HOLE,
+                         CHUNK_DEFINITION_HARDLINK_HOLE,
+                         archiveEntryInfo->blockLength,
+                         &archiveEntryInfo->hardLink.chunkHardLinkHole.cryptInfo,
+                         &archiveEntryInfo->hardLink.chunkHardLinkHole
+                        );
+      if (error == ERROR_NONE)
+      {
+        AUTOFREE_ADD(&autoFreeList2,&archiveEntryInfo->hardLink.chunkHardLinkHole.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkHole.info); });
+      }
+    }
+    if (error == ERROR_NONE)
     {
       error = Chunk_init(&archiveEntryInfo->hardLink.chunkHardLinkData.info,
                          &archiveEntryInfo->hardLink.chunkHardLink.info,
@@ -12359,6 +15713,7 @@ NULL//                             password
                         );
       if (error == ERROR_NONE)
       {
+        Chunk_setDataCrypt(&archiveEntryInfo->hardLink.chunkHardLinkData.info,&archiveEntryInfo->hardLink.cryptInfo);
         AUTOFREE_ADD(&autoFreeList2,&archiveEntryInfo->hardLink.chunkHardLinkData.info,{ Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkData.info); });
       }
     }
@@ -12505,6 +15860,43 @@ NULL//                             password
               break;
             }
             break;
+          case CHUNK_ID_HARDLINK_HOLE:
+            if (fileHoleList != NULL)
+            {
+              // read hard link hole chunk
+              error = Chunk_open(&archiveEntryInfo->hardLink.chunkHardLinkHole.info,
+                                 &subChunkHeader,
+                                 subChunkHeader.size,
+                                 archiveHandle
+                                );
+              if (error != ERROR_NONE)
+              {
+                break;
+              }
+
+              // add hole to list
+              File_addHole(fileHoleList,
+                           archiveEntryInfo->hardLink.chunkHardLinkHole.offset,
+                           archiveEntryInfo->hardLink.chunkHardLinkHole.size
+                          );
+
+              // close hard link hole chunk
+              error = Chunk_close(&archiveEntryInfo->hardLink.chunkHardLinkHole.info);
+              if (error != ERROR_NONE)
+              {
+                break;
+              }
+            }
+            else
+            {
+              // skip hard link hole chunk
+              error = Chunk_skipSub(&archiveEntryInfo->hardLink.chunkHardLink.info,&subChunkHeader);
+              if (error != ERROR_NONE)
+              {
+                break;
+              }
+            }
+            break;
           case CHUNK_ID_HARDLINK_DATA:
             // read hard link data chunk (only header)
             assert(Chunk_getSize(&archiveEntryInfo->hardLink.chunkHardLinkData.info,NULL,0) == ALIGN(CHUNK_FIXED_SIZE_HARDLINK_DATA,archiveEntryInfo->hardLink.chunkHardLinkData.info.alignment));
@@ -13109,6 +16501,14 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
   }
   while (chunkHeader.id != CHUNK_ID_SIGNATURE);
 
+  // check if signature public key is available
+  if (!Configuration_isKeyAvailable(&globalOptions.signaturePublicKey))
+  {
+    archiveHandle->pendingError = Chunk_skip(archiveHandle->chunkIO,archiveHandle->chunkIOUserData,&chunkHeader);
+    AutoFree_cleanup(&autoFreeList);
+    return ERROR_NO_PUBLIC_SIGNATURE_KEY;
+  }
+
   // init signature chunk
   ChunkSignature chunkSignature;
   error = Chunk_init(&chunkSignature.info,
@@ -13158,40 +16558,23 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
     return ERROR_UNKNOWN_HASH_ALGORITHM;
   }
 
-  // init signature hash
-  CryptHash signatureHash;
-  error = Crypt_initHash(&signatureHash,SIGNATURE_HASH_ALGORITHM);
-  if (error != ERROR_NONE)
-  {
-    archiveHandle->pendingError = Chunk_skip(archiveHandle->chunkIO,archiveHandle->chunkIOUserData,&chunkHeader);
-    Chunk_close(&chunkSignature.info);
-    AutoFree_cleanup(&autoFreeList);
-    return error;
-  }
-  AUTOFREE_ADD(&autoFreeList,&signatureHash,{ Crypt_doneHash(&signatureHash); });
-
   // get signature hash
-  error = calculateHash(archiveHandle->chunkIO,
-                        archiveHandle->chunkIOUserData,
-                        &signatureHash,
-                        offset,
-                        chunkSignature.info.offset
-                       );
+  byte hash[MAX_HASH_SIZE];
+  uint hashLength;
+  error = calculateSignatureHash(archiveHandle,
+                                 offset,
+                                 chunkSignature.info.offset,
+                                 hash,
+                                 sizeof(hash),
+                                 &hashLength
+                                );
   if (error != ERROR_NONE)
   {
     archiveHandle->pendingError = Chunk_skip(archiveHandle->chunkIO,archiveHandle->chunkIOUserData,&chunkHeader);
-    Crypt_doneHash(&signatureHash);
     Chunk_close(&chunkSignature.info);
     AutoFree_cleanup(&autoFreeList);
     return error;
   }
-  byte hash[MAX_HASH_SIZE];
-  uint hashLength;
-  (void)Crypt_getHash(&signatureHash,hash,sizeof(hash),&hashLength);
-
-  // done signature hash
-  AUTOFREE_REMOVE(&autoFreeList,&signatureHash);
-  Crypt_doneHash(&signatureHash);
 
   // verify signature
   CryptKey publicSignatureKey;
@@ -13226,6 +16609,9 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
   // close chunk
   Chunk_close(&chunkSignature.info);
 
+  // restart signature hash for next signed data
+  restartReadSignatureHash(archiveHandle,Chunk_endOffset(&chunkSignature.info));
+
   // free resources
   Chunk_done(&chunkSignature.info);
   AutoFree_done(&autoFreeList);
@@ -13319,7 +16705,10 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
               if (archiveEntryInfo->file.headerWrittenFlag)
               {
                 // update fragment size
-                archiveEntryInfo->file.chunkFileData.fragmentSize = Compress_getInputLength(&archiveEntryInfo->file.deltaCompressInfo);
+                archiveEntryInfo->file.chunkFileData.fragmentSize = getFragmentSize(archiveEntryInfo->file.fileHoleList,
+                                                                                    archiveEntryInfo->file.chunkFileData.fragmentOffset,
+                                                                                    Compress_getInputLength(&archiveEntryInfo->file.deltaCompressInfo)
+                                                                                   );
                 Errors tmpError = Chunk_update(&archiveEntryInfo->file.chunkFileData.info);
                 if ((error == ERROR_NONE) && (tmpError != ERROR_NONE)) error = tmpError;
 
@@ -13333,6 +16722,7 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
               }
 
               // transfer to archive
+              uint64 offset = 0LL;
               SEMAPHORE_LOCKED_DO(&archiveEntryInfo->archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
               {
                 // create archive file (if not already created)
@@ -13346,7 +16736,8 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
 
                 // transfer intermediate data into archive
                 tmpError = transferToArchive(archiveEntryInfo->archiveHandle,
-                                             &archiveEntryInfo->file.intermediateFileHandle
+                                             &archiveEntryInfo->file.intermediateFileHandle,
+                                             &offset
                                             );
                 if (tmpError != ERROR_NONE)
                 {
@@ -13354,6 +16745,12 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
                   Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
                   break;
                 }
+
+                // add to table of contents (Note: nothing written if last fragment is empty)
+                if (archiveEntryInfo->file.headerWrittenFlag)
+                {
+                  addTOCEntries(archiveEntryInfo,offset);
+                }
               }
 
               // store in index database
@@ -13372,7 +16769,8 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
                                        archiveEntryInfo->file.chunkFileEntry.groupId,
                                        archiveEntryInfo->file.chunkFileEntry.permissions,
                                        archiveEntryInfo->file.chunkFileData.fragmentOffset,
-                                       archiveEntryInfo->file.chunkFileData.fragmentSize
+                                       archiveEntryInfo->file.chunkFileData.fragmentSize,
+                                       offset
                                       );
                 }
               }
@@ -13383,12 +16781,16 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
             Compress_done(&archiveEntryInfo->file.deltaCompressInfo);
 
             Chunk_done(&archiveEntryInfo->file.chunkFileData.info);
+            Chunk_done(&archiveEntryInfo->file.chunkFileReference.info);
+            Chunk_done(&archiveEntryInfo->file.chunkFileHole.info);
             Chunk_done(&archiveEntryInfo->file.chunkFileDelta.info);
             Chunk_done(&archiveEntryInfo->file.chunkFileExtendedAttribute.info);
             Chunk_done(&archiveEntryInfo->file.chunkFileEntry.info);
 
             Crypt_done(&archiveEntryInfo->file.cryptInfo);
             Crypt_done(&archiveEntryInfo->file.chunkFileData.cryptInfo);
+            Crypt_done(&archiveEntryInfo->file.chunkFileReference.cryptInfo);
+            Crypt_done(&archiveEntryInfo->file.chunkFileHole.cryptInfo);
             Crypt_done(&archiveEntryInfo->file.chunkFileDelta.cryptInfo);
             Crypt_done(&archiveEntryInfo->file.chunkFileExtendedAttribute.cryptInfo);
             Crypt_done(&archiveEntryInfo->file.chunkFileEntry.cryptInfo);
@@ -13481,6 +16883,7 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
               }
 
               // transfer to archive
+              uint64 offset = 0LL;
               SEMAPHORE_LOCKED_DO(&archiveEntryInfo->archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
               {
                 // create archive file (if not already created)
@@ -13495,7 +16898,8 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
 
                 // transfer intermediate data into archive
                 tmpError = transferToArchive(archiveEntryInfo->archiveHandle,
-                                             &archiveEntryInfo->image.intermediateFileHandle
+                                             &archiveEntryInfo->image.intermediateFileHandle,
+                                             &offset
                                             );
                 if (tmpError != ERROR_NONE)
                 {
@@ -13503,6 +16907,12 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
                   Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
                   break;
                 }
+
+                // add to table of contents (Note: nothing written if last fragment is empty)
+                if (archiveEntryInfo->image.headerWrittenFlag)
+                {
+                  addTOCEntries(archiveEntryInfo,offset);
+                }
               }
 
               // store in index database
@@ -13517,7 +16927,8 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
                                         archiveEntryInfo->image.chunkImageEntry.size,
                                         archiveEntryInfo->image.chunkImageEntry.blockSize,
                                         archiveEntryInfo->image.chunkImageData.blockOffset,
-                                        archiveEntryInfo->image.chunkImageData.blockCount
+                                        archiveEntryInfo->image.chunkImageData.blockCount,
+                                        offset
                                        );
                 }
               }
@@ -13565,6 +16976,12 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
               tmpError = Chunk_close(&archiveEntryInfo->directory.chunkDirectory.info);
               if ((error == ERROR_NONE) && (tmpError != ERROR_NONE)) error = tmpError;
 
+              // add to table of contents
+              if (error == ERROR_NONE)
+              {
+                addTOCEntries(archiveEntryInfo,archiveEntryInfo->directory.chunkDirectory.info.offset);
+              }
+
               // unlock archive
               Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
 
@@ -13581,7 +16998,8 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
                                             archiveEntryInfo->directory.chunkDirectoryEntry.timeLastChanged,
                                             archiveEntryInfo->directory.chunkDirectoryEntry.userId,
                                             archiveEntryInfo->directory.chunkDirectoryEntry.groupId,
-                                            archiveEntryInfo->directory.chunkDirectoryEntry.permissions
+                                            archiveEntryInfo->directory.chunkDirectoryEntry.permissions,
+                                            archiveEntryInfo->directory.chunkDirectory.info.offset
                                            );
                 }
               }
@@ -13607,6 +17025,12 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
               tmpError = Chunk_close(&archiveEntryInfo->link.chunkLink.info);
               if ((error == ERROR_NONE) && (tmpError != ERROR_NONE)) error = tmpError;
 
+              // add to table of contents
+              if (error == ERROR_NONE)
+              {
+                addTOCEntries(archiveEntryInfo,archiveEntryInfo->link.chunkLink.info.offset);
+              }
+
               // unlock archive
               Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
 
@@ -13623,7 +17047,8 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
                                        archiveEntryInfo->link.chunkLinkEntry.timeLastChanged,
                                        archiveEntryInfo->link.chunkLinkEntry.userId,
                                        archiveEntryInfo->link.chunkLinkEntry.groupId,
-                                       archiveEntryInfo->link.chunkLinkEntry.permissions
+                                       archiveEntryInfo->link.chunkLinkEntry.permissions,
+                                       archiveEntryInfo->link.chunkLink.info.offset
                                       );
                 }
               }
@@ -13696,7 +17121,10 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
               if (archiveEntryInfo->hardLink.headerWrittenFlag)
               {
                 // update fragment size
-                archiveEntryInfo->hardLink.chunkHardLinkData.fragmentSize = Compress_getInputLength(&archiveEntryInfo->hardLink.deltaCompressInfo);
+                archiveEntryInfo->hardLink.chunkHardLinkData.fragmentSize = getFragmentSize(archiveEntryInfo->hardLink.fileHoleList,
+                                                                                            archiveEntryInfo->hardLink.chunkHardLinkData.fragmentOffset,
+                                                                                            Compress_getInputLength(&archiveEntryInfo->hardLink.deltaCompressInfo)
+                                                                                           );
                 Errors tmpError = Chunk_update(&archiveEntryInfo->hardLink.chunkHardLinkData.info);
                 if ((error == ERROR_NONE) && (tmpError != ERROR_NONE)) error = tmpError;
 
@@ -13710,6 +17138,7 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
               }
 
               // transfer to archive
+              uint64 offset = 0LL;
               SEMAPHORE_LOCKED_DO(&archiveEntryInfo->archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
               {
                 // create archive file (if not already created)
@@ -13723,7 +17152,8 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
 
                 // transfer intermediate data into archive
                 tmpError = transferToArchive(archiveEntryInfo->archiveHandle,
-                                             &archiveEntryInfo->hardLink.intermediateFileHandle
+                                             &archiveEntryInfo->hardLink.intermediateFileHandle,
+                                             &offset
                                             );
                 if (tmpError != ERROR_NONE)
                 {
@@ -13731,6 +17161,12 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
                   Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
                   break;
                 }
+
+                // add to table of contents (Note: nothing written if last fragment is empty)
+                if (archiveEntryInfo->hardLink.headerWrittenFlag)
+                {
+                  addTOCEntries(archiveEntryInfo,offset);
+                }
               }
 
               // store in index database
@@ -13751,7 +17187,8 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
                                              archiveEntryInfo->hardLink.chunkHardLinkEntry.groupId,
                                              archiveEntryInfo->hardLink.chunkHardLinkEntry.permissions,
                                              archiveEntryInfo->hardLink.chunkHardLinkData.fragmentOffset,
-                                             archiveEntryInfo->hardLink.chunkHardLinkData.fragmentSize
+                                             archiveEntryInfo->hardLink.chunkHardLinkData.fragmentSize,
+                                             offset
                                             );
                   }
                 }
@@ -13763,6 +17200,7 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
             Compress_done(&archiveEntryInfo->hardLink.deltaCompressInfo);
 
             Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkData.info);
+            Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkHole.info);
             Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkDelta.info);
             Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkName.info);
             Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.info);
@@ -13770,6 +17208,7 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
 
             Crypt_done(&archiveEntryInfo->hardLink.cryptInfo);
             Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkData.cryptInfo);
+            Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkHole.cryptInfo);
             Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkDelta.cryptInfo);
             Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkName.cryptInfo);
             Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.cryptInfo);
@@ -13800,6 +17239,12 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
               tmpError = Chunk_close(&archiveEntryInfo->special.chunkSpecial.info);
               if ((error == ERROR_NONE) && (tmpError != ERROR_NONE)) error = tmpError;
 
+              // add to table of contents
+              if (error == ERROR_NONE)
+              {
+                addTOCEntries(archiveEntryInfo,archiveEntryInfo->special.chunkSpecial.info.offset);
+              }
+
               // unlock archive
               Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
 
@@ -13818,7 +17263,8 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
                                           archiveEntryInfo->special.chunkSpecialEntry.groupId,
                                           archiveEntryInfo->special.chunkSpecialEntry.permissions,
                                           archiveEntryInfo->special.chunkSpecialEntry.major,
-                                          archiveEntryInfo->special.chunkSpecialEntry.minor
+                                          archiveEntryInfo->special.chunkSpecialEntry.minor,
+                                          archiveEntryInfo->special.chunkSpecial.info.offset
                                          );
                 }
               }
@@ -13834,6 +17280,135 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
             Chunk_done(&archiveEntryInfo->special.chunkSpecial.info);
           }
           break;
+        case ARCHIVE_ENTRY_TYPE_SOLID:
+          {
+            if (!archiveEntryInfo->archiveHandle->dryRun)
+            {
+              // data of last member is complete
+              if (archiveEntryInfo->solid.memberList.tail != NULL)
+              {
+                archiveEntryInfo->solid.memberList.tail->size = archiveEntryInfo->solid.dataLength-archiveEntryInfo->solid.memberList.tail->offset;
+              }
+
+              // flush byte compress
+              error = Compress_flush(&archiveEntryInfo->solid.byteCompressInfo);
+              if (error == ERROR_NONE)
+              {
+                error = flushSolidDataBlocks(archiveEntryInfo,COMPRESS_BLOCK_TYPE_ANY);
+              }
+
+              // update fragment size
+              archiveEntryInfo->solid.chunkSolidData.fragmentSize = archiveEntryInfo->solid.dataLength;
+              Errors tmpError = Chunk_update(&archiveEntryInfo->solid.chunkSolidData.info);
+              if ((error == ERROR_NONE) && (tmpError != ERROR_NONE)) error = tmpError;
+
+              // close chunks
+              tmpError = Chunk_close(&archiveEntryInfo->solid.chunkSolidData.info);
+              if ((error == ERROR_NONE) && (tmpError != ERROR_NONE)) error = tmpError;
+              tmpError = Chunk_close(&archiveEntryInfo->solid.chunkSolid.info);
+              if ((error == ERROR_NONE) && (tmpError != ERROR_NONE)) error = tmpError;
+
+              // write file chunks of members
+              ArchiveSolidMemberNode *archiveSolidMemberNode = archiveEntryInfo->solid.memberList.head;
+              while ((error == ERROR_NONE) && (archiveSolidMemberNode != NULL))
+              {
+                error = writeSolidMemberChunks(archiveEntryInfo,archiveSolidMemberNode);
+                archiveSolidMemberNode->chunkOffset = archiveEntryInfo->solid.chunkFile.info.offset;
+                archiveSolidMemberNode = archiveSolidMemberNode->next;
+              }
+
+              // transfer to archive (Note: solid block is never split into parts)
+              uint64 offset = 0LL;
+              if (error == ERROR_NONE)
+              {
+                SEMAPHORE_LOCKED_DO(&archiveEntryInfo->archiveHandle->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+                {
+                  // ensure space in archive: start new part if solid block does not fit into current part
+                  tmpError = ensureArchiveSpace(archiveEntryInfo->archiveHandle,
+                                                (ulong)File_getSize(&archiveEntryInfo->solid.intermediateFileHandle)
+                                               );
+                  if (tmpError != ERROR_NONE)
+                  {
+                    error = tmpError;
+                    Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+                    break;
+                  }
+
+                  // create archive file (if not already created)
+                  tmpError = createArchiveFile(archiveEntryInfo->archiveHandle);
+                  if (tmpError != ERROR_NONE)
+                  {
+                    error = tmpError;
+                    Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+                    break;
+                  }
+
+                  // transfer intermediate data into archive
+                  tmpError = transferToArchive(archiveEntryInfo->archiveHandle,
+                                               &archiveEntryInfo->solid.intermediateFileHandle,
+                                               &offset
+                                              );
+                  if (tmpError != ERROR_NONE)
+                  {
+                    error = tmpError;
+                    Semaphore_unlock(&archiveEntryInfo->archiveHandle->lock);
+                    break;
+                  }
+
+                  // add to table of contents
+                  addTOCEntries(archiveEntryInfo,offset);
+                }
+              }
+
+              // store in index database
+              if (   (error == ERROR_NONE)
+                  && Index_isAvailable()
+                 )
+              {
+                // add file entries
+                archiveSolidMemberNode = archiveEntryInfo->solid.memberList.head;
+                while ((error == ERROR_NONE) && (archiveSolidMemberNode != NULL))
+                {
+                  error = indexAddFile(archiveEntryInfo->archiveHandle,
+                                       archiveSolidMemberNode->name,
+                                       archiveSolidMemberNode->fileInfo.size,
+                                       archiveSolidMemberNode->fileInfo.timeLastAccess,
+                                       archiveSolidMemberNode->fileInfo.timeModified,
+                                       archiveSolidMemberNode->fileInfo.timeLastChanged,
+                                       archiveSolidMemberNode->fileInfo.userId,
+                                       archiveSolidMemberNode->fileInfo.groupId,
+                                       archiveSolidMemberNode->fileInfo.permissions,
+                                       0LL,
+                                       archiveSolidMemberNode->size,
+                                       offset+archiveSolidMemberNode->chunkOffset
+                                      );
+                  archiveSolidMemberNode = archiveSolidMemberNode->next;
+                }
+              }
+            }
+
+            // free resources
+            Compress_done(&archiveEntryInfo->solid.byteCompressInfo);
+
+            Chunk_done(&archiveEntryInfo->solid.chunkFileSolid.info);
+            Chunk_done(&archiveEntryInfo->solid.chunkFileExtendedAttribute.info);
+            Chunk_done(&archiveEntryInfo->solid.chunkFileEntry.info);
+            Chunk_done(&archiveEntryInfo->solid.chunkFile.info);
+            Chunk_done(&archiveEntryInfo->solid.chunkSolidData.info);
+            Chunk_done(&archiveEntryInfo->solid.chunkSolid.info);
+
+            Crypt_done(&archiveEntryInfo->solid.cryptInfo);
+            Crypt_done(&archiveEntryInfo->solid.chunkFileSolid.cryptInfo);
+            Crypt_done(&archiveEntryInfo->solid.chunkFileExtendedAttribute.cryptInfo);
+            Crypt_done(&archiveEntryInfo->solid.chunkFileEntry.cryptInfo);
+            Crypt_done(&archiveEntryInfo->solid.chunkSolidData.cryptInfo);
+
+            free(archiveEntryInfo->solid.byteBuffer);
+            List_done(&archiveEntryInfo->solid.memberList);
+
+            (void)File_close(&archiveEntryInfo->solid.intermediateFileHandle);
+          }
+          break;
         case ARCHIVE_ENTRY_TYPE_META:
           {
             if (!archiveEntryInfo->archiveHandle->dryRun)
@@ -13904,12 +17479,18 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
             Compress_done(&archiveEntryInfo->file.deltaCompressInfo);
 
             Chunk_done(&archiveEntryInfo->file.chunkFileData.info);
+            Chunk_done(&archiveEntryInfo->file.chunkFileSolid.info);
+            Chunk_done(&archiveEntryInfo->file.chunkFileReference.info);
+            Chunk_done(&archiveEntryInfo->file.chunkFileHole.info);
             Chunk_done(&archiveEntryInfo->file.chunkFileDelta.info);
             Chunk_done(&archiveEntryInfo->file.chunkFileExtendedAttribute.info);
             Chunk_done(&archiveEntryInfo->file.chunkFileEntry.info);
 
             Crypt_done(&archiveEntryInfo->file.cryptInfo);
             Crypt_done(&archiveEntryInfo->file.chunkFileData.cryptInfo);
+            Crypt_done(&archiveEntryInfo->file.chunkFileSolid.cryptInfo);
+            Crypt_done(&archiveEntryInfo->file.chunkFileReference.cryptInfo);
+            Crypt_done(&archiveEntryInfo->file.chunkFileHole.cryptInfo);
             Crypt_done(&archiveEntryInfo->file.chunkFileDelta.cryptInfo);
             Crypt_done(&archiveEntryInfo->file.chunkFileExtendedAttribute.cryptInfo);
             Crypt_done(&archiveEntryInfo->file.chunkFileEntry.cryptInfo);
@@ -14014,6 +17595,7 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
             Compress_done(&archiveEntryInfo->hardLink.deltaCompressInfo);
 
             Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkData.info);
+            Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkHole.info);
             Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkDelta.info);
             Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkName.info);
             Chunk_done(&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.info);
@@ -14021,6 +17603,7 @@ Errors Archive_verifySignatureEntry(ArchiveHandle        *archiveHandle,
 
             Crypt_done(&archiveEntryInfo->hardLink.cryptInfo);
             Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkData.cryptInfo);
+            Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkHole.cryptInfo);
             Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkDelta.cryptInfo);
             Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkName.cryptInfo);
             Crypt_done(&archiveEntryInfo->hardLink.chunkHardLinkExtendedAttribute.cryptInfo);
@@ -14121,6 +17704,21 @@ Errors Archive_writeData(ArchiveEntryInfo *archiveEntryInfo,
         case ARCHIVE_ENTRY_TYPE_FILE:
           assert((archiveEntryInfo->file.byteBufferSize%archiveEntryInfo->blockLength) == 0);
 
+          // disable byte compression if first data block is not compressible
+          error = checkAdaptiveCompress(&archiveEntryInfo->file.adaptiveCompressFlag,
+                                        archiveEntryInfo->file.deltaCompressAlgorithm,
+                                        &archiveEntryInfo->file.byteCompressAlgorithm,
+                                        &archiveEntryInfo->file.byteCompressInfo,
+                                        &archiveEntryInfo->file.chunkFile.info,
+                                        &archiveEntryInfo->file.chunkFile.compressAlgorithm,
+                                        buffer,
+                                        length
+                                       );
+          if (error != ERROR_NONE)
+          {
+            return error;
+          }
+
           while (writtenDataBlockLength < dataBlockLength)
           {
             // do compress (delta+byte)
@@ -14186,6 +17784,21 @@ Errors Archive_writeData(ArchiveEntryInfo *archiveEntryInfo,
         case ARCHIVE_ENTRY_TYPE_IMAGE:
           assert((archiveEntryInfo->image.byteBufferSize%archiveEntryInfo->blockLength) == 0);
 
+          // disable byte compression if first data block is not compressible
+          error = checkAdaptiveCompress(&archiveEntryInfo->image.adaptiveCompressFlag,
+                                        archiveEntryInfo->image.deltaCompressAlgorithm,
+                                        &archiveEntryInfo->image.byteCompressAlgorithm,
+                                        &archiveEntryInfo->image.byteCompressInfo,
+                                        &archiveEntryInfo->image.chunkImage.info,
+                                        &archiveEntryInfo->image.chunkImage.compressAlgorithm,
+                                        buffer,
+                                        length
+                                       );
+          if (error != ERROR_NONE)
+          {
+            return error;
+          }
+
           while (writtenDataBlockLength < dataBlockLength)
           {
             // do compress (delta+byte)
@@ -14251,6 +17864,21 @@ Errors Archive_writeData(ArchiveEntryInfo *archiveEntryInfo,
         case ARCHIVE_ENTRY_TYPE_HARDLINK:
           assert((archiveEntryInfo->hardLink.byteBufferSize%archiveEntryInfo->blockLength) == 0);
 
+          // disable byte compression if first data block is not compressible
+          error = checkAdaptiveCompress(&archiveEntryInfo->hardLink.adaptiveCompressFlag,
+                                        archiveEntryInfo->hardLink.deltaCompressAlgorithm,
+                                        &archiveEntryInfo->hardLink.byteCompressAlgorithm,
+                                        &archiveEntryInfo->hardLink.byteCompressInfo,
+                                        &archiveEntryInfo->hardLink.chunkHardLink.info,
+                                        &archiveEntryInfo->hardLink.chunkHardLink.compressAlgorithm,
+                                        buffer,
+                                        length
+                                       );
+          if (error != ERROR_NONE)
+          {
+            return error;
+          }
+
           while (writtenDataBlockLength < dataBlockLength)
           {
             // do compress (delta+byte)
@@ -14313,6 +17941,36 @@ Errors Archive_writeData(ArchiveEntryInfo *archiveEntryInfo,
             }
           }
           break;
+        case ARCHIVE_ENTRY_TYPE_SOLID:
+          assert((archiveEntryInfo->solid.byteBufferSize%archiveEntryInfo->blockLength) == 0);
+
+          while (writtenDataBlockLength < dataBlockLength)
+          {
+            // do byte-compress data (Note: no delta compression in solid block)
+            if (Compress_isFreeDataSpace(&archiveEntryInfo->solid.byteCompressInfo))
+            {
+              ulong deflatedBytes;
+              error = Compress_deflate(&archiveEntryInfo->solid.byteCompressInfo,
+                                       p+writtenDataBlockLength,
+                                       dataBlockLength-writtenDataBlockLength,
+                                       &deflatedBytes
+                                      );
+              if (error != ERROR_NONE)
+              {
+                return error;
+              }
+              writtenDataBlockLength += deflatedBytes;
+              archiveEntryInfo->solid.dataLength += (uint64)deflatedBytes;
+            }
+
+            // write compressed data
+            error = flushSolidDataBlocks(archiveEntryInfo,COMPRESS_BLOCK_TYPE_FULL);
+            if (error != ERROR_NONE)
+            {
+              return error;
+            }
+          }
+          break;
         default:
           HALT_INTERNAL_ERROR("write data not supported for entry type");
           break;
@@ -14342,6 +18000,19 @@ Errors Archive_readData(ArchiveEntryInfo *archiveEntryInfo,
   switch (archiveEntryInfo->archiveEntryType)
   {
     case ARCHIVE_ENTRY_TYPE_FILE:
+      if (archiveEntryInfo->file.solidFlag)
+      {
+        // read data from solid block (Note: never delta-compressed)
+        assert(!Compress_isCompressed(archiveEntryInfo->file.deltaCompressAlgorithm));
+
+        error = readSolidData(archiveEntryInfo->archiveHandle,buffer,length);
+        if (error != ERROR_NONE)
+        {
+          return error;
+        }
+        break;
+      }
+
       if (   Compress_isCompressed(archiveEntryInfo->file.deltaCompressAlgorithm)
           && !archiveEntryInfo->file.deltaSourceHandleInitFlag
          )
@@ -14933,9 +18604,45 @@ Errors Archive_seek(ArchiveHandle *archiveHandle,
         break; /* not reached */
     #endif /* NDEBUG */
   }
-  archiveHandle->nextChunkHeaderReadFlag = FALSE;
+  archiveHandle->nextChunkHeaderReadFlag = FALSE;
+
+  return error;
+}
+
+Errors Archive_seekEntry(ArchiveHandle *archiveHandle,
+                         uint64        offset
+                        )
+{
+  Errors error;
+
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+  assert(archiveHandle->storageInfo != NULL);
+  assert(archiveHandle->storageInfo->jobOptions != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_READ);
+
+  // check for pending error
+  if (archiveHandle->pendingError != ERROR_NONE)
+  {
+    error = archiveHandle->pendingError;
+    archiveHandle->pendingError = ERROR_NONE;
+    return error;
+  }
+
+  // read header chunks of archive to get crypt info
+  error = readHeaderChunks(archiveHandle);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
 
-  return error;
+  // check offset
+  if (offset >= Archive_getSize(archiveHandle))
+  {
+    return ERROR_END_OF_ARCHIVE;
+  }
+
+  return Archive_seek(archiveHandle,offset);
 }
 
 uint64 Archive_getSize(ArchiveHandle *archiveHandle)
@@ -14975,6 +18682,346 @@ uint64 Archive_getSize(ArchiveHandle *archiveHandle)
   return size;
 }
 
+void Archive_initTOCList(ArchiveTOCList *tocList)
+{
+  assert(tocList != NULL);
+
+  List_init(tocList,CALLBACK_(NULL,NULL),CALLBACK_((ListNodeFreeFunction)freeTOCNode,NULL));
+}
+
+void Archive_doneTOCList(ArchiveTOCList *tocList)
+{
+  assert(tocList != NULL);
+
+  List_done(tocList);
+}
+
+Errors Archive_readTOC(ArchiveHandle  *archiveHandle,
+                       ArchiveTOCList *tocList
+                      )
+{
+  Errors error;
+
+  assert(archiveHandle != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(archiveHandle);
+  assert(archiveHandle->storageInfo != NULL);
+  assert(archiveHandle->storageInfo->jobOptions != NULL);
+  assert(archiveHandle->mode == ARCHIVE_MODE_READ);
+  assert(tocList != NULL);
+
+  // check for pending error
+  if (archiveHandle->pendingError != ERROR_NONE)
+  {
+    error = archiveHandle->pendingError;
+    archiveHandle->pendingError = ERROR_NONE;
+    return error;
+  }
+
+  // init variables
+  AutoFreeList autoFreeList;
+  AutoFree_init(&autoFreeList);
+  List_clear(tocList);
+
+  // read header chunks of archive to get crypt info
+  error = readHeaderChunks(archiveHandle);
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return (error == ERROR_END_OF_ARCHIVE) ? ERROR_NO_TOC : error;
+  }
+
+  // init table of contents locator chunk
+  ChunkTOCLocator chunkTOCLocator;
+  error = Chunk_init(&chunkTOCLocator.info,
+                     NULL,  // parentChunkInfo
+                     archiveHandle->chunkIO,
+                     archiveHandle->chunkIOUserData,
+                     CHUNK_ID_TOC_LOCATOR,
+                     CHUNK_DEFINITION_TOC_LOCATOR,
+                     DEFAULT_ALIGNMENT,
+                     NULL,  // cryptInfo
+                     &chunkTOCLocator
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&chunkTOCLocator.info,{ Chunk_done(&chunkTOCLocator.info); });
+
+  // read table of contents locator chunk at end of archive
+  uint64 locatorSize = CHUNK_HEADER_SIZE+(uint64)Chunk_getSize(&chunkTOCLocator.info,NULL,0);
+  uint64 archiveSize = Archive_getSize(archiveHandle);
+  if (archiveSize < locatorSize)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return ERROR_NO_TOC;
+  }
+  error = Archive_seek(archiveHandle,archiveSize-locatorSize);
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  ChunkHeader chunkHeader;
+  error = getNextChunkHeader(archiveHandle,&chunkHeader);
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  if (   (chunkHeader.id != CHUNK_ID_TOC_LOCATOR)
+      || ((CHUNK_HEADER_SIZE+chunkHeader.size) != locatorSize)
+     )
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return ERROR_NO_TOC;
+  }
+  error = Chunk_open(&chunkTOCLocator.info,
+                     &chunkHeader,
+                     chunkHeader.size,
+                     NULL  // transformUserData
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  uint64 tocOffset = chunkTOCLocator.offset;
+  (void)Chunk_close(&chunkTOCLocator.info);
+  if (tocOffset >= archiveSize-locatorSize)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return ERROR_NO_TOC;
+  }
+
+  // init table of contents chunk
+  ChunkTOC chunkTOC;
+  error = Chunk_init(&chunkTOC.info,
+                     NULL,  // parentChunkInfo
+                     archiveHandle->chunkIO,
+                     archiveHandle->chunkIOUserData,
+                     CHUNK_ID_TOC,
+                     CHUNK_DEFINITION_TOC,
+                     DEFAULT_ALIGNMENT,
+                     NULL,  // cryptInfo
+                     &chunkTOC
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&chunkTOC.info,{ Chunk_done(&chunkTOC.info); });
+
+  // read table of contents chunk
+  error = Archive_seek(archiveHandle,tocOffset);
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  error = getNextChunkHeader(archiveHandle,&chunkHeader);
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  if (chunkHeader.id != CHUNK_ID_TOC)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return ERROR_NO_TOC;
+  }
+  error = Chunk_open(&chunkTOC.info,
+                     &chunkHeader,
+                     CHUNK_FIXED_SIZE_TOC,
+                     archiveHandle
+                    );
+  if (error != ERROR_NONE)
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+  AUTOFREE_ADD(&autoFreeList,&chunkTOC.info,{ Chunk_close(&chunkTOC.info); });
+
+  // get and check crypt algorithm
+  if (!Crypt_isValidAlgorithm(chunkTOC.cryptAlgorithms[0]))
+  {
+    AutoFree_cleanup(&autoFreeList);
+    return ERROR_INVALID_CRYPT_ALGORITHM;
+  }
+//TODO: multi crypt
+  CryptAlgorithms cryptAlgorithm = CRYPT_CONSTANT_TO_ALGORITHM(chunkTOC.cryptAlgorithms[0]);
+  uint            blockLength    = Crypt_getBlockLength(cryptAlgorithm);
+  assert(blockLength > 0);
+  uint            keyLength      = Crypt_getKeyLength(cryptAlgorithm);
+  assert(!Crypt_isEncrypted(cryptAlgorithm) || (keyLength > 0));
+
+  // try to read table of contents entries with all decrypt keys
+  uint64 index;
+  Chunk_tell(&chunkTOC.info,&index);
+  const CryptKey     *decryptKey;
+  DecryptKeyIterator decryptKeyIterator;
+  if (Crypt_isEncrypted(cryptAlgorithm))
+  {
+    if (archiveHandle->archiveCryptInfo->cryptType == CRYPT_TYPE_ASYMMETRIC)
+    {
+      decryptKey = &archiveHandle->archiveCryptInfo->cryptKey;
+    }
+    else
+    {
+      decryptKey = getFirstDecryptKey(&decryptKeyIterator,
+                                      archiveHandle,
+                                      &archiveHandle->storageInfo->jobOptions->cryptPassword,
+                                      CALLBACK_(archiveHandle->getNamePasswordFunction,archiveHandle->getNamePasswordUserData),
+                                      archiveHandle->archiveCryptInfo->cryptKeyDeriveType,
+                                      &archiveHandle->archiveCryptInfo->cryptSalt,
+                                      keyLength
+                                     );
+    }
+    if (decryptKey == NULL)
+    {
+      AutoFree_cleanup(&autoFreeList);
+      return ERROR_NO_CRYPT_PASSWORD;
+    }
+  }
+  else
+  {
+    decryptKey = NULL;
+  }
+  do
+  {
+    // reset
+    List_clear(tocList);
+    error = Chunk_seek(&chunkTOC.info,index);
+
+    // init crypt
+    CryptInfo cryptInfo;
+    if (error == ERROR_NONE)
+    {
+      error = Crypt_init(&cryptInfo,
+                         cryptAlgorithm,
+                         archiveHandle->archiveCryptInfo->cryptMode|CRYPT_MODE_CBC_,
+                         &archiveHandle->archiveCryptInfo->cryptSalt,
+                         decryptKey
+                        );
+    }
+
+    // read table of contents entries
+    if (error == ERROR_NONE)
+    {
+      ChunkTOCEntry chunkTOCEntry;
+      error = Chunk_init(&chunkTOCEntry.info,
+                         &chunkTOC.info,
+                         CHUNK_USE_PARENT,
+                         CHUNK_USE_PARENT,
+                         CHUNK_ID_TOC_ENTRY,
+                         CHUNK_DEFINITION_TOC_ENTRY,
+                         blockLength,
+                         &cryptInfo,
+                         &chunkTOCEntry
+                        );
+      if (error == ERROR_NONE)
+      {
+        while (   (error == ERROR_NONE)
+               && !Chunk_eofSub(&chunkTOC.info)
+              )
+        {
+          ChunkHeader subChunkHeader;
+          error = Chunk_nextSub(&chunkTOC.info,&subChunkHeader);
+          if (error != ERROR_NONE)
+          {
+            break;
+          }
+
+          switch (subChunkHeader.id)
+          {
+            case CHUNK_ID_TOC_ENTRY:
+              // read table of contents entry chunk
+              error = Chunk_open(&chunkTOCEntry.info,
+                                 &subChunkHeader,
+                                 subChunkHeader.size,
+                                 archiveHandle
+                                );
+              if (error != ERROR_NONE)
+              {
+                break;
+              }
+
+              // add entry
+              {
+                ArchiveTOCNode *tocNode = LIST_NEW_NODE(ArchiveTOCNode);
+                if (tocNode == NULL)
+                {
+                  HALT_INSUFFICIENT_MEMORY();
+                }
+                tocNode->type           = (ArchiveEntryTypes)chunkTOCEntry.entryType;
+                tocNode->name           = String_new();
+                convertUTF8ToSystemEncoding(tocNode->name,chunkTOCEntry.name);
+                tocNode->offset         = chunkTOCEntry.offset;
+                tocNode->fragmentOffset = chunkTOCEntry.fragmentOffset;
+                tocNode->fragmentSize   = chunkTOCEntry.fragmentSize;
+                List_append(tocList,tocNode);
+              }
+
+              (void)Chunk_close(&chunkTOCEntry.info);
+              break;
+            default:
+              // unknown sub-chunk -> skip
+              if (isPrintInfo(3))
+              {
+                printWarning(_("skipped unknown sub-chunk '%s' (offset %"PRIu64") in '%s'"),
+                             Chunk_idToString(subChunkHeader.id),
+                             subChunkHeader.offset,
+                             String_cString(archiveHandle->printableStorageName)
+                            );
+              }
+              error = Chunk_skipSub(&chunkTOC.info,&subChunkHeader);
+              break;
+          }
+        }
+        Chunk_done(&chunkTOCEntry.info);
+      }
+      Crypt_done(&cryptInfo);
+    }
+
+    if (error != ERROR_NONE)
+    {
+      if (   Crypt_isEncrypted(cryptAlgorithm)
+          && (archiveHandle->archiveCryptInfo->cryptType != CRYPT_TYPE_ASYMMETRIC)
+         )
+      {
+        // get next decrypt key
+        decryptKey = getNextDecryptKey(&decryptKeyIterator,
+                                       archiveHandle->archiveCryptInfo->cryptKeyDeriveType,
+                                       &archiveHandle->archiveCryptInfo->cryptSalt,
+                                       keyLength
+                                      );
+      }
+      else
+      {
+        // no more decrypt keys when no encryption or asymmetric encryption is used
+        decryptKey = NULL;
+      }
+    }
+  }
+  while ((error != ERROR_NONE) && (decryptKey != NULL));
+  if (error != ERROR_NONE)
+  {
+    List_clear(tocList);
+    AutoFree_cleanup(&autoFreeList);
+    return error;
+  }
+
+  // free resources
+  Chunk_close(&chunkTOC.info);
+  Chunk_done(&chunkTOC.info);
+  Chunk_done(&chunkTOCLocator.info);
+  AutoFree_done(&autoFreeList);
+
+  return ERROR_NONE;
+}
+
 Errors Archive_verifySignatures(ArchiveHandle        *archiveHandle,
                                 CryptSignatureStates *allCryptSignaturesState
                                )
@@ -15071,36 +19118,22 @@ Errors Archive_verifySignatures(ArchiveHandle        *archiveHandle,
         return ERROR_UNKNOWN_HASH_ALGORITHM;
       }
 
-      // init signature hash
-      CryptHash signatureHash;
-      error = Crypt_initHash(&signatureHash,SIGNATURE_HASH_ALGORITHM);
-      if (error != ERROR_NONE)
-      {
-        Chunk_close(&chunkSignature.info);
-        AutoFree_cleanup(&autoFreeList);
-        return error;
-      }
-
       // get signature hash
-      error = calculateHash(archiveHandle->chunkIO,
-                            archiveHandle->chunkIOUserData,
-                            &signatureHash,
-                            lastSignatureOffset,
-                            chunkSignature.info.offset
-                           );
+      byte hash[MAX_HASH_SIZE];
+      uint hashLength;
+      error = calculateSignatureHash(archiveHandle,
+                                     lastSignatureOffset,
+                                     chunkSignature.info.offset,
+                                     hash,
+                                     sizeof(hash),
+                                     &hashLength
+                                    );
       if (error != ERROR_NONE)
       {
-        Crypt_doneHash(&signatureHash);
         Chunk_close(&chunkSignature.info);
         AutoFree_cleanup(&autoFreeList);
         return error;
       }
-      byte hash[MAX_HASH_SIZE];
-      uint hashLength;
-      (void)Crypt_getHash(&signatureHash,hash,sizeof(hash),&hashLength);
-
-      // done signature hash
-      Crypt_doneHash(&signatureHash);
 
       // compare signatures
 //fprintf(stderr,"%s, %d: hash %d\n",__FILE__,__LINE__,hashLength); debugDumpMemory(hash,hashLength,0);
@@ -15167,6 +19200,7 @@ Errors Archive_verifySignatures(ArchiveHandle        *archiveHandle,
 
       // get next signature offset
       lastSignatureOffset = Chunk_endOffset(&chunkSignature.info);
+      restartReadSignatureHash(archiveHandle,lastSignatureOffset);
     }
     else
     {
@@ -15180,6 +19214,7 @@ Errors Archive_verifySignatures(ArchiveHandle        *archiveHandle,
     }
   }
   (void)Archive_seek(archiveHandle,offset);
+  restartReadSignatureHash(archiveHandle,offset);
   if (error != ERROR_NONE)
   {
     AutoFree_cleanup(&autoFreeList);
@@ -15465,10 +19500,11 @@ Errors Archive_updateIndex(IndexHandle       *indexHandle,
   {
     // get next file type
     ArchiveEntryTypes archiveEntryType;
+    uint64            offset;
     error = Archive_getNextArchiveEntry(&archiveHandle,
                                         &archiveEntryType,
                                         NULL,  // archiveCryptInfo
-                                        NULL,  // offset
+                                        &offset,
                                         NULL  // size
                                        );
     if (error != ERROR_NONE)
@@ -15497,6 +19533,8 @@ Errors Archive_updateIndex(IndexHandle       *indexHandle,
                                         fileName,
                                         &fileInfo,
                                         NULL,  // fileExtendedAttributeList
+                                        NULL,  // fileHoleList
+                                        NULL,  // referenceName
                                         NULL,  // deltaSourceName
                                         NULL,  // deltaSourceSize
                                         &fragmentOffset,
@@ -15519,7 +19557,8 @@ Errors Archive_updateIndex(IndexHandle       *indexHandle,
                        fileInfo.groupId,
                        fileInfo.permissions,
                        fragmentOffset,
-                       fragmentSize
+                       fragmentSize,
+                       offset
                       );
 
           pprintInfo(4,"INDEX: ","Added file '%s', %lubytes to index for '%s'\n",String_cString(fileName),fileInfo.size,String_cString(printableStorageName));
@@ -15568,7 +19607,8 @@ Errors Archive_updateIndex(IndexHandle       *indexHandle,
                         deviceInfo.size,
                         deviceInfo.blockSize,
                         blockOffset,
-                        blockCount
+                        blockCount,
+                        offset
                        );
           pprintInfo(4,"INDEX: ","Added image '%s', %lubytes to index for '%s'\n",String_cString(imageName),deviceInfo.size,String_cString(printableStorageName));
 
@@ -15609,7 +19649,8 @@ Errors Archive_updateIndex(IndexHandle       *indexHandle,
                             fileInfo.timeLastChanged,
                             fileInfo.userId,
                             fileInfo.groupId,
-                            fileInfo.permissions
+                            fileInfo.permissions,
+                            offset
                            );
 
           pprintInfo(4,"INDEX: ","Added directory '%s' to index for '%s'\n",String_cString(directoryName),String_cString(printableStorageName));
@@ -15655,7 +19696,8 @@ Errors Archive_updateIndex(IndexHandle       *indexHandle,
                        fileInfo.timeLastChanged,
                        fileInfo.userId,
                        fileInfo.groupId,
-                       fileInfo.permissions
+                       fileInfo.permissions,
+                       offset
                       );
 
           pprintInfo(4,"INDEX: ","Added link '%s' to index for '%s'\n",String_cString(linkName),String_cString(printableStorageName));
@@ -15687,6 +19729,7 @@ Errors Archive_updateIndex(IndexHandle       *indexHandle,
                                             &fileNameList,
                                             &fileInfo,
                                             NULL,  // fileExtendedAttributeList
+                                            NULL,  // fileHoleList
                                             NULL,  // deltaSourceName
                                             NULL,  // deltaSourceSize
                                             &fragmentOffset,
@@ -15712,7 +19755,8 @@ Errors Archive_updateIndex(IndexHandle       *indexHandle,
                              fileInfo.groupId,
                              fileInfo.permissions,
                              fragmentOffset,
-                             fragmentSize
+                             fragmentSize,
+                             offset
                             );
           }
 
@@ -15758,7 +19802,8 @@ Errors Archive_updateIndex(IndexHandle       *indexHandle,
                           fileInfo.groupId,
                           fileInfo.permissions,
                           fileInfo.major,
-                          fileInfo.minor
+                          fileInfo.minor,
+                          offset
                          );
 
           pprintInfo(4,"INDEX: ","Added special '%s' to index for '%s'\n",String_cString(fileName),String_cString(printableStorageName));
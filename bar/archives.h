@@ -21,6 +21,8 @@
 #include "common/files.h"
 #include "common/devices.h"
 #include "common/semaphores.h"
+#include "common/msgqueues.h"
+#include "common/threads.h"
 #include "common/passwords.h"
 
 #include "errors.h"
@@ -55,6 +57,7 @@ typedef enum
   ARCHIVE_ENTRY_TYPE_LINK,
   ARCHIVE_ENTRY_TYPE_HARDLINK,
   ARCHIVE_ENTRY_TYPE_SPECIAL,
+  ARCHIVE_ENTRY_TYPE_SOLID,
 
   ARCHIVE_ENTRY_TYPE_META,
   ARCHIVE_ENTRY_TYPE_SALT,
@@ -78,6 +81,8 @@ typedef enum
 #define ARCHIVE_FLAG_CREATE_META          (1 <<  9)   // create meta chunk (create only)
 #define ARCHIVE_FLAG_SKIP_UNKNOWN_CHUNKS  (1 << 10)   // skip unknown chunks (read only)
 #define ARCHIVE_FLAG_PRINT_UNKNOWN_CHUNKS (1 << 11)   // print unknown chunks (read only)
+#define ARCHIVE_FLAG_ADAPTIVE_COMPRESS    (1 << 12)   // disable byte compression if data is not compressible (create only)
+#define ARCHIVE_FLAG_VERIFY_SIGNATURES    (1 << 13)   // verify signatures while reading entries: hash all data in-order by a separate thread (read only)
 
 /***************************** Datatypes *******************************/
 
@@ -241,6 +246,42 @@ typedef Errors(*ArchiveStoreFunction)(StorageInfo  *storageInfo,
                                       void         *userData
                                      );
 
+/***********************************************************************\
+* Name   : ArchiveStreamFunction
+* Purpose: call back to get storage name for streaming an archive part
+*          directly into the storage
+* Input  : storageInfo - storage info
+*          partNumber  - part number or ARCHIVE_PART_NUMBER_NONE for
+*                        single part
+*          archiveName - archive name variable
+*          userData    - user data
+* Output : archiveName - archive name
+* Return : ERROR_NONE or error code
+* Notes  : if no call back is given archive parts are written into
+*          temporary files and stored via ArchiveStoreFunction
+\***********************************************************************/
+
+typedef Errors(*ArchiveStreamFunction)(StorageInfo *storageInfo,
+                                       int         partNumber,
+                                       String      archiveName,
+                                       void        *userData
+                                      );
+
+// archive stream: archive part written via a bounded buffer directly into storage or into a temporary file
+typedef struct
+{
+  String                   archiveName;                                // storage archive name
+  StorageHandle            storageHandle;
+  FileHandle               *fileHandle;                                // temporary file handle or NULL to store into storage
+  byte                     *buffer;                                    // buffer with not stored data
+  ulong                    bufferSize;                                 // size of buffer [bytes]
+  uint64                   bufferOffset;                               // archive offset of buffer begin
+  ulong                    bufferLength;                               // number of bytes in buffer
+  uint64                   offset;                                     // current archive offset
+  bool                     signatureHashFlag;                          // TRUE iff signature hash is calculated
+  CryptHash                signatureHash;                              // signature hash of stored data
+} ArchiveStream;
+
 // archive index cache list
 struct ArchiveIndexNode;
 typedef struct
@@ -249,6 +290,30 @@ typedef struct
   Semaphore lock;
 } ArchiveIndexList;
 
+// archive table of contents
+typedef struct ArchiveTOCNode
+{
+  LIST_NODE_HEADER(struct ArchiveTOCNode);
+
+  ArchiveEntryTypes type;
+  String            name;                                              // entry name (UTF-8)
+  uint64            offset;                                            // offset of entry chunk in archive file [bytes]
+  uint64            fragmentOffset;                                    // fragment offset [bytes]
+  uint64            fragmentSize;                                      // fragment size [bytes]
+} ArchiveTOCNode;
+
+typedef struct
+{
+  LIST_HEADER(ArchiveTOCNode);
+} ArchiveTOCList;
+
+// solid block member list
+struct ArchiveSolidMemberNode;
+typedef struct
+{
+  LIST_HEADER(struct ArchiveSolidMemberNode);
+} ArchiveSolidMemberList;
+
 // archive handle
 typedef struct
 {
@@ -278,6 +343,8 @@ typedef struct
   void                     *archiveTestUserData;                       // user data for test archive file
   ArchiveStoreFunction     archiveStoreFunction;                       // call back to store data info archive file
   void                     *archiveStoreUserData;                      // user data for call back to store data info archive file
+  ArchiveStreamFunction    archiveStreamFunction;                      // call back to get storage name for streaming archive file
+  void                     *archiveStreamUserData;                     // user data for call back to get storage name for streaming archive file
   GetNamePasswordFunction  getNamePasswordFunction;                    // call back to get crypt password
   void                     *getNamePasswordUserData;                   // user data for call back to get crypt password
   LogHandle                *logHandle;                                 // log handle
@@ -304,18 +371,48 @@ typedef struct
   ArchiveModes             mode;                                       // archive mode
   union
   {
-    // create (local file)
+    // create (local file or stream)
     struct
     {
       String               tmpFileName;                                // temporary archive file name
       FileHandle           tmpFileHandle;                              // temporary file handle
       bool                 openFlag;                                   // TRUE iff temporary archive file is open
+      bool                 streamFlag;                                 // TRUE iff archive files are streamed directly into storage
+      ArchiveStream        stream;                                     // archive stream (also used for temporary archive files with signature)
     } create;
     // read (local or remote storage)
     struct
     {
       String               storageFileName;                            // storage name
       StorageHandle        storageHandle;
+      bool                 signatureHashFlag;                          // TRUE iff signature hash is calculated while reading
+      CryptHash            signatureHash;                              // signature hash of read data
+      uint64               signatureHashStart;                         // archive offset of signature hash begin
+      uint64               signatureHashOffset;                        // archive offset of signature hash end
+      byte                 *signatureHashBuffer;                       // read data not hashed yet (kept for signature chunk)
+      ulong                signatureHashBufferLength;                  // number of bytes in buffer
+      bool                 signatureHashThreadFlag;                    // TRUE iff signature hash is calculated by hash thread
+      Thread               signatureHashThread;                        // signature hash thread
+      MsgQueue             signatureHashMsgQueue;                      // queue with data blocks to hash
+      Semaphore            signatureHashLock;                          // lock for hashed bytes
+      uint64               signatureHashPostedBytes;                   // number of bytes sent to hash thread
+      uint64               signatureHashDoneBytes;                     // number of bytes hashed by hash thread
+      byte                 *signatureHashBlock;                        // data block collected for hash thread
+      ulong                signatureHashBlockLength;                   // number of bytes in data block
+
+      // data of current solid block (shared by members, read forward)
+      struct
+      {
+        bool               openFlag;                                   // TRUE iff solid block data is open
+        uint64             offset;                                     // archive offset of solid block chunk
+        uint64             dataOffset;                                 // offset of next decompressed byte in solid block
+        ChunkSolid         chunkSolid;                                 // solid block chunk
+        ChunkFileData      chunkSolidData;                             // solid block data chunk
+        CompressInfo       byteCompressInfo;                           // byte decompress info
+        CryptInfo          cryptInfo;                                  // data decrypt info
+        byte               *byteBuffer;                                // buffer for processing byte data
+        ulong              byteBufferSize;                             // size of byte buffer
+      } solid;
     } read;
   };
   const ChunkIO            *chunkIO;                                   // chunk i/o functions
@@ -326,6 +423,9 @@ typedef struct
   IndexId                  storageId;                                  // storage index id
   ArchiveIndexList         archiveIndexList;
 
+  ArchiveTOCList           tocList;                                    // table of contents of current archive file (create only)
+  bool                     tocOverflowFlag;                            // TRUE iff table of contents exceeded max. number of entries
+
   uint64                   entries;                                    // number of processed entries
   uint64                   archiveFileSize;                            // size of current archive file part
   uint                     partNumber;                                 // current archive part number
@@ -359,19 +459,27 @@ typedef struct ArchiveEntryInfo
     struct
     {
       const FileExtendedAttributeList *fileExtendedAttributeList;      // extended attribute list
+      const FileHoleList              *fileHoleList;                   // hole list
+      ConstString                     referenceName;                   // name of referenced identical file or NULL (write only)
 
       DeltaSourceHandle               deltaSourceHandle;               // delta source handle
       bool                            deltaSourceHandleInitFlag;       // TRUE if delta source is initialized
 
       CompressAlgorithms              deltaCompressAlgorithm;          // delta compression algorithm
       CompressAlgorithms              byteCompressAlgorithm;           // byte compression algorithm
+      bool                            adaptiveCompressFlag;            // TRUE to check if first data block is compressible
 
       ChunkFile                       chunkFile;                       // base chunk
       ChunkFileEntry                  chunkFileEntry;                  // entry
       ChunkFileExtendedAttribute      chunkFileExtendedAttribute;      // extended attribute
       ChunkFileDelta                  chunkFileDelta;                  // delta
+      ChunkFileHole                   chunkFileHole;                   // hole
+      ChunkFileReference              chunkFileReference;              // reference to identical file
+      ChunkFileSolid                  chunkFileSolid;                  // data in solid block (read only)
       ChunkFileData                   chunkFileData;                   // data
 
+      bool                            solidFlag;                       // TRUE iff data is read from solid block (see archive handle)
+
       CompressInfo                    deltaCompressInfo;               // delta compress info
       CompressInfo                    byteCompressInfo;                // byte compress info
       CryptInfo                       cryptInfo;                       // cryption info
@@ -394,6 +502,7 @@ typedef struct ArchiveEntryInfo
 
       CompressAlgorithms              deltaCompressAlgorithm;          // delta compression algorithm
       CompressAlgorithms              byteCompressAlgorithm;           // byte compression algorithm
+      bool                            adaptiveCompressFlag;            // TRUE to check if first data block is compressible
 
       ChunkImage                      chunkImage;                      // base chunk
       ChunkImageEntry                 chunkImageEntry;                 // entry chunk
@@ -433,18 +542,21 @@ typedef struct ArchiveEntryInfo
     {
       const StringList                *fileNameList;                   // list of hard link names
       const FileExtendedAttributeList *fileExtendedAttributeList;      // extended attribute list
+      const FileHoleList              *fileHoleList;                   // hole list
 
       DeltaSourceHandle               deltaSourceHandle;               // delta source handle
       bool                            deltaSourceHandleInitFlag;       // TRUE if delta source is initialized
 
       CompressAlgorithms              deltaCompressAlgorithm;          // delta compression algorithm
       CompressAlgorithms              byteCompressAlgorithm;           // byte compression algorithm
+      bool                            adaptiveCompressFlag;            // TRUE to check if first data block is compressible
 
       ChunkHardLink                   chunkHardLink;                   // base chunk
       ChunkHardLinkEntry              chunkHardLinkEntry;              // entry chunk
       ChunkHardLinkExtendedAttribute  chunkHardLinkExtendedAttribute;  // extended attribute chunk
       ChunkHardLinkName               chunkHardLinkName;               // name chunk
       ChunkHardLinkDelta              chunkHardLinkDelta;              // delta chunk
+      ChunkHardLinkHole               chunkHardLinkHole;               // hole chunk
       ChunkHardLinkData               chunkHardLinkData;               // data chunk
 
       CompressInfo                    deltaCompressInfo;               // delta compress info
@@ -469,6 +581,27 @@ typedef struct ArchiveEntryInfo
       ChunkHardLinkExtendedAttribute  chunkSpecialExtendedAttribute;   // extended attribute chunk
     } special;
     struct
+    {
+      ArchiveSolidMemberList          memberList;                      // members of solid block
+      uint64                          dataLength;                      // total length of uncompressed member data
+
+      CompressAlgorithms              byteCompressAlgorithm;           // byte compression algorithm
+
+      ChunkSolid                      chunkSolid;                      // base chunk
+      ChunkFileData                   chunkSolidData;                  // data chunk
+      ChunkFile                       chunkFile;                       // member base chunk
+      ChunkFileEntry                  chunkFileEntry;                  // member entry chunk
+      ChunkFileExtendedAttribute      chunkFileExtendedAttribute;      // member extended attribute chunk
+      ChunkFileSolid                  chunkFileSolid;                  // member solid data chunk
+
+      CompressInfo                    byteCompressInfo;                // byte compress info
+      CryptInfo                       cryptInfo;                       // cryption info
+
+      FileHandle                      intermediateFileHandle;          // file handle for intermediate entry data
+      byte                            *byteBuffer;                     // buffer for processing byte data
+      ulong                           byteBufferSize;                  // size of byte buffer
+    } solid;
+    struct
     {
       ChunkMeta                       chunkMeta;                       // base chunk
       ChunkMetaEntry                  chunkMetaEntry;                  // entry chunk
@@ -493,6 +626,7 @@ typedef struct ArchiveEntryInfo
   #define Archive_newLinkEntry(...)       __Archive_newLinkEntry      (__FILE__,__LINE__, ## __VA_ARGS__)
   #define Archive_newHardLinkEntry(...)   __Archive_newHardLinkEntry  (__FILE__,__LINE__, ## __VA_ARGS__)
   #define Archive_newSpecialEntry(...)    __Archive_newSpecialEntry   (__FILE__,__LINE__, ## __VA_ARGS__)
+  #define Archive_newSolidEntry(...)      __Archive_newSolidEntry     (__FILE__,__LINE__, ## __VA_ARGS__)
 
   #define Archive_readMetaEntry(...)      __Archive_readMetaEntry     (__FILE__,__LINE__, ## __VA_ARGS__)
   #define Archive_readFileEntry(...)      __Archive_readFileEntry     (__FILE__,__LINE__, ## __VA_ARGS__)
@@ -716,6 +850,9 @@ bool Archive_waitDecryptPassword(Password *password, long timeout);
 *          archiveTestUserData     - user data for call back
 *          archiveStoreFunction    - call back to store archive file
 *          archiveStoreUserData    - user data for call back
+*          archiveStreamFunction   - call back to get storage name for
+*                                    streaming archive file (can be NULL)
+*          archiveStreamUserData   - user data for call back
 *          getNamePasswordFunction - get password call back (can be
 *                                    NULL)
 *          getNamePasswordUserData - user data for get password call back
@@ -751,6 +888,8 @@ bool Archive_waitDecryptPassword(Password *password, long timeout);
                         void                    *archiveTestUserData,
                         ArchiveStoreFunction    archiveStoreFunction,
                         void                    *archiveStoreUserData,
+                        ArchiveStreamFunction   archiveStreamFunction,
+                        void                    *archiveStreamUserData,
                         GetNamePasswordFunction getNamePasswordFunction,
                         void                    *getNamePasswordUserData,
                         LogHandle               *logHandle
@@ -783,6 +922,8 @@ bool Archive_waitDecryptPassword(Password *password, long timeout);
                           void                    *archiveTestUserData,
                           ArchiveStoreFunction    archiveStoreFunction,
                           void                    *archiveStoreUserData,
+                          ArchiveStreamFunction   archiveStreamFunction,
+                          void                    *archiveStreamUserData,
                           GetNamePasswordFunction getNamePasswordFunction,
                           void                    *getNamePasswordUserData,
                           LogHandle               *logHandle
@@ -1096,12 +1237,16 @@ bool Archive_eof(ArchiveHandle *archiveHandle);
 *          fileInfo                  - file info
 *          fileExtendedAttributeList - file extended attribute list or
 *                                      NULL
+*          fileHoleList              - file hole list or NULL
+*          referenceName             - name of identical file already
+*                                      stored in archive or NULL
 *          fragmentOffset            - fragment offset [bytes]
 *          fragmentSize              - fragment size [bytes]
 *          archiveFlags              - flags; see ARCHIVE_FLAG_...
 * Output : archiveEntryInfo - archive file entry info
 * Return : ERROR_NONE or error code
-* Notes  : -
+* Notes  : if referenceName is given no file data is stored; the
+*          fragment size have to be 0
 \***********************************************************************/
 
 #ifdef NDEBUG
@@ -1116,6 +1261,8 @@ bool Archive_eof(ArchiveHandle *archiveHandle);
                               ConstString                     fileName,
                               const FileInfo                  *fileInfo,
                               const FileExtendedAttributeList *fileExtendedAttributeList,
+                              const FileHoleList              *fileHoleList,
+                              ConstString                     referenceName,
                               uint64                          fragmentOffset,
                               uint64                          fragmentSize,
                               ArchiveFlags                    archiveFlags
@@ -1133,6 +1280,8 @@ bool Archive_eof(ArchiveHandle *archiveHandle);
                                 ConstString                     fileName,
                                 const FileInfo                  *fileInfo,
                                 const FileExtendedAttributeList *fileExtendedAttributeList,
+                                const FileHoleList              *fileHoleList,
+                                ConstString                     referenceName,
                                 uint64                          fragmentOffset,
                                 uint64                          fragmentSize,
                                 ArchiveFlags                    archiveFlags
@@ -1298,6 +1447,7 @@ bool Archive_eof(ArchiveHandle *archiveHandle);
 *          fileInfo                  - file info
 *          fileExtendedAttributeList - file extended attribute list or
 *                                      NULL
+*          fileHoleList              - file hole list or NULL
 *          fragmentOffset            - fragment offset [bytes]
 *          fragmentSize              - fragment size [bytes]
 *          archiveFlags              - flags; see ARCHIVE_FLAG_...
@@ -1317,6 +1467,7 @@ bool Archive_eof(ArchiveHandle *archiveHandle);
                                   const StringList                *fileNameList,
                                   const FileInfo                  *fileInfo,
                                   const FileExtendedAttributeList *fileExtendedAttributeList,
+                                  const FileHoleList              *fileHoleList,
                                   uint64                          fragmentOffset,
                                   uint64                          fragmentSize,
                                   ArchiveFlags                    archiveFlags
@@ -1334,6 +1485,7 @@ bool Archive_eof(ArchiveHandle *archiveHandle);
                                     const StringList                *fileNameList,
                                     const FileInfo                  *fileInfo,
                                     const FileExtendedAttributeList *fileExtendedAttributeList,
+                                    const FileHoleList              *fileHoleList,
                                     uint64                          fragmentOffset,
                                     uint64                          fragmentSize,
                                     ArchiveFlags                    archiveFlags
@@ -1383,6 +1535,75 @@ bool Archive_eof(ArchiveHandle *archiveHandle);
                                   );
 #endif /* NDEBUG */
 
+/***********************************************************************\
+* Name   : Archive_newSolidEntry
+* Purpose: add new solid block entry to archive
+* Input  : archiveEntryInfo      - archive solid entry info variable
+*          archiveHandle         - archive handle
+*          byteCompressAlgorithm - used byte compression algorithm
+*          cryptAlgorithm        - crypt algorihm or
+*                                  CRYPT_ALGORITHM_NONE
+*          cryptSalt             - crypt salt or NULL for default
+*          cryptKey              - crypt key or NULL for default
+* Output : archiveEntryInfo - archive solid entry info
+* Return : ERROR_NONE or error code
+* Notes  : add files with Archive_addSolidEntryFile() and write the
+*          data of the file with Archive_writeData() afterwards; the
+*          data of all files is stored in a single compressed and
+*          encrypted data stream. The solid block and the file entries
+*          are written into the archive by Archive_closeEntry().
+\***********************************************************************/
+
+#ifdef NDEBUG
+  Errors Archive_newSolidEntry(ArchiveEntryInfo   *archiveEntryInfo,
+                               ArchiveHandle      *archiveHandle,
+                               CompressAlgorithms byteCompressAlgorithm,
+                               CryptAlgorithms    cryptAlgorithm,
+                               const CryptSalt    *cryptSalt,
+                               const CryptKey     *cryptKey
+                              );
+#else /* not NDEBUG */
+  Errors __Archive_newSolidEntry(const char         *__fileName__,
+                                 ulong              __lineNb__,
+                                 ArchiveEntryInfo   *archiveEntryInfo,
+                                 ArchiveHandle      *archiveHandle,
+                                 CompressAlgorithms byteCompressAlgorithm,
+                                 CryptAlgorithms    cryptAlgorithm,
+                                 const CryptSalt    *cryptSalt,
+                                 const CryptKey     *cryptKey
+                                );
+#endif /* NDEBUG */
+
+/***********************************************************************\
+* Name   : Archive_addSolidEntryFile
+* Purpose: add file to solid block entry
+* Input  : archiveEntryInfo          - archive solid entry info
+*          fileName                  - file name
+*          fileInfo                  - file info
+*          fileExtendedAttributeList - file extended attribute list or
+*                                      NULL
+* Output : -
+* Return : -
+* Notes  : data of previous added file is complete
+\***********************************************************************/
+
+void Archive_addSolidEntryFile(ArchiveEntryInfo                *archiveEntryInfo,
+                               ConstString                     fileName,
+                               const FileInfo                  *fileInfo,
+                               const FileExtendedAttributeList *fileExtendedAttributeList
+                              );
+
+/***********************************************************************\
+* Name   : Archive_getSolidEntrySize
+* Purpose: get size of data in solid block entry
+* Input  : archiveEntryInfo - archive solid entry info
+* Output : -
+* Return : size of (uncompressed) data [bytes]
+* Notes  : -
+\***********************************************************************/
+
+uint64 Archive_getSolidEntrySize(const ArchiveEntryInfo *archiveEntryInfo);
+
 /***********************************************************************\
 * Name   : Archive_getNextArchiveEntry
 * Purpose: get next entry in archive
@@ -1431,6 +1652,9 @@ Errors Archive_skipNextEntry(ArchiveHandle *archiveHandle);
 *          fileInfo                  - file info
 *          fileExtendedAttributeList - file extended attribute list or
 *                                      NULL
+*          fileHoleList              - file hole list or NULL
+*          referenceName             - name of identical file stored in
+*                                      archive or empty (can be NULL)
 *          deltaSourceName           - delta source name (can be NULL)
 *          deltaSourceSize           - delta source size [bytes] (can be
 *                                      NULL)
@@ -1438,7 +1662,8 @@ Errors Archive_skipNextEntry(ArchiveHandle *archiveHandle);
 *          fragmentSize              - fragment size in bytes (can be
 *                                      NULL)
 * Return : ERROR_NONE or error code
-* Notes  : -
+* Notes  : if referenceName is not empty the entry does not contain
+*          file data; the data is the data of the referenced file
 \***********************************************************************/
 
 #ifdef NDEBUG
@@ -1453,6 +1678,8 @@ Errors Archive_skipNextEntry(ArchiveHandle *archiveHandle);
                                String                    fileName,
                                FileInfo                  *fileInfo,
                                FileExtendedAttributeList *fileExtendedAttributeList,
+                               FileHoleList              *fileHoleList,
+                               String                    referenceName,
                                String                    deltaSourceName,
                                uint64                    *deltaSourceSize,
                                uint64                    *fragmentOffset,
@@ -1472,6 +1699,8 @@ Errors Archive_skipNextEntry(ArchiveHandle *archiveHandle);
                                  String                    fileName,
                                  FileInfo                  *fileInfo,
                                  FileExtendedAttributeList *fileExtendedAttributeList,
+                                 FileHoleList              *fileHoleList,
+                                 String                    referenceName,
                                  String                    deltaSourceName,
                                  uint64                    *deltaSourceSize,
                                  uint64                    *fragmentOffset,
@@ -1648,6 +1877,7 @@ Errors Archive_skipNextEntry(ArchiveHandle *archiveHandle);
 *          fileInfo                  - file info
 *          fileExtendedAttributeList - file extended attribute list or
 *                                      NULL
+*          fileHoleList              - file hole list or NULL
 *          deltaSourceName           - delta source name (can be NULL)
 *          deltaSourceSize           - delta source size [bytes] (can
 *                                      be NULL)
@@ -1670,6 +1900,7 @@ Errors Archive_skipNextEntry(ArchiveHandle *archiveHandle);
                                    StringList                *fileNameList,
                                    FileInfo                  *fileInfo,
                                    FileExtendedAttributeList *fileExtendedAttributeList,
+                                   FileHoleList              *fileHoleList,
                                    String                    deltaSourceName,
                                    uint64                    *deltaSourceSize,
                                    uint64                    *fragmentOffset,
@@ -1689,6 +1920,7 @@ Errors Archive_skipNextEntry(ArchiveHandle *archiveHandle);
                                      StringList                *fileNameList,
                                      FileInfo                  *fileInfo,
                                      FileExtendedAttributeList *fileExtendedAttributeList,
+                                     FileHoleList              *fileHoleList,
                                      String                    deltaSourceName,
                                      uint64                    *deltaSourceSize,
                                      uint64                    *fragmentOffset,
@@ -1932,6 +2164,21 @@ INLINE uint64 Archive_getEntries(const ArchiveHandle *archiveHandle)
 }
 #endif /* NDEBUG || __ARCHIVE_IMPLEMENTATION__ */
 
+/***********************************************************************\
+* Name   : Archive_seekEntry
+* Purpose: seek to entry in archive file
+* Input  : archiveHandle - archive handle
+*          offset        - offset of entry chunks in archive (e. g. from
+*                          table of contents or index database)
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : read header chunks of archive first to get crypt info
+\***********************************************************************/
+
+Errors Archive_seekEntry(ArchiveHandle *archiveHandle,
+                         uint64        offset
+                        );
+
 /***********************************************************************\
 * Name   : Archive_getSize
 * Purpose: get size of archive file
@@ -1943,6 +2190,46 @@ INLINE uint64 Archive_getEntries(const ArchiveHandle *archiveHandle)
 
 uint64 Archive_getSize(ArchiveHandle *archiveHandle);
 
+/***********************************************************************\
+* Name   : Archive_initTOCList
+* Purpose: init table of contents list
+* Input  : tocList - table of contents list
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+void Archive_initTOCList(ArchiveTOCList *tocList);
+
+/***********************************************************************\
+* Name   : Archive_doneTOCList
+* Purpose: done table of contents list
+* Input  : tocList - table of contents list
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+void Archive_doneTOCList(ArchiveTOCList *tocList);
+
+/***********************************************************************\
+* Name   : Archive_readTOC
+* Purpose: read table of contents of archive
+* Input  : archiveHandle - archive handle
+*          tocList       - table of contents list variable
+* Output : tocList - table of contents list with entry names in system
+*                    encoding
+* Return : ERROR_NONE, ERROR_NO_TOC if archive has no table of contents
+*          or error code
+* Notes  : the archive position is undefined afterwards; use
+*          Archive_seek() to read an entry at an offset from the table
+*          of contents
+\***********************************************************************/
+
+Errors Archive_readTOC(ArchiveHandle  *archiveHandle,
+                       ArchiveTOCList *tocList
+                      );
+
 /***********************************************************************\
 * Name   : Archive_verifySignatures
 * Purpose: verify signatures of archive
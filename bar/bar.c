@@ -540,14 +540,14 @@ LOCAL Errors initAll(void)
   Semaphore_init(&logLock,SEMAPHORE_TYPE_BINARY);
   logFile = NULL;
 
-  Thread_initLocalVariable(&consoleOutputHandle,consoleOutputHandleInit,NULL);
+  Thread_initLocalVariable(&consoleOutputHandle,consoleOutputHandleInit,NULL,consoleOutputHandleDone,NULL);
   lastConsoleOutput = NULL;
 
   AUTOFREE_ADD(&autoFreeList,&consoleLock,{ Semaphore_done(&consoleLock); });
   AUTOFREE_ADD(&autoFreeList,&mountedList,{ List_done(&mountedList); });
   AUTOFREE_ADD(&autoFreeList,&mountedList.lock,{ Semaphore_done(&mountedList.lock); });
   AUTOFREE_ADD(&autoFreeList,&logLock,{ Semaphore_done(&logLock); });
-  AUTOFREE_ADD(&autoFreeList,&consoleOutputHandle,{ Thread_doneLocalVariable(&consoleOutputHandle,consoleOutputHandleDone,NULL); });
+  AUTOFREE_ADD(&autoFreeList,&consoleOutputHandle,{ Thread_doneLocalVariable(&consoleOutputHandle); });
 
   // initialize i18n
   #if defined(HAVE_SETLOCALE) && defined(HAVE_BINDTEXTDOMAIN) && defined(HAVE_TEXTDOMAIN)
@@ -795,7 +795,7 @@ LOCAL void doneAll(void)
   Configuration_doneAll();
   Common_doneAll();
 
-  Thread_doneLocalVariable(&consoleOutputHandle,consoleOutputHandleDone,NULL);
+  Thread_doneLocalVariable(&consoleOutputHandle);
 
   // deinitialize variables
   #ifdef HAVE_NEWLOCALE
@@ -1574,6 +1574,70 @@ void logPostProcess(LogHandle        *logHandle,
   }
 }
 
+/***********************************************************************\
+* Name   : getMaxConnectionCount
+* Purpose: get max. number of concurrent connections of server
+* Input  : serverType         - server type; see SERVER_TYPE_...
+*          maxConnectionCount - server specific max. number of
+*                               connections or 0
+* Output : -
+* Return : max. number of concurrent connections or 0 for unlimited
+* Notes  : -
+\***********************************************************************/
+
+LOCAL uint getMaxConnectionCount(ServerTypes serverType, uint maxConnectionCount)
+{
+  if (maxConnectionCount == 0)
+  {
+    switch (serverType)
+    {
+      case SERVER_TYPE_FILE:
+        maxConnectionCount = MAX_UINT;
+        break;
+      case SERVER_TYPE_FTP:
+        maxConnectionCount = globalOptions.defaultFTPServer.maxConnectionCount;
+        break;
+      case SERVER_TYPE_SSH:
+        maxConnectionCount = globalOptions.defaultSSHServer.maxConnectionCount;
+        break;
+      case SERVER_TYPE_WEBDAV:
+      case SERVER_TYPE_WEBDAVS:
+        maxConnectionCount = globalOptions.defaultWebDAVServer.maxConnectionCount;
+        break;
+      case SERVER_TYPE_SMB:
+        maxConnectionCount = globalOptions.defaultSMBServer.maxConnectionCount;
+        break;
+      default:
+        #ifndef NDEBUG
+          HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+        #endif /* NDEBUG */
+        break;
+    }
+  }
+
+  return maxConnectionCount;
+}
+
+uint getServerMaxConnectionCount(uint serverId, ServerTypes serverType)
+{
+  uint maxConnectionCount = 0;
+
+  if (serverId != 0)
+  {
+    SEMAPHORE_LOCKED_DO(&globalOptions.serverList.lock,SEMAPHORE_LOCK_TYPE_READ,WAIT_FOREVER)
+    {
+      // find server
+      const ServerNode *serverNode = (ServerNode*)LIST_FIND(&globalOptions.serverList,serverNode,serverNode->server.id == serverId);
+      if (serverNode != NULL)
+      {
+        maxConnectionCount = serverNode->server.maxConnectionCount;
+      }
+    }
+  }
+
+  return getMaxConnectionCount(serverType,maxConnectionCount);
+}
+
 bool allocateServer(uint serverId, ServerConnectionPriorities priority, long timeout)
 {
   if (serverId != 0)
@@ -1589,36 +1653,7 @@ bool allocateServer(uint serverId, ServerConnectionPriorities priority, long tim
       }
 
       // get max. number of allowed concurrent connections
-      uint maxConnectionCount;
-      if (serverNode->server.maxConnectionCount != 0)
-      {
-        maxConnectionCount = serverNode->server.maxConnectionCount;
-      }
-      else
-      {
-        maxConnectionCount = 0;
-        switch (serverNode->server.type)
-        {
-          case SERVER_TYPE_FILE:
-            maxConnectionCount = MAX_UINT;
-            break;
-          case SERVER_TYPE_FTP:
-            maxConnectionCount = globalOptions.defaultFTPServer.maxConnectionCount;
-            break;
-          case SERVER_TYPE_SSH:
-            maxConnectionCount = globalOptions.defaultSSHServer.maxConnectionCount;
-            break;
-          case SERVER_TYPE_WEBDAV:
-          case SERVER_TYPE_WEBDAVS:
-            maxConnectionCount = globalOptions.defaultWebDAVServer.maxConnectionCount;
-            break;
-          default:
-            #ifndef NDEBUG
-              HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
-            #endif /* NDEBUG */
-            break;
-        }
-      }
+      uint maxConnectionCount = getMaxConnectionCount(serverNode->server.type,serverNode->server.maxConnectionCount);
 
       // allocate server
       switch (priority)
@@ -3651,6 +3686,7 @@ LOCAL Errors runInteractive(int argc, const char *argv[])
             error = Command_restore(&storageNameList,
                                     &globalOptions.includeEntryList,
                                     &globalOptions.excludePatternList,
+                                    NULL,  // restoreEntryOffsetList
                                     &jobOptions,
                                     CALLBACK_(NULL,NULL),  // restoreRunningInfo
                                     CALLBACK_(NULL,NULL),  // restoreError
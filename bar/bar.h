@@ -606,6 +606,19 @@ void doneDeviceSettings(Device *device);
 
 // ----------------------------------------------------------------------
 
+/***********************************************************************\
+* Name   : getServerMaxConnectionCount
+* Purpose: get max. number of concurrent connections to server
+* Input  : serverId   - server id or 0
+*          serverType - server type; see SERVER_TYPE_...
+* Output : -
+* Return : max. number of concurrent connections or 0 for unlimited
+* Notes  : default settings of server type are used if no server
+*          specific value is configured
+\***********************************************************************/
+
+uint getServerMaxConnectionCount(uint serverId, ServerTypes serverType);
+
 /***********************************************************************\
 * Name   : allocateServer
 * Purpose: allocate server
@@ -369,6 +369,63 @@ void setRunningInfo(RunningInfo *runningInfo, const RunningInfo *fromRunningInfo
   runningInfo->estimatedRestTime            = fromRunningInfo->estimatedRestTime;
 }
 
+void ProgressCounters_init(ProgressCounters *progressCounters)
+{
+  assert(progressCounters != NULL);
+
+  memClear(progressCounters,sizeof(ProgressCounters));
+}
+
+ulong ProgressCounters_getDoneCount(const ProgressCounters *progressCounters)
+{
+  assert(progressCounters != NULL);
+
+  ulong count = 0L;
+  for (uint i = 0; i < PROGRESS_COUNTERS_SLOTS; i++)
+  {
+    count += __atomic_load_n(&progressCounters->slots[i].doneCount,__ATOMIC_RELAXED);
+  }
+
+  return count;
+}
+
+uint64 ProgressCounters_getDoneSize(const ProgressCounters *progressCounters)
+{
+  assert(progressCounters != NULL);
+
+  uint64 size = 0LL;
+  for (uint i = 0; i < PROGRESS_COUNTERS_SLOTS; i++)
+  {
+    size += __atomic_load_n(&progressCounters->slots[i].doneSize,__ATOMIC_RELAXED);
+  }
+
+  return size;
+}
+
+void ProgressCounters_get(const ProgressCounters *progressCounters, RunningInfo *runningInfo)
+{
+  assert(progressCounters != NULL);
+  assert(runningInfo != NULL);
+
+  runningInfo->progress.done.count    = 0L;
+  runningInfo->progress.done.size     = 0LL;
+  runningInfo->progress.skipped.count = 0L;
+  runningInfo->progress.skipped.size  = 0LL;
+  runningInfo->progress.error.count   = 0L;
+  runningInfo->progress.error.size    = 0LL;
+  for (uint i = 0; i < PROGRESS_COUNTERS_SLOTS; i++)
+  {
+    const ProgressCounterSlot *progressCounterSlot = &progressCounters->slots[i];
+
+    runningInfo->progress.done.count    += __atomic_load_n(&progressCounterSlot->doneCount,__ATOMIC_RELAXED);
+    runningInfo->progress.done.size     += __atomic_load_n(&progressCounterSlot->doneSize,__ATOMIC_RELAXED);
+    runningInfo->progress.skipped.count += __atomic_load_n(&progressCounterSlot->skippedCount,__ATOMIC_RELAXED);
+    runningInfo->progress.skipped.size  += __atomic_load_n(&progressCounterSlot->skippedSize,__ATOMIC_RELAXED);
+    runningInfo->progress.error.count   += __atomic_load_n(&progressCounterSlot->errorCount,__ATOMIC_RELAXED);
+    runningInfo->progress.error.size    += __atomic_load_n(&progressCounterSlot->errorSize,__ATOMIC_RELAXED);
+  }
+}
+
 const char *volumeRequestToString(VolumeRequests volumeRequest)
 {
   const char *VOLUME_REQUEST_TEXT[] =
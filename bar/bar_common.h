@@ -943,6 +943,26 @@ typedef struct
   ulong             estimatedRestTime;                // estimated rest running time [s]
 } RunningInfo;
 
+// progress counters: pthread_self() is hashed into one of 64 shared slots;
+// threads can share a slot, so updates still have to be atomic
+#define PROGRESS_COUNTERS_CACHE_LINE_SIZE 64
+#define PROGRESS_COUNTERS_SLOTS           64
+
+typedef struct
+{
+  ulong             doneCount;                        // number of entries processed
+  uint64            doneSize;                         // size processed [bytes]
+  ulong             skippedCount;                     // number of skipped entries
+  uint64            skippedSize;                      // size sum skipped [bytes]
+  ulong             errorCount;                       // number of entries with errors
+  uint64            errorSize;                        // size sum of entries with errors [bytes]
+} __attribute__((aligned(PROGRESS_COUNTERS_CACHE_LINE_SIZE))) ProgressCounterSlot;
+
+typedef struct
+{
+  ProgressCounterSlot slots[PROGRESS_COUNTERS_SLOTS]; // slots selected by thread id hash; atomic updates
+} ProgressCounters;
+
 // global options
 typedef struct
 {
@@ -953,9 +973,13 @@ typedef struct
 
   uint                        niceLevel;                      // nice level 0..19
   uint                        maxThreads;                     // max. number of concurrent compress/encryption threads or 0
+  bool                        singlePassCollectorFlag;        // TRUE to collect entries and total sum in a single pass
+  uint                        collectorThreads;               // number of parallel directory scan threads or 0
 
   String                      tmpDirectory;                   // base directory for temporary files
   uint64                      maxTmpSize;                     // max. size of temporary files
+  bool                        streamArchivesFlag;             // TRUE to stream archive files directly into storage
+  bool                        incrementalFileSystemGenerationFlag; // TRUE to find changed entries by file system generation
 
   String                      jobsDirectory;                  // jobs directory
   String                      incrementalDataDirectory;       // incremental data directory
@@ -1105,6 +1129,10 @@ typedef struct
   uint64                      volumeSize;                     // volume size or 0LL for default [bytes]
 
   ulong                       compressMinFileSize;            // min. size of file for using compression
+  bool                        compressAdaptiveFlag;           // TRUE to skip compression of incompressible data
+  uint64                      solidBlockSize;                 // max. size of solid block for small files or 0LL [bytes]
+  bool                        deduplicateFlag;                // TRUE to store identical files only once
+  bool                        tableOfContentsFlag;            // TRUE to add table of contents to archive files
   uint64                      continuousMaxSize;              // max. entry size for continuous backup
   uint                        continuousMinTimeDelta;         // min. time between consequtive continuous backup of an entry [s]
 
@@ -1401,6 +1429,108 @@ void resetRunningInfo(RunningInfo *runningInfo);
 
 // ----------------------------------------------------------------------
 
+/***********************************************************************\
+* Name   : ProgressCounters_init
+* Purpose: initialize progress counters
+* Input  : progressCounters - progress counters variable
+* Output : progressCounters - initialized progress counters
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+void ProgressCounters_init(ProgressCounters *progressCounters);
+
+/***********************************************************************\
+* Name   : ProgressCounters_getSlot
+* Purpose: get progress counter slot of calling thread
+* Input  : progressCounters - progress counters
+* Output : -
+* Return : progress counter slot
+* Notes  : pthread_self() is hashed into one of the shared slots;
+*          several threads can use the same slot, so the counters
+*          still have to be updated with atomic operations
+\***********************************************************************/
+
+INLINE ProgressCounterSlot *ProgressCounters_getSlot(ProgressCounters *progressCounters);
+#if defined(NDEBUG) || defined(__BAR_COMMON_IMPLEMENTATION__)
+INLINE ProgressCounterSlot *ProgressCounters_getSlot(ProgressCounters *progressCounters)
+{
+  assert(progressCounters != NULL);
+
+  uint64 hash = ((uint64)(uintptr_t)pthread_self() >> 12)*0x9E3779B97F4A7C15LL;
+  return &progressCounters->slots[(hash >> 32) % PROGRESS_COUNTERS_SLOTS];
+}
+#endif /* NDEBUG || __BAR_COMMON_IMPLEMENTATION__ */
+
+/***********************************************************************\
+* Name   : ProgressCounters_addDone, ProgressCounters_addSkipped,
+*          ProgressCounters_addError
+* Purpose: add done/skipped/error entries
+* Input  : progressCounters - progress counters
+*          count            - number of entries
+*          size             - size [bytes]
+* Output : -
+* Return : -
+* Notes  : lock-free; counters are merged by ProgressCounters_get()
+\***********************************************************************/
+
+INLINE void ProgressCounters_addDone(ProgressCounters *progressCounters, ulong count, uint64 size);
+#if defined(NDEBUG) || defined(__BAR_COMMON_IMPLEMENTATION__)
+INLINE void ProgressCounters_addDone(ProgressCounters *progressCounters, ulong count, uint64 size)
+{
+  ProgressCounterSlot *progressCounterSlot = ProgressCounters_getSlot(progressCounters);
+  if (count > 0L) (void)__atomic_fetch_add(&progressCounterSlot->doneCount,count,__ATOMIC_RELAXED);
+  if (size > 0LL) (void)__atomic_fetch_add(&progressCounterSlot->doneSize,size,__ATOMIC_RELAXED);
+}
+#endif /* NDEBUG || __BAR_COMMON_IMPLEMENTATION__ */
+
+INLINE void ProgressCounters_addSkipped(ProgressCounters *progressCounters, ulong count, uint64 size);
+#if defined(NDEBUG) || defined(__BAR_COMMON_IMPLEMENTATION__)
+INLINE void ProgressCounters_addSkipped(ProgressCounters *progressCounters, ulong count, uint64 size)
+{
+  ProgressCounterSlot *progressCounterSlot = ProgressCounters_getSlot(progressCounters);
+  if (count > 0L) (void)__atomic_fetch_add(&progressCounterSlot->skippedCount,count,__ATOMIC_RELAXED);
+  if (size > 0LL) (void)__atomic_fetch_add(&progressCounterSlot->skippedSize,size,__ATOMIC_RELAXED);
+}
+#endif /* NDEBUG || __BAR_COMMON_IMPLEMENTATION__ */
+
+INLINE void ProgressCounters_addError(ProgressCounters *progressCounters, ulong count, uint64 size);
+#if defined(NDEBUG) || defined(__BAR_COMMON_IMPLEMENTATION__)
+INLINE void ProgressCounters_addError(ProgressCounters *progressCounters, ulong count, uint64 size)
+{
+  ProgressCounterSlot *progressCounterSlot = ProgressCounters_getSlot(progressCounters);
+  if (count > 0L) (void)__atomic_fetch_add(&progressCounterSlot->errorCount,count,__ATOMIC_RELAXED);
+  if (size > 0LL) (void)__atomic_fetch_add(&progressCounterSlot->errorSize,size,__ATOMIC_RELAXED);
+}
+#endif /* NDEBUG || __BAR_COMMON_IMPLEMENTATION__ */
+
+/***********************************************************************\
+* Name   : ProgressCounters_getDoneCount, ProgressCounters_getDoneSize
+* Purpose: get merged number/size of done entries
+* Input  : progressCounters - progress counters
+* Output : -
+* Return : number of done entries/size of done entries [bytes]
+* Notes  : -
+\***********************************************************************/
+
+ulong ProgressCounters_getDoneCount(const ProgressCounters *progressCounters);
+uint64 ProgressCounters_getDoneSize(const ProgressCounters *progressCounters);
+
+/***********************************************************************\
+* Name   : ProgressCounters_get
+* Purpose: merge progress counters into running info
+* Input  : progressCounters - progress counters
+*          runningInfo      - running info
+* Output : runningInfo - running info with done/skipped/error
+*                        counters
+* Return : -
+* Notes  : call with running info locked before publishing it
+\***********************************************************************/
+
+void ProgressCounters_get(const ProgressCounters *progressCounters, RunningInfo *runningInfo);
+
+// ----------------------------------------------------------------------
+
 /***********************************************************************\
 * Name   : volumeRequestToString
 * Purpose: get volume request string
@@ -2035,6 +2035,264 @@ LOCAL Errors writeDefinition(const ChunkIO   *chunkIO,
   return ERROR_NONE;
 }
 
+/***********************************************************************\
+* Name   : readChunkData
+* Purpose: read raw data of chunk
+* Input  : chunkInfo - chunk info block
+*          data      - data buffer
+*          size      - max. number of bytes to read
+* Output : bytesRead - number of bytes read (can be NULL)
+* Return : ERROR_NONE or error code
+* Notes  : if bytesRead is NULL all requested data must be read
+\***********************************************************************/
+
+LOCAL Errors readChunkData(ChunkInfo *chunkInfo,
+                           void      *data,
+                           ulong     size,
+                           ulong     *bytesRead
+                          )
+{
+  Errors error;
+
+  assert(chunkInfo != NULL);
+  assert(chunkInfo->io != NULL);
+  assert(chunkInfo->io->read != NULL);
+  assert(data != NULL);
+
+  // limit size to read to rest
+  if ((uint64)size > (chunkInfo->size-chunkInfo->index))
+  {
+    size = (ulong)(chunkInfo->size-chunkInfo->index);
+  }
+
+  // read data
+  ulong n;
+  error = chunkInfo->io->read(chunkInfo->ioUserData,data,size,&n);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+  if (bytesRead != NULL)
+  {
+    // return number of read bytes
+    (*bytesRead) = n;
+  }
+  else
+  {
+    // check if read all requested data
+    if (size != n)
+    {
+      return ERROR_(IO,errno);
+    }
+  }
+
+  // increment indizes
+  chunkInfo->index += (uint64)n;
+  if (chunkInfo->parentChunkInfo != NULL)
+  {
+    chunkInfo->parentChunkInfo->index += (uint64)n;
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : writeChunkData
+* Purpose: write raw data of chunk
+* Input  : chunkInfo - chunk info block
+*          data      - data
+*          size      - size of data [bytes]
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors writeChunkData(ChunkInfo  *chunkInfo,
+                            const void *data,
+                            ulong      size
+                           )
+{
+  Errors error;
+
+  assert(chunkInfo != NULL);
+  assert(chunkInfo->io != NULL);
+  assert(chunkInfo->io->write != NULL);
+
+  // write data
+  error = chunkInfo->io->write(chunkInfo->ioUserData,data,size);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  // increment indizes and increase sizes
+  chunkInfo->size  += (uint64)size;
+  chunkInfo->index += (uint64)size;
+  if (chunkInfo->parentChunkInfo != NULL)
+  {
+    chunkInfo->parentChunkInfo->index += (uint64)size;
+    chunkInfo->parentChunkInfo->size  += (uint64)size;
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : resetAuthenticatedData
+* Purpose: reset authenticated data state
+* Input  : chunkInfo - chunk info block
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void resetAuthenticatedData(ChunkInfo *chunkInfo)
+{
+  assert(chunkInfo != NULL);
+
+  chunkInfo->authenticated.nonceFlag  = FALSE;
+  chunkInfo->authenticated.blockIndex = 0LL;
+  chunkInfo->authenticated.length     = 0L;
+  chunkInfo->authenticated.index      = 0L;
+}
+
+/***********************************************************************\
+* Name   : writeAuthenticatedBlock
+* Purpose: encrypt and write buffered authenticated data block
+* Input  : chunkInfo - chunk info block
+*          lastFlag  - TRUE iff last block of chunk
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : nonce is written before first block
+\***********************************************************************/
+
+LOCAL Errors writeAuthenticatedBlock(ChunkInfo *chunkInfo, bool lastFlag)
+{
+  Errors error;
+
+  assert(chunkInfo != NULL);
+  assert(chunkInfo->authenticated.cryptInfo != NULL);
+  assert(chunkInfo->authenticated.buffer != NULL);
+  assert(chunkInfo->authenticated.length <= CRYPT_AUTHENTICATED_BLOCK_LENGTH);
+
+  // write nonce
+  if (!chunkInfo->authenticated.nonceFlag)
+  {
+    byte nonce[CRYPT_NONCE_LENGTH+4];
+
+    memCopyFast(nonce,sizeof(nonce),chunkInfo->authenticated.nonce,CRYPT_NONCE_LENGTH);
+    memClear(&nonce[CRYPT_NONCE_LENGTH],4);
+    error = writeChunkData(chunkInfo,nonce,sizeof(nonce));
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    chunkInfo->authenticated.nonceFlag = TRUE;
+  }
+
+  // encrypt block, append tag
+  error = Crypt_encryptAuthenticated(chunkInfo->authenticated.cryptInfo,
+                                     chunkInfo->authenticated.nonce,
+                                     chunkInfo->authenticated.blockIndex,
+                                     lastFlag,
+                                     chunkInfo->authenticated.buffer,
+                                     chunkInfo->authenticated.length,
+                                     &chunkInfo->authenticated.buffer[chunkInfo->authenticated.length]
+                                    );
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  // write block
+  error = writeChunkData(chunkInfo,
+                         chunkInfo->authenticated.buffer,
+                         chunkInfo->authenticated.length+CRYPT_TAG_LENGTH
+                        );
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  chunkInfo->authenticated.blockIndex++;
+  chunkInfo->authenticated.length = 0L;
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : readAuthenticatedBlock
+* Purpose: read and decrypt next authenticated data block
+* Input  : chunkInfo - chunk info block
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : nonce is read before first block; last block is the block
+*          which ends at the end of the chunk
+\***********************************************************************/
+
+LOCAL Errors readAuthenticatedBlock(ChunkInfo *chunkInfo)
+{
+  Errors error;
+
+  assert(chunkInfo != NULL);
+  assert(chunkInfo->authenticated.cryptInfo != NULL);
+  assert(chunkInfo->authenticated.buffer != NULL);
+
+  // read nonce
+  if (!chunkInfo->authenticated.nonceFlag)
+  {
+    byte nonce[CRYPT_NONCE_LENGTH+4];
+
+    if ((chunkInfo->size-chunkInfo->index) < sizeof(nonce))
+    {
+      return ERROR_INCOMPLETE_ARCHIVE;
+    }
+    error = readChunkData(chunkInfo,nonce,sizeof(nonce),NULL);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    memCopyFast(chunkInfo->authenticated.nonce,CRYPT_NONCE_LENGTH,nonce,CRYPT_NONCE_LENGTH);
+    chunkInfo->authenticated.nonceFlag = TRUE;
+  }
+
+  // get block size
+  uint64 restSize = chunkInfo->size-chunkInfo->index;
+  if (restSize < CRYPT_TAG_LENGTH)
+  {
+    return ERROR_INCOMPLETE_ARCHIVE;
+  }
+  ulong n        = (ulong)MIN(restSize,CRYPT_AUTHENTICATED_BLOCK_LENGTH+CRYPT_TAG_LENGTH);
+  bool  lastFlag = ((uint64)n == restSize);
+
+  // read block
+  error = readChunkData(chunkInfo,chunkInfo->authenticated.buffer,n,NULL);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  // decrypt and verify block
+  error = Crypt_decryptAuthenticated(chunkInfo->authenticated.cryptInfo,
+                                     chunkInfo->authenticated.nonce,
+                                     chunkInfo->authenticated.blockIndex,
+                                     lastFlag,
+                                     chunkInfo->authenticated.buffer,
+                                     n-CRYPT_TAG_LENGTH,
+                                     &chunkInfo->authenticated.buffer[n-CRYPT_TAG_LENGTH]
+                                    );
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  chunkInfo->authenticated.blockIndex++;
+  chunkInfo->authenticated.length = n-CRYPT_TAG_LENGTH;
+  chunkInfo->authenticated.index  = 0L;
+
+  return ERROR_NONE;
+}
+
 /*---------------------------------------------------------------------*/
 
 Errors Chunk_initAll(void)
@@ -2125,6 +2383,10 @@ Errors __Chunk_init(const char      *__fileName__,
 
   chunkInfo->data            = data;
 
+  chunkInfo->authenticated.cryptInfo = NULL;
+  chunkInfo->authenticated.buffer    = NULL;
+  resetAuthenticatedData(chunkInfo);
+
   #ifdef NDEBUG
     initDefinition(chunkInfo->definition,chunkInfo->data);
   #else /* not NDEBUG */
@@ -2166,6 +2428,33 @@ void __Chunk_done(const char *__fileName__,
   #else /* not NDEBUG */
     doneDefinition(__fileName__,__lineNb__,chunkInfo->definition,chunkInfo->data);
   #endif /* NDEBUG */
+
+  if (chunkInfo->authenticated.buffer != NULL) free(chunkInfo->authenticated.buffer);
+}
+
+void Chunk_setDataCrypt(ChunkInfo *chunkInfo, CryptInfo *cryptInfo)
+{
+  assert(chunkInfo != NULL);
+  DEBUG_CHECK_RESOURCE_TRACE(chunkInfo);
+  assert(cryptInfo != NULL);
+
+  if (Crypt_isAuthenticated(cryptInfo->cryptAlgorithm))
+  {
+    if (chunkInfo->authenticated.buffer == NULL)
+    {
+      chunkInfo->authenticated.buffer = (byte*)malloc(CRYPT_AUTHENTICATED_BLOCK_LENGTH+CRYPT_TAG_LENGTH);
+      if (chunkInfo->authenticated.buffer == NULL)
+      {
+        HALT_INSUFFICIENT_MEMORY();
+      }
+    }
+    chunkInfo->authenticated.cryptInfo = cryptInfo;
+  }
+  else
+  {
+    chunkInfo->authenticated.cryptInfo = NULL;
+  }
+  resetAuthenticatedData(chunkInfo);
 }
 
 Errors Chunk_next(const ChunkIO *chunkIO,
@@ -2392,6 +2681,7 @@ Errors __Chunk_open(const char        *__fileName__,
   chunkInfo->offset    = chunkHeader->offset;
   chunkInfo->mode      = CHUNK_MODE_READ;
   chunkInfo->index     = 0LL;
+  resetAuthenticatedData(chunkInfo);
 
 chunkInfo->chunkSize = ALIGN(dataSize,chunkInfo->alignment);
 //chunkInfo->chunkSize = getDefinitionSize(chunkInfo->definition,chunkInfo->alignment,NULL,0);
@@ -2490,6 +2780,11 @@ Errors __Chunk_create(const char *__fileName__,
   chunkInfo->offset = 0LL;
   chunkInfo->mode   = CHUNK_MODE_WRITE;
   chunkInfo->index  = 0LL;
+  resetAuthenticatedData(chunkInfo);
+  if (chunkInfo->authenticated.cryptInfo != NULL)
+  {
+    Crypt_randomize(chunkInfo->authenticated.nonce,CRYPT_NONCE_LENGTH);
+  }
 
   // get size of chunk (without data elements)
   chunkInfo->chunkSize = Chunk_getSize(chunkInfo,chunkInfo->data,0);
@@ -2572,6 +2867,18 @@ Errors Chunk_close(ChunkInfo *chunkInfo)
       break;
     case CHUNK_MODE_WRITE:
       {
+        // write last authenticated data block (Note: nothing is written if there is no data)
+        if (   (chunkInfo->authenticated.cryptInfo != NULL)
+            && (chunkInfo->authenticated.nonceFlag || (chunkInfo->authenticated.length > 0L))
+           )
+        {
+          error = writeAuthenticatedBlock(chunkInfo,TRUE);
+          if (error != ERROR_NONE)
+          {
+            return error;
+          }
+        }
+
         // save offset
         uint64 offset;
         error = chunkInfo->io->tell(chunkInfo->ioUserData,&offset);
@@ -2815,44 +3122,60 @@ Errors Chunk_readData(ChunkInfo *chunkInfo,
 
   assert(chunkInfo != NULL);
   DEBUG_CHECK_RESOURCE_TRACE(chunkInfo);
-  assert(chunkInfo->io != NULL);
-  assert(chunkInfo->io->read != NULL);
   assert(data != NULL);
 
-  // limit size to read to rest
-  if ((uint64)size > (chunkInfo->size-chunkInfo->index))
+  if (chunkInfo->authenticated.cryptInfo != NULL)
   {
-    size = (ulong)(chunkInfo->size-chunkInfo->index);
-  }
+    // read data from authenticated blocks
+    ulong n = 0L;
+    while (n < size)
+    {
+      if (chunkInfo->authenticated.index >= chunkInfo->authenticated.length)
+      {
+        if (chunkInfo->index >= chunkInfo->size)
+        {
+          break;
+        }
+        error = readAuthenticatedBlock(chunkInfo);
+        if (error != ERROR_NONE)
+        {
+          return error;
+        }
+      }
 
-  // read data
-  ulong n;
-  error = chunkInfo->io->read(chunkInfo->ioUserData,data,size,&n);
-  if (error != ERROR_NONE)
-  {
-    return error;
-  }
-  if (bytesRead != NULL)
-  {
-    // return number of read bytes
-    (*bytesRead) = n;
+      ulong bytesAvailable = MIN(size-n,chunkInfo->authenticated.length-chunkInfo->authenticated.index);
+      memCopyFast((byte*)data+n,
+                  bytesAvailable,
+                  &chunkInfo->authenticated.buffer[chunkInfo->authenticated.index],
+                  bytesAvailable
+                 );
+      chunkInfo->authenticated.index += bytesAvailable;
+      n += bytesAvailable;
+    }
+    if (bytesRead != NULL)
+    {
+      // return number of read bytes
+      (*bytesRead) = n;
+    }
+    else
+    {
+      // check if read all requested data
+      if (size != n)
+      {
+        return ERROR_INCOMPLETE_ARCHIVE;
+      }
+    }
   }
   else
   {
-    // check if read all requested data
-    if (size != n)
+    // read data
+    error = readChunkData(chunkInfo,data,size,bytesRead);
+    if (error != ERROR_NONE)
     {
-      return ERROR_(IO,errno);
+      return error;
     }
   }
 
-  // increment indizes
-  chunkInfo->index += (uint64)n;
-  if (chunkInfo->parentChunkInfo != NULL)
-  {
-    chunkInfo->parentChunkInfo->index += (uint64)n;
-  }
-
   return ERROR_NONE;
 }
 
@@ -2865,23 +3188,37 @@ Errors Chunk_writeData(ChunkInfo  *chunkInfo,
 
   assert(chunkInfo != NULL);
   DEBUG_CHECK_RESOURCE_TRACE(chunkInfo);
-  assert(chunkInfo->io != NULL);
-  assert(chunkInfo->io->write != NULL);
 
-  // write data
-  error = chunkInfo->io->write(chunkInfo->ioUserData,data,size);
-  if (error != ERROR_NONE)
+  if (chunkInfo->authenticated.cryptInfo != NULL)
   {
-    return error;
-  }
+    // write data into authenticated blocks (Note: write full block only if there is more data, thus last block is never empty)
+    const byte *p = (const byte*)data;
+    while (size > 0L)
+    {
+      if (chunkInfo->authenticated.length >= CRYPT_AUTHENTICATED_BLOCK_LENGTH)
+      {
+        error = writeAuthenticatedBlock(chunkInfo,FALSE);
+        if (error != ERROR_NONE)
+        {
+          return error;
+        }
+      }
 
-  // increment indizes and increase sizes
-  chunkInfo->size  += (uint64)size;
-  chunkInfo->index += (uint64)size;
-  if (chunkInfo->parentChunkInfo != NULL)
+      ulong n = MIN(size,CRYPT_AUTHENTICATED_BLOCK_LENGTH-chunkInfo->authenticated.length);
+      memCopyFast(&chunkInfo->authenticated.buffer[chunkInfo->authenticated.length],n,p,n);
+      chunkInfo->authenticated.length += n;
+      p    += n;
+      size -= n;
+    }
+  }
+  else
   {
-    chunkInfo->parentChunkInfo->index += (uint64)size;
-    chunkInfo->parentChunkInfo->size  += (uint64)size;
+    // write data
+    error = writeChunkData(chunkInfo,data,size);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
   }
 
   return ERROR_NONE;
@@ -217,6 +217,17 @@ typedef struct ChunkInfo
   uint64           index;             // current position inside chunk 0..size
 
   void             *data;             // chunk data
+
+  struct
+  {
+    CryptInfo      *cryptInfo;        // crypt info for authenticated data blocks or NULL
+    byte           nonce[CRYPT_NONCE_LENGTH];
+    bool           nonceFlag;         // TRUE iff nonce written/read
+    uint64         blockIndex;        // index of next data block
+    byte           *buffer;           // data block buffer
+    ulong          length;            // length of data in buffer [bytes]
+    ulong          index;             // read index in buffer [bytes]
+  } authenticated;                    // authenticated data (AEAD crypt algorithms only)
 } ChunkInfo;
 
 /***************************** Variables *******************************/
@@ -345,6 +356,22 @@ void __Chunk_done(const char *__fileName__,
                  );
 #endif /* NDEBUG */
 
+/***********************************************************************\
+* Name   : Chunk_setDataCrypt
+* Purpose: set crypt info for data of chunk
+* Input  : chunkInfo - chunk info block
+*          cryptInfo - crypt info for data
+* Output : -
+* Return : -
+* Notes  : if crypt algorithm is an authenticated algorithm, data
+*          written/read with Chunk_writeData()/Chunk_readData() is
+*          encrypted/decrypted and authenticated in blocks of
+*          CRYPT_AUTHENTICATED_BLOCK_LENGTH bytes; otherwise data is
+*          written/read as is
+\***********************************************************************/
+
+void Chunk_setDataCrypt(ChunkInfo *chunkInfo, CryptInfo *cryptInfo);
+
 /***********************************************************************\
 * Name   : Chunk_next
 * Purpose: get next chunk header
@@ -583,7 +610,8 @@ INLINE bool Chunk_eofSub(ChunkInfo *chunkInfo)
 {
   assert(chunkInfo != NULL);
 
-  return chunkInfo->index >= chunkInfo->size;
+  return    (chunkInfo->index >= chunkInfo->size)
+         && (chunkInfo->authenticated.index >= chunkInfo->authenticated.length);
 }
 #endif /* NDEBUG || __CHUNKS_IMPLEMENTATION__ */
 
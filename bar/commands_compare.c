@@ -227,6 +227,176 @@ LOCAL_INLINE ulong compare(const void *p0, const void *p1, ulong length)
   return i;
 }
 
+/***********************************************************************\
+* Name   : compareHoles
+* Purpose: compare holes of sparse file entry with file content
+* Input  : fileHandle   - file handle
+*          fileHoleList - file hole list
+*          fileName     - file name
+*          buffer0,buffer1 - buffers for temporary data
+*          bufferSize   - size of data buffer
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : holes must read as zero bytes in the file
+\***********************************************************************/
+
+LOCAL Errors compareHoles(FileHandle         *fileHandle,
+                          const FileHoleList *fileHoleList,
+                          ConstString        fileName,
+                          byte               *buffer0,
+                          byte               *buffer1,
+                          uint               bufferSize
+                         )
+{
+  assert(fileHandle != NULL);
+  assert(fileHoleList != NULL);
+  assert(fileName != NULL);
+  assert(buffer0 != NULL);
+  assert(buffer1 != NULL);
+
+  memClear(buffer0,bufferSize);
+
+  const FileHoleNode *fileHoleNode;
+  LIST_ITERATE(fileHoleList,fileHoleNode)
+  {
+    Errors error = File_seek(fileHandle,fileHoleNode->offset);
+    if (error != ERROR_NONE)
+    {
+      printInfo(1,"FAIL!\n");
+      printError(_("cannot read file '%s' (error: %s)"),
+                 String_cString(fileName),
+                 Error_getText(error)
+                );
+      return error;
+    }
+
+    uint64 length = 0LL;
+    while (length < fileHoleNode->size)
+    {
+      ulong bufferLength = (ulong)MIN(fileHoleNode->size-length,bufferSize);
+
+      error = File_read(fileHandle,buffer1,bufferLength,NULL);
+      if (error != ERROR_NONE)
+      {
+        printInfo(1,"FAIL!\n");
+        printError(_("cannot read file '%s' (error: %s)"),
+                   String_cString(fileName),
+                   Error_getText(error)
+                  );
+        return error;
+      }
+
+      ulong diffIndex = compare(buffer0,buffer1,bufferLength);
+      if (diffIndex < bufferLength)
+      {
+        printInfo(1,"FAIL!\n");
+        printError(_("'%s' differ at offset %"PRIu64),
+                   String_cString(fileName),
+                   fileHoleNode->offset+length+(uint64)diffIndex
+                  );
+        return ERROR_ENTRIES_DIFFER;
+      }
+
+      length += (uint64)bufferLength;
+    }
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : compareReference
+* Purpose: compare content of deduplicated file entry with content of
+*          referenced file
+* Input  : fileHandle      - file handle
+*          fileName        - file name
+*          referenceName   - name of referenced file
+*          size            - file size [bytes]
+*          buffer0,buffer1 - buffers for temporary data
+*          bufferSize      - size of data buffer
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : the referenced file itself is compared with the archive
+*          content when its entry is compared
+\***********************************************************************/
+
+LOCAL Errors compareReference(FileHandle  *fileHandle,
+                              ConstString fileName,
+                              ConstString referenceName,
+                              uint64      size,
+                              byte        *buffer0,
+                              byte        *buffer1,
+                              uint        bufferSize
+                             )
+{
+  assert(fileHandle != NULL);
+  assert(fileName != NULL);
+  assert(referenceName != NULL);
+  assert(buffer0 != NULL);
+  assert(buffer1 != NULL);
+
+  // open referenced file
+  FileHandle referenceFileHandle;
+  Errors error = File_open(&referenceFileHandle,referenceName,FILE_OPEN_READ|FILE_OPEN_NO_ATIME|FILE_OPEN_NO_CACHE);
+  if (error != ERROR_NONE)
+  {
+    printInfo(1,"FAIL!\n");
+    printError(_("cannot open file '%s' (error: %s)"),
+               String_cString(referenceName),
+               Error_getText(error)
+              );
+    return error;
+  }
+
+  // compare content
+  uint64 length = 0LL;
+  while (length < size)
+  {
+    ulong bufferLength = (ulong)MIN(size-length,bufferSize);
+
+    error = File_read(&referenceFileHandle,buffer0,bufferLength,NULL);
+    if (error != ERROR_NONE)
+    {
+      printInfo(1,"FAIL!\n");
+      printError(_("cannot read file '%s' (error: %s)"),
+                 String_cString(referenceName),
+                 Error_getText(error)
+                );
+      break;
+    }
+    error = File_read(fileHandle,buffer1,bufferLength,NULL);
+    if (error != ERROR_NONE)
+    {
+      printInfo(1,"FAIL!\n");
+      printError(_("cannot read file '%s' (error: %s)"),
+                 String_cString(fileName),
+                 Error_getText(error)
+                );
+      break;
+    }
+
+    ulong diffIndex = compare(buffer0,buffer1,bufferLength);
+    if (diffIndex < bufferLength)
+    {
+      error = ERROR_ENTRIES_DIFFER;
+
+      printInfo(1,"FAIL!\n");
+      printError(_("'%s' differ at offset %"PRIu64),
+                 String_cString(fileName),
+                 length+(uint64)diffIndex
+                );
+      break;
+    }
+
+    length += (uint64)bufferLength;
+  }
+
+  // close referenced file
+  (void)File_close(&referenceFileHandle);
+
+  return error;
+}
+
 /***********************************************************************\
 * Name   : compareFileEntry
 * Purpose: compare a file entry in archive
@@ -270,7 +440,10 @@ LOCAL Errors compareFileEntry(ArchiveHandle     *archiveHandle,
   CompressAlgorithms deltaCompressAlgorithm,byteCompressAlgorithm;
   String             fileName = String_new();
   FileInfo           fileInfo;
+  FileHoleList       fileHoleList;
+  String             referenceName = String_new();
   uint64             fragmentOffset,fragmentSize;
+  File_initHoles(&fileHoleList);
   error = Archive_readFileEntry(&archiveEntryInfo,
                                 archiveHandle,
                                 &deltaCompressAlgorithm,
@@ -282,6 +455,8 @@ LOCAL Errors compareFileEntry(ArchiveHandle     *archiveHandle,
                                 fileName,
                                 &fileInfo,
                                 NULL,  // fileExtendedAttributeList
+                                &fileHoleList,
+                                referenceName,
                                 NULL,  // deltaSourceName
                                 NULL,  // deltaSourceSize
                                 &fragmentOffset,
@@ -293,10 +468,12 @@ LOCAL Errors compareFileEntry(ArchiveHandle     *archiveHandle,
                String_cString(archiveHandle->printableStorageName),
                Error_getText(error)
               );
+    File_doneHoles(&fileHoleList);
+    String_delete(referenceName);
     String_delete(fileName);
     return error;
   }
-  DEBUG_TESTCODE() { Archive_closeEntry(&archiveEntryInfo); String_delete(fileName); return DEBUG_TESTCODE_ERROR(); }
+  DEBUG_TESTCODE() { Archive_closeEntry(&archiveEntryInfo); File_doneHoles(&fileHoleList); String_delete(referenceName); String_delete(fileName); return DEBUG_TESTCODE_ERROR(); }
 
   if (   (List_isEmpty(includeEntryList) || EntryList_match(includeEntryList,fileName,PATTERN_MATCH_MODE_EXACT))
       && !PatternList_match(excludePatternList,fileName,PATTERN_MATCH_MODE_EXACT)
@@ -310,6 +487,8 @@ LOCAL Errors compareFileEntry(ArchiveHandle     *archiveHandle,
       printInfo(1,"FAIL!\n");
       printError(_("file '%s' not found!"),String_cString(fileName));
       (void)Archive_closeEntry(&archiveEntryInfo);
+      File_doneHoles(&fileHoleList);
+      String_delete(referenceName);
       String_delete(fileName);
       return ERROR_FILE_NOT_FOUND_;
     }
@@ -318,6 +497,8 @@ LOCAL Errors compareFileEntry(ArchiveHandle     *archiveHandle,
       printInfo(1,"FAIL!\n");
       printError(_("'%s' is not a file!"),String_cString(fileName));
       (void)Archive_closeEntry(&archiveEntryInfo);
+      File_doneHoles(&fileHoleList);
+      String_delete(referenceName);
       String_delete(fileName);
       return ERROR_WRONG_ENTRY_TYPE;
     }
@@ -333,10 +514,12 @@ LOCAL Errors compareFileEntry(ArchiveHandle     *archiveHandle,
                  Error_getText(error)
                 );
       (void)Archive_closeEntry(&archiveEntryInfo);
+      File_doneHoles(&fileHoleList);
+      String_delete(referenceName);
       String_delete(fileName);
       return error;
     }
-    DEBUG_TESTCODE() { (void)File_close(&fileHandle); Archive_closeEntry(&archiveEntryInfo); String_delete(fileName); return DEBUG_TESTCODE_ERROR(); }
+    DEBUG_TESTCODE() { (void)File_close(&fileHandle); Archive_closeEntry(&archiveEntryInfo); File_doneHoles(&fileHoleList); String_delete(referenceName); String_delete(fileName); return DEBUG_TESTCODE_ERROR(); }
 
     // check file size
     if (fileInfo.size != File_getSize(&fileHandle))
@@ -349,6 +532,8 @@ LOCAL Errors compareFileEntry(ArchiveHandle     *archiveHandle,
                 );
       File_close(&fileHandle);
       (void)Archive_closeEntry(&archiveEntryInfo);
+      File_doneHoles(&fileHoleList);
+      String_delete(referenceName);
       String_delete(fileName);
       return ERROR_ENTRIES_DIFFER;
     }
@@ -364,20 +549,51 @@ LOCAL Errors compareFileEntry(ArchiveHandle     *archiveHandle,
                 );
       File_close(&fileHandle);
       (void)Archive_closeEntry(&archiveEntryInfo);
+      File_doneHoles(&fileHoleList);
+      String_delete(referenceName);
       String_delete(fileName);
       return error;
     }
-    DEBUG_TESTCODE() { (void)File_close(&fileHandle); Archive_closeEntry(&archiveEntryInfo); String_delete(fileName); return DEBUG_TESTCODE_ERROR(); }
-
-    // compare archive and file content
-    uint64 length    = 0LL;
-    bool   equalFlag = TRUE;
-    ulong  diffIndex = 0L;
-    while (   (length < fragmentSize)
+    DEBUG_TESTCODE() { (void)File_close(&fileHandle); Archive_closeEntry(&archiveEntryInfo); File_doneHoles(&fileHoleList); String_delete(referenceName); String_delete(fileName); return DEBUG_TESTCODE_ERROR(); }
+
+    // compare archive and file content (Note: data of holes is not stored)
+    const FileHoleNode *fileHoleNode  = fileHoleList.head;
+    uint64             dataSize      = File_getDataSize(&fileHoleList,fragmentOffset,fragmentSize);
+    uint64             dataOffset    = fragmentOffset;
+    uint64             dataRemaining = 0LL;
+    uint64             length        = 0LL;
+    bool               equalFlag     = TRUE;
+    ulong              diffIndex     = 0L;
+    while (   (length < dataSize)
            && equalFlag
           )
     {
-      ulong bufferLength = (ulong)MIN(fragmentSize-length,bufferSize);
+      // get next data, seek to data
+      if (dataRemaining == 0LL)
+      {
+        dataOffset = File_getNextData(&fileHoleNode,dataOffset,fragmentOffset+fragmentSize,&dataRemaining);
+        if (dataRemaining == 0LL)
+        {
+          error = ERROR_CORRUPT_DATA;
+          printInfo(1,"FAIL!\n");
+          printError(_("invalid holes in 'file' entry '%s'!"),
+                     String_cString(fileName)
+                    );
+          break;
+        }
+        error = File_seek(&fileHandle,dataOffset);
+        if (error != ERROR_NONE)
+        {
+          printInfo(1,"FAIL!\n");
+          printError(_("cannot read file '%s' (error: %s)"),
+                     String_cString(fileName),
+                     Error_getText(error)
+                    );
+          break;
+        }
+      }
+
+      ulong bufferLength = (ulong)MIN(dataRemaining,bufferSize);
 
       // read archive, file
       error = Archive_readData(&archiveEntryInfo,buffer0,bufferLength);
@@ -413,23 +629,37 @@ LOCAL Errors compareFileEntry(ArchiveHandle     *archiveHandle,
         printInfo(1,"FAIL!\n");
         printError(_("'%s' differ at offset %"PRIu64),
                    String_cString(fileName),
-                   fragmentOffset+length+(uint64)diffIndex
+                   dataOffset+(uint64)diffIndex
                   );
         break;
       }
 
-      length += (uint64)bufferLength;
+      dataOffset    += (uint64)bufferLength;
+      dataRemaining -= (uint64)bufferLength;
+      length        += (uint64)bufferLength;
 
-      printInfo(2,"%3d%%\b\b\b\b",(uint)((length*100LL)/fragmentSize));
+      printInfo(2,"%3d%%\b\b\b\b",(uint)((length*100LL)/dataSize));
+    }
+    if (error == ERROR_NONE)
+    {
+      // compare holes
+      error = compareHoles(&fileHandle,&fileHoleList,fileName,buffer0,buffer1,bufferSize);
+    }
+    if ((error == ERROR_NONE) && !String_isEmpty(referenceName))
+    {
+      // compare with referenced file
+      error = compareReference(&fileHandle,fileName,referenceName,fileInfo.size,buffer0,buffer1,bufferSize);
     }
     if (error != ERROR_NONE)
     {
       File_close(&fileHandle);
       (void)Archive_closeEntry(&archiveEntryInfo);
+      File_doneHoles(&fileHoleList);
+      String_delete(referenceName);
       String_delete(fileName);
       return error;
     }
-    DEBUG_TESTCODE() { File_close(&fileHandle); Archive_closeEntry(&archiveEntryInfo); String_delete(fileName); return DEBUG_TESTCODE_ERROR(); }
+    DEBUG_TESTCODE() { File_close(&fileHandle); Archive_closeEntry(&archiveEntryInfo); File_doneHoles(&fileHoleList); String_delete(referenceName); String_delete(fileName); return DEBUG_TESTCODE_ERROR(); }
 
     printInfo(2,"    \b\b\b\b");
 
@@ -449,7 +679,11 @@ LOCAL Errors compareFileEntry(ArchiveHandle     *archiveHandle,
         assert(fragmentNode != NULL);
 //FragmentList_print(fragmentNode,String_cString(fileName),FALSE);
 
-        // add fragment to file fragment list
+        // add fragment to file fragment list (data of a duplicate is stored complete in referenced file)
+        if (!String_isEmpty(referenceName))
+        {
+          FragmentList_addRange(fragmentNode,0LL,fileInfo.size);
+        }
         FragmentList_addRange(fragmentNode,fragmentOffset,fragmentSize);
 
         // discard fragment list if file is complete
@@ -479,23 +713,33 @@ LOCAL Errors compareFileEntry(ArchiveHandle     *archiveHandle,
       printInfo(1,"FAIL!\n");
       printError(_("unexpected data at end of file entry '%s'!"),String_cString(fileName));
       (void)Archive_closeEntry(&archiveEntryInfo);
+      File_doneHoles(&fileHoleList);
+      String_delete(referenceName);
       String_delete(fileName);
       return error;
     }
 
     // get size/fragment info
-    char sizeString[32];
+    uint64 size = String_isEmpty(referenceName) ? fragmentSize : fileInfo.size;
+    char   sizeString[32];
     if (globalOptions.humanFormatFlag)
     {
-      getHumanSizeString(sizeString,sizeof(sizeString),fragmentSize);
+      getHumanSizeString(sizeString,sizeof(sizeString),size);
     }
     else
     {
-      stringFormat(sizeString,sizeof(sizeString),"%"PRIu64,fragmentSize);
+      stringFormat(sizeString,sizeof(sizeString),"%"PRIu64,size);
     }
     char fragmentString[256];
     stringClear(fragmentString);
-    if (fragmentSize < fileInfo.size)
+    if (!String_isEmpty(referenceName))
+    {
+      stringFormat(fragmentString,sizeof(fragmentString),
+                   ", duplicate of '%s'",
+                   String_cString(referenceName)
+                  );
+    }
+    else if (fragmentSize < fileInfo.size)
     {
       stringFormat(fragmentString,sizeof(fragmentString),
                    ", fragment %*"PRIu64"..%*"PRIu64,
@@ -523,6 +767,8 @@ LOCAL Errors compareFileEntry(ArchiveHandle     *archiveHandle,
   }
 
   // free resources
+  File_doneHoles(&fileHoleList);
+  String_delete(referenceName);
   String_delete(fileName);
 
   return ERROR_NONE;
@@ -1213,7 +1459,9 @@ LOCAL Errors compareHardLinkEntry(ArchiveHandle     *archiveHandle,
   StringList         fileNameList;
   StringList_init(&fileNameList);
   FileInfo           fileInfo;
+  FileHoleList       fileHoleList;
   uint64             fragmentOffset,fragmentSize;
+  File_initHoles(&fileHoleList);
   error = Archive_readHardLinkEntry(&archiveEntryInfo,
                                     archiveHandle,
                                     &deltaCompressAlgorithm,
@@ -1225,6 +1473,7 @@ LOCAL Errors compareHardLinkEntry(ArchiveHandle     *archiveHandle,
                                     &fileNameList,
                                     &fileInfo,
                                     NULL,  // fileExtendedAttributeList
+                                    &fileHoleList,
                                     NULL,  // deltaSourceName
                                     NULL,  // deltaSourceSize
                                     &fragmentOffset,
@@ -1236,10 +1485,11 @@ LOCAL Errors compareHardLinkEntry(ArchiveHandle     *archiveHandle,
                String_cString(archiveHandle->printableStorageName),
                Error_getText(error)
               );
+    File_doneHoles(&fileHoleList);
     StringList_done(&fileNameList);
     return error;
   }
-  DEBUG_TESTCODE() { Archive_closeEntry(&archiveEntryInfo); StringList_done(&fileNameList); return DEBUG_TESTCODE_ERROR(); }
+  DEBUG_TESTCODE() { Archive_closeEntry(&archiveEntryInfo); File_doneHoles(&fileHoleList); StringList_done(&fileNameList); return DEBUG_TESTCODE_ERROR(); }
 
   bool        comparedDataFlag = FALSE;
   ConstString fileName;
@@ -1348,15 +1598,44 @@ LOCAL Errors compareHardLinkEntry(ArchiveHandle     *archiveHandle,
         }
         DEBUG_TESTCODE() { (void)File_close(&fileHandle); error = DEBUG_TESTCODE_ERROR(); break; }
 
-        // compare archive and hard link content
-        uint64 length    = 0LL;
-        bool   equalFlag = TRUE;
-        ulong  diffIndex = 0L;
-        while (   (length < fragmentSize)
+        // compare archive and hard link content (Note: data of holes is not stored)
+        const FileHoleNode *fileHoleNode  = fileHoleList.head;
+        uint64             dataSize      = File_getDataSize(&fileHoleList,fragmentOffset,fragmentSize);
+        uint64             dataOffset    = fragmentOffset;
+        uint64             dataRemaining = 0LL;
+        uint64             length        = 0LL;
+        bool               equalFlag     = TRUE;
+        ulong              diffIndex     = 0L;
+        while (   (length < dataSize)
                && equalFlag
               )
         {
-          ulong bufferLength = (ulong)MIN(fragmentSize-length,bufferSize);
+          // get next data, seek to data
+          if (dataRemaining == 0LL)
+          {
+            dataOffset = File_getNextData(&fileHoleNode,dataOffset,fragmentOffset+fragmentSize,&dataRemaining);
+            if (dataRemaining == 0LL)
+            {
+              error = ERROR_CORRUPT_DATA;
+              printInfo(1,"FAIL!\n");
+              printError(_("invalid holes in 'hard link' entry '%s'!"),
+                         String_cString(fileName)
+                        );
+              break;
+            }
+            error = File_seek(&fileHandle,dataOffset);
+            if (error != ERROR_NONE)
+            {
+              printInfo(1,"FAIL!\n");
+              printError(_("cannot read file '%s' (error: %s)"),
+                         String_cString(fileName),
+                         Error_getText(error)
+                        );
+              break;
+            }
+          }
+
+          ulong bufferLength = (ulong)MIN(dataRemaining,bufferSize);
 
           // read archive, file
           error = Archive_readData(&archiveEntryInfo,buffer0,bufferLength);
@@ -1392,14 +1671,21 @@ LOCAL Errors compareHardLinkEntry(ArchiveHandle     *archiveHandle,
             printInfo(1,"FAIL!\n");
             printError(_("'%s' differ at offset %"PRIu64),
                        String_cString(fileName),
-                       fragmentOffset+length+(uint64)diffIndex
+                       dataOffset+(uint64)diffIndex
                       );
             break;
           }
 
-          length += (uint64)bufferLength;
+          dataOffset    += (uint64)bufferLength;
+          dataRemaining -= (uint64)bufferLength;
+          length        += (uint64)bufferLength;
 
-          printInfo(2,"%3d%%\b\b\b\b",(uint)((length*100LL)/fragmentSize));
+          printInfo(2,"%3d%%\b\b\b\b",(uint)((length*100LL)/dataSize));
+        }
+        if (error == ERROR_NONE)
+        {
+          // compare holes
+          error = compareHoles(&fileHandle,&fileHoleList,fileName,buffer0,buffer1,bufferSize);
         }
         if (error != ERROR_NONE)
         {
@@ -1537,6 +1823,7 @@ LOCAL Errors compareHardLinkEntry(ArchiveHandle     *archiveHandle,
   }
 
   // free resources
+  File_doneHoles(&fileHoleList);
   StringList_done(&fileNameList);
 
   return ERROR_NONE;
@@ -1790,6 +2077,7 @@ LOCAL Errors compareEntry(ArchiveHandle     *archiveHandle,
       break;
     case ARCHIVE_ENTRY_TYPE_SALT:
     case ARCHIVE_ENTRY_TYPE_KEY:
+    case ARCHIVE_ENTRY_TYPE_SOLID:
     case ARCHIVE_ENTRY_TYPE_SIGNATURE:
       #ifndef NDEBUG
         HALT_INTERNAL_ERROR_UNREACHABLE();
@@ -1928,11 +2216,121 @@ LOCAL void compareThreadCode(CompareInfo *compareInfo)
     freeEntryMsg(&entryMsg,NULL);
   }
 
+  // free pooled compress/crypt contexts of thread
+  Compress_doneThreadContexts();
+  Crypt_doneThreadContexts();
+
   // free resources
   free(buffer1);
   free(buffer0);
 }
 
+/***********************************************************************\
+* Name   : compareTOCEntries
+* Purpose: compare included entries of archive via table of contents
+* Input  : compareInfo        - compare info
+*          archiveHandle      - archive handle
+*          tocList            - table of contents of archive
+*          compareThreadCount - number of compare threads
+*          buffer0,buffer1    - buffers for temporary data or NULL if
+*                               compare threads are used
+*          bufferSize         - size of data buffer
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : only entries matching the include/exclude lists are read;
+*          all other entries are not read from the storage
+\***********************************************************************/
+
+LOCAL Errors compareTOCEntries(CompareInfo          *compareInfo,
+                               ArchiveHandle        *archiveHandle,
+                               const ArchiveTOCList *tocList,
+                               uint                 compareThreadCount,
+                               byte                 *buffer0,
+                               byte                 *buffer1,
+                               uint                 bufferSize
+                              )
+{
+  assert(compareInfo != NULL);
+  assert(compareInfo->includeEntryList != NULL);
+  assert(compareInfo->jobOptions != NULL);
+  assert(archiveHandle != NULL);
+  assert(tocList != NULL);
+
+  Errors               error      = ERROR_NONE;
+  uint64               lastOffset = MAX_UINT64;
+  const ArchiveTOCNode *tocNode   = tocList->head;
+  while (   ((compareInfo->failError == ERROR_NONE) || !compareInfo->jobOptions->noStopOnErrorFlag)
+         && (tocNode != NULL)
+        )
+  {
+    // check if entry is included (Note: names of a hard link refer to the same entry)
+    if (   (tocNode->offset != lastOffset)
+        && EntryList_match(compareInfo->includeEntryList,tocNode->name,PATTERN_MATCH_MODE_EXACT)
+        && ((compareInfo->excludePatternList == NULL) || !PatternList_match(compareInfo->excludePatternList,tocNode->name,PATTERN_MATCH_MODE_EXACT))
+       )
+    {
+      // seek to entry
+      ArchiveEntryTypes archiveEntryType;
+      ArchiveCryptInfo  *archiveCryptInfo;
+      error = Archive_seek(archiveHandle,tocNode->offset);
+      if (error == ERROR_NONE)
+      {
+        error = Archive_getNextArchiveEntry(archiveHandle,
+                                            &archiveEntryType,
+                                            &archiveCryptInfo,
+                                            NULL,  // offset
+                                            NULL  // size
+                                           );
+      }
+      if ((error == ERROR_NONE) && (archiveEntryType != tocNode->type))
+      {
+        error = ERRORX_(CORRUPT_DATA,0,"%s",String_cString(archiveHandle->printableStorageName));
+      }
+      if (error != ERROR_NONE)
+      {
+        printError(_("cannot read next entry from storage '%s' (error: %s)!"),
+                   String_cString(archiveHandle->printableStorageName),
+                   Error_getText(error)
+                  );
+        if (compareInfo->failError == ERROR_NONE) compareInfo->failError = error;
+        break;
+      }
+
+      // compare entry
+      if (compareThreadCount > 1)
+      {
+        // send entry to compare threads
+        EntryMsg entryMsg;
+        entryMsg.archiveIndex     = 1;
+        entryMsg.archiveHandle    = archiveHandle;
+        entryMsg.archiveEntryType = archiveEntryType;
+        entryMsg.archiveCryptInfo = archiveCryptInfo;
+        entryMsg.offset           = tocNode->offset;
+        if (!MsgQueue_put(&compareInfo->entryMsgQueue,&entryMsg,sizeof(entryMsg)))
+        {
+          HALT_INTERNAL_ERROR("Send message to compare threads fail!");
+        }
+      }
+      else
+      {
+        error = compareEntry(archiveHandle,
+                             archiveEntryType,
+                             compareInfo,
+                             buffer0,
+                             buffer1,
+                             bufferSize
+                            );
+      }
+
+      lastOffset = tocNode->offset;
+    }
+
+    tocNode = tocNode->next;
+  }
+
+  return error;
+}
+
 /***********************************************************************\
 * Name   : compareArchive
 * Purpose: compare archive content
@@ -2101,11 +2499,38 @@ NULL, // masterSocketHandle
             !isPrintInfo(1) ? "..." : ":\n"
            );
 
+  // read included entries directly via table of contents (if available)
+  bool tocFlag = FALSE;
+  if (!List_isEmpty(compareInfo->includeEntryList))
+  {
+    ArchiveTOCList tocList;
+    Archive_initTOCList(&tocList);
+    if (Archive_readTOC(&archiveHandle,&tocList) == ERROR_NONE)
+    {
+      (void)compareTOCEntries(compareInfo,
+                              &archiveHandle,
+                              &tocList,
+                              compareThreadCount,
+                              buffer0,
+                              buffer1,
+                              BUFFER_SIZE
+                             );
+      tocFlag = TRUE;
+    }
+    else
+    {
+      // read all archive entries
+      (void)Archive_seek(&archiveHandle,0LL);
+    }
+    Archive_doneTOCList(&tocList);
+  }
+
   // read archive entries
   error = ERROR_NONE;
   CryptSignatureStates allCryptSignatureState = CRYPT_SIGNATURE_STATE_NONE;
   uint64               lastSignatureOffset    = Archive_tell(&archiveHandle);
-  while (   (compareInfo->jobOptions->skipVerifySignaturesFlag || Crypt_isValidSignatureState(allCryptSignatureState))
+  while (   !tocFlag
+         && (compareInfo->jobOptions->skipVerifySignaturesFlag || Crypt_isValidSignatureState(allCryptSignatureState))
          && ((compareInfo->failError == ERROR_NONE) || !compareInfo->jobOptions->noStopOnErrorFlag)
          && !Archive_eof(&archiveHandle)
         )
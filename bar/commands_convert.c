@@ -713,6 +713,9 @@ LOCAL Errors convertFileEntry(ArchiveHandle    *sourceArchiveHandle,
   FileInfo                  fileInfo;
   FileExtendedAttributeList fileExtendedAttributeList;
   File_initExtendedAttributes(&fileExtendedAttributeList);
+  FileHoleList              fileHoleList;
+  File_initHoles(&fileHoleList);
+  String                    referenceName = String_new();
   uint64                    fragmentOffset,fragmentSize;
   error = Archive_readFileEntry(&sourceArchiveEntryInfo,
                                 sourceArchiveHandle,
@@ -725,6 +728,8 @@ LOCAL Errors convertFileEntry(ArchiveHandle    *sourceArchiveHandle,
                                 fileName,
                                 &fileInfo,
                                 &fileExtendedAttributeList,
+                                &fileHoleList,
+                                referenceName,
                                 NULL,  // deltaSourceName
                                 NULL,  // deltaSourceSize
                                 &fragmentOffset,
@@ -736,11 +741,13 @@ LOCAL Errors convertFileEntry(ArchiveHandle    *sourceArchiveHandle,
                String_cString(sourceArchiveHandle->printableStorageName),
                Error_getText(error)
               );
+    File_doneHoles(&fileHoleList);
     File_doneExtendedAttributes(&fileExtendedAttributeList);
+    String_delete(referenceName);
     String_delete(fileName);
     return error;
   }
-  DEBUG_TESTCODE() { Archive_closeEntry(&sourceArchiveEntryInfo); File_doneExtendedAttributes(&fileExtendedAttributeList); String_delete(fileName); return DEBUG_TESTCODE_ERROR(); }
+  DEBUG_TESTCODE() { Archive_closeEntry(&sourceArchiveEntryInfo); File_doneHoles(&fileHoleList); File_doneExtendedAttributes(&fileExtendedAttributeList); String_delete(referenceName); String_delete(fileName); return DEBUG_TESTCODE_ERROR(); }
 
   // get size/fragment info
   char sizeString[32];
@@ -795,6 +802,8 @@ LOCAL Errors convertFileEntry(ArchiveHandle    *sourceArchiveHandle,
                                fileName,
                                &fileInfo,
                                &fileExtendedAttributeList,
+                               &fileHoleList,
+                               referenceName,
                                fragmentOffset,
                                fragmentSize,
                                archiveFlags
@@ -806,17 +815,20 @@ LOCAL Errors convertFileEntry(ArchiveHandle    *sourceArchiveHandle,
                Error_getText(error)
               );
     (void)Archive_closeEntry(&sourceArchiveEntryInfo);
+    File_doneHoles(&fileHoleList);
     File_doneExtendedAttributes(&fileExtendedAttributeList);
+    String_delete(referenceName);
     String_delete(fileName);
     return error;
   }
-  DEBUG_TESTCODE() { Archive_closeEntry(&destinationArchiveEntryInfo); Archive_closeEntry(&sourceArchiveEntryInfo); File_doneExtendedAttributes(&fileExtendedAttributeList); String_delete(fileName); return DEBUG_TESTCODE_ERROR(); }
+  DEBUG_TESTCODE() { Archive_closeEntry(&destinationArchiveEntryInfo); Archive_closeEntry(&sourceArchiveEntryInfo); File_doneHoles(&fileHoleList); File_doneExtendedAttributes(&fileExtendedAttributeList); String_delete(referenceName); String_delete(fileName); return DEBUG_TESTCODE_ERROR(); }
 
-  // convert archive and file content
+  // convert archive and file content (Note: data of holes is not stored)
+  uint64 dataSize = File_getDataSize(&fileHoleList,fragmentOffset,fragmentSize);
   uint64 length = 0LL;
-  while (length < fragmentSize)
+  while (length < dataSize)
   {
-    ulong bufferLength = (ulong)MIN(fragmentSize-length,bufferSize);
+    ulong bufferLength = (ulong)MIN(dataSize-length,bufferSize);
 
     // read source archive
     error = Archive_readData(&sourceArchiveEntryInfo,buffer,bufferLength);
@@ -846,17 +858,19 @@ LOCAL Errors convertFileEntry(ArchiveHandle    *sourceArchiveHandle,
 
     length += (uint64)bufferLength;
 
-    printInfo(2,"%3d%%\b\b\b\b",(uint)((length*100LL)/fragmentSize));
+    printInfo(2,"%3d%%\b\b\b\b",(uint)((length*100LL)/dataSize));
   }
   if (error != ERROR_NONE)
   {
     (void)Archive_closeEntry(&destinationArchiveEntryInfo);
     (void)Archive_closeEntry(&sourceArchiveEntryInfo);
+    File_doneHoles(&fileHoleList);
     File_doneExtendedAttributes(&fileExtendedAttributeList);
+    String_delete(referenceName);
     String_delete(fileName);
     return error;
   }
-  DEBUG_TESTCODE() { (void)Archive_closeEntry(&destinationArchiveEntryInfo); (void)Archive_closeEntry(&sourceArchiveEntryInfo); File_doneExtendedAttributes(&fileExtendedAttributeList); String_delete(fileName); return DEBUG_TESTCODE_ERROR(); }
+  DEBUG_TESTCODE() { (void)Archive_closeEntry(&destinationArchiveEntryInfo); (void)Archive_closeEntry(&sourceArchiveEntryInfo); File_doneHoles(&fileHoleList); File_doneExtendedAttributes(&fileExtendedAttributeList); String_delete(referenceName); String_delete(fileName); return DEBUG_TESTCODE_ERROR(); }
 
   printInfo(2,"    \b\b\b\b");
 
@@ -870,7 +884,9 @@ LOCAL Errors convertFileEntry(ArchiveHandle    *sourceArchiveHandle,
                Error_getText(error)
               );
     (void)Archive_closeEntry(&sourceArchiveEntryInfo);
+    File_doneHoles(&fileHoleList);
     File_doneExtendedAttributes(&fileExtendedAttributeList);
+    String_delete(referenceName);
     String_delete(fileName);
     return error;
   }
@@ -898,7 +914,9 @@ LOCAL Errors convertFileEntry(ArchiveHandle    *sourceArchiveHandle,
   }
 
   // free resources
+  File_doneHoles(&fileHoleList);
   File_doneExtendedAttributes(&fileExtendedAttributeList);
+  String_delete(referenceName);
   String_delete(fileName);
 
   return ERROR_NONE;
@@ -1411,6 +1429,8 @@ LOCAL Errors convertHardLinkEntry(ArchiveHandle    *sourceArchiveHandle,
   FileInfo                  fileInfo;
   FileExtendedAttributeList fileExtendedAttributeList;
   File_initExtendedAttributes(&fileExtendedAttributeList);
+  FileHoleList              fileHoleList;
+  File_initHoles(&fileHoleList);
   uint64                    fragmentOffset,fragmentSize;
   error = Archive_readHardLinkEntry(&sourceArchiveEntryInfo,
                                     sourceArchiveHandle,
@@ -1423,6 +1443,7 @@ LOCAL Errors convertHardLinkEntry(ArchiveHandle    *sourceArchiveHandle,
                                     &fileNameList,
                                     &fileInfo,
                                     &fileExtendedAttributeList,
+                                    &fileHoleList,
                                     NULL,  // deltaSourceName
                                     NULL,  // deltaSourceSize
                                     &fragmentOffset,
@@ -1434,11 +1455,12 @@ LOCAL Errors convertHardLinkEntry(ArchiveHandle    *sourceArchiveHandle,
                String_cString(sourceArchiveHandle->printableStorageName),
                Error_getText(error)
               );
+    File_doneHoles(&fileHoleList);
     File_doneExtendedAttributes(&fileExtendedAttributeList);
     StringList_done(&fileNameList);
     return error;
   }
-  DEBUG_TESTCODE() { Archive_closeEntry(&sourceArchiveEntryInfo); File_doneExtendedAttributes(&fileExtendedAttributeList); StringList_done(&fileNameList); return DEBUG_TESTCODE_ERROR(); }
+  DEBUG_TESTCODE() { Archive_closeEntry(&sourceArchiveEntryInfo); File_doneHoles(&fileHoleList); File_doneExtendedAttributes(&fileExtendedAttributeList); StringList_done(&fileNameList); return DEBUG_TESTCODE_ERROR(); }
 
   // get size/fragment info
   char sizeString[32];
@@ -1490,6 +1512,7 @@ LOCAL Errors convertHardLinkEntry(ArchiveHandle    *sourceArchiveHandle,
                                    &fileNameList,
                                    &fileInfo,
                                    &fileExtendedAttributeList,
+                                   &fileHoleList,
                                    fragmentOffset,
                                    fragmentSize,
                                    archiveFlags
@@ -1501,17 +1524,19 @@ LOCAL Errors convertHardLinkEntry(ArchiveHandle    *sourceArchiveHandle,
                Error_getText(error)
               );
     (void)Archive_closeEntry(&sourceArchiveEntryInfo);
+    File_doneHoles(&fileHoleList);
     File_doneExtendedAttributes(&fileExtendedAttributeList);
     StringList_done(&fileNameList);
     return error;
   }
-  DEBUG_TESTCODE() { Archive_closeEntry(&destinationArchiveEntryInfo); Archive_closeEntry(&sourceArchiveEntryInfo); File_doneExtendedAttributes(&fileExtendedAttributeList); StringList_done(&fileNameList); return DEBUG_TESTCODE_ERROR(); }
+  DEBUG_TESTCODE() { Archive_closeEntry(&destinationArchiveEntryInfo); Archive_closeEntry(&sourceArchiveEntryInfo); File_doneHoles(&fileHoleList); File_doneExtendedAttributes(&fileExtendedAttributeList); StringList_done(&fileNameList); return DEBUG_TESTCODE_ERROR(); }
 
-  // convert archive and hard link content
+  // convert archive and hard link content (Note: data of holes is not stored)
+  uint64 dataSize = File_getDataSize(&fileHoleList,fragmentOffset,fragmentSize);
   uint64 length = 0LL;
-  while (length < fragmentSize)
+  while (length < dataSize)
   {
-    ulong bufferLength = (ulong)MIN(fragmentSize-length,bufferSize);
+    ulong bufferLength = (ulong)MIN(dataSize-length,bufferSize);
 
     // read source archive
     error = Archive_readData(&sourceArchiveEntryInfo,buffer,bufferLength);
@@ -1541,12 +1566,13 @@ LOCAL Errors convertHardLinkEntry(ArchiveHandle    *sourceArchiveHandle,
 
     length += (uint64)bufferLength;
 
-    printInfo(2,"%3d%%\b\b\b\b",(uint)((length*100LL)/fragmentSize));
+    printInfo(2,"%3d%%\b\b\b\b",(uint)((length*100LL)/dataSize));
   }
   if (error != ERROR_NONE)
   {
     (void)Archive_closeEntry(&destinationArchiveEntryInfo);
     (void)Archive_closeEntry(&sourceArchiveEntryInfo);
+    File_doneHoles(&fileHoleList);
     File_doneExtendedAttributes(&fileExtendedAttributeList);
     StringList_done(&fileNameList);
     return error;
@@ -1563,6 +1589,7 @@ LOCAL Errors convertHardLinkEntry(ArchiveHandle    *sourceArchiveHandle,
                Error_getText(error)
               );
     (void)Archive_closeEntry(&sourceArchiveEntryInfo);
+    File_doneHoles(&fileHoleList);
     File_doneExtendedAttributes(&fileExtendedAttributeList);
     StringList_done(&fileNameList);
     return error;
@@ -1591,6 +1618,7 @@ LOCAL Errors convertHardLinkEntry(ArchiveHandle    *sourceArchiveHandle,
   }
 
   // free resources
+  File_doneHoles(&fileHoleList);
   File_doneExtendedAttributes(&fileExtendedAttributeList);
   StringList_done(&fileNameList);
 
@@ -1950,6 +1978,7 @@ LOCAL Errors convertEntry(ArchiveHandle     *sourceArchiveHandle,
                                     &convertInfo->destinationArchiveHandle
                                    );
       break;
+    case ARCHIVE_ENTRY_TYPE_SOLID:
     case ARCHIVE_ENTRY_TYPE_SIGNATURE:
       #ifndef NDEBUG
         HALT_INTERNAL_ERROR_UNREACHABLE();
@@ -2291,6 +2320,7 @@ LOCAL Errors convertArchive(ConvertInfo      *convertInfo,
                          CALLBACK_(NULL,NULL),  // archiveGetSizeFunction
                          CALLBACK_(NULL,NULL),  // archiveTestFunction
                          CALLBACK_(archiveStore,convertInfo),
+                         CALLBACK_(NULL,NULL),  // archiveStreamFunction
                          CALLBACK_(convertInfo->getNamePasswordFunction,convertInfo->getNamePasswordUserData),
                          convertInfo->logHandle
                         );
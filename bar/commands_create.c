@@ -15,6 +15,9 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
+#ifdef HAVE_SYS_MMAN_H
+  #include <sys/mman.h>
+#endif /* HAVE_SYS_MMAN_H */
 #include <assert.h>
 
 #include "common/arrays.h"
@@ -60,13 +63,44 @@
 
 /***************************** Constants *******************************/
 
-#define MAX_ENTRY_MSG_QUEUE 256
+#define MAX_ENTRY_MSG_QUEUE             256
+#define MAX_ENTRY_MSG_QUEUE_SINGLE_PASS (64*1024)
+
+// max. number of scanned directory entries not yet processed by collector
+#define MAX_DIRECTORY_SCAN_ENTRIES      (64*1024)
 
 // file data buffer size
 #define BUFFER_SIZE                   (64*1024)
 
-#define INCREMENTAL_LIST_FILE_ID      "BAR incremental list"
-#define INCREMENTAL_LIST_FILE_VERSION 1
+// min. size of a hole in a sparse file which is not stored
+#define MIN_SPARSE_HOLE_SIZE          (64*KB)
+
+// max. size of a file which is stored in a solid block
+#define SOLID_MAX_FILE_SIZE           (64*KB)
+
+// interval to update running info while storing entry data [ms]
+#define RUNNING_INFO_UPDATE_INTERVAL  500
+
+// max. number of concurrent storage threads (transfer of archive parts)
+#define MAX_STORAGE_THREADS           4
+
+// interval to adapt number of create threads to measured CPU load [ms]
+#define CREATE_THREAD_CONTROL_INTERVAL (2*MS_PER_S)
+
+// adaptive fragment size: min. fragment size, fragment size alignment, max. number of fragments of an entry
+#define MIN_FRAGMENT_SIZE             (4*MB)
+#define FRAGMENT_SIZE_ALIGNMENT       (1*MB)
+#define MAX_FRAGMENT_COUNT            1024
+
+// hash algorithm for detecting files with identical content
+#define DEDUPLICATE_HASH_ALGORITHM    CRYPT_HASH_ALGORITHM_SHA2_256
+#define DEDUPLICATE_HASH_LENGTH       32
+
+#define INCREMENTAL_LIST_FILE_ID        "BAR incremental list"
+#define INCREMENTAL_LIST_FILE_VERSION_1 1  // unsorted list of entries
+#define INCREMENTAL_LIST_FILE_VERSION_2 2  // sorted entries with index
+#define INCREMENTAL_LIST_FILE_VERSION_3 3  // version 2 with file system change generation
+#define INCREMENTAL_LIST_FILE_VERSION   INCREMENTAL_LIST_FILE_VERSION_3
 
 /***************************** Datatypes *******************************/
 
@@ -92,6 +126,48 @@ typedef struct
   FileCast              cast;
 } IncrementalListInfo;
 
+// new incremental list entry
+typedef struct
+{
+  const void            *name;
+  uint16                nameLength;
+  const FileCast        *cast;
+} IncrementalListEntry;
+
+// incremental list file header (version 2/3)
+typedef struct
+{
+  char   id[32];
+  uint16 version;
+  uint16 reserved[3];
+  uint64 count;                                                      // number of entries
+  uint64 indexOffset;                                                // offset of entry index
+  // version 3
+  uint64 changeGeneration;                                           // file system change generation or 0
+  byte   changeUUID[16];                                             // file system/sub-volume UUID of change generation
+} IncrementalListHeader;
+#define INCREMENTAL_LIST_HEADER_SIZE_2 offsetof(IncrementalListHeader,changeGeneration)
+
+// deduplicate dictionary key: file content hash
+typedef struct
+{
+  uint64 size;                                                       // file size [bytes]
+  byte   hash[DEDUPLICATE_HASH_LENGTH];                              // file content hash
+} DeduplicateKey;
+
+// incremental list (version 2/3)
+//   entries: FileCast, uint16 name length, name; sorted by name
+//   index  : uint64 offsets of entries
+typedef struct
+{
+  void        *data;                                                 // file data or NULL
+  uint64      size;                                                  // size of file data [bytes]
+  bool        mappedFlag;                                            // TRUE iff file data is memory mapped
+  ulong       count;                                                 // number of entries
+  const byte  *index;                                                // entry index
+  FileChangeGeneration changeGeneration;                             // file system change generation (version 3) or generation 0
+} IncrementalList;
+
 // create info
 typedef struct
 {
@@ -112,8 +188,16 @@ typedef struct
   LogHandle                   *logHandle;                            // log handle
 
   bool                        partialFlag;                           // TRUE for create incremental/differential archive
+  IncrementalList             incrementalList;                       // last incremental list (used for incremental/differental backup)
   Dictionary                  namesDictionary;                       // dictionary with files (used for incremental/differental backup)
   bool                        storeIncrementalFileInfoFlag;          // TRUE to store incremental file data
+  FileChangeGeneration        changeGeneration;                      // file system change generation at start or generation 0
+  bool                        changedDirectoriesFlag;                // TRUE iff only changed directories are traversed
+  Dictionary                  changedDirectoriesDictionary;          // directories with entries changed since last incremental list
+
+  Semaphore                   deduplicateLock;
+  Dictionary                  deduplicateDictionary;                 // dictionary with content hash->archive entry name of stored files
+  Dictionary                  deduplicateSizeDictionary;             // dictionary with sizes of stored files
 
   MsgQueue                    entryMsgQueue;                         // queue with entries to store
 
@@ -129,7 +213,22 @@ typedef struct
     uint64                    bytes;                                 // number of bytes in current storage files
   }                           storage;
   bool                        storageThreadExitFlag;
-  StringList                  storageFileList;                       // list with stored storage files
+  Dictionary                  storageFileDictionary;                 // set of stored storage file names
+  struct
+  {
+    Semaphore                 lock;
+    uint64                    nextNumber;                            // sequence number of next storage file
+    uint64                    doneNumber;                            // sequence number of next storage file to finish
+  }                           storageThreads;
+
+  struct
+  {
+    uint                      count;                                 // number of running create threads
+    uint                      minCount,maxCount;                     // min./max. number of create threads
+    uint                      stopCount;                             // number of create threads to stop
+    uint64                    cpuTime;                               // total CPU time of create threads [us]
+    bool                      quitFlag;                              // TRUE to quit create thread control
+  }                           createThreads;
 
   Errors                      failError;                             // failure error
 
@@ -145,6 +244,7 @@ typedef struct
   void                        *runningInfoUserData;                  // user data for running info call back
   Semaphore                   runningInfoLock;                       // running info lock
   RunningInfo                 runningInfo;                           // running info
+  ProgressCounters            progressCounters;                      // done/skipped/error counters in shared slots; merged into running info
   const FragmentNode          *runningInfoCurrentFragmentNode;       // current fragment node in running info
   uint64                      runningInfoCurrentLastUpdateTimestamp; // timestamp of last update current fragment node
 } CreateInfo;
@@ -157,6 +257,83 @@ typedef struct
   FileInfo   fileInfo;
 } HardLinkInfo;
 
+// scanned directory entry
+typedef struct ScanEntryNode
+{
+  LIST_NODE_HEADER(struct ScanEntryNode);
+
+  String   name;                                                     // entry name
+  FileInfo fileInfo;                                                 // entry file info
+  Errors   error;                                                    // read error or ERROR_NONE
+  bool     includedFlag;                                             // TRUE iff included by include entry
+  bool     excludedFlag;                                             // TRUE iff included and excluded by exclude pattern
+} ScanEntryNode;
+
+typedef struct
+{
+  LIST_HEADER(ScanEntryNode);
+} ScanEntryList;
+
+// scan directory states
+typedef enum
+{
+  SCAN_DIRECTORY_STATE_WAIT,                                         // wait for scan
+  SCAN_DIRECTORY_STATE_RUNNING,                                      // scan in progress
+  SCAN_DIRECTORY_STATE_DONE                                          // scan done
+} ScanDirectoryStates;
+
+// scan directory
+typedef struct ScanDirectoryNode
+{
+  LIST_NODE_HEADER(struct ScanDirectoryNode);
+
+  String              name;                                          // directory name
+  ScanDirectoryStates state;
+  uint                threadIndex;                                   // index of scan thread wait list
+  Errors              error;                                         // open error or ERROR_NONE
+  ScanEntryList       entryList;                                     // directory entries
+} ScanDirectoryNode;
+
+typedef struct
+{
+  LIST_HEADER(ScanDirectoryNode);
+} ScanDirectoryList;
+
+struct DirectoryScanner;
+
+// directory scan thread
+typedef struct
+{
+  struct DirectoryScanner *directoryScanner;
+  uint                    index;
+  ScanDirectoryList       waitList;                                  // directories to scan
+} DirectoryScanThread;
+
+// directory scanner: read directories in parallel ahead of the collector
+typedef struct DirectoryScanner
+{
+  CreateInfo          *createInfo;
+  const EntryNode     *includeEntryNode;                             // include entry
+  Semaphore           lock;
+  Dictionary          directoryDictionary;                           // directory name -> ScanDirectoryNode*
+  DirectoryScanThread *threads;
+  uint                threadCount;
+  uint                nextThreadIndex;                               // next scan thread for directories found by collector
+  ThreadPoolSet       threadSet;
+  ScanDirectoryList   doneList;                                      // scanned directories
+  ulong               entryCount;                                    // number of scanned entries not processed
+  bool                quitFlag;
+} DirectoryScanner;
+
+// directory list handle for collector
+typedef struct
+{
+  DirectoryScanner    *directoryScanner;                             // directory scanner or NULL
+  DirectoryListHandle directoryListHandle;                           // directory list handle (without scanner)
+  ScanDirectoryNode   *scanDirectoryNode;                            // scanned directory (with scanner)
+  ScanEntryNode       *scanEntryNode;                                // next scanned entry (with scanner)
+} CollectorDirectoryListHandle;
+
 // format modes
 typedef enum
 {
@@ -261,11 +438,20 @@ typedef struct
   IndexId      entityId;
 //  ArchiveTypes archiveType;
   IndexId      storageId;
-  String       intermediateFileName;                                 // intermediate archive file name
+  uint64       number;                                               // sequence number
+  String       intermediateFileName;                                 // intermediate archive file name or empty
   uint64       intermediateFileSize;                                 // intermediate archive size [bytes]
   String       archiveName;                                          // destination archive name
+  bool         streamFlag;                                           // TRUE iff archive is already streamed into storage
 } StorageMsg;
 
+// solid block of small files, one per create thread
+typedef struct
+{
+  bool             openFlag;                                         // TRUE iff solid block is open
+  ArchiveEntryInfo archiveEntryInfo;                                 // archive solid entry
+} SolidBlock;
+
 /***************************** Variables *******************************/
 
 /****************************** Macros *********************************/
@@ -337,6 +523,58 @@ LOCAL void freeStorageMsg(StorageMsg *storageMsg, void *userData)
   String_delete(storageMsg->intermediateFileName);
 }
 
+/***********************************************************************\
+* Name   : initIncrementalList
+* Purpose: initialize incremental list
+* Input  : incrementalList - incremental list variable
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void initIncrementalList(IncrementalList *incrementalList)
+{
+  assert(incrementalList != NULL);
+
+  incrementalList->data       = NULL;
+  incrementalList->size       = 0LL;
+  incrementalList->mappedFlag = FALSE;
+  incrementalList->count      = 0L;
+  incrementalList->index      = NULL;
+  memClear(&incrementalList->changeGeneration,sizeof(incrementalList->changeGeneration));
+}
+
+/***********************************************************************\
+* Name   : doneIncrementalList
+* Purpose: done incremental list
+* Input  : incrementalList - incremental list
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void doneIncrementalList(IncrementalList *incrementalList)
+{
+  assert(incrementalList != NULL);
+
+  if (incrementalList->data != NULL)
+  {
+    #ifdef HAVE_SYS_MMAN_H
+      if (incrementalList->mappedFlag)
+      {
+        munmap(incrementalList->data,(size_t)incrementalList->size);
+      }
+      else
+      {
+        free(incrementalList->data);
+      }
+    #else /* not HAVE_SYS_MMAN_H */
+      free(incrementalList->data);
+    #endif /* HAVE_SYS_MMAN_H */
+  }
+  initIncrementalList(incrementalList);
+}
+
 /***********************************************************************\
 * Name   : initCreateInfo
 * Purpose: initialize create info
@@ -409,16 +647,32 @@ LOCAL void initCreateInfo(CreateInfo          *createInfo,
 
   createInfo->logHandle                             = logHandle;
 
+  initIncrementalList(&createInfo->incrementalList);
   Dictionary_init(&createInfo->namesDictionary,DICTIONARY_BYTE_INIT_ENTRY,DICTIONARY_BYTE_DONE_ENTRY,DICTIONARY_BYTE_COMPARE_ENTRY);
 
   createInfo->storeIncrementalFileInfoFlag          = FALSE;
+  memClear(&createInfo->changeGeneration,sizeof(createInfo->changeGeneration));
+  createInfo->changedDirectoriesFlag                = FALSE;
+  Dictionary_init(&createInfo->changedDirectoriesDictionary,DICTIONARY_BYTE_INIT_ENTRY,DICTIONARY_BYTE_DONE_ENTRY,DICTIONARY_BYTE_COMPARE_ENTRY);
+
+  Dictionary_init(&createInfo->deduplicateDictionary,DICTIONARY_BYTE_INIT_ENTRY,DICTIONARY_BYTE_DONE_ENTRY,DICTIONARY_BYTE_COMPARE_ENTRY);
+  Dictionary_init(&createInfo->deduplicateSizeDictionary,DICTIONARY_BYTE_INIT_ENTRY,DICTIONARY_BYTE_DONE_ENTRY,DICTIONARY_BYTE_COMPARE_ENTRY);
 
   createInfo->collectorTotalSumDone                 = FALSE;
 
   createInfo->storage.count                         = 0;
   createInfo->storage.bytes                         = 0LL;
   createInfo->storageThreadExitFlag                 = FALSE;
-  StringList_init(&createInfo->storageFileList);
+  Dictionary_init(&createInfo->storageFileDictionary,DICTIONARY_BYTE_INIT_ENTRY,DICTIONARY_BYTE_DONE_ENTRY,DICTIONARY_BYTE_COMPARE_ENTRY);
+  createInfo->storageThreads.nextNumber             = 0LL;
+  createInfo->storageThreads.doneNumber             = 0LL;
+
+  createInfo->createThreads.count                   = 0;
+  createInfo->createThreads.minCount                = 0;
+  createInfo->createThreads.maxCount                = 0;
+  createInfo->createThreads.stopCount               = 0;
+  createInfo->createThreads.cpuTime                 = 0LL;
+  createInfo->createThreads.quitFlag                = FALSE;
 
   createInfo->failError                             = ERROR_NONE;
 
@@ -435,6 +689,7 @@ LOCAL void initCreateInfo(CreateInfo          *createInfo,
   createInfo->isAbortedUserData                     = isAbortedUserData;
 
   initRunningInfo(&createInfo->runningInfo);
+  ProgressCounters_init(&createInfo->progressCounters);
 
   // get archive type
   if (archiveType != ARCHIVE_TYPE_NONE)
@@ -451,8 +706,10 @@ LOCAL void initCreateInfo(CreateInfo          *createInfo,
                             || (createInfo->archiveType == ARCHIVE_TYPE_DIFFERENTIAL);
 
   // init entry name queue, storage queue
+  // Note: with a single pass collector the entry queue is larger to let
+  //       the collector run ahead and get a total sum estimate early
   if (!MsgQueue_init(&createInfo->entryMsgQueue,
-                     MAX_ENTRY_MSG_QUEUE,
+                     !globalOptions.singlePassCollectorFlag ? MAX_ENTRY_MSG_QUEUE : MAX_ENTRY_MSG_QUEUE_SINGLE_PASS,
                      CALLBACK_((MsgQueueMsgFreeFunction)freeEntryMsg,NULL)
                     )
      )
@@ -469,10 +726,18 @@ LOCAL void initCreateInfo(CreateInfo          *createInfo,
   {
     HALT_FATAL_ERROR("Cannot initialize storage semaphore!");
   }
+  if (!Semaphore_init(&createInfo->storageThreads.lock,SEMAPHORE_TYPE_BINARY))
+  {
+    HALT_FATAL_ERROR("Cannot initialize storage threads semaphore!");
+  }
   if (!Semaphore_init(&createInfo->runningInfoLock,SEMAPHORE_TYPE_BINARY))
   {
     HALT_FATAL_ERROR("Cannot initialize running info semaphore!");
   }
+  if (!Semaphore_init(&createInfo->deduplicateLock,SEMAPHORE_TYPE_BINARY))
+  {
+    HALT_FATAL_ERROR("Cannot initialize deduplicate semaphore!");
+  }
 
   DEBUG_ADD_RESOURCE_TRACE(createInfo,CreateInfo);
 }
@@ -492,7 +757,9 @@ LOCAL void doneCreateInfo(CreateInfo *createInfo)
 
   DEBUG_REMOVE_RESOURCE_TRACE(createInfo,CreateInfo);
 
+  Semaphore_done(&createInfo->deduplicateLock);
   Semaphore_done(&createInfo->runningInfoLock);
+  Semaphore_done(&createInfo->storageThreads.lock);
   Semaphore_done(&createInfo->storageInfoLock);
 
   MsgQueue_done(&createInfo->storageMsgQueue);
@@ -500,9 +767,13 @@ LOCAL void doneCreateInfo(CreateInfo *createInfo)
 
   doneRunningInfo(&createInfo->runningInfo);
   FragmentList_done(&createInfo->runningInfoFragmentList);
-  StringList_done(&createInfo->storageFileList);
+  Dictionary_done(&createInfo->storageFileDictionary);
 
+  Dictionary_done(&createInfo->deduplicateSizeDictionary);
+  Dictionary_done(&createInfo->deduplicateDictionary);
+  Dictionary_done(&createInfo->changedDirectoriesDictionary);
   Dictionary_done(&createInfo->namesDictionary);
+  doneIncrementalList(&createInfo->incrementalList);
 }
 
 /***********************************************************************\
@@ -543,82 +814,183 @@ LOCAL void pauseCreate(const CreateInfo *createInfo)
 }
 
 /***********************************************************************\
-* Name   : readIncrementalList
-* Purpose: read data of incremental list from file
-* Input  : createInfo      - create info
-*          fileName        - file name
-*          namesDictionary - names dictionary variable
+* Name   : compareIncrementalListNames
+* Purpose: compare names of incremental list entries
+* Input  : name0,name1     - names (not NULL-terminated)
+*          length0,length1 - name lengths
 * Output : -
-* Return : ERROR_NONE if incremental list read in files dictionary,
-*          error code otherwise
+* Return : -1/0/1 if name0 </=/> name1
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors readIncrementalList(const CreateInfo *createInfo,
-                                 ConstString      fileName,
-                                 Dictionary       *namesDictionary
-                                )
+LOCAL int compareIncrementalListNames(const void *name0, ulong length0, const void *name1, ulong length1)
 {
-  #define MAX_KEY_DATA (64*1024)
+  int result = memcmp(name0,name1,MIN(length0,length1));
+  if (result == 0)
+  {
+    if      (length0 < length1) result = -1;
+    else if (length0 > length1) result =  1;
+  }
 
-  Errors error;
+  return result;
+}
 
-  assert(createInfo != NULL);
-  assert(fileName != NULL);
-  assert(namesDictionary != NULL);
+/***********************************************************************\
+* Name   : compareIncrementalListEntries
+* Purpose: compare new incremental list entries by name
+* Input  : p0,p1 - incremental list entries
+* Output : -
+* Return : -1/0/1 if name of p0 </=/> name of p1
+* Notes  : used for qsort()
+\***********************************************************************/
 
-  // open file
-  FileHandle fileHandle;
-  error = File_open(&fileHandle,fileName,FILE_OPEN_READ);
-  if (error != ERROR_NONE)
-  {
-    return error;
-  }
+LOCAL int compareIncrementalListEntries(const void *p0, const void *p1)
+{
+  const IncrementalListEntry *incrementalListEntry0 = (const IncrementalListEntry*)p0;
+  const IncrementalListEntry *incrementalListEntry1 = (const IncrementalListEntry*)p1;
 
-  // read and check header
-  char id[32];
-  error = File_read(&fileHandle,id,sizeof(id),NULL);
-  if (error != ERROR_NONE)
-  {
-    File_close(&fileHandle);
-    return error;
-  }
-  if (!stringEquals(id,INCREMENTAL_LIST_FILE_ID))
-  {
-    File_close(&fileHandle);
-    return ERROR_NOT_AN_INCREMENTAL_FILE;
-  }
-  uint16 version;
-  error = File_read(&fileHandle,&version,sizeof(version),NULL);
-  if (error != ERROR_NONE)
+  return compareIncrementalListNames(incrementalListEntry0->name,
+                                     incrementalListEntry0->nameLength,
+                                     incrementalListEntry1->name,
+                                     incrementalListEntry1->nameLength
+                                    );
+}
+
+/***********************************************************************\
+* Name   : getIncrementalListEntry
+* Purpose: get entry of incremental list
+* Input  : incrementalList - incremental list
+*          i               - entry index [0..count-1]
+* Output : name       - name (not NULL-terminated)
+*          nameLength - name length
+*          fileCast   - file cast data (can be NULL)
+* Return : entry data
+* Notes  : -
+\***********************************************************************/
+
+LOCAL const byte *getIncrementalListEntry(const IncrementalList *incrementalList,
+                                          ulong                 i,
+                                          const char            **name,
+                                          uint16                *nameLength,
+                                          FileCast              *fileCast
+                                         )
+{
+  assert(incrementalList != NULL);
+  assert(incrementalList->data != NULL);
+  assert(i < incrementalList->count);
+  assert(name != NULL);
+  assert(nameLength != NULL);
+
+  // Note: data in file is not aligned
+  uint64 offset;
+  memcpy(&offset,&incrementalList->index[i*sizeof(uint64)],sizeof(offset));
+  const byte *entry = (const byte*)incrementalList->data+offset;
+
+  if (fileCast != NULL)
   {
-    File_close(&fileHandle);
-    return error;
+    memcpy(fileCast,entry,sizeof(FileCast));
   }
-  if (version != INCREMENTAL_LIST_FILE_VERSION)
+  memcpy(nameLength,entry+sizeof(FileCast),sizeof(uint16));
+  (*name) = (const char*)(entry+sizeof(FileCast)+sizeof(uint16));
+
+  return entry;
+}
+
+/***********************************************************************\
+* Name   : findIncrementalListEntry
+* Purpose: find entry in incremental list
+* Input  : incrementalList - incremental list
+*          name            - name
+* Output : fileCast - file cast data
+* Return : TRUE iff entry found
+* Notes  : binary search in sorted entries
+\***********************************************************************/
+
+LOCAL bool findIncrementalListEntry(const IncrementalList *incrementalList,
+                                    ConstString           name,
+                                    FileCast              *fileCast
+                                   )
+{
+  assert(incrementalList != NULL);
+  assert(name != NULL);
+  assert(fileCast != NULL);
+
+  ulong lower = 0L;
+  ulong upper = incrementalList->count;
+  while (lower < upper)
   {
-    File_close(&fileHandle);
-    return ERROR_WRONG_INCREMENTAL_FILE_VERSION;
+    ulong i = lower+(upper-lower)/2;
+
+    const char *entryName;
+    uint16     entryNameLength;
+    getIncrementalListEntry(incrementalList,i,&entryName,&entryNameLength,NULL);
+
+    int result = compareIncrementalListNames(String_cString(name),
+                                             String_length(name),
+                                             entryName,
+                                             entryNameLength
+                                            );
+    if      (result < 0)
+    {
+      upper = i;
+    }
+    else if (result > 0)
+    {
+      lower = i+1;
+    }
+    else
+    {
+      getIncrementalListEntry(incrementalList,i,&entryName,&entryNameLength,fileCast);
+      return TRUE;
+    }
   }
 
-  // read entries
+  return FALSE;
+}
+
+/***********************************************************************\
+* Name   : readIncrementalListEntries
+* Purpose: read entries of incremental list version 1 into dictionary
+* Input  : createInfo      - create info
+*          fileHandle      - file handle (positioned after header)
+*          namesDictionary - names dictionary variable
+* Output : -
+* Return : ERROR_NONE if entries read, error code otherwise
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors readIncrementalListEntries(const CreateInfo *createInfo,
+                                        FileHandle       *fileHandle,
+                                        Dictionary       *namesDictionary
+                                       )
+{
+  #define MAX_KEY_DATA (64*1024)
+
+  Errors error;
+
+  assert(createInfo != NULL);
+  assert(fileHandle != NULL);
+  assert(namesDictionary != NULL);
+
   void *keyData = malloc(MAX_KEY_DATA);
   if (keyData == NULL)
   {
     HALT_INSUFFICIENT_MEMORY();
   }
+
+  error = ERROR_NONE;
   Dictionary_clear(namesDictionary);
-  while (!File_eof(&fileHandle) && !isAborted(createInfo))
+  while (!File_eof(fileHandle) && !isAborted(createInfo))
   {
     // read entry
     IncrementalListInfo incrementalListInfo;
     incrementalListInfo.state = INCREMENTAL_FILE_STATE_UNKNOWN;
-    error = File_read(&fileHandle,&incrementalListInfo.cast,sizeof(incrementalListInfo.cast),NULL);
+    error = File_read(fileHandle,&incrementalListInfo.cast,sizeof(incrementalListInfo.cast),NULL);
     if (error != ERROR_NONE) break;
     uint16 keyLength;
-    error = File_read(&fileHandle,&keyLength,sizeof(keyLength),NULL);
+    error = File_read(fileHandle,&keyLength,sizeof(keyLength),NULL);
     if (error != ERROR_NONE) break;
-    error = File_read(&fileHandle,keyData,keyLength,NULL);
+    error = File_read(fileHandle,keyData,keyLength,NULL);
     if (error != ERROR_NONE) break;
 
     // store in dictionary
@@ -631,131 +1003,245 @@ LOCAL Errors readIncrementalList(const CreateInfo *createInfo,
   }
   free(keyData);
 
-  // close file
-  File_close(&fileHandle);
-
-  // free resources
-
   return error;
+
+  #undef MAX_KEY_DATA
 }
 
 /***********************************************************************\
-* Name   : writeIncrementalList
-* Purpose: write incremental list data to file
-* Input  : createInfo      - create info
-*          fileName        - file name
-*          namesDictionary - names dictionary
-* Output : -
-* Return : ERROR_NONE if incremental list file written, error code
-*          otherwise
-* Notes  : -
+* Name   : mapIncrementalList
+* Purpose: map incremental list version 2/3 into memory
+* Input  : fileHandle      - file handle
+*          version         - incremental list version
+*          incrementalList - incremental list variable
+* Output : incrementalList - incremental list
+* Return : ERROR_NONE if incremental list mapped, error code otherwise
+* Notes  : if memory mapping is not available the file is read with a
+*          single read into memory
 \***********************************************************************/
 
-LOCAL Errors writeIncrementalList(const CreateInfo *createInfo,
-                                  ConstString      fileName,
-                                  Dictionary       *namesDictionary
-                                 )
+LOCAL Errors mapIncrementalList(FileHandle      *fileHandle,
+                                uint16          version,
+                                IncrementalList *incrementalList
+                               )
 {
   Errors error;
 
-  assert(createInfo != NULL);
-  assert(fileName != NULL);
-  assert(namesDictionary != NULL);
+  assert(fileHandle != NULL);
+  assert(incrementalList != NULL);
 
-  // get directory of .bid file
-  String directoryName = File_getDirectoryName(String_new(),fileName);
+  doneIncrementalList(incrementalList);
 
-  // create directory if not existing
-  if (!String_isEmpty(directoryName))
+  size_t headerSize = (version >= INCREMENTAL_LIST_FILE_VERSION_3) ? sizeof(IncrementalListHeader) : INCREMENTAL_LIST_HEADER_SIZE_2;
+  uint64 size       = File_getSize(fileHandle);
+  if ((size < headerSize) || (size > (uint64)SIZE_MAX))
   {
-    if      (!File_exists(directoryName))
+    return ERROR_CORRUPT_INCREMENTAL_FILE;
+  }
+
+  // map file
+  void *data       = NULL;
+  bool mappedFlag  = FALSE;
+  #ifdef HAVE_SYS_MMAN_H
+    data = mmap(NULL,(size_t)size,PROT_READ,MAP_PRIVATE,File_getDescriptor(fileHandle),0);
+    if (data != MAP_FAILED)
     {
-      error = File_makeDirectory(directoryName,
-                                 FILE_DEFAULT_USER_ID,
-                                 FILE_DEFAULT_GROUP_ID,
-                                 FILE_DEFAULT_PERMISSIONS,
-                                 FALSE
-                                );
-      if (error != ERROR_NONE)
-      {
-        String_delete(directoryName);
-        return error;
-      }
+      mappedFlag = TRUE;
     }
-    else if (!File_isDirectory(directoryName))
+    else
     {
-      error = ERRORX_(NOT_A_DIRECTORY,0,"%s",String_cString(directoryName));
-      String_delete(directoryName);
+      data = NULL;
+    }
+  #endif /* HAVE_SYS_MMAN_H */
+  if (data == NULL)
+  {
+    data = malloc((size_t)size);
+    if (data == NULL)
+    {
+      HALT_INSUFFICIENT_MEMORY();
+    }
+    error = File_seek(fileHandle,0LL);
+    if (error == ERROR_NONE)
+    {
+      error = File_read(fileHandle,data,(ulong)size,NULL);
+    }
+    if (error != ERROR_NONE)
+    {
+      free(data);
       return error;
     }
   }
+  incrementalList->data       = data;
+  incrementalList->size       = size;
+  incrementalList->mappedFlag = mappedFlag;
 
-  // check write permission
-  if (!File_isWritable(directoryName))
+  // check header and index
+  IncrementalListHeader header;
+  memClear(&header,sizeof(header));
+  memcpy(&header,data,headerSize);
+  if (   (header.indexOffset < headerSize)
+      || (header.indexOffset > size)
+      || (header.count > (size-header.indexOffset)/sizeof(uint64))
+     )
   {
-    String_delete(directoryName);
-    return ERRORX_(WRITE_FILE,0,"%s",String_cString(fileName));
+    doneIncrementalList(incrementalList);
+    return ERROR_CORRUPT_INCREMENTAL_FILE;
   }
+  incrementalList->count = (ulong)header.count;
+  incrementalList->index = (const byte*)data+header.indexOffset;
+  incrementalList->changeGeneration.generation = header.changeGeneration;
+  memcpy(incrementalList->changeGeneration.uuid,header.changeUUID,sizeof(incrementalList->changeGeneration.uuid));
 
-  // get temporary name for new .bid file
-  String tmpFileName = String_new();
-  error = File_getTmpFileName(tmpFileName,"bid",directoryName);
-  if (error != ERROR_NONE)
+  // check entries
+  for (ulong i = 0L; i < incrementalList->count; i++)
   {
-    String_delete(tmpFileName);
-    String_delete(directoryName);
-    return error;
+    uint64 offset;
+    memcpy(&offset,&incrementalList->index[i*sizeof(uint64)],sizeof(offset));
+    if (   (offset < headerSize)
+        || ((offset+sizeof(FileCast)+sizeof(uint16)) > header.indexOffset)
+       )
+    {
+      doneIncrementalList(incrementalList);
+      return ERROR_CORRUPT_INCREMENTAL_FILE;
+    }
+    uint16 nameLength;
+    memcpy(&nameLength,(const byte*)data+offset+sizeof(FileCast),sizeof(nameLength));
+    if ((offset+sizeof(FileCast)+sizeof(uint16)+nameLength) > header.indexOffset)
+    {
+      doneIncrementalList(incrementalList);
+      return ERROR_CORRUPT_INCREMENTAL_FILE;
+    }
   }
 
-  // open file new .bid file
-  FileHandle fileHandle;
-  error = File_open(&fileHandle,tmpFileName,FILE_OPEN_CREATE);
-  if (error != ERROR_NONE)
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : readIncrementalList
+* Purpose: read data of incremental list from file
+* Input  : createInfo      - create info
+*          fileName        - file name
+*          incrementalList - incremental list variable
+*          namesDictionary - names dictionary variable
+* Output : -
+* Return : ERROR_NONE if incremental list read, error code otherwise
+* Notes  : a version 2/3 list is mapped into memory and entries are
+*          searched with findIncrementalListEntry(); entries of a
+*          version 1 list are read into the names dictionary
+\***********************************************************************/
+
+LOCAL Errors readIncrementalList(const CreateInfo *createInfo,
+                                 ConstString      fileName,
+                                 IncrementalList  *incrementalList,
+                                 Dictionary       *namesDictionary
+                                )
+{
+  Errors error;
+
+  assert(createInfo != NULL);
+  assert(fileName != NULL);
+  assert(incrementalList != NULL);
+  assert(namesDictionary != NULL);
+
+  // open file
+  FileHandle fileHandle;
+  error = File_open(&fileHandle,fileName,FILE_OPEN_READ);
+  if (error != ERROR_NONE)
   {
-    File_delete(tmpFileName,FALSE);
-    String_delete(tmpFileName);
-    String_delete(directoryName);
     return error;
   }
 
-  // write header
+  // read and check header
   char id[32];
-  memClear(id,sizeof(id));
-  strncpy(id,INCREMENTAL_LIST_FILE_ID,sizeof(id)-1);
-  error = File_write(&fileHandle,id,sizeof(id));
+  error = File_read(&fileHandle,id,sizeof(id),NULL);
   if (error != ERROR_NONE)
   {
     File_close(&fileHandle);
-    File_delete(tmpFileName,FALSE);
-    String_delete(tmpFileName);
-    String_delete(directoryName);
     return error;
   }
-  uint16 version = INCREMENTAL_LIST_FILE_VERSION;
-  error = File_write(&fileHandle,&version,sizeof(version));
+  if (!stringEquals(id,INCREMENTAL_LIST_FILE_ID))
+  {
+    File_close(&fileHandle);
+    return ERROR_NOT_AN_INCREMENTAL_FILE;
+  }
+  uint16 version;
+  error = File_read(&fileHandle,&version,sizeof(version),NULL);
   if (error != ERROR_NONE)
   {
     File_close(&fileHandle);
-    File_delete(tmpFileName,FALSE);
-    String_delete(tmpFileName);
-    String_delete(directoryName);
     return error;
   }
 
-  // write entries
+  // read entries
+  switch (version)
+  {
+    case INCREMENTAL_LIST_FILE_VERSION_1:
+      error = readIncrementalListEntries(createInfo,&fileHandle,namesDictionary);
+      break;
+    case INCREMENTAL_LIST_FILE_VERSION_2:
+    case INCREMENTAL_LIST_FILE_VERSION_3:
+      error = mapIncrementalList(&fileHandle,version,incrementalList);
+      break;
+    default:
+      error = ERROR_WRONG_INCREMENTAL_FILE_VERSION;
+      break;
+  }
+
+  // close file
+  File_close(&fileHandle);
+
+  return error;
+}
+
+/***********************************************************************\
+* Name   : writeIncrementalListEntries
+* Purpose: write header, entries and index of incremental list
+* Input  : createInfo      - create info
+*          fileHandle      - file handle
+*          incrementalList - last incremental list
+*          namesDictionary - names dictionary with new entries
+* Output : entryCount - number of written entries (can be NULL)
+* Return : ERROR_NONE if incremental list written, error code otherwise
+* Notes  : new entries are sorted and merged with the sorted entries of
+*          the last incremental list; new entries replace entries of
+*          the last incremental list with the same name
+\***********************************************************************/
+
+LOCAL Errors writeIncrementalListEntries(const CreateInfo      *createInfo,
+                                         FileHandle            *fileHandle,
+                                         const IncrementalList *incrementalList,
+                                         Dictionary            *namesDictionary,
+                                         ulong                 *entryCount
+                                        )
+{
+  Errors error;
+
+  assert(createInfo != NULL);
+  assert(fileHandle != NULL);
+  assert(incrementalList != NULL);
+  assert(namesDictionary != NULL);
+
+  // get sorted new entries
+  ulong newEntryCount = Dictionary_count(namesDictionary);
+  IncrementalListEntry *newEntries = (IncrementalListEntry*)malloc((newEntryCount+1)*sizeof(IncrementalListEntry));
+  if (newEntries == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
   DictionaryIterator dictionaryIterator;
   Dictionary_initIterator(&dictionaryIterator,namesDictionary);
-  const void         *keyData;
-  ulong              keyLength;
-  void               *data;
-  ulong              length;
-  while (   Dictionary_getNext(&dictionaryIterator,
+  const void *keyData;
+  ulong      keyLength;
+  void       *data;
+  ulong      length;
+  ulong      n = 0L;
+  while (   (n < newEntryCount)
+         && Dictionary_getNext(&dictionaryIterator,
                                &keyData,
                                &keyLength,
                                &data,
                                &length
                               )
-         && !isAborted(createInfo)
         )
   {
     assert(keyData != NULL);
@@ -763,16 +1249,197 @@ LOCAL Errors writeIncrementalList(const CreateInfo *createInfo,
     assert(data != NULL);
     assert(length == sizeof(IncrementalListInfo));
 
-    const IncrementalListInfo *incrementalListInfo = (IncrementalListInfo*)data;
-    error = File_write(&fileHandle,&incrementalListInfo->cast,sizeof(incrementalListInfo->cast));
-    if (error != ERROR_NONE) break;
-    uint16 n = (uint16)keyLength;
-    error = File_write(&fileHandle,&n,sizeof(n));
-    if (error != ERROR_NONE) break;
-    error = File_write(&fileHandle,keyData,n);
-    if (error != ERROR_NONE) break;
+    newEntries[n].name       = keyData;
+    newEntries[n].nameLength = (uint16)keyLength;
+    newEntries[n].cast       = &((const IncrementalListInfo*)data)->cast;
+    n++;
   }
   Dictionary_doneIterator(&dictionaryIterator);
+  newEntryCount = n;
+  qsort(newEntries,newEntryCount,sizeof(IncrementalListEntry),compareIncrementalListEntries);
+
+  uint64 *offsets = (uint64*)malloc((incrementalList->count+newEntryCount+1)*sizeof(uint64));
+  if (offsets == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+
+  // write header (updated when index is written)
+  IncrementalListHeader header;
+  memClear(&header,sizeof(header));
+  strncpy(header.id,INCREMENTAL_LIST_FILE_ID,sizeof(header.id)-1);
+  header.version          = INCREMENTAL_LIST_FILE_VERSION;
+  header.changeGeneration = createInfo->changeGeneration.generation;
+  memcpy(header.changeUUID,createInfo->changeGeneration.uuid,sizeof(header.changeUUID));
+  error = File_write(fileHandle,&header,sizeof(header));
+
+  // merge and write entries
+  uint64 offset = sizeof(header);
+  ulong  count  = 0L;
+  ulong  i      = 0L;
+  ulong  j      = 0L;
+  while (   ((i < incrementalList->count) || (j < newEntryCount))
+         && (error == ERROR_NONE)
+         && !isAborted(createInfo)
+        )
+  {
+    const byte *entry = NULL;
+    const char *name;
+    uint16     nameLength;
+    int        result;
+    if (i < incrementalList->count)
+    {
+      entry  = getIncrementalListEntry(incrementalList,i,&name,&nameLength,NULL);
+      result = (j < newEntryCount)
+                 ? compareIncrementalListNames(name,nameLength,newEntries[j].name,newEntries[j].nameLength)
+                 : -1;
+    }
+    else
+    {
+      result = 1;
+    }
+
+    offsets[count] = offset;
+    if (result < 0)
+    {
+      // copy entry of last incremental list
+      ulong entryLength = sizeof(FileCast)+sizeof(uint16)+nameLength;
+      error = File_write(fileHandle,entry,entryLength);
+      offset += entryLength;
+      i++;
+    }
+    else
+    {
+      // write new entry
+      error = File_write(fileHandle,newEntries[j].cast,sizeof(FileCast));
+      if (error == ERROR_NONE) error = File_write(fileHandle,&newEntries[j].nameLength,sizeof(uint16));
+      if (error == ERROR_NONE) error = File_write(fileHandle,newEntries[j].name,newEntries[j].nameLength);
+      offset += sizeof(FileCast)+sizeof(uint16)+newEntries[j].nameLength;
+      if (result == 0) i++;
+      j++;
+    }
+    count++;
+  }
+
+  // write index
+  if (error == ERROR_NONE)
+  {
+    static const byte PADDING[sizeof(uint64)] = {0};
+    uint paddingLength = (uint)((sizeof(uint64)-(offset%sizeof(uint64)))%sizeof(uint64));
+    error = File_write(fileHandle,PADDING,paddingLength);
+    offset += paddingLength;
+  }
+  if (error == ERROR_NONE)
+  {
+    error = File_write(fileHandle,offsets,count*sizeof(uint64));
+  }
+
+  // update header
+  if (error == ERROR_NONE)
+  {
+    header.count       = count;
+    header.indexOffset = offset;
+    error = File_seek(fileHandle,0LL);
+  }
+  if (error == ERROR_NONE)
+  {
+    error = File_write(fileHandle,&header,sizeof(header));
+  }
+
+  // free resources
+  free(offsets);
+  free(newEntries);
+
+  if (entryCount != NULL) (*entryCount) = count;
+
+  return error;
+}
+
+/***********************************************************************\
+* Name   : writeIncrementalList
+* Purpose: write incremental list data to file
+* Input  : createInfo      - create info
+*          fileName        - file name
+*          incrementalList - last incremental list
+*          namesDictionary - names dictionary
+* Output : entryCount - number of written entries (can be NULL)
+* Return : ERROR_NONE if incremental list file written, error code
+*          otherwise
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors writeIncrementalList(const CreateInfo      *createInfo,
+                                  ConstString           fileName,
+                                  const IncrementalList *incrementalList,
+                                  Dictionary            *namesDictionary,
+                                  ulong                 *entryCount
+                                 )
+{
+  Errors error;
+
+  assert(createInfo != NULL);
+  assert(fileName != NULL);
+  assert(incrementalList != NULL);
+  assert(namesDictionary != NULL);
+
+  // get directory of .bid file
+  String directoryName = File_getDirectoryName(String_new(),fileName);
+
+  // create directory if not existing
+  if (!String_isEmpty(directoryName))
+  {
+    if      (!File_exists(directoryName))
+    {
+      error = File_makeDirectory(directoryName,
+                                 FILE_DEFAULT_USER_ID,
+                                 FILE_DEFAULT_GROUP_ID,
+                                 FILE_DEFAULT_PERMISSIONS,
+                                 FALSE
+                                );
+      if (error != ERROR_NONE)
+      {
+        String_delete(directoryName);
+        return error;
+      }
+    }
+    else if (!File_isDirectory(directoryName))
+    {
+      error = ERRORX_(NOT_A_DIRECTORY,0,"%s",String_cString(directoryName));
+      String_delete(directoryName);
+      return error;
+    }
+  }
+
+  // check write permission
+  if (!File_isWritable(directoryName))
+  {
+    String_delete(directoryName);
+    return ERRORX_(WRITE_FILE,0,"%s",String_cString(fileName));
+  }
+
+  // get temporary name for new .bid file
+  String tmpFileName = String_new();
+  error = File_getTmpFileName(tmpFileName,"bid",directoryName);
+  if (error != ERROR_NONE)
+  {
+    String_delete(tmpFileName);
+    String_delete(directoryName);
+    return error;
+  }
+
+  // open file new .bid file
+  FileHandle fileHandle;
+  error = File_open(&fileHandle,tmpFileName,FILE_OPEN_CREATE);
+  if (error != ERROR_NONE)
+  {
+    File_delete(tmpFileName,FALSE);
+    String_delete(tmpFileName);
+    String_delete(directoryName);
+    return error;
+  }
+
+  // write header, entries and index
+  error = writeIncrementalListEntries(createInfo,&fileHandle,incrementalList,namesDictionary,entryCount);
 
   // close file .bid file
   File_close(&fileHandle);
@@ -809,47 +1476,78 @@ LOCAL Errors writeIncrementalList(const CreateInfo *createInfo,
   return ERROR_NONE;
 }
 
+/***********************************************************************\
+* Name   : getIncrementalListCast
+* Purpose: get file cast data of incremental list entry
+* Input  : createInfo - create info
+*          name       - name
+* Output : fileCast - file cast data
+* Return : TRUE iff entry found
+* Notes  : -
+\***********************************************************************/
+
+LOCAL bool getIncrementalListCast(CreateInfo  *createInfo,
+                                  ConstString name,
+                                  FileCast    *fileCast
+                                 )
+{
+  assert(createInfo != NULL);
+  assert(name != NULL);
+  assert(fileCast != NULL);
+
+  // find in names dictionary
+  union
+  {
+    void                *value;
+    IncrementalListInfo *incrementalListInfo;
+  } data;
+  ulong length;
+  if (Dictionary_find(&createInfo->namesDictionary,
+                      String_cString(name),
+                      String_length(name),
+                      &data.value,
+                      &length
+                     )
+     )
+  {
+    assert(length == sizeof(IncrementalListInfo));
+    memCopyFast(fileCast,sizeof(FileCast),&data.incrementalListInfo->cast,sizeof(FileCast));
+    return TRUE;
+  }
+
+  // find in last incremental list
+  return findIncrementalListEntry(&createInfo->incrementalList,name,fileCast);
+}
+
 /***********************************************************************\
 * Name   : isFileChanged
 * Purpose: check if file changed
-* Input  : namesDictionary - names dictionary
-*          fileName        - file name
-*          fileInfo        - file info with file cast data
+* Input  : createInfo - create info
+*          fileName   - file name
+*          fileInfo   - file info with file cast data
 * Output : -
 * Return : TRUE iff file changed, FALSE otherwise
 * Notes  : -
 \***********************************************************************/
 
-LOCAL bool isFileChanged(Dictionary     *namesDictionary,
+LOCAL bool isFileChanged(CreateInfo     *createInfo,
                          ConstString    fileName,
                          const FileInfo *fileInfo
                         )
 {
-  assert(namesDictionary != NULL);
+  assert(createInfo != NULL);
   assert(fileName != NULL);
   assert(fileInfo != NULL);
 
   // check if exists
-  union
-  {
-    void                *value;
-    IncrementalListInfo *incrementalListInfo;
-  } data;
-  ulong length;
-  if (!Dictionary_find(namesDictionary,
-                       String_cString(fileName),
-                       String_length(fileName),
-                       &data.value,
-                       &length
-                      )
-     )
+  FileCast fileCast;
+  if (!getIncrementalListCast(createInfo,fileName,&fileCast))
   {
     return TRUE;
   }
-  assert(length == sizeof(IncrementalListInfo));
 
   // check if modified
-  if (!File_isEqualsCast(&data.incrementalListInfo->cast,&fileInfo->cast))
+  if (!File_isEqualsCast(&fileCast,&fileInfo->cast))
   {
     return TRUE;
   }
@@ -860,7 +1558,7 @@ LOCAL bool isFileChanged(Dictionary     *namesDictionary,
 /***********************************************************************\
 * Name   : printIncrementalInfo
 * Purpose: print incremental info for file
-* Input  : dictionary - incremental dictionary
+* Input  : createInfo - create info
 *          name       - name
 *          fileCast   - file cast data
 * Output : -
@@ -868,7 +1566,7 @@ LOCAL bool isFileChanged(Dictionary     *namesDictionary,
 * Notes  : -
 \***********************************************************************/
 
-LOCAL void printIncrementalInfo(Dictionary     *dictionary,
+LOCAL void printIncrementalInfo(CreateInfo     *createInfo,
                                 ConstString    name,
                                 const FileCast *fileCast
                                )
@@ -876,21 +1574,10 @@ LOCAL void printIncrementalInfo(Dictionary     *dictionary,
   String s = String_new();
   printInfo(2,"Include '%s':\n",String_cString(name));
   printInfo(2,"  new: %s\n",String_cString(File_castToString(String_clear(s),fileCast)));
-  union
-  {
-    void                *value;
-    IncrementalListInfo *incrementalListInfo;
-  } data;
-  ulong length;
-  if (Dictionary_find(dictionary,
-                      String_cString(name),
-                      String_length(name),
-                      &data.value,
-                      &length
-                     )
-      )
+  FileCast oldFileCast;
+  if (getIncrementalListCast(createInfo,name,&oldFileCast))
   {
-    printInfo(2,"  old: %s\n",String_cString(File_castToString(String_clear(s),&data.incrementalListInfo->cast)));
+    printInfo(2,"  old: %s\n",String_cString(File_castToString(String_clear(s),&oldFileCast)));
   }
   else
   {
@@ -939,7 +1626,8 @@ LOCAL void addIncrementalList(Dictionary     *namesDictionary,
 *          forceUpdate - true to force update
 * Output : -
 * Return : -
-* Notes  : Update only every 500ms or if forced
+* Notes  : Update only every 500ms or if forced; per-thread progress
+*          counters are merged into the running info on update
 \***********************************************************************/
 
 LOCAL void updateRunningInfo(CreateInfo *createInfo, bool forceUpdate)
@@ -949,17 +1637,20 @@ LOCAL void updateRunningInfo(CreateInfo *createInfo, bool forceUpdate)
   assert(createInfo != NULL);
   assert(Semaphore_isLocked(&createInfo->runningInfoLock));
 
-  if (createInfo->runningInfoFunction != NULL)
+  uint64 timestamp = Misc_getTimestamp();
+  if (forceUpdate || (timestamp > (lastTimestamp+RUNNING_INFO_UPDATE_INTERVAL*US_PER_MS)))
   {
-    uint64 timestamp = Misc_getTimestamp();
-    if (forceUpdate || (timestamp > (lastTimestamp+500LL*US_PER_MS)))
+    // merge progress counters
+    ProgressCounters_get(&createInfo->progressCounters,&createInfo->runningInfo);
+
+    if (createInfo->runningInfoFunction != NULL)
     {
       createInfo->runningInfoFunction(createInfo->failError,
                                       &createInfo->runningInfo,
                                       createInfo->runningInfoUserData
                                      );
-      lastTimestamp = timestamp;
     }
+    lastTimestamp = timestamp;
   }
 }
 
@@ -1033,7 +1724,7 @@ LOCAL void runningInfoUpdateUnlock(CreateInfo *createInfo, ConstString name)
   }
 
   // update running info
-  updateRunningInfo(createInfo,TRUE);
+  updateRunningInfo(createInfo,FALSE);
 
   // unlock
   Semaphore_unlock(&createInfo->runningInfoLock);
@@ -1064,17 +1755,39 @@ LOCAL void runningInfoUpdateUnlock(CreateInfo *createInfo, ConstString name)
       )
 
 /***********************************************************************\
-* Name   : updateStorageProgress
-* Purpose: update storage progress data
-* Input  : doneSize     - done size [bytes]
-*          volumeNumber - volume number [1..n]
-*          volumeDone   - volume done [0..100%]
-*          messageCode  - message code; see MESSAGE_CODE_...
-*          messageText  - message text
-*          userData     - user data
+* Name   : updateRunningInfoNoWait
+* Purpose: update running info if it is not locked
+* Input  : createInfo - create info structure
+*          name       - name of entry (can be NULL)
 * Output : -
-* Return : TRUE to continue, FALSE to abort
-* Notes  : -
+* Return : -
+* Notes  : progress counters are updated lock-free by the caller; if
+*          the running info is locked by another thread the update is
+*          skipped, the counters are merged with the next update
+\***********************************************************************/
+
+LOCAL void updateRunningInfoNoWait(CreateInfo *createInfo, ConstString name)
+{
+  assert(createInfo != NULL);
+
+  if (Semaphore_lock(&createInfo->runningInfoLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,NO_WAIT))
+  {
+    runningInfoUpdateUnlock(createInfo,name);
+  }
+}
+
+/***********************************************************************\
+* Name   : updateStorageProgress
+* Purpose: update storage progress data
+* Input  : doneSize     - done size [bytes]
+*          volumeNumber - volume number [1..n]
+*          volumeDone   - volume done [0..100%]
+*          messageCode  - message code; see MESSAGE_CODE_...
+*          messageText  - message text
+*          userData     - user data
+* Output : -
+* Return : TRUE to continue, FALSE to abort
+* Notes  : -
 \***********************************************************************/
 
 LOCAL bool updateStorageProgress(uint64       doneSize,
@@ -1093,11 +1806,95 @@ LOCAL bool updateStorageProgress(uint64       doneSize,
     createInfo->runningInfo.progress.volume.number    = volumeNumber;
     createInfo->runningInfo.progress.volume.done      = volumeDone;
     messageSet(&createInfo->runningInfo.message,messageCode,messageText);
+    if (messageCode != MESSAGE_CODE_NONE)
+    {
+      updateRunningInfo(createInfo,TRUE);
+    }
   }
 
   return !isAborted(createInfo);
 }
 
+/***********************************************************************\
+* Name   : updateTotalSum
+* Purpose: update total sum of entries when collecting in a single pass
+* Input  : createInfo - create info structure
+*          size       - size of entry [bytes]
+* Output : -
+* Return : -
+* Notes  : total sum is updated by the collector sum thread if not
+*          collecting in a single pass
+\***********************************************************************/
+
+LOCAL void updateTotalSum(CreateInfo *createInfo, uint64 size)
+{
+  assert(createInfo != NULL);
+
+  if (globalOptions.singlePassCollectorFlag)
+  {
+    STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+    {
+      createInfo->runningInfo.progress.total.count++;
+      createInfo->runningInfo.progress.total.size += size;
+    }
+  }
+}
+
+/***********************************************************************\
+* Name   : getFragmentSize
+* Purpose: get fragment size for entry
+* Input  : createInfo      - create info
+*          size            - size of entry [bytes]
+*          maxFragmentSize - max. fragment size or 0
+* Output : -
+* Return : fragment size [bytes] or 0
+* Notes  : entries larger than max. fragment size are split into a
+*          multiple of the number of create threads, so a few very
+*          large files are processed by all create threads in
+*          parallel; number of fragments is limited to
+*          MAX_FRAGMENT_COUNT by growing fragments up to the archive
+*          part size
+\***********************************************************************/
+
+LOCAL uint64 getFragmentSize(const CreateInfo *createInfo, uint64 size, uint64 maxFragmentSize)
+{
+  assert(createInfo != NULL);
+  assert(createInfo->jobOptions != NULL);
+
+  if ((maxFragmentSize == 0LL) || (size <= maxFragmentSize))
+  {
+    return maxFragmentSize;
+  }
+
+  uint threadCount = (globalOptions.maxThreads != 0) ? globalOptions.maxThreads : Thread_getNumberOfCores();
+  if (threadCount < 1) threadCount = 1;
+
+  // split evenly into a multiple of the number of create threads
+  uint64 fragmentCount = (size+maxFragmentSize-1)/maxFragmentSize;
+  fragmentCount = ((fragmentCount+threadCount-1)/threadCount)*threadCount;
+
+  // limit number of fragments
+  uint64 maxFragmentCount = MAX((MAX_FRAGMENT_COUNT/threadCount)*threadCount,threadCount);
+  if (fragmentCount > maxFragmentCount) fragmentCount = maxFragmentCount;
+
+  // get fragment size
+  uint64 fragmentSize = (size+fragmentCount-1)/fragmentCount;
+  fragmentSize = ALIGN(fragmentSize,(fragmentSize >= FRAGMENT_SIZE_ALIGNMENT) ? FRAGMENT_SIZE_ALIGNMENT : 4*KB);
+  if (fragmentSize < MIN(MIN_FRAGMENT_SIZE,maxFragmentSize))
+  {
+    fragmentSize = MIN(MIN_FRAGMENT_SIZE,maxFragmentSize);
+  }
+  if (   (fragmentSize > maxFragmentSize)
+      && (createInfo->jobOptions->archivePartSize > 0LL)
+     )
+  {
+    // do not grow fragments beyond archive part size
+    fragmentSize = MIN(fragmentSize,MAX(createInfo->jobOptions->archivePartSize,maxFragmentSize));
+  }
+
+  return fragmentSize;
+}
+
 /***********************************************************************\
 * Name   : appendFileToEntryList
 * Purpose: append file to entry list
@@ -1120,6 +1917,9 @@ LOCAL void appendFileToEntryList(CreateInfo     *createInfo,
   assert(name != NULL);
   assert(fileInfo != NULL);
 
+  updateTotalSum(createInfo,fileInfo->size);
+
+  maxFragmentSize = getFragmentSize(createInfo,fileInfo->size,maxFragmentSize);
   uint   fragmentCount  = (maxFragmentSize > 0LL)
                             ? (fileInfo->size+maxFragmentSize-1)/maxFragmentSize
                             : 1;
@@ -1178,6 +1978,9 @@ LOCAL void appendImageToEntryList(CreateInfo       *createInfo,
   assert(name != NULL);
   assert(deviceInfo != NULL);
 
+  updateTotalSum(createInfo,deviceInfo->size);
+
+  maxFragmentSize = getFragmentSize(createInfo,deviceInfo->size,maxFragmentSize);
   uint   fragmentCount  = (maxFragmentSize > 0LL)
                             ? (deviceInfo->size+maxFragmentSize-1)/maxFragmentSize
                             : 1;
@@ -1233,6 +2036,8 @@ LOCAL void appendDirectoryToEntryList(CreateInfo     *createInfo,
   assert(name != NULL);
   assert(fileInfo != NULL);
 
+  updateTotalSum(createInfo,0LL);
+
   // init
   EntryMsg entryMsg;
   entryMsg.type           = ENTRY_TYPE_DIRECTORY;
@@ -1266,6 +2071,8 @@ LOCAL void appendLinkToEntryList(CreateInfo     *createInfo,
   assert(name != NULL);
   assert(fileInfo != NULL);
 
+  updateTotalSum(createInfo,0LL);
+
   // init
   EntryMsg entryMsg;
   entryMsg.type      = ENTRY_TYPE_LINK;
@@ -1302,6 +2109,9 @@ LOCAL void appendHardLinkToEntryList(CreateInfo     *createInfo,
   assert(!StringList_isEmpty(nameList));
   assert(fileInfo != NULL);
 
+  updateTotalSum(createInfo,fileInfo->size);
+
+  maxFragmentSize = getFragmentSize(createInfo,fileInfo->size,maxFragmentSize);
   uint   fragmentCount     = (maxFragmentSize > 0LL)
                                ? (fileInfo->size+maxFragmentSize-1)/maxFragmentSize
                                : 1;
@@ -1358,6 +2168,8 @@ LOCAL void appendSpecialToEntryList(CreateInfo       *createInfo,
   assert(name != NULL);
   assert(fileInfo != NULL);
 
+  updateTotalSum(createInfo,0LL);
+
   // init
   EntryMsg entryMsg;
   entryMsg.type         = ENTRY_TYPE_SPECIAL;
@@ -1501,1917 +2313,2717 @@ LOCAL String getIncrementalFileNameFromJobUUID(String fileName, const char *jobU
 }
 
 /***********************************************************************\
-* Name   : collector
-* Purpose: file collector
-* Input  : createInfo    - create info block
-*          collectorType - collector type
+* Name   : getIncludeBasePath
+* Purpose: get base path of include entry
+* Input  : path        - path variable
+*          includeName - include name/pattern
 * Output : -
-* Return : -
+* Return : path (longest leading part without pattern)
 * Notes  : -
 \***********************************************************************/
 
-LOCAL void collector(CreateInfo     *createInfo,
-                     CollectorTypes collectorType
-                    )
+LOCAL String getIncludeBasePath(String path, ConstString includeName)
 {
-  /***********************************************************************\
-  * Name   : freeHardlinkInfo
-  * Purpose: free hardlink info
-  * Input  : data     - data
-  *          length   - data length
-  *          userData - user data (not used)
-  * Output : -
-  * Return : -
-  * Notes  : -
-  \***********************************************************************/
+  assert(path != NULL);
+  assert(includeName != NULL);
 
-  auto void freeHardlinkInfo(void *data, ulong length, void *userData);
-  void freeHardlinkInfo(void *data, ulong length, void *userData)
+  StringTokenizer fileNameTokenizer;
+  ConstString     token;
+  File_initSplitFileName(&fileNameTokenizer,includeName);
+  if (File_getNextSplitFileName(&fileNameTokenizer,&token) && !Pattern_checkIsPattern(token))
   {
-    HardLinkInfo *hardLinkInfo = (HardLinkInfo*)data;
+    if (!String_isEmpty(token))
+    {
+      File_setFileName(path,token);
+    }
+    else
+    {
+      File_getSystemDirectory(path,FILE_SYSTEM_PATH_ROOT,NULL);
+    }
+  }
+  else
+  {
+    String_clear(path);
+  }
+  while (File_getNextSplitFileName(&fileNameTokenizer,&token) && !Pattern_checkIsPattern(token))
+  {
+    File_appendFileName(path,token);
+  }
+  File_doneSplitFileName(&fileNameTokenizer);
 
-    UNUSED_VARIABLE(length);
-    UNUSED_VARIABLE(userData);
+  return path;
+}
 
-    StringList_done(&hardLinkInfo->nameList);
-  }
+/***********************************************************************\
+* Name   : addChangedEntry
+* Purpose: add parent directories of changed entry to changed
+*          directories
+* Input  : name     - name of changed entry
+*          userData - create info
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void addChangedEntry(ConstString name, void *userData)
+{
+  CreateInfo *createInfo = (CreateInfo*)userData;
 
   assert(createInfo != NULL);
-  assert(createInfo->includeEntryList != NULL);
-  assert(createInfo->excludePatternList != NULL);
-  assert(createInfo->jobOptions != NULL);
+  assert(name != NULL);
 
-  // initialize variables
-  Dictionary         duplicateNamesDictionary;
-  if (!Dictionary_init(&duplicateNamesDictionary,DICTIONARY_BYTE_INIT_ENTRY,DICTIONARY_BYTE_DONE_ENTRY,DICTIONARY_BYTE_COMPARE_ENTRY))
+  String directoryName = String_new();
+  File_getDirectoryName(directoryName,name);
+  while (   !String_isEmpty(directoryName)
+         && !Dictionary_contains(&createInfo->changedDirectoriesDictionary,String_cString(directoryName),String_length(directoryName))
+        )
   {
-    HALT_INSUFFICIENT_MEMORY();
+    Dictionary_add(&createInfo->changedDirectoriesDictionary,String_cString(directoryName),String_length(directoryName),NULL,0);
+    File_getDirectoryName(directoryName,directoryName);
   }
-  Dictionary         hardLinksDictionary;
-  if (!Dictionary_init(&hardLinksDictionary,DICTIONARY_BYTE_INIT_ENTRY,CALLBACK_(freeHardlinkInfo,NULL),DICTIONARY_BYTE_COMPARE_ENTRY))
+  String_delete(directoryName);
+}
+
+/***********************************************************************\
+* Name   : initChangedDirectories
+* Purpose: get file system change generation and directories with
+*          entries changed since last incremental list
+* Input  : createInfo - create info
+* Output : -
+* Return : -
+* Notes  : if the change generation is not available for all include
+*          entries, all directories are traversed
+\***********************************************************************/
+
+LOCAL void initChangedDirectories(CreateInfo *createInfo)
+{
+  assert(createInfo != NULL);
+  assert(createInfo->includeEntryList != NULL);
+
+  if (!globalOptions.incrementalFileSystemGenerationFlag || (createInfo->archiveType == ARCHIVE_TYPE_CONTINUOUS))
   {
-    HALT_INSUFFICIENT_MEMORY();
+    return;
   }
-  if (createInfo->archiveType == ARCHIVE_TYPE_CONTINUOUS)
+
+  // get change generation: all base paths must be in the same sub-volume
+  String               path = String_new();
+  FileChangeGeneration changeGeneration;
+  memClear(&changeGeneration,sizeof(changeGeneration));
+  Errors               error = ERROR_NONE;
+  const EntryNode      *includeEntryNode;
+  LIST_ITERATEX(createInfo->includeEntryList,includeEntryNode,error == ERROR_NONE)
   {
-    if (Continuous_isAvailable())
+    getIncludeBasePath(path,includeEntryNode->string);
+    if (!String_isEmpty(path))
     {
-      Errors error;
-      // open continuous database
-      DatabaseHandle continuousDatabaseHandle;
-      error = Continuous_open(&continuousDatabaseHandle);
+      FileChangeGeneration fileChangeGeneration;
+      error = File_getChangeGeneration(&fileChangeGeneration,path);
       if (error == ERROR_NONE)
       {
-        // process entries from continuous database
-        DatabaseStatementHandle databaseStatementHandle;
-        error = Continuous_initList(&databaseStatementHandle,
-                                    &continuousDatabaseHandle,
-                                    createInfo->jobUUID,
-                                    createInfo->scheduleUUID
-                                   );
-        if (error == ERROR_NONE)
+        if      (changeGeneration.generation == 0LL)
         {
-          DatabaseId databaseId;
-          String     name = String_new();
-          while (   (createInfo->failError == ERROR_NONE)
-                 && !isAborted(createInfo)
-                 && Continuous_getNext(&databaseStatementHandle,&databaseId,name)
-                )
-          {
-            // pause
-            pauseCreate(createInfo);
+          changeGeneration = fileChangeGeneration;
+        }
+        else if (memcmp(changeGeneration.uuid,fileChangeGeneration.uuid,sizeof(changeGeneration.uuid)) != 0)
+        {
+          error = ERROR_FUNCTION_NOT_SUPPORTED;
+        }
+      }
+    }
+    else
+    {
+      error = ERROR_FUNCTION_NOT_SUPPORTED;
+    }
+  }
+  if (error != ERROR_NONE)
+  {
+    printInfo(2,"File system change generation not available (error: %s)\n",Error_getText(error));
+    String_delete(path);
+    return;
+  }
+  createInfo->changeGeneration = changeGeneration;
 
-            // check if file still exists
-            if (!File_exists(name))
-            {
-              continue;
-            }
+  // get directories with changed entries
+  const FileChangeGeneration *lastChangeGeneration = &createInfo->incrementalList.changeGeneration;
+  if (   createInfo->partialFlag
+      && (lastChangeGeneration->generation != 0LL)
+      && (memcmp(lastChangeGeneration->uuid,changeGeneration.uuid,sizeof(changeGeneration.uuid)) == 0)
+     )
+  {
+    LIST_ITERATEX(createInfo->includeEntryList,includeEntryNode,error == ERROR_NONE)
+    {
+      getIncludeBasePath(path,includeEntryNode->string);
+      if (File_isDirectory(path))
+      {
+        error = File_getChangedEntries(path,
+                                       lastChangeGeneration->generation,
+                                       CALLBACK_(addChangedEntry,createInfo)
+                                      );
+      }
+    }
+    if (error == ERROR_NONE)
+    {
+      createInfo->changedDirectoriesFlag = TRUE;
+      printInfo(2,
+                "Entries changed since file system generation %"PRIu64" in %lu directories\n",
+                lastChangeGeneration->generation,
+                Dictionary_count(&createInfo->changedDirectoriesDictionary)
+               );
+    }
+    else
+    {
+      Dictionary_clear(&createInfo->changedDirectoriesDictionary);
+      printInfo(2,"File system changes not available (error: %s)\n",Error_getText(error));
+    }
+  }
 
-            // read file info
-            FileInfo fileInfo;
-            error = File_getInfo(&fileInfo,name);
-            if (error != ERROR_NONE)
-            {
-              if (collectorType == COLLECTOR_TYPE_ENTRIES)
-              {
-                if (createInfo->jobOptions->skipUnreadableFlag)
-                {
-                  printWarning(_("cannot get info for '%s' (error: %s) - skipped"),String_cString(name),Error_getText(error));
-                }
-                else
-                {
-                  printError(_("cannot get info for '%s' (error: %s)"),
-                             String_cString(name),
-                             Error_getText(error)
-                            );
-                }
-                logMessage(createInfo->logHandle,
-                           LOG_TYPE_ENTRY_ACCESS_DENIED,
-                           "Access denied '%s' (error: %s)",
-                           String_cString(name),
-                           Error_getText(error)
-                          );
+  String_delete(path);
+}
 
-                STATUS_INFO_UPDATE(createInfo,name,NULL)
-                {
-                  createInfo->runningInfo.progress.error.count++;
-                }
-              }
-              continue;
-            }
+/***********************************************************************\
+* Name   : isTraverseDirectory
+* Purpose: check if directory has to be traversed by collector
+* Input  : createInfo - create info
+*          name       - directory name
+* Output : -
+* Return : TRUE iff directory has to be traversed
+* Notes  : with a file system change generation only directories with
+*          changed entries and directories not in the last incremental
+*          list (new or moved) are traversed
+\***********************************************************************/
 
-            // collect entry for storage
-            if (createInfo->jobOptions->ignoreNoDumpAttributeFlag || !File_hasAttributeNoDump(&fileInfo))
-            {
-              switch (fileInfo.type)
-              {
-                case FILE_TYPE_FILE:
-                  if (isInIncludedList(createInfo->includeEntryList,name))
-                  {
-                    if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
-                    {
-                      // add to known names history
-                      Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
+LOCAL bool isTraverseDirectory(CreateInfo *createInfo, ConstString name)
+{
+  assert(createInfo != NULL);
+  assert(name != NULL);
 
-                      if (   ((globalOptions.continuousMaxSize == 0LL) || fileInfo.size <= globalOptions.continuousMaxSize)
-                          && !isInExcludedList(createInfo->excludePatternList,name)
-                         )
-                      {
-                        switch (collectorType)
-                        {
-                          case COLLECTOR_TYPE_ENTRIES:
-                            if ((globalOptions.continuousMaxSize == 0LL) || fileInfo.size <= globalOptions.continuousMaxSize)
-                            {
-                              // add to entry list
-                              if (isPrintInfo(2))
-                              {
-                                printIncrementalInfo(&createInfo->namesDictionary,name,&fileInfo.cast);
-                              }
-                              appendFileToEntryList(createInfo,
-                                                    name,
-                                                    &fileInfo,
-                                                    !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
-                                                   );
-                            }
-                            else
-                            {
-                              logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Size exceeded limit '%s'",String_cString(name));
+  if (!createInfo->changedDirectoriesFlag)
+  {
+    return TRUE;
+  }
 
-                              STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                              {
-                                createInfo->runningInfo.progress.skipped.count++;
-                                createInfo->runningInfo.progress.skipped.size += fileInfo.size;
-                              }
-                            }
-                            break;
-                          case COLLECTOR_TYPE_SUM:
-                            STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                            {
-                              createInfo->runningInfo.progress.total.count++;
-                              createInfo->runningInfo.progress.total.size += fileInfo.size;
-                            }
-                            break;
-                        }
-                      }
-                      else
-                      {
-                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                        {
-                          logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
+  FileCast fileCast;
+  return    Dictionary_contains(&createInfo->changedDirectoriesDictionary,String_cString(name),String_length(name))
+         || !findIncrementalListEntry(&createInfo->incrementalList,name,&fileCast);
+}
 
-                          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                          {
-                            createInfo->runningInfo.progress.skipped.count++;
-                            createInfo->runningInfo.progress.skipped.size += fileInfo.size;
-                          }
-                        }
-                      }
-                    }
-                  }
-                  break;
-                case FILE_TYPE_DIRECTORY:
-                  // add to known names history
-                  Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
+/***********************************************************************\
+* Name   : freeScanEntryNode
+* Purpose: free scan entry node
+* Input  : scanEntryNode - scan entry node
+*          userData      - user data (not used)
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
 
-                  if (globalOptions.ignoreNoBackupFileFlag || !hasNoBackup(name))
-                  {
-                    if (isInIncludedList(createInfo->includeEntryList,name))
-                    {
-                      if (!isInExcludedList(createInfo->excludePatternList,name))
-                      {
-                        switch (collectorType)
-                        {
-                          case COLLECTOR_TYPE_ENTRIES:
-                            // add to entry list
-                            if (isPrintInfo(2))
-                            {
-                              printIncrementalInfo(&createInfo->namesDictionary,name,&fileInfo.cast);
-                            }
-                            appendDirectoryToEntryList(createInfo,
-                                                       name,
-                                                       &fileInfo
-                                                      );
-                            break;
-                          case COLLECTOR_TYPE_SUM:
-                            STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                            {
-                              createInfo->runningInfo.progress.total.count++;
-                            }
-                            break;
-                        }
-                      }
-                      else
-                      {
-                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                        {
-                          logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
+LOCAL void freeScanEntryNode(ScanEntryNode *scanEntryNode, void *userData)
+{
+  assert(scanEntryNode != NULL);
 
-                          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                          {
-                            createInfo->runningInfo.progress.skipped.count++;
-                            createInfo->runningInfo.progress.skipped.size += fileInfo.size;
-                          }
-                        }
-                      }
-                    }
-                  }
-                  break;
-                case FILE_TYPE_LINK:
-                  if (isInIncludedList(createInfo->includeEntryList,name))
-                  {
-                    if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
-                    {
-                      if (!isInExcludedList(createInfo->excludePatternList,name))
-                      {
-                        // add to known names history
-                        Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
+  UNUSED_VARIABLE(userData);
 
-                        switch (collectorType)
-                        {
-                          case COLLECTOR_TYPE_ENTRIES:
-                            // add to entry list
-                            if (isPrintInfo(2))
-                            {
-                              printIncrementalInfo(&createInfo->namesDictionary,name,&fileInfo.cast);
-                            }
-                            appendLinkToEntryList(createInfo,
-                                                  name,
-                                                  &fileInfo
-                                                 );
-                            break;
-                          case COLLECTOR_TYPE_SUM:
-                            STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                            {
-                              createInfo->runningInfo.progress.total.count++;
-                            }
-                            break;
-                        }
-                      }
-                      else
-                      {
-                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                        {
-                          logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
+  String_delete(scanEntryNode->name);
+}
 
-                          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                          {
-                            createInfo->runningInfo.progress.skipped.count++;
-                            createInfo->runningInfo.progress.skipped.size += fileInfo.size;
-                          }
-                        }
-                      }
-                    }
-                  }
-                  break;
-                case FILE_TYPE_HARDLINK:
-                  if (   ((globalOptions.continuousMaxSize == 0LL) || fileInfo.size <= globalOptions.continuousMaxSize)
-                      && isInIncludedList(createInfo->includeEntryList,name)
-                     )
-                  {
-                    if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
-                    {
-                      // add to known names history
-                      Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
+/***********************************************************************\
+* Name   : freeScanDirectoryNode
+* Purpose: free scan directory node
+* Input  : scanDirectoryNode - scan directory node
+*          userData          - user data (not used)
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
 
-                      if (!isInExcludedList(createInfo->excludePatternList,name))
-                      {
-                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                        {
-                          if ((globalOptions.continuousMaxSize == 0LL) || fileInfo.size <= globalOptions.continuousMaxSize)
-                          {
-                            union { void *value; HardLinkInfo *hardLinkInfo; } data;
-                            HardLinkInfo                                       hardLinkInfo;
-                            if (Dictionary_find(&hardLinksDictionary,
-                                                &fileInfo.id,
-                                                sizeof(fileInfo.id),
-                                                &data.value,
-                                                NULL
-                                               )
-                                )
-                            {
-                              // append name to hard link name list
-                              StringList_append(&data.hardLinkInfo->nameList,name);
+LOCAL void freeScanDirectoryNode(ScanDirectoryNode *scanDirectoryNode, void *userData)
+{
+  assert(scanDirectoryNode != NULL);
 
-                              if (StringList_count(&data.hardLinkInfo->nameList) >= data.hardLinkInfo->count)
-                              {
-                                // found last hardlink
+  UNUSED_VARIABLE(userData);
 
-                                switch (collectorType)
-                                {
-                                  case COLLECTOR_TYPE_ENTRIES:
-                                    // add to entry list
-                                    appendHardLinkToEntryList(createInfo,
-                                                              &data.hardLinkInfo->nameList,
-                                                              &data.hardLinkInfo->fileInfo,
-                                                              !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
-                                                             );
-                                    break;
-                                  case COLLECTOR_TYPE_SUM:
-                                    // update status
-                                    STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                                    {
-                                      createInfo->runningInfo.progress.total.count++;
-                                      createInfo->runningInfo.progress.total.size += fileInfo.size;
-                                    }
-                                }
+  List_done(&scanDirectoryNode->entryList);
+  String_delete(scanDirectoryNode->name);
+}
 
-                                // clear entry
-                                Dictionary_remove(&hardLinksDictionary,
-                                                  &fileInfo.id,
-                                                  sizeof(fileInfo.id)
-                                                 );
-                              }
-                            }
-                            else
-                            {
-                              // create hard link name list
-                              if (isPrintInfo(2))
-                              {
-                                printIncrementalInfo(&createInfo->namesDictionary,
-                                                     name,
-                                                     &fileInfo.cast
-                                                    );
-                              }
+/***********************************************************************\
+* Name   : newScanDirectoryNode
+* Purpose: create new scan directory node
+* Input  : name        - directory name
+*          threadIndex - index of scan thread wait list
+* Output : -
+* Return : scan directory node
+* Notes  : -
+\***********************************************************************/
 
-                              hardLinkInfo.count = fileInfo.linkCount;
-                              StringList_init(&hardLinkInfo.nameList);
-                              StringList_append(&hardLinkInfo.nameList,name);
-                              memCopyFast(&hardLinkInfo.fileInfo,sizeof(hardLinkInfo.fileInfo),&fileInfo,sizeof(fileInfo));
+LOCAL ScanDirectoryNode *newScanDirectoryNode(ConstString name, uint threadIndex)
+{
+  assert(name != NULL);
 
-                              if (!Dictionary_add(&hardLinksDictionary,
-                                                  &fileInfo.id,
-                                                  sizeof(fileInfo.id),
-                                                  &hardLinkInfo,
-                                                  sizeof(hardLinkInfo)
-                                                 )
-                                  )
-                              {
-                                HALT_INSUFFICIENT_MEMORY();
-                              }
-                            }
-                          }
-                          else
-                          {
-                            logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Size exceeded limit '%s'",String_cString(name));
+  ScanDirectoryNode *scanDirectoryNode = LIST_NEW_NODE(ScanDirectoryNode);
+  if (scanDirectoryNode == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  scanDirectoryNode->name        = String_duplicate(name);
+  scanDirectoryNode->state       = SCAN_DIRECTORY_STATE_WAIT;
+  scanDirectoryNode->threadIndex = threadIndex;
+  scanDirectoryNode->error       = ERROR_NONE;
+  List_init(&scanDirectoryNode->entryList,CALLBACK_(NULL,NULL),CALLBACK_((ListNodeFreeFunction)freeScanEntryNode,NULL));
 
-                            STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                            {
-                              createInfo->runningInfo.progress.skipped.count++;
-                              createInfo->runningInfo.progress.skipped.size += fileInfo.size;
-                            }
-                          }
-                        }
-                      }
-                      else
-                      {
-                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                        {
-                          logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
+  return scanDirectoryNode;
+}
 
-                          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                          {
-                            createInfo->runningInfo.progress.skipped.count++;
-                            createInfo->runningInfo.progress.skipped.size += fileInfo.size;
-                          }
-                        }
-                      }
-                    }
-                  }
-                  break;
-                case FILE_TYPE_SPECIAL:
-                  if (   isInIncludedList(createInfo->includeEntryList,name)
-                      && !isInExcludedList(createInfo->excludePatternList,name)
-                     )
-                  {
-                    if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
-                    {
-                      // add to known names history
-                      Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
-
-                      switch (collectorType)
-                      {
-                        case COLLECTOR_TYPE_ENTRIES:
-                          // add to entry list
-                          if (isPrintInfo(2))
-                          {
-                            printIncrementalInfo(&createInfo->namesDictionary,name,&fileInfo.cast);
-                          }
-                          appendSpecialToEntryList(createInfo,
-                                                   name,
-                                                   &fileInfo
-                                                  );
-                          break;
-                        case COLLECTOR_TYPE_SUM:
-                          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                          {
-                            createInfo->runningInfo.progress.total.count++;
-                          }
-                          break;
-                      }
-                    }
-                    else
-                    {
-                      if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                      {
-                        logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
-
-                        STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                        {
-                          createInfo->runningInfo.progress.skipped.count++;
-                          createInfo->runningInfo.progress.skipped.size += fileInfo.size;
-                        }
-                      }
-                    }
-                  }
-                  break;
-                default:
-                  if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                  {
-                    printInfo(2,"Unknown type of file '%s' - skipped\n",String_cString(name));
-                    logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_TYPE_UNKNOWN,"Unknown type '%s'",String_cString(name));
-
-                    STATUS_INFO_UPDATE(createInfo,name,NULL)
-                    {
-                      createInfo->runningInfo.progress.error.count++;
-                      createInfo->runningInfo.progress.error.size += (uint64)fileInfo.size;
-                    }
-                  }
-                  break;
-              }
-            }
+/***********************************************************************\
+* Name   : deleteScanDirectoryNode
+* Purpose: delete scan directory node
+* Input  : scanDirectoryNode - scan directory node
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
 
-            // mark as stored
-            if (collectorType == COLLECTOR_TYPE_ENTRIES)
-            {
-              error = Continuous_markEntryStored(&continuousDatabaseHandle,databaseId);
-              if (error != ERROR_NONE)
-              {
-                printError(_("cannot mark continuous entry '%s' as stored (error: %s)"),
-                           String_cString(name),
-                           Error_getText(error)
-                          );
-                logMessage(createInfo->logHandle,
-                           LOG_TYPE_ENTRY_ACCESS_DENIED,
-                           "Cannot mark continuous entry '%s' as stored (error: %s)",
-                           String_cString(name),
-                           Error_getText(error)
-                          );
+LOCAL void deleteScanDirectoryNode(ScanDirectoryNode *scanDirectoryNode)
+{
+  assert(scanDirectoryNode != NULL);
 
-                STATUS_INFO_UPDATE(createInfo,name,NULL)
-                {
-                  createInfo->runningInfo.progress.error.count++;
-                }
-                continue;
-              }
-            }
+  freeScanDirectoryNode(scanDirectoryNode,NULL);
+  LIST_DELETE_NODE(scanDirectoryNode);
+}
 
-            // free resources
-          }
-          String_delete(name);
+/***********************************************************************\
+* Name   : scanDirectory
+* Purpose: read all entries of a directory and apply include/exclude
+*          patterns
+* Input  : directoryScanner  - directory scanner
+*          scanDirectoryNode - directory to scan
+* Output : -
+* Return : -
+* Notes  : called without directory scanner lock
+\***********************************************************************/
 
-          Continuous_doneList(&databaseStatementHandle);
-        }
+LOCAL void scanDirectory(const DirectoryScanner *directoryScanner, ScanDirectoryNode *scanDirectoryNode)
+{
+  assert(directoryScanner != NULL);
+  assert(scanDirectoryNode != NULL);
 
-        // close continuous database
-        Continuous_close(&continuousDatabaseHandle);
+  DirectoryListHandle directoryListHandle;
+  scanDirectoryNode->error = File_openDirectoryList(&directoryListHandle,scanDirectoryNode->name);
+  if (scanDirectoryNode->error == ERROR_NONE)
+  {
+    while (   !directoryScanner->quitFlag
+           && !isAborted(directoryScanner->createInfo)
+           && !File_endOfDirectoryList(&directoryListHandle)
+          )
+    {
+      ScanEntryNode *scanEntryNode = LIST_NEW_NODE(ScanEntryNode);
+      if (scanEntryNode == NULL)
+      {
+        HALT_INSUFFICIENT_MEMORY();
+      }
+      scanEntryNode->name  = String_new();
+      memClear(&scanEntryNode->fileInfo,sizeof(scanEntryNode->fileInfo));
+      scanEntryNode->error = File_readDirectoryList(&directoryListHandle,scanEntryNode->name,&scanEntryNode->fileInfo);
+      if (scanEntryNode->error == ERROR_NONE)
+      {
+        scanEntryNode->includedFlag =    isIncluded(directoryScanner->includeEntryNode,scanEntryNode->name);
+        scanEntryNode->excludedFlag =    scanEntryNode->includedFlag
+                                      && isInExcludedList(directoryScanner->createInfo->excludePatternList,scanEntryNode->name);
       }
       else
       {
-        if (collectorType == COLLECTOR_TYPE_ENTRIES)
-        {
-          printError(_("cannot initialize continuous database (error: %s)!"),
-                     Error_getText(error)
-                    );
-        }
+        scanEntryNode->includedFlag = FALSE;
+        scanEntryNode->excludedFlag = FALSE;
       }
+      List_append(&scanDirectoryNode->entryList,scanEntryNode);
     }
+
+    File_closeDirectoryList(&directoryListHandle);
   }
-  else
+}
+
+/***********************************************************************\
+* Name   : addScanSubDirectories
+* Purpose: add sub-directories of a scanned directory to wait list
+* Input  : directoryScanner  - directory scanner
+*          scanDirectoryNode - scanned directory
+*          threadIndex       - index of scan thread wait list
+* Output : -
+* Return : TRUE iff entries of scanned directory are read by collector,
+*          FALSE if directory contains a .nobackup file
+* Notes  : directory scanner must be locked; skip sub-directories which
+*          are not traversed by the collector (no dump attribute,
+*          .nobackup file)
+\***********************************************************************/
+
+LOCAL bool addScanSubDirectories(DirectoryScanner        *directoryScanner,
+                                 const ScanDirectoryNode *scanDirectoryNode,
+                                 uint                    threadIndex
+                                )
+{
+  assert(directoryScanner != NULL);
+  assert(directoryScanner->createInfo != NULL);
+  assert(directoryScanner->createInfo->jobOptions != NULL);
+  assert(scanDirectoryNode != NULL);
+  assert(threadIndex < directoryScanner->threadCount);
+
+  const ScanEntryNode *scanEntryNode;
+
+  // check for .nobackup file
+  bool noBackupFlag = FALSE;
+  if (!globalOptions.ignoreNoBackupFileFlag)
   {
+    String baseName = String_new();
+    LIST_ITERATEX(&scanDirectoryNode->entryList,scanEntryNode,!noBackupFlag)
+    {
+      File_getBaseName(baseName,scanEntryNode->name,TRUE);
+      noBackupFlag =    String_equalsCString(baseName,".nobackup")
+                     || String_equalsCString(baseName,".NOBACKUP");
+    }
+    String_delete(baseName);
+  }
 
-    // process include entries
-    StringList      nameList;
-    StringList_init(&nameList);
-    String path     = String_new();
-    String fileName = String_new();
-    EntryNode *includeEntryNode = LIST_HEAD(createInfo->includeEntryList);
-    while (   (createInfo->failError == ERROR_NONE)
-           && !isAborted(createInfo)
-           && (includeEntryNode != NULL)
-          )
+  if (!noBackupFlag)
+  {
+    LIST_ITERATE(&scanDirectoryNode->entryList,scanEntryNode)
     {
-      Errors error;
+      if (   (scanEntryNode->error == ERROR_NONE)
+          && (scanEntryNode->fileInfo.type == FILE_TYPE_DIRECTORY)
+          && (directoryScanner->createInfo->jobOptions->ignoreNoDumpAttributeFlag || !File_hasAttributeNoDump(&scanEntryNode->fileInfo))
+          && isTraverseDirectory(directoryScanner->createInfo,scanEntryNode->name)
+          && !Dictionary_contains(&directoryScanner->directoryDictionary,String_cString(scanEntryNode->name),String_length(scanEntryNode->name))
+         )
+      {
+        ScanDirectoryNode *subDirectoryNode = newScanDirectoryNode(scanEntryNode->name,threadIndex);
+        List_append(&directoryScanner->threads[threadIndex].waitList,subDirectoryNode);
+        Dictionary_add(&directoryScanner->directoryDictionary,
+                       String_cString(subDirectoryNode->name),
+                       String_length(subDirectoryNode->name),
+                       &subDirectoryNode,
+                       sizeof(subDirectoryNode)
+                      );
+      }
+    }
+  }
 
-      // pause
-      pauseCreate(createInfo);
+  return !noBackupFlag;
+}
 
-      // find base path
-      StringTokenizer fileNameTokenizer;
-      ConstString     token;
-      File_initSplitFileName(&fileNameTokenizer,includeEntryNode->string);
-      if (File_getNextSplitFileName(&fileNameTokenizer,&token) && !Pattern_checkIsPattern(token))
+/***********************************************************************\
+* Name   : directoryScannerThreadCode
+* Purpose: directory scan thread: scan directories from own wait list
+*          or steal directories from wait lists of other scan threads
+* Input  : directoryScanThread - directory scan thread
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void directoryScannerThreadCode(DirectoryScanThread *directoryScanThread)
+{
+  assert(directoryScanThread != NULL);
+  assert(directoryScanThread->directoryScanner != NULL);
+
+  DirectoryScanner *directoryScanner = directoryScanThread->directoryScanner;
+
+  Semaphore_lock(&directoryScanner->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER);
+  {
+    while (   !directoryScanner->quitFlag
+           && !isAborted(directoryScanner->createInfo)
+          )
+    {
+      // get next directory: newest from own wait list, else oldest from other wait lists
+      ScanDirectoryNode *scanDirectoryNode = NULL;
+      if (directoryScanner->entryCount < MAX_DIRECTORY_SCAN_ENTRIES)
       {
-        if (!String_isEmpty(token))
+        scanDirectoryNode = (ScanDirectoryNode*)List_removeLast(&directoryScanThread->waitList);
+        for (uint i = 1; (i < directoryScanner->threadCount) && (scanDirectoryNode == NULL); i++)
         {
-          File_setFileName(path,token);
+          scanDirectoryNode = (ScanDirectoryNode*)List_removeFirst(&directoryScanner->threads[(directoryScanThread->index+i) % directoryScanner->threadCount].waitList);
         }
-        else
+      }
+
+      if (scanDirectoryNode != NULL)
+      {
+        scanDirectoryNode->state = SCAN_DIRECTORY_STATE_RUNNING;
+
+        // scan directory
+        Semaphore_unlock(&directoryScanner->lock);
+        {
+          pauseCreate(directoryScanner->createInfo);
+          scanDirectory(directoryScanner,scanDirectoryNode);
+        }
+        Semaphore_lock(&directoryScanner->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER);
+
+        // add sub-directories, store result (Note: entries of a directory with .nobackup are not read by collector)
+        if (!addScanSubDirectories(directoryScanner,scanDirectoryNode,directoryScanThread->index))
         {
-          File_getSystemDirectory(path,FILE_SYSTEM_PATH_ROOT,NULL);
+          List_clear(&scanDirectoryNode->entryList);
         }
+        scanDirectoryNode->state = SCAN_DIRECTORY_STATE_DONE;
+        List_append(&directoryScanner->doneList,scanDirectoryNode);
+        directoryScanner->entryCount += List_count(&scanDirectoryNode->entryList);
+
+        Semaphore_signalModified(&directoryScanner->lock,SEMAPHORE_SIGNAL_MODIFY_ALL);
       }
       else
       {
-        String_clear(path);
-      }
-      while (File_getNextSplitFileName(&fileNameTokenizer,&token) && !Pattern_checkIsPattern(token))
-      {
-        File_appendFileName(path,token);
+        // wait for new directories or entries processed by collector (back-pressure)
+        Semaphore_waitModified(&directoryScanner->lock,WAIT_FOREVER);
       }
-      File_doneSplitFileName(&fileNameTokenizer);
+    }
+  }
+  Semaphore_unlock(&directoryScanner->lock);
+}
 
-      // find files starting from base path
-      String name = String_new();
-      StringList_append(&nameList,path);
-      ulong n = 0;
-      while (   (createInfo->failError == ERROR_NONE)
-             && !isAborted(createInfo)
-             && !StringList_isEmpty(&nameList)
-            )
-      {
-        // pause
-        pauseCreate(createInfo);
+/***********************************************************************\
+* Name   : initDirectoryScanner
+* Purpose: init directory scanner and start scan threads
+* Input  : directoryScanner - directory scanner variable
+*          createInfo       - create info
+*          includeEntryNode - include entry
+*          name             - base directory name
+*          threadCount      - number of scan threads or 0 to read
+*                             directories in collector
+* Output : directoryScanner - directory scanner
+* Return : -
+* Notes  : -
+\***********************************************************************/
 
-        // get next entry to process
-        StringList_removeLast(&nameList,name);
+LOCAL void initDirectoryScanner(DirectoryScanner *directoryScanner,
+                                CreateInfo       *createInfo,
+                                const EntryNode  *includeEntryNode,
+                                ConstString      name,
+                                uint             threadCount
+                               )
+{
+  assert(directoryScanner != NULL);
+  assert(createInfo != NULL);
+  assert(includeEntryNode != NULL);
+  assert(name != NULL);
 
-        // read file info
-        FileInfo fileInfo;
-        if (!String_isEmpty(name))
-        {
-          String_set(path,name);
-        }
-        else
-        {
-          File_getCurrentDirectory(path);
-        }
-        error = File_getInfo(&fileInfo,path);
-        if (error != ERROR_NONE)
-        {
-          if (collectorType == COLLECTOR_TYPE_ENTRIES)
-          {
-            if (createInfo->jobOptions->skipUnreadableFlag)
-            {
-              printWarning(_("cannot get info for '%s' (error: %s) - skipped"),String_cString(path),Error_getText(error));
-            }
-            else
-            {
-              printError(_("cannot get info for '%s' (error: %s)"),
-                         String_cString(path),
-                         Error_getText(error)
-                        );
-            }
-            logMessage(createInfo->logHandle,
-                       LOG_TYPE_ENTRY_ACCESS_DENIED,
-                       "Access denied '%s' (error: %s)",
-                       String_cString(path),
-                       Error_getText(error)
-                      );
+  // init variables
+  directoryScanner->createInfo       = createInfo;
+  directoryScanner->includeEntryNode = includeEntryNode;
+  directoryScanner->threadCount      = threadCount;
+  directoryScanner->nextThreadIndex  = 0;
+  directoryScanner->entryCount       = 0L;
+  directoryScanner->quitFlag         = FALSE;
+  if (!Semaphore_init(&directoryScanner->lock,SEMAPHORE_TYPE_BINARY))
+  {
+    HALT_FATAL_ERROR("Cannot initialize directory scanner semaphore!");
+  }
+  if (!Dictionary_init(&directoryScanner->directoryDictionary,DICTIONARY_BYTE_INIT_ENTRY,DICTIONARY_BYTE_DONE_ENTRY,DICTIONARY_BYTE_COMPARE_ENTRY))
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  List_init(&directoryScanner->doneList,CALLBACK_(NULL,NULL),CALLBACK_((ListNodeFreeFunction)freeScanDirectoryNode,NULL));
+  directoryScanner->threads = NULL;
+  ThreadPool_initSet(&directoryScanner->threadSet,&workerThreadPool);
 
-            STATUS_INFO_UPDATE(createInfo,name,NULL)
-            {
-              createInfo->runningInfo.progress.error.count++;
-            }
-          }
-          continue;
-        }
+  if (threadCount > 0)
+  {
+    directoryScanner->threads = (DirectoryScanThread*)malloc(threadCount*sizeof(DirectoryScanThread));
+    if (directoryScanner->threads == NULL)
+    {
+      HALT_INSUFFICIENT_MEMORY();
+    }
+    for (uint i = 0; i < threadCount; i++)
+    {
+      directoryScanner->threads[i].directoryScanner = directoryScanner;
+      directoryScanner->threads[i].index            = i;
+      List_init(&directoryScanner->threads[i].waitList,CALLBACK_(NULL,NULL),CALLBACK_((ListNodeFreeFunction)freeScanDirectoryNode,NULL));
+    }
 
-        // increment number of possible found entries
-        n++;
+    // start with base directory
+    ScanDirectoryNode *scanDirectoryNode = newScanDirectoryNode(name,0);
+    List_append(&directoryScanner->threads[0].waitList,scanDirectoryNode);
+    Dictionary_add(&directoryScanner->directoryDictionary,
+                   String_cString(scanDirectoryNode->name),
+                   String_length(scanDirectoryNode->name),
+                   &scanDirectoryNode,
+                   sizeof(scanDirectoryNode)
+                  );
 
-        if (createInfo->jobOptions->ignoreNoDumpAttributeFlag || !File_hasAttributeNoDump(&fileInfo))
-        {
-          switch (fileInfo.type)
-          {
-            case FILE_TYPE_FILE:
-              if (isIncluded(includeEntryNode,name))
-              {
-                if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
-                {
-                  // add to known names history
-                  Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
+    // start scan threads
+    for (uint i = 0; i < threadCount; i++)
+    {
+      ThreadPool_setAdd(&directoryScanner->threadSet,
+                        ThreadPool_run(&workerThreadPool,directoryScannerThreadCode,&directoryScanner->threads[i])
+                       );
+    }
+  }
+}
 
-                  if (!isInExcludedList(createInfo->excludePatternList,name))
-                  {
-                    switch (includeEntryNode->storeType)
-                    {
-                      case ENTRY_STORE_TYPE_FILE:
-                        if (   !createInfo->partialFlag
-                            || isFileChanged(&createInfo->namesDictionary,name,&fileInfo)
-                           )
-                        {
-                          switch (collectorType)
-                          {
-                            case COLLECTOR_TYPE_ENTRIES:
-                              // add to entry list
-                              if (createInfo->partialFlag && isPrintInfo(2))
-                              {
-                                printIncrementalInfo(&createInfo->namesDictionary,name,&fileInfo.cast);
-                              }
-                              appendFileToEntryList(createInfo,
-                                                    name,
-                                                    &fileInfo,
-                                                    !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
-                                                   );
-                              break;
-                            case COLLECTOR_TYPE_SUM:
-                              STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                              {
-                                createInfo->runningInfo.progress.total.count++;
-                                createInfo->runningInfo.progress.total.size += fileInfo.size;
-                              }
-                              break;
-                          }
-                        }
-                        break;
-                      case ENTRY_STORE_TYPE_IMAGE:
-                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                        {
-                          printWarning(_("'%s' is not a device"),String_cString(name));
-                        }
-                        break;
-                      default:
-                        #ifndef NDEBUG
-                          HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
-                        #endif /* NDEBUG */
-                        break; /* not reached */
-                    }
-                  }
-                  else
-                  {
-                    logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
+/***********************************************************************\
+* Name   : doneDirectoryScanner
+* Purpose: stop scan threads and done directory scanner
+* Input  : directoryScanner - directory scanner
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
 
-                    STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                    {
-                      createInfo->runningInfo.progress.skipped.count++;
-                      createInfo->runningInfo.progress.skipped.size += fileInfo.size;
-                    }
-                  }
-                }
-              }
-              break;
-            case FILE_TYPE_DIRECTORY:
-              // add to known names history
-              Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
+LOCAL void doneDirectoryScanner(DirectoryScanner *directoryScanner)
+{
+  assert(directoryScanner != NULL);
 
-              if (globalOptions.ignoreNoBackupFileFlag || !hasNoBackup(name))
-              {
-                if (isIncluded(includeEntryNode,name))
-                {
-                  if (!isInExcludedList(createInfo->excludePatternList,name))
-                  {
-                    switch (includeEntryNode->storeType)
-                    {
-                      case ENTRY_STORE_TYPE_FILE:
-                        if (   !createInfo->partialFlag
-                            || isFileChanged(&createInfo->namesDictionary,name,&fileInfo)
-                           )
-                        {
-                          switch (collectorType)
-                          {
-                            case COLLECTOR_TYPE_ENTRIES:
-                              // add to entry list
-                              if (createInfo->partialFlag && isPrintInfo(2))
-                              {
-                                printIncrementalInfo(&createInfo->namesDictionary,name,&fileInfo.cast);
-                              }
-                              appendDirectoryToEntryList(createInfo,
-                                                         name,
-                                                         &fileInfo
-                                                        );
-                              break;
-                            case COLLECTOR_TYPE_SUM:
-                              STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                              {
-                                createInfo->runningInfo.progress.total.count++;
-                              }
-                              break;
-                          }
-                        }
-                        break;
-                      case ENTRY_STORE_TYPE_IMAGE:
-                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                        {
-                          printWarning(_("'%s' is not a device"),String_cString(name));
-                        }
-                        break;
-                      default:
-                        #ifndef NDEBUG
-                          HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
-                        #endif /* NDEBUG */
-                        break; /* not reached */
-                    }
-                  }
-                  else
-                  {
-                    if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                    {
-                      logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
+  // stop scan threads
+  SEMAPHORE_LOCKED_DO(&directoryScanner->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  {
+    directoryScanner->quitFlag = TRUE;
+    Semaphore_signalModified(&directoryScanner->lock,SEMAPHORE_SIGNAL_MODIFY_ALL);
+  }
+  ThreadPool_joinSet(&directoryScanner->threadSet);
+  ThreadPool_doneSet(&directoryScanner->threadSet);
 
-                      STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                      {
-                        createInfo->runningInfo.progress.skipped.count++;
-                        createInfo->runningInfo.progress.skipped.size += fileInfo.size;
-                      }
-                    }
-                  }
-                }
+  // free resources
+  if (directoryScanner->threads != NULL)
+  {
+    for (uint i = 0; i < directoryScanner->threadCount; i++)
+    {
+      List_done(&directoryScanner->threads[i].waitList);
+    }
+    free(directoryScanner->threads);
+  }
+  List_done(&directoryScanner->doneList);
+  Dictionary_done(&directoryScanner->directoryDictionary);
+  Semaphore_done(&directoryScanner->lock);
+}
 
-                // open directory contents
-                DirectoryListHandle directoryListHandle;
-                error = File_openDirectoryList(&directoryListHandle,name);
-                if (error == ERROR_NONE)
-                {
-                  // read directory content
-                  while (   (createInfo->failError == ERROR_NONE)
-                         && !isAborted(createInfo)
-                         && !File_endOfDirectoryList(&directoryListHandle)
-                        )
-                  {
-                    // pause
-                    pauseCreate(createInfo);
+/***********************************************************************\
+* Name   : getScanDirectory
+* Purpose: get scanned directory
+* Input  : directoryScanner - directory scanner
+*          name             - directory name
+* Output : -
+* Return : scanned directory
+* Notes  : wait if directory is scanned by a scan thread; scan directory
+*          if it is not scanned yet
+\***********************************************************************/
 
-                    // read next directory entry
-                    FileInfo fileInfo;
-                    error = File_readDirectoryList(&directoryListHandle,fileName,&fileInfo);
-                    if (error != ERROR_NONE)
-                    {
-                      if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                      {
-                        printError(_("cannot read directory '%s' (error: %s) - skipped"),String_cString(name),Error_getText(error));
-                        logMessage(createInfo->logHandle,
-                                   LOG_TYPE_ENTRY_ACCESS_DENIED,
-                                   "Access denied '%s' (error: %s)",
-                                   String_cString(name),
-                                   Error_getText(error)
-                                  );
+LOCAL ScanDirectoryNode *getScanDirectory(DirectoryScanner *directoryScanner, ConstString name)
+{
+  assert(directoryScanner != NULL);
+  assert(directoryScanner->threadCount > 0);
+  assert(name != NULL);
 
-                        STATUS_INFO_UPDATE(createInfo,fileName,NULL)
-                        {
-                          createInfo->runningInfo.progress.error.count++;
-                          createInfo->runningInfo.progress.error.size += fileInfo.size;
-                        }
-                      }
-                      continue;
-                    }
+  ScanDirectoryNode *scanDirectoryNode = NULL;
+  bool              scanFlag           = FALSE;
+  SEMAPHORE_LOCKED_DO(&directoryScanner->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  {
+    while (scanDirectoryNode == NULL)
+    {
+      union { void *value; ScanDirectoryNode **scanDirectoryNode; } data;
+      if (Dictionary_find(&directoryScanner->directoryDictionary,
+                          String_cString(name),
+                          String_length(name),
+                          &data.value,
+                          NULL
+                         )
+         )
+      {
+        switch ((*data.scanDirectoryNode)->state)
+        {
+          case SCAN_DIRECTORY_STATE_WAIT:
+            // not scanned yet: take from wait list and scan
+            scanDirectoryNode = (*data.scanDirectoryNode);
+            List_remove(&directoryScanner->threads[scanDirectoryNode->threadIndex].waitList,scanDirectoryNode);
+            Dictionary_remove(&directoryScanner->directoryDictionary,String_cString(name),String_length(name));
+            scanFlag = TRUE;
+            break;
+          case SCAN_DIRECTORY_STATE_RUNNING:
+            // wait until scan is done
+            Semaphore_waitModified(&directoryScanner->lock,WAIT_FOREVER);
+            break;
+          case SCAN_DIRECTORY_STATE_DONE:
+            // scanned: take from done list
+            scanDirectoryNode = (*data.scanDirectoryNode);
+            List_remove(&directoryScanner->doneList,scanDirectoryNode);
+            Dictionary_remove(&directoryScanner->directoryDictionary,String_cString(name),String_length(name));
+            assert(directoryScanner->entryCount >= List_count(&scanDirectoryNode->entryList));
+            directoryScanner->entryCount -= List_count(&scanDirectoryNode->entryList);
+            Semaphore_signalModified(&directoryScanner->lock,SEMAPHORE_SIGNAL_MODIFY_ALL);
+            break;
+        }
+      }
+      else
+      {
+        // unknown: scan
+        scanDirectoryNode = newScanDirectoryNode(name,0);
+        scanFlag = TRUE;
+      }
+    }
+  }
+  assert(scanDirectoryNode != NULL);
 
-                    // add sub-directories to directory search list
-                    if (fileInfo.type == FILE_TYPE_DIRECTORY)
-                    {
-                      StringList_append(&nameList,fileName);
-                    }
+  if (scanFlag)
+  {
+    scanDirectory(directoryScanner,scanDirectoryNode);
 
-                    if (isIncluded(includeEntryNode,fileName))
-                    {
-                      if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(fileName),String_length(fileName)))
-                      {
-                        // add to known names history
-                        Dictionary_add(&duplicateNamesDictionary,String_cString(fileName),String_length(fileName),NULL,0);
+    // add sub-directories for scan threads
+    SEMAPHORE_LOCKED_DO(&directoryScanner->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+    {
+      (void)addScanSubDirectories(directoryScanner,scanDirectoryNode,directoryScanner->nextThreadIndex);
+      directoryScanner->nextThreadIndex = (directoryScanner->nextThreadIndex+1) % directoryScanner->threadCount;
+      Semaphore_signalModified(&directoryScanner->lock,SEMAPHORE_SIGNAL_MODIFY_ALL);
+    }
+  }
 
-                        if (!isInExcludedList(createInfo->excludePatternList,fileName))
-                        {
-                          if (createInfo->jobOptions->ignoreNoDumpAttributeFlag || !File_hasAttributeNoDump(&fileInfo))
-                          {
-                            switch (fileInfo.type)
-                            {
-                              case FILE_TYPE_FILE:
-                                switch (includeEntryNode->storeType)
-                                {
-                                  case ENTRY_STORE_TYPE_FILE:
-                                    if (   !createInfo->partialFlag
-                                        || isFileChanged(&createInfo->namesDictionary,fileName,&fileInfo)
-                                       )
-                                    {
-                                      switch (collectorType)
-                                      {
-                                        case COLLECTOR_TYPE_ENTRIES:
-                                          // add to entry list
-                                          if (createInfo->partialFlag && isPrintInfo(2))
-                                          {
-                                            printIncrementalInfo(&createInfo->namesDictionary,fileName,&fileInfo.cast);
-                                          }
-                                          appendFileToEntryList(createInfo,
-                                                                fileName,
-                                                                &fileInfo,
-                                                                !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
-                                                               );
-                                          break;
-                                        case COLLECTOR_TYPE_SUM:
-                                          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                                          {
-                                            createInfo->runningInfo.progress.total.count++;
-                                            createInfo->runningInfo.progress.total.size += fileInfo.size;
-                                          }
-                                          break;
-                                      }
-                                    }
-                                    break;
-                                  case ENTRY_STORE_TYPE_IMAGE:
-                                    if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                                    {
-                                      printWarning(_("'%s' is not a device"),String_cString(fileName));
-                                    }
-                                    break;
-                                  default:
-                                    #ifndef NDEBUG
-                                      HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
-                                    #endif /* NDEBUG */
-                                    break; /* not reached */
-                                }
-                                break;
-                              case FILE_TYPE_DIRECTORY:
-                                // nothing to do: directory is appended to include list
-                                break;
-                              case FILE_TYPE_LINK:
-                                switch (includeEntryNode->storeType)
-                                {
-                                  case ENTRY_STORE_TYPE_FILE:
-                                    if (   !createInfo->partialFlag
-                                        || isFileChanged(&createInfo->namesDictionary,fileName,&fileInfo)
+  return scanDirectoryNode;
+}
+
+/***********************************************************************\
+* Name   : openCollectorDirectoryList
+* Purpose: open directory list for collector
+* Input  : collectorDirectoryListHandle - directory list handle variable
+*          directoryScanner             - directory scanner
+*          name                         - directory name
+* Output : collectorDirectoryListHandle - directory list handle
+* Return : ERROR_NONE or error code
+* Notes  : use entries read by directory scanner if scan threads are
+*          enabled
+\***********************************************************************/
+
+LOCAL Errors openCollectorDirectoryList(CollectorDirectoryListHandle *collectorDirectoryListHandle,
+                                        DirectoryScanner             *directoryScanner,
+                                        ConstString                  name
                                        )
-                                    {
-                                      switch (collectorType)
-                                      {
-                                        case COLLECTOR_TYPE_ENTRIES:
-                                          // add to entry list
-                                          if (createInfo->partialFlag && isPrintInfo(2))
-                                          {
-                                            printIncrementalInfo(&createInfo->namesDictionary,fileName,&fileInfo.cast);
-                                          }
-                                          appendLinkToEntryList(createInfo,
-                                                                fileName,
-                                                                &fileInfo
-                                                               );
-                                          break;
-                                        case COLLECTOR_TYPE_SUM:
-                                          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                                          {
-                                            createInfo->runningInfo.progress.total.count++;
-                                          }
-                                          break;
-                                      }
-                                    }
-                                    break;
-                                  case ENTRY_STORE_TYPE_IMAGE:
-                                    if (File_readLink(fileName,name,TRUE) == ERROR_NONE)
-                                    {
-                                      // get device info
-                                      DeviceInfo deviceInfo;
-                                      error = Device_getInfo(&deviceInfo,fileName,TRUE);
-                                      if (error != ERROR_NONE)
-                                      {
-                                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                                        {
-                                          if (createInfo->jobOptions->skipUnreadableFlag)
-                                          {
-                                            printWarning(_("cannot get info for '%s' (error: %s) - skipped"),String_cString(fileName),Error_getText(error));
-                                          }
-                                          else
-                                          {
-                                            printError(_("cannot get info for '%s' (error: %s)"),
-                                                       String_cString(fileName),
-                                                       Error_getText(error)
-                                                      );
-                                          }
-                                          logMessage(createInfo->logHandle,
-                                                     LOG_TYPE_ENTRY_ACCESS_DENIED,
-                                                     "Access denied '%s' (error: %s)",
-                                                     String_cString(fileName),
-                                                     Error_getText(error)
-                                                    );
+{
+  assert(collectorDirectoryListHandle != NULL);
+  assert(directoryScanner != NULL);
+  assert(name != NULL);
 
-                                          STATUS_INFO_UPDATE(createInfo,name,NULL)
-                                          {
-                                            createInfo->runningInfo.progress.error.count++;
-                                          }
-                                        }
-                                        continue;
-                                      }
+  Errors error;
 
-                                      switch (collectorType)
-                                      {
-                                        case COLLECTOR_TYPE_ENTRIES:
-                                          // add to entry list
-                                          appendImageToEntryList(createInfo,
-                                                                 name,
-                                                                 &deviceInfo,
-                                                                 !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
-                                                                );
-                                          break;
-                                        case COLLECTOR_TYPE_SUM:
-                                          if (deviceInfo.type == DEVICE_TYPE_BLOCK)
-                                          {
-                                            STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                                            {
-                                              createInfo->runningInfo.progress.total.count++;
-                                              createInfo->runningInfo.progress.total.size += deviceInfo.size;
-                                            }
-                                          }
-                                          break;
-                                      }
-                                    }
-                                    break;
-                                  default:
-                                    #ifndef NDEBUG
-                                      HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
-                                    #endif /* NDEBUG */
-                                    break; /* not reached */
-                                }
-                                break;
-                              case FILE_TYPE_HARDLINK:
-                                switch (includeEntryNode->storeType)
-                                {
-                                  case ENTRY_STORE_TYPE_FILE:
-                                    {
-                                      if (   !createInfo->partialFlag
-                                          || isFileChanged(&createInfo->namesDictionary,fileName,&fileInfo)
-                                          )
-                                      {
-                                        union { void *value; HardLinkInfo *hardLinkInfo; } data;
-                                        HardLinkInfo                                       hardLinkInfo;
-                                        if (Dictionary_find(&hardLinksDictionary,
-                                                            &fileInfo.id,
-                                                            sizeof(fileInfo.id),
-                                                            &data.value,
-                                                            NULL
-                                                           )
-                                            )
-                                        {
-                                          // append name to hard link name list
-                                          StringList_append(&data.hardLinkInfo->nameList,fileName);
+  collectorDirectoryListHandle->directoryScanner  = directoryScanner;
+  collectorDirectoryListHandle->scanDirectoryNode = NULL;
+  collectorDirectoryListHandle->scanEntryNode     = NULL;
+  if (directoryScanner->threadCount > 0)
+  {
+    ScanDirectoryNode *scanDirectoryNode = getScanDirectory(directoryScanner,name);
+    error = scanDirectoryNode->error;
+    if (error == ERROR_NONE)
+    {
+      collectorDirectoryListHandle->scanDirectoryNode = scanDirectoryNode;
+      collectorDirectoryListHandle->scanEntryNode     = LIST_HEAD(&scanDirectoryNode->entryList);
+    }
+    else
+    {
+      deleteScanDirectoryNode(scanDirectoryNode);
+    }
+  }
+  else
+  {
+    error = File_openDirectoryList(&collectorDirectoryListHandle->directoryListHandle,name);
+  }
 
-                                          if (StringList_count(&data.hardLinkInfo->nameList) >= data.hardLinkInfo->count)
-                                          {
-                                            // found last hardlink
+  return error;
+}
 
-                                            switch (collectorType)
-                                            {
-                                              case COLLECTOR_TYPE_ENTRIES:
-                                                // add to entry list
-                                                appendHardLinkToEntryList(createInfo,
-                                                                          &data.hardLinkInfo->nameList,
-                                                                          &data.hardLinkInfo->fileInfo,
-                                                                          !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
-                                                                         );
-                                                break;
-                                              case COLLECTOR_TYPE_SUM:
-                                                // update status
-                                                STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                                                {
-                                                  createInfo->runningInfo.progress.total.count++;
-                                                  createInfo->runningInfo.progress.total.size += fileInfo.size;
-                                                }
-                                                break;
-                                            }
+/***********************************************************************\
+* Name   : closeCollectorDirectoryList
+* Purpose: close directory list for collector
+* Input  : collectorDirectoryListHandle - directory list handle
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
 
-                                            // clear entry
-                                            Dictionary_remove(&hardLinksDictionary,
-                                                              &fileInfo.id,
-                                                              sizeof(fileInfo.id)
-                                                             );
-                                          }
-                                        }
-                                        else
-                                        {
-                                          // create hard link name list
-                                          if (createInfo->partialFlag && isPrintInfo(2))
-                                          {
-                                            printIncrementalInfo(&createInfo->namesDictionary,
-                                                                 fileName,
-                                                                 &fileInfo.cast
-                                                                );
-                                          }
+LOCAL void closeCollectorDirectoryList(CollectorDirectoryListHandle *collectorDirectoryListHandle)
+{
+  assert(collectorDirectoryListHandle != NULL);
+  assert(collectorDirectoryListHandle->directoryScanner != NULL);
 
-                                          hardLinkInfo.count = fileInfo.linkCount;
-                                          StringList_init(&hardLinkInfo.nameList);
-                                          StringList_append(&hardLinkInfo.nameList,fileName);
-                                          memCopyFast(&hardLinkInfo.fileInfo,sizeof(hardLinkInfo.fileInfo),&fileInfo,sizeof(fileInfo));
+  if (collectorDirectoryListHandle->directoryScanner->threadCount > 0)
+  {
+    assert(collectorDirectoryListHandle->scanDirectoryNode != NULL);
+    deleteScanDirectoryNode(collectorDirectoryListHandle->scanDirectoryNode);
+  }
+  else
+  {
+    File_closeDirectoryList(&collectorDirectoryListHandle->directoryListHandle);
+  }
+}
 
-                                          if (!Dictionary_add(&hardLinksDictionary,
-                                                              &fileInfo.id,
-                                                              sizeof(fileInfo.id),
-                                                              &hardLinkInfo,
-                                                              sizeof(hardLinkInfo)
-                                                             )
-                                              )
-                                          {
-                                            HALT_INSUFFICIENT_MEMORY();
-                                          }
-                                        }
-                                      }
-                                    }
-                                    break;
-                                  case ENTRY_STORE_TYPE_IMAGE:
-                                    // nothing to do
-                                    break;
-                                  default:
-                                    #ifndef NDEBUG
-                                      HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
-                                    #endif /* NDEBUG */
-                                    break; /* not reached */
-                                }
-                                break;
-                              case FILE_TYPE_SPECIAL:
-                                switch (includeEntryNode->storeType)
-                                {
-                                  case ENTRY_STORE_TYPE_FILE:
-                                    if (   !createInfo->partialFlag
-                                        || isFileChanged(&createInfo->namesDictionary,fileName,&fileInfo)
-                                       )
-                                    {
-                                      switch (collectorType)
-                                      {
-                                        case COLLECTOR_TYPE_ENTRIES:
-                                          // add to entry list
-                                          if (createInfo->partialFlag && isPrintInfo(2))
-                                          {
-                                            printIncrementalInfo(&createInfo->namesDictionary,fileName,&fileInfo.cast);
-                                          }
-                                          appendSpecialToEntryList(createInfo,
-                                                                   fileName,
-                                                                   &fileInfo
-                                                                  );
-                                          break;
-                                        case COLLECTOR_TYPE_SUM:
-                                          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                                          {
-                                            createInfo->runningInfo.progress.total.count++;
-                                            if (   (includeEntryNode->storeType == ENTRY_STORE_TYPE_IMAGE)
-                                                && (fileInfo.specialType == FILE_SPECIAL_TYPE_BLOCK_DEVICE)
-                                               )
-                                            {
-                                              createInfo->runningInfo.progress.total.size += fileInfo.size;
-                                            }
-                                          }
-                                          break;
-                                      }
-                                    }
-                                    break;
-                                  case ENTRY_STORE_TYPE_IMAGE:
-                                    if (fileInfo.specialType == FILE_SPECIAL_TYPE_BLOCK_DEVICE)
-                                    {
-                                      // get device info
-                                      DeviceInfo deviceInfo;
-                                      error = Device_getInfo(&deviceInfo,fileName,TRUE);
-                                      if (error != ERROR_NONE)
-                                      {
-                                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                                        {
-                                          printError(_("cannot access '%s' (error: %s) - skipped"),String_cString(name),Error_getText(error));
-                                          logMessage(createInfo->logHandle,
-                                                     LOG_TYPE_ENTRY_ACCESS_DENIED,
-                                                     "Access denied '%s' (error: %s)",
-                                                     String_cString(name),
-                                                     Error_getText(error)
-                                                    );
+/***********************************************************************\
+* Name   : endOfCollectorDirectoryList
+* Purpose: check if end of directory list for collector reached
+* Input  : collectorDirectoryListHandle - directory list handle
+* Output : -
+* Return : TRUE if end of directory list reached, FALSE otherwise
+* Notes  : -
+\***********************************************************************/
 
-                                          STATUS_INFO_UPDATE(createInfo,name,NULL)
-                                          {
-                                            createInfo->runningInfo.progress.error.count++;
-                                          }
-                                        }
-                                        continue;
-                                      }
+LOCAL bool endOfCollectorDirectoryList(CollectorDirectoryListHandle *collectorDirectoryListHandle)
+{
+  assert(collectorDirectoryListHandle != NULL);
+  assert(collectorDirectoryListHandle->directoryScanner != NULL);
 
-                                      switch (collectorType)
-                                      {
-                                        case COLLECTOR_TYPE_ENTRIES:
-                                          // add to entry list
-                                          appendImageToEntryList(createInfo,
-                                                                 fileName,
-                                                                 &deviceInfo,
-                                                                 !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
-                                                                );
-                                          break;
-                                        case COLLECTOR_TYPE_SUM:
-                                          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                                          {
-                                            createInfo->runningInfo.progress.total.count++;
-                                            createInfo->runningInfo.progress.total.size += fileInfo.size;
-                                          }
-                                          break;
-                                      }
-                                    }
-                                    break;
-                                  default:
-                                    #ifndef NDEBUG
-                                      HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
-                                    #endif /* NDEBUG */
-                                    break; /* not reached */
-                                }
-                                break;
-                              default:
-                                if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                                {
-                                  printInfo(2,"Unknown type of file '%s' - skipped\n",String_cString(fileName));
-                                  logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_TYPE_UNKNOWN,"Unknown type '%s'",String_cString(fileName));
+  if (collectorDirectoryListHandle->directoryScanner->threadCount > 0)
+  {
+    return collectorDirectoryListHandle->scanEntryNode == NULL;
+  }
+  else
+  {
+    return File_endOfDirectoryList(&collectorDirectoryListHandle->directoryListHandle);
+  }
+}
 
-                                  STATUS_INFO_UPDATE(createInfo,fileName,NULL)
-                                  {
-                                    createInfo->runningInfo.progress.error.count++;
-                                    createInfo->runningInfo.progress.error.size += fileInfo.size;
-                                  }
-                                }
-                                break;
-                            }
-                          }
-                          else
-                          {
-                            if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                            {
-                              logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s' (no dump attribute)",String_cString(fileName));
+/***********************************************************************\
+* Name   : readCollectorDirectoryList
+* Purpose: read next directory list entry for collector
+* Input  : collectorDirectoryListHandle - directory list handle
+*          fileName                     - file name variable
+*          fileInfo                     - file info variable
+* Output : fileName     - next file name (including path)
+*          fileInfo     - next file info
+*          includedFlag - TRUE iff included by include entry
+*          excludedFlag - TRUE iff included and excluded by exclude
+*                         pattern
+* Return : ERROR_NONE or error code
+* Notes  : include/exclude patterns are applied by the scan threads if
+*          enabled
+\***********************************************************************/
 
-                              STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                              {
-                                createInfo->runningInfo.progress.skipped.count++;
-                                createInfo->runningInfo.progress.skipped.size += fileInfo.size;
-                              }
-                            }
-                          }
-                        }
-                        else
-                        {
-                          if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                          {
-                            logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(fileName));
+LOCAL Errors readCollectorDirectoryList(CollectorDirectoryListHandle *collectorDirectoryListHandle,
+                                        String                       fileName,
+                                        FileInfo                     *fileInfo,
+                                        bool                         *includedFlag,
+                                        bool                         *excludedFlag
+                                       )
+{
+  assert(collectorDirectoryListHandle != NULL);
+  assert(collectorDirectoryListHandle->directoryScanner != NULL);
+  assert(fileName != NULL);
+  assert(fileInfo != NULL);
+  assert(includedFlag != NULL);
+  assert(excludedFlag != NULL);
 
-                            STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                            {
-                              createInfo->runningInfo.progress.skipped.count++;
-                              createInfo->runningInfo.progress.skipped.size += fileInfo.size;
-                            }
-                          }
-                        }
-                      }
-                    }
-                  }
+  Errors error;
 
-                  // close directory
-                  File_closeDirectoryList(&directoryListHandle);
-                }
-                else
-                {
-                  if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                  {
-                    printInfo(2,"Cannot open directory '%s' (error: %s) - skipped\n",String_cString(name),Error_getText(error));
-                    logMessage(createInfo->logHandle,
-                               LOG_TYPE_ENTRY_ACCESS_DENIED,
-                               "Access denied '%s' (error: %s)",
-                               String_cString(name),
-                               Error_getText(error)
-                              );
+  if (collectorDirectoryListHandle->directoryScanner->threadCount > 0)
+  {
+    const ScanEntryNode *scanEntryNode = collectorDirectoryListHandle->scanEntryNode;
+    assert(scanEntryNode != NULL);
 
-                    STATUS_INFO_UPDATE(createInfo,name,NULL)
-                    {
-                      createInfo->runningInfo.progress.error.count++;
-                    }
-                  }
-                }
-              }
-              else
+    String_set(fileName,scanEntryNode->name);
+    memCopyFast(fileInfo,sizeof(FileInfo),&scanEntryNode->fileInfo,sizeof(scanEntryNode->fileInfo));
+    (*includedFlag) = scanEntryNode->includedFlag;
+    (*excludedFlag) = scanEntryNode->excludedFlag;
+    error = scanEntryNode->error;
+
+    collectorDirectoryListHandle->scanEntryNode = scanEntryNode->next;
+  }
+  else
+  {
+    error = File_readDirectoryList(&collectorDirectoryListHandle->directoryListHandle,fileName,fileInfo);
+    if (error == ERROR_NONE)
+    {
+      const DirectoryScanner *directoryScanner = collectorDirectoryListHandle->directoryScanner;
+      (*includedFlag) =    isIncluded(directoryScanner->includeEntryNode,fileName);
+      (*excludedFlag) =    (*includedFlag)
+                        && isInExcludedList(directoryScanner->createInfo->excludePatternList,fileName);
+    }
+  }
+
+  return error;
+}
+
+/***********************************************************************\
+* Name   : collector
+* Purpose: file collector
+* Input  : createInfo    - create info block
+*          collectorType - collector type
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void collector(CreateInfo     *createInfo,
+                     CollectorTypes collectorType
+                    )
+{
+  /***********************************************************************\
+  * Name   : freeHardlinkInfo
+  * Purpose: free hardlink info
+  * Input  : data     - data
+  *          length   - data length
+  *          userData - user data (not used)
+  * Output : -
+  * Return : -
+  * Notes  : -
+  \***********************************************************************/
+
+  auto void freeHardlinkInfo(void *data, ulong length, void *userData);
+  void freeHardlinkInfo(void *data, ulong length, void *userData)
+  {
+    HardLinkInfo *hardLinkInfo = (HardLinkInfo*)data;
+
+    UNUSED_VARIABLE(length);
+    UNUSED_VARIABLE(userData);
+
+    StringList_done(&hardLinkInfo->nameList);
+  }
+
+  assert(createInfo != NULL);
+  assert(createInfo->includeEntryList != NULL);
+  assert(createInfo->excludePatternList != NULL);
+  assert(createInfo->jobOptions != NULL);
+
+  // initialize variables
+  Dictionary         duplicateNamesDictionary;
+  if (!Dictionary_init(&duplicateNamesDictionary,DICTIONARY_BYTE_INIT_ENTRY,DICTIONARY_BYTE_DONE_ENTRY,DICTIONARY_BYTE_COMPARE_ENTRY))
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  Dictionary         hardLinksDictionary;
+  if (!Dictionary_init(&hardLinksDictionary,DICTIONARY_BYTE_INIT_ENTRY,CALLBACK_(freeHardlinkInfo,NULL),DICTIONARY_BYTE_COMPARE_ENTRY))
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  if (createInfo->archiveType == ARCHIVE_TYPE_CONTINUOUS)
+  {
+    if (Continuous_isAvailable())
+    {
+      Errors error;
+      // open continuous database
+      DatabaseHandle continuousDatabaseHandle;
+      error = Continuous_open(&continuousDatabaseHandle);
+      if (error == ERROR_NONE)
+      {
+        // process entries from continuous database
+        DatabaseStatementHandle databaseStatementHandle;
+        error = Continuous_initList(&databaseStatementHandle,
+                                    &continuousDatabaseHandle,
+                                    createInfo->jobUUID,
+                                    createInfo->scheduleUUID
+                                   );
+        if (error == ERROR_NONE)
+        {
+          DatabaseId databaseId;
+          String     name = String_new();
+          while (   (createInfo->failError == ERROR_NONE)
+                 && !isAborted(createInfo)
+                 && Continuous_getNext(&databaseStatementHandle,&databaseId,name)
+                )
+          {
+            // pause
+            pauseCreate(createInfo);
+
+            // check if file still exists
+            if (!File_exists(name))
+            {
+              continue;
+            }
+
+            // read file info
+            FileInfo fileInfo;
+            error = File_getInfo(&fileInfo,name);
+            if (error != ERROR_NONE)
+            {
+              if (collectorType == COLLECTOR_TYPE_ENTRIES)
               {
-                if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                if (createInfo->jobOptions->skipUnreadableFlag)
                 {
-                  logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s' (.nobackup file)",String_cString(name));
+                  printWarning(_("cannot get info for '%s' (error: %s) - skipped"),String_cString(name),Error_getText(error));
                 }
-              }
-              break;
-            case FILE_TYPE_LINK:
-              if (isIncluded(includeEntryNode,name))
-              {
-                if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
+                else
                 {
-                  // add to known names history
-                  Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
+                  printError(_("cannot get info for '%s' (error: %s)"),
+                             String_cString(name),
+                             Error_getText(error)
+                            );
+                }
+                logMessage(createInfo->logHandle,
+                           LOG_TYPE_ENTRY_ACCESS_DENIED,
+                           "Access denied '%s' (error: %s)",
+                           String_cString(name),
+                           Error_getText(error)
+                          );
 
-                  if (!isInExcludedList(createInfo->excludePatternList,name))
+                ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+                updateRunningInfoNoWait(createInfo,name);
+              }
+              continue;
+            }
+
+            // collect entry for storage
+            if (createInfo->jobOptions->ignoreNoDumpAttributeFlag || !File_hasAttributeNoDump(&fileInfo))
+            {
+              switch (fileInfo.type)
+              {
+                case FILE_TYPE_FILE:
+                  if (isInIncludedList(createInfo->includeEntryList,name))
                   {
-                    switch (includeEntryNode->storeType)
+                    if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
                     {
-                      case ENTRY_STORE_TYPE_FILE:
-                        if (  !createInfo->partialFlag
-                            || isFileChanged(&createInfo->namesDictionary,name,&fileInfo)
-                           )
+                      // add to known names history
+                      Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
+
+                      if (   ((globalOptions.continuousMaxSize == 0LL) || fileInfo.size <= globalOptions.continuousMaxSize)
+                          && !isInExcludedList(createInfo->excludePatternList,name)
+                         )
+                      {
+                        switch (collectorType)
                         {
-                          switch (collectorType)
-                          {
-                            case COLLECTOR_TYPE_ENTRIES:
+                          case COLLECTOR_TYPE_ENTRIES:
+                            if ((globalOptions.continuousMaxSize == 0LL) || fileInfo.size <= globalOptions.continuousMaxSize)
+                            {
                               // add to entry list
-                              if (createInfo->partialFlag && isPrintInfo(2))
+                              if (isPrintInfo(2))
                               {
-                                printIncrementalInfo(&createInfo->namesDictionary,name,&fileInfo.cast);
+                                printIncrementalInfo(createInfo,name,&fileInfo.cast);
                               }
-                              appendLinkToEntryList(createInfo,
+                              appendFileToEntryList(createInfo,
                                                     name,
-                                                    &fileInfo
+                                                    &fileInfo,
+                                                    !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
                                                    );
-                              break;
-                            case COLLECTOR_TYPE_SUM:
-                              STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                              {
-                                createInfo->runningInfo.progress.total.count++;
-                              }
-                              break;
-                          }
-                        }
-                        break;
-                      case ENTRY_STORE_TYPE_IMAGE:
-                        {
-                          error = File_readLink(fileName,name,TRUE);
-                          if (error != ERROR_NONE)
-                          {
-                            if (collectorType == COLLECTOR_TYPE_ENTRIES)
-                            {
-                              if (createInfo->jobOptions->skipUnreadableFlag)
-                              {
-                                printWarning(_("cannot get info for '%s' (error: %s) - skipped"),String_cString(path),Error_getText(error));
-                              }
-                              else
-                              {
-                                printError(_("cannot get info for '%s' (error: %s)"),
-                                           String_cString(path),
-                                           Error_getText(error)
-                                          );
-                              }
-                              logMessage(createInfo->logHandle,
-                                         LOG_TYPE_ENTRY_ACCESS_DENIED,
-                                         "Access denied '%s' (error: %s)",
-                                         String_cString(path),
-                                         Error_getText(error)
-                                        );
-
-                              STATUS_INFO_UPDATE(createInfo,name,NULL)
-                              {
-                                createInfo->runningInfo.progress.error.count++;
-                              }
                             }
-                            continue;
-                          }
-
-                          // get device info
-                          DeviceInfo deviceInfo;
-                          error = Device_getInfo(&deviceInfo,fileName,TRUE);
-                          if (error != ERROR_NONE)
-                          {
-                            if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                            else
                             {
-                              printInfo(2,"Cannot access '%s' (error: %s) - skipped\n",String_cString(name),Error_getText(error));
-                              logMessage(createInfo->logHandle,
-                                         LOG_TYPE_ENTRY_ACCESS_DENIED,
-                                         "Access denied '%s' (error: %s)",
-                                         String_cString(name),
-                                         Error_getText(error)
-                                        );
-                            }
+                              logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Size exceeded limit '%s'",String_cString(name));
 
-                            STATUS_INFO_UPDATE(createInfo,name,NULL)
+                              ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+                              updateRunningInfoNoWait(createInfo,NULL);
+                            }
+                            break;
+                          case COLLECTOR_TYPE_SUM:
+                            STATUS_INFO_UPDATE(createInfo,NULL,NULL)
                             {
-                              createInfo->runningInfo.progress.error.count++;
+                              createInfo->runningInfo.progress.total.count++;
+                              createInfo->runningInfo.progress.total.size += fileInfo.size;
                             }
-                            continue;
-                          }
-
-                          switch (collectorType)
-                          {
-                            case COLLECTOR_TYPE_ENTRIES:
-                              // add to entry list
-                              appendImageToEntryList(createInfo,
-                                                     name,
-                                                     &deviceInfo,
-                                                     !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
-                                                    );
-                              break;
-                            case COLLECTOR_TYPE_SUM:
-                              if (deviceInfo.type == DEVICE_TYPE_BLOCK)
-                              {
-                                STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                                {
-                                  createInfo->runningInfo.progress.total.count++;
-                                  createInfo->runningInfo.progress.total.size += deviceInfo.size;
-                                }
-                              }
-                              break;
-                          }
+                            break;
                         }
-                        break;
-                      default:
-                        #ifndef NDEBUG
-                          HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
-                        #endif /* NDEBUG */
-                        break; /* not reached */
-                    }
-                  }
-                  else
-                  {
-                    logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
+                      }
+                      else
+                      {
+                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                        {
+                          logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
 
-                    STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                    {
-                      createInfo->runningInfo.progress.skipped.count++;
-                      createInfo->runningInfo.progress.skipped.size += fileInfo.size;
+                          ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+                          updateRunningInfoNoWait(createInfo,NULL);
+                        }
+                      }
                     }
                   }
-                }
-              }
-              break;
-            case FILE_TYPE_HARDLINK:
-              if (isIncluded(includeEntryNode,name))
-              {
-                if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
-                {
+                  break;
+                case FILE_TYPE_DIRECTORY:
                   // add to known names history
                   Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
 
-                  if (!isInExcludedList(createInfo->excludePatternList,name))
+                  if (globalOptions.ignoreNoBackupFileFlag || !hasNoBackup(name))
                   {
-                    switch (includeEntryNode->storeType)
+                    if (isInIncludedList(createInfo->includeEntryList,name))
                     {
-                      case ENTRY_STORE_TYPE_FILE:
-                        if (   !createInfo->partialFlag
-                            || isFileChanged(&createInfo->namesDictionary,name,&fileInfo)
-                            )
+                      if (!isInExcludedList(createInfo->excludePatternList,name))
+                      {
+                        switch (collectorType)
                         {
-                          union { void *value; HardLinkInfo *hardLinkInfo; } data;
-                          if (Dictionary_find(&hardLinksDictionary,
-                                              &fileInfo.id,
-                                              sizeof(fileInfo.id),
-                                              &data.value,
-                                              NULL
-                                             )
-                              )
-                          {
-                            // append name to hard link name list
-                            StringList_append(&data.hardLinkInfo->nameList,name);
-
-                            if (StringList_count(&data.hardLinkInfo->nameList) >= data.hardLinkInfo->count)
+                          case COLLECTOR_TYPE_ENTRIES:
+                            // add to entry list
+                            if (isPrintInfo(2))
                             {
-                              // found last hardlink
-                              switch (collectorType)
-                              {
-                                case COLLECTOR_TYPE_ENTRIES:
-                                  // add to entry list
-                                  appendHardLinkToEntryList(createInfo,
-                                                            &data.hardLinkInfo->nameList,
-                                                            &data.hardLinkInfo->fileInfo,
-                                                            !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
-                                                           );
-                                  break;
-                                case COLLECTOR_TYPE_SUM:
-                                  // update status
-                                  STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                                  {
-                                    createInfo->runningInfo.progress.total.count++;
-                                    createInfo->runningInfo.progress.total.size += fileInfo.size;
-                                  }
-                                  break;
-                              }
-
-                              // clear entry
-                              Dictionary_remove(&hardLinksDictionary,
-                                                &fileInfo.id,
-                                                sizeof(fileInfo.id)
-                                               );
+                              printIncrementalInfo(createInfo,name,&fileInfo.cast);
                             }
-                          }
-                          else
-                          {
-                            // create hard link name list
-                            if (createInfo->partialFlag && isPrintInfo(2))
+                            appendDirectoryToEntryList(createInfo,
+                                                       name,
+                                                       &fileInfo
+                                                      );
+                            break;
+                          case COLLECTOR_TYPE_SUM:
+                            STATUS_INFO_UPDATE(createInfo,NULL,NULL)
                             {
-                              printIncrementalInfo(&createInfo->namesDictionary,
-                                                   name,
-                                                   &fileInfo.cast
-                                                  );
+                              createInfo->runningInfo.progress.total.count++;
                             }
+                            break;
+                        }
+                      }
+                      else
+                      {
+                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                        {
+                          logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
 
-                            HardLinkInfo hardLinkInfo;
-                            hardLinkInfo.count = fileInfo.linkCount;
-                            StringList_init(&hardLinkInfo.nameList);
-                            StringList_append(&hardLinkInfo.nameList,name);
-                            memCopyFast(&hardLinkInfo.fileInfo,sizeof(hardLinkInfo.fileInfo),&fileInfo,sizeof(fileInfo));
-
-                            if (!Dictionary_add(&hardLinksDictionary,
-                                                &fileInfo.id,
-                                                sizeof(fileInfo.id),
-                                                &hardLinkInfo,
-                                                sizeof(hardLinkInfo)
-                                               )
-                                )
-                            {
-                              HALT_INSUFFICIENT_MEMORY();
-                            }
-                          }
+                          ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+                          updateRunningInfoNoWait(createInfo,NULL);
                         }
-                        break;
-                      case ENTRY_STORE_TYPE_IMAGE:
-                        // nothing to do
-                        break;
-                      default:
-                        #ifndef NDEBUG
-                          HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
-                        #endif /* NDEBUG */
-                        break; /* not reached */
+                      }
                     }
                   }
-                  else
+                  break;
+                case FILE_TYPE_LINK:
+                  if (isInIncludedList(createInfo->includeEntryList,name))
                   {
-                    logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
-
-                    STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                    if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
                     {
-                      createInfo->runningInfo.progress.skipped.count++;
-                      createInfo->runningInfo.progress.skipped.size += fileInfo.size;
-                    }
-                  }
-                }
-              }
-              break;
-            case FILE_TYPE_SPECIAL:
-              if (isIncluded(includeEntryNode,name))
-              {
-                if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
-                {
-                  // add to known names history
-                  Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
+                      if (!isInExcludedList(createInfo->excludePatternList,name))
+                      {
+                        // add to known names history
+                        Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
 
-                  if (!isInExcludedList(createInfo->excludePatternList,name))
-                  {
-                    switch (includeEntryNode->storeType)
-                    {
-                      case ENTRY_STORE_TYPE_FILE:
-                        if (   !createInfo->partialFlag
-                            || isFileChanged(&createInfo->namesDictionary,name,&fileInfo)
-                           )
+                        switch (collectorType)
                         {
-                          switch (collectorType)
-                          {
-                            case COLLECTOR_TYPE_ENTRIES:
-                              // add to entry list
-                              if (createInfo->partialFlag && isPrintInfo(2))
-                              {
-                                printIncrementalInfo(&createInfo->namesDictionary,name,&fileInfo.cast);
-                              }
-                              appendSpecialToEntryList(createInfo,
-                                                       name,
-                                                       &fileInfo
-                                                      );
-                              break;
-                            case COLLECTOR_TYPE_SUM:
-                              STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                              {
-                                createInfo->runningInfo.progress.total.count++;
-                              }
-                              break;
-                          }
+                          case COLLECTOR_TYPE_ENTRIES:
+                            // add to entry list
+                            if (isPrintInfo(2))
+                            {
+                              printIncrementalInfo(createInfo,name,&fileInfo.cast);
+                            }
+                            appendLinkToEntryList(createInfo,
+                                                  name,
+                                                  &fileInfo
+                                                 );
+                            break;
+                          case COLLECTOR_TYPE_SUM:
+                            STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                            {
+                              createInfo->runningInfo.progress.total.count++;
+                            }
+                            break;
                         }
-                        break;
-                      case ENTRY_STORE_TYPE_IMAGE:
-                        if (fileInfo.specialType == FILE_SPECIAL_TYPE_BLOCK_DEVICE)
+                      }
+                      else
+                      {
+                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
                         {
-                          // get device info
-                          DeviceInfo deviceInfo;
-                          error = Device_getInfo(&deviceInfo,name,TRUE);
-                          if (error != ERROR_NONE)
+                          logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
+
+                          ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+                          updateRunningInfoNoWait(createInfo,NULL);
+                        }
+                      }
+                    }
+                  }
+                  break;
+                case FILE_TYPE_HARDLINK:
+                  if (   ((globalOptions.continuousMaxSize == 0LL) || fileInfo.size <= globalOptions.continuousMaxSize)
+                      && isInIncludedList(createInfo->includeEntryList,name)
+                     )
+                  {
+                    if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
+                    {
+                      // add to known names history
+                      Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
+
+                      if (!isInExcludedList(createInfo->excludePatternList,name))
+                      {
+                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                        {
+                          if ((globalOptions.continuousMaxSize == 0LL) || fileInfo.size <= globalOptions.continuousMaxSize)
                           {
-                            if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                            union { void *value; HardLinkInfo *hardLinkInfo; } data;
+                            HardLinkInfo                                       hardLinkInfo;
+                            if (Dictionary_find(&hardLinksDictionary,
+                                                &fileInfo.id,
+                                                sizeof(fileInfo.id),
+                                                &data.value,
+                                                NULL
+                                               )
+                                )
                             {
-                              if (createInfo->jobOptions->skipUnreadableFlag)
+                              // append name to hard link name list
+                              StringList_append(&data.hardLinkInfo->nameList,name);
+
+                              if (StringList_count(&data.hardLinkInfo->nameList) >= data.hardLinkInfo->count)
                               {
-                                printWarning(_("cannot get info for '%s' (error: %s) - skipped"),String_cString(name),Error_getText(error));
+                                // found last hardlink
+
+                                switch (collectorType)
+                                {
+                                  case COLLECTOR_TYPE_ENTRIES:
+                                    // add to entry list
+                                    appendHardLinkToEntryList(createInfo,
+                                                              &data.hardLinkInfo->nameList,
+                                                              &data.hardLinkInfo->fileInfo,
+                                                              !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
+                                                             );
+                                    break;
+                                  case COLLECTOR_TYPE_SUM:
+                                    // update status
+                                    STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                                    {
+                                      createInfo->runningInfo.progress.total.count++;
+                                      createInfo->runningInfo.progress.total.size += fileInfo.size;
+                                    }
+                                }
+
+                                // clear entry
+                                Dictionary_remove(&hardLinksDictionary,
+                                                  &fileInfo.id,
+                                                  sizeof(fileInfo.id)
+                                                 );
                               }
-                              else
+                            }
+                            else
+                            {
+                              // create hard link name list
+                              if (isPrintInfo(2))
                               {
-                                printError(_("cannot get info for '%s' (error: %s)"),
-                                           String_cString(name),
-                                           Error_getText(error)
-                                          );
+                                printIncrementalInfo(createInfo,
+                                                     name,
+                                                     &fileInfo.cast
+                                                    );
                               }
-                              logMessage(createInfo->logHandle,
-                                         LOG_TYPE_ENTRY_ACCESS_DENIED,
-                                         "Access denied '%s' (error: %s)",
-                                         String_cString(name),
-                                         Error_getText(error)
-                                        );
 
-                              STATUS_INFO_UPDATE(createInfo,name,NULL)
+                              hardLinkInfo.count = fileInfo.linkCount;
+                              StringList_init(&hardLinkInfo.nameList);
+                              StringList_append(&hardLinkInfo.nameList,name);
+                              memCopyFast(&hardLinkInfo.fileInfo,sizeof(hardLinkInfo.fileInfo),&fileInfo,sizeof(fileInfo));
+
+                              if (!Dictionary_add(&hardLinksDictionary,
+                                                  &fileInfo.id,
+                                                  sizeof(fileInfo.id),
+                                                  &hardLinkInfo,
+                                                  sizeof(hardLinkInfo)
+                                                 )
+                                  )
                               {
-                                createInfo->runningInfo.progress.error.count++;
+                                HALT_INSUFFICIENT_MEMORY();
                               }
                             }
-                            continue;
                           }
-
-                          switch (collectorType)
+                          else
                           {
-                            case COLLECTOR_TYPE_ENTRIES:
-                              // add to entry list
-                              appendImageToEntryList(createInfo,
-                                                     name,
-                                                     &deviceInfo,
-                                                     !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
-                                                    );
-                              break;
-                            case COLLECTOR_TYPE_SUM:
-                              STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-                              {
-                                createInfo->runningInfo.progress.total.count++;
-                                createInfo->runningInfo.progress.total.size += deviceInfo.size;
-                              }
-                              break;
+                            logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Size exceeded limit '%s'",String_cString(name));
+
+                            ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+                            updateRunningInfoNoWait(createInfo,NULL);
                           }
                         }
-                        break;
-                      default:
-                        #ifndef NDEBUG
-                          HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
-                        #endif /* NDEBUG */
-                        break; /* not reached */
+                      }
+                      else
+                      {
+                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                        {
+                          logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
+
+                          ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+                          updateRunningInfoNoWait(createInfo,NULL);
+                        }
+                      }
                     }
                   }
-                  else
+                  break;
+                case FILE_TYPE_SPECIAL:
+                  if (   isInIncludedList(createInfo->includeEntryList,name)
+                      && !isInExcludedList(createInfo->excludePatternList,name)
+                     )
                   {
-                    logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
+                    if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
+                    {
+                      // add to known names history
+                      Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
 
-                    STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                      switch (collectorType)
+                      {
+                        case COLLECTOR_TYPE_ENTRIES:
+                          // add to entry list
+                          if (isPrintInfo(2))
+                          {
+                            printIncrementalInfo(createInfo,name,&fileInfo.cast);
+                          }
+                          appendSpecialToEntryList(createInfo,
+                                                   name,
+                                                   &fileInfo
+                                                  );
+                          break;
+                        case COLLECTOR_TYPE_SUM:
+                          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                          {
+                            createInfo->runningInfo.progress.total.count++;
+                          }
+                          break;
+                      }
+                    }
+                    else
                     {
-                      createInfo->runningInfo.progress.skipped.count++;
-                      createInfo->runningInfo.progress.skipped.size += fileInfo.size;
+                      if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                      {
+                        logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
+
+                        ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+                        updateRunningInfoNoWait(createInfo,NULL);
+                      }
                     }
                   }
-                }
-              }
-              break;
-            default:
-              if (collectorType == COLLECTOR_TYPE_ENTRIES)
-              {
-                printInfo(2,"Unknown type of file '%s' - skipped\n",String_cString(name));
-                logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_TYPE_UNKNOWN,"Unknown type '%s'",String_cString(name));
+                  break;
+                default:
+                  if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                  {
+                    printInfo(2,"Unknown type of file '%s' - skipped\n",String_cString(name));
+                    logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_TYPE_UNKNOWN,"Unknown type '%s'",String_cString(name));
 
-                STATUS_INFO_UPDATE(createInfo,name,NULL)
-                {
-                  createInfo->runningInfo.progress.error.count++;
-                  createInfo->runningInfo.progress.error.size += fileInfo.size;
-                }
+                    ProgressCounters_addError(&createInfo->progressCounters,1,(uint64)fileInfo.size);
+                    updateRunningInfoNoWait(createInfo,name);
+                  }
+                  break;
               }
-              break;
-          }
-        }
-        else
-        {
-          if (collectorType == COLLECTOR_TYPE_ENTRIES)
-          {
-            logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s' (no dump attribute)",String_cString(name));
-
-            STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-            {
-              createInfo->runningInfo.progress.skipped.count++;
-              createInfo->runningInfo.progress.skipped.size += fileInfo.size;
             }
-          }
-        }
 
-        // free resources
-      }
-      String_delete(name);
-      if (collectorType == COLLECTOR_TYPE_ENTRIES)
-      {
-        if (n <= 0)
-        {
-          if (!createInfo->jobOptions->skipUnreadableFlag)
-          {
+            // mark as stored
             if (collectorType == COLLECTOR_TYPE_ENTRIES)
             {
-              printError(_("no matching entry found for '%s'!"),
-                         String_cString(includeEntryNode->string)
-                        );
-              logMessage(createInfo->logHandle,
-                         LOG_TYPE_ENTRY_MISSING,
-                         "No matching entry found for '%s'",
-                         String_cString(includeEntryNode->string)
-                        );
+              error = Continuous_markEntryStored(&continuousDatabaseHandle,databaseId);
+              if (error != ERROR_NONE)
+              {
+                printError(_("cannot mark continuous entry '%s' as stored (error: %s)"),
+                           String_cString(name),
+                           Error_getText(error)
+                          );
+                logMessage(createInfo->logHandle,
+                           LOG_TYPE_ENTRY_ACCESS_DENIED,
+                           "Cannot mark continuous entry '%s' as stored (error: %s)",
+                           String_cString(name),
+                           Error_getText(error)
+                          );
+
+                ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+                updateRunningInfoNoWait(createInfo,name);
+                continue;
+              }
             }
-            createInfo->failError = ERRORX_(FILE_NOT_FOUND_,0,"%s",String_cString(includeEntryNode->string));
-          }
 
-          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-          {
-            createInfo->runningInfo.progress.error.count++;
+            // free resources
           }
+          String_delete(name);
+
+          Continuous_doneList(&databaseStatementHandle);
         }
-      }
 
-      // next include entry
-      includeEntryNode = includeEntryNode->next;
+        // close continuous database
+        Continuous_close(&continuousDatabaseHandle);
+      }
+      else
+      {
+        if (collectorType == COLLECTOR_TYPE_ENTRIES)
+        {
+          printError(_("cannot initialize continuous database (error: %s)!"),
+                     Error_getText(error)
+                    );
+        }
+      }
     }
-
-    // free resoures
-    String_delete(fileName);
-    String_delete(path);
-    StringList_done(&nameList);
   }
-
-  if (collectorType == COLLECTOR_TYPE_ENTRIES)
+  else
   {
-    // add incomplete hard link entries (not all hard links found) to entry list
-    DictionaryIterator dictionaryIterator;
-    Dictionary_initIterator(&dictionaryIterator,&hardLinksDictionary);
-//???
-union { const void *value; const uint64 *id; } keyData;
-union { void *value; HardLinkInfo *hardLinkInfo; } data;
-    while (Dictionary_getNext(&dictionaryIterator,
-                              &keyData.value,
-                              NULL,
-                              &data.value,
-                              NULL
-                             )
+
+    // process include entries
+    StringList      nameList;
+    StringList_init(&nameList);
+    String path     = String_new();
+    String fileName = String_new();
+    EntryNode *includeEntryNode = LIST_HEAD(createInfo->includeEntryList);
+    while (   (createInfo->failError == ERROR_NONE)
+           && !isAborted(createInfo)
+           && (includeEntryNode != NULL)
           )
     {
-      appendHardLinkToEntryList(createInfo,
-                                &data.hardLinkInfo->nameList,
-                                &data.hardLinkInfo->fileInfo,
-                                !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
-                               );
-    }
-    Dictionary_doneIterator(&dictionaryIterator);
-  }
-
-  // free resoures
-  Dictionary_done(&hardLinksDictionary);
-  Dictionary_done(&duplicateNamesDictionary);
-}
-
-/***********************************************************************\
-* Name   : collectorSumThreadCode
-* Purpose: file collector sum thread: only collect files and update
-*          total files/bytes values
-* Input  : createInfo - create info block
-* Output : -
-* Return : -
-* Notes  : -
-\***********************************************************************/
-
-LOCAL void collectorSumThreadCode(CreateInfo *createInfo)
-{
-  collector(createInfo,COLLECTOR_TYPE_SUM);
-
-  // set collector done
-  STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-  {
-    createInfo->runningInfo.progress.collectTotalSumDone = TRUE;
-  }
-
-  createInfo->collectorTotalSumDone = TRUE;
-}
-
-/***********************************************************************\
-* Name   : collectorThreadCode
-* Purpose: file collector thread
-* Input  : createInfo - create info block
-* Output : -
-* Return : -
-* Notes  : -
-\***********************************************************************/
-
-LOCAL void collectorThreadCode(CreateInfo *createInfo)
-{
-  collector(createInfo,COLLECTOR_TYPE_ENTRIES);
-}
-
-/*---------------------------------------------------------------------*/
-
-/***********************************************************************\
-* Name   : storageInfoIncrement
-* Purpose: increment storage info
-* Input  : createInfo - create info
-*          size       - storage file size
-* Output : -
-* Return : -
-* Notes  : -
-\***********************************************************************/
-
-LOCAL void storageInfoIncrement(CreateInfo *createInfo, uint64 size)
-{
-  assert(createInfo != NULL);
-
-  SEMAPHORE_LOCKED_DO(&createInfo->storageInfoLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
-  {
-    createInfo->storage.count += 1;
-    createInfo->storage.bytes += size;
-  }
-}
-
-/***********************************************************************\
-* Name   : storageInfoDecrement
-* Purpose: decrement storage info
-* Input  : createInfo - create info
-*          size       - storage file size
-* Output : -
-* Return : -
-* Notes  : -
-\***********************************************************************/
-
-LOCAL void storageInfoDecrement(CreateInfo *createInfo, uint64 size)
-{
-  assert(createInfo != NULL);
+      Errors error;
 
-  SEMAPHORE_LOCKED_DO(&createInfo->storageInfoLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
-  {
-    assert(createInfo->storage.count > 0);
-    assert(createInfo->storage.bytes >= size);
+      // pause
+      pauseCreate(createInfo);
 
-    createInfo->storage.count -= 1;
-    createInfo->storage.bytes -= size;
-  }
-}
+      // find base path
+      getIncludeBasePath(path,includeEntryNode->string);
 
-/***********************************************************************\
-* Name   : waitForTemporaryFileSpace
-* Purpose: wait for temporary file space
-* Input  : createInfo - create info
-* Output : -
-* Return : -
-* Notes  : -
-\***********************************************************************/
+      // find files starting from base path
+      String name = String_new();
+      StringList_append(&nameList,path);
+      DirectoryScanner directoryScanner;
+      initDirectoryScanner(&directoryScanner,
+                           createInfo,
+                           includeEntryNode,
+                           path,
+                           // Note: directories are only read in parallel for the collector of entries, not for the sum collector
+                           (collectorType == COLLECTOR_TYPE_ENTRIES) ? globalOptions.collectorThreads : 0
+                          );
+      ulong n = 0;
+      while (   (createInfo->failError == ERROR_NONE)
+             && !isAborted(createInfo)
+             && !StringList_isEmpty(&nameList)
+            )
+      {
+        // pause
+        pauseCreate(createInfo);
 
-LOCAL void waitForTemporaryFileSpace(CreateInfo *createInfo)
-{
-  assert(createInfo != NULL);
+        // get next entry to process
+        StringList_removeLast(&nameList,name);
 
-  if (globalOptions.maxTmpSize > 0)
-  {
-    SEMAPHORE_LOCKED_DO(&createInfo->storageInfoLock,SEMAPHORE_LOCK_TYPE_READ,WAIT_FOREVER)
-    {
-      if (   (createInfo->storage.count > 2)                           // more than 2 archives are waiting
-          && (createInfo->storage.bytes > globalOptions.maxTmpSize)    // temporary space limit exceeded
-          && (createInfo->failError == ERROR_NONE)
-          && !isAborted(createInfo)
-         )
-      {
-        STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+        // read file info
+        FileInfo fileInfo;
+        if (!String_isEmpty(name))
         {
-          messageSet(&createInfo->runningInfo.message,MESSAGE_CODE_WAIT_FOR_TEMPORARY_SPACE,NULL);
-          String_clear(createInfo->runningInfo.message.text);
+          String_set(path,name);
         }
-
-        do
+        else
         {
-          Semaphore_waitModified(&createInfo->storageInfoLock,30*MS_PER_SECOND);
+          File_getCurrentDirectory(path);
         }
-        while (   (createInfo->storage.count > 2)
-               && (createInfo->storage.bytes > globalOptions.maxTmpSize)
-               && (createInfo->failError == ERROR_NONE)
-               && !isAborted(createInfo)
-              );
-
-        STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+        error = File_getInfo(&fileInfo,path);
+        if (error != ERROR_NONE)
         {
-          messageClear(&createInfo->runningInfo.message);
-          String_clear(createInfo->runningInfo.message.text);
-        }
-      }
-    }
-  }
-}
+          if (collectorType == COLLECTOR_TYPE_ENTRIES)
+          {
+            if (createInfo->jobOptions->skipUnreadableFlag)
+            {
+              printWarning(_("cannot get info for '%s' (error: %s) - skipped"),String_cString(path),Error_getText(error));
+            }
+            else
+            {
+              printError(_("cannot get info for '%s' (error: %s)"),
+                         String_cString(path),
+                         Error_getText(error)
+                        );
+            }
+            logMessage(createInfo->logHandle,
+                       LOG_TYPE_ENTRY_ACCESS_DENIED,
+                       "Access denied '%s' (error: %s)",
+                       String_cString(path),
+                       Error_getText(error)
+                      );
 
-/***********************************************************************\
-* Name   : archiveGetSize
-* Purpose: call back to get archive size
-* Input  : storageInfo - storage info
-*          storageId   - index storage id
-*          partNumber  - part number or ARCHIVE_PART_NUMBER_NONE for
-*                        single part
-*          userData    - user data
-* Output : -
-* Return : archive size [bytes] or 0
-* Notes  : -
-\***********************************************************************/
+            ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+            updateRunningInfoNoWait(createInfo,name);
+          }
+          continue;
+        }
 
-LOCAL uint64 archiveGetSize(StorageInfo *storageInfo,
-                            IndexId     storageId,
-                            int         partNumber,
-                            void        *userData
-                           )
-{
-  assert(storageInfo != NULL);
+        // increment number of possible found entries
+        n++;
 
-  UNUSED_VARIABLE(storageId);
+        if (createInfo->jobOptions->ignoreNoDumpAttributeFlag || !File_hasAttributeNoDump(&fileInfo))
+        {
+          switch (fileInfo.type)
+          {
+            case FILE_TYPE_FILE:
+              if (isIncluded(includeEntryNode,name))
+              {
+                if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
+                {
+                  // add to known names history
+                  Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
 
-  uint64 archiveSize = 0LL;
+                  if (!isInExcludedList(createInfo->excludePatternList,name))
+                  {
+                    switch (includeEntryNode->storeType)
+                    {
+                      case ENTRY_STORE_TYPE_FILE:
+                        if (   !createInfo->partialFlag
+                            || isFileChanged(createInfo,name,&fileInfo)
+                           )
+                        {
+                          switch (collectorType)
+                          {
+                            case COLLECTOR_TYPE_ENTRIES:
+                              // add to entry list
+                              if (createInfo->partialFlag && isPrintInfo(2))
+                              {
+                                printIncrementalInfo(createInfo,name,&fileInfo.cast);
+                              }
+                              appendFileToEntryList(createInfo,
+                                                    name,
+                                                    &fileInfo,
+                                                    !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
+                                                   );
+                              break;
+                            case COLLECTOR_TYPE_SUM:
+                              STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                              {
+                                createInfo->runningInfo.progress.total.count++;
+                                createInfo->runningInfo.progress.total.size += fileInfo.size;
+                              }
+                              break;
+                          }
+                        }
+                        break;
+                      case ENTRY_STORE_TYPE_IMAGE:
+                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                        {
+                          printWarning(_("'%s' is not a device"),String_cString(name));
+                        }
+                        break;
+                      default:
+                        #ifndef NDEBUG
+                          HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+                        #endif /* NDEBUG */
+                        break; /* not reached */
+                    }
+                  }
+                  else
+                  {
+                    logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
 
-  Errors error;
+                    ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+                    updateRunningInfoNoWait(createInfo,NULL);
+                  }
+                }
+              }
+              break;
+            case FILE_TYPE_DIRECTORY:
+              // add to known names history
+              Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
 
-  // get archive file name (expand macros)
-  String     archiveName = String_new();
-  CreateInfo *createInfo = (CreateInfo*)userData;
-  assert(createInfo != NULL);
-  error = Archive_formatName(archiveName,
-                             storageInfo->storageSpecifier.archiveName,
-                             EXPAND_MACRO_MODE_STRING,
-                             createInfo->archiveType,
-                             createInfo->scheduleTitle,
-                             createInfo->customText,
-                             createInfo->createdDateTime,
-                             partNumber
-                            );
-  if (error != ERROR_NONE)
-  {
-    String_delete(archiveName);
-    return 0LL;
-  }
+              if (globalOptions.ignoreNoBackupFileFlag || !hasNoBackup(name))
+              {
+                if (isIncluded(includeEntryNode,name))
+                {
+                  if (!isInExcludedList(createInfo->excludePatternList,name))
+                  {
+                    switch (includeEntryNode->storeType)
+                    {
+                      case ENTRY_STORE_TYPE_FILE:
+                        if (   !createInfo->partialFlag
+                            || isFileChanged(createInfo,name,&fileInfo)
+                           )
+                        {
+                          switch (collectorType)
+                          {
+                            case COLLECTOR_TYPE_ENTRIES:
+                              // add to entry list
+                              if (createInfo->partialFlag && isPrintInfo(2))
+                              {
+                                printIncrementalInfo(createInfo,name,&fileInfo.cast);
+                              }
+                              appendDirectoryToEntryList(createInfo,
+                                                         name,
+                                                         &fileInfo
+                                                        );
+                              break;
+                            case COLLECTOR_TYPE_SUM:
+                              STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                              {
+                                createInfo->runningInfo.progress.total.count++;
+                              }
+                              break;
+                          }
+                        }
+                        break;
+                      case ENTRY_STORE_TYPE_IMAGE:
+                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                        {
+                          printWarning(_("'%s' is not a device"),String_cString(name));
+                        }
+                        break;
+                      default:
+                        #ifndef NDEBUG
+                          HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+                        #endif /* NDEBUG */
+                        break; /* not reached */
+                    }
+                  }
+                  else
+                  {
+                    if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                    {
+                      logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
 
-  // get archive size
-  StorageHandle storageHandle;
-  error = Storage_open(&storageHandle,storageInfo,archiveName);
-  if (error != ERROR_NONE)
-  {
-    String_delete(archiveName);
-    return 0LL;
-  }
-  archiveSize = Storage_getSize(&storageHandle);
-  Storage_close(&storageHandle);
+                      ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+                      updateRunningInfoNoWait(createInfo,NULL);
+                    }
+                  }
+                }
 
-  // free resources
-  String_delete(archiveName);
+                // open directory contents
+                CollectorDirectoryListHandle directoryListHandle;
+                error = openCollectorDirectoryList(&directoryListHandle,&directoryScanner,name);
+                if (error == ERROR_NONE)
+                {
+                  // read directory content
+                  while (   (createInfo->failError == ERROR_NONE)
+                         && !isAborted(createInfo)
+                         && !endOfCollectorDirectoryList(&directoryListHandle)
+                        )
+                  {
+                    // pause
+                    pauseCreate(createInfo);
 
-  return archiveSize;
-}
+                    // read next directory entry
+                    FileInfo fileInfo;
+                    bool     includedFlag,excludedFlag;
+                    error = readCollectorDirectoryList(&directoryListHandle,fileName,&fileInfo,&includedFlag,&excludedFlag);
+                    if (error != ERROR_NONE)
+                    {
+                      if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                      {
+                        printError(_("cannot read directory '%s' (error: %s) - skipped"),String_cString(name),Error_getText(error));
+                        logMessage(createInfo->logHandle,
+                                   LOG_TYPE_ENTRY_ACCESS_DENIED,
+                                   "Access denied '%s' (error: %s)",
+                                   String_cString(name),
+                                   Error_getText(error)
+                                  );
 
-/***********************************************************************\
-* Name   : simpleTestArchive
-* Purpose: simple test archive
-* Input  : storageInfo - storage info
-*          archiveName - archive name
-* Output : -
-* Return : ERROR_NONE or error code
-* Notes  : -
-\***********************************************************************/
+                        ProgressCounters_addError(&createInfo->progressCounters,1,fileInfo.size);
+                        updateRunningInfoNoWait(createInfo,fileName);
+                      }
+                      continue;
+                    }
 
-LOCAL Errors simpleTestArchive(StorageInfo *storageInfo,
-                               ConstString  archiveName
-                              )
-{
-  Errors error;
+                    // add sub-directories to directory search list
+                    if (   (fileInfo.type == FILE_TYPE_DIRECTORY)
+                        && isTraverseDirectory(createInfo,fileName)
+                       )
+                    {
+                      StringList_append(&nameList,fileName);
+                    }
 
-  // open archive
-  ArchiveHandle archiveHandle;
-  error = Archive_open(&archiveHandle,
-                       storageInfo,
-                       archiveName,
-                       NULL,  // deltaSourceList,
-                       ARCHIVE_FLAG_NONE,
-                       CALLBACK_(NULL,NULL),  // getNamePasswordFunction
-                       NULL // logHandle
-                      );
-  if (error != ERROR_NONE)
-  {
-// TODO: race condition in scp/sftp without a short delay?
-Misc_udelay(1000*1000);
-    error = Archive_open(&archiveHandle,
-                         storageInfo,
-                         archiveName,
-                         NULL,  // deltaSourceList,
-                         ARCHIVE_FLAG_NONE,
-                         CALLBACK_(NULL,NULL),  // getNamePasswordFunction
-                         NULL // logHandle
-                        );
-    if (error != ERROR_NONE)
-    {
-      return error;
-    }
-  }
+                    if (includedFlag)
+                    {
+                      if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(fileName),String_length(fileName)))
+                      {
+                        // add to known names history
+                        Dictionary_add(&duplicateNamesDictionary,String_cString(fileName),String_length(fileName),NULL,0);
 
-  // simple test: read and skip content of archive entries
-  error = ERROR_NONE;
+                        if (!excludedFlag)
+                        {
+                          if (createInfo->jobOptions->ignoreNoDumpAttributeFlag || !File_hasAttributeNoDump(&fileInfo))
+                          {
+                            switch (fileInfo.type)
+                            {
+                              case FILE_TYPE_FILE:
+                                switch (includeEntryNode->storeType)
+                                {
+                                  case ENTRY_STORE_TYPE_FILE:
+                                    if (   !createInfo->partialFlag
+                                        || isFileChanged(createInfo,fileName,&fileInfo)
+                                       )
+                                    {
+                                      switch (collectorType)
+                                      {
+                                        case COLLECTOR_TYPE_ENTRIES:
+                                          // add to entry list
+                                          if (createInfo->partialFlag && isPrintInfo(2))
+                                          {
+                                            printIncrementalInfo(createInfo,fileName,&fileInfo.cast);
+                                          }
+                                          appendFileToEntryList(createInfo,
+                                                                fileName,
+                                                                &fileInfo,
+                                                                !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
+                                                               );
+                                          break;
+                                        case COLLECTOR_TYPE_SUM:
+                                          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                                          {
+                                            createInfo->runningInfo.progress.total.count++;
+                                            createInfo->runningInfo.progress.total.size += fileInfo.size;
+                                          }
+                                          break;
+                                      }
+                                    }
+                                    break;
+                                  case ENTRY_STORE_TYPE_IMAGE:
+                                    if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                                    {
+                                      printWarning(_("'%s' is not a device"),String_cString(fileName));
+                                    }
+                                    break;
+                                  default:
+                                    #ifndef NDEBUG
+                                      HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+                                    #endif /* NDEBUG */
+                                    break; /* not reached */
+                                }
+                                break;
+                              case FILE_TYPE_DIRECTORY:
+                                // nothing to do: directory is appended to include list
+                                break;
+                              case FILE_TYPE_LINK:
+                                switch (includeEntryNode->storeType)
+                                {
+                                  case ENTRY_STORE_TYPE_FILE:
+                                    if (   !createInfo->partialFlag
+                                        || isFileChanged(createInfo,fileName,&fileInfo)
+                                       )
+                                    {
+                                      switch (collectorType)
+                                      {
+                                        case COLLECTOR_TYPE_ENTRIES:
+                                          // add to entry list
+                                          if (createInfo->partialFlag && isPrintInfo(2))
+                                          {
+                                            printIncrementalInfo(createInfo,fileName,&fileInfo.cast);
+                                          }
+                                          appendLinkToEntryList(createInfo,
+                                                                fileName,
+                                                                &fileInfo
+                                                               );
+                                          break;
+                                        case COLLECTOR_TYPE_SUM:
+                                          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                                          {
+                                            createInfo->runningInfo.progress.total.count++;
+                                          }
+                                          break;
+                                      }
+                                    }
+                                    break;
+                                  case ENTRY_STORE_TYPE_IMAGE:
+                                    if (File_readLink(fileName,name,TRUE) == ERROR_NONE)
+                                    {
+                                      // get device info
+                                      DeviceInfo deviceInfo;
+                                      error = Device_getInfo(&deviceInfo,fileName,TRUE);
+                                      if (error != ERROR_NONE)
+                                      {
+                                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                                        {
+                                          if (createInfo->jobOptions->skipUnreadableFlag)
+                                          {
+                                            printWarning(_("cannot get info for '%s' (error: %s) - skipped"),String_cString(fileName),Error_getText(error));
+                                          }
+                                          else
+                                          {
+                                            printError(_("cannot get info for '%s' (error: %s)"),
+                                                       String_cString(fileName),
+                                                       Error_getText(error)
+                                                      );
+                                          }
+                                          logMessage(createInfo->logHandle,
+                                                     LOG_TYPE_ENTRY_ACCESS_DENIED,
+                                                     "Access denied '%s' (error: %s)",
+                                                     String_cString(fileName),
+                                                     Error_getText(error)
+                                                    );
+
+                                          ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+                                          updateRunningInfoNoWait(createInfo,name);
+                                        }
+                                        continue;
+                                      }
+
+                                      switch (collectorType)
+                                      {
+                                        case COLLECTOR_TYPE_ENTRIES:
+                                          // add to entry list
+                                          appendImageToEntryList(createInfo,
+                                                                 name,
+                                                                 &deviceInfo,
+                                                                 !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
+                                                                );
+                                          break;
+                                        case COLLECTOR_TYPE_SUM:
+                                          if (deviceInfo.type == DEVICE_TYPE_BLOCK)
+                                          {
+                                            STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                                            {
+                                              createInfo->runningInfo.progress.total.count++;
+                                              createInfo->runningInfo.progress.total.size += deviceInfo.size;
+                                            }
+                                          }
+                                          break;
+                                      }
+                                    }
+                                    break;
+                                  default:
+                                    #ifndef NDEBUG
+                                      HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+                                    #endif /* NDEBUG */
+                                    break; /* not reached */
+                                }
+                                break;
+                              case FILE_TYPE_HARDLINK:
+                                switch (includeEntryNode->storeType)
+                                {
+                                  case ENTRY_STORE_TYPE_FILE:
+                                    {
+                                      if (   !createInfo->partialFlag
+                                          || isFileChanged(createInfo,fileName,&fileInfo)
+                                          )
+                                      {
+                                        union { void *value; HardLinkInfo *hardLinkInfo; } data;
+                                        HardLinkInfo                                       hardLinkInfo;
+                                        if (Dictionary_find(&hardLinksDictionary,
+                                                            &fileInfo.id,
+                                                            sizeof(fileInfo.id),
+                                                            &data.value,
+                                                            NULL
+                                                           )
+                                            )
+                                        {
+                                          // append name to hard link name list
+                                          StringList_append(&data.hardLinkInfo->nameList,fileName);
+
+                                          if (StringList_count(&data.hardLinkInfo->nameList) >= data.hardLinkInfo->count)
+                                          {
+                                            // found last hardlink
+
+                                            switch (collectorType)
+                                            {
+                                              case COLLECTOR_TYPE_ENTRIES:
+                                                // add to entry list
+                                                appendHardLinkToEntryList(createInfo,
+                                                                          &data.hardLinkInfo->nameList,
+                                                                          &data.hardLinkInfo->fileInfo,
+                                                                          !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
+                                                                         );
+                                                break;
+                                              case COLLECTOR_TYPE_SUM:
+                                                // update status
+                                                STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                                                {
+                                                  createInfo->runningInfo.progress.total.count++;
+                                                  createInfo->runningInfo.progress.total.size += fileInfo.size;
+                                                }
+                                                break;
+                                            }
+
+                                            // clear entry
+                                            Dictionary_remove(&hardLinksDictionary,
+                                                              &fileInfo.id,
+                                                              sizeof(fileInfo.id)
+                                                             );
+                                          }
+                                        }
+                                        else
+                                        {
+                                          // create hard link name list
+                                          if (createInfo->partialFlag && isPrintInfo(2))
+                                          {
+                                            printIncrementalInfo(createInfo,
+                                                                 fileName,
+                                                                 &fileInfo.cast
+                                                                );
+                                          }
+
+                                          hardLinkInfo.count = fileInfo.linkCount;
+                                          StringList_init(&hardLinkInfo.nameList);
+                                          StringList_append(&hardLinkInfo.nameList,fileName);
+                                          memCopyFast(&hardLinkInfo.fileInfo,sizeof(hardLinkInfo.fileInfo),&fileInfo,sizeof(fileInfo));
+
+                                          if (!Dictionary_add(&hardLinksDictionary,
+                                                              &fileInfo.id,
+                                                              sizeof(fileInfo.id),
+                                                              &hardLinkInfo,
+                                                              sizeof(hardLinkInfo)
+                                                             )
+                                              )
+                                          {
+                                            HALT_INSUFFICIENT_MEMORY();
+                                          }
+                                        }
+                                      }
+                                    }
+                                    break;
+                                  case ENTRY_STORE_TYPE_IMAGE:
+                                    // nothing to do
+                                    break;
+                                  default:
+                                    #ifndef NDEBUG
+                                      HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+                                    #endif /* NDEBUG */
+                                    break; /* not reached */
+                                }
+                                break;
+                              case FILE_TYPE_SPECIAL:
+                                switch (includeEntryNode->storeType)
+                                {
+                                  case ENTRY_STORE_TYPE_FILE:
+                                    if (   !createInfo->partialFlag
+                                        || isFileChanged(createInfo,fileName,&fileInfo)
+                                       )
+                                    {
+                                      switch (collectorType)
+                                      {
+                                        case COLLECTOR_TYPE_ENTRIES:
+                                          // add to entry list
+                                          if (createInfo->partialFlag && isPrintInfo(2))
+                                          {
+                                            printIncrementalInfo(createInfo,fileName,&fileInfo.cast);
+                                          }
+                                          appendSpecialToEntryList(createInfo,
+                                                                   fileName,
+                                                                   &fileInfo
+                                                                  );
+                                          break;
+                                        case COLLECTOR_TYPE_SUM:
+                                          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                                          {
+                                            createInfo->runningInfo.progress.total.count++;
+                                            if (   (includeEntryNode->storeType == ENTRY_STORE_TYPE_IMAGE)
+                                                && (fileInfo.specialType == FILE_SPECIAL_TYPE_BLOCK_DEVICE)
+                                               )
+                                            {
+                                              createInfo->runningInfo.progress.total.size += fileInfo.size;
+                                            }
+                                          }
+                                          break;
+                                      }
+                                    }
+                                    break;
+                                  case ENTRY_STORE_TYPE_IMAGE:
+                                    if (fileInfo.specialType == FILE_SPECIAL_TYPE_BLOCK_DEVICE)
+                                    {
+                                      // get device info
+                                      DeviceInfo deviceInfo;
+                                      error = Device_getInfo(&deviceInfo,fileName,TRUE);
+                                      if (error != ERROR_NONE)
+                                      {
+                                        if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                                        {
+                                          printError(_("cannot access '%s' (error: %s) - skipped"),String_cString(name),Error_getText(error));
+                                          logMessage(createInfo->logHandle,
+                                                     LOG_TYPE_ENTRY_ACCESS_DENIED,
+                                                     "Access denied '%s' (error: %s)",
+                                                     String_cString(name),
+                                                     Error_getText(error)
+                                                    );
+
+                                          ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+                                          updateRunningInfoNoWait(createInfo,name);
+                                        }
+                                        continue;
+                                      }
+
+                                      switch (collectorType)
+                                      {
+                                        case COLLECTOR_TYPE_ENTRIES:
+                                          // add to entry list
+                                          appendImageToEntryList(createInfo,
+                                                                 fileName,
+                                                                 &deviceInfo,
+                                                                 !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
+                                                                );
+                                          break;
+                                        case COLLECTOR_TYPE_SUM:
+                                          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                                          {
+                                            createInfo->runningInfo.progress.total.count++;
+                                            createInfo->runningInfo.progress.total.size += fileInfo.size;
+                                          }
+                                          break;
+                                      }
+                                    }
+                                    break;
+                                  default:
+                                    #ifndef NDEBUG
+                                      HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+                                    #endif /* NDEBUG */
+                                    break; /* not reached */
+                                }
+                                break;
+                              default:
+                                if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                                {
+                                  printInfo(2,"Unknown type of file '%s' - skipped\n",String_cString(fileName));
+                                  logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_TYPE_UNKNOWN,"Unknown type '%s'",String_cString(fileName));
+
+                                  ProgressCounters_addError(&createInfo->progressCounters,1,fileInfo.size);
+                                  updateRunningInfoNoWait(createInfo,fileName);
+                                }
+                                break;
+                            }
+                          }
+                          else
+                          {
+                            if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                            {
+                              logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s' (no dump attribute)",String_cString(fileName));
+
+                              ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+                              updateRunningInfoNoWait(createInfo,NULL);
+                            }
+                          }
+                        }
+                        else
+                        {
+                          if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                          {
+                            logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(fileName));
+
+                            ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+                            updateRunningInfoNoWait(createInfo,NULL);
+                          }
+                        }
+                      }
+                    }
+                  }
+
+                  // close directory
+                  closeCollectorDirectoryList(&directoryListHandle);
+                }
+                else
+                {
+                  if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                  {
+                    printInfo(2,"Cannot open directory '%s' (error: %s) - skipped\n",String_cString(name),Error_getText(error));
+                    logMessage(createInfo->logHandle,
+                               LOG_TYPE_ENTRY_ACCESS_DENIED,
+                               "Access denied '%s' (error: %s)",
+                               String_cString(name),
+                               Error_getText(error)
+                              );
+
+                    ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+                    updateRunningInfoNoWait(createInfo,name);
+                  }
+                }
+              }
+              else
+              {
+                if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                {
+                  logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s' (.nobackup file)",String_cString(name));
+                }
+              }
+              break;
+            case FILE_TYPE_LINK:
+              if (isIncluded(includeEntryNode,name))
+              {
+                if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
+                {
+                  // add to known names history
+                  Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
+
+                  if (!isInExcludedList(createInfo->excludePatternList,name))
+                  {
+                    switch (includeEntryNode->storeType)
+                    {
+                      case ENTRY_STORE_TYPE_FILE:
+                        if (  !createInfo->partialFlag
+                            || isFileChanged(createInfo,name,&fileInfo)
+                           )
+                        {
+                          switch (collectorType)
+                          {
+                            case COLLECTOR_TYPE_ENTRIES:
+                              // add to entry list
+                              if (createInfo->partialFlag && isPrintInfo(2))
+                              {
+                                printIncrementalInfo(createInfo,name,&fileInfo.cast);
+                              }
+                              appendLinkToEntryList(createInfo,
+                                                    name,
+                                                    &fileInfo
+                                                   );
+                              break;
+                            case COLLECTOR_TYPE_SUM:
+                              STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                              {
+                                createInfo->runningInfo.progress.total.count++;
+                              }
+                              break;
+                          }
+                        }
+                        break;
+                      case ENTRY_STORE_TYPE_IMAGE:
+                        {
+                          error = File_readLink(fileName,name,TRUE);
+                          if (error != ERROR_NONE)
+                          {
+                            if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                            {
+                              if (createInfo->jobOptions->skipUnreadableFlag)
+                              {
+                                printWarning(_("cannot get info for '%s' (error: %s) - skipped"),String_cString(path),Error_getText(error));
+                              }
+                              else
+                              {
+                                printError(_("cannot get info for '%s' (error: %s)"),
+                                           String_cString(path),
+                                           Error_getText(error)
+                                          );
+                              }
+                              logMessage(createInfo->logHandle,
+                                         LOG_TYPE_ENTRY_ACCESS_DENIED,
+                                         "Access denied '%s' (error: %s)",
+                                         String_cString(path),
+                                         Error_getText(error)
+                                        );
+
+                              ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+                              updateRunningInfoNoWait(createInfo,name);
+                            }
+                            continue;
+                          }
+
+                          // get device info
+                          DeviceInfo deviceInfo;
+                          error = Device_getInfo(&deviceInfo,fileName,TRUE);
+                          if (error != ERROR_NONE)
+                          {
+                            if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                            {
+                              printInfo(2,"Cannot access '%s' (error: %s) - skipped\n",String_cString(name),Error_getText(error));
+                              logMessage(createInfo->logHandle,
+                                         LOG_TYPE_ENTRY_ACCESS_DENIED,
+                                         "Access denied '%s' (error: %s)",
+                                         String_cString(name),
+                                         Error_getText(error)
+                                        );
+                            }
+
+                            ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+                            updateRunningInfoNoWait(createInfo,name);
+                            continue;
+                          }
+
+                          switch (collectorType)
+                          {
+                            case COLLECTOR_TYPE_ENTRIES:
+                              // add to entry list
+                              appendImageToEntryList(createInfo,
+                                                     name,
+                                                     &deviceInfo,
+                                                     !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
+                                                    );
+                              break;
+                            case COLLECTOR_TYPE_SUM:
+                              if (deviceInfo.type == DEVICE_TYPE_BLOCK)
+                              {
+                                STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                                {
+                                  createInfo->runningInfo.progress.total.count++;
+                                  createInfo->runningInfo.progress.total.size += deviceInfo.size;
+                                }
+                              }
+                              break;
+                          }
+                        }
+                        break;
+                      default:
+                        #ifndef NDEBUG
+                          HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+                        #endif /* NDEBUG */
+                        break; /* not reached */
+                    }
+                  }
+                  else
+                  {
+                    logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
+
+                    ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+                    updateRunningInfoNoWait(createInfo,NULL);
+                  }
+                }
+              }
+              break;
+            case FILE_TYPE_HARDLINK:
+              if (isIncluded(includeEntryNode,name))
+              {
+                if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
+                {
+                  // add to known names history
+                  Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
+
+                  if (!isInExcludedList(createInfo->excludePatternList,name))
+                  {
+                    switch (includeEntryNode->storeType)
+                    {
+                      case ENTRY_STORE_TYPE_FILE:
+                        if (   !createInfo->partialFlag
+                            || isFileChanged(createInfo,name,&fileInfo)
+                            )
+                        {
+                          union { void *value; HardLinkInfo *hardLinkInfo; } data;
+                          if (Dictionary_find(&hardLinksDictionary,
+                                              &fileInfo.id,
+                                              sizeof(fileInfo.id),
+                                              &data.value,
+                                              NULL
+                                             )
+                              )
+                          {
+                            // append name to hard link name list
+                            StringList_append(&data.hardLinkInfo->nameList,name);
+
+                            if (StringList_count(&data.hardLinkInfo->nameList) >= data.hardLinkInfo->count)
+                            {
+                              // found last hardlink
+                              switch (collectorType)
+                              {
+                                case COLLECTOR_TYPE_ENTRIES:
+                                  // add to entry list
+                                  appendHardLinkToEntryList(createInfo,
+                                                            &data.hardLinkInfo->nameList,
+                                                            &data.hardLinkInfo->fileInfo,
+                                                            !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
+                                                           );
+                                  break;
+                                case COLLECTOR_TYPE_SUM:
+                                  // update status
+                                  STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                                  {
+                                    createInfo->runningInfo.progress.total.count++;
+                                    createInfo->runningInfo.progress.total.size += fileInfo.size;
+                                  }
+                                  break;
+                              }
+
+                              // clear entry
+                              Dictionary_remove(&hardLinksDictionary,
+                                                &fileInfo.id,
+                                                sizeof(fileInfo.id)
+                                               );
+                            }
+                          }
+                          else
+                          {
+                            // create hard link name list
+                            if (createInfo->partialFlag && isPrintInfo(2))
+                            {
+                              printIncrementalInfo(createInfo,
+                                                   name,
+                                                   &fileInfo.cast
+                                                  );
+                            }
+
+                            HardLinkInfo hardLinkInfo;
+                            hardLinkInfo.count = fileInfo.linkCount;
+                            StringList_init(&hardLinkInfo.nameList);
+                            StringList_append(&hardLinkInfo.nameList,name);
+                            memCopyFast(&hardLinkInfo.fileInfo,sizeof(hardLinkInfo.fileInfo),&fileInfo,sizeof(fileInfo));
+
+                            if (!Dictionary_add(&hardLinksDictionary,
+                                                &fileInfo.id,
+                                                sizeof(fileInfo.id),
+                                                &hardLinkInfo,
+                                                sizeof(hardLinkInfo)
+                                               )
+                                )
+                            {
+                              HALT_INSUFFICIENT_MEMORY();
+                            }
+                          }
+                        }
+                        break;
+                      case ENTRY_STORE_TYPE_IMAGE:
+                        // nothing to do
+                        break;
+                      default:
+                        #ifndef NDEBUG
+                          HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+                        #endif /* NDEBUG */
+                        break; /* not reached */
+                    }
+                  }
+                  else
+                  {
+                    logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
+
+                    ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+                    updateRunningInfoNoWait(createInfo,NULL);
+                  }
+                }
+              }
+              break;
+            case FILE_TYPE_SPECIAL:
+              if (isIncluded(includeEntryNode,name))
+              {
+                if (!Dictionary_contains(&duplicateNamesDictionary,String_cString(name),String_length(name)))
+                {
+                  // add to known names history
+                  Dictionary_add(&duplicateNamesDictionary,String_cString(name),String_length(name),NULL,0);
+
+                  if (!isInExcludedList(createInfo->excludePatternList,name))
+                  {
+                    switch (includeEntryNode->storeType)
+                    {
+                      case ENTRY_STORE_TYPE_FILE:
+                        if (   !createInfo->partialFlag
+                            || isFileChanged(createInfo,name,&fileInfo)
+                           )
+                        {
+                          switch (collectorType)
+                          {
+                            case COLLECTOR_TYPE_ENTRIES:
+                              // add to entry list
+                              if (createInfo->partialFlag && isPrintInfo(2))
+                              {
+                                printIncrementalInfo(createInfo,name,&fileInfo.cast);
+                              }
+                              appendSpecialToEntryList(createInfo,
+                                                       name,
+                                                       &fileInfo
+                                                      );
+                              break;
+                            case COLLECTOR_TYPE_SUM:
+                              STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                              {
+                                createInfo->runningInfo.progress.total.count++;
+                              }
+                              break;
+                          }
+                        }
+                        break;
+                      case ENTRY_STORE_TYPE_IMAGE:
+                        if (fileInfo.specialType == FILE_SPECIAL_TYPE_BLOCK_DEVICE)
+                        {
+                          // get device info
+                          DeviceInfo deviceInfo;
+                          error = Device_getInfo(&deviceInfo,name,TRUE);
+                          if (error != ERROR_NONE)
+                          {
+                            if (collectorType == COLLECTOR_TYPE_ENTRIES)
+                            {
+                              if (createInfo->jobOptions->skipUnreadableFlag)
+                              {
+                                printWarning(_("cannot get info for '%s' (error: %s) - skipped"),String_cString(name),Error_getText(error));
+                              }
+                              else
+                              {
+                                printError(_("cannot get info for '%s' (error: %s)"),
+                                           String_cString(name),
+                                           Error_getText(error)
+                                          );
+                              }
+                              logMessage(createInfo->logHandle,
+                                         LOG_TYPE_ENTRY_ACCESS_DENIED,
+                                         "Access denied '%s' (error: %s)",
+                                         String_cString(name),
+                                         Error_getText(error)
+                                        );
+
+                              ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+                              updateRunningInfoNoWait(createInfo,name);
+                            }
+                            continue;
+                          }
+
+                          switch (collectorType)
+                          {
+                            case COLLECTOR_TYPE_ENTRIES:
+                              // add to entry list
+                              appendImageToEntryList(createInfo,
+                                                     name,
+                                                     &deviceInfo,
+                                                     !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
+                                                    );
+                              break;
+                            case COLLECTOR_TYPE_SUM:
+                              STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+                              {
+                                createInfo->runningInfo.progress.total.count++;
+                                createInfo->runningInfo.progress.total.size += deviceInfo.size;
+                              }
+                              break;
+                          }
+                        }
+                        break;
+                      default:
+                        #ifndef NDEBUG
+                          HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+                        #endif /* NDEBUG */
+                        break; /* not reached */
+                    }
+                  }
+                  else
+                  {
+                    logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s'",String_cString(name));
+
+                    ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+                    updateRunningInfoNoWait(createInfo,NULL);
+                  }
+                }
+              }
+              break;
+            default:
+              if (collectorType == COLLECTOR_TYPE_ENTRIES)
+              {
+                printInfo(2,"Unknown type of file '%s' - skipped\n",String_cString(name));
+                logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_TYPE_UNKNOWN,"Unknown type '%s'",String_cString(name));
+
+                ProgressCounters_addError(&createInfo->progressCounters,1,fileInfo.size);
+                updateRunningInfoNoWait(createInfo,name);
+              }
+              break;
+          }
+        }
+        else
+        {
+          if (collectorType == COLLECTOR_TYPE_ENTRIES)
+          {
+            logMessage(createInfo->logHandle,LOG_TYPE_ENTRY_EXCLUDED,"Excluded '%s' (no dump attribute)",String_cString(name));
+
+            ProgressCounters_addSkipped(&createInfo->progressCounters,1,fileInfo.size);
+            updateRunningInfoNoWait(createInfo,NULL);
+          }
+        }
+
+        // free resources
+      }
+      doneDirectoryScanner(&directoryScanner);
+      String_delete(name);
+      if (collectorType == COLLECTOR_TYPE_ENTRIES)
+      {
+        if (n <= 0)
+        {
+          if (!createInfo->jobOptions->skipUnreadableFlag)
+          {
+            if (collectorType == COLLECTOR_TYPE_ENTRIES)
+            {
+              printError(_("no matching entry found for '%s'!"),
+                         String_cString(includeEntryNode->string)
+                        );
+              logMessage(createInfo->logHandle,
+                         LOG_TYPE_ENTRY_MISSING,
+                         "No matching entry found for '%s'",
+                         String_cString(includeEntryNode->string)
+                        );
+            }
+            createInfo->failError = ERRORX_(FILE_NOT_FOUND_,0,"%s",String_cString(includeEntryNode->string));
+          }
+
+          ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+          updateRunningInfoNoWait(createInfo,NULL);
+        }
+      }
+
+      // next include entry
+      includeEntryNode = includeEntryNode->next;
+    }
+
+    // free resoures
+    String_delete(fileName);
+    String_delete(path);
+    StringList_done(&nameList);
+  }
+
+  if (collectorType == COLLECTOR_TYPE_ENTRIES)
+  {
+    // add incomplete hard link entries (not all hard links found) to entry list
+    DictionaryIterator dictionaryIterator;
+    Dictionary_initIterator(&dictionaryIterator,&hardLinksDictionary);
+//???
+union { const void *value; const uint64 *id; } keyData;
+union { void *value; HardLinkInfo *hardLinkInfo; } data;
+    while (Dictionary_getNext(&dictionaryIterator,
+                              &keyData.value,
+                              NULL,
+                              &data.value,
+                              NULL
+                             )
+          )
+    {
+      appendHardLinkToEntryList(createInfo,
+                                &data.hardLinkInfo->nameList,
+                                &data.hardLinkInfo->fileInfo,
+                                !createInfo->jobOptions->noStorage ? globalOptions.fragmentSize : 0LL
+                               );
+    }
+    Dictionary_doneIterator(&dictionaryIterator);
+  }
+
+  // free resoures
+  Dictionary_done(&hardLinksDictionary);
+  Dictionary_done(&duplicateNamesDictionary);
+}
+
+/***********************************************************************\
+* Name   : collectorSumThreadCode
+* Purpose: file collector sum thread: only collect files and update
+*          total files/bytes values
+* Input  : createInfo - create info block
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void collectorSumThreadCode(CreateInfo *createInfo)
+{
+  collector(createInfo,COLLECTOR_TYPE_SUM);
+
+  // set collector done
+  STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+  {
+    createInfo->runningInfo.progress.collectTotalSumDone = TRUE;
+  }
+
+  createInfo->collectorTotalSumDone = TRUE;
+}
+
+/***********************************************************************\
+* Name   : collectorThreadCode
+* Purpose: file collector thread
+* Input  : createInfo - create info block
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void collectorThreadCode(CreateInfo *createInfo)
+{
+  collector(createInfo,COLLECTOR_TYPE_ENTRIES);
+
+  if (globalOptions.singlePassCollectorFlag)
+  {
+    // set collector done: total sum is updated while collecting entries
+    STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+    {
+      createInfo->runningInfo.progress.collectTotalSumDone = TRUE;
+    }
+
+    createInfo->collectorTotalSumDone = TRUE;
+  }
+}
+
+/*---------------------------------------------------------------------*/
+
+/***********************************************************************\
+* Name   : storageInfoIncrement
+* Purpose: increment storage info
+* Input  : createInfo - create info
+*          size       - storage file size
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void storageInfoIncrement(CreateInfo *createInfo, uint64 size)
+{
+  assert(createInfo != NULL);
+
+  SEMAPHORE_LOCKED_DO(&createInfo->storageInfoLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  {
+    createInfo->storage.count += 1;
+    createInfo->storage.bytes += size;
+  }
+}
+
+/***********************************************************************\
+* Name   : storageInfoDecrement
+* Purpose: decrement storage info
+* Input  : createInfo - create info
+*          size       - storage file size
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void storageInfoDecrement(CreateInfo *createInfo, uint64 size)
+{
+  assert(createInfo != NULL);
+
+  SEMAPHORE_LOCKED_DO(&createInfo->storageInfoLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  {
+    assert(createInfo->storage.count > 0);
+    assert(createInfo->storage.bytes >= size);
+
+    createInfo->storage.count -= 1;
+    createInfo->storage.bytes -= size;
+  }
+}
+
+/***********************************************************************\
+* Name   : waitForTemporaryFileSpace
+* Purpose: wait for temporary file space
+* Input  : createInfo - create info
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void waitForTemporaryFileSpace(CreateInfo *createInfo)
+{
+  assert(createInfo != NULL);
+
+  if (globalOptions.maxTmpSize > 0)
+  {
+    SEMAPHORE_LOCKED_DO(&createInfo->storageInfoLock,SEMAPHORE_LOCK_TYPE_READ,WAIT_FOREVER)
+    {
+      if (   (createInfo->storage.count > 2)                           // more than 2 archives are waiting
+          && (createInfo->storage.bytes > globalOptions.maxTmpSize)    // temporary space limit exceeded
+          && (createInfo->failError == ERROR_NONE)
+          && !isAborted(createInfo)
+         )
+      {
+        STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+        {
+          messageSet(&createInfo->runningInfo.message,MESSAGE_CODE_WAIT_FOR_TEMPORARY_SPACE,NULL);
+          String_clear(createInfo->runningInfo.message.text);
+          updateRunningInfo(createInfo,TRUE);
+        }
+
+        do
+        {
+          Semaphore_waitModified(&createInfo->storageInfoLock,30*MS_PER_SECOND);
+        }
+        while (   (createInfo->storage.count > 2)
+               && (createInfo->storage.bytes > globalOptions.maxTmpSize)
+               && (createInfo->failError == ERROR_NONE)
+               && !isAborted(createInfo)
+              );
+
+        STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+        {
+          messageClear(&createInfo->runningInfo.message);
+          String_clear(createInfo->runningInfo.message.text);
+          updateRunningInfo(createInfo,TRUE);
+        }
+      }
+    }
+  }
+}
+
+/***********************************************************************\
+* Name   : archiveGetSize
+* Purpose: call back to get archive size
+* Input  : storageInfo - storage info
+*          storageId   - index storage id
+*          partNumber  - part number or ARCHIVE_PART_NUMBER_NONE for
+*                        single part
+*          userData    - user data
+* Output : -
+* Return : archive size [bytes] or 0
+* Notes  : -
+\***********************************************************************/
+
+LOCAL uint64 archiveGetSize(StorageInfo *storageInfo,
+                            IndexId     storageId,
+                            int         partNumber,
+                            void        *userData
+                           )
+{
+  assert(storageInfo != NULL);
+
+  UNUSED_VARIABLE(storageId);
+
+  uint64 archiveSize = 0LL;
+
+  Errors error;
+
+  // get archive file name (expand macros)
+  String     archiveName = String_new();
+  CreateInfo *createInfo = (CreateInfo*)userData;
+  assert(createInfo != NULL);
+  error = Archive_formatName(archiveName,
+                             storageInfo->storageSpecifier.archiveName,
+                             EXPAND_MACRO_MODE_STRING,
+                             createInfo->archiveType,
+                             createInfo->scheduleTitle,
+                             createInfo->customText,
+                             createInfo->createdDateTime,
+                             partNumber
+                            );
+  if (error != ERROR_NONE)
+  {
+    String_delete(archiveName);
+    return 0LL;
+  }
+
+  // get archive size
+  StorageHandle storageHandle;
+  error = Storage_open(&storageHandle,storageInfo,archiveName);
+  if (error != ERROR_NONE)
+  {
+    String_delete(archiveName);
+    return 0LL;
+  }
+  archiveSize = Storage_getSize(&storageHandle);
+  Storage_close(&storageHandle);
+
+  // free resources
+  String_delete(archiveName);
+
+  return archiveSize;
+}
+
+/***********************************************************************\
+* Name   : archiveStream
+* Purpose: call back to get storage name for streaming archive file
+* Input  : storageInfo - storage info
+*          partNumber  - part number or ARCHIVE_PART_NUMBER_NONE for
+*                        single part
+*          archiveName - archive name variable
+*          userData    - user data
+* Output : archiveName - archive name
+* Return : ERROR_NONE or error code
+* Notes  : storage pre-process is done before the archive file is
+*          streamed into the storage
+\***********************************************************************/
+
+LOCAL Errors archiveStream(StorageInfo *storageInfo,
+                           int         partNumber,
+                           String      archiveName,
+                           void        *userData
+                          )
+{
+  Errors error;
+
+  assert(storageInfo != NULL);
+  assert(archiveName != NULL);
+
+  // get archive file name (expand macros)
+  CreateInfo *createInfo = (CreateInfo*)userData;
+  assert(createInfo != NULL);
+  error = Archive_formatName(archiveName,
+                             storageInfo->storageSpecifier.archiveName,
+                             EXPAND_MACRO_MODE_STRING,
+                             createInfo->archiveType,
+                             createInfo->scheduleTitle,
+                             createInfo->customText,
+                             createInfo->createdDateTime,
+                             partNumber
+                            );
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  // pre-process
+  error = Storage_preProcess(storageInfo,
+                             archiveName,
+                             createInfo->createdDateTime,
+                             FALSE  // initialFlag
+                            );
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : simpleTestArchive
+* Purpose: simple test archive
+* Input  : storageInfo - storage info
+*          archiveName - archive name
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors simpleTestArchive(StorageInfo *storageInfo,
+                               ConstString  archiveName
+                              )
+{
+  Errors error;
+
+  // open archive
+  ArchiveHandle archiveHandle;
+  error = Archive_open(&archiveHandle,
+                       storageInfo,
+                       archiveName,
+                       NULL,  // deltaSourceList,
+                       ARCHIVE_FLAG_NONE,
+                       CALLBACK_(NULL,NULL),  // getNamePasswordFunction
+                       NULL // logHandle
+                      );
+  if (error != ERROR_NONE)
+  {
+// TODO: race condition in scp/sftp without a short delay?
+Misc_udelay(1000*1000);
+    error = Archive_open(&archiveHandle,
+                         storageInfo,
+                         archiveName,
+                         NULL,  // deltaSourceList,
+                         ARCHIVE_FLAG_NONE,
+                         CALLBACK_(NULL,NULL),  // getNamePasswordFunction
+                         NULL // logHandle
+                        );
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+  }
+
+  // simple test: read and skip content of archive entries
+  error = ERROR_NONE;
   while (   (error == ERROR_NONE)
          && !Archive_eof(&archiveHandle)
         )
@@ -3448,6 +5060,8 @@ Misc_udelay(1000*1000);
                                           NULL,  // fileName,
                                           NULL,  // fileInfo,
                                           NULL,  // fileExtendedAttributeList
+                                          NULL,  // fileHoleList
+                                          NULL,  // referenceName
                                           NULL,  // deltaSourceName
                                           NULL,  // deltaSourceSize
                                           NULL,  // fragmentOffset,
@@ -3537,6 +5151,7 @@ Misc_udelay(1000*1000);
                                               NULL,  // fileNameList,
                                               NULL,  // fileInfo,
                                               NULL,  // fileExtendedAttributeList
+                                              NULL,  // fileHoleList
                                               NULL,  // deltaSourceName
                                               NULL,  // deltaSourceSize
                                               NULL,  // fragmentOffset,
@@ -3550,1598 +5165,2517 @@ Misc_udelay(1000*1000);
           break;
         case ARCHIVE_ENTRY_TYPE_SPECIAL:
           {
-            ArchiveEntryInfo archiveEntryInfo;
-            error = Archive_readSpecialEntry(&archiveEntryInfo,
-                                             &archiveHandle,
-                                             NULL,  // cryptType
-                                             NULL,  // cryptAlgorithm
-                                             NULL,  // cryptSalt
-                                             NULL,  // cryptKey
-                                             NULL,  // fileName,
-                                             NULL,  // fileInfo,
-                                             NULL   // fileExtendedAttributeList
-                                            );
-            if (error == ERROR_NONE)
-            {
-              error = Archive_closeEntry(&archiveEntryInfo);
-            }
+            ArchiveEntryInfo archiveEntryInfo;
+            error = Archive_readSpecialEntry(&archiveEntryInfo,
+                                             &archiveHandle,
+                                             NULL,  // cryptType
+                                             NULL,  // cryptAlgorithm
+                                             NULL,  // cryptSalt
+                                             NULL,  // cryptKey
+                                             NULL,  // fileName,
+                                             NULL,  // fileInfo,
+                                             NULL   // fileExtendedAttributeList
+                                            );
+            if (error == ERROR_NONE)
+            {
+              error = Archive_closeEntry(&archiveEntryInfo);
+            }
+          }
+          break;
+        case ARCHIVE_ENTRY_TYPE_META:
+          {
+// TODO: read meta
+            error = Archive_skipNextEntry(&archiveHandle);
+          }
+          break;
+        case ARCHIVE_ENTRY_TYPE_SALT:
+// TODO: read salt
+          {
+          }
+          break;
+        case ARCHIVE_ENTRY_TYPE_KEY:
+// TODO: read key
+          {
+            #ifndef NDEBUG
+              HALT_INTERNAL_ERROR_UNREACHABLE();
+            #else
+              error = Archive_skipNextEntry(&archiveHandle);
+            #endif /* NDEBUG */
+          }
+          break;
+        case ARCHIVE_ENTRY_TYPE_SOLID:
+        case ARCHIVE_ENTRY_TYPE_SIGNATURE:
+// TODO: read signature
+          {
+            error = Archive_skipNextEntry(&archiveHandle);
+          }
+          break;
+        case ARCHIVE_ENTRY_TYPE_UNKNOWN:
+          error = ERROR_UNKNOWN_CHUNK;
+          break; /* not reached */
+      }
+    }
+  }
+
+  // close archive
+  (void)Archive_close(&archiveHandle,FALSE);
+
+  return error;
+}
+
+/***********************************************************************\
+* Name   : archiveStore
+* Purpose: call back to store archive file
+* Input  : storageInfo          - storage info
+*          uuidId               - index UUID id
+*          jobUUID              - job UUID
+*          entityUUID           - entity UUID
+*          entityId             - index entity id
+*          storageId            - index storage id
+*          partNumber           - part number or ARCHIVE_PART_NUMBER_NONE
+*                                 for single part
+*          intermediateFileName - intermediate archive file name or
+*                                 empty if archive was streamed into
+*                                 storage
+*          intermediateFileSize - intermediate archive size [bytes]
+*          userData             - user data
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors archiveStore(StorageInfo  *storageInfo,
+                          IndexId      uuidId,
+                          ConstString  jobUUID,
+                          ConstString  entityUUID,
+                          IndexId      entityId,
+                          IndexId      storageId,
+                          int          partNumber,
+                          ConstString  intermediateFileName,
+                          uint64       intermediateFileSize,
+                          void         *userData
+                         )
+{
+  Errors error;
+
+  assert(storageInfo != NULL);
+  assert(intermediateFileName != NULL);
+
+  UNUSED_VARIABLE(jobUUID);
+  UNUSED_VARIABLE(entityUUID);
+
+  // get archive file name (expand macros)
+  String     archiveName = String_new();
+  CreateInfo *createInfo = (CreateInfo*)userData;
+  assert(createInfo != NULL);
+  error = Archive_formatName(archiveName,
+                             storageInfo->storageSpecifier.archiveName,
+                             EXPAND_MACRO_MODE_STRING,
+                             createInfo->archiveType,
+                             createInfo->scheduleTitle,
+                             createInfo->customText,
+                             createInfo->createdDateTime,
+                             partNumber
+                            );
+  if (error != ERROR_NONE)
+  {
+    (void)File_delete(intermediateFileName,FALSE);
+    String_delete(archiveName);
+    return error;
+  }
+  DEBUG_TESTCODE() { String_delete(archiveName); return DEBUG_TESTCODE_ERROR(); }
+
+  // send to storage thread
+  StorageMsg storageMsg;
+  storageMsg.uuidId               = uuidId;
+  storageMsg.entityId             = entityId;
+  storageMsg.storageId            = storageId;
+  storageMsg.intermediateFileName = String_duplicate(intermediateFileName);
+  storageMsg.intermediateFileSize = intermediateFileSize;
+  storageMsg.archiveName          = archiveName;
+  storageMsg.streamFlag           = String_isEmpty(intermediateFileName);
+  storageInfoIncrement(createInfo,!storageMsg.streamFlag ? intermediateFileSize : 0LL);
+  DEBUG_TESTCODE() { freeStorageMsg(&storageMsg,NULL); return DEBUG_TESTCODE_ERROR(); }
+  bool putFlag = FALSE;
+  SEMAPHORE_LOCKED_DO(&createInfo->storageThreads.lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  {
+    // number storage files in order of sending to keep index updates in order
+    storageMsg.number = createInfo->storageThreads.nextNumber;
+    putFlag = MsgQueue_put(&createInfo->storageMsgQueue,&storageMsg,sizeof(storageMsg));
+    if (putFlag) createInfo->storageThreads.nextNumber++;
+  }
+  if (!putFlag)
+  {
+    freeStorageMsg(&storageMsg,NULL);
+    (void)File_delete(intermediateFileName,FALSE);
+    return ERROR_ABORTED;
+  }
+
+  // update running info
+  STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+  {
+    createInfo->runningInfo.progress.storage.totalSize += intermediateFileSize;
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : purgeStorageByJobUUID
+* Purpose: purge old storages by job UUID
+* Input  : indexHandle    - index handle or NULL if no index
+*          jobUUID        - job UUID
+*          limit          - size limit of existing storages [bytes] or 0
+*          maxStorageSize - max. storage size [bytes]
+*          logHandle      - log handle (can be NULL)
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void purgeStorageByJobUUID(IndexHandle *indexHandle,
+                                 const char  *jobUUID,
+                                 uint64      limit,
+                                 uint64      maxStorageSize,
+                                 LogHandle   *logHandle
+                                )
+{
+  assert(jobUUID != NULL);
+  assert(maxStorageSize > 0LL);
+
+  if (indexHandle != NULL)
+  {
+    String           storageName       = String_new();
+    String           oldestStorageName = String_new();
+    StorageSpecifier storageSpecifier;
+    Storage_initSpecifier(&storageSpecifier);
+    String           dateTime          = String_new();
+    uint64           totalStorageSize  = 0LL;
+    IndexId          oldestStorageId;
+    do
+    {
+      oldestStorageId  = INDEX_ID_NONE;
+
+      Errors error;
+
+      // get total storage size, find oldest storage entry
+      IndexId          oldestUUIDId          = INDEX_ID_NONE;
+      IndexId          oldestEntityId        = INDEX_ID_NONE;
+      String_clear(oldestStorageName);
+      uint64           oldestCreatedDateTime = MAX_UINT64;
+      uint64           oldestSize            = 0LL;
+      IndexQueryHandle indexQueryHandle;
+      error = IndexStorage_initList(&indexQueryHandle,
+                                    indexHandle,
+                                    INDEX_ID_ANY,  // uuidId
+                                    INDEX_ID_ANY,  // entityId
+                                    jobUUID,
+                                    NULL,  // entityUUID
+                                    NULL,  // indexIds
+                                    0,   // indexIdCount
+                                    INDEX_TYPESET_ALL,
+                                      INDEX_STATE_SET(INDEX_STATE_OK)
+                                    | INDEX_STATE_SET(INDEX_STATE_UPDATE_REQUESTED)
+                                    | INDEX_STATE_SET(INDEX_STATE_ERROR),
+                                    INDEX_MODE_SET(INDEX_MODE_AUTO),
+                                    NULL,  // hostName
+                                    NULL,  // userName
+                                    NULL,  // name
+                                    INDEX_STORAGE_SORT_MODE_NONE,
+                                    DATABASE_ORDERING_NONE,
+                                    0LL,  // offset
+                                    INDEX_UNLIMITED
+                                   );
+      if (error != ERROR_NONE)
+      {
+        logMessage(logHandle,
+                   LOG_TYPE_STORAGE,
+                   "Purging storage for job '%s' fail (error: %s)",
+                   jobUUID,
+                   Error_getText(error)
+                  );
+        break;
+      }
+      IndexId uuidId;
+      IndexId entityId;
+      IndexId storageId;
+      uint64  createdDateTime;
+      uint64  size;
+      while (IndexStorage_getNext(&indexQueryHandle,
+                                  &uuidId,
+                                  NULL,  // jobUUID
+                                  &entityId,
+                                  NULL,  // entityUUID
+                                  NULL,  // hostName
+                                  NULL,  // userName
+                                  NULL,  // comment
+                                  NULL,  // createdDateTime
+                                  NULL,  // archiveType
+                                  &storageId,
+                                  storageName,
+                                  &createdDateTime,
+                                  &size,
+                                  NULL,  // indexState
+                                  NULL,  // indexMode
+                                  NULL,  // lastCheckedDateTime
+                                  NULL,  // errorMessage
+                                  NULL,  // totalEntryCount
+                                  NULL  // totalEntrySize
+                                 )
+            )
+      {
+//fprintf(stderr,"%s, %d: %"PRIu64" %s: createdDateTime=%"PRIu64" size=%"PRIu64"\n",__FILE__,__LINE__,storageId,String_cString(storageName),createdDateTime,size);
+        if (createdDateTime < oldestCreatedDateTime)
+        {
+          oldestUUIDId          = uuidId;
+          oldestEntityId        = entityId;
+          oldestStorageId       = storageId;
+          String_set(oldestStorageName,storageName);
+          oldestCreatedDateTime = createdDateTime;
+          oldestSize            = size;
+        }
+        totalStorageSize += size;
+      }
+      Index_doneList(&indexQueryHandle);
+
+//fprintf(stderr,"%s, %d: totalStorageSize=%"PRIu64" limit=%"PRIu64" oldestStorageId=%"PRIu64"\n",__FILE__,__LINE__,totalStorageSize,limit,oldestStorageId);
+      if (!INDEX_ID_IS_NONE((oldestStorageId)) && (totalStorageSize > limit))
+      {
+        // delete oldest storage entry
+        error = Storage_parseName(&storageSpecifier,oldestStorageName);
+        if (error == ERROR_NONE)
+        {
+          StorageInfo storageInfo;
+          error = Storage_init(&storageInfo,
+//TODO
+NULL, // masterIO
+                               &storageSpecifier,
+                               NULL,  // jobOptions
+                               &globalOptions.indexDatabaseMaxBandWidthList,
+                               SERVER_CONNECTION_PRIORITY_HIGH,
+                               CALLBACK_(NULL,NULL),  // storageUpdateProgress
+                               CALLBACK_(NULL,NULL),  // getPassword
+                               CALLBACK_(NULL,NULL),  // requestVolume
+                               CALLBACK_(NULL,NULL),  // isPause
+                               CALLBACK_(NULL,NULL),  // isAborte
+                               logHandle
+                              );
+          if (error == ERROR_NONE)
+          {
+            // delete storage
+            (void)Storage_delete(&storageInfo,
+                                 NULL  // archiveName
+                                );
+
+            // prune empty directories
+            (void)Storage_pruneDirectories(&storageInfo,oldestStorageName);
+
+            Storage_done(&storageInfo);
           }
-          break;
-        case ARCHIVE_ENTRY_TYPE_META:
+          else
           {
-// TODO: read meta
-            error = Archive_skipNextEntry(&archiveHandle);
+            logMessage(logHandle,
+                       LOG_TYPE_STORAGE,
+                       "Purging storage '%s', %.1f%s (%"PRIu64" bytes) fail (error: %s)",
+                       String_cString(oldestStorageName),
+                       BYTES_SHORT(oldestSize),
+                       BYTES_UNIT(oldestSize),
+                       oldestSize,
+                       Error_getText(error)
+                      );
           }
+        }
+
+        // purge index of storage
+        error = IndexStorage_purge(indexHandle,
+                                   oldestStorageId,
+                                   NULL  // progressInfo
+                                  );
+        if (error != ERROR_NONE)
+        {
+          logMessage(logHandle,
+                     LOG_TYPE_STORAGE,
+                     "Purging storage index #%"PRIu64" fail (error: %s)",
+                     oldestStorageId,
+                     Error_getText(error)
+                    );
           break;
-        case ARCHIVE_ENTRY_TYPE_SALT:
-// TODO: read salt
+        }
+        if (!INDEX_ID_IS_NONE(oldestEntityId))
+        {
+          (void)IndexEntity_prune(indexHandle,NULL,NULL,oldestEntityId);
+        }
+        if (!INDEX_ID_IS_NONE(oldestUUIDId))
+        {
+          (void)IndexUUID_prune(indexHandle,NULL,NULL,oldestUUIDId);
+        }
+
+        // log
+        Misc_formatDateTime(String_clear(dateTime),oldestCreatedDateTime,TIME_TYPE_LOCAL,NULL);
+        logMessage(logHandle,
+                   LOG_TYPE_STORAGE,
+                   "Job size limit exceeded (max %.1f%s): purged storage '%s', created at %s, %"PRIu64" bytes",
+                   BYTES_SHORT(maxStorageSize),
+                   BYTES_UNIT(maxStorageSize),
+                   String_cString(oldestStorageName),
+                   String_cString(dateTime),
+                   oldestSize
+                  );
+      }
+    }
+    while (   !INDEX_ID_IS_NONE(oldestStorageId)
+           && (totalStorageSize > limit)
+          );
+
+    // free resources
+    String_delete(dateTime);
+    Storage_doneSpecifier(&storageSpecifier);
+    String_delete(oldestStorageName);
+    String_delete(storageName);
+  }
+}
+
+/***********************************************************************\
+* Name   : purgeStorageByServer
+* Purpose: purge old storages by serer
+* Input  : indexHandle    - index handle or NULL if no index
+*          jobUUID        - job UUID
+*          limit          - limit [bytes] or 0
+*          maxStorageSize - max. storage size [bytes] or 0
+*          logHandle      - log handle (can be NULL)
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void purgeStorageByServer(IndexHandle  *indexHandle,
+                                const Server *server,
+                                uint64       limit,
+                                uint64       maxStorageSize,
+                                LogHandle    *logHandle
+                               )
+{
+  assert(server != NULL);
+  assert(maxStorageSize > 0LL);
+
+  if (indexHandle != NULL)
+  {
+    StorageSpecifier storageSpecifier;
+    Storage_initSpecifier(&storageSpecifier);
+    String           storageName       = String_new();
+    String           oldestStorageName = String_new();
+    String           dateTime          = String_new();
+    uint64           totalStorageSize  = 0LL;
+    IndexId          oldestStorageId   = INDEX_ID_NONE;
+    do
+    {
+      Errors error;
+
+      // get total storage size, find oldest storage entry
+      IndexId          oldestUUIDId          = INDEX_ID_NONE;
+      IndexId          oldestEntityId        = INDEX_ID_NONE;
+      String_clear(oldestStorageName);
+      uint64           oldestCreatedDateTime = MAX_UINT64;
+      uint64           oldestSize            = 0LL;
+      IndexQueryHandle indexQueryHandle;
+      error = IndexStorage_initList(&indexQueryHandle,
+                                    indexHandle,
+                                    INDEX_ID_ANY,  // uuidId
+                                    INDEX_ID_ANY,  // entityId
+                                    NULL,  // jobUUID
+                                    NULL,  // entityUUID
+                                    NULL,  // indexIds
+                                    0,   // indexIdCount
+                                    INDEX_TYPESET_ALL,
+                                      INDEX_STATE_SET(INDEX_STATE_OK)
+                                    | INDEX_STATE_SET(INDEX_STATE_UPDATE_REQUESTED)
+                                    | INDEX_STATE_SET(INDEX_STATE_ERROR),
+                                    INDEX_MODE_SET(INDEX_MODE_AUTO),
+                                    NULL,  // hostName
+                                    NULL,  // userName
+                                    NULL,  // name
+                                    INDEX_STORAGE_SORT_MODE_NONE,
+                                    DATABASE_ORDERING_NONE,
+                                    0LL,  // offset
+                                    INDEX_UNLIMITED
+                                   );
+      if (error != ERROR_NONE)
+      {
+        logMessage(logHandle,
+                   LOG_TYPE_STORAGE,
+                   "Purging storage for server '%s' fail (error: %s)",
+                   String_cString(server->name),
+                   Error_getText(error)
+                  );
+        break;
+      }
+      IndexId uuidId;
+      IndexId entityId;
+      IndexId storageId;
+      uint64  createdDateTime;
+      uint64  size;
+      while (IndexStorage_getNext(&indexQueryHandle,
+                                  &uuidId,
+                                  NULL,  // jobUUID,
+                                  &entityId,
+                                  NULL,  // entityUUID
+                                  NULL,  // hostName
+                                  NULL,  // userName
+                                  NULL,  // comment
+                                  NULL,  // createdDateTime
+                                  NULL,  // archiveType
+                                  &storageId,
+                                  storageName,
+                                  &createdDateTime,
+                                  &size,
+                                  NULL,  // indexState
+                                  NULL,  // indexMode
+                                  NULL,  // lastCheckedDateTime
+                                  NULL,  // errorMessage
+                                  NULL,  // totalEntryCount
+                                  NULL  // totalEntrySize
+                                 )
+            )
+      {
+//fprintf(stderr,"%s, %d: %"PRIu64" %s: %"PRIu64"\n",__FILE__,__LINE__,storageId,String_cString(storageName),createdDateTime);
+        error = Storage_parseName(&storageSpecifier,storageName);
+        if (   (error == ERROR_NONE)
+            && String_equals(storageSpecifier.hostName,server->name)
+           )
+        {
+          if (createdDateTime < oldestCreatedDateTime)
           {
+            oldestUUIDId          = uuidId;
+            oldestEntityId        = entityId;
+            oldestStorageId       = storageId;
+            String_set(oldestStorageName,storageName);
+            oldestCreatedDateTime = createdDateTime;
+            oldestSize            = size;
           }
-          break;
-        case ARCHIVE_ENTRY_TYPE_KEY:
-// TODO: read key
+          totalStorageSize += size;
+        }
+      }
+      Index_doneList(&indexQueryHandle);
+
+      if ((totalStorageSize > limit) && !INDEX_ID_IS_NONE(oldestStorageId))
+      {
+        // delete oldest storage entry
+        error = Storage_parseName(&storageSpecifier,oldestStorageName);
+        if (error == ERROR_NONE)
+        {
+          StorageInfo storageInfo;
+          error = Storage_init(&storageInfo,
+//TODO
+NULL, // masterIO
+                               &storageSpecifier,
+                               NULL,  // jobOptions
+                               &globalOptions.indexDatabaseMaxBandWidthList,
+                               SERVER_CONNECTION_PRIORITY_HIGH,
+                               CALLBACK_(NULL,NULL),  // storageUpdateProgress
+                               CALLBACK_(NULL,NULL),  // getPassword
+                               CALLBACK_(NULL,NULL),  // requestVolume
+                               CALLBACK_(NULL,NULL),  // isPause
+                               CALLBACK_(NULL,NULL),  // isAborted
+                               logHandle
+                              );
+          if (error == ERROR_NONE)
           {
-            #ifndef NDEBUG
-              HALT_INTERNAL_ERROR_UNREACHABLE();
-            #else
-              error = Archive_skipNextEntry(&archiveHandle);
-            #endif /* NDEBUG */
+            // delete storage
+            (void)Storage_delete(&storageInfo,
+                                 NULL  // archiveName
+                                );
+
+            // prune empty directories
+            (void)Storage_pruneDirectories(&storageInfo,oldestStorageName);
           }
-          break;
-        case ARCHIVE_ENTRY_TYPE_SIGNATURE:
-// TODO: read signature
+          else
           {
-            error = Archive_skipNextEntry(&archiveHandle);
+            logMessage(logHandle,
+                       LOG_TYPE_STORAGE,
+                       "Purging storage '%s', %.1f%s (%"PRIu64" bytes) fail (error: %s)",
+                       String_cString(oldestStorageName),
+                       BYTES_SHORT(oldestSize),
+                       BYTES_UNIT(oldestSize),
+                       oldestSize,
+                       Error_getText(error)
+                      );
           }
+          Storage_done(&storageInfo);
+        }
+
+        // purge index of storage
+        error = IndexStorage_purge(indexHandle,
+                                   oldestStorageId,
+                                   NULL  // progressInfo
+                                  );
+        if (error != ERROR_NONE)
+        {
+          logMessage(logHandle,
+                     LOG_TYPE_STORAGE,
+                     "Purging storage index #%"PRIu64" fail (error: %s)",
+                     oldestStorageId,
+                     Error_getText(error)
+                    );
           break;
-        case ARCHIVE_ENTRY_TYPE_UNKNOWN:
-          error = ERROR_UNKNOWN_CHUNK;
-          break; /* not reached */
+        }
+        if (!INDEX_ID_IS_NONE(oldestEntityId))
+        {
+          (void)IndexEntity_prune(indexHandle,NULL,NULL,oldestEntityId);
+        }
+        if (!INDEX_ID_IS_NONE(oldestUUIDId))
+        {
+          (void)IndexUUID_prune(indexHandle,NULL,NULL,oldestUUIDId);
+        }
+
+        // log
+        Misc_formatDateTime(dateTime,oldestCreatedDateTime,TIME_TYPE_LOCAL,NULL);
+        logMessage(logHandle,
+                   LOG_TYPE_STORAGE,
+                   "Server size limit exceeded (max %.1f%s): purged storage '%s', created at %s, %"PRIu64" bytes",
+                   BYTES_SHORT(maxStorageSize),
+                   BYTES_UNIT(maxStorageSize),
+                   String_cString(oldestStorageName),
+                   String_cString(dateTime),
+                   oldestSize
+                  );
       }
     }
-  }
-
-  // close archive
-  (void)Archive_close(&archiveHandle,FALSE);
+    while (   (totalStorageSize > limit)
+           && !INDEX_ID_IS_NONE(oldestStorageId)
+          );
 
-  return error;
+    // free resources
+    String_delete(dateTime);
+    Storage_doneSpecifier(&storageSpecifier);
+    String_delete(oldestStorageName);
+    String_delete(storageName);
+  }
 }
 
 /***********************************************************************\
-* Name   : archiveStore
-* Purpose: call back to store archive file
-* Input  : storageInfo          - storage info
-*          uuidId               - index UUID id
-*          jobUUID              - job UUID
-*          entityUUID           - entity UUID
-*          entityId             - index entity id
-*          storageId            - index storage id
-*          partNumber           - part number or ARCHIVE_PART_NUMBER_NONE
-*                                 for single part
-*          intermediateFileName - intermediate archive file name
-*          intermediateFileSize - intermediate archive size [bytes]
-*          userData             - user data
+* Name   : getStorageThreadCount
+* Purpose: get number of storage threads
+* Input  : createInfo - create info block
 * Output : -
-* Return : ERROR_NONE or error code
-* Notes  : -
+* Return : number of storage threads
+* Notes  : archive parts are transfered to a server concurrently with
+*          one connection per storage thread, bounded by the max.
+*          number of connections to the server
 \***********************************************************************/
 
-LOCAL Errors archiveStore(StorageInfo  *storageInfo,
-                          IndexId      uuidId,
-                          ConstString  jobUUID,
-                          ConstString  entityUUID,
-                          IndexId      entityId,
-                          IndexId      storageId,
-                          int          partNumber,
-                          ConstString  intermediateFileName,
-                          uint64       intermediateFileSize,
-                          void         *userData
-                         )
+LOCAL uint getStorageThreadCount(const CreateInfo *createInfo)
 {
-  Errors error;
+  assert(createInfo != NULL);
+  assert(createInfo->jobOptions != NULL);
 
-  assert(storageInfo != NULL);
-  assert(!String_isEmpty(intermediateFileName));
+  ServerTypes serverType;
+  switch (createInfo->storageInfo.storageSpecifier.type)
+  {
+    case STORAGE_TYPE_FTP:     serverType = SERVER_TYPE_FTP;     break;
+    case STORAGE_TYPE_SCP:
+    case STORAGE_TYPE_SFTP:    serverType = SERVER_TYPE_SSH;     break;
+    case STORAGE_TYPE_WEBDAV:  serverType = SERVER_TYPE_WEBDAV;  break;
+    case STORAGE_TYPE_WEBDAVS: serverType = SERVER_TYPE_WEBDAVS; break;
+    case STORAGE_TYPE_SMB:     serverType = SERVER_TYPE_SMB;     break;
+    default:
+      // file system, optical disk, device: store sequential
+      return 1;
+  }
+
+  // get max. number of connections to server
+  Server server;
+  Configuration_initServer(&server,NULL,SERVER_TYPE_NONE);
+  uint serverId           = Storage_getServerSettings(&server,&createInfo->storageInfo.storageSpecifier,createInfo->jobOptions);
+  uint maxConnectionCount = getServerMaxConnectionCount(serverId,serverType);
+  Configuration_doneServer(&server);
+
+  return ((maxConnectionCount > 0) && (maxConnectionCount < MAX_STORAGE_THREADS))
+           ? maxConnectionCount
+           : MAX_STORAGE_THREADS;
+}
 
-  UNUSED_VARIABLE(jobUUID);
-  UNUSED_VARIABLE(entityUUID);
+/***********************************************************************\
+* Name   : isStreamArchives
+* Purpose: check if archive files are streamed directly into storage
+* Input  : createInfo - create info block
+* Output : -
+* Return : TRUE iff archive files are streamed into storage, FALSE if
+*          temporary archive files are used
+* Notes  : temporary archive files are required if the size must be
+*          known before storing (FTP, SCP, WebDAV), for optical disks
+*          and devices, to append to or to rename existing archives
+*          and to create PAR2 files
+\***********************************************************************/
 
-  // get archive file name (expand macros)
-  String     archiveName = String_new();
-  CreateInfo *createInfo = (CreateInfo*)userData;
+LOCAL bool isStreamArchives(const CreateInfo *createInfo)
+{
   assert(createInfo != NULL);
-  error = Archive_formatName(archiveName,
-                             storageInfo->storageSpecifier.archiveName,
-                             EXPAND_MACRO_MODE_STRING,
-                             createInfo->archiveType,
-                             createInfo->scheduleTitle,
-                             createInfo->customText,
-                             createInfo->createdDateTime,
-                             partNumber
-                            );
-  if (error != ERROR_NONE)
+  assert(createInfo->jobOptions != NULL);
+
+  if (   !globalOptions.streamArchivesFlag
+      || createInfo->jobOptions->dryRun
+      || createInfo->jobOptions->noStorage
+      || (createInfo->jobOptions->archiveFileMode == ARCHIVE_FILE_MODE_APPEND)
+      || (createInfo->jobOptions->archiveFileMode == ARCHIVE_FILE_MODE_RENAME)
+     )
   {
-    (void)File_delete(intermediateFileName,FALSE);
-    String_delete(archiveName);
-    return error;
+    return FALSE;
   }
-  DEBUG_TESTCODE() { String_delete(archiveName); return DEBUG_TESTCODE_ERROR(); }
 
-  // send to storage thread
-  StorageMsg storageMsg;
-  storageMsg.uuidId               = uuidId;
-  storageMsg.entityId             = entityId;
-  storageMsg.storageId            = storageId;
-  storageMsg.intermediateFileName = String_duplicate(intermediateFileName);
-  storageMsg.intermediateFileSize = intermediateFileSize;
-  storageMsg.archiveName          = archiveName;
-  storageInfoIncrement(createInfo,intermediateFileSize);
-  DEBUG_TESTCODE() { freeStorageMsg(&storageMsg,NULL); return DEBUG_TESTCODE_ERROR(); }
-  if (!MsgQueue_put(&createInfo->storageMsgQueue,&storageMsg,sizeof(storageMsg)))
+  #ifdef HAVE_PAR2
+    if (   !stringIsEmpty(globalOptions.par2Directory)
+        || !String_isEmpty(createInfo->jobOptions->par2Directory)
+       )
+    {
+      return FALSE;
+    }
+  #endif // HAVE_PAR2
+
+  switch (createInfo->storageInfo.storageSpecifier.type)
   {
-    freeStorageMsg(&storageMsg,NULL);
-    (void)File_delete(intermediateFileName,FALSE);
-    return ERROR_ABORTED;
+    case STORAGE_TYPE_FILESYSTEM:
+    case STORAGE_TYPE_SFTP:
+    case STORAGE_TYPE_SMB:
+      return TRUE;
+    default:
+      return FALSE;
   }
+}
 
-  // update running info
-  STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+/***********************************************************************\
+* Name   : waitStorageTurn
+* Purpose: wait until all previous storage files are done
+* Input  : createInfo - create info block
+*          number     - sequence number of storage file
+* Output : -
+* Return : TRUE iff all previous storage files are done, FALSE on
+*          error/abort
+* Notes  : -
+\***********************************************************************/
+
+LOCAL bool waitStorageTurn(CreateInfo *createInfo, uint64 number)
+{
+  assert(createInfo != NULL);
+
+  bool turnFlag = FALSE;
+  SEMAPHORE_LOCKED_DO(&createInfo->storageThreads.lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
   {
-    createInfo->runningInfo.progress.storage.totalSize += intermediateFileSize;
+    while (   (createInfo->storageThreads.doneNumber != number)
+           && (createInfo->failError == ERROR_NONE)
+           && !isAborted(createInfo)
+          )
+    {
+      (void)Semaphore_waitModified(&createInfo->storageThreads.lock,500L);
+    }
+    turnFlag = (createInfo->storageThreads.doneNumber == number);
   }
 
-  return ERROR_NONE;
+  return turnFlag;
 }
 
 /***********************************************************************\
-* Name   : purgeStorageByJobUUID
-* Purpose: purge old storages by job UUID
-* Input  : indexHandle    - index handle or NULL if no index
-*          jobUUID        - job UUID
-*          limit          - size limit of existing storages [bytes] or 0
-*          maxStorageSize - max. storage size [bytes]
-*          logHandle      - log handle (can be NULL)
+* Name   : doneStorageTurn
+* Purpose: done storage file, continue with next storage file
+* Input  : createInfo - create info block
+*          number     - sequence number of storage file
 * Output : -
 * Return : -
 * Notes  : -
 \***********************************************************************/
 
-LOCAL void purgeStorageByJobUUID(IndexHandle *indexHandle,
-                                 const char  *jobUUID,
-                                 uint64      limit,
-                                 uint64      maxStorageSize,
-                                 LogHandle   *logHandle
-                                )
+LOCAL void doneStorageTurn(CreateInfo *createInfo, uint64 number)
 {
-  assert(jobUUID != NULL);
-  assert(maxStorageSize > 0LL);
+  assert(createInfo != NULL);
+
+  if (waitStorageTurn(createInfo,number))
+  {
+    SEMAPHORE_LOCKED_DO(&createInfo->storageThreads.lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+    {
+      createInfo->storageThreads.doneNumber++;
+      Semaphore_signalModified(&createInfo->storageThreads.lock,SEMAPHORE_SIGNAL_MODIFY_ALL);
+    }
+  }
+}
+
+/***********************************************************************\
+* Name   : printStoreInfo
+* Purpose: print store info
+* Input  : storageMsg           - storage message
+*          printableStorageName - printable storage name
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void printStoreInfo(const StorageMsg *storageMsg, ConstString printableStorageName)
+{
+  assert(storageMsg != NULL);
+
+  #ifndef NDEBUG
+    if (!storageMsg->streamFlag)
+    {
+      printInfo(1,"Store '%s' to '%s'...",String_cString(storageMsg->intermediateFileName),String_cString(printableStorageName));
+    }
+    else
+    {
+      printInfo(1,"Store '%s'...",String_cString(printableStorageName));
+    }
+  #else /* not NDEBUG */
+    UNUSED_VARIABLE(storageMsg);
+
+    printInfo(1,"Store '%s'...",String_cString(printableStorageName));
+  #endif /* NDEBUG */
+}
+
+/***********************************************************************\
+* Name   : storeArchives
+* Purpose: store archive files
+* Input  : createInfo  - create info block
+*          indexHandle - index handle or NULL
+* Output : -
+* Return : -
+* Notes  : may run in several storage threads concurrently; index
+*          updates are done in order of the storage files
+\***********************************************************************/
+
+LOCAL void storeArchives(CreateInfo *createInfo, IndexHandle *indexHandle)
+{
+  #define MAX_RETRIES 3
+
+  assert(createInfo != NULL);
+  assert(createInfo->jobOptions != NULL);
+
+  // init variables
+  AutoFreeList autoFreeList;
+  AutoFree_init(&autoFreeList);
 
-  if (indexHandle != NULL)
+  // store archives
+  String printableStorageName  = String_new();
+  AUTOFREE_ADD(&autoFreeList,printableStorageName,{ String_delete(printableStorageName); });
+  String directoryPath         = String_new();
+  AUTOFREE_ADD(&autoFreeList,directoryPath,{ String_delete(directoryPath); });
+  String existingStorageName   = String_new();
+  AUTOFREE_ADD(&autoFreeList,existingStorageName,{ String_delete(existingStorageName); });
+  String existingDirectoryName = String_new();
+  AUTOFREE_ADD(&autoFreeList,existingDirectoryName,{ String_delete(existingDirectoryName); });
+  StorageSpecifier existingStorageSpecifier;
+  Storage_initSpecifier(&existingStorageSpecifier);
+  AUTOFREE_ADD(&autoFreeList,&existingStorageSpecifier,{ Storage_doneSpecifier(&existingStorageSpecifier); });
+  byte *buffer = (byte*)malloc(BUFFER_SIZE);
+  if (buffer == NULL)
   {
-    String           storageName       = String_new();
-    String           oldestStorageName = String_new();
-    StorageSpecifier storageSpecifier;
-    Storage_initSpecifier(&storageSpecifier);
-    String           dateTime          = String_new();
-    uint64           totalStorageSize  = 0LL;
-    IndexId          oldestStorageId;
-    do
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  AUTOFREE_ADD(&autoFreeList,buffer,{ free(buffer); });
+  while (   (createInfo->failError == ERROR_NONE)
+         && !isAborted(createInfo)
+        )
+  {
+    void *autoFreeSavePoint = AutoFree_save(&autoFreeList);
+
+    // pause, check abort
+    Storage_pause(&createInfo->storageInfo);
+    if ((createInfo->failError != ERROR_NONE) || isAborted(createInfo))
     {
-      oldestStorageId  = INDEX_ID_NONE;
+      AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
+      break;
+    }
+
+    // get next archive to store
+    StorageMsg storageMsg;
+    if (!MsgQueue_get(&createInfo->storageMsgQueue,&storageMsg,NULL,sizeof(storageMsg),WAIT_FOREVER))
+    {
+      AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
+      break;
+    }
+    AUTOFREE_ADD(&autoFreeList,&storageMsg,
+                 {
+                   storageInfoDecrement(createInfo,!storageMsg.streamFlag ? storageMsg.intermediateFileSize : 0LL);
+                   if (!storageMsg.streamFlag) File_delete(storageMsg.intermediateFileName,FALSE);
+                   freeStorageMsg(&storageMsg,NULL);
+                 }
+                );
+    if ((createInfo->failError != ERROR_NONE) || isAborted(createInfo))
+    {
+      AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
+      break;
+    }
 
+    if (!createInfo->jobOptions->dryRun)
+    {
       Errors error;
 
-      // get total storage size, find oldest storage entry
-      IndexId          oldestUUIDId          = INDEX_ID_NONE;
-      IndexId          oldestEntityId        = INDEX_ID_NONE;
-      String_clear(oldestStorageName);
-      uint64           oldestCreatedDateTime = MAX_UINT64;
-      uint64           oldestSize            = 0LL;
-      IndexQueryHandle indexQueryHandle;
-      error = IndexStorage_initList(&indexQueryHandle,
-                                    indexHandle,
-                                    INDEX_ID_ANY,  // uuidId
-                                    INDEX_ID_ANY,  // entityId
-                                    jobUUID,
-                                    NULL,  // entityUUID
-                                    NULL,  // indexIds
-                                    0,   // indexIdCount
-                                    INDEX_TYPESET_ALL,
-                                      INDEX_STATE_SET(INDEX_STATE_OK)
-                                    | INDEX_STATE_SET(INDEX_STATE_UPDATE_REQUESTED)
-                                    | INDEX_STATE_SET(INDEX_STATE_ERROR),
-                                    INDEX_MODE_SET(INDEX_MODE_AUTO),
-                                    NULL,  // hostName
-                                    NULL,  // userName
-                                    NULL,  // name
-                                    INDEX_STORAGE_SORT_MODE_NONE,
-                                    DATABASE_ORDERING_NONE,
-                                    0LL,  // offset
-                                    INDEX_UNLIMITED
-                                   );
-      if (error != ERROR_NONE)
+      // get file info
+      FileInfo fileInfo;
+      if (!storageMsg.streamFlag)
       {
-        logMessage(logHandle,
-                   LOG_TYPE_STORAGE,
-                   "Purging storage for job '%s' fail (error: %s)",
-                   jobUUID,
-                   Error_getText(error)
-                  );
-        break;
+        error = File_getInfo(&fileInfo,storageMsg.intermediateFileName);
+        if (error != ERROR_NONE)
+        {
+          if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+
+          printError(_("cannot get info for file '%s' (error: %s)"),
+                     String_cString(storageMsg.intermediateFileName),
+                     Error_getText(error)
+                    );
+
+          AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
+          break;
+        }
+        DEBUG_TESTCODE() { createInfo->failError = DEBUG_TESTCODE_ERROR(); AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE); break; }
       }
-      IndexId uuidId;
-      IndexId entityId;
-      IndexId storageId;
-      uint64  createdDateTime;
-      uint64  size;
-      while (IndexStorage_getNext(&indexQueryHandle,
-                                  &uuidId,
-                                  NULL,  // jobUUID
-                                  &entityId,
-                                  NULL,  // entityUUID
-                                  NULL,  // hostName
-                                  NULL,  // userName
-                                  NULL,  // comment
-                                  NULL,  // createdDateTime
-                                  NULL,  // archiveType
-                                  &storageId,
-                                  storageName,
-                                  &createdDateTime,
-                                  &size,
-                                  NULL,  // indexState
-                                  NULL,  // indexMode
-                                  NULL,  // lastCheckedDateTime
-                                  NULL,  // errorMessage
-                                  NULL,  // totalEntryCount
-                                  NULL  // totalEntrySize
-                                 )
-            )
+      else
       {
-//fprintf(stderr,"%s, %d: %"PRIu64" %s: createdDateTime=%"PRIu64" size=%"PRIu64"\n",__FILE__,__LINE__,storageId,String_cString(storageName),createdDateTime,size);
-        if (createdDateTime < oldestCreatedDateTime)
+        // archive already streamed into storage
+        memClear(&fileInfo,sizeof(fileInfo));
+        fileInfo.size = storageMsg.intermediateFileSize;
+      }
+
+      // check if exist, auto-rename if requested
+      if (   !storageMsg.streamFlag
+          && (createInfo->storageInfo.jobOptions != NULL)
+          && (createInfo->storageInfo.jobOptions->archiveFileMode == ARCHIVE_FILE_MODE_RENAME)
+          && Storage_exists(&createInfo->storageInfo,storageMsg.archiveName)
+         )
+      {
+        String directoryPath,baseName,extension;
+        String prefixFileName,postfixFileName;
+        uint   n;
+
+        // rename new archive
+        directoryPath   = String_new();
+        baseName        = String_new();
+        extension       = String_new();
+        prefixFileName  = String_new();
+        postfixFileName = String_new();
+        File_splitFileName(storageMsg.archiveName,directoryPath,baseName,extension);
+        String_set(prefixFileName,baseName);
+        String_set(postfixFileName,extension);
+        n = 0;
+        do
         {
-          oldestUUIDId          = uuidId;
-          oldestEntityId        = entityId;
-          oldestStorageId       = storageId;
-          String_set(oldestStorageName,storageName);
-          oldestCreatedDateTime = createdDateTime;
-          oldestSize            = size;
+          String_set(storageMsg.archiveName,directoryPath);
+          File_appendFileName(storageMsg.archiveName,prefixFileName);
+          String_appendFormat(storageMsg.archiveName,"-%u",n);
+          String_append(storageMsg.archiveName,postfixFileName);
+          n++;
         }
-        totalStorageSize += size;
+        while (Storage_exists(&createInfo->storageInfo,storageMsg.archiveName));
+        String_delete(postfixFileName);
+        String_delete(prefixFileName);
+        String_delete(extension);
+        String_delete(baseName);
+        String_delete(directoryPath);
       }
-      Index_doneList(&indexQueryHandle);
 
-//fprintf(stderr,"%s, %d: totalStorageSize=%"PRIu64" limit=%"PRIu64" oldestStorageId=%"PRIu64"\n",__FILE__,__LINE__,totalStorageSize,limit,oldestStorageId);
-      if (!INDEX_ID_IS_NONE((oldestStorageId)) && (totalStorageSize > limit))
+      // get printable storage name
+      Storage_getPrintableName(printableStorageName,&createInfo->storageInfo.storageSpecifier,storageMsg.archiveName);
+
+      // pre-process (Note: already done for streamed archive)
+      if (!storageMsg.streamFlag)
       {
-        // delete oldest storage entry
-        error = Storage_parseName(&storageSpecifier,oldestStorageName);
-        if (error == ERROR_NONE)
+        error = Storage_preProcess(&createInfo->storageInfo,
+                                   storageMsg.
+                                   archiveName,
+                                   createInfo->createdDateTime,
+                                   FALSE  // initialFlag
+                                  );
+        if (error != ERROR_NONE)
         {
-          StorageInfo storageInfo;
-          error = Storage_init(&storageInfo,
-//TODO
-NULL, // masterIO
-                               &storageSpecifier,
-                               NULL,  // jobOptions
-                               &globalOptions.indexDatabaseMaxBandWidthList,
-                               SERVER_CONNECTION_PRIORITY_HIGH,
-                               CALLBACK_(NULL,NULL),  // storageUpdateProgress
-                               CALLBACK_(NULL,NULL),  // getPassword
-                               CALLBACK_(NULL,NULL),  // requestVolume
-                               CALLBACK_(NULL,NULL),  // isPause
-                               CALLBACK_(NULL,NULL),  // isAborte
-                               logHandle
-                              );
-          if (error == ERROR_NONE)
-          {
-            // delete storage
-            (void)Storage_delete(&storageInfo,
-                                 NULL  // archiveName
-                                );
+          if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
 
-            // prune empty directories
-            (void)Storage_pruneDirectories(&storageInfo,oldestStorageName);
+          printError(_("cannot pre-process file '%s' (error: %s)!"),
+                     String_cString(printableStorageName),
+                     Error_getText(error)
+                    );
 
-            Storage_done(&storageInfo);
-          }
-          else
-          {
-            logMessage(logHandle,
-                       LOG_TYPE_STORAGE,
-                       "Purging storage '%s', %.1f%s (%"PRIu64" bytes) fail (error: %s)",
-                       String_cString(oldestStorageName),
-                       BYTES_SHORT(oldestSize),
-                       BYTES_UNIT(oldestSize),
-                       oldestSize,
-                       Error_getText(error)
-                      );
-          }
+          AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
+          break;
+        }
+        DEBUG_TESTCODE() { createInfo->failError = DEBUG_TESTCODE_ERROR(); AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE); break; }
+      }
+
+      // check storage size, purge old archives
+      if (!createInfo->jobOptions->dryRun && (createInfo->jobOptions->maxStorageSize > 0LL))
+      {
+        // purge archives by max. job storage size
+        purgeStorageByJobUUID(indexHandle,
+                              createInfo->jobUUID,
+                              (createInfo->jobOptions->maxStorageSize > fileInfo.size)
+                                ? createInfo->jobOptions->maxStorageSize-fileInfo.size
+                                : 0LL,
+                              createInfo->jobOptions->maxStorageSize,
+                              createInfo->logHandle
+                             );
+
+        // purge archives by max. server storage size
+        Server server;
+        Configuration_initServer(&server,NULL,SERVER_TYPE_NONE);
+        Storage_getServerSettings(&server,&createInfo->storageInfo.storageSpecifier,createInfo->jobOptions);
+        if (server.maxStorageSize > fileInfo.size)
+        {
+          purgeStorageByServer(indexHandle,
+                               &server,
+                               server.maxStorageSize-fileInfo.size,
+                               server.maxStorageSize,
+                               createInfo->logHandle
+                              );
         }
+        Configuration_doneServer(&server);
+      }
 
-        // purge index of storage
-        error = IndexStorage_purge(indexHandle,
-                                   oldestStorageId,
-                                   NULL  // progressInfo
-                                  );
+      // transfer intermediate file to storage
+      bool   appendFlag  = FALSE;
+      uint64 storageSize = 0LL;
+      if (!storageMsg.streamFlag)
+      {
+        // open file to store
+        FileHandle fileHandle;
+        error = File_open(&fileHandle,storageMsg.intermediateFileName,FILE_OPEN_READ);
         if (error != ERROR_NONE)
         {
-          logMessage(logHandle,
-                     LOG_TYPE_STORAGE,
-                     "Purging storage index #%"PRIu64" fail (error: %s)",
-                     oldestStorageId,
+          if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+
+          printStoreInfo(&storageMsg,printableStorageName);
+          printInfo(1,"FAIL!\n");
+          printError(_("cannot open file '%s' (error: %s)!"),
+                     String_cString(storageMsg.intermediateFileName),
                      Error_getText(error)
                     );
+
+          AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
           break;
         }
-        if (!INDEX_ID_IS_NONE(oldestEntityId))
-        {
-          (void)IndexEntity_prune(indexHandle,NULL,NULL,oldestEntityId);
-        }
-        if (!INDEX_ID_IS_NONE(oldestUUIDId))
-        {
-          (void)IndexUUID_prune(indexHandle,NULL,NULL,oldestUUIDId);
-        }
-
-        // log
-        Misc_formatDateTime(String_clear(dateTime),oldestCreatedDateTime,TIME_TYPE_LOCAL,NULL);
-        logMessage(logHandle,
-                   LOG_TYPE_STORAGE,
-                   "Job size limit exceeded (max %.1f%s): purged storage '%s', created at %s, %"PRIu64" bytes",
-                   BYTES_SHORT(maxStorageSize),
-                   BYTES_UNIT(maxStorageSize),
-                   String_cString(oldestStorageName),
-                   String_cString(dateTime),
-                   oldestSize
-                  );
-      }
-    }
-    while (   !INDEX_ID_IS_NONE(oldestStorageId)
-           && (totalStorageSize > limit)
-          );
+        AUTOFREE_ADD(&autoFreeList,&fileHandle,{ File_close(&fileHandle); });
+        DEBUG_TESTCODE() { createInfo->failError = DEBUG_TESTCODE_ERROR(); AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE); continue; }
 
-    // free resources
-    String_delete(dateTime);
-    Storage_doneSpecifier(&storageSpecifier);
-    String_delete(oldestStorageName);
-    String_delete(storageName);
-  }
-}
+        // create storage
+        uint retryCount = 0;
+        do
+        {
+          // next try
+          retryCount++;
 
-/***********************************************************************\
-* Name   : purgeStorageByServer
-* Purpose: purge old storages by serer
-* Input  : indexHandle    - index handle or NULL if no index
-*          jobUUID        - job UUID
-*          limit          - limit [bytes] or 0
-*          maxStorageSize - max. storage size [bytes] or 0
-*          logHandle      - log handle (can be NULL)
-* Output : -
-* Return : -
-* Notes  : -
-\***********************************************************************/
+          // pause, check abort/error
+          Storage_pause(&createInfo->storageInfo);
+          if (isAborted(createInfo) || (createInfo->failError != ERROR_NONE))
+          {
+            break;
+          }
 
-LOCAL void purgeStorageByServer(IndexHandle  *indexHandle,
-                                const Server *server,
-                                uint64       limit,
-                                uint64       maxStorageSize,
-                                LogHandle    *logHandle
-                               )
-{
-  assert(server != NULL);
-  assert(maxStorageSize > 0LL);
+          // check if append to storage
+          appendFlag =    (createInfo->storageInfo.jobOptions != NULL)
+                       && (createInfo->storageInfo.jobOptions->archiveFileMode == ARCHIVE_FILE_MODE_APPEND)
+                       && Storage_exists(&createInfo->storageInfo,storageMsg.archiveName);
+
+          // create/append storage file
+          StorageHandle storageHandle;
+          error = Storage_create(&storageHandle,
+                                 &createInfo->storageInfo,
+                                 storageMsg.archiveName,
+                                 fileInfo.size,
+                                 FALSE  // forceFlag
+                                );
+          if (error != ERROR_NONE)
+          {
+            if (retryCount < MAX_RETRIES)
+            {
+              // retry
+              continue;
+            }
+            else
+            {
+              // create fail -> abort
+              break;
+            }
+          }
+          DEBUG_TESTCODE() { Storage_close(&storageHandle); error = DEBUG_TESTCODE_ERROR(); break; }
+          AUTOFREE_ADD(&autoFreeList,&storageMsg,
+                       {
+                         if (!appendFlag && !INDEX_ID_IS_NONE(storageMsg.storageId))
+                         {
+                           IndexStorage_purge(indexHandle,
+                                              storageMsg.storageId,
+                                              NULL  // progressInfo
+                                             );
+                         }
+                       }
+                      );
 
-  if (indexHandle != NULL)
-  {
-    StorageSpecifier storageSpecifier;
-    Storage_initSpecifier(&storageSpecifier);
-    String           storageName       = String_new();
-    String           oldestStorageName = String_new();
-    String           dateTime          = String_new();
-    uint64           totalStorageSize  = 0LL;
-    IndexId          oldestStorageId   = INDEX_ID_NONE;
-    do
-    {
-      Errors error;
+          // update running info
+          STATUS_INFO_UPDATE(createInfo,NULL,NULL)
+          {
+            String_set(createInfo->runningInfo.progress.storage.name,printableStorageName);
+          }
 
-      // get total storage size, find oldest storage entry
-      IndexId          oldestUUIDId          = INDEX_ID_NONE;
-      IndexId          oldestEntityId        = INDEX_ID_NONE;
-      String_clear(oldestStorageName);
-      uint64           oldestCreatedDateTime = MAX_UINT64;
-      uint64           oldestSize            = 0LL;
-      IndexQueryHandle indexQueryHandle;
-      error = IndexStorage_initList(&indexQueryHandle,
-                                    indexHandle,
-                                    INDEX_ID_ANY,  // uuidId
-                                    INDEX_ID_ANY,  // entityId
-                                    NULL,  // jobUUID
-                                    NULL,  // entityUUID
-                                    NULL,  // indexIds
-                                    0,   // indexIdCount
-                                    INDEX_TYPESET_ALL,
-                                      INDEX_STATE_SET(INDEX_STATE_OK)
-                                    | INDEX_STATE_SET(INDEX_STATE_UPDATE_REQUESTED)
-                                    | INDEX_STATE_SET(INDEX_STATE_ERROR),
-                                    INDEX_MODE_SET(INDEX_MODE_AUTO),
-                                    NULL,  // hostName
-                                    NULL,  // userName
-                                    NULL,  // name
-                                    INDEX_STORAGE_SORT_MODE_NONE,
-                                    DATABASE_ORDERING_NONE,
-                                    0LL,  // offset
-                                    INDEX_UNLIMITED
-                                   );
-      if (error != ERROR_NONE)
-      {
-        logMessage(logHandle,
-                   LOG_TYPE_STORAGE,
-                   "Purging storage for server '%s' fail (error: %s)",
-                   String_cString(server->name),
-                   Error_getText(error)
-                  );
-        break;
-      }
-      IndexId uuidId;
-      IndexId entityId;
-      IndexId storageId;
-      uint64  createdDateTime;
-      uint64  size;
-      while (IndexStorage_getNext(&indexQueryHandle,
-                                  &uuidId,
-                                  NULL,  // jobUUID,
-                                  &entityId,
-                                  NULL,  // entityUUID
-                                  NULL,  // hostName
-                                  NULL,  // userName
-                                  NULL,  // comment
-                                  NULL,  // createdDateTime
-                                  NULL,  // archiveType
-                                  &storageId,
-                                  storageName,
-                                  &createdDateTime,
-                                  &size,
-                                  NULL,  // indexState
-                                  NULL,  // indexMode
-                                  NULL,  // lastCheckedDateTime
-                                  NULL,  // errorMessage
-                                  NULL,  // totalEntryCount
-                                  NULL  // totalEntrySize
-                                 )
-            )
-      {
-//fprintf(stderr,"%s, %d: %"PRIu64" %s: %"PRIu64"\n",__FILE__,__LINE__,storageId,String_cString(storageName),createdDateTime);
-        error = Storage_parseName(&storageSpecifier,storageName);
-        if (   (error == ERROR_NONE)
-            && String_equals(storageSpecifier.hostName,server->name)
-           )
-        {
-          if (createdDateTime < oldestCreatedDateTime)
+          // pause, check abort/error
+          Storage_pause(&createInfo->storageInfo);
+          if (isAborted(createInfo) || (createInfo->failError != ERROR_NONE))
           {
-            oldestUUIDId          = uuidId;
-            oldestEntityId        = entityId;
-            oldestStorageId       = storageId;
-            String_set(oldestStorageName,storageName);
-            oldestCreatedDateTime = createdDateTime;
-            oldestSize            = size;
+            (void)Storage_close(&storageHandle);
+            (void)Storage_delete(&createInfo->storageInfo,storageMsg.archiveName);
+            break;
           }
-          totalStorageSize += size;
-        }
-      }
-      Index_doneList(&indexQueryHandle);
 
-      if ((totalStorageSize > limit) && !INDEX_ID_IS_NONE(oldestStorageId))
-      {
-        // delete oldest storage entry
-        error = Storage_parseName(&storageSpecifier,oldestStorageName);
-        if (error == ERROR_NONE)
-        {
-          StorageInfo storageInfo;
-          error = Storage_init(&storageInfo,
-//TODO
-NULL, // masterIO
-                               &storageSpecifier,
-                               NULL,  // jobOptions
-                               &globalOptions.indexDatabaseMaxBandWidthList,
-                               SERVER_CONNECTION_PRIORITY_HIGH,
-                               CALLBACK_(NULL,NULL),  // storageUpdateProgress
-                               CALLBACK_(NULL,NULL),  // getPassword
-                               CALLBACK_(NULL,NULL),  // requestVolume
-                               CALLBACK_(NULL,NULL),  // isPause
-                               CALLBACK_(NULL,NULL),  // isAborted
-                               logHandle
-                              );
-          if (error == ERROR_NONE)
+          // transfer file data to storage
+          error = Storage_transferFromFile(&fileHandle,
+                                           &storageHandle,
+                                           CALLBACK_(NULL,NULL),  // storageTransferInfo
+                                           CALLBACK_(NULL,NULL)  // isAborted
+                                          );
+          if (error != ERROR_NONE)
           {
-            // delete storage
-            (void)Storage_delete(&storageInfo,
-                                 NULL  // archiveName
-                                );
+            (void)Storage_close(&storageHandle);
+            (void)Storage_delete(&createInfo->storageInfo,storageMsg.archiveName);
 
-            // prune empty directories
-            (void)Storage_pruneDirectories(&storageInfo,oldestStorageName);
+            if (retryCount < MAX_RETRIES)
+            {
+              // retry
+              continue;
+            }
+            else
+            {
+              // write fail -> abort
+              break;
+            }
           }
-          else
+          DEBUG_TESTCODE() { Storage_close(&storageHandle); Storage_delete(&createInfo->storageInfo,storageMsg.archiveName); error = DEBUG_TESTCODE_ERROR(); break; }
+
+          // pause, check abort/error
+          Storage_pause(&createInfo->storageInfo);
+          if (isAborted(createInfo) || (createInfo->failError != ERROR_NONE))
           {
-            logMessage(logHandle,
-                       LOG_TYPE_STORAGE,
-                       "Purging storage '%s', %.1f%s (%"PRIu64" bytes) fail (error: %s)",
-                       String_cString(oldestStorageName),
-                       BYTES_SHORT(oldestSize),
-                       BYTES_UNIT(oldestSize),
-                       oldestSize,
-                       Error_getText(error)
-                      );
+            (void)Storage_close(&storageHandle);
+            (void)Storage_delete(&createInfo->storageInfo,storageMsg.archiveName);
+            break;
           }
-          Storage_done(&storageInfo);
+
+  //TODO: on error restore to original size/delete
+
+          // get storage size
+          storageSize = Storage_getSize(&storageHandle);
+
+          // close storage
+          Storage_close(&storageHandle);
+        }
+        while (   (createInfo->failError == ERROR_NONE)                            // no eror
+               && !isAborted(createInfo)                                           // not aborted
+               && ((error != ERROR_NONE) && (Error_getErrno(error) != ENOSPC))     // some error and not "no space left"
+               && (retryCount < MAX_RETRIES)                                       // still some retry left
+              );
+        if (error != ERROR_NONE)
+        {
+          if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
         }
 
-        // purge index of storage
-        error = IndexStorage_purge(indexHandle,
-                                   oldestStorageId,
-                                   NULL  // progressInfo
-                                  );
+        // close file to store
+        File_close(&fileHandle);
+        AUTOFREE_REMOVE(&autoFreeList,&fileHandle);
+      }
+      else
+      {
+        // archive already streamed into storage
+        storageSize = storageMsg.intermediateFileSize;
+        AUTOFREE_ADD(&autoFreeList,&storageMsg,
+                     {
+                       if (!INDEX_ID_IS_NONE(storageMsg.storageId))
+                       {
+                         IndexStorage_purge(indexHandle,
+                                            storageMsg.storageId,
+                                            NULL  // progressInfo
+                                           );
+                       }
+                     }
+                    );
+      }
+
+      // wait for previous storage files: keep output and index updates in order
+      (void)waitStorageTurn(createInfo,storageMsg.number);
+      printStoreInfo(&storageMsg,printableStorageName);
+
+      // check if aborted/error
+      if      (isAborted(createInfo))
+      {
+        printInfo(1,"ABORTED\n");
+        AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
+        break;
+      }
+      else if (createInfo->failError != ERROR_NONE)
+      {
+        printInfo(1,"FAIL!\n");
+        printError(_("cannot store '%s' (error: %s)!"),
+                   String_cString(printableStorageName),
+                   Error_getText(createInfo->failError)
+                  );
+        AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
+        break;
+      }
+      printInfo(1,"OK (%"PRIu64" bytes)\n",storageSize);
+
+      if (createInfo->jobOptions->testCreatedArchivesFlag)
+      {
+        printInfo(1,"Test '%s'...",String_cString(printableStorageName));
+        error = simpleTestArchive(&createInfo->storageInfo,storageMsg.archiveName);
         if (error != ERROR_NONE)
         {
-          logMessage(logHandle,
-                     LOG_TYPE_STORAGE,
-                     "Purging storage index #%"PRIu64" fail (error: %s)",
-                     oldestStorageId,
-                     Error_getText(error)
+          if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+
+          printInfo(1,"FAIL!\n");
+          printError(_("cannot test '%s' (error: %s)!"),
+                     String_cString(printableStorageName),
+                     Error_getText(createInfo->failError)
                     );
+          AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
           break;
         }
-        if (!INDEX_ID_IS_NONE(oldestEntityId))
-        {
-          (void)IndexEntity_prune(indexHandle,NULL,NULL,oldestEntityId);
-        }
-        if (!INDEX_ID_IS_NONE(oldestUUIDId))
+        printInfo(1,"OK (%"PRIu64" bytes)\n",fileInfo.size);
+      }
+
+#ifdef HAVE_PAR2
+      if (   !stringIsEmpty(globalOptions.par2Directory)
+          || !String_isEmpty(createInfo->jobOptions->par2Directory)
+         )
+      {
+        printInfo(1,"Create PAR2 files for '%s'...",String_cString(printableStorageName));
+        error = PAR2_create(storageMsg.intermediateFileName,
+                            fileInfo.size,
+                            storageMsg.archiveName,
+                            !String_isEmpty(createInfo->jobOptions->par2Directory)
+                              ? String_cString(createInfo->jobOptions->par2Directory)
+                              : globalOptions.par2Directory,
+                            createInfo->storageInfo.jobOptions->archiveFileMode
+                           );
+        if (error != ERROR_NONE)
         {
-          (void)IndexUUID_prune(indexHandle,NULL,NULL,oldestUUIDId);
-        }
+          if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
 
-        // log
-        Misc_formatDateTime(dateTime,oldestCreatedDateTime,TIME_TYPE_LOCAL,NULL);
-        logMessage(logHandle,
-                   LOG_TYPE_STORAGE,
-                   "Server size limit exceeded (max %.1f%s): purged storage '%s', created at %s, %"PRIu64" bytes",
-                   BYTES_SHORT(maxStorageSize),
-                   BYTES_UNIT(maxStorageSize),
-                   String_cString(oldestStorageName),
-                   String_cString(dateTime),
-                   oldestSize
-                  );
+          printInfo(1,"FAIL!\n");
+          printError(_("cannot create PAR2 files for '%s' (error: %s)!"),
+                     String_cString(printableStorageName),
+                     Error_getText(createInfo->failError)
+                    );
+          AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
+          break;
+        }
+        printInfo(1,"OK\n");
       }
-    }
-    while (   (totalStorageSize > limit)
-           && !INDEX_ID_IS_NONE(oldestStorageId)
-          );
-
-    // free resources
-    String_delete(dateTime);
-    Storage_doneSpecifier(&storageSpecifier);
-    String_delete(oldestStorageName);
-    String_delete(storageName);
-  }
-}
+#endif // HAVE_PAR2
 
-/***********************************************************************\
-* Name   : storageThreadCode
-* Purpose: archive storage thread
-* Input  : createInfo - create info block
-* Output : -
-* Return : -
-* Notes  : -
-\***********************************************************************/
+      // update index database and set state
+      if (   (indexHandle != NULL)
+          && !INDEX_ID_IS_NONE(storageMsg.storageId)
+         )
+      {
+        assert(!INDEX_ID_IS_NONE(storageMsg.entityId));
 
-LOCAL void storageThreadCode(CreateInfo *createInfo)
-{
-  #define MAX_RETRIES 3
+        // check if append and storage exists => assign to existing storage index
+        IndexId storageId;
+        if (   appendFlag
+            && (IndexStorage_findByName(indexHandle,
+                                        &createInfo->storageInfo.storageSpecifier,
+                                        storageMsg.archiveName,
+                                        NULL,  // uuidId
+                                        NULL,  // entityId
+                                        NULL,  // jobUUID
+                                        NULL,  // entityUUID
+                                        &storageId,
+                                        NULL,  // createdDateTime
+                                        NULL,  // size
+                                        NULL,  // indexMode
+                                        NULL,  // indexState
+                                        NULL,  // lastCheckedDateTime
+                                        NULL,  // errorMessage
+                                        NULL,  // totalEntryCount
+                                        NULL  // totalEntrySize
+                                       )
+               )
+           )
+        {
+          // set index database state
+          error = IndexStorage_setState(indexHandle,
+                                        storageId,
+                                        INDEX_STATE_CREATE,
+                                        0LL,  // lastCheckedDateTime
+                                        NULL // errorMessage
+                                       );
+          if (error != ERROR_NONE)
+          {
+            if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
 
-  assert(createInfo != NULL);
-  assert(createInfo->jobOptions != NULL);
+            printInfo(1,"FAIL\n");
+            printError(_("cannot update index for storage '%s' (error: %s)!"),
+                       String_cString(printableStorageName),
+                       Error_getText(error)
+                      );
 
-  // init variables
-  AutoFreeList autoFreeList;
-  AutoFree_init(&autoFreeList);
+            AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
+            break;
+          }
+          AUTOFREE_ADD(&autoFreeList,&storageMsg.storageId,
+          {
+            (void)IndexStorage_setState(indexHandle,
+                                        storageId,
+                                        INDEX_STATE_ERROR,
+                                        0LL,  // lastCheckedDateTime
+                                        NULL // errorMessage
+                                       );
+          });
 
-  // initial storage pre-processing
-  if (   (createInfo->failError == ERROR_NONE)
-      && !createInfo->jobOptions->dryRun
-     )
-  {
-    // pause
-    Storage_pause(&createInfo->storageInfo);
+          // append index: assign storage index entries to existing storage index
+//fprintf(stderr,"%s, %d: append to storage %"PRIu64"\n",__FILE__,__LINE__,storageId);
+          error = IndexAssign_to(indexHandle,
+                                 NULL,  // jobUUID
+                                 INDEX_ID_NONE,  // entityId
+                                 storageMsg.storageId,
+                                 NULL,  // jobUUID
+                                 INDEX_ID_NONE,  // toEntityId
+                                 ARCHIVE_TYPE_NONE,
+                                 storageId
+                                );
+          if (error != ERROR_NONE)
+          {
+            if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
 
-    // pre-process
-    if (!isAborted(createInfo))
-    {
-      Errors error = Storage_preProcess(&createInfo->storageInfo,NULL,createInfo->createdDateTime,TRUE);
-      if (error != ERROR_NONE)
-      {
-        printError(_("cannot pre-process storage (error: %s)!"),
-                   Error_getText(error)
-                  );
-        createInfo->failError = error;
-        AutoFree_cleanup(&autoFreeList);
-        return;
-      }
-    }
-  }
+            printInfo(1,"FAIL\n");
+            printError(_("cannot update index for storage '%s' (error: %s)!"),
+                       String_cString(printableStorageName),
+                       Error_getText(error)
+                      );
 
-  // store archives
-  String printableStorageName  = String_new();
-  AUTOFREE_ADD(&autoFreeList,printableStorageName,{ String_delete(printableStorageName); });
-  String directoryPath         = String_new();
-  AUTOFREE_ADD(&autoFreeList,directoryPath,{ String_delete(directoryPath); });
-  String existingStorageName   = String_new();
-  AUTOFREE_ADD(&autoFreeList,existingStorageName,{ String_delete(existingStorageName); });
-  String existingDirectoryName = String_new();
-  AUTOFREE_ADD(&autoFreeList,existingDirectoryName,{ String_delete(existingDirectoryName); });
-  StorageSpecifier existingStorageSpecifier;
-  Storage_initSpecifier(&existingStorageSpecifier);
-  AUTOFREE_ADD(&autoFreeList,&existingStorageSpecifier,{ Storage_doneSpecifier(&existingStorageSpecifier); });
-  byte *buffer = (byte*)malloc(BUFFER_SIZE);
-  if (buffer == NULL)
-  {
-    HALT_INSUFFICIENT_MEMORY();
-  }
-  AUTOFREE_ADD(&autoFreeList,buffer,{ free(buffer); });
-  while (   (createInfo->failError == ERROR_NONE)
-         && !isAborted(createInfo)
-        )
-  {
-    void *autoFreeSavePoint = AutoFree_save(&autoFreeList);
+            AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
+            break;
+          }
 
-    // pause, check abort
-    Storage_pause(&createInfo->storageInfo);
-    if ((createInfo->failError != ERROR_NONE) || isAborted(createInfo))
-    {
-      AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-      break;
-    }
+          // prune storage (maybe empty now)
+          (void)IndexStorage_prune(indexHandle,NULL,NULL,storageMsg.storageId);
 
-    // get next archive to store
-    StorageMsg storageMsg;
-    if (!MsgQueue_get(&createInfo->storageMsgQueue,&storageMsg,NULL,sizeof(storageMsg),WAIT_FOREVER))
-    {
-      AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-      break;
-    }
-    AUTOFREE_ADD(&autoFreeList,&storageMsg,
-                 {
-                   storageInfoDecrement(createInfo,storageMsg.intermediateFileSize);
-                   File_delete(storageMsg.intermediateFileName,FALSE);
-                   freeStorageMsg(&storageMsg,NULL);
-                 }
-                );
-    if ((createInfo->failError != ERROR_NONE) || isAborted(createInfo))
-    {
-      AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-      break;
-    }
+          // prune entity (maybe empty now)
+          (void)IndexEntity_prune(indexHandle,NULL,NULL,storageMsg.entityId);
+        }
+        else
+        {
+          // replace index: keep new storage
+          storageId = storageMsg.storageId;
+          AUTOFREE_ADD(&autoFreeList,&storageMsg.storageId,
+          {
+            // nothing to do
+          });
 
-    if (!createInfo->jobOptions->dryRun)
-    {
-      Errors error;
+          // delete old indizes for same storage file
+          error = IndexStorage_purgeAllByName(indexHandle,
+                                              &createInfo->storageInfo.storageSpecifier,
+                                              storageMsg.archiveName,
+                                              storageMsg.storageId,
+                                              NULL  // progressInfo
+                                             );
+          if (error != ERROR_NONE)
+          {
+            if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
 
-      // get file info
-      FileInfo fileInfo;
-      error = File_getInfo(&fileInfo,storageMsg.intermediateFileName);
-      if (error != ERROR_NONE)
-      {
-        if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+            printInfo(1,"FAIL\n");
+            printError(_("cannot delete old index for storage '%s' (error: %s)!"),
+                       String_cString(printableStorageName),
+                       Error_getText(error)
+                      );
 
-        printError(_("cannot get info for file '%s' (error: %s)"),
-                   String_cString(storageMsg.intermediateFileName),
-                   Error_getText(error)
-                  );
+            AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
+            break;
+          }
 
-        AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-        break;
-      }
-      DEBUG_TESTCODE() { createInfo->failError = DEBUG_TESTCODE_ERROR(); AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE); break; }
+          // append storage to existing entity which has the same storage directory
+          if (createInfo->storageInfo.jobOptions->archiveFileMode == ARCHIVE_FILE_MODE_APPEND)
+          {
+            Storage_getPrintableName(printableStorageName,&createInfo->storageInfo.storageSpecifier,storageMsg.archiveName);
 
-      // check if exist, auto-rename if requested
-      if (   (createInfo->storageInfo.jobOptions != NULL)
-          && (createInfo->storageInfo.jobOptions->archiveFileMode == ARCHIVE_FILE_MODE_RENAME)
-          && Storage_exists(&createInfo->storageInfo,storageMsg.archiveName)
-         )
-      {
-        String directoryPath,baseName,extension;
-        String prefixFileName,postfixFileName;
-        uint   n;
+            // find matching entity and assign storage to entity
+            File_getDirectoryName(directoryPath,storageMsg.archiveName);
+            IndexQueryHandle indexQueryHandle;
+            error = IndexStorage_initList(&indexQueryHandle,
+                                          indexHandle,
+                                          storageMsg.uuidId,
+                                          INDEX_ID_ANY, // entityId
+                                          NULL,  // jobUUID
+                                          NULL,  // entityUUID
+                                          NULL,  // indexIds
+                                          0,  // indexIdCount
+                                          INDEX_TYPESET_ALL,
+                                          INDEX_STATE_SET_ALL,
+                                          INDEX_MODE_SET_ALL,
+                                          NULL,  // hostName
+                                          NULL,  // userName
+                                          NULL,  // name,
+                                          INDEX_STORAGE_SORT_MODE_NONE,
+                                          DATABASE_ORDERING_NONE,
+                                          0LL,  // offset
+                                          INDEX_UNLIMITED
+                                         );
+            if (error != ERROR_NONE)
+            {
+              if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
 
-        // rename new archive
-        directoryPath   = String_new();
-        baseName        = String_new();
-        extension       = String_new();
-        prefixFileName  = String_new();
-        postfixFileName = String_new();
-        File_splitFileName(storageMsg.archiveName,directoryPath,baseName,extension);
-        String_set(prefixFileName,baseName);
-        String_set(postfixFileName,extension);
-        n = 0;
-        do
-        {
-          String_set(storageMsg.archiveName,directoryPath);
-          File_appendFileName(storageMsg.archiveName,prefixFileName);
-          String_appendFormat(storageMsg.archiveName,"-%u",n);
-          String_append(storageMsg.archiveName,postfixFileName);
-          n++;
-        }
-        while (Storage_exists(&createInfo->storageInfo,storageMsg.archiveName));
-        String_delete(postfixFileName);
-        String_delete(prefixFileName);
-        String_delete(extension);
-        String_delete(baseName);
-        String_delete(directoryPath);
-      }
+              AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
+              break;
+            }
+            IndexId existingEntityId;
+            IndexId existingStorageId;
+            while (IndexStorage_getNext(&indexQueryHandle,
+                                        NULL,  // uuidId
+                                        NULL,  // jobUUID
+                                        &existingEntityId,
+                                        NULL,  // entityUUID
+                                        NULL,  // hostName
+                                        NULL,  // userName
+                                        NULL,  // comment
+                                        NULL,  // createdDateTime
+                                        NULL,  // archiveType
+                                        &existingStorageId,
+                                        existingStorageName,
+                                        NULL,  // createdDateTime
+                                        NULL,  // size
+                                        NULL,  // indexState
+                                        NULL,  // indexMode
+                                        NULL,  // lastCheckedDateTime
+                                        NULL,  // errorMessage
+                                        NULL,  // totalEntryCount
+                                        NULL  // totalEntrySize
+                                       )
+                  )
+            {
+              File_getDirectoryName(existingDirectoryName,existingStorageName);
+              if (   !INDEX_ID_EQUALS(storageId,existingStorageId)
+                  && (Storage_parseName(&existingStorageSpecifier,existingStorageName) == ERROR_NONE)
+                  && Storage_equalSpecifiers(&existingStorageSpecifier,directoryPath,&existingStorageSpecifier,existingDirectoryName)
+                 )
+              {
+//fprintf(stderr,"%s, %d: assign to existingStorageName=%s\n",__FILE__,__LINE__,String_cString(existingStorageName));
+                error = IndexAssign_to(indexHandle,
+                                       NULL,  // jobUUID
+                                       INDEX_ID_NONE,  // entityId
+                                       storageId,
+                                       NULL,  // jobUUID
+                                       existingEntityId,
+                                       ARCHIVE_TYPE_NONE,
+                                       INDEX_ID_NONE  // toStorageId
+                                      );
+                break;
+              }
+            }
+            Index_doneList(&indexQueryHandle);
+            if (error != ERROR_NONE)
+            {
+              if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
 
-      // get printable storage name
-      Storage_getPrintableName(printableStorageName,&createInfo->storageInfo.storageSpecifier,storageMsg.archiveName);
+              printInfo(1,"FAIL\n");
+              printError(_("cannot delete old index for storage '%s' (error: %s)!"),
+                         String_cString(printableStorageName),
+                         Error_getText(error)
+                        );
 
-      // pre-process
-      error = Storage_preProcess(&createInfo->storageInfo,
-                                 storageMsg.
-                                 archiveName,
-                                 createInfo->createdDateTime,
-                                 FALSE  // initialFlag
-                                );
-      if (error != ERROR_NONE)
-      {
-        if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+              AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
+              break;
+            }
 
-        printError(_("cannot pre-process file '%s' (error: %s)!"),
-                   String_cString(printableStorageName),
-                   Error_getText(error)
-                  );
+            // prune entity (maybe empty now)
+            (void)IndexEntity_prune(indexHandle,NULL,NULL,storageMsg.entityId);
+          }
+        }
 
-        AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-        break;
-      }
-      DEBUG_TESTCODE() { createInfo->failError = DEBUG_TESTCODE_ERROR(); AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE); break; }
+        // update index storage name+size+newest entries
+        if (error == ERROR_NONE)
+        {
+          error = IndexStorage_update(indexHandle,
+                                      storageId,
+                                      NULL,  // hostName
+                                      NULL,  // userName
+                                      printableStorageName,
+                                      0,  // createDateTime
+                                      storageSize,
+                                      NULL,  // comment
+                                      TRUE  // updateNewest
+                                     );
+        }
 
-      // check storage size, purge old archives
-      if (!createInfo->jobOptions->dryRun && (createInfo->jobOptions->maxStorageSize > 0LL))
-      {
-        // purge archives by max. job storage size
-        purgeStorageByJobUUID(createInfo->indexHandle,
-                              createInfo->jobUUID,
-                              (createInfo->jobOptions->maxStorageSize > fileInfo.size)
-                                ? createInfo->jobOptions->maxStorageSize-fileInfo.size
-                                : 0LL,
-                              createInfo->jobOptions->maxStorageSize,
-                              createInfo->logHandle
-                             );
+        // update storages info (aggregated values)
+        if (error == ERROR_NONE)
+        {
+          error = IndexStorage_updateInfos(indexHandle,
+                                           storageId
+                                          );
+        }
 
-        // purge archives by max. server storage size
-        Server server;
-        Configuration_initServer(&server,NULL,SERVER_TYPE_NONE);
-        Storage_getServerSettings(&server,&createInfo->storageInfo.storageSpecifier,createInfo->jobOptions);
-        if (server.maxStorageSize > fileInfo.size)
+        // set index database state and last check time stamp
+        if (error == ERROR_NONE)
         {
-          purgeStorageByServer(createInfo->indexHandle,
-                               &server,
-                               server.maxStorageSize-fileInfo.size,
-                               server.maxStorageSize,
-                               createInfo->logHandle
-                              );
+          error = IndexStorage_setState(indexHandle,
+                                        storageId,
+                                        ((createInfo->failError == ERROR_NONE) && !isAborted(createInfo))
+                                          ? INDEX_STATE_OK
+                                          : INDEX_STATE_ERROR,
+                                        Misc_getCurrentDateTime(),
+                                        NULL // errorMessage
+                                       );
         }
-        Configuration_doneServer(&server);
+        if (error != ERROR_NONE)
+        {
+          if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+
+          printInfo(1,"FAIL\n");
+          printError(_("cannot update index for storage '%s' (error: %s)!"),
+                     String_cString(printableStorageName),
+                     Error_getText(error)
+                    );
+
+          AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
+          break;
+        }
+        DEBUG_TESTCODE() { createInfo->failError = DEBUG_TESTCODE_ERROR(); AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE); continue; }
+
+        AUTOFREE_REMOVE(&autoFreeList,&storageMsg.storageId);
       }
 
-      // open file to store
-      #ifndef NDEBUG
-        printInfo(1,"Store '%s' to '%s'...",String_cString(storageMsg.intermediateFileName),String_cString(printableStorageName));
-      #else /* not NDEBUG */
-        printInfo(1,"Store '%s'...",String_cString(printableStorageName));
-      #endif /* NDEBUG */
-      FileHandle fileHandle;
-      error = File_open(&fileHandle,storageMsg.intermediateFileName,FILE_OPEN_READ);
+      // done
+      logMessage(createInfo->logHandle,
+                 LOG_TYPE_STORAGE,
+                 "%s '%s' (%"PRIu64" bytes)",
+                 appendFlag ? "Appended to" : "Stored",
+                 String_cString(printableStorageName),
+                 storageSize
+                );
+
+      // post-process
+      error = Storage_postProcess(&createInfo->storageInfo,storageMsg.archiveName,createInfo->createdDateTime,FALSE);
       if (error != ERROR_NONE)
       {
-        if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
-
-        printInfo(1,"FAIL!\n");
-        printError(_("cannot open file '%s' (error: %s)!"),
-                   String_cString(storageMsg.intermediateFileName),
+        printError(_("cannot post-process storage file '%s' (error: %s)!"),
+                   String_cString(printableStorageName),
                    Error_getText(error)
                   );
+        if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
 
         AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
         break;
       }
-      AUTOFREE_ADD(&autoFreeList,&fileHandle,{ File_close(&fileHandle); });
       DEBUG_TESTCODE() { createInfo->failError = DEBUG_TESTCODE_ERROR(); AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE); continue; }
 
-      // create storage
-      uint   retryCount  = 0;
-      bool   appendFlag  = FALSE;
-      uint64 storageSize = 0LL;
-      do
+      // delete temporary storage file
+      if (!storageMsg.streamFlag)
       {
-        // next try
-        retryCount++;
-
-        // pause, check abort/error
-        Storage_pause(&createInfo->storageInfo);
-        if (isAborted(createInfo) || (createInfo->failError != ERROR_NONE))
-        {
-          break;
-        }
-
-        // check if append to storage
-        appendFlag =    (createInfo->storageInfo.jobOptions != NULL)
-                     && (createInfo->storageInfo.jobOptions->archiveFileMode == ARCHIVE_FILE_MODE_APPEND)
-                     && Storage_exists(&createInfo->storageInfo,storageMsg.archiveName);
-
-        // create/append storage file
-        StorageHandle storageHandle;
-        error = Storage_create(&storageHandle,
-                               &createInfo->storageInfo,
-                               storageMsg.archiveName,
-                               fileInfo.size,
-                               FALSE  // forceFlag
-                              );
+        error = File_delete(storageMsg.intermediateFileName,FALSE);
         if (error != ERROR_NONE)
         {
-          if (retryCount < MAX_RETRIES)
-          {
-            // retry
-            continue;
-          }
-          else
-          {
-            // create fail -> abort
-            break;
-          }
+          printWarning(_("cannot delete file '%s' (error: %s)!"),
+                       String_cString(storageMsg.intermediateFileName),
+                       Error_getText(error)
+                      );
         }
-        DEBUG_TESTCODE() { Storage_close(&storageHandle); error = DEBUG_TESTCODE_ERROR(); break; }
-        AUTOFREE_ADD(&autoFreeList,&storageMsg,
-                     {
-                       if (!appendFlag && !INDEX_ID_IS_NONE(storageMsg.storageId))
-                       {
-                         IndexStorage_purge(createInfo->indexHandle,
-                                            storageMsg.storageId,
-                                            NULL  // progressInfo
-                                           );
-                       }
-                     }
-                    );
+      }
 
-        // update running info
-        STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-        {
-          String_set(createInfo->runningInfo.progress.storage.name,printableStorageName);
-        }
+      // add to set of stored archive files
+      Dictionary_add(&createInfo->storageFileDictionary,
+                     String_cString(storageMsg.archiveName),
+                     String_length(storageMsg.archiveName),
+                     NULL,
+                     0
+                    );
 
-        // pause, check abort/error
-        Storage_pause(&createInfo->storageInfo);
-        if (isAborted(createInfo) || (createInfo->failError != ERROR_NONE))
-        {
-          (void)Storage_close(&storageHandle);
-          (void)Storage_delete(&createInfo->storageInfo,storageMsg.archiveName);
-          break;
-        }
+      // update storage info
+      storageInfoDecrement(createInfo,!storageMsg.streamFlag ? storageMsg.intermediateFileSize : 0LL);
+    }
 
-        // transfer file data to storage
-        error = Storage_transferFromFile(&fileHandle,
-                                         &storageHandle,
-                                         CALLBACK_(NULL,NULL),  // storageTransferInfo
-                                         CALLBACK_(NULL,NULL)  // isAborted
-                                        );
-        if (error != ERROR_NONE)
-        {
-          (void)Storage_close(&storageHandle);
-          (void)Storage_delete(&createInfo->storageInfo,storageMsg.archiveName);
+    // next storage file in order
+    doneStorageTurn(createInfo,storageMsg.number);
 
-          if (retryCount < MAX_RETRIES)
-          {
-            // retry
-            continue;
-          }
-          else
-          {
-            // write fail -> abort
-            break;
-          }
-        }
-        DEBUG_TESTCODE() { Storage_close(&storageHandle); Storage_delete(&createInfo->storageInfo,storageMsg.archiveName); error = DEBUG_TESTCODE_ERROR(); break; }
+    // free resources
+    freeStorageMsg(&storageMsg,NULL);
 
-        // pause, check abort/error
-        Storage_pause(&createInfo->storageInfo);
-        if (isAborted(createInfo) || (createInfo->failError != ERROR_NONE))
-        {
-          (void)Storage_close(&storageHandle);
-          (void)Storage_delete(&createInfo->storageInfo,storageMsg.archiveName);
-          break;
-        }
+    AutoFree_restore(&autoFreeList,autoFreeSavePoint,FALSE);
+  }
 
-//TODO: on error restore to original size/delete
+  // free resoures
+  Storage_doneSpecifier(&existingStorageSpecifier);
+  String_delete(existingDirectoryName);
+  String_delete(existingStorageName);
+  String_delete(directoryPath);
+  String_delete(printableStorageName);
+  free(buffer);
+  AutoFree_done(&autoFreeList);
 
-        // get storage size
-        storageSize = Storage_getSize(&storageHandle);
+  #undef MAX_RETRIES
+}
 
-        // close storage
-        Storage_close(&storageHandle);
-      }
-      while (   (createInfo->failError == ERROR_NONE)                            // no eror
-             && !isAborted(createInfo)                                           // not aborted
-             && ((error != ERROR_NONE) && (Error_getErrno(error) != ENOSPC))     // some error and not "no space left"
-             && (retryCount < MAX_RETRIES)                                       // still some retry left
-            );
-      if (error != ERROR_NONE)
-      {
-        if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
-      }
+/***********************************************************************\
+* Name   : storageWorkerThreadCode
+* Purpose: additional archive storage thread
+* Input  : createInfo - create info block
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
 
-      // close file to store
-      File_close(&fileHandle);
-      AUTOFREE_REMOVE(&autoFreeList,&fileHandle);
+LOCAL void storageWorkerThreadCode(CreateInfo *createInfo)
+{
+  assert(createInfo != NULL);
 
-      // check if aborted/error
-      if      (isAborted(createInfo))
-      {
-        printInfo(1,"ABORTED\n");
-        AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-        break;
-      }
-      else if (createInfo->failError != ERROR_NONE)
-      {
-        printInfo(1,"FAIL!\n");
-        printError(_("cannot store '%s' (error: %s)!"),
-                   String_cString(printableStorageName),
-                   Error_getText(createInfo->failError)
+  if (createInfo->indexHandle != NULL)
+  {
+    // open own index handle
+    IndexHandle indexHandle;
+    Errors error = Index_open(&indexHandle,createInfo->storageInfo.masterIO,INDEX_TIMEOUT);
+    if (error != ERROR_NONE)
+    {
+      printWarning(_("cannot open index for storage thread (error: %s)!"),
+                   Error_getText(error)
                   );
-        AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-        break;
-      }
-      printInfo(1,"OK (%"PRIu64" bytes)\n",storageSize);
+      return;
+    }
 
-      if (createInfo->jobOptions->testCreatedArchivesFlag)
-      {
-        printInfo(1,"Test '%s'...",String_cString(printableStorageName));
-        error = simpleTestArchive(&createInfo->storageInfo,storageMsg.archiveName);
-        if (error != ERROR_NONE)
-        {
-          if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+    storeArchives(createInfo,&indexHandle);
 
-          printInfo(1,"FAIL!\n");
-          printError(_("cannot test '%s' (error: %s)!"),
-                     String_cString(printableStorageName),
-                     Error_getText(createInfo->failError)
-                    );
-          AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-          break;
-        }
-        printInfo(1,"OK (%"PRIu64" bytes)\n",fileInfo.size);
-      }
+    Index_close(&indexHandle);
+  }
+  else
+  {
+    storeArchives(createInfo,NULL);
+  }
+}
 
-#ifdef HAVE_PAR2
-      if (   !stringIsEmpty(globalOptions.par2Directory)
-          || !String_isEmpty(createInfo->jobOptions->par2Directory)
-         )
-      {
-        printInfo(1,"Create PAR2 files for '%s'...",String_cString(printableStorageName));
-        error = PAR2_create(storageMsg.intermediateFileName,
-                            fileInfo.size,
-                            storageMsg.archiveName,
-                            !String_isEmpty(createInfo->jobOptions->par2Directory)
-                              ? String_cString(createInfo->jobOptions->par2Directory)
-                              : globalOptions.par2Directory,
-                            createInfo->storageInfo.jobOptions->archiveFileMode
-                           );
-        if (error != ERROR_NONE)
-        {
-          if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+/***********************************************************************\
+* Name   : storageThreadCode
+* Purpose: archive storage thread
+* Input  : createInfo - create info block
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
 
-          printInfo(1,"FAIL!\n");
-          printError(_("cannot create PAR2 files for '%s' (error: %s)!"),
-                     String_cString(printableStorageName),
-                     Error_getText(createInfo->failError)
-                    );
-          AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-          break;
-        }
-        printInfo(1,"OK\n");
-      }
-#endif // HAVE_PAR2
+LOCAL void storageThreadCode(CreateInfo *createInfo)
+{
+  assert(createInfo != NULL);
+  assert(createInfo->jobOptions != NULL);
 
-      // update index database and set state
-      if (   (createInfo->indexHandle != NULL)
-          && !INDEX_ID_IS_NONE(storageMsg.storageId)
-         )
+  // init variables
+  AutoFreeList autoFreeList;
+  AutoFree_init(&autoFreeList);
+
+  // initial storage pre-processing
+  if (   (createInfo->failError == ERROR_NONE)
+      && !createInfo->jobOptions->dryRun
+     )
+  {
+    // pause
+    Storage_pause(&createInfo->storageInfo);
+
+    // pre-process
+    if (!isAborted(createInfo))
+    {
+      Errors error = Storage_preProcess(&createInfo->storageInfo,NULL,createInfo->createdDateTime,TRUE);
+      if (error != ERROR_NONE)
       {
-        assert(!INDEX_ID_IS_NONE(storageMsg.entityId));
+        printError(_("cannot pre-process storage (error: %s)!"),
+                   Error_getText(error)
+                  );
+        createInfo->failError = error;
+        AutoFree_cleanup(&autoFreeList);
+        return;
+      }
+    }
+  }
 
-        // check if append and storage exists => assign to existing storage index
-        IndexId storageId;
-        if (   appendFlag
-            && (IndexStorage_findByName(createInfo->indexHandle,
-                                        &createInfo->storageInfo.storageSpecifier,
-                                        storageMsg.archiveName,
-                                        NULL,  // uuidId
-                                        NULL,  // entityId
-                                        NULL,  // jobUUID
-                                        NULL,  // entityUUID
-                                        &storageId,
-                                        NULL,  // createdDateTime
-                                        NULL,  // size
-                                        NULL,  // indexMode
-                                        NULL,  // indexState
-                                        NULL,  // lastCheckedDateTime
-                                        NULL,  // errorMessage
-                                        NULL,  // totalEntryCount
-                                        NULL  // totalEntrySize
-                                       )
-               )
-           )
-        {
-          // set index database state
-          error = IndexStorage_setState(createInfo->indexHandle,
-                                        storageId,
-                                        INDEX_STATE_CREATE,
-                                        0LL,  // lastCheckedDateTime
-                                        NULL // errorMessage
-                                       );
-          if (error != ERROR_NONE)
-          {
-            if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+  // store archives, transfer archive parts concurrently with additional storage threads
+  ThreadPoolSet threadSet;
+  ThreadPool_initSet(&threadSet,&workerThreadPool);
+  if (!createInfo->jobOptions->dryRun)
+  {
+    uint storageThreadCount = getStorageThreadCount(createInfo);
+    for (uint i = 1; i < storageThreadCount; i++)
+    {
+      ThreadPool_setAdd(&threadSet,
+                        ThreadPool_run(&workerThreadPool,storageWorkerThreadCode,createInfo)
+                       );
+    }
+  }
+  storeArchives(createInfo,createInfo->indexHandle);
+  ThreadPool_joinSet(&threadSet);
+  ThreadPool_doneSet(&threadSet);
+
+  // discard unprocessed archives
+  StorageMsg storageMsg;
+  while (MsgQueue_get(&createInfo->storageMsgQueue,&storageMsg,NULL,sizeof(storageMsg),NO_WAIT))
+  {
+    // discard index
+    if (!INDEX_ID_IS_NONE(storageMsg.storageId))
+    {
+      (void)IndexStorage_purge(createInfo->indexHandle,
+                               storageMsg.storageId,
+                               NULL  // progressInfo
+                              );
+    }
 
-            printInfo(1,"FAIL\n");
-            printError(_("cannot update index for storage '%s' (error: %s)!"),
-                       String_cString(printableStorageName),
-                       Error_getText(error)
-                      );
+    // delete temporary storage file or already streamed storage file
+    Errors error = (!storageMsg.streamFlag)
+                     ? File_delete(storageMsg.intermediateFileName,FALSE)
+                     : Storage_delete(&createInfo->storageInfo,storageMsg.archiveName);
+    if (error != ERROR_NONE)
+    {
+      printWarning(_("cannot delete file '%s' (error: %s)!"),
+                   String_cString(!storageMsg.streamFlag ? storageMsg.intermediateFileName : storageMsg.archiveName),
+                   Error_getText(error)
+                  );
+    }
 
-            AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-            break;
-          }
-          AUTOFREE_ADD(&autoFreeList,&storageMsg.storageId,
-          {
-            (void)IndexStorage_setState(createInfo->indexHandle,
-                                        storageId,
-                                        INDEX_STATE_ERROR,
-                                        0LL,  // lastCheckedDateTime
-                                        NULL // errorMessage
-                                       );
-          });
+    // free resources
+    freeStorageMsg(&storageMsg,NULL);
+  }
 
-          // append index: assign storage index entries to existing storage index
-//fprintf(stderr,"%s, %d: append to storage %"PRIu64"\n",__FILE__,__LINE__,storageId);
-          error = IndexAssign_to(createInfo->indexHandle,
-                                 NULL,  // jobUUID
-                                 INDEX_ID_NONE,  // entityId
-                                 storageMsg.storageId,
-                                 NULL,  // jobUUID
-                                 INDEX_ID_NONE,  // toEntityId
-                                 ARCHIVE_TYPE_NONE,
-                                 storageId
-                                );
-          if (error != ERROR_NONE)
-          {
-            if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+  // final storage post-processing
+  if (   (createInfo->failError == ERROR_NONE)
+      && !createInfo->jobOptions->dryRun
+     )
+  {
+    // pause
+    Storage_pause(&createInfo->storageInfo);
 
-            printInfo(1,"FAIL\n");
-            printError(_("cannot update index for storage '%s' (error: %s)!"),
-                       String_cString(printableStorageName),
-                       Error_getText(error)
-                      );
+    // post-processing
+    if (!isAborted(createInfo))
+    {
+      Errors error = Storage_postProcess(&createInfo->storageInfo,NULL,createInfo->createdDateTime,TRUE);
+      if (error != ERROR_NONE)
+      {
+        printError(_("cannot post-process storage (error: %s)!"),
+                   Error_getText(error)
+                  );
+        if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+      }
+    }
+  }
 
-            AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-            break;
-          }
+//TODO: required?
+  // delete old storage files if no database
+  if (   (createInfo->failError == ERROR_NONE)
+      && !isAborted(createInfo)
+      && (createInfo->indexHandle == NULL)
+     )
+  {
+    if (globalOptions.deleteOldArchiveFilesFlag)
+    {
+      // get archive name pattern (expand macros)
+      String pattern = String_new();
+      Errors error = Archive_formatName(pattern,
+                                        createInfo->storageInfo.storageSpecifier.archiveName,
+                                        EXPAND_MACRO_MODE_PATTERN,
+                                        createInfo->archiveType,
+                                        createInfo->scheduleTitle,
+                                        createInfo->customText,
+                                        createInfo->createdDateTime,
+                                        ARCHIVE_PART_NUMBER_NONE
+                                       );
+      if (error == ERROR_NONE)
+      {
+        // delete all matching storage files which are unknown
+        (void)Storage_forAll(&createInfo->storageInfo.storageSpecifier,
+                             NULL,  // directory
+                             String_cString(pattern),
+                             TRUE,  // skipUnreadableFlag
+                             CALLBACK_INLINE(Errors,(ConstString storageName, const FileInfo *fileInfo, void *userData),
+                             {
+                               UNUSED_VARIABLE(fileInfo);
+                               UNUSED_VARIABLE(userData);
 
-          // prune storage (maybe empty now)
-          (void)IndexStorage_prune(createInfo->indexHandle,NULL,NULL,storageMsg.storageId);
+                               // init variables
+                               StorageSpecifier storageSpecifier;
+                               Storage_initSpecifier(&storageSpecifier);
 
-          // prune entity (maybe empty now)
-          (void)IndexEntity_prune(createInfo->indexHandle,NULL,NULL,storageMsg.entityId);
-        }
-        else
-        {
-          // replace index: keep new storage
-          storageId = storageMsg.storageId;
-          AUTOFREE_ADD(&autoFreeList,&storageMsg.storageId,
-          {
-            // nothing to do
-          });
+                               Errors error = Storage_parseName(&storageSpecifier,storageName);
+                               if (error == ERROR_NONE)
+                               {
+                                 // find in stored storage files
+                                 if (!Dictionary_contains(&createInfo->storageFileDictionary,
+                                                          String_cString(storageSpecifier.archiveName),
+                                                          String_length(storageSpecifier.archiveName)
+                                                         )
+                                    )
+                                 {
+                                   (void)Storage_delete(&createInfo->storageInfo,storageName);
+                                 }
+                               }
 
-          // delete old indizes for same storage file
-          error = IndexStorage_purgeAllByName(createInfo->indexHandle,
-                                              &createInfo->storageInfo.storageSpecifier,
-                                              storageMsg.archiveName,
-                                              storageMsg.storageId,
-                                              NULL  // progressInfo
-                                             );
-          if (error != ERROR_NONE)
-          {
-            if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+                               // free resources
+                               Storage_doneSpecifier(&storageSpecifier);
 
-            printInfo(1,"FAIL\n");
-            printError(_("cannot delete old index for storage '%s' (error: %s)!"),
-                       String_cString(printableStorageName),
-                       Error_getText(error)
-                      );
+                               return error;
+                             },NULL),
+                             CALLBACK_(NULL,NULL)
+                            );
+      }
+      String_delete(pattern);
+    }
+  }
 
-            AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-            break;
-          }
+  // free resoures
+  AutoFree_done(&autoFreeList);
 
-          // append storage to existing entity which has the same storage directory
-          if (createInfo->storageInfo.jobOptions->archiveFileMode == ARCHIVE_FILE_MODE_APPEND)
-          {
-            Storage_getPrintableName(printableStorageName,&createInfo->storageInfo.storageSpecifier,storageMsg.archiveName);
+  createInfo->storageThreadExitFlag = TRUE;
+}
 
-            // find matching entity and assign storage to entity
-            File_getDirectoryName(directoryPath,storageMsg.archiveName);
-            IndexQueryHandle indexQueryHandle;
-            error = IndexStorage_initList(&indexQueryHandle,
-                                          createInfo->indexHandle,
-                                          storageMsg.uuidId,
-                                          INDEX_ID_ANY, // entityId
-                                          NULL,  // jobUUID
-                                          NULL,  // entityUUID
-                                          NULL,  // indexIds
-                                          0,  // indexIdCount
-                                          INDEX_TYPESET_ALL,
-                                          INDEX_STATE_SET_ALL,
-                                          INDEX_MODE_SET_ALL,
-                                          NULL,  // hostName
-                                          NULL,  // userName
-                                          NULL,  // name,
-                                          INDEX_STORAGE_SORT_MODE_NONE,
-                                          DATABASE_ORDERING_NONE,
-                                          0LL,  // offset
-                                          INDEX_UNLIMITED
-                                         );
-            if (error != ERROR_NONE)
-            {
-              if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+/***********************************************************************\
+* Name   : fragmentInit
+* Purpose: init fragment
+* Input  : createInfo    - create info structure
+*          name          - name of entry
+*          size          - total size of entry [bytes] or 0
+*          fragmentCount - fragment count
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
 
-              AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-              break;
-            }
-            IndexId existingEntityId;
-            IndexId existingStorageId;
-            while (IndexStorage_getNext(&indexQueryHandle,
-                                        NULL,  // uuidId
-                                        NULL,  // jobUUID
-                                        &existingEntityId,
-                                        NULL,  // entityUUID
-                                        NULL,  // hostName
-                                        NULL,  // userName
-                                        NULL,  // comment
-                                        NULL,  // createdDateTime
-                                        NULL,  // archiveType
-                                        &existingStorageId,
-                                        existingStorageName,
-                                        NULL,  // createdDateTime
-                                        NULL,  // size
-                                        NULL,  // indexState
-                                        NULL,  // indexMode
-                                        NULL,  // lastCheckedDateTime
-                                        NULL,  // errorMessage
-                                        NULL,  // totalEntryCount
-                                        NULL  // totalEntrySize
-                                       )
-                  )
-            {
-              File_getDirectoryName(existingDirectoryName,existingStorageName);
-              if (   !INDEX_ID_EQUALS(storageId,existingStorageId)
-                  && (Storage_parseName(&existingStorageSpecifier,existingStorageName) == ERROR_NONE)
-                  && Storage_equalSpecifiers(&existingStorageSpecifier,directoryPath,&existingStorageSpecifier,existingDirectoryName)
-                 )
-              {
-//fprintf(stderr,"%s, %d: assign to existingStorageName=%s\n",__FILE__,__LINE__,String_cString(existingStorageName));
-                error = IndexAssign_to(createInfo->indexHandle,
-                                       NULL,  // jobUUID
-                                       INDEX_ID_NONE,  // entityId
-                                       storageId,
-                                       NULL,  // jobUUID
-                                       existingEntityId,
-                                       ARCHIVE_TYPE_NONE,
-                                       INDEX_ID_NONE  // toStorageId
-                                      );
-                break;
-              }
-            }
-            Index_doneList(&indexQueryHandle);
-            if (error != ERROR_NONE)
-            {
-              if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+LOCAL void fragmentInit(CreateInfo *createInfo, ConstString name, uint64 size, uint fragmentCount)
+{
+  assert(createInfo != NULL);
+  assert(name != NULL);
+
+  STATUS_INFO_UPDATE(createInfo,name,NULL)
+  {
+    // get/create fragment node
+    FragmentNode *fragmentNode = FragmentList_find(&createInfo->runningInfoFragmentList,name);
+    if (fragmentNode == NULL)
+    {
+      fragmentNode = FragmentList_add(&createInfo->runningInfoFragmentList,name,size,NULL,0,fragmentCount);
+      if (fragmentNode == NULL)
+      {
+        HALT_INSUFFICIENT_MEMORY();
+      }
+    }
+    assert(fragmentNode != NULL);
 
-              printInfo(1,"FAIL\n");
-              printError(_("cannot delete old index for storage '%s' (error: %s)!"),
-                         String_cString(printableStorageName),
-                         Error_getText(error)
-                        );
+    // status update
+    if (   (createInfo->runningInfoCurrentFragmentNode == NULL)
+        || ((Misc_getTimestamp()-createInfo->runningInfoCurrentLastUpdateTimestamp) >= 10*US_PER_S)
+       )
+    {
+      createInfo->runningInfoCurrentFragmentNode        = fragmentNode;
+      createInfo->runningInfoCurrentLastUpdateTimestamp = Misc_getTimestamp();
 
-              AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-              break;
-            }
+      String_set(createInfo->runningInfo.progress.entry.name,name);
+      createInfo->runningInfo.progress.entry.doneSize  = FragmentList_getSize(fragmentNode);
+      createInfo->runningInfo.progress.entry.totalSize = FragmentList_getTotalSize(fragmentNode);
+    }
+    assert(createInfo->runningInfoCurrentFragmentNode != NULL);
+  }
+}
 
-            // prune entity (maybe empty now)
-            (void)IndexEntity_prune(createInfo->indexHandle,NULL,NULL,storageMsg.entityId);
-          }
-        }
+/***********************************************************************\
+* Name   : fragmentDone
+* Purpose: done fragment
+* Input  : createInfo - create info structure
+*          name       - name of entry
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
 
-        // update index storage name+size+newest entries
-        if (error == ERROR_NONE)
-        {
-          error = IndexStorage_update(createInfo->indexHandle,
-                                      storageId,
-                                      NULL,  // hostName
-                                      NULL,  // userName
-                                      printableStorageName,
-                                      0,  // createDateTime
-                                      storageSize,
-                                      NULL,  // comment
-                                      TRUE  // updateNewest
-                                     );
-        }
+LOCAL void fragmentDone(CreateInfo *createInfo, ConstString name)
+{
+  assert(createInfo != NULL);
+  assert(name != NULL);
 
-        // update storages info (aggregated values)
-        if (error == ERROR_NONE)
-        {
-          error = IndexStorage_updateInfos(createInfo->indexHandle,
-                                           storageId
-                                          );
-        }
+  SEMAPHORE_LOCKED_DO(&createInfo->runningInfoLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  {
+    // get fragment node
+    FragmentNode *fragmentNode = FragmentList_find(&createInfo->runningInfoFragmentList,name);
+    if (fragmentNode != NULL)
+    {
+      if (fragmentNode->size > 0LL)
+      {
+        // unlock
+        FragmentList_unlockNode(fragmentNode);
+      }
 
-        // set index database state and last check time stamp
-        if (error == ERROR_NONE)
+      // check if fragment complete
+      if (FragmentList_isComplete(fragmentNode))
+      {
+        if (fragmentNode == createInfo->runningInfoCurrentFragmentNode)
         {
-          error = IndexStorage_setState(createInfo->indexHandle,
-                                        storageId,
-                                        ((createInfo->failError == ERROR_NONE) && !isAborted(createInfo))
-                                          ? INDEX_STATE_OK
-                                          : INDEX_STATE_ERROR,
-                                        Misc_getCurrentDateTime(),
-                                        NULL // errorMessage
-                                       );
+          createInfo->runningInfoCurrentFragmentNode = NULL;
         }
-        if (error != ERROR_NONE)
-        {
-          if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
 
-          printInfo(1,"FAIL\n");
-          printError(_("cannot update index for storage '%s' (error: %s)!"),
-                     String_cString(printableStorageName),
-                     Error_getText(error)
-                    );
+        FragmentList_discard(&createInfo->runningInfoFragmentList,fragmentNode);
+      }
+    }
+  }
+}
 
-          AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-          break;
-        }
-        DEBUG_TESTCODE() { createInfo->failError = DEBUG_TESTCODE_ERROR(); AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE); continue; }
+/***********************************************************************\
+* Name   : updateFragmentProgress
+* Purpose: update fragment and running info with stored data
+* Input  : createInfo - create info structure
+*          name       - name of entry
+*          offset     - offset of stored data [bytes]
+*          length     - length of stored data [bytes]
+* Output : -
+* Return : -
+* Notes  : done size is counted separately with progress counters
+\***********************************************************************/
 
-        AUTOFREE_REMOVE(&autoFreeList,&storageMsg.storageId);
-      }
+LOCAL void updateFragmentProgress(CreateInfo *createInfo, ConstString name, uint64 offset, uint64 length)
+{
+  assert(createInfo != NULL);
+  assert(name != NULL);
 
-      // done
-      logMessage(createInfo->logHandle,
-                 LOG_TYPE_STORAGE,
-                 "%s '%s' (%"PRIu64" bytes)",
-                 appendFlag ? "Appended to" : "Stored",
-                 String_cString(printableStorageName),
-                 storageSize
-                );
+  // get current archive size
+  uint64 archiveSize = Archive_getSize(&createInfo->archiveHandle);
 
-      // post-process
-      error = Storage_postProcess(&createInfo->storageInfo,storageMsg.archiveName,createInfo->createdDateTime,FALSE);
-      if (error != ERROR_NONE)
-      {
-        printError(_("cannot post-process storage file '%s' (error: %s)!"),
-                   String_cString(printableStorageName),
-                   Error_getText(error)
-                  );
-        if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
+  FragmentNode *fragmentNode;
+  STATUS_INFO_UPDATE(createInfo,name,&fragmentNode)
+  {
+    if (fragmentNode != NULL)
+    {
+      // add fragment
+      FragmentList_addRange(fragmentNode,offset,length);
 
-        AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE);
-        break;
+      // update running info
+      if (fragmentNode == createInfo->runningInfoCurrentFragmentNode)
+      {
+        createInfo->runningInfo.progress.entry.doneSize   = FragmentList_getSize(createInfo->runningInfoCurrentFragmentNode);
+        createInfo->runningInfo.progress.entry.totalSize  = FragmentList_getTotalSize(createInfo->runningInfoCurrentFragmentNode);
       }
-      DEBUG_TESTCODE() { createInfo->failError = DEBUG_TESTCODE_ERROR(); AutoFree_restore(&autoFreeList,autoFreeSavePoint,TRUE); continue; }
+    }
+    createInfo->runningInfo.progress.archiveSize      = archiveSize+createInfo->runningInfo.progress.storage.totalSize;
+    createInfo->runningInfo.progress.compressionRatio = (!createInfo->jobOptions->dryRun && (ProgressCounters_getDoneSize(&createInfo->progressCounters) > 0))
+                                                          ? 100.0-(archiveSize*100.0)/ProgressCounters_getDoneSize(&createInfo->progressCounters)
+                                                          : 0.0;
+  }
+}
 
-      // delete temporary storage file
-      error = File_delete(storageMsg.intermediateFileName,FALSE);
-      if (error != ERROR_NONE)
+/***********************************************************************\
+* Name   : fragmentAddHoles
+* Purpose: add holes to fragment
+* Input  : createInfo   - create info structure
+*          name         - name of entry
+*          fileHoleList - hole list
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void fragmentAddHoles(CreateInfo *createInfo, ConstString name, const FileHoleList *fileHoleList)
+{
+  assert(createInfo != NULL);
+  assert(name != NULL);
+  assert(fileHoleList != NULL);
+
+  if (!List_isEmpty(fileHoleList))
+  {
+    const FileHoleNode *fileHoleNode;
+    LIST_ITERATE(fileHoleList,fileHoleNode)
+    {
+      ProgressCounters_addDone(&createInfo->progressCounters,0L,fileHoleNode->size);
+    }
+
+    FragmentNode *fragmentNode;
+    STATUS_INFO_UPDATE(createInfo,name,&fragmentNode)
+    {
+      if (fragmentNode != NULL)
       {
-        printWarning(_("cannot delete file '%s' (error: %s)!"),
-                     String_cString(storageMsg.intermediateFileName),
-                     Error_getText(error)
-                    );
+        LIST_ITERATE(fileHoleList,fileHoleNode)
+        {
+          FragmentList_addRange(fragmentNode,fileHoleNode->offset,fileHoleNode->size);
+        }
       }
+    }
+  }
+}
+
+/***********************************************************************\
+* Name   : getArchiveEntryName
+* Purpose: transform archive entry name
+* Input  : archiveEntryName - archive entry name variable
+*          name             - name to transform
+* Output : -
+* Return : archive entry name
+* Notes  : -
+\***********************************************************************/
+
+LOCAL String getArchiveEntryName(String archiveEntryName, ConstString name)
+{
+  assert(archiveEntryName != NULL);
+  assert(name != NULL);
+
+  if (!String_isEmpty(globalOptions.transform.patternString))
+  {
+    // transform name with matching pattern
+    String_clear(archiveEntryName);
+    Pattern pattern;
+    Pattern_init(&pattern,globalOptions.transform.patternString,globalOptions.transform.patternType,PATTERN_FLAG_NONE);
+    ulong   index = STRING_BEGIN;
+    ulong   matchIndex,matchLength;
+    while (Pattern_match(&pattern,name,index,PATTERN_MATCH_MODE_ANY,&matchIndex,&matchLength))
+    {
+      String_appendBuffer(archiveEntryName,String_cString(name)+index,matchIndex-index);
+      String_append(archiveEntryName,globalOptions.transform.replace);
+      index = matchIndex+matchLength;
+    }
+    Pattern_done(&pattern);
+    String_appendCString(archiveEntryName,String_cString(name)+index);
+  }
+  else
+  {
+    // keep name
+    String_set(archiveEntryName,name);
+  }
+
+  return archiveEntryName;
+}
+
+/***********************************************************************\
+* Name   : getArchiveEntryNameList
+* Purpose: transform archive entry name list
+* Input  : archiveEntryNameList - archive entry name list variable
+*          nameList             - name list to transform
+* Output : archiveEntryNameList - archive entry name list
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void getArchiveEntryNameList(StringList *archiveEntryNameList, const StringList *nameList)
+{
+  assert(archiveEntryNameList != NULL);
+
+  String archiveEntryName = String_new();
+  ConstString name;
+  STRINGLIST_ITERATE(nameList,name)
+  {
+    StringList_append(archiveEntryNameList,getArchiveEntryName(archiveEntryName,name));
+  }
+  String_delete(archiveEntryName);
+}
+
+/***********************************************************************\
+* Name   : isSolidFile
+* Purpose: check if file data should be stored in a solid block
+* Input  : createInfo     - create info structure
+*          fileName       - file name
+*          fileInfo       - file info
+*          fragmentOffset - fragment offset [bytes]
+*          fragmentSize   - fragment size [bytes]
+* Output : -
+* Return : TRUE iff file should be stored in solid block
+* Notes  : -
+\***********************************************************************/
 
-      // add to list of stored archive files
-      StringList_append(&createInfo->storageFileList,storageMsg.archiveName);
+LOCAL bool isSolidFile(const CreateInfo *createInfo,
+                       ConstString      fileName,
+                       const FileInfo   *fileInfo,
+                       uint64           fragmentOffset,
+                       uint64           fragmentSize
+                      )
+{
+  assert(createInfo != NULL);
+  assert(createInfo->jobOptions != NULL);
+  assert(fileName != NULL);
+  assert(fileInfo != NULL);
+
+  return    (globalOptions.solidBlockSize > 0LL)
+         && (fileInfo->size <= SOLID_MAX_FILE_SIZE)
+         && (fragmentOffset == 0LL)
+         && (fragmentSize == fileInfo->size)
+         && !Compress_isCompressed(createInfo->jobOptions->compressAlgorithms.delta)
+         && !PatternList_match(&createInfo->jobOptions->compressExcludePatternList,fileName,PATTERN_MATCH_MODE_EXACT);
+}
 
-      // update storage info
-      storageInfoDecrement(createInfo,storageMsg.intermediateFileSize);
-    }
+/***********************************************************************\
+* Name   : closeSolidBlock
+* Purpose: close solid block
+* Input  : solidBlock - solid block
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
 
-    // free resources
-    freeStorageMsg(&storageMsg,NULL);
+LOCAL Errors closeSolidBlock(SolidBlock *solidBlock)
+{
+  Errors error;
 
-    AutoFree_restore(&autoFreeList,autoFreeSavePoint,FALSE);
-  }
+  assert(solidBlock != NULL);
 
-  // discard unprocessed archives
-  StorageMsg storageMsg;
-  while (MsgQueue_get(&createInfo->storageMsgQueue,&storageMsg,NULL,sizeof(storageMsg),NO_WAIT))
+  error = ERROR_NONE;
+  if (solidBlock->openFlag)
   {
-    // discard index
-    if (!INDEX_ID_IS_NONE(storageMsg.storageId))
+    error = Archive_closeEntry(&solidBlock->archiveEntryInfo);
+    if (error != ERROR_NONE)
     {
-      (void)IndexStorage_purge(createInfo->indexHandle,
-                               storageMsg.storageId,
-                               NULL  // progressInfo
-                              );
+      printError(_("cannot close archive solid entry (error: %s)!"),
+                 Error_getText(error)
+                );
     }
+    solidBlock->openFlag = FALSE;
+  }
+
+  return error;
+}
+
+/***********************************************************************\
+* Name   : storeSolidFileData
+* Purpose: store file data into solid block
+* Input  : createInfo                - create info structure
+*          solidBlock                - solid block
+*          fileName                  - file name
+*          fileInfo                  - file info
+*          fileExtendedAttributeList - file extended attribute list
+*          fileHandle                - file handle
+*          buffer                    - buffer for temporary data
+*          bufferSize                - size of data buffer
+*          cryptHash                 - content hash to update with
+*                                      stored data or NULL
+* Output : storedSize - number of stored bytes
+* Return : ERROR_NONE or error code
+* Notes  : solid block is opened if required and closed when max.
+*          solid block size is reached
+\***********************************************************************/
+
+LOCAL Errors storeSolidFileData(CreateInfo                      *createInfo,
+                                SolidBlock                      *solidBlock,
+                                ConstString                     fileName,
+                                const FileInfo                  *fileInfo,
+                                const FileExtendedAttributeList *fileExtendedAttributeList,
+                                FileHandle                      *fileHandle,
+                                byte                            *buffer,
+                                uint                            bufferSize,
+                                CryptHash                       *cryptHash,
+                                uint64                          *storedSize
+                               )
+{
+  Errors error;
+
+  assert(createInfo != NULL);
+  assert(createInfo->jobOptions != NULL);
+  assert(solidBlock != NULL);
+  assert(fileName != NULL);
+  assert(fileInfo != NULL);
+  assert(fileHandle != NULL);
+  assert(buffer != NULL);
+  assert(storedSize != NULL);
 
-    // delete temporary storage file
-    Errors error = File_delete(storageMsg.intermediateFileName,FALSE);
+  // open solid block
+  if (!solidBlock->openFlag)
+  {
+    error = Archive_newSolidEntry(&solidBlock->archiveEntryInfo,
+                                  &createInfo->archiveHandle,
+                                  createInfo->jobOptions->compressAlgorithms.byte,
+                                  createInfo->jobOptions->cryptAlgorithms[0],
+                                  NULL,  // cryptSalt
+                                  NULL  // cryptKey
+                                 );
     if (error != ERROR_NONE)
     {
-      printWarning(_("cannot delete file '%s' (error: %s)!"),
-                   String_cString(storageMsg.intermediateFileName),
-                   Error_getText(error)
-                  );
+      return error;
     }
-
-    // free resources
-    freeStorageMsg(&storageMsg,NULL);
+    solidBlock->openFlag = TRUE;
   }
 
-  // final storage post-processing
-  if (   (createInfo->failError == ERROR_NONE)
-      && !createInfo->jobOptions->dryRun
-     )
+  // add file to solid block
+  String archiveEntryName = getArchiveEntryName(String_new(),fileName);
+  Archive_addSolidEntryFile(&solidBlock->archiveEntryInfo,
+                            archiveEntryName,
+                            fileInfo,
+                            fileExtendedAttributeList
+                           );
+  String_delete(archiveEntryName);
+
+  // write file content to solid block
+  uint64 offset            = 0LL;
+  uint64 size              = fileInfo->size;
+  uint64 progressOffset    = offset;
+  uint64 progressTimestamp = Misc_getTimestamp();
+  error = ERROR_NONE;
+  while (   (createInfo->failError == ERROR_NONE)
+         && !isAborted(createInfo)
+         && (error == ERROR_NONE)
+         && (size > 0LL)
+        )
   {
     // pause
     Storage_pause(&createInfo->storageInfo);
 
-    // post-processing
-    if (!isAborted(createInfo))
+    // read file data
+    ulong bufferLength;
+    error = File_read(fileHandle,buffer,MIN(size,bufferSize),&bufferLength);
+    if (error != ERROR_NONE)
     {
-      Errors error = Storage_postProcess(&createInfo->storageInfo,NULL,createInfo->createdDateTime,TRUE);
-      if (error != ERROR_NONE)
-      {
-        printError(_("cannot post-process storage (error: %s)!"),
-                   Error_getText(error)
-                  );
-        if (createInfo->failError == ERROR_NONE) createInfo->failError = error;
-      }
+      logMessage(createInfo->logHandle,
+                 LOG_TYPE_ERROR,
+                 "Read file failed '%s' (error: %s)",
+                 String_cString(fileName),
+                 Error_getText(error)
+                );
+      break;
     }
-  }
-
-//TODO: required?
-  // delete old storage files if no database
-  if (   (createInfo->failError == ERROR_NONE)
-      && !isAborted(createInfo)
-      && (createInfo->indexHandle == NULL)
-     )
-  {
-    if (globalOptions.deleteOldArchiveFilesFlag)
+    if (bufferLength <= 0L)
     {
-      // get archive name pattern (expand macros)
-      String pattern = String_new();
-      Errors error = Archive_formatName(pattern,
-                                        createInfo->storageInfo.storageSpecifier.archiveName,
-                                        EXPAND_MACRO_MODE_PATTERN,
-                                        createInfo->archiveType,
-                                        createInfo->scheduleTitle,
-                                        createInfo->customText,
-                                        createInfo->createdDateTime,
-                                        ARCHIVE_PART_NUMBER_NONE
-                                       );
-      if (error == ERROR_NONE)
-      {
-        // delete all matching storage files which are unknown
-        (void)Storage_forAll(&createInfo->storageInfo.storageSpecifier,
-                             NULL,  // directory
-                             String_cString(pattern),
-                             TRUE,  // skipUnreadableFlag
-                             CALLBACK_INLINE(Errors,(ConstString storageName, const FileInfo *fileInfo, void *userData),
-                             {
-                               UNUSED_VARIABLE(fileInfo);
-                               UNUSED_VARIABLE(userData);
+      // read nothing -> file size changed -> done
+      break;
+    }
 
-                               // init variables
-                               StorageSpecifier storageSpecifier;
-                               Storage_initSpecifier(&storageSpecifier);
+    // write data to solid block
+    error = Archive_writeData(&solidBlock->archiveEntryInfo,buffer,bufferLength,1);
+    if (error != ERROR_NONE)
+    {
+      logMessage(createInfo->logHandle,
+                 LOG_TYPE_ERROR,
+                 "Write archive failed (error: %s)",
+                 Error_getText(error)
+                );
+      break;
+    }
 
-                               Errors error = Storage_parseName(&storageSpecifier,storageName);
-                               if (error == ERROR_NONE)
-                               {
-                                 // find in storage list
-                                 if (StringList_find(&createInfo->storageFileList,storageSpecifier.archiveName) == NULL)
-                                 {
-                                   (void)Storage_delete(&createInfo->storageInfo,storageName);
-                                 }
-                               }
+    if (cryptHash != NULL)
+    {
+      Crypt_updateHash(cryptHash,buffer,bufferLength);
+    }
 
-                               // free resources
-                               Storage_doneSpecifier(&storageSpecifier);
+    ProgressCounters_addDone(&createInfo->progressCounters,0L,(uint64)bufferLength);
+    offset += bufferLength;
 
-                               return error;
-                             },NULL),
-                             CALLBACK_(NULL,NULL)
-                            );
-      }
-      String_delete(pattern);
+    // update running info from time to time
+    if (Misc_getTimestamp() >= (progressTimestamp+RUNNING_INFO_UPDATE_INTERVAL*US_PER_MS))
+    {
+      updateFragmentProgress(createInfo,fileName,progressOffset,offset-progressOffset);
+      progressOffset    = offset;
+      progressTimestamp = Misc_getTimestamp();
     }
+
+    assert(size >= bufferLength);
+    size -= bufferLength;
+  }
+  if (offset > progressOffset)
+  {
+    updateFragmentProgress(createInfo,fileName,progressOffset,offset-progressOffset);
   }
+  (*storedSize) = offset;
 
-  // free resoures
-  Storage_doneSpecifier(&existingStorageSpecifier);
-  String_delete(existingDirectoryName);
-  String_delete(existingStorageName);
-  String_delete(directoryPath);
-  String_delete(printableStorageName);
-  free(buffer);
-  AutoFree_done(&autoFreeList);
+  // close solid block if max. size is reached (Note: solid blocks are not split, thus limit size to archive part size)
+  uint64 maxSolidBlockSize = globalOptions.solidBlockSize;
+  if (createInfo->jobOptions->archivePartSize > 0LL)
+  {
+    maxSolidBlockSize = MIN(maxSolidBlockSize,createInfo->jobOptions->archivePartSize);
+  }
+  if (   (error == ERROR_NONE)
+      && (Archive_getSolidEntrySize(&solidBlock->archiveEntryInfo) >= maxSolidBlockSize)
+     )
+  {
+    error = closeSolidBlock(solidBlock);
+  }
 
-  createInfo->storageThreadExitFlag = TRUE;
+  return error;
 }
 
 /***********************************************************************\
-* Name   : fragmentInit
-* Purpose: init fragment
-* Input  : createInfo    - create info structure
-*          name          - name of entry
-*          size          - total size of entry [bytes] or 0
-*          fragmentCount - fragment count
+* Name   : isDeduplicateFile
+* Purpose: check if file can be deduplicated
+* Input  : createInfo     - create info structure
+*          fileInfo       - file info
+*          fragmentOffset - fragment offset [bytes]
+*          fragmentSize   - fragment size [bytes]
 * Output : -
-* Return : -
-* Notes  : -
+* Return : TRUE iff file content hash should be checked for duplicates
+* Notes  : only complete files are deduplicated
 \***********************************************************************/
 
-LOCAL void fragmentInit(CreateInfo *createInfo, ConstString name, uint64 size, uint fragmentCount)
+LOCAL bool isDeduplicateFile(const CreateInfo *createInfo,
+                             const FileInfo   *fileInfo,
+                             uint64           fragmentOffset,
+                             uint64           fragmentSize
+                            )
 {
   assert(createInfo != NULL);
-  assert(name != NULL);
-
-  STATUS_INFO_UPDATE(createInfo,name,NULL)
-  {
-    // get/create fragment node
-    FragmentNode *fragmentNode = FragmentList_find(&createInfo->runningInfoFragmentList,name);
-    if (fragmentNode == NULL)
-    {
-      fragmentNode = FragmentList_add(&createInfo->runningInfoFragmentList,name,size,NULL,0,fragmentCount);
-      if (fragmentNode == NULL)
-      {
-        HALT_INSUFFICIENT_MEMORY();
-      }
-    }
-    assert(fragmentNode != NULL);
+  assert(createInfo->jobOptions != NULL);
+  assert(fileInfo != NULL);
 
-    // status update
-    if (   (createInfo->runningInfoCurrentFragmentNode == NULL)
-        || ((Misc_getTimestamp()-createInfo->runningInfoCurrentLastUpdateTimestamp) >= 10*US_PER_S)
-       )
-    {
-      createInfo->runningInfoCurrentFragmentNode        = fragmentNode;
-      createInfo->runningInfoCurrentLastUpdateTimestamp = Misc_getTimestamp();
+  UNUSED_VARIABLE(createInfo);
 
-      String_set(createInfo->runningInfo.progress.entry.name,name);
-      createInfo->runningInfo.progress.entry.doneSize  = FragmentList_getSize(fragmentNode);
-      createInfo->runningInfo.progress.entry.totalSize = FragmentList_getTotalSize(fragmentNode);
-    }
-    assert(createInfo->runningInfoCurrentFragmentNode != NULL);
-  }
+  return    globalOptions.deduplicateFlag
+         && (fileInfo->size > 0LL)
+         && (fragmentOffset == 0LL)
+         && (fragmentSize == fileInfo->size);
 }
 
 /***********************************************************************\
-* Name   : fragmentDone
-* Purpose: done fragment
-* Input  : createInfo - create info structure
-*          name       - name of entry
-* Output : -
-* Return : -
-* Notes  : -
+* Name   : getDeduplicateKey
+* Purpose: get content hash of file before storing it
+* Input  : deduplicateKey - deduplicate key variable
+*          createInfo     - create info structure
+*          fileHandle     - file handle
+*          size           - file size [bytes]
+*          buffer         - buffer for temporary data
+*          bufferSize     - size of data buffer
+* Output : deduplicateKey - deduplicate key
+*          validFlag      - TRUE iff content hash of complete file
+*                           calculated
+* Return : ERROR_NONE or error code
+* Notes  : file position is reset to the beginning of the file; only
+*          used for files with the size of an already stored file, the
+*          key of a stored file is calculated while storing it
 \***********************************************************************/
 
-LOCAL void fragmentDone(CreateInfo *createInfo, ConstString name)
+LOCAL Errors getDeduplicateKey(DeduplicateKey   *deduplicateKey,
+                               bool             *validFlag,
+                               const CreateInfo *createInfo,
+                               FileHandle       *fileHandle,
+                               uint64           size,
+                               byte             *buffer,
+                               uint             bufferSize
+                              )
 {
+  Errors error;
+
+  assert(deduplicateKey != NULL);
+  assert(validFlag != NULL);
   assert(createInfo != NULL);
-  assert(name != NULL);
+  assert(fileHandle != NULL);
+  assert(buffer != NULL);
 
-  SEMAPHORE_LOCKED_DO(&createInfo->runningInfoLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  (*validFlag) = FALSE;
+
+  CryptHash cryptHash;
+  if (Crypt_initHash(&cryptHash,DEDUPLICATE_HASH_ALGORITHM) != ERROR_NONE)
   {
-    // get fragment node
-    FragmentNode *fragmentNode = FragmentList_find(&createInfo->runningInfoFragmentList,name);
-    if (fragmentNode != NULL)
-    {
-      if (fragmentNode->size > 0LL)
-      {
-        // unlock
-        FragmentList_unlockNode(fragmentNode);
-      }
+    // hash not available -> do not deduplicate
+    return ERROR_NONE;
+  }
+  assert(Crypt_getHashLength(&cryptHash) == DEDUPLICATE_HASH_LENGTH);
 
-      // check if fragment complete
-      if (FragmentList_isComplete(fragmentNode))
+  // calculate hash of file content
+  error = ERROR_NONE;
+  uint64 length = 0LL;
+  while (   (error == ERROR_NONE)
+         && !isAborted(createInfo)
+         && (length < size)
+        )
+  {
+    ulong bufferLength;
+    error = File_read(fileHandle,buffer,MIN(size-length,bufferSize),&bufferLength);
+    if (error == ERROR_NONE)
+    {
+      if (bufferLength == 0L)
       {
-        if (fragmentNode == createInfo->runningInfoCurrentFragmentNode)
-        {
-          createInfo->runningInfoCurrentFragmentNode = NULL;
-        }
-
-        FragmentList_discard(&createInfo->runningInfoFragmentList,fragmentNode);
+        // read nothing -> file size changed -> do not deduplicate
+        break;
       }
+      Crypt_updateHash(&cryptHash,buffer,bufferLength);
+      length += (uint64)bufferLength;
     }
   }
+  if ((error == ERROR_NONE) && (length == size))
+  {
+    deduplicateKey->size = size;
+    Crypt_getHash(&cryptHash,deduplicateKey->hash,sizeof(deduplicateKey->hash),NULL);
+    (*validFlag) = TRUE;
+  }
+  Crypt_doneHash(&cryptHash);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  // rewind file
+  return File_seek(fileHandle,0LL);
 }
 
 /***********************************************************************\
-* Name   : getArchiveEntryName
-* Purpose: transform archive entry name
-* Input  : archiveEntryName - archive entry name variable
-*          name             - name to transform
+* Name   : isDeduplicateSize
+* Purpose: check if file with same size is already stored
+* Input  : createInfo - create info structure
+*          size       - file size [bytes]
 * Output : -
-* Return : archive entry name
+* Return : TRUE iff file with same size is already stored
 * Notes  : -
 \***********************************************************************/
 
-LOCAL String getArchiveEntryName(String archiveEntryName, ConstString name)
+LOCAL bool isDeduplicateSize(CreateInfo *createInfo, uint64 size)
 {
-  assert(archiveEntryName != NULL);
-  assert(name != NULL);
+  assert(createInfo != NULL);
 
-  if (!String_isEmpty(globalOptions.transform.patternString))
+  bool sizeFlag = FALSE;
+  SEMAPHORE_LOCKED_DO(&createInfo->deduplicateLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
   {
-    // transform name with matching pattern
-    String_clear(archiveEntryName);
-    Pattern pattern;
-    Pattern_init(&pattern,globalOptions.transform.patternString,globalOptions.transform.patternType,PATTERN_FLAG_NONE);
-    ulong   index = STRING_BEGIN;
-    ulong   matchIndex,matchLength;
-    while (Pattern_match(&pattern,name,index,PATTERN_MATCH_MODE_ANY,&matchIndex,&matchLength))
-    {
-      String_appendBuffer(archiveEntryName,String_cString(name)+index,matchIndex-index);
-      String_append(archiveEntryName,globalOptions.transform.replace);
-      index = matchIndex+matchLength;
-    }
-    Pattern_done(&pattern);
-    String_appendCString(archiveEntryName,String_cString(name)+index);
+    sizeFlag = Dictionary_contains(&createInfo->deduplicateSizeDictionary,&size,sizeof(size));
   }
-  else
+
+  return sizeFlag;
+}
+
+/***********************************************************************\
+* Name   : isDuplicateFile
+* Purpose: check if file with identical content is already stored
+* Input  : createInfo     - create info structure
+*          deduplicateKey - deduplicate key
+* Output : -
+* Return : TRUE iff file with identical content is already stored
+* Notes  : -
+\***********************************************************************/
+
+LOCAL bool isDuplicateFile(CreateInfo *createInfo, const DeduplicateKey *deduplicateKey)
+{
+  assert(createInfo != NULL);
+  assert(deduplicateKey != NULL);
+
+  bool duplicateFlag = FALSE;
+  SEMAPHORE_LOCKED_DO(&createInfo->deduplicateLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
   {
-    // keep name
-    String_set(archiveEntryName,name);
+    duplicateFlag = Dictionary_contains(&createInfo->deduplicateDictionary,deduplicateKey,sizeof(DeduplicateKey));
   }
 
-  return archiveEntryName;
+  return duplicateFlag;
 }
 
 /***********************************************************************\
-* Name   : getArchiveEntryNameList
-* Purpose: transform archive entry name list
-* Input  : archiveEntryNameList - archive entry name list variable
-*          nameList             - name list to transform
-* Output : archiveEntryNameList - archive entry name list
+* Name   : addDeduplicateFile
+* Purpose: add stored file to deduplicate dictionary
+* Input  : createInfo     - create info structure
+*          deduplicateKey - deduplicate key
+*          fileName       - file name
+* Output : -
 * Return : -
-* Notes  : -
+* Notes  : call only when the file data is completely stored; the key
+*          must be the content hash of the stored data
 \***********************************************************************/
 
-LOCAL void getArchiveEntryNameList(StringList *archiveEntryNameList, const StringList *nameList)
+LOCAL void addDeduplicateFile(CreateInfo           *createInfo,
+                              const DeduplicateKey *deduplicateKey,
+                              ConstString          fileName
+                             )
 {
-  assert(archiveEntryNameList != NULL);
+  assert(createInfo != NULL);
+  assert(deduplicateKey != NULL);
+  assert(fileName != NULL);
 
-  String archiveEntryName = String_new();
-  ConstString name;
-  STRINGLIST_ITERATE(nameList,name)
+  String archiveEntryName = getArchiveEntryName(String_new(),fileName);
+  SEMAPHORE_LOCKED_DO(&createInfo->deduplicateLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
   {
-    StringList_append(archiveEntryNameList,getArchiveEntryName(archiveEntryName,name));
+    // Note: keep first stored file
+    if (!Dictionary_contains(&createInfo->deduplicateDictionary,deduplicateKey,sizeof(DeduplicateKey)))
+    {
+      Dictionary_add(&createInfo->deduplicateSizeDictionary,
+                     &deduplicateKey->size,
+                     sizeof(deduplicateKey->size),
+                     NULL,
+                     0
+                    );
+      Dictionary_add(&createInfo->deduplicateDictionary,
+                     deduplicateKey,
+                     sizeof(DeduplicateKey),
+                     String_cString(archiveEntryName),
+                     String_length(archiveEntryName)+1
+                    );
+    }
   }
   String_delete(archiveEntryName);
 }
 
+/***********************************************************************\
+* Name   : storeFileReference
+* Purpose: store file entry referencing an already stored file with
+*          identical content
+* Input  : createInfo                - create info structure
+*          deduplicateKey            - deduplicate key
+*          fileName                  - file name to store
+*          fileInfo                  - file info
+*          fileExtendedAttributeList - file extended attribute list
+*          referenceName             - referenced archive entry name
+*                                      variable
+* Output : referenceName - referenced archive entry name
+* Return : ERROR_NONE or error code
+* Notes  : no file data is stored
+\***********************************************************************/
+
+LOCAL Errors storeFileReference(CreateInfo                      *createInfo,
+                                const DeduplicateKey            *deduplicateKey,
+                                ConstString                     fileName,
+                                const FileInfo                  *fileInfo,
+                                const FileExtendedAttributeList *fileExtendedAttributeList,
+                                String                          referenceName
+                               )
+{
+  Errors error;
+
+  assert(createInfo != NULL);
+  assert(deduplicateKey != NULL);
+  assert(fileName != NULL);
+  assert(fileInfo != NULL);
+  assert(referenceName != NULL);
+
+  // get name of referenced file
+  SEMAPHORE_LOCKED_DO(&createInfo->deduplicateLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  {
+    void  *data;
+    ulong length;
+    if (Dictionary_find(&createInfo->deduplicateDictionary,
+                        deduplicateKey,
+                        sizeof(DeduplicateKey),
+                        &data,
+                        &length
+                       )
+       )
+    {
+      String_setCString(referenceName,(const char*)data);
+    }
+  }
+  assert(!String_isEmpty(referenceName));
+
+  // create new archive file entry without data
+  String           archiveEntryName = getArchiveEntryName(String_new(),fileName);
+  ArchiveEntryInfo archiveEntryInfo;
+  error = Archive_newFileEntry(&archiveEntryInfo,
+                               &createInfo->archiveHandle,
+                               COMPRESS_ALGORITHM_NONE,
+                               COMPRESS_ALGORITHM_NONE,
+                               createInfo->jobOptions->cryptAlgorithms[0],
+                               NULL,  // cryptSalt
+                               NULL,  // cryptKey
+                               archiveEntryName,
+                               fileInfo,
+                               fileExtendedAttributeList,
+                               NULL,  // fileHoleList
+                               referenceName,
+                               0LL,  // fragmentOffset
+                               0LL,  // fragmentSize
+                               ARCHIVE_FLAG_NONE
+                              );
+  String_delete(archiveEntryName);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+  error = Archive_closeEntry(&archiveEntryInfo);
+  if (error != ERROR_NONE)
+  {
+    return error;
+  }
+
+  // update running info
+  ProgressCounters_addDone(&createInfo->progressCounters,0L,fileInfo->size);
+  uint64 archiveSize = Archive_getSize(&createInfo->archiveHandle);
+  FragmentNode *fragmentNode;
+  STATUS_INFO_UPDATE(createInfo,fileName,&fragmentNode)
+  {
+    if (fragmentNode != NULL)
+    {
+      FragmentList_addRange(fragmentNode,0LL,fileInfo->size);
+    }
+    createInfo->runningInfo.progress.archiveSize      = archiveSize+createInfo->runningInfo.progress.storage.totalSize;
+    createInfo->runningInfo.progress.compressionRatio = (!createInfo->jobOptions->dryRun && (ProgressCounters_getDoneSize(&createInfo->progressCounters) > 0))
+                                                          ? 100.0-(archiveSize*100.0)/ProgressCounters_getDoneSize(&createInfo->progressCounters)
+                                                          : 0.0;
+  }
+
+  return ERROR_NONE;
+}
+
 /***********************************************************************\
 * Name   : storeFileEntry
 * Purpose: store a file entry into archive
 * Input  : createInfo     - create info structure
+*          solidBlock     - solid block for small files
 *          fileName       - file name to store
 *          fileInfo       - file info
 *          fragmentNumber - fragment number [0..n-1]
@@ -5156,6 +7690,7 @@ LOCAL void getArchiveEntryNameList(StringList *archiveEntryNameList, const Strin
 \***********************************************************************/
 
 LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
+                            SolidBlock     *solidBlock,
                             ConstString    fileName,
                             const FileInfo *fileInfo,
                             uint           fragmentNumber,
@@ -5170,6 +7705,7 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
 
   assert(createInfo != NULL);
   assert(createInfo->jobOptions != NULL);
+  assert(solidBlock != NULL);
   assert(fileName != NULL);
   assert(fileInfo != NULL);
   assert((fragmentCount == 0) || (fragmentNumber < fragmentCount));
@@ -5206,13 +7742,9 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,fileName,NULL)
-      {
-        createInfo->runningInfo.progress.skipped.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.skipped.size  += fragmentSize;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.done.size += fragmentSize;
-      }
+      ProgressCounters_addSkipped(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,fileName);
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -5226,13 +7758,9 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,fileName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.error.size += fragmentSize;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.done.size += fragmentSize;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,fileName);
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -5242,7 +7770,7 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
 
   // open file
   FileHandle fileHandle;
-  error = File_open(&fileHandle,fileName,FILE_OPEN_READ|FILE_OPEN_NO_ATIME|FILE_OPEN_NO_CACHE);
+  error = File_open(&fileHandle,fileName,FILE_OPEN_READ|FILE_OPEN_NO_ATIME|FILE_OPEN_NO_CACHE|FILE_OPEN_READ_AHEAD);
   if (error != ERROR_NONE)
   {
     if (createInfo->jobOptions->skipUnreadableFlag)
@@ -5255,13 +7783,9 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,NULL,NULL)
-      {
-        createInfo->runningInfo.progress.skipped.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.skipped.size  += fragmentSize;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.done.size  += fragmentSize;
-      }
+      ProgressCounters_addSkipped(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,NULL);
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -5275,13 +7799,9 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,fileName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.error.size  += (uint64)fileInfo->size;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.done.size  += (uint64)fileInfo->size;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,(uint64)fileInfo->size);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,(uint64)fileInfo->size);
+      updateRunningInfoNoWait(createInfo,fileName);
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -5292,11 +7812,183 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
   // init fragment
   fragmentInit(createInfo,fileName,fileInfo->size,fragmentCount);
 
-  if (!createInfo->jobOptions->noStorage)
+  // get content hash for detecting already stored files with identical content (only if a file with same size is stored)
+  DeduplicateKey deduplicateKey;
+  bool           deduplicateFlag = FALSE;
+  bool           duplicateFlag   = FALSE;
+  if (   !createInfo->jobOptions->noStorage
+      && isDeduplicateFile(createInfo,fileInfo,fragmentOffset,fragmentSize)
+     )
   {
-    uint64       offset       = 0LL;
-    uint64       size         = 0LL;
-    ArchiveFlags archiveFlags = ARCHIVE_FLAG_NONE;
+    deduplicateFlag = TRUE;
+  }
+  if (deduplicateFlag && isDeduplicateSize(createInfo,fileInfo->size))
+  {
+    bool validFlag;
+    error = getDeduplicateKey(&deduplicateKey,
+                              &validFlag,
+                              createInfo,
+                              &fileHandle,
+                              fileInfo->size,
+                              buffer,
+                              bufferSize
+                             );
+    if (error != ERROR_NONE)
+    {
+      printInfo(1,"FAIL\n");
+      printError(_("cannot read file '%s' (error: %s)"),
+                 String_cString(fileName),
+                 Error_getText(error)
+                );
+
+      ProgressCounters_addError(&createInfo->progressCounters,1,(uint64)fileInfo->size);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,(uint64)fileInfo->size);
+      updateRunningInfoNoWait(createInfo,fileName);
+
+      (void)File_close(&fileHandle);
+      fragmentDone(createInfo,fileName);
+      File_doneExtendedAttributes(&fileExtendedAttributeList);
+
+      return error;
+    }
+    duplicateFlag = validFlag && isDuplicateFile(createInfo,&deduplicateKey);
+  }
+
+  // init content hash of stored data (Note: key of a stored file is the hash of the data actually stored)
+  CryptHash deduplicateHash;
+  uint64    deduplicateHashSize = 0LL;
+  if (deduplicateFlag)
+  {
+    if (duplicateFlag || (Crypt_initHash(&deduplicateHash,DEDUPLICATE_HASH_ALGORITHM) != ERROR_NONE))
+    {
+      // content is already in deduplicate dictionary or hash not available
+      deduplicateFlag = FALSE;
+    }
+  }
+
+  if      (duplicateFlag)
+  {
+    // store reference to already stored file with identical content
+    String referenceName = String_new();
+    error = storeFileReference(createInfo,
+                               &deduplicateKey,
+                               fileName,
+                               fileInfo,
+                               &fileExtendedAttributeList,
+                               referenceName
+                              );
+    if (error != ERROR_NONE)
+    {
+      printInfo(1,"FAIL\n");
+      printError(_("cannot store file entry (error: %s)!"),
+                 Error_getText(error)
+                );
+
+      ProgressCounters_addError(&createInfo->progressCounters,1,(uint64)fileInfo->size);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,(uint64)fileInfo->size);
+      updateRunningInfoNoWait(createInfo,fileName);
+
+      String_delete(referenceName);
+      (void)File_close(&fileHandle);
+      fragmentDone(createInfo,fileName);
+      File_doneExtendedAttributes(&fileExtendedAttributeList);
+
+      return error;
+    }
+
+    if (!createInfo->jobOptions->dryRun)
+    {
+      printInfo(1,"OK (%"PRIu64" bytes, duplicate of '%s')\n",
+                fragmentSize,
+                String_cString(referenceName)
+               );
+      logMessage(createInfo->logHandle,
+                 LOG_TYPE_ENTRY_OK,
+                 "Added file '%s' (%"PRIu64" bytes, duplicate of '%s')",
+                 String_cString(fileName),
+                 fragmentSize,
+                 String_cString(referenceName)
+                );
+    }
+    else
+    {
+      printInfo(1,"OK (%"PRIu64" bytes, duplicate of '%s', dry-run)\n",
+                fragmentSize,
+                String_cString(referenceName)
+               );
+    }
+    String_delete(referenceName);
+  }
+  else if (   !createInfo->jobOptions->noStorage
+           && isSolidFile(createInfo,fileName,fileInfo,fragmentOffset,fragmentSize)
+          )
+  {
+    // store file data in solid block
+    error = storeSolidFileData(createInfo,
+                               solidBlock,
+                               fileName,
+                               fileInfo,
+                               &fileExtendedAttributeList,
+                               &fileHandle,
+                               buffer,
+                               bufferSize,
+                               deduplicateFlag ? &deduplicateHash : NULL,
+                               &deduplicateHashSize
+                              );
+    if (isAborted(createInfo))
+    {
+      printInfo(1,"ABORTED\n");
+      (void)File_close(&fileHandle);
+      fragmentDone(createInfo,fileName);
+      if (deduplicateFlag) Crypt_doneHash(&deduplicateHash);
+      File_doneExtendedAttributes(&fileExtendedAttributeList);
+      return FALSE;
+    }
+    if (error != ERROR_NONE)
+    {
+      printInfo(1,"FAIL\n");
+      printError(_("cannot store file entry (error: %s)!"),
+                 Error_getText(error)
+                );
+
+      ProgressCounters_addError(&createInfo->progressCounters,1,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,fragmentSize);
+      updateRunningInfoNoWait(createInfo,fileName);
+
+      (void)File_close(&fileHandle);
+      fragmentDone(createInfo,fileName);
+      if (deduplicateFlag) Crypt_doneHash(&deduplicateHash);
+      File_doneExtendedAttributes(&fileExtendedAttributeList);
+
+      return error;
+    }
+
+    if (!createInfo->jobOptions->dryRun)
+    {
+      printInfo(1,"OK (%"PRIu64" bytes, solid)\n",
+                fragmentSize
+               );
+      logMessage(createInfo->logHandle,
+                 LOG_TYPE_ENTRY_OK,
+                 "Added file '%s' (%"PRIu64" bytes, solid)",
+                 String_cString(fileName),
+                 fragmentSize
+                );
+    }
+    else
+    {
+      printInfo(1,"OK (%"PRIu64" bytes, solid, dry-run)\n",
+                fragmentSize
+               );
+    }
+  }
+  else if (!createInfo->jobOptions->noStorage)
+  {
+    uint64       offset            = 0LL;
+    uint64       size              = 0LL;
+    uint64       progressOffset    = 0LL;
+    uint64       progressTimestamp = 0LL;
+    ArchiveFlags archiveFlags      = ARCHIVE_FLAG_NONE;
 
     // check if file data should be delta compressed
     if (   (fileInfo->size > globalOptions.compressMinFileSize)
@@ -5314,7 +8006,28 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
        archiveFlags |= ARCHIVE_FLAG_TRY_BYTE_COMPRESS;
     }
 
-    // create new archive file entry
+    // check if byte compression should be disabled for not compressible data
+    if (globalOptions.compressAdaptiveFlag)
+    {
+       archiveFlags |= ARCHIVE_FLAG_ADAPTIVE_COMPRESS;
+    }
+
+    // get holes of sparse file (on error store all data)
+    FileHoleList fileHoleList;
+    File_initHoles(&fileHoleList);
+    if (createInfo->jobOptions->sparseFlag)
+    {
+      (void)File_getHoles(&fileHoleList,&fileHandle,fragmentOffset,fragmentSize,MIN_SPARSE_HOLE_SIZE);
+    }
+
+    // content hash is only calculated for files without holes
+    if (deduplicateFlag && !List_isEmpty(&fileHoleList))
+    {
+      Crypt_doneHash(&deduplicateHash);
+      deduplicateFlag = FALSE;
+    }
+
+    // create new archive file entry (Note: holes are stored in the entry, data of holes is not stored)
     String           archiveEntryName = getArchiveEntryName(String_new(),fileName);
     ArchiveEntryInfo archiveEntryInfo;
     error = Archive_newFileEntry(&archiveEntryInfo,
@@ -5327,6 +8040,8 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
                                  archiveEntryName,
                                  fileInfo,
                                  &fileExtendedAttributeList,
+                                 &fileHoleList,
+                                 NULL,  // referenceName
                                  fragmentOffset,
                                  fragmentSize,
                                  archiveFlags
@@ -5339,31 +8054,52 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,fileName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.error.size  += (uint64)fileInfo->size;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.done.size  += (uint64)fileInfo->size;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,fileName);
 
       String_delete(archiveEntryName);
       (void)File_close(&fileHandle);
       fragmentDone(createInfo,fileName);
+      File_doneHoles(&fileHoleList);
+      if (deduplicateFlag) Crypt_doneHash(&deduplicateHash);
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
       return error;
     }
     String_delete(archiveEntryName);
 
-    // seek to start offset
-    error = File_seek(&fileHandle,fragmentOffset);
-    if (error == ERROR_NONE)
+    // write file content to archive: data of fragment without holes
+    const FileHoleNode *fileHoleNode = fileHoleList.head;
+    bool               endOfFileFlag = FALSE;
+    offset            = fragmentOffset;
+    progressOffset    = offset;
+    progressTimestamp = Misc_getTimestamp();
+    error             = ERROR_NONE;
+    while (   (createInfo->failError == ERROR_NONE)
+           && !isAborted(createInfo)
+           && (error == ERROR_NONE)
+           && !endOfFileFlag
+           && (offset < (fragmentOffset+fragmentSize))
+          )
     {
-      // write file content to archive
-      offset = fragmentOffset;
-      size   = fragmentSize;
-      error  = ERROR_NONE;
+      // get next data, seek to data
+      uint64 dataOffset = File_getNextData(&fileHoleNode,offset,fragmentOffset+fragmentSize,&size);
+      if (dataOffset != offset)
+      {
+        if (offset > progressOffset)
+        {
+          updateFragmentProgress(createInfo,fileName,progressOffset,offset-progressOffset);
+        }
+        offset         = dataOffset;
+        progressOffset = offset;
+      }
+      if (size == 0LL)
+      {
+        break;
+      }
+      error = File_seek(&fileHandle,offset);
+
       while (   (createInfo->failError == ERROR_NONE)
              && !isAborted(createInfo)
              && (error == ERROR_NONE)
@@ -5384,31 +8120,22 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
             error = Archive_writeData(&archiveEntryInfo,buffer,bufferLength,1);
             if (error == ERROR_NONE)
             {
-              // get current archive size
-              uint64 archiveSize = Archive_getSize(&createInfo->archiveHandle);
-
-              FragmentNode *fragmentNode;
-              STATUS_INFO_UPDATE(createInfo,fileName,&fragmentNode)
+              if (deduplicateFlag)
               {
-                if (fragmentNode != NULL)
-                {
-                  // add fragment
-                  FragmentList_addRange(fragmentNode,offset,bufferLength);
-
-                  // update running info
-                  if (fragmentNode == createInfo->runningInfoCurrentFragmentNode)
-                  {
-                    createInfo->runningInfo.progress.entry.doneSize   = FragmentList_getSize(createInfo->runningInfoCurrentFragmentNode);
-                    createInfo->runningInfo.progress.entry.totalSize  = FragmentList_getTotalSize(createInfo->runningInfoCurrentFragmentNode);
-                  }
-                }
-                createInfo->runningInfo.progress.done.size        = createInfo->runningInfo.progress.done.size+(uint64)bufferLength;
-                createInfo->runningInfo.progress.archiveSize      = archiveSize+createInfo->runningInfo.progress.storage.totalSize;
-                createInfo->runningInfo.progress.compressionRatio = (!createInfo->jobOptions->dryRun && (createInfo->runningInfo.progress.done.size > 0))
-                                                                      ? 100.0-(archiveSize*100.0)/createInfo->runningInfo.progress.done.size
-                                                                      : 0.0;
+                Crypt_updateHash(&deduplicateHash,buffer,bufferLength);
+                deduplicateHashSize += (uint64)bufferLength;
               }
+
+              ProgressCounters_addDone(&createInfo->progressCounters,0L,(uint64)bufferLength);
               offset += bufferLength;
+
+              // update running info from time to time
+              if (Misc_getTimestamp() >= (progressTimestamp+RUNNING_INFO_UPDATE_INTERVAL*US_PER_MS))
+              {
+                updateFragmentProgress(createInfo,fileName,progressOffset,offset-progressOffset);
+                progressOffset    = offset;
+                progressTimestamp = Misc_getTimestamp();
+              }
             }
             else
             {
@@ -5419,8 +8146,6 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
                         );
             }
 
-
-
             if (isPrintInfo(2))
             {
               uint percentageDone = 0;
@@ -5439,7 +8164,8 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
           else
           {
             // read nothing -> file size changed -> done
-            size = 0;
+            size          = 0;
+            endOfFileFlag = TRUE;
           }
         }
         else
@@ -5449,39 +8175,43 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
                      "Read file failed '%s' (error: %s)",
                      String_cString(fileName),
                      Error_getText(error)
-                    );
-        }
-
-        // wait for temporary file space
-        waitForTemporaryFileSpace(createInfo);
-      }
-      if (isAborted(createInfo))
-      {
-        printInfo(1,"ABORTED\n");
-        (void)Archive_closeEntry(&archiveEntryInfo);
-        (void)File_close(&fileHandle);
-        fragmentDone(createInfo,fileName);
-        File_doneExtendedAttributes(&fileExtendedAttributeList);
-        return FALSE;
+                    );
+        }
+
+        // wait for temporary file space
+        waitForTemporaryFileSpace(createInfo);
       }
     }
+    if (offset > progressOffset)
+    {
+      updateFragmentProgress(createInfo,fileName,progressOffset,offset-progressOffset);
+    }
+    if (isAborted(createInfo))
+    {
+      printInfo(1,"ABORTED\n");
+      (void)Archive_closeEntry(&archiveEntryInfo);
+      (void)File_close(&fileHandle);
+      fragmentDone(createInfo,fileName);
+      File_doneHoles(&fileHoleList);
+      if (deduplicateFlag) Crypt_doneHash(&deduplicateHash);
+      File_doneExtendedAttributes(&fileExtendedAttributeList);
+      return FALSE;
+    }
     if (error != ERROR_NONE)
     {
       if (createInfo->jobOptions->skipUnreadableFlag)
       {
         printInfo(1,"skipped (reason: %s)\n",Error_getText(error));
 
-        STATUS_INFO_UPDATE(createInfo,fileName,NULL)
-        {
-          createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;;
-          createInfo->runningInfo.progress.error.size += fragmentSize;
-          createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;;
-          createInfo->runningInfo.progress.done.size += fragmentSize;
-        }
+        ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+        ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+        updateRunningInfoNoWait(createInfo,fileName);
 
         (void)Archive_closeEntry(&archiveEntryInfo);
         (void)File_close(&fileHandle);
         fragmentDone(createInfo,fileName);
+        File_doneHoles(&fileHoleList);
+        if (deduplicateFlag) Crypt_doneHash(&deduplicateHash);
         File_doneExtendedAttributes(&fileExtendedAttributeList);
 
         return ERROR_NONE;
@@ -5493,17 +8223,15 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
                    Error_getText(error)
                   );
 
-        STATUS_INFO_UPDATE(createInfo,fileName,NULL)
-        {
-          createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;;
-          createInfo->runningInfo.progress.error.size += fragmentSize;
-          createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;;
-          createInfo->runningInfo.progress.done.size += fragmentSize;
-        }
+        ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+        ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+        updateRunningInfoNoWait(createInfo,fileName);
 
         (void)Archive_closeEntry(&archiveEntryInfo);
         (void)File_close(&fileHandle);
         fragmentDone(createInfo,fileName);
+        File_doneHoles(&fileHoleList);
+        if (deduplicateFlag) Crypt_doneHash(&deduplicateHash);
         File_doneExtendedAttributes(&fileExtendedAttributeList);
 
         return error;
@@ -5520,26 +8248,31 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,fileName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;;
-        createInfo->runningInfo.progress.error.size += fragmentSize;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;;
-        createInfo->runningInfo.progress.done.size += fragmentSize;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,fileName);
 
       (void)File_close(&fileHandle);
       fragmentDone(createInfo,fileName);
+      File_doneHoles(&fileHoleList);
+      if (deduplicateFlag) Crypt_doneHash(&deduplicateHash);
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
       return error;
     }
 
+    // add holes
+    fragmentAddHoles(createInfo,fileName,&fileHoleList);
+    File_doneHoles(&fileHoleList);
+
+    uint64 storedSize   = archiveEntryInfo.file.chunkFileData.fragmentSize;
+    uint64 archivedSize = archiveEntryInfo.file.chunkFileData.info.size;
+
     // get final compression ratio
     double compressionRatio;
-    if (archiveEntryInfo.file.chunkFileData.fragmentSize > 0LL)
+    if (storedSize > 0LL)
     {
-      compressionRatio = 100.0-archiveEntryInfo.file.chunkFileData.info.size*100.0/archiveEntryInfo.file.chunkFileData.fragmentSize;
+      compressionRatio = 100.0-archivedSize*100.0/storedSize;
     }
     else
     {
@@ -5621,7 +8354,7 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
       }
       if (FragmentList_isComplete(fragmentNode))
       {
-        createInfo->runningInfo.progress.done.count++;
+        ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
       }
     }
   }
@@ -5633,6 +8366,18 @@ LOCAL Errors storeFileEntry(CreateInfo     *createInfo,
   fragmentDone(createInfo,fileName);
   File_doneExtendedAttributes(&fileExtendedAttributeList);
 
+  // add to deduplicate dictionary: key is content hash of stored data
+  if (deduplicateFlag)
+  {
+    if (deduplicateHashSize == fileInfo->size)
+    {
+      deduplicateKey.size = deduplicateHashSize;
+      Crypt_getHash(&deduplicateHash,deduplicateKey.hash,sizeof(deduplicateKey.hash),NULL);
+      addDeduplicateFile(createInfo,&deduplicateKey,fileName);
+    }
+    Crypt_doneHash(&deduplicateHash);
+  }
+
   // add to incremental list
   if (createInfo->storeIncrementalFileInfoFlag)
   {
@@ -5691,13 +8436,9 @@ LOCAL Errors storeImageEntry(CreateInfo       *createInfo,
                bufferSize
               );
 
-    STATUS_INFO_UPDATE(createInfo,deviceName,NULL)
-    {
-      createInfo->runningInfo.progress.skipped.count += (fragmentOffset == 0LL) ? 1 : 0;
-      createInfo->runningInfo.progress.skipped.size  += fragmentSize;
-      createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-      createInfo->runningInfo.progress.done.size  += fragmentSize;
-    }
+    ProgressCounters_addSkipped(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+    ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+    updateRunningInfoNoWait(createInfo,deviceName);
 
     return ERROR_INVALID_DEVICE_BLOCK_SIZE;
   }
@@ -5708,13 +8449,9 @@ LOCAL Errors storeImageEntry(CreateInfo       *createInfo,
                String_cString(deviceName)
               );
 
-    STATUS_INFO_UPDATE(createInfo,deviceName,NULL)
-    {
-      createInfo->runningInfo.progress.skipped.count += (fragmentOffset == 0LL) ? 1 : 0;
-      createInfo->runningInfo.progress.skipped.size  += fragmentSize;
-      createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-      createInfo->runningInfo.progress.done.size  += fragmentSize;
-    }
+    ProgressCounters_addSkipped(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+    ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+    updateRunningInfoNoWait(createInfo,deviceName);
 
     return ERROR_INVALID_DEVICE_BLOCK_SIZE;
   }
@@ -5736,13 +8473,9 @@ LOCAL Errors storeImageEntry(CreateInfo       *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,deviceName,NULL)
-      {
-        createInfo->runningInfo.progress.skipped.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.skipped.size  += fragmentSize;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.done.size  += fragmentSize;
-      }
+      ProgressCounters_addSkipped(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,deviceName);
 
       return ERROR_NONE;
     }
@@ -5754,13 +8487,9 @@ LOCAL Errors storeImageEntry(CreateInfo       *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,deviceName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.error.size  += fragmentSize;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.done.size  += fragmentSize;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,deviceName);
 
       return error;
     }
@@ -5793,9 +8522,11 @@ LOCAL Errors storeImageEntry(CreateInfo       *createInfo,
 
   if (!createInfo->jobOptions->noStorage)
   {
-    uint64       blockOffset  = 0LL;
-    uint64       blockCount   = 0LL;
-    ArchiveFlags archiveFlags = ARCHIVE_FLAG_NONE;
+    uint64       blockOffset         = 0LL;
+    uint64       blockCount          = 0LL;
+    uint64       progressBlockOffset = 0LL;
+    uint64       progressTimestamp   = 0LL;
+    ArchiveFlags archiveFlags        = ARCHIVE_FLAG_NONE;
 
     // check if file data should be delta compressed
     if (   (deviceInfo->size > globalOptions.compressMinFileSize)
@@ -5813,6 +8544,12 @@ LOCAL Errors storeImageEntry(CreateInfo       *createInfo,
        archiveFlags |= ARCHIVE_FLAG_TRY_BYTE_COMPRESS;
     }
 
+    // check if byte compression should be disabled for not compressible data
+    if (globalOptions.compressAdaptiveFlag)
+    {
+       archiveFlags |= ARCHIVE_FLAG_ADAPTIVE_COMPRESS;
+    }
+
     // create new archive image entry
     String           archiveEntryName = getArchiveEntryName(String_new(),deviceName);
     ArchiveEntryInfo archiveEntryInfo;
@@ -5840,13 +8577,9 @@ LOCAL Errors storeImageEntry(CreateInfo       *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,deviceName,NULL)
-      {
-        createInfo->runningInfo.progress.skipped.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.skipped.size  += fragmentSize;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.done.size  += fragmentSize;
-      }
+      ProgressCounters_addSkipped(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,deviceName);
 
       String_delete(archiveEntryName);
       if (isSupportedFileSystem) FileSystem_done(&fileSystemHandle);
@@ -5858,9 +8591,11 @@ LOCAL Errors storeImageEntry(CreateInfo       *createInfo,
     String_delete(archiveEntryName);
 
     // write device content to archive
-    blockOffset = fragmentOffset/(uint64)deviceInfo->blockSize;
-    blockCount  = (fragmentSize+(uint64)deviceInfo->blockSize-1)/(uint64)deviceInfo->blockSize;
-    error       = ERROR_NONE;
+    blockOffset         = fragmentOffset/(uint64)deviceInfo->blockSize;
+    blockCount          = (fragmentSize+(uint64)deviceInfo->blockSize-1)/(uint64)deviceInfo->blockSize;
+    progressBlockOffset = blockOffset;
+    progressTimestamp   = Misc_getTimestamp();
+    error               = ERROR_NONE;
     while (   (createInfo->failError == ERROR_NONE)
            && !isAborted(createInfo)
            && (error == ERROR_NONE)
@@ -5905,32 +8640,20 @@ LOCAL Errors storeImageEntry(CreateInfo       *createInfo,
         error = Archive_writeData(&archiveEntryInfo,buffer,bufferBlockCount*deviceInfo->blockSize,deviceInfo->blockSize);
         if (error == ERROR_NONE)
         {
-          // get current archive size
-          uint64 archiveSize = Archive_getSize(&createInfo->archiveHandle);
+          ProgressCounters_addDone(&createInfo->progressCounters,0L,(uint64)bufferBlockCount*(uint64)deviceInfo->blockSize);
+          blockOffset += (uint64)bufferBlockCount;
 
-          // update running info
-          FragmentNode *fragmentNode;
-          STATUS_INFO_UPDATE(createInfo,deviceName,&fragmentNode)
+          // update running info from time to time
+          if (Misc_getTimestamp() >= (progressTimestamp+RUNNING_INFO_UPDATE_INTERVAL*US_PER_MS))
           {
-            if (fragmentNode != NULL)
-            {
-              // add fragment
-              FragmentList_addRange(fragmentNode,blockOffset*(uint64)deviceInfo->blockSize,(uint64)bufferBlockCount*(uint64)deviceInfo->blockSize);
-
-              // update running info
-              if (fragmentNode == createInfo->runningInfoCurrentFragmentNode)
-              {
-                createInfo->runningInfo.progress.entry.doneSize   = FragmentList_getSize(createInfo->runningInfoCurrentFragmentNode);
-                createInfo->runningInfo.progress.entry.totalSize  = FragmentList_getTotalSize(createInfo->runningInfoCurrentFragmentNode);
-              }
-            }
-            createInfo->runningInfo.progress.done.size        = createInfo->runningInfo.progress.done.size+(uint64)bufferBlockCount*(uint64)deviceInfo->blockSize;
-            createInfo->runningInfo.progress.archiveSize      = archiveSize+createInfo->runningInfo.progress.storage.totalSize;
-            createInfo->runningInfo.progress.compressionRatio = (!createInfo->jobOptions->dryRun && (createInfo->runningInfo.progress.done.size > 0))
-                                                                  ? 100.0-(archiveSize*100.0)/createInfo->runningInfo.progress.done.size
-                                                                  : 0.0;
+            updateFragmentProgress(createInfo,
+                                   deviceName,
+                                   progressBlockOffset*(uint64)deviceInfo->blockSize,
+                                   (blockOffset-progressBlockOffset)*(uint64)deviceInfo->blockSize
+                                  );
+            progressBlockOffset = blockOffset;
+            progressTimestamp   = Misc_getTimestamp();
           }
-          blockOffset += (uint64)bufferBlockCount;
         }
         else
         {
@@ -5966,6 +8689,14 @@ LOCAL Errors storeImageEntry(CreateInfo       *createInfo,
       // wait for temporary file space
       waitForTemporaryFileSpace(createInfo);
     }
+    if (blockOffset > progressBlockOffset)
+    {
+      updateFragmentProgress(createInfo,
+                             deviceName,
+                             progressBlockOffset*(uint64)deviceInfo->blockSize,
+                             (blockOffset-progressBlockOffset)*(uint64)deviceInfo->blockSize
+                            );
+    }
     if (isAborted(createInfo))
     {
       printInfo(1,"ABORTED\n");
@@ -5982,13 +8713,9 @@ LOCAL Errors storeImageEntry(CreateInfo       *createInfo,
       {
         printInfo(1,"skipped (reason: %s)\n",Error_getText(error));
 
-        STATUS_INFO_UPDATE(createInfo,deviceName,NULL)
-        {
-          createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;;
-          createInfo->runningInfo.progress.error.size += fragmentSize;
-          createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;;
-          createInfo->runningInfo.progress.done.size += fragmentSize;
-        }
+        ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+        ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+        updateRunningInfoNoWait(createInfo,deviceName);
 
         (void)Archive_closeEntry(&archiveEntryInfo);
         if (isSupportedFileSystem) FileSystem_done(&fileSystemHandle);
@@ -6004,13 +8731,9 @@ LOCAL Errors storeImageEntry(CreateInfo       *createInfo,
                    Error_getText(error)
                   );
 
-        STATUS_INFO_UPDATE(createInfo,deviceName,NULL)
-        {
-          createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;;
-          createInfo->runningInfo.progress.error.size += fragmentSize;
-          createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;;
-          createInfo->runningInfo.progress.done.size += fragmentSize;
-        }
+        ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+        ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+        updateRunningInfoNoWait(createInfo,deviceName);
 
         (void)Archive_closeEntry(&archiveEntryInfo);
         if (isSupportedFileSystem) FileSystem_done(&fileSystemHandle);
@@ -6031,13 +8754,9 @@ LOCAL Errors storeImageEntry(CreateInfo       *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,deviceName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;;
-        createInfo->runningInfo.progress.error.size += fragmentSize;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;;
-        createInfo->runningInfo.progress.done.size += fragmentSize;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,deviceName);
 
       if (isSupportedFileSystem) FileSystem_done(&fileSystemHandle);
       Device_close(&deviceHandle);
@@ -6157,7 +8876,7 @@ LOCAL Errors storeImageEntry(CreateInfo       *createInfo,
 
       if (FragmentList_isComplete(fragmentNode))
       {
-        createInfo->runningInfo.progress.done.count++;
+        ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
       }
     }
   }
@@ -6228,11 +8947,9 @@ LOCAL Errors storeDirectoryEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,directoryName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count++;
-        createInfo->runningInfo.progress.done.count++;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+      updateRunningInfoNoWait(createInfo,directoryName);
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -6246,11 +8963,9 @@ LOCAL Errors storeDirectoryEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,directoryName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count++;
-        createInfo->runningInfo.progress.done.count++;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+      updateRunningInfoNoWait(createInfo,directoryName);
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -6286,11 +9001,9 @@ LOCAL Errors storeDirectoryEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,directoryName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count++;
-        createInfo->runningInfo.progress.done.count++;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+      updateRunningInfoNoWait(createInfo,directoryName);
 
       String_delete(archiveEntryName);
       File_doneExtendedAttributes(&fileExtendedAttributeList);
@@ -6308,11 +9021,9 @@ LOCAL Errors storeDirectoryEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,directoryName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count++;
-        createInfo->runningInfo.progress.done.count++;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+      updateRunningInfoNoWait(createInfo,directoryName);
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -6340,10 +9051,8 @@ LOCAL Errors storeDirectoryEntry(CreateInfo     *createInfo,
   }
 
   // update running info
-  STATUS_INFO_UPDATE(createInfo,directoryName,NULL)
-  {
-    createInfo->runningInfo.progress.done.count++;
-  }
+  ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+  updateRunningInfoNoWait(createInfo,directoryName);
 
   // free resources
   File_doneExtendedAttributes(&fileExtendedAttributeList);
@@ -6411,11 +9120,9 @@ LOCAL Errors storeLinkEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,linkName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count++;
-        createInfo->runningInfo.progress.done.count++;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+      updateRunningInfoNoWait(createInfo,linkName);
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -6429,11 +9136,9 @@ LOCAL Errors storeLinkEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,linkName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count++;
-        createInfo->runningInfo.progress.done.count++;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+      updateRunningInfoNoWait(createInfo,linkName);
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -6458,11 +9163,9 @@ LOCAL Errors storeLinkEntry(CreateInfo     *createInfo,
                    Error_getText(error)
                   );
 
-        STATUS_INFO_UPDATE(createInfo,linkName,NULL)
-        {
-          createInfo->runningInfo.progress.error.count++;
-          createInfo->runningInfo.progress.done.count++;
-        }
+        ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+        ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+        updateRunningInfoNoWait(createInfo,linkName);
 
         String_delete(fileName);
         File_doneExtendedAttributes(&fileExtendedAttributeList);
@@ -6477,11 +9180,9 @@ LOCAL Errors storeLinkEntry(CreateInfo     *createInfo,
                    Error_getText(error)
                   );
 
-        STATUS_INFO_UPDATE(createInfo,linkName,NULL)
-        {
-          createInfo->runningInfo.progress.error.count++;
-          createInfo->runningInfo.progress.done.count++;
-        }
+        ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+        ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+        updateRunningInfoNoWait(createInfo,linkName);
 
         String_delete(fileName);
         File_doneExtendedAttributes(&fileExtendedAttributeList);
@@ -6511,11 +9212,9 @@ LOCAL Errors storeLinkEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,linkName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count++;
-        createInfo->runningInfo.progress.done.count++;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+      updateRunningInfoNoWait(createInfo,linkName);
 
       String_delete(archiveEntryName);
       String_delete(fileName);
@@ -6540,11 +9239,9 @@ LOCAL Errors storeLinkEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,linkName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count++;
-        createInfo->runningInfo.progress.done.count++;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+      updateRunningInfoNoWait(createInfo,linkName);
 
       String_delete(fileName);
       File_doneExtendedAttributes(&fileExtendedAttributeList);
@@ -6576,10 +9273,8 @@ LOCAL Errors storeLinkEntry(CreateInfo     *createInfo,
   }
 
   // update running info
-  STATUS_INFO_UPDATE(createInfo,linkName,NULL)
-  {
-    createInfo->runningInfo.progress.done.count++;
-  }
+  ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+  updateRunningInfoNoWait(createInfo,linkName);
 
   // free resources
   File_doneExtendedAttributes(&fileExtendedAttributeList);
@@ -6661,13 +9356,9 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,StringList_first(fileNameList,NULL),NULL)
-      {
-        createInfo->runningInfo.progress.skipped.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.skipped.size  += fragmentSize;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.done.size += fragmentSize;
-      }
+      ProgressCounters_addSkipped(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,StringList_first(fileNameList,NULL));
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -6681,13 +9372,10 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,StringList_first(fileNameList,NULL),NULL)
-      {
-        createInfo->runningInfo.progress.error.count++;
-        createInfo->runningInfo.progress.done.count++;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.done.size += fragmentSize;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,StringList_first(fileNameList,NULL));
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -6697,7 +9385,7 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
 
   // open file
   FileHandle fileHandle;
-  error = File_open(&fileHandle,StringList_first(fileNameList,NULL),FILE_OPEN_READ|FILE_OPEN_NO_ATIME|FILE_OPEN_NO_CACHE);
+  error = File_open(&fileHandle,StringList_first(fileNameList,NULL),FILE_OPEN_READ|FILE_OPEN_NO_ATIME|FILE_OPEN_NO_CACHE|FILE_OPEN_READ_AHEAD);
   if (error != ERROR_NONE)
   {
     if (createInfo->jobOptions->skipUnreadableFlag)
@@ -6710,13 +9398,9 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,StringList_first(fileNameList,NULL),NULL)
-      {
-        createInfo->runningInfo.progress.skipped.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.skipped.size  += fragmentSize;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.done.size += fragmentSize;
-      }
+      ProgressCounters_addSkipped(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,StringList_first(fileNameList,NULL));
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -6730,13 +9414,9 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,StringList_first(fileNameList,NULL),NULL)
-      {
-        createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.error.size  += fragmentSize;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.done.size += fragmentSize;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,StringList_first(fileNameList,NULL));
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -6767,7 +9447,21 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
        archiveFlags |= ARCHIVE_FLAG_TRY_BYTE_COMPRESS;
     }
 
-    // create new archive hard link entry
+    // check if byte compression should be disabled for not compressible data
+    if (globalOptions.compressAdaptiveFlag)
+    {
+       archiveFlags |= ARCHIVE_FLAG_ADAPTIVE_COMPRESS;
+    }
+
+    // get holes of sparse file (on error store all data)
+    FileHoleList fileHoleList;
+    File_initHoles(&fileHoleList);
+    if (createInfo->jobOptions->sparseFlag)
+    {
+      (void)File_getHoles(&fileHoleList,&fileHandle,fragmentOffset,fragmentSize,MIN_SPARSE_HOLE_SIZE);
+    }
+
+    // create new archive hard link entry (Note: holes are stored in the entry, data of holes is not stored)
     StringList archiveEntryNameList;
     StringList_init(&archiveEntryNameList);
     getArchiveEntryNameList(&archiveEntryNameList,fileNameList);
@@ -6782,6 +9476,7 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
                                      &archiveEntryNameList,
                                      fileInfo,
                                      &fileExtendedAttributeList,
+                                     &fileHoleList,
                                      fragmentOffset,
                                      fragmentSize,
                                      archiveFlags
@@ -6794,30 +9489,51 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,StringList_first(fileNameList,NULL),NULL)
-      {
-        createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.error.size  += fragmentSize;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.done.size += fragmentSize;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,StringList_first(fileNameList,NULL));
 
       StringList_done(&archiveEntryNameList);
       (void)File_close(&fileHandle);
       fragmentDone(createInfo,StringList_first(fileNameList,NULL));
+      File_doneHoles(&fileHoleList);
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
       return error;
     }
 
-    // seek to start offset
-    error = File_seek(&fileHandle,fragmentOffset);
-    if (error == ERROR_NONE)
+    // write hard link content to archive: data of fragment without holes
+    const FileHoleNode *fileHoleNode      = fileHoleList.head;
+    bool               endOfFileFlag     = FALSE;
+    uint64             offset            = fragmentOffset;
+    uint64             progressOffset    = offset;
+    uint64             progressTimestamp = Misc_getTimestamp();
+    error = ERROR_NONE;
+    while (   (createInfo->failError == ERROR_NONE)
+           && !isAborted(createInfo)
+           && (error == ERROR_NONE)
+           && !endOfFileFlag
+           && (offset < (fragmentOffset+fragmentSize))
+          )
     {
-      // write hard link content to archive
-      uint64 offset = fragmentOffset;
-      uint64 size   = fragmentSize;
-      error  = ERROR_NONE;
+      // get next data, seek to data
+      uint64 size;
+      uint64 dataOffset = File_getNextData(&fileHoleNode,offset,fragmentOffset+fragmentSize,&size);
+      if (dataOffset != offset)
+      {
+        if (offset > progressOffset)
+        {
+          updateFragmentProgress(createInfo,StringList_first(fileNameList,NULL),progressOffset,offset-progressOffset);
+        }
+        offset         = dataOffset;
+        progressOffset = offset;
+      }
+      if (size == 0LL)
+      {
+        break;
+      }
+      error = File_seek(&fileHandle,offset);
+
       while (   (createInfo->failError == ERROR_NONE)
              && !isAborted(createInfo)
              && (error == ERROR_NONE)
@@ -6838,32 +9554,16 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
             error = Archive_writeData(&archiveEntryInfo,buffer,bufferLength,1);
             if (error == ERROR_NONE)
             {
-              // get current archive size
-              uint64 archiveSize = Archive_getSize(&createInfo->archiveHandle);
+              ProgressCounters_addDone(&createInfo->progressCounters,0L,(uint64)bufferLength);
+              offset += bufferLength;
 
-              // update running info
-              FragmentNode *fragmentNode;
-              STATUS_INFO_UPDATE(createInfo,StringList_first(fileNameList,NULL),&fragmentNode)
+              // update running info from time to time
+              if (Misc_getTimestamp() >= (progressTimestamp+RUNNING_INFO_UPDATE_INTERVAL*US_PER_MS))
               {
-                if (fragmentNode != NULL)
-                {
-                  // add fragment
-                  FragmentList_addRange(fragmentNode,offset,bufferLength);
-
-                  // update running info
-                  if (fragmentNode == createInfo->runningInfoCurrentFragmentNode)
-                  {
-                    createInfo->runningInfo.progress.entry.doneSize   = FragmentList_getSize(createInfo->runningInfoCurrentFragmentNode);
-                    createInfo->runningInfo.progress.entry.totalSize  = FragmentList_getTotalSize(createInfo->runningInfoCurrentFragmentNode);
-                  }
-                }
-                createInfo->runningInfo.progress.done.size        = createInfo->runningInfo.progress.done.size+(uint64)bufferLength;
-                createInfo->runningInfo.progress.archiveSize      = archiveSize+createInfo->runningInfo.progress.storage.totalSize;
-                createInfo->runningInfo.progress.compressionRatio = (!createInfo->jobOptions->dryRun && (createInfo->runningInfo.progress.done.size > 0))
-                                                                      ? 100.0-(createInfo->runningInfo.progress.archiveSize *100.0)/createInfo->runningInfo.progress.done.size
-                                                                      : 0.0;
+                updateFragmentProgress(createInfo,StringList_first(fileNameList,NULL),progressOffset,offset-progressOffset);
+                progressOffset    = offset;
+                progressTimestamp = Misc_getTimestamp();
               }
-              offset += bufferLength;
             }
             else
             {
@@ -6892,7 +9592,8 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
           else
           {
             // read nohting -> file size changed -> done
-            size = 0;
+            size          = 0;
+            endOfFileFlag = TRUE;
           }
         }
         else
@@ -6908,18 +9609,23 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
         // wait for temporary file space
         waitForTemporaryFileSpace(createInfo);
       }
-      if (isAborted(createInfo))
-      {
-        printInfo(1,"ABORTED\n");
+    }
+    if (offset > progressOffset)
+    {
+      updateFragmentProgress(createInfo,StringList_first(fileNameList,NULL),progressOffset,offset-progressOffset);
+    }
+    if (isAborted(createInfo))
+    {
+      printInfo(1,"ABORTED\n");
 
-        (void)Archive_closeEntry(&archiveEntryInfo);
-        StringList_done(&archiveEntryNameList);
-        (void)File_close(&fileHandle);
-        fragmentDone(createInfo,StringList_first(fileNameList,NULL));
-        File_doneExtendedAttributes(&fileExtendedAttributeList);
+      (void)Archive_closeEntry(&archiveEntryInfo);
+      StringList_done(&archiveEntryNameList);
+      (void)File_close(&fileHandle);
+      fragmentDone(createInfo,StringList_first(fileNameList,NULL));
+      File_doneHoles(&fileHoleList);
+      File_doneExtendedAttributes(&fileExtendedAttributeList);
 
-        return error;
-      }
+      return error;
     }
     if (error != ERROR_NONE)
     {
@@ -6927,18 +9633,15 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
       {
         printInfo(1,"skipped (reason: %s)\n",Error_getText(error));
 
-        STATUS_INFO_UPDATE(createInfo,StringList_first(fileNameList,NULL),NULL)
-        {
-          createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;
-          createInfo->runningInfo.progress.error.size  += fragmentSize;
-          createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-          createInfo->runningInfo.progress.done.size += fragmentSize;
-        }
+        ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+        ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+        updateRunningInfoNoWait(createInfo,StringList_first(fileNameList,NULL));
 
         (void)Archive_closeEntry(&archiveEntryInfo);
         StringList_done(&archiveEntryNameList);
         (void)File_close(&fileHandle);
         fragmentDone(createInfo,StringList_first(fileNameList,NULL));
+        File_doneHoles(&fileHoleList);
         File_doneExtendedAttributes(&fileExtendedAttributeList);
 
         return ERROR_NONE;
@@ -6950,18 +9653,15 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
                    Error_getText(error)
                   );
 
-        STATUS_INFO_UPDATE(createInfo,StringList_first(fileNameList,NULL),NULL)
-        {
-          createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;
-          createInfo->runningInfo.progress.error.size  += fragmentSize;
-          createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-          createInfo->runningInfo.progress.done.size += fragmentSize;
-        }
+        ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+        ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+        updateRunningInfoNoWait(createInfo,StringList_first(fileNameList,NULL));
 
         (void)Archive_closeEntry(&archiveEntryInfo);
         StringList_done(&archiveEntryNameList);
         (void)File_close(&fileHandle);
         fragmentDone(createInfo,StringList_first(fileNameList,NULL));
+        File_doneHoles(&fileHoleList);
         File_doneExtendedAttributes(&fileExtendedAttributeList);
 
         return error;
@@ -6978,28 +9678,32 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,StringList_first(fileNameList,NULL),NULL)
-      {
-        createInfo->runningInfo.progress.error.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.error.size  += fragmentSize;
-        createInfo->runningInfo.progress.done.count += (fragmentOffset == 0LL) ? 1 : 0;
-        createInfo->runningInfo.progress.done.size += fragmentSize;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      ProgressCounters_addDone(&createInfo->progressCounters,(fragmentOffset == 0LL) ? 1 : 0,fragmentSize);
+      updateRunningInfoNoWait(createInfo,StringList_first(fileNameList,NULL));
 
       StringList_done(&archiveEntryNameList);
       (void)File_close(&fileHandle);
       fragmentDone(createInfo,StringList_first(fileNameList,NULL));
+      File_doneHoles(&fileHoleList);
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
       return error;
     }
     StringList_done(&archiveEntryNameList);
 
+    // add holes
+    fragmentAddHoles(createInfo,StringList_first(fileNameList,NULL),&fileHoleList);
+    File_doneHoles(&fileHoleList);
+
+    uint64 storedSize   = archiveEntryInfo.hardLink.chunkHardLinkData.fragmentSize;
+    uint64 archivedSize = archiveEntryInfo.hardLink.chunkHardLinkData.info.size;
+
     // get final compression ratio
     double compressionRatio;
-    if (archiveEntryInfo.hardLink.chunkHardLinkData.fragmentSize > 0LL)
+    if (storedSize > 0LL)
     {
-      compressionRatio = 100.0-archiveEntryInfo.hardLink.chunkHardLinkData.info.size*100.0/archiveEntryInfo.hardLink.chunkHardLinkData.fragmentSize;
+      compressionRatio = 100.0-archivedSize*100.0/storedSize;
     }
     else
     {
@@ -7085,7 +9789,7 @@ LOCAL Errors storeHardLinkEntry(CreateInfo       *createInfo,
 
       if (FragmentList_isComplete(fragmentNode))
       {
-        createInfo->runningInfo.progress.done.count += StringList_count(fileNameList);
+        ProgressCounters_addDone(&createInfo->progressCounters,StringList_count(fileNameList),0LL);
       }
     }
   }
@@ -7171,11 +9875,9 @@ LOCAL Errors storeSpecialEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,fileName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count++;
-        createInfo->runningInfo.progress.done.count++;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+      updateRunningInfoNoWait(createInfo,fileName);
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -7189,11 +9891,9 @@ LOCAL Errors storeSpecialEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,fileName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count++;
-        createInfo->runningInfo.progress.done.count++;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+      updateRunningInfoNoWait(createInfo,fileName);
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -7223,11 +9923,9 @@ LOCAL Errors storeSpecialEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,fileName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count++;
-        createInfo->runningInfo.progress.done.count++;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+      updateRunningInfoNoWait(createInfo,fileName);
 
       String_delete(archiveEntryName);
       File_doneExtendedAttributes(&fileExtendedAttributeList);
@@ -7245,11 +9943,9 @@ LOCAL Errors storeSpecialEntry(CreateInfo     *createInfo,
                  Error_getText(error)
                 );
 
-      STATUS_INFO_UPDATE(createInfo,fileName,NULL)
-      {
-        createInfo->runningInfo.progress.error.count++;
-        createInfo->runningInfo.progress.done.count++;
-      }
+      ProgressCounters_addError(&createInfo->progressCounters,1,0LL);
+      ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+      updateRunningInfoNoWait(createInfo,fileName);
 
       File_doneExtendedAttributes(&fileExtendedAttributeList);
 
@@ -7277,10 +9973,8 @@ LOCAL Errors storeSpecialEntry(CreateInfo     *createInfo,
   }
 
   // update running info
-  STATUS_INFO_UPDATE(createInfo,fileName,NULL)
-  {
-    createInfo->runningInfo.progress.done.count++;
-  }
+  ProgressCounters_addDone(&createInfo->progressCounters,1,0LL);
+  updateRunningInfoNoWait(createInfo,fileName);
 
   // free resources
   File_doneExtendedAttributes(&fileExtendedAttributeList);
@@ -7294,6 +9988,79 @@ LOCAL Errors storeSpecialEntry(CreateInfo     *createInfo,
   return ERROR_NONE;
 }
 
+/***********************************************************************\
+* Name   : isOwnFile
+* Purpose: check if file is an own file (temporary file or created
+*          storage file)
+* Input  : createInfo - create info
+*          name       - file name
+* Output : -
+* Return : TRUE iff own file
+* Notes  : -
+\***********************************************************************/
+
+LOCAL bool isOwnFile(CreateInfo *createInfo, ConstString name)
+{
+  assert(createInfo != NULL);
+  assert(name != NULL);
+
+  return    String_startsWith(name,tmpDirectory)
+         || Dictionary_contains(&createInfo->storageFileDictionary,
+                                String_cString(name),
+                                String_length(name)
+                               );
+}
+
+/***********************************************************************\
+* Name   : isStopCreateThread
+* Purpose: check if create thread should stop
+* Input  : createInfo - create info block
+* Output : -
+* Return : TRUE iff thread should stop
+* Notes  : decrement number of create threads to stop
+\***********************************************************************/
+
+LOCAL bool isStopCreateThread(CreateInfo *createInfo)
+{
+  assert(createInfo != NULL);
+
+  uint stopCount;
+  do
+  {
+    stopCount = createInfo->createThreads.stopCount;
+    if (stopCount == 0)
+    {
+      return FALSE;
+    }
+  }
+  while (!atomicCompareSwap32(&createInfo->createThreads.stopCount,stopCount,stopCount-1));
+
+  return TRUE;
+}
+
+/***********************************************************************\
+* Name   : addCreateThreadTime
+* Purpose: add CPU time used by calling create thread
+* Input  : createInfo - create info structure
+*          threadTime - CPU time of thread at last call [us]
+* Output : threadTime - current CPU time of thread [us]
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void addCreateThreadTime(CreateInfo *createInfo, uint64 *threadTime)
+{
+  assert(createInfo != NULL);
+  assert(threadTime != NULL);
+
+  uint64 time = Misc_getThreadTime();
+  if (time > (*threadTime))
+  {
+    (void)atomicIncrement64(&createInfo->createThreads.cpuTime,(int)MIN(time-(*threadTime),(uint64)MAX_INT));
+  }
+  (*threadTime) = time;
+}
+
 /***********************************************************************\
 * Name   : createThreadCode
 * Purpose: create worker thread
@@ -7308,9 +10075,14 @@ LOCAL void createThreadCode(CreateInfo *createInfo)
 
   assert(createInfo != NULL);
 
+  (void)ATOMIC_INCREMENT(createInfo->createThreads.count);
+  uint64 threadTime = Misc_getThreadTime();
+
   // store entries
-  EntryMsg entryMsg;
-  byte     *buffer = (byte*)malloc(BUFFER_SIZE);
+  EntryMsg   entryMsg;
+  SolidBlock solidBlock;
+  solidBlock.openFlag = FALSE;
+  byte       *buffer = (byte*)malloc(BUFFER_SIZE);
   if (buffer == NULL)
   {
     HALT_INSUFFICIENT_MEMORY();
@@ -7327,23 +10099,19 @@ LOCAL void createThreadCode(CreateInfo *createInfo)
     {
       case ENTRY_TYPE_FILE:
         name        = entryMsg.file.name;
-        ownFileFlag =    String_startsWith(entryMsg.file.name,tmpDirectory)
-                      || StringList_contains(&createInfo->storageFileList,entryMsg.file.name);
+        ownFileFlag = isOwnFile(createInfo,entryMsg.file.name);
         break;
       case ENTRY_TYPE_IMAGE:
         name        = entryMsg.image.name;
-        ownFileFlag =    String_startsWith(entryMsg.image.name,tmpDirectory)
-                      || StringList_contains(&createInfo->storageFileList,entryMsg.image.name);
+        ownFileFlag = isOwnFile(createInfo,entryMsg.image.name);
         break;
       case ENTRY_TYPE_DIRECTORY:
         name        = entryMsg.directory.name;
-        ownFileFlag =    String_startsWith(entryMsg.directory.name,tmpDirectory)
-                      || StringList_contains(&createInfo->storageFileList,entryMsg.directory.name);
+        ownFileFlag = isOwnFile(createInfo,entryMsg.directory.name);
         break;
       case ENTRY_TYPE_LINK:
         name        = entryMsg.link.name;
-        ownFileFlag =    String_startsWith(entryMsg.link.name,tmpDirectory)
-                      || StringList_contains(&createInfo->storageFileList,entryMsg.link.name);
+        ownFileFlag = isOwnFile(createInfo,entryMsg.link.name);
         break;
       case ENTRY_TYPE_HARDLINK:
         {
@@ -7352,15 +10120,13 @@ LOCAL void createThreadCode(CreateInfo *createInfo)
           ConstString hardLinkName;
           STRINGLIST_ITERATEX(&entryMsg.hardLink.nameList,hardLinkName,!ownFileFlag)
           {
-            ownFileFlag =    String_startsWith(hardLinkName,tmpDirectory)
-                          || StringList_contains(&createInfo->storageFileList,hardLinkName);
+            ownFileFlag = isOwnFile(createInfo,hardLinkName);
           }
         }
         break;
       case ENTRY_TYPE_SPECIAL:
         name        = entryMsg.special.name;
-        ownFileFlag =    String_startsWith(entryMsg.special.name,tmpDirectory)
-                      || StringList_contains(&createInfo->storageFileList,entryMsg.special.name);
+        ownFileFlag = isOwnFile(createInfo,entryMsg.special.name);
         break;
     }
 
@@ -7375,6 +10141,7 @@ LOCAL void createThreadCode(CreateInfo *createInfo)
       {
         case ENTRY_TYPE_FILE:
           error = storeFileEntry(createInfo,
+                                 &solidBlock,
                                  entryMsg.file.name,
                                  &entryMsg.file.fileInfo,
                                  entryMsg.file.fragmentNumber,
@@ -7444,10 +10211,8 @@ LOCAL void createThreadCode(CreateInfo *createInfo)
     {
       printInfo(1,"Add '%s'...skipped (reason: own created file)\n",String_cString(name));
 
-      STATUS_INFO_UPDATE(createInfo,name,NULL)
-      {
-        createInfo->runningInfo.progress.skipped.count++;
-      }
+      ProgressCounters_addSkipped(&createInfo->progressCounters,1,0LL);
+      updateRunningInfoNoWait(createInfo,name);
     }
 
     // update running info and check if aborted
@@ -7459,14 +10224,31 @@ LOCAL void createThreadCode(CreateInfo *createInfo)
     // free entry message
     freeEntryMsg(&entryMsg,NULL);
 
+    // add CPU time of thread for create thread control
+    addCreateThreadTime(createInfo,&threadTime);
+
 // NYI: is this really useful? (avoid that sum-collector-thread is slower than file-collector-thread)
     // slow down if too fast
-    while (   !createInfo->collectorTotalSumDone
-           && (createInfo->runningInfo.progress.done.count >= createInfo->runningInfo.progress.total.count)
+    while (   !globalOptions.singlePassCollectorFlag
+           && !createInfo->collectorTotalSumDone
+           && (ProgressCounters_getDoneCount(&createInfo->progressCounters) >= createInfo->runningInfo.progress.total.count)
           )
     {
       Misc_udelay(1000LL*US_PER_MS);
     }
+
+    // stop thread if requested by create thread control
+    if (isStopCreateThread(createInfo))
+    {
+      break;
+    }
+  }
+
+  // close solid block
+  Errors error = closeSolidBlock(&solidBlock);
+  if ((error != ERROR_NONE) && (createInfo->failError == ERROR_NONE))
+  {
+    createInfo->failError = error;
   }
 
   // if error or abort terminated the entry queue
@@ -7475,8 +10257,84 @@ LOCAL void createThreadCode(CreateInfo *createInfo)
     MsgQueue_setEndOfMsg(&createInfo->entryMsgQueue);
   }
 
+  // free pooled compress/crypt contexts of thread
+  Compress_doneThreadContexts();
+  Crypt_doneThreadContexts();
+
   // free resources
   free(buffer);
+
+  addCreateThreadTime(createInfo,&threadTime);
+  (void)ATOMIC_DECREMENT(createInfo->createThreads.count);
+}
+
+/***********************************************************************\
+* Name   : createThreadControlCode
+* Purpose: create thread control: adapt number of create threads
+* Input  : createInfo - create info block
+* Output : -
+* Return : -
+* Notes  : the number of create threads is adapted to the CPU time
+*          used by the create threads of this job: when the create
+*          threads are mostly waiting for I/O, additional create
+*          threads are started to keep the cores busy; when they keep
+*          all cores busy, additional threads are stopped again
+\***********************************************************************/
+
+LOCAL void createThreadControlCode(CreateInfo *createInfo)
+{
+  assert(createInfo != NULL);
+
+  ThreadPoolSet threadSet;
+  ThreadPool_initSet(&threadSet,&workerThreadPool);
+
+  uint   coreCount       = Thread_getNumberOfCores();
+  uint64 lastTimestamp   = Misc_getTimestamp();
+  uint64 lastCPUTime     = createInfo->createThreads.cpuTime;
+  while (   !createInfo->createThreads.quitFlag
+         && (createInfo->failError == ERROR_NONE)
+         && !isAborted(createInfo)
+        )
+  {
+    // sleep
+    for (uint64 time = 0LL; (time < CREATE_THREAD_CONTROL_INTERVAL) && !createInfo->createThreads.quitFlag; time += 100LL)
+    {
+      Misc_mdelay(100LL);
+    }
+    if (createInfo->createThreads.quitFlag) break;
+
+    // get CPU load of create threads in last interval (number of busy cores in percent)
+    uint64 timestamp = Misc_getTimestamp();
+    uint64 cpuTime   = createInfo->createThreads.cpuTime;
+    uint   load      = (timestamp > lastTimestamp) ? (uint)((100LL*(cpuTime-lastCPUTime))/(timestamp-lastTimestamp)) : 0;
+    lastTimestamp = timestamp;
+    lastCPUTime   = cpuTime;
+
+    // adapt number of create threads
+    uint activeCount = createInfo->createThreads.count-createInfo->createThreads.stopCount;
+    if      (   (load < 50*activeCount)
+             && (load < 100*coreCount)
+             && (MsgQueue_count(&createInfo->entryMsgQueue) > 0)
+             && (activeCount < createInfo->createThreads.maxCount)
+            )
+    {
+      // I/O bound -> start additional create thread
+      ThreadPool_setAdd(&threadSet,
+                        ThreadPool_run(&workerThreadPool,createThreadCode,createInfo)
+                       );
+    }
+    else if (   (load >= 90*coreCount)
+             && (activeCount > createInfo->createThreads.minCount)
+            )
+    {
+      // CPU bound -> stop a create thread
+      (void)ATOMIC_INCREMENT(createInfo->createThreads.stopCount);
+    }
+  }
+
+  // wait for additional create threads
+  ThreadPool_joinSet(&threadSet);
+  ThreadPool_doneSet(&threadSet);
 }
 
 /*---------------------------------------------------------------------*/
@@ -7690,6 +10548,7 @@ Errors Command_create(ServerIO                     *masterIO,
       printInfo(1,"Read incremental list '%s'...",String_cString(incrementalListFileName));
       error = readIncrementalList(&createInfo,
                                   incrementalListFileName,
+                                  &createInfo.incrementalList,
                                   &createInfo.namesDictionary
                                  );
       if (error != ERROR_NONE)
@@ -7705,7 +10564,7 @@ Errors Command_create(ServerIO                     *masterIO,
       DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
       printInfo(1,
                 "OK (%lu entries)\n",
-                Dictionary_count(&createInfo.namesDictionary)
+                createInfo.incrementalList.count+Dictionary_count(&createInfo.namesDictionary)
                );
     }
 
@@ -7714,6 +10573,12 @@ Errors Command_create(ServerIO                     *masterIO,
   }
   AUTOFREE_ADD(&autoFreeList,incrementalListFileName,{ String_delete(incrementalListFileName); });
 
+  // get file system change generation and directories with changed entries
+  if (createInfo.storeIncrementalFileInfoFlag || createInfo.partialFlag)
+  {
+    initChangedDirectories(&createInfo);
+  }
+
   IndexId entityId = INDEX_ID_NONE;
   if (Index_isAvailable())
   {
@@ -7802,6 +10667,7 @@ Errors Command_create(ServerIO                     *masterIO,
                          CALLBACK_(archiveGetSize,&createInfo),
                          CALLBACK_(NULL,NULL),  // archiveTest
                          CALLBACK_(archiveStore,&createInfo),
+                         CALLBACK_(isStreamArchives(&createInfo) ? archiveStream : NULL,&createInfo),
                          CALLBACK_(getNamePasswordFunction,getNamePasswordUserData),
                          logHandle
                         );
@@ -7818,13 +10684,18 @@ Errors Command_create(ServerIO                     *masterIO,
   AUTOFREE_ADD(&autoFreeList,&createInfo.archiveHandle,{ Archive_close(&createInfo.archiveHandle,FALSE); });
 
   // start collectors and storage thread
-  ThreadPoolNode *collectorSumThreadNode = ThreadPool_run(&workerThreadPool,collectorSumThreadCode,&createInfo);
-  assert(collectorSumThreadNode != NULL);
+  // Note: collector sum thread is not needed if total sum is collected in a single pass
+  ThreadPoolNode *collectorSumThreadNode = NULL;
+  if (!globalOptions.singlePassCollectorFlag)
+  {
+    collectorSumThreadNode = ThreadPool_run(&workerThreadPool,collectorSumThreadCode,&createInfo);
+    assert(collectorSumThreadNode != NULL);
+    AUTOFREE_ADD(&autoFreeList,collectorSumThreadNode,{ ThreadPool_join(&workerThreadPool,collectorSumThreadNode); });
+  }
   ThreadPoolNode *collectorThreadNode = ThreadPool_run(&workerThreadPool,collectorThreadCode,&createInfo);
   assert(collectorThreadNode != NULL);
   ThreadPoolNode *collectorStorageThreadNode = ThreadPool_run(&workerThreadPool,storageThreadCode,&createInfo);
   assert(collectorStorageThreadNode != NULL);
-  AUTOFREE_ADD(&autoFreeList,collectorSumThreadNode,{ ThreadPool_join(&workerThreadPool,collectorSumThreadNode); });
   AUTOFREE_ADD(&autoFreeList,collectorThreadNode,{ ThreadPool_join(&workerThreadPool,collectorThreadNode); });
   AUTOFREE_ADD(&autoFreeList,collectorStorageThreadNode,{ MsgQueue_setEndOfMsg(&createInfo.storageMsgQueue); ThreadPool_join(&workerThreadPool,collectorStorageThreadNode); });
 
@@ -7840,15 +10711,40 @@ Errors Command_create(ServerIO                     *masterIO,
   }
   AUTOFREE_ADD(&autoFreeList,&createThreadSet,{ ThreadPool_joinSet(&createThreadSet); ThreadPool_doneSet(&createThreadSet); });
 
+  // start create thread control: adapt number of create threads if not set explicitly
+  ThreadPoolNode *createThreadControlNode = NULL;
+  if (globalOptions.maxThreads == 0)
+  {
+    createInfo.createThreads.minCount = createThreadCount;
+    createInfo.createThreads.maxCount = 2*createThreadCount;
+    createThreadControlNode = ThreadPool_run(&workerThreadPool,createThreadControlCode,&createInfo);
+    assert(createThreadControlNode != NULL);
+    AUTOFREE_ADD(&autoFreeList,createThreadControlNode,
+    {
+      createInfo.createThreads.quitFlag = TRUE;
+      MsgQueue_setEndOfMsg(&createInfo.entryMsgQueue);
+      ThreadPool_join(&workerThreadPool,createThreadControlNode);
+    });
+  }
+
   // wait for collector threads
-  ThreadPool_join(&workerThreadPool,collectorSumThreadNode);
+  if (collectorSumThreadNode != NULL)
+  {
+    ThreadPool_join(&workerThreadPool,collectorSumThreadNode);
+    AUTOFREE_REMOVE(&autoFreeList,collectorSumThreadNode);
+  }
   ThreadPool_join(&workerThreadPool,collectorThreadNode);
-  AUTOFREE_REMOVE(&autoFreeList,collectorSumThreadNode);
   AUTOFREE_REMOVE(&autoFreeList,collectorThreadNode);
 
   // wait for and done create threads
   MsgQueue_setEndOfMsg(&createInfo.entryMsgQueue);
   ThreadPool_joinSet(&createThreadSet);
+  if (createThreadControlNode != NULL)
+  {
+    createInfo.createThreads.quitFlag = TRUE;
+    ThreadPool_join(&workerThreadPool,createThreadControlNode);
+    AUTOFREE_REMOVE(&autoFreeList,createThreadControlNode);
+  }
   AUTOFREE_REMOVE(&autoFreeList,&createThreadSet);
   ThreadPool_doneSet(&createThreadSet);
   if (createInfo.failError != ERROR_NONE)
@@ -8022,9 +10918,12 @@ Errors Command_create(ServerIO                     *masterIO,
 
     // write incremental list
     printInfo(1,"Write incremental list '%s'...",String_cString(incrementalListFileName));
+    ulong entryCount;
     error = writeIncrementalList(&createInfo,
                                  incrementalListFileName,
-                                 &createInfo.namesDictionary
+                                 &createInfo.incrementalList,
+                                 &createInfo.namesDictionary,
+                                 &entryCount
                                 );
     if (error != ERROR_NONE)
     {
@@ -8039,7 +10938,7 @@ Errors Command_create(ServerIO                     *masterIO,
     DEBUG_TESTCODE() { AutoFree_cleanup(&autoFreeList); return DEBUG_TESTCODE_ERROR(); }
     printInfo(1,
               "OK (%lu entries)\n",
-              Dictionary_count(&createInfo.namesDictionary)
+              entryCount
              );
     logMessage(logHandle,LOG_TYPE_ALWAYS,"Updated incremental file '%s'",String_cString(incrementalListFileName));
   }
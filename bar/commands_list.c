@@ -1892,6 +1892,7 @@ LOCAL void freeArchiveContentNode(ArchiveContentNode *archiveContentNode, void *
     case ARCHIVE_ENTRY_TYPE_META:
     case ARCHIVE_ENTRY_TYPE_SALT:
     case ARCHIVE_ENTRY_TYPE_KEY:
+    case ARCHIVE_ENTRY_TYPE_SOLID:
     case ARCHIVE_ENTRY_TYPE_SIGNATURE:
       break;
     case ARCHIVE_ENTRY_TYPE_UNKNOWN:
@@ -1971,6 +1972,7 @@ LOCAL int compareArchiveContentNode(const ArchiveContentNode *archiveContentNode
     case ARCHIVE_ENTRY_TYPE_META:
     case ARCHIVE_ENTRY_TYPE_SALT:
     case ARCHIVE_ENTRY_TYPE_KEY:
+    case ARCHIVE_ENTRY_TYPE_SOLID:
     case ARCHIVE_ENTRY_TYPE_SIGNATURE:
       break;
     case ARCHIVE_ENTRY_TYPE_UNKNOWN:
@@ -2019,6 +2021,7 @@ LOCAL int compareArchiveContentNode(const ArchiveContentNode *archiveContentNode
     case ARCHIVE_ENTRY_TYPE_META:
     case ARCHIVE_ENTRY_TYPE_SALT:
     case ARCHIVE_ENTRY_TYPE_KEY:
+    case ARCHIVE_ENTRY_TYPE_SOLID:
     case ARCHIVE_ENTRY_TYPE_SIGNATURE:
       break;
     case ARCHIVE_ENTRY_TYPE_UNKNOWN:
@@ -2109,6 +2112,7 @@ LOCAL uint printArchiveContentList(uint prefixWidth)
       case ARCHIVE_ENTRY_TYPE_META:
       case ARCHIVE_ENTRY_TYPE_SALT:
       case ARCHIVE_ENTRY_TYPE_KEY:
+      case ARCHIVE_ENTRY_TYPE_SOLID:
       case ARCHIVE_ENTRY_TYPE_SIGNATURE:
         break;
       case ARCHIVE_ENTRY_TYPE_UNKNOWN:
@@ -2213,6 +2217,7 @@ LOCAL uint printArchiveContentList(uint prefixWidth)
           case ARCHIVE_ENTRY_TYPE_META:
           case ARCHIVE_ENTRY_TYPE_SALT:
           case ARCHIVE_ENTRY_TYPE_KEY:
+          case ARCHIVE_ENTRY_TYPE_SOLID:
           case ARCHIVE_ENTRY_TYPE_SIGNATURE:
             break;
           case ARCHIVE_ENTRY_TYPE_UNKNOWN:
@@ -2334,6 +2339,7 @@ LOCAL uint printArchiveContentList(uint prefixWidth)
       case ARCHIVE_ENTRY_TYPE_META:
       case ARCHIVE_ENTRY_TYPE_SALT:
       case ARCHIVE_ENTRY_TYPE_KEY:
+      case ARCHIVE_ENTRY_TYPE_SOLID:
       case ARCHIVE_ENTRY_TYPE_SIGNATURE:
         break;
       case ARCHIVE_ENTRY_TYPE_UNKNOWN:
@@ -2544,6 +2550,8 @@ NULL, // masterSocketHandle
                                                 fileName,
                                                 &fileInfo,
                                                 NULL,  // fileExtendedAttributeList
+                                                NULL,  // fileHoleList
+                                                NULL,  // referenceName
                                                 deltaSourceName,
                                                 &deltaSourceSize,
                                                 &fragmentOffset,
@@ -2955,6 +2963,7 @@ NULL, // masterSocketHandle
                                                     &fileNameList,
                                                     &fileInfo,
                                                     NULL,  // fileExtendedAttributeList
+                                                    NULL,  // fileHoleList
                                                     deltaSourceName,
                                                     &deltaSourceSize,
                                                     &fragmentOffset,
@@ -3220,6 +3229,7 @@ NULL, // masterSocketHandle
               break;
             case ARCHIVE_ENTRY_TYPE_SALT:
             case ARCHIVE_ENTRY_TYPE_KEY:
+            case ARCHIVE_ENTRY_TYPE_SOLID:
               #ifndef NDEBUG
                 HALT_INTERNAL_ERROR_UNREACHABLE();
               #else
@@ -53,6 +53,22 @@
 
 /***************************** Datatypes *******************************/
 
+// deduplicated file: content is restored by copying the referenced file
+typedef struct FileReferenceNode
+{
+  LIST_NODE_HEADER(struct FileReferenceNode);
+
+  String   storageName;                                             // printable storage name
+  String   referenceName;                                           // name of referenced file entry
+  String   destinationFileName;                                     // destination file name
+  FileInfo fileInfo;                                                // file info
+} FileReferenceNode;
+
+typedef struct
+{
+  LIST_HEADER(FileReferenceNode);
+} FileReferenceList;
+
 // restore information
 typedef struct
 {
@@ -84,6 +100,9 @@ typedef struct
   Semaphore                  fragmentListLock;
   FragmentList               fragmentList;                          // entry fragments
 
+  Semaphore                  fileReferenceListLock;
+  FileReferenceList          fileReferenceList;                     // deduplicated files to restore from referenced files
+
   Semaphore                  runningInfoLock;
   RunningInfo                runningInfo;                           // running info
   const FragmentNode         *runningInfoCurrentFragmentNode;       // current fragment node in running info
@@ -130,6 +149,27 @@ LOCAL void freeEntryMsg(EntryMsg *entryMsg, void *userData)
   UNUSED_VARIABLE(userData);
 }
 
+/***********************************************************************\
+* Name   : freeFileReferenceNode
+* Purpose: free file reference node
+* Input  : fileReferenceNode - file reference node
+*          userData          - user data (not used)
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void freeFileReferenceNode(FileReferenceNode *fileReferenceNode, void *userData)
+{
+  assert(fileReferenceNode != NULL);
+
+  UNUSED_VARIABLE(userData);
+
+  String_delete(fileReferenceNode->destinationFileName);
+  String_delete(fileReferenceNode->referenceName);
+  String_delete(fileReferenceNode->storageName);
+}
+
 /***********************************************************************\
 * Name   : initRestoreInfo
 * Purpose: initialize restore info
@@ -210,6 +250,12 @@ LOCAL void initRestoreInfo(RestoreInfo                *restoreInfo,
   }
   FragmentList_init(&restoreInfo->fragmentList);
 
+  if (!Semaphore_init(&restoreInfo->fileReferenceListLock,SEMAPHORE_TYPE_BINARY))
+  {
+    HALT_FATAL_ERROR("Cannot initialize file reference list semaphore!");
+  }
+  List_init(&restoreInfo->fileReferenceList,CALLBACK_(NULL,NULL),CALLBACK_((ListNodeFreeFunction)freeFileReferenceNode,NULL));
+
   if (!Semaphore_init(&restoreInfo->runningInfoLock,SEMAPHORE_TYPE_BINARY))
   {
     HALT_FATAL_ERROR("Cannot initialize running info semaphore!");
@@ -250,6 +296,8 @@ LOCAL void doneRestoreInfo(RestoreInfo *restoreInfo)
 
   doneRunningInfo(&restoreInfo->runningInfo);
   Semaphore_done(&restoreInfo->runningInfoLock);
+  List_done(&restoreInfo->fileReferenceList);
+  Semaphore_done(&restoreInfo->fileReferenceListLock);
   FragmentList_done(&restoreInfo->fragmentList);
   Semaphore_done(&restoreInfo->fragmentListLock);
   Dictionary_done(&restoreInfo->namesDictionary);
@@ -680,6 +728,313 @@ LOCAL String getUniqName(String destinationFileName)
   return destinationFileName;
 }
 
+/***********************************************************************\
+* Name   : addFileReference
+* Purpose: add deduplicated file to restore from referenced file
+* Input  : restoreInfo         - restore info
+*          storageName         - printable storage name
+*          referenceName       - name of referenced file entry
+*          destinationFileName - destination file name
+*          fileInfo            - file info
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void addFileReference(RestoreInfo    *restoreInfo,
+                            ConstString    storageName,
+                            ConstString    referenceName,
+                            ConstString    destinationFileName,
+                            const FileInfo *fileInfo
+                           )
+{
+  assert(restoreInfo != NULL);
+  assert(restoreInfo->jobOptions != NULL);
+  assert(referenceName != NULL);
+  assert(destinationFileName != NULL);
+  assert(fileInfo != NULL);
+
+  // add to list of file references
+  FileReferenceNode *fileReferenceNode = LIST_NEW_NODE(FileReferenceNode);
+  if (fileReferenceNode == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  fileReferenceNode->storageName         = String_duplicate(storageName);
+  fileReferenceNode->referenceName       = String_duplicate(referenceName);
+  fileReferenceNode->destinationFileName = String_duplicate(destinationFileName);
+  memCopyFast(&fileReferenceNode->fileInfo,sizeof(fileReferenceNode->fileInfo),fileInfo,sizeof(FileInfo));
+  SEMAPHORE_LOCKED_DO(&restoreInfo->fileReferenceListLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  {
+    List_append(&restoreInfo->fileReferenceList,fileReferenceNode);
+  }
+}
+
+/***********************************************************************\
+* Name   : restoreFileReference
+* Purpose: restore deduplicated file by copying the referenced file
+* Input  : restoreInfo       - restore info
+*          fileReferenceNode - file reference node
+*          sourceFileName    - restored referenced file name
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors restoreFileReference(RestoreInfo       *restoreInfo,
+                                  FileReferenceNode *fileReferenceNode,
+                                  ConstString       sourceFileName
+                                 )
+{
+  Errors error;
+
+  assert(restoreInfo != NULL);
+  assert(restoreInfo->jobOptions != NULL);
+  assert(fileReferenceNode != NULL);
+  assert(sourceFileName != NULL);
+
+  // temporary change owner+permissions for writing (ignore errors)
+  (void)File_setPermission(fileReferenceNode->destinationFileName,FILE_PERMISSION_USER_READ|FILE_PERMISSION_USER_WRITE);
+  (void)File_setOwner(fileReferenceNode->destinationFileName,FILE_OWN_USER_ID,FILE_OWN_GROUP_ID);
+
+  // copy content of referenced file
+  error = File_copy(sourceFileName,fileReferenceNode->destinationFileName);
+  if (error != ERROR_NONE)
+  {
+    printError(_("cannot restore file '%s' from '%s' (error: %s)"),
+               String_cString(fileReferenceNode->destinationFileName),
+               String_cString(sourceFileName),
+               Error_getText(error)
+              );
+    return handleError(restoreInfo,fileReferenceNode->storageName,fileReferenceNode->destinationFileName,error);
+  }
+
+  // set file time, file permission
+  if (globalOptions.permissions != FILE_DEFAULT_PERMISSIONS)
+  {
+    fileReferenceNode->fileInfo.permissions = globalOptions.permissions;
+  }
+  error = File_setInfo(&fileReferenceNode->fileInfo,fileReferenceNode->destinationFileName);
+  if (error != ERROR_NONE)
+  {
+    if (   !restoreInfo->jobOptions->noStopOnErrorFlag
+        && !File_isNetworkFileSystem(fileReferenceNode->destinationFileName)
+       )
+    {
+      printError(_("cannot set file info of '%s' (error: %s)"),
+                 String_cString(fileReferenceNode->destinationFileName),
+                 Error_getText(error)
+                );
+      return handleError(restoreInfo,fileReferenceNode->storageName,fileReferenceNode->destinationFileName,error);
+    }
+    else
+    {
+      printWarning(_("cannot set file info of '%s' (error: %s)"),
+                   String_cString(fileReferenceNode->destinationFileName),
+                   Error_getText(error)
+                  );
+    }
+  }
+
+  // set file owner/group
+  error = File_setOwner(fileReferenceNode->destinationFileName,
+                        (restoreInfo->jobOptions->owner.userId  != FILE_DEFAULT_USER_ID ) ? restoreInfo->jobOptions->owner.userId  : fileReferenceNode->fileInfo.userId,
+                        (restoreInfo->jobOptions->owner.groupId != FILE_DEFAULT_GROUP_ID) ? restoreInfo->jobOptions->owner.groupId : fileReferenceNode->fileInfo.groupId
+                       );
+  if (error != ERROR_NONE)
+  {
+    if (   !restoreInfo->jobOptions->noStopOnOwnerErrorFlag
+        && !File_isNetworkFileSystem(fileReferenceNode->destinationFileName)
+       )
+    {
+      printError(_("cannot set owner/group of file '%s' (error: %s)"),
+                 String_cString(fileReferenceNode->destinationFileName),
+                 Error_getText(error)
+                );
+      return handleError(restoreInfo,fileReferenceNode->storageName,fileReferenceNode->destinationFileName,error);
+    }
+    else
+    {
+      printWarning(_("cannot set owner/group of file '%s' (error: %s)"),
+                   String_cString(fileReferenceNode->destinationFileName),
+                   Error_getText(error)
+                  );
+    }
+  }
+
+  // set attributes
+  error = File_setAttributes(fileReferenceNode->fileInfo.attributes,fileReferenceNode->destinationFileName);
+  if (error != ERROR_NONE)
+  {
+    if (   !restoreInfo->jobOptions->noStopOnAttributeErrorFlag
+        && !File_isNetworkFileSystem(fileReferenceNode->destinationFileName)
+       )
+    {
+      printError(_("cannot set file attributes of '%s' (error: %s)"),
+                 String_cString(fileReferenceNode->destinationFileName),
+                 Error_getText(error)
+                );
+      return handleError(restoreInfo,fileReferenceNode->storageName,fileReferenceNode->destinationFileName,error);
+    }
+    else
+    {
+      printWarning(_("cannot set file attributes of '%s' (error: %s)"),
+                   String_cString(fileReferenceNode->destinationFileName),
+                   Error_getText(error)
+                  );
+    }
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : restoreFileReferences
+* Purpose: restore deduplicated files from referenced files
+* Input  : restoreInfo - restore info
+*          finalFlag   - TRUE to report deduplicated files where the
+*                        referenced file is not restored
+* Output : -
+* Return : -
+* Notes  : a deduplicated file is restored when the referenced file is
+*          restored completely; the referenced file may be stored after
+*          the deduplicated file or in a following archive part
+\***********************************************************************/
+
+LOCAL void restoreFileReferences(RestoreInfo *restoreInfo, bool finalFlag)
+{
+  assert(restoreInfo != NULL);
+  assert(restoreInfo->jobOptions != NULL);
+
+  String sourceFileName = String_new();
+  SEMAPHORE_LOCKED_DO(&restoreInfo->fileReferenceListLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  {
+    FileReferenceNode *fileReferenceNode = restoreInfo->fileReferenceList.head;
+    while (fileReferenceNode != NULL)
+    {
+      // check if referenced file is restored
+      getDestinationFileName(sourceFileName,
+                             fileReferenceNode->referenceName,
+                             restoreInfo->jobOptions->destination,
+                             restoreInfo->jobOptions->directoryStripCount
+                            );
+      bool restoredFlag = FALSE;
+      SEMAPHORE_LOCKED_DO(&restoreInfo->namesDictionaryLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+      {
+        restoredFlag = Dictionary_contains(&restoreInfo->namesDictionary,
+                                           String_cString(sourceFileName),
+                                           String_length(sourceFileName)
+                                          );
+      }
+      if (restoredFlag && !restoreInfo->jobOptions->noFragmentsCheckFlag)
+      {
+        SEMAPHORE_LOCKED_DO(&restoreInfo->fragmentListLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+        {
+          restoredFlag = (FragmentList_find(&restoreInfo->fragmentList,fileReferenceNode->referenceName) == NULL);
+        }
+      }
+
+      if      (restoredFlag)
+      {
+        // restore deduplicated file
+        Errors error = restoreFileReference(restoreInfo,fileReferenceNode,sourceFileName);
+        if ((error != ERROR_NONE) && (restoreInfo->failError == ERROR_NONE))
+        {
+          restoreInfo->failError = error;
+        }
+        fileReferenceNode = (FileReferenceNode*)List_removeAndFree(&restoreInfo->fileReferenceList,fileReferenceNode);
+      }
+      else if (finalFlag)
+      {
+        // referenced file not restored
+        printError(_("cannot restore file '%s': referenced file '%s' not restored"),
+                   String_cString(fileReferenceNode->destinationFileName),
+                   String_cString(fileReferenceNode->referenceName)
+                  );
+        Errors error = handleError(restoreInfo,
+                                   fileReferenceNode->storageName,
+                                   fileReferenceNode->destinationFileName,
+                                   ERRORX_(ENTRY_NOT_FOUND,0,"%s",String_cString(fileReferenceNode->referenceName))
+                                  );
+        if ((error != ERROR_NONE) && (restoreInfo->failError == ERROR_NONE))
+        {
+          restoreInfo->failError = error;
+        }
+        fileReferenceNode = (FileReferenceNode*)List_removeAndFree(&restoreInfo->fileReferenceList,fileReferenceNode);
+      }
+      else
+      {
+        fileReferenceNode = fileReferenceNode->next;
+      }
+    }
+  }
+  String_delete(sourceFileName);
+}
+
+/***********************************************************************\
+* Name   : restoreHoles
+* Purpose: restore holes of sparse file
+* Input  : fileHandle   - file handle
+*          fileHoleList - holes list
+*          sparseFlag   - TRUE to create holes, FALSE to write 0-bytes
+*          buffer       - buffer for temporary data
+*          bufferSize   - size of data buffer
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : data already existing in a hole, e. g. of a file restored
+*          before from another archive, is cleared
+\***********************************************************************/
+
+LOCAL Errors restoreHoles(FileHandle         *fileHandle,
+                          const FileHoleList *fileHoleList,
+                          bool               sparseFlag,
+                          byte               *buffer,
+                          uint               bufferSize
+                         )
+{
+  assert(fileHandle != NULL);
+  assert(fileHoleList != NULL);
+  assert(buffer != NULL);
+  assert(bufferSize > 0);
+
+  Errors             error = ERROR_NONE;
+  const FileHoleNode *fileHoleNode;
+  LIST_ITERATEX(fileHoleList,fileHoleNode,error == ERROR_NONE)
+  {
+    uint64 fileSize = File_getSize(fileHandle);
+    if (sparseFlag)
+    {
+      // deallocate existing data in hole, extend file by hole
+      if (fileHoleNode->offset < fileSize)
+      {
+        error = File_punchHole(fileHandle,
+                               fileHoleNode->offset,
+                               MIN(fileHoleNode->size,fileSize-fileHoleNode->offset)
+                              );
+      }
+      if ((error == ERROR_NONE) && (fileSize < (fileHoleNode->offset+fileHoleNode->size)))
+      {
+        error = File_truncate(fileHandle,fileHoleNode->offset+fileHoleNode->size);
+      }
+    }
+    else
+    {
+      // write 0-bytes
+      memClear(buffer,bufferSize);
+      error = File_seek(fileHandle,fileHoleNode->offset);
+      uint64 length = fileHoleNode->size;
+      while ((error == ERROR_NONE) && (length > 0LL))
+      {
+        ulong n = (ulong)MIN(length,(uint64)bufferSize);
+        error = File_write(fileHandle,buffer,n);
+        length -= (uint64)n;
+      }
+    }
+  }
+
+  return error;
+}
+
 /***********************************************************************\
 * Name   : restoreFileEntry
 * Purpose: restore file entry
@@ -715,6 +1070,11 @@ LOCAL Errors restoreFileEntry(RestoreInfo   *restoreInfo,
   File_initExtendedAttributes(&fileExtendedAttributeList);
   AUTOFREE_ADD(&autoFreeList,fileName,{ String_delete(fileName); });
   AUTOFREE_ADD(&autoFreeList,&fileExtendedAttributeList,{ File_doneExtendedAttributes(&fileExtendedAttributeList); });
+  FileHoleList              fileHoleList;
+  File_initHoles(&fileHoleList);
+  AUTOFREE_ADD(&autoFreeList,&fileHoleList,{ File_doneHoles(&fileHoleList); });
+  String                    referenceName = String_new();
+  AUTOFREE_ADD(&autoFreeList,referenceName,{ String_delete(referenceName); });
   uint64                    fragmentOffset,fragmentSize;
   error = Archive_readFileEntry(&archiveEntryInfo,
                                 archiveHandle,
@@ -727,6 +1087,8 @@ LOCAL Errors restoreFileEntry(RestoreInfo   *restoreInfo,
                                 fileName,
                                 &fileInfo,
                                 &fileExtendedAttributeList,
+                                &fileHoleList,
+                                referenceName,
                                 NULL,  // deltaSourceName
                                 NULL,  // deltaSourceSize
                                 &fragmentOffset,
@@ -923,6 +1285,61 @@ LOCAL Errors restoreFileEntry(RestoreInfo   *restoreInfo,
       }
     }
 
+    if (!String_isEmpty(referenceName))
+    {
+      // deduplicated file: content is complete with referenced file content
+      if (!restoreInfo->jobOptions->noFragmentsCheckFlag)
+      {
+        SEMAPHORE_LOCKED_DO(&restoreInfo->fragmentListLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+        {
+          FragmentNode *fragmentNode = FragmentList_find(&restoreInfo->fragmentList,fileName);
+          if (fragmentNode != NULL)
+          {
+            FragmentList_addRange(fragmentNode,0LL,fileInfo.size);
+            if (FragmentList_isComplete(fragmentNode))
+            {
+              FragmentList_discard(&restoreInfo->fragmentList,fragmentNode);
+            }
+          }
+        }
+      }
+
+      // restore from referenced file when it is restored
+      if (!restoreInfo->jobOptions->dryRun)
+      {
+        addFileReference(restoreInfo,
+                         archiveHandle->printableStorageName,
+                         referenceName,
+                         destinationFileName,
+                         &fileInfo
+                        );
+      }
+
+      // get size info
+      char sizeString[32];
+      if (globalOptions.humanFormatFlag)
+      {
+        getHumanSizeString(sizeString,sizeof(sizeString),fileInfo.size);
+      }
+      else
+      {
+        stringFormat(sizeString,sizeof(sizeString),"%"PRIu64,fileInfo.size);
+      }
+
+      // output result
+      if (!restoreInfo->jobOptions->dryRun)
+      {
+        printInfo(1,"OK (%s bytes, duplicate of '%s')\n",sizeString,String_cString(referenceName));
+      }
+      else
+      {
+        printInfo(1,"OK (%s bytes, duplicate of '%s', dry-run)\n",sizeString,String_cString(referenceName));
+      }
+
+      AutoFree_cleanup(&autoFreeList);
+      return ERROR_NONE;
+    }
+
     FileHandle fileHandle;
     if (!restoreInfo->jobOptions->dryRun)
     {
@@ -947,10 +1364,15 @@ LOCAL Errors restoreFileEntry(RestoreInfo   *restoreInfo,
       }
       AUTOFREE_ADD(&autoFreeList,&fileHandle,{ (void)File_close(&fileHandle); });
 
-      // set file length for sparse files
+      // set file length for sparse files, clear fragment
       if (restoreInfo->jobOptions->sparseFlag)
       {
         error = File_truncate(&fileHandle,fileInfo.size);
+        // clear existing data of fragment (Note: 0-bytes are not written into a sparse file)
+        if ((error == ERROR_NONE) && (fragmentSize > 0LL))
+        {
+          error = File_punchHole(&fileHandle,fragmentOffset,fragmentSize);
+        }
         if (error != ERROR_NONE)
         {
           printInfo(1,"FAIL!\n");
@@ -979,11 +1401,15 @@ LOCAL Errors restoreFileEntry(RestoreInfo   *restoreInfo,
       }
     }
 
-    // write file data
+    // write file data (Note: data of holes is not stored)
     error  = ERROR_NONE;
-    uint64 length = 0LL;
+    const FileHoleNode *fileHoleNode = fileHoleList.head;
+    uint64             dataSize      = File_getDataSize(&fileHoleList,fragmentOffset,fragmentSize);
+    uint64             offset        = fragmentOffset;
+    uint64             size          = 0LL;
+    uint64             length        = 0LL;
     while (   ((restoreInfo->isAbortedFunction == NULL) || !restoreInfo->isAbortedFunction(restoreInfo->isAbortedUserData))
-           && (length < fragmentSize)
+           && (length < dataSize)
           )
     {
       // pause
@@ -992,7 +1418,35 @@ LOCAL Errors restoreFileEntry(RestoreInfo   *restoreInfo,
         Misc_udelay(500L*US_PER_MS);
       }
 
-      ulong bufferLength = (ulong)MIN(fragmentSize-length,bufferSize);
+      // get next data, seek to data
+      if (size == 0LL)
+      {
+        offset = File_getNextData(&fileHoleNode,offset,fragmentOffset+fragmentSize,&size);
+        if (size == 0LL)
+        {
+          printInfo(1,"FAIL!\n");
+          printError(_("invalid holes in 'file' entry '%s'!"),
+                     String_cString(destinationFileName)
+                    );
+          error = ERROR_CORRUPT_DATA;
+          break;
+        }
+        if (!restoreInfo->jobOptions->dryRun)
+        {
+          error = File_seek(&fileHandle,offset);
+          if (error != ERROR_NONE)
+          {
+            printInfo(1,"FAIL!\n");
+            printError(_("cannot write content of file '%s' (error: %s)"),
+                       String_cString(destinationFileName),
+                       Error_getText(error)
+                      );
+            break;
+          }
+        }
+      }
+
+      ulong bufferLength = (ulong)MIN(size,bufferSize);
 
       error = Archive_readData(&archiveEntryInfo,buffer,bufferLength);
       if (error != ERROR_NONE)
@@ -1023,9 +1477,11 @@ LOCAL Errors restoreFileEntry(RestoreInfo   *restoreInfo,
       restoreInfo->runningInfo.progress.entry.doneSize += (uint64)bufferLength;
       updateRunningInfo(restoreInfo,FALSE);
 
+      offset += (uint64)bufferLength;
+      size   -= (uint64)bufferLength;
       length += (uint64)bufferLength;
 
-      printInfo(2,"%3d%%\b\b\b\b",(uint)((length*100LL)/fragmentSize));
+      printInfo(2,"%3d%%\b\b\b\b",(uint)((length*100LL)/dataSize));
     }
     if      (error != ERROR_NONE)
     {
@@ -1053,6 +1509,23 @@ LOCAL Errors restoreFileEntry(RestoreInfo   *restoreInfo,
       }
     }
 
+    // create holes of sparse file
+    if (!restoreInfo->jobOptions->dryRun)
+    {
+      error = restoreHoles(&fileHandle,&fileHoleList,restoreInfo->jobOptions->sparseFlag,buffer,bufferSize);
+      if (error != ERROR_NONE)
+      {
+        printInfo(1,"FAIL!\n");
+        printError(_("cannot write content of file '%s' (error: %s)"),
+                   String_cString(destinationFileName),
+                   Error_getText(error)
+                  );
+        error = handleError(restoreInfo,archiveHandle->printableStorageName,destinationFileName,error);
+        AutoFree_cleanup(&autoFreeList);
+        return error;
+      }
+    }
+
     // close file
     if (!restoreInfo->jobOptions->dryRun)
     {
@@ -1240,6 +1713,7 @@ LOCAL Errors restoreFileEntry(RestoreInfo   *restoreInfo,
   }
 
   // free resources
+  File_doneHoles(&fileHoleList);
   File_doneExtendedAttributes(&fileExtendedAttributeList);
   String_delete(fileName);
   AutoFree_done(&autoFreeList);
@@ -2400,6 +2874,9 @@ LOCAL Errors restoreHardLinkEntry(RestoreInfo   *restoreInfo,
   FileExtendedAttributeList fileExtendedAttributeList;
   File_initExtendedAttributes(&fileExtendedAttributeList);
   AUTOFREE_ADD(&autoFreeList,&fileExtendedAttributeList,{ File_doneExtendedAttributes(&fileExtendedAttributeList); });
+  FileHoleList              fileHoleList;
+  File_initHoles(&fileHoleList);
+  AUTOFREE_ADD(&autoFreeList,&fileHoleList,{ File_doneHoles(&fileHoleList); });
   uint64                    fragmentOffset,fragmentSize;
   error = Archive_readHardLinkEntry(&archiveEntryInfo,
                                     archiveHandle,
@@ -2412,6 +2889,7 @@ LOCAL Errors restoreHardLinkEntry(RestoreInfo   *restoreInfo,
                                     &fileNameList,
                                     &fileInfo,
                                     &fileExtendedAttributeList,
+                                    &fileHoleList,
                                     NULL,  // deltaSourceName
                                     NULL,  // deltaSourceSize
                                     &fragmentOffset,
@@ -2644,10 +3122,15 @@ LOCAL Errors restoreHardLinkEntry(RestoreInfo   *restoreInfo,
           }
           AUTOFREE_ADD(&autoFreeList,&fileHandle,{ (void)File_close(&fileHandle); });
 
-          // set file length for sparse files
+          // set file length for sparse files, clear fragment
           if (restoreInfo->jobOptions->sparseFlag)
           {
             error = File_truncate(&fileHandle,fileInfo.size);
+            // clear existing data of fragment (Note: 0-bytes are not written into a sparse file)
+            if ((error == ERROR_NONE) && (fragmentSize > 0LL))
+            {
+              error = File_punchHole(&fileHandle,fragmentOffset,fragmentSize);
+            }
             if (error != ERROR_NONE)
             {
               printInfo(1,"FAIL!\n");
@@ -2677,11 +3160,15 @@ LOCAL Errors restoreHardLinkEntry(RestoreInfo   *restoreInfo,
           String_set(hardLinkFileName,destinationFileName);
         }
 
-        // write file data
+        // write file data (Note: data of holes is not stored)
         error  = ERROR_NONE;
-        uint64 length = 0LL;
+        const FileHoleNode *fileHoleNode = fileHoleList.head;
+        uint64             dataSize      = File_getDataSize(&fileHoleList,fragmentOffset,fragmentSize);
+        uint64             offset        = fragmentOffset;
+        uint64             size          = 0LL;
+        uint64             length        = 0LL;
         while (   ((restoreInfo->isAbortedFunction == NULL) || !restoreInfo->isAbortedFunction(restoreInfo->isAbortedUserData))
-               && (length < fragmentSize)
+               && (length < dataSize)
               )
         {
           // pause
@@ -2690,13 +3177,41 @@ LOCAL Errors restoreHardLinkEntry(RestoreInfo   *restoreInfo,
             Misc_udelay(500L*US_PER_MS);
           }
 
-          ulong bufferLength = (ulong)MIN(fragmentSize-length,bufferSize);
-
-          error = Archive_readData(&archiveEntryInfo,buffer,bufferLength);
-          if (error != ERROR_NONE)
+          // get next data, seek to data
+          if (size == 0LL)
           {
-            printInfo(1,"FAIL!\n");
-            printError(_("cannot read content of 'hard link' entry '%s' (error: %s)!"),
+            offset = File_getNextData(&fileHoleNode,offset,fragmentOffset+fragmentSize,&size);
+            if (size == 0LL)
+            {
+              printInfo(1,"FAIL!\n");
+              printError(_("invalid holes in 'hard link' entry '%s'!"),
+                         String_cString(destinationFileName)
+                        );
+              error = ERROR_CORRUPT_DATA;
+              break;
+            }
+            if (!restoreInfo->jobOptions->dryRun)
+            {
+              error = File_seek(&fileHandle,offset);
+              if (error != ERROR_NONE)
+              {
+                printInfo(1,"FAIL!\n");
+                printError(_("cannot write content of hard link '%s' (error: %s)"),
+                           String_cString(destinationFileName),
+                           Error_getText(error)
+                          );
+                break;
+              }
+            }
+          }
+
+          ulong bufferLength = (ulong)MIN(size,bufferSize);
+
+          error = Archive_readData(&archiveEntryInfo,buffer,bufferLength);
+          if (error != ERROR_NONE)
+          {
+            printInfo(1,"FAIL!\n");
+            printError(_("cannot read content of 'hard link' entry '%s' (error: %s)!"),
                        String_cString(StringList_first(&fileNameList,NULL)),
                        Error_getText(error)
                       );
@@ -2723,9 +3238,11 @@ LOCAL Errors restoreHardLinkEntry(RestoreInfo   *restoreInfo,
             updateRunningInfo(restoreInfo,FALSE);
           }
 
+          offset += (uint64)bufferLength;
+          size   -= (uint64)bufferLength;
           length += (uint64)bufferLength;
 
-          printInfo(2,"%3d%%\b\b\b\b",(uint)((length*100LL)/fragmentSize));
+          printInfo(2,"%3d%%\b\b\b\b",(uint)((length*100LL)/dataSize));
         }
         if      (error != ERROR_NONE)
         {
@@ -2753,6 +3270,23 @@ LOCAL Errors restoreHardLinkEntry(RestoreInfo   *restoreInfo,
           }
         }
 
+        // create holes of sparse file
+        if (!restoreInfo->jobOptions->dryRun)
+        {
+          error = restoreHoles(&fileHandle,&fileHoleList,restoreInfo->jobOptions->sparseFlag,buffer,bufferSize);
+          if (error != ERROR_NONE)
+          {
+            printInfo(1,"FAIL!\n");
+            printError(_("cannot write content of hard link '%s' (error: %s)"),
+                       String_cString(destinationFileName),
+                       Error_getText(error)
+                      );
+            error = handleError(restoreInfo,archiveHandle->printableStorageName,destinationFileName,error);
+            AutoFree_cleanup(&autoFreeList);
+            return error;
+          }
+        }
+
         // close file
         if (!restoreInfo->jobOptions->dryRun)
         {
@@ -2970,6 +3504,7 @@ LOCAL Errors restoreHardLinkEntry(RestoreInfo   *restoreInfo,
   }
 
   // free resources
+  File_doneHoles(&fileHoleList);
   File_doneExtendedAttributes(&fileExtendedAttributeList);
   StringList_done(&fileNameList);
   AutoFree_done(&autoFreeList);
@@ -3325,6 +3860,7 @@ LOCAL Errors restoreEntry(ArchiveHandle     *archiveHandle,
       break;
     case ARCHIVE_ENTRY_TYPE_SALT:
     case ARCHIVE_ENTRY_TYPE_KEY:
+    case ARCHIVE_ENTRY_TYPE_SOLID:
     case ARCHIVE_ENTRY_TYPE_SIGNATURE:
       #ifndef NDEBUG
         HALT_INTERNAL_ERROR_UNREACHABLE();
@@ -3458,23 +3994,158 @@ LOCAL void restoreThreadCode(RestoreInfo *restoreInfo)
     freeEntryMsg(&entryMsg,NULL);
   }
 
+  // free pooled compress/crypt contexts of thread
+  Compress_doneThreadContexts();
+  Crypt_doneThreadContexts();
+
   // free resources
 }
 
+/***********************************************************************\
+* Name   : restoreTOCEntries
+* Purpose: restore included entries of archive via table of contents
+* Input  : restoreInfo        - restore info
+*          archiveHandle      - archive handle
+*          tocList            - table of contents of archive
+*          restoreThreadCount - number of restore threads
+*          buffer             - buffer for temporary data or NULL if
+*                               restore threads are used
+*          bufferSize         - size of data buffer
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : only entries matching the include/exclude lists are read;
+*          all other entries are not read from the storage
+\***********************************************************************/
+
+LOCAL Errors restoreTOCEntries(RestoreInfo          *restoreInfo,
+                               ArchiveHandle        *archiveHandle,
+                               const ArchiveTOCList *tocList,
+                               uint                 restoreThreadCount,
+                               byte                 *buffer,
+                               uint                 bufferSize
+                              )
+{
+  assert(restoreInfo != NULL);
+  assert(restoreInfo->includeEntryList != NULL);
+  assert(restoreInfo->jobOptions != NULL);
+  assert(archiveHandle != NULL);
+  assert(tocList != NULL);
+
+  Errors               error      = ERROR_NONE;
+  uint64               lastOffset = MAX_UINT64;
+  const ArchiveTOCNode *tocNode   = tocList->head;
+  while (   ((restoreInfo->failError == ERROR_NONE) || restoreInfo->jobOptions->noStopOnErrorFlag)
+         && ((restoreInfo->isAbortedFunction == NULL) || !restoreInfo->isAbortedFunction(restoreInfo->isAbortedUserData))
+         && (tocNode != NULL)
+        )
+  {
+    // pause
+    while ((restoreInfo->isPauseFunction != NULL) && restoreInfo->isPauseFunction(restoreInfo->isPauseUserData))
+    {
+      Misc_udelay(500L*US_PER_MS);
+    }
+
+    // check if entry is included (Note: names of a hard link refer to the same entry)
+    if (   (tocNode->offset != lastOffset)
+        && EntryList_match(restoreInfo->includeEntryList,tocNode->name,PATTERN_MATCH_MODE_EXACT)
+        && ((restoreInfo->excludePatternList == NULL) || !PatternList_match(restoreInfo->excludePatternList,tocNode->name,PATTERN_MATCH_MODE_EXACT))
+       )
+    {
+      // seek to entry
+      ArchiveEntryTypes archiveEntryType;
+      ArchiveCryptInfo  *archiveCryptInfo;
+      error = Archive_seek(archiveHandle,tocNode->offset);
+      if (error == ERROR_NONE)
+      {
+        error = Archive_getNextArchiveEntry(archiveHandle,
+                                            &archiveEntryType,
+                                            &archiveCryptInfo,
+                                            NULL,  // offset
+                                            NULL  // size
+                                           );
+      }
+      if ((error == ERROR_NONE) && (archiveEntryType != tocNode->type))
+      {
+        error = ERRORX_(CORRUPT_DATA,0,"%s",String_cString(archiveHandle->printableStorageName));
+      }
+      if (error != ERROR_NONE)
+      {
+        printError(_("cannot read next entry from storage '%s' (error: %s)!"),
+                   String_cString(archiveHandle->printableStorageName),
+                   Error_getText(error)
+                  );
+        if (restoreInfo->failError == ERROR_NONE)
+        {
+          restoreInfo->failError = handleError(restoreInfo,archiveHandle->printableStorageName,NULL,error);
+        }
+        break;
+      }
+
+      // update storage status
+      SEMAPHORE_LOCKED_DO(&restoreInfo->runningInfoLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+      {
+        restoreInfo->runningInfo.progress.storage.doneSize = tocNode->offset;
+        updateRunningInfo(restoreInfo,TRUE);
+      }
+
+      // restore entry
+      if (restoreThreadCount > 1)
+      {
+        // send entry to restore threads
+        EntryMsg entryMsg;
+        entryMsg.archiveIndex     = 1;
+        entryMsg.archiveHandle    = archiveHandle;
+        entryMsg.archiveEntryType = archiveEntryType;
+        entryMsg.archiveCryptInfo = archiveCryptInfo;
+        entryMsg.offset           = tocNode->offset;
+        if (!MsgQueue_put(&restoreInfo->entryMsgQueue,&entryMsg,sizeof(entryMsg)))
+        {
+          HALT_INTERNAL_ERROR("Send message to restore threads fail!");
+        }
+      }
+      else
+      {
+        error = restoreEntry(archiveHandle,
+                             archiveEntryType,
+                             restoreInfo,
+                             buffer,
+                             bufferSize
+                            );
+      }
+
+      lastOffset = tocNode->offset;
+    }
+
+    tocNode = tocNode->next;
+  }
+
+  // update storage status
+  SEMAPHORE_LOCKED_DO(&restoreInfo->runningInfoLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  {
+    restoreInfo->runningInfo.progress.storage.doneSize = Archive_getSize(archiveHandle);
+    updateRunningInfo(restoreInfo,TRUE);
+  }
+
+  return error;
+}
+
 /***********************************************************************\
 * Name   : restoreArchive
 * Purpose: restore archive content
 * Input  : restoreInfo      - restore info
 *          storageSpecifier - storage to restore from
 *          archiveName      - archive name to restore from or NULL
+*          entryTOCList     - entries to restore sorted by offset or
+*                             NULL to read entries from archive
 * Output : -
 * Return : -
 * Notes  : -
 \***********************************************************************/
 
-LOCAL Errors restoreArchive(RestoreInfo      *restoreInfo,
-                            StorageSpecifier *storageSpecifier,
-                            ConstString       archiveName
+LOCAL Errors restoreArchive(RestoreInfo          *restoreInfo,
+                            StorageSpecifier     *storageSpecifier,
+                            ConstString          archiveName,
+                            const ArchiveTOCList *entryTOCList
                            )
 {
   Errors error;
@@ -3641,11 +4312,58 @@ NULL, // masterIO
     AUTOFREE_ADD(&autoFreeList,buffer,{ free(buffer); });
   }
 
+  // read included entries directly via known offsets (if available)
+  bool tocFlag = FALSE;
+  if ((entryTOCList != NULL) && !List_isEmpty(entryTOCList))
+  {
+    if (Archive_seekEntry(&archiveHandle,entryTOCList->head->offset) == ERROR_NONE)
+    {
+      (void)restoreTOCEntries(restoreInfo,
+                              &archiveHandle,
+                              entryTOCList,
+                              restoreThreadCount,
+                              buffer,
+                              BUFFER_SIZE
+                             );
+      tocFlag = TRUE;
+    }
+    else
+    {
+      // read all archive entries
+      (void)Archive_seek(&archiveHandle,0LL);
+    }
+  }
+
+  // read included entries directly via table of contents (if available)
+  if (!tocFlag && !List_isEmpty(restoreInfo->includeEntryList))
+  {
+    ArchiveTOCList tocList;
+    Archive_initTOCList(&tocList);
+    if (Archive_readTOC(&archiveHandle,&tocList) == ERROR_NONE)
+    {
+      (void)restoreTOCEntries(restoreInfo,
+                              &archiveHandle,
+                              &tocList,
+                              restoreThreadCount,
+                              buffer,
+                              BUFFER_SIZE
+                             );
+      tocFlag = TRUE;
+    }
+    else
+    {
+      // read all archive entries
+      (void)Archive_seek(&archiveHandle,0LL);
+    }
+    Archive_doneTOCList(&tocList);
+  }
+
   // read archive entries
   error                  = ERROR_NONE;
   CryptSignatureStates allCryptSignatureState = CRYPT_SIGNATURE_STATE_NONE;
   uint64               lastSignatureOffset    = Archive_tell(&archiveHandle);
-  while (   ((restoreInfo->failError == ERROR_NONE) || restoreInfo->jobOptions->noStopOnErrorFlag)
+  while (   !tocFlag
+         && ((restoreInfo->failError == ERROR_NONE) || restoreInfo->jobOptions->noStopOnErrorFlag)
          && ((restoreInfo->isAbortedFunction == NULL) || !restoreInfo->isAbortedFunction(restoreInfo->isAbortedUserData))
          && (restoreInfo->jobOptions->skipVerifySignaturesFlag || Crypt_isValidSignatureState(allCryptSignatureState))
          && !Archive_eof(&archiveHandle)
@@ -3769,6 +4487,9 @@ NULL, // masterIO
   // done storage
   (void)Storage_done(&storageInfo);
 
+  // restore deduplicated files with restored referenced files
+  restoreFileReferences(restoreInfo,FALSE);
+
   // output info
   if (!isPrintInfo(1))
   {
@@ -3808,78 +4529,142 @@ NULL, // masterIO
   return restoreInfo->failError;
 }
 
-/*---------------------------------------------------------------------*/
+/***********************************************************************\
+* Name   : freeRestoreEntryOffsetNode
+* Purpose: free restore entry offset node
+* Input  : restoreEntryOffsetNode - restore entry offset node
+*          userData               - user data (not used)
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
 
-Errors Command_restore(const StringList           *storageNameList,
-                       const EntryList            *includeEntryList,
-                       const PatternList          *excludePatternList,
-                       JobOptions                 *jobOptions,
-                       RestoreRunningInfoFunction restoreRunningInfoFunction,
-                       void                       *restoreRunningInfoUserData,
-                       RestoreErrorHandlerFunction restoreErrorHandlerFunction,
-                       void                       *restoreErrorHandlerUserData,
-                       GetNamePasswordFunction    getNamePasswordFunction,
-                       void                       *getNamePasswordUserData,
-                       IsPauseFunction            isPauseFunction,
-                       void                       *isPauseUserData,
-                       IsAbortedFunction          isAbortedFunction,
-                       void                       *isAbortedUserData,
-                       LogHandle                  *logHandle
-                      )
+LOCAL void freeRestoreEntryOffsetNode(RestoreEntryOffsetNode *restoreEntryOffsetNode, void *userData)
 {
-  Errors error;
+  assert(restoreEntryOffsetNode != NULL);
 
-  assert(storageNameList != NULL);
-  assert(includeEntryList != NULL);
-  assert(jobOptions != NULL);
+  UNUSED_VARIABLE(userData);
 
-  // init variables
-  StorageSpecifier storageSpecifier;
-  Storage_initSpecifier(&storageSpecifier);
+  String_delete(restoreEntryOffsetNode->entryName);
+  String_delete(restoreEntryOffsetNode->storageName);
+}
 
-  // init restore info
-  RestoreInfo restoreInfo;
-  initRestoreInfo(&restoreInfo,
-                  &storageSpecifier,
-                  includeEntryList,
-                  excludePatternList,
-                  jobOptions,
-                  CALLBACK_(restoreRunningInfoFunction,restoreRunningInfoUserData),
-                  CALLBACK_(restoreErrorHandlerFunction,restoreErrorHandlerUserData),
-                  CALLBACK_(getNamePasswordFunction,getNamePasswordUserData),
-                  CALLBACK_(isPauseFunction,isPauseUserData),
-                  CALLBACK_(isAbortedFunction,isAbortedUserData),
-                  logHandle
-                 );
+/***********************************************************************\
+* Name   : compareTOCNodeOffset
+* Purpose: compare offsets of table of contents nodes
+* Input  : tocNode1, tocNode2 - table of contents nodes
+*          userData           - user data (not used)
+* Output : -
+* Return : -1/0/1 if offset 1 </=/> offset 2
+* Notes  : -
+\***********************************************************************/
 
-  // restore
-  SEMAPHORE_LOCKED_DO(&restoreInfo.runningInfoLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+LOCAL int compareTOCNodeOffset(const ArchiveTOCNode *tocNode1, const ArchiveTOCNode *tocNode2, void *userData)
+{
+  assert(tocNode1 != NULL);
+  assert(tocNode2 != NULL);
+
+  UNUSED_VARIABLE(userData);
+
+  if      (tocNode1->offset < tocNode2->offset) return -1;
+  else if (tocNode1->offset > tocNode2->offset) return  1;
+  else                                          return  0;
+}
+
+/***********************************************************************\
+* Name   : getEntryTOCList
+* Purpose: get entries to restore from storage with known offsets
+* Input  : restoreEntryOffsetList - offsets of entries to restore
+*          storageName            - storage name
+* Output : entryTOCList - entries to restore sorted by offset
+* Return : TRUE iff entries to restore from storage exists and the
+*          offsets of all of them are known
+* Notes  : -
+\***********************************************************************/
+
+LOCAL bool getEntryTOCList(ArchiveTOCList               *entryTOCList,
+                           const RestoreEntryOffsetList *restoreEntryOffsetList,
+                           ConstString                  storageName
+                          )
+{
+  assert(entryTOCList != NULL);
+  assert(restoreEntryOffsetList != NULL);
+
+  List_clear(entryTOCList);
+
+  const RestoreEntryOffsetNode *restoreEntryOffsetNode;
+  LIST_ITERATE(restoreEntryOffsetList,restoreEntryOffsetNode)
   {
-    restoreInfo.runningInfo.progress.done.count = 0L;
-    restoreInfo.runningInfo.progress.done.size  = 0LL;
-    updateRunningInfo(&restoreInfo,TRUE);
+    if (String_equals(restoreEntryOffsetNode->storageName,storageName))
+    {
+      if (restoreEntryOffsetNode->offset == 0LL)
+      {
+        // unknown offset: read all archive entries
+        List_clear(entryTOCList);
+        return FALSE;
+      }
+
+      ArchiveTOCNode *tocNode = LIST_NEW_NODE(ArchiveTOCNode);
+      if (tocNode == NULL)
+      {
+        HALT_INSUFFICIENT_MEMORY();
+      }
+      tocNode->type           = restoreEntryOffsetNode->entryType;
+      tocNode->name           = String_duplicate(restoreEntryOffsetNode->entryName);
+      tocNode->offset         = restoreEntryOffsetNode->offset;
+      tocNode->fragmentOffset = 0LL;
+      tocNode->fragmentSize   = 0LL;
+      List_append(entryTOCList,tocNode);
+    }
   }
-  error                        = ERROR_NONE;
+  List_sort(entryTOCList,CALLBACK_((ListNodeCompareFunction)compareTOCNodeOffset,NULL));
+
+  return !List_isEmpty(entryTOCList);
+}
+
+/***********************************************************************\
+* Name   : restoreStorages
+* Purpose: restore content of storages
+* Input  : restoreInfo      - restore info
+*          storageNameList  - list with storage names
+*          restoreEntryOffsetList - offsets of entries to restore or
+*                                   NULL
+* Output : -
+* Return : TRUE iff some storage found, FALSE otherwise
+* Notes  : errors are stored in restoreInfo->failError
+\***********************************************************************/
+
+LOCAL bool restoreStorages(RestoreInfo                  *restoreInfo,
+                           const StringList             *storageNameList,
+                           const RestoreEntryOffsetList *restoreEntryOffsetList
+                          )
+{
+  assert(restoreInfo != NULL);
+  assert(restoreInfo->storageSpecifier != NULL);
+  assert(restoreInfo->jobOptions != NULL);
+  assert(storageNameList != NULL);
+
+  Errors      error            = ERROR_NONE;
   bool        abortFlag        = FALSE;
   bool        someStorageFound = FALSE;
   ConstString storageName;
   STRINGLIST_ITERATE(storageNameList,storageName)
   {
     // pause
-    while ((isPauseFunction != NULL) && isPauseFunction(isPauseUserData))
+    while ((restoreInfo->isPauseFunction != NULL) && restoreInfo->isPauseFunction(restoreInfo->isPauseUserData))
     {
       Misc_udelay(500L*US_PER_MS);
     }
 
     // parse storage name
-    error = Storage_parseName(&storageSpecifier,storageName);
+    error = Storage_parseName(restoreInfo->storageSpecifier,storageName);
     if (error != ERROR_NONE)
     {
       printError(_("invalid storage '%s' (error: %s)"),
                  String_cString(storageName),
                  Error_getText(error)
                 );
-      if (restoreInfo.failError == ERROR_NONE) restoreInfo.failError = error;
+      if (restoreInfo->failError == ERROR_NONE) restoreInfo->failError = error;
       continue;
     }
 
@@ -3888,16 +4673,23 @@ Errors Command_restore(const StringList           *storageNameList,
     // try restore archive content
     if (error != ERROR_NONE)
     {
-      if (String_isEmpty(storageSpecifier.archivePatternString))
+      if (String_isEmpty(restoreInfo->storageSpecifier->archivePatternString))
       {
+        // get entries to restore with known offsets
+        ArchiveTOCList entryTOCList;
+        Archive_initTOCList(&entryTOCList);
+        bool entryTOCFlag = (restoreEntryOffsetList != NULL) && getEntryTOCList(&entryTOCList,restoreEntryOffsetList,storageName);
+
         // restore archive content
-        error = restoreArchive(&restoreInfo,
-                               &storageSpecifier,
-                               NULL  // archiveName
+        error = restoreArchive(restoreInfo,
+                               restoreInfo->storageSpecifier,
+                               NULL,  // archiveName
+                               entryTOCFlag ? &entryTOCList : NULL
                               );
+        Archive_doneTOCList(&entryTOCList);
         if (error != ERROR_NONE)
         {
-          if (restoreInfo.failError == ERROR_NONE) restoreInfo.failError = error;
+          if (restoreInfo->failError == ERROR_NONE) restoreInfo->failError = error;
         }
         someStorageFound = TRUE;
       }
@@ -3909,9 +4701,9 @@ Errors Command_restore(const StringList           *storageNameList,
       // restore all matching archives content
       StorageDirectoryListHandle storageDirectoryListHandle;
       error = Storage_openDirectoryList(&storageDirectoryListHandle,
-                                        &storageSpecifier,
+                                        restoreInfo->storageSpecifier,
                                         NULL,  // archiveName
-                                        jobOptions,
+                                        restoreInfo->jobOptions,
                                         SERVER_CONNECTION_PRIORITY_HIGH
                                        );
       if (error == ERROR_NONE)
@@ -3927,24 +4719,25 @@ Errors Command_restore(const StringList           *storageNameList,
           }
 
           // match pattern
-          if (!String_isEmpty(storageSpecifier.archivePatternString))
+          if (!String_isEmpty(restoreInfo->storageSpecifier->archivePatternString))
           {
-            if (!Pattern_match(&storageSpecifier.archivePattern,fileName,STRING_BEGIN,PATTERN_MATCH_MODE_EXACT,NULL,NULL))
+            if (!Pattern_match(&restoreInfo->storageSpecifier->archivePattern,fileName,STRING_BEGIN,PATTERN_MATCH_MODE_EXACT,NULL,NULL))
             {
               continue;
             }
           }
 
           // restore archive content
-          error = restoreArchive(&restoreInfo,
-                                 &storageSpecifier,
-                                 fileName
+          error = restoreArchive(restoreInfo,
+                                 restoreInfo->storageSpecifier,
+                                 fileName,
+                                 NULL  // entryTOCList
                                 );
           if (error != ERROR_NONE)
           {
-            if (restoreInfo.failError == ERROR_NONE)
+            if (restoreInfo->failError == ERROR_NONE)
             {
-              restoreInfo.failError = error;
+              restoreInfo->failError = error;
             }
           }
           someStorageFound = TRUE;
@@ -3956,28 +4749,241 @@ Errors Command_restore(const StringList           *storageNameList,
     }
 
     if (   abortFlag
-        || ((isAbortedFunction != NULL) && isAbortedFunction(isAbortedUserData))
-        || (restoreInfo.failError != ERROR_NONE)
+        || ((restoreInfo->isAbortedFunction != NULL) && restoreInfo->isAbortedFunction(restoreInfo->isAbortedUserData))
+        || (restoreInfo->failError != ERROR_NONE)
        )
     {
       break;
     }
 
     // update statuss
-    SEMAPHORE_LOCKED_DO(&restoreInfo.runningInfoLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+    SEMAPHORE_LOCKED_DO(&restoreInfo->runningInfoLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
     {
-      restoreInfo.runningInfo.progress.done.count++;
+      restoreInfo->runningInfo.progress.done.count++;
 //TODO: done size?
-//      restoreInfo.runningInfo.done.size;
-      updateRunningInfo(&restoreInfo,TRUE);
+//      restoreInfo->runningInfo.done.size;
+      updateRunningInfo(restoreInfo,TRUE);
+    }
+  }
+
+  return someStorageFound;
+}
+
+/***********************************************************************\
+* Name   : restoreReferencedFiles
+* Purpose: restore deduplicated files where the referenced file is not
+*          restored
+* Input  : restoreInfo     - restore info
+*          storageNameList - list with storage names
+* Output : -
+* Return : -
+* Notes  : the referenced files (e.g. excluded by include patterns) are
+*          restored into a temporary directory in a second pass over
+*          the storages and the deduplicated files are copied from
+*          there; errors are stored in restoreInfo->failError
+\***********************************************************************/
+
+LOCAL void restoreReferencedFiles(RestoreInfo      *restoreInfo,
+                                  const StringList *storageNameList
+                                 )
+{
+  Errors error;
+
+  assert(restoreInfo != NULL);
+  assert(restoreInfo->jobOptions != NULL);
+  assert(storageNameList != NULL);
+
+  // get include list with referenced files (Note: exact names, regular expression special characters escaped)
+  EntryList includeEntryList;
+  EntryList_init(&includeEntryList);
+  String pattern = String_new();
+  SEMAPHORE_LOCKED_DO(&restoreInfo->fileReferenceListLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  {
+    const FileReferenceNode *fileReferenceNode;
+    LIST_ITERATE(&restoreInfo->fileReferenceList,fileReferenceNode)
+    {
+      String_clear(pattern);
+      for (ulong i = 0; i < String_length(fileReferenceNode->referenceName); i++)
+      {
+        char ch = String_index(fileReferenceNode->referenceName,i);
+        if (strchr(".*?+[](){}^$|\\",ch) != NULL)
+        {
+          String_appendChar(pattern,'\\');
+        }
+        String_appendChar(pattern,ch);
+      }
+      (void)EntryList_append(&includeEntryList,ENTRY_STORE_TYPE_FILE,pattern,PATTERN_TYPE_REGEX,NULL);
     }
   }
+  String_delete(pattern);
+
+  // create temporary directory
+  String tmpDirectory = String_new();
+  error = File_getTmpDirectoryName(tmpDirectory,"bar",globalOptions.tmpDirectory);
+  if (error != ERROR_NONE)
+  {
+    printError(_("cannot create temporary directory in '%s' (error: %s)!"),
+               String_cString(globalOptions.tmpDirectory),
+               Error_getText(error)
+              );
+    if (restoreInfo->failError == ERROR_NONE) restoreInfo->failError = error;
+    String_delete(tmpDirectory);
+    EntryList_done(&includeEntryList);
+    return;
+  }
+
+  // restore referenced files into temporary directory
+  JobOptions jobOptions;
+  Job_copyOptions(&jobOptions,restoreInfo->jobOptions);
+  String_set(jobOptions.destination,tmpDirectory);
+  StorageSpecifier storageSpecifier;
+  Storage_initSpecifier(&storageSpecifier);
+  RestoreInfo referenceRestoreInfo;
+  initRestoreInfo(&referenceRestoreInfo,
+                  &storageSpecifier,
+                  &includeEntryList,
+                  NULL,  // excludePatternList
+                  &jobOptions,
+                  CALLBACK_(NULL,NULL),  // restoreRunningInfo
+                  CALLBACK_(restoreInfo->restoreErrorHandlerFunction,restoreInfo->restoreErrorHandlerUserData),
+                  CALLBACK_(restoreInfo->getNamePasswordFunction,restoreInfo->getNamePasswordUserData),
+                  CALLBACK_(restoreInfo->isPauseFunction,restoreInfo->isPauseUserData),
+                  CALLBACK_(restoreInfo->isAbortedFunction,restoreInfo->isAbortedUserData),
+                  restoreInfo->logHandle
+                 );
+  SEMAPHORE_LOCKED_DO(&restoreInfo->fileReferenceListLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  {
+    List_move(&referenceRestoreInfo.fileReferenceList,NULL,&restoreInfo->fileReferenceList,NULL,NULL);
+  }
+  (void)restoreStorages(&referenceRestoreInfo,storageNameList,NULL);
+
+  // restore remaining deduplicated files
+  if (referenceRestoreInfo.failError == ERROR_NONE)
+  {
+    restoreFileReferences(&referenceRestoreInfo,TRUE);
+  }
+  if (restoreInfo->failError == ERROR_NONE) restoreInfo->failError = referenceRestoreInfo.failError;
+
+  // free resources
+  doneRestoreInfo(&referenceRestoreInfo);
+  Storage_doneSpecifier(&storageSpecifier);
+  Job_doneOptions(&jobOptions);
+  (void)File_delete(tmpDirectory,TRUE);
+  String_delete(tmpDirectory);
+  EntryList_done(&includeEntryList);
+}
+
+/*---------------------------------------------------------------------*/
+
+void Command_initRestoreEntryOffsetList(RestoreEntryOffsetList *restoreEntryOffsetList)
+{
+  assert(restoreEntryOffsetList != NULL);
+
+  List_init(restoreEntryOffsetList,CALLBACK_(NULL,NULL),CALLBACK_((ListNodeFreeFunction)freeRestoreEntryOffsetNode,NULL));
+}
+
+void Command_doneRestoreEntryOffsetList(RestoreEntryOffsetList *restoreEntryOffsetList)
+{
+  assert(restoreEntryOffsetList != NULL);
+
+  List_done(restoreEntryOffsetList);
+}
+
+void Command_addRestoreEntryOffset(RestoreEntryOffsetList *restoreEntryOffsetList,
+                                   ConstString            storageName,
+                                   ArchiveEntryTypes      entryType,
+                                   ConstString            entryName,
+                                   uint64                 offset
+                                  )
+{
+  assert(restoreEntryOffsetList != NULL);
+  assert(storageName != NULL);
+  assert(entryName != NULL);
+
+  RestoreEntryOffsetNode *restoreEntryOffsetNode = LIST_NEW_NODE(RestoreEntryOffsetNode);
+  if (restoreEntryOffsetNode == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  restoreEntryOffsetNode->storageName = String_duplicate(storageName);
+  restoreEntryOffsetNode->entryType   = entryType;
+  restoreEntryOffsetNode->entryName   = String_duplicate(entryName);
+  restoreEntryOffsetNode->offset      = offset;
+  List_append(restoreEntryOffsetList,restoreEntryOffsetNode);
+}
+
+Errors Command_restore(const StringList           *storageNameList,
+                       const EntryList            *includeEntryList,
+                       const PatternList          *excludePatternList,
+                       const RestoreEntryOffsetList *restoreEntryOffsetList,
+                       JobOptions                 *jobOptions,
+                       RestoreRunningInfoFunction restoreRunningInfoFunction,
+                       void                       *restoreRunningInfoUserData,
+                       RestoreErrorHandlerFunction restoreErrorHandlerFunction,
+                       void                       *restoreErrorHandlerUserData,
+                       GetNamePasswordFunction    getNamePasswordFunction,
+                       void                       *getNamePasswordUserData,
+                       IsPauseFunction            isPauseFunction,
+                       void                       *isPauseUserData,
+                       IsAbortedFunction          isAbortedFunction,
+                       void                       *isAbortedUserData,
+                       LogHandle                  *logHandle
+                      )
+{
+  Errors error;
+
+  assert(storageNameList != NULL);
+  assert(includeEntryList != NULL);
+  assert(jobOptions != NULL);
+
+  // init variables
+  StorageSpecifier storageSpecifier;
+  Storage_initSpecifier(&storageSpecifier);
+
+  // init restore info
+  RestoreInfo restoreInfo;
+  initRestoreInfo(&restoreInfo,
+                  &storageSpecifier,
+                  includeEntryList,
+                  excludePatternList,
+                  jobOptions,
+                  CALLBACK_(restoreRunningInfoFunction,restoreRunningInfoUserData),
+                  CALLBACK_(restoreErrorHandlerFunction,restoreErrorHandlerUserData),
+                  CALLBACK_(getNamePasswordFunction,getNamePasswordUserData),
+                  CALLBACK_(isPauseFunction,isPauseUserData),
+                  CALLBACK_(isAbortedFunction,isAbortedUserData),
+                  logHandle
+                 );
+
+  // restore
+  SEMAPHORE_LOCKED_DO(&restoreInfo.runningInfoLock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER)
+  {
+    restoreInfo.runningInfo.progress.done.count = 0L;
+    restoreInfo.runningInfo.progress.done.size  = 0LL;
+    updateRunningInfo(&restoreInfo,TRUE);
+  }
+  bool someStorageFound = restoreStorages(&restoreInfo,storageNameList,restoreEntryOffsetList);
   if ((restoreInfo.failError == ERROR_NONE) && !StringList_isEmpty(storageNameList) && !someStorageFound)
   {
     printError(_("no matching storage files found!"));
     restoreInfo.failError = ERROR_FILE_NOT_FOUND_;
   }
 
+  if (   (restoreInfo.failError == ERROR_NONE)
+      && ((isAbortedFunction == NULL) || !isAbortedFunction(isAbortedUserData))
+     )
+  {
+    // restore remaining deduplicated files
+    if (!List_isEmpty(&restoreInfo.fileReferenceList) && !jobOptions->dryRun)
+    {
+      restoreReferencedFiles(&restoreInfo,storageNameList);
+    }
+    else
+    {
+      restoreFileReferences(&restoreInfo,TRUE);
+    }
+  }
+
   if (   (restoreInfo.failError == ERROR_NONE)
       && !jobOptions->noFragmentsCheckFlag
      )
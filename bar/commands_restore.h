@@ -15,6 +15,7 @@
 #include <stdio.h>
 #include <assert.h>
 
+#include "common/lists.h"
 #include "common/stringlists.h"
 
 #include "bar_common.h"
@@ -22,6 +23,7 @@
 #include "common/patternlists.h"
 #include "deltasourcelists.h"
 #include "crypt.h"
+#include "archives.h"
 
 /****************** Conditional compilation switches *******************/
 
@@ -29,6 +31,22 @@
 
 /***************************** Datatypes *******************************/
 
+// offsets of entries to restore (e. g. from index database)
+typedef struct RestoreEntryOffsetNode
+{
+  LIST_NODE_HEADER(struct RestoreEntryOffsetNode);
+
+  String            storageName;
+  ArchiveEntryTypes entryType;
+  String            entryName;
+  uint64            offset;                          // offset of entry in archive or 0 if unknown
+} RestoreEntryOffsetNode;
+
+typedef struct
+{
+  LIST_HEADER(RestoreEntryOffsetNode);
+} RestoreEntryOffsetList;
+
 /***********************************************************************\
 * Name   : RestoreRunningInfoFunction
 * Purpose: restore running info call-back
@@ -72,12 +90,57 @@ typedef Errors(*RestoreErrorHandlerFunction)(ConstString storageName,
   extern "C" {
 #endif
 
+/***********************************************************************\
+* Name   : Command_initRestoreEntryOffsetList
+* Purpose: init restore entry offset list
+* Input  : -
+* Output : restoreEntryOffsetList - restore entry offset list
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+void Command_initRestoreEntryOffsetList(RestoreEntryOffsetList *restoreEntryOffsetList);
+
+/***********************************************************************\
+* Name   : Command_doneRestoreEntryOffsetList
+* Purpose: done restore entry offset list
+* Input  : restoreEntryOffsetList - restore entry offset list
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+void Command_doneRestoreEntryOffsetList(RestoreEntryOffsetList *restoreEntryOffsetList);
+
+/***********************************************************************\
+* Name   : Command_addRestoreEntryOffset
+* Purpose: add offset of entry to restore
+* Input  : restoreEntryOffsetList - restore entry offset list
+*          storageName            - storage name
+*          entryType              - archive entry type
+*          entryName              - entry name
+*          offset                 - offset of entry in archive or 0 if
+*                                   unknown
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+void Command_addRestoreEntryOffset(RestoreEntryOffsetList *restoreEntryOffsetList,
+                                   ConstString            storageName,
+                                   ArchiveEntryTypes      entryType,
+                                   ConstString            entryName,
+                                   uint64                 offset
+                                  );
+
 /***********************************************************************\
 * Name   : Command_restore
 * Purpose: restore archive content
 * Input  : storageNameList              - list with storage names
 *          includeEntryList             - include entry list
 *          excludePatternList           - exclude pattern list
+*          restoreEntryOffsetList       - offsets of entries to
+*                                         restore (can be NULL)
 *          jobOptions                   - job options
 *          restoreRunningInfoFunction   - running info call back
 *                                         function (can be NULL)
@@ -97,12 +160,16 @@ typedef Errors(*RestoreErrorHandlerFunction)(ConstString storageName,
 *          logHandle                    - log handle (can be NULL)
 * Output : -
 * Return : ERROR_NONE if all files restored, otherwise error code
-* Notes  : -
+* Notes  : if the offsets of all entries to restore from a storage
+*          are known, only these entries are read from the archive
+*          instead of scanning all entries, e. g. when entries to
+*          restore are selected from the index database
 \***********************************************************************/
 
 Errors Command_restore(const StringList           *storageNameList,
                        const EntryList            *includeEntryList,
                        const PatternList          *excludePatternList,
+                       const RestoreEntryOffsetList *restoreEntryOffsetList,
                        JobOptions                 *jobOptions,
                        RestoreRunningInfoFunction restoreRunningInfoFunction,
                        void                       *restoreRunningInfoUserData,
@@ -24,6 +24,7 @@
 #include "common/global.h"
 #include "common/cstrings.h"
 #include "common/autofree.h"
+#include "common/dictionaries.h"
 #include "common/strings.h"
 #include "common/stringlists.h"
 #include "common/msgqueues.h"
@@ -71,8 +72,10 @@ typedef struct
 
   MsgQueue                      entryMsgQueue;                      // queue with entries to store
 
-  Semaphore                     fragmentListLock;
+  Semaphore                     fragmentListLock;                   // lock for fragment list and name dictionaries
   FragmentList                  fragmentList;
+  Dictionary                    fileNamesDictionary;                // names of completely stored file entries
+  Dictionary                    referenceNamesDictionary;           // referenced name -> name of duplicate file entry
 
   Semaphore                     runningInfoLock;
   RunningInfo                   runningInfo;                        // running info
@@ -178,6 +181,8 @@ LOCAL void initTestInfo(TestInfo                      *testInfo,
     HALT_FATAL_ERROR("Cannot initialize fragment list semaphore!");
   }
   FragmentList_init(&testInfo->fragmentList);
+  Dictionary_init(&testInfo->fileNamesDictionary,DICTIONARY_BYTE_INIT_ENTRY,DICTIONARY_BYTE_DONE_ENTRY,DICTIONARY_BYTE_COMPARE_ENTRY);
+  Dictionary_init(&testInfo->referenceNamesDictionary,DICTIONARY_BYTE_INIT_ENTRY,DICTIONARY_BYTE_DONE_ENTRY,DICTIONARY_BYTE_COMPARE_ENTRY);
 
   if (!Semaphore_init(&testInfo->runningInfoLock,SEMAPHORE_TYPE_BINARY))
   {
@@ -218,6 +223,8 @@ LOCAL void doneTestInfo(TestInfo *testInfo)
   doneRunningInfo(&testInfo->runningInfo);
   Semaphore_done(&testInfo->runningInfoLock);
 
+  Dictionary_done(&testInfo->referenceNamesDictionary);
+  Dictionary_done(&testInfo->fileNamesDictionary);
   FragmentList_done(&testInfo->fragmentList);
   Semaphore_done(&testInfo->fragmentListLock);
 }
@@ -290,7 +297,10 @@ LOCAL Errors testFileEntry(TestInfo          *testInfo,
   ArchiveEntryInfo archiveEntryInfo;
   String           fileName = String_new();
   FileInfo         fileInfo;
+  FileHoleList     fileHoleList;
+  String           referenceName = String_new();
   uint64           fragmentOffset,fragmentSize;
+  File_initHoles(&fileHoleList);
   error = Archive_readFileEntry(&archiveEntryInfo,
                                 archiveHandle,
                                 NULL,  // deltaCompressAlgorithm
@@ -302,6 +312,8 @@ LOCAL Errors testFileEntry(TestInfo          *testInfo,
                                 fileName,
                                 &fileInfo,
                                 NULL,  // fileExtendedAttributeList
+                                &fileHoleList,
+                                referenceName,
                                 NULL,  // deltaSourceName
                                 NULL,  // deltaSourceSize
                                 &fragmentOffset,
@@ -313,6 +325,8 @@ LOCAL Errors testFileEntry(TestInfo          *testInfo,
                String_cString(archiveHandle->printableStorageName),
                Error_getText(error)
               );
+    File_doneHoles(&fileHoleList);
+    String_delete(referenceName);
     String_delete(fileName);
     return error;
   }
@@ -333,13 +347,14 @@ LOCAL Errors testFileEntry(TestInfo          *testInfo,
       updateRunningInfo(testInfo,FALSE);
     }
 
-    // read file content
+    // read file content (Note: data of holes is not stored)
+    uint64 dataSize = File_getDataSize(&fileHoleList,fragmentOffset,fragmentSize);
     uint64 length = 0LL;
     while (   ((testInfo->isAbortedFunction == NULL) || !testInfo->isAbortedFunction(testInfo->isAbortedUserData))
-           && (length < fragmentSize)
+           && (length < dataSize)
           )
     {
-      ulong n = (ulong)MIN(fragmentSize-length,bufferSize);
+      ulong n = (ulong)MIN(dataSize-length,bufferSize);
 
       // read archive file
       error = Archive_readData(&archiveEntryInfo,buffer,n);
@@ -364,11 +379,13 @@ LOCAL Errors testFileEntry(TestInfo          *testInfo,
         updateRunningInfo(testInfo,FALSE);
       }
 
-      printInfo(2,"%3u%%\b\b\b\b",(uint)((length*100LL)/fragmentSize));
+      printInfo(2,"%3u%%\b\b\b\b",(uint)((length*100LL)/dataSize));
     }
     if (error != ERROR_NONE)
     {
       (void)Archive_closeEntry(&archiveEntryInfo);
+      File_doneHoles(&fileHoleList);
+      String_delete(referenceName);
       String_delete(fileName);
       return error;
     }
@@ -386,7 +403,14 @@ LOCAL Errors testFileEntry(TestInfo          *testInfo,
     }
     char fragmentString[256];
     stringClear(fragmentString);
-    if (fragmentSize < fileInfo.size)
+    if (!String_isEmpty(referenceName))
+    {
+      stringFormat(fragmentString,sizeof(fragmentString),
+                   ", duplicate of '%s'",
+                   String_cString(referenceName)
+                  );
+    }
+    else if (fragmentSize < fileInfo.size)
     {
       stringFormat(fragmentString,sizeof(fragmentString),
                    ", fragment %*"PRIu64"..%*"PRIu64,
@@ -407,12 +431,31 @@ LOCAL Errors testFileEntry(TestInfo          *testInfo,
         }
         assert(fragmentNode != NULL);
 
-        // add fragment to file fragment list
+        // add fragment to file fragment list (data of a duplicate is stored complete in referenced file, checked when all entries are tested)
+        if (!String_isEmpty(referenceName))
+        {
+          FragmentList_addRange(fragmentNode,0LL,fileInfo.size);
+          Dictionary_add(&testInfo->referenceNamesDictionary,
+                         String_cString(referenceName),
+                         String_length(referenceName),
+                         String_cString(fileName),
+                         String_length(fileName)+1
+                        );
+        }
         FragmentList_addRange(fragmentNode,fragmentOffset,fragmentSize);
 
         // discard fragment list if file is complete
         if (FragmentList_isComplete(fragmentNode))
         {
+          if (String_isEmpty(referenceName))
+          {
+            Dictionary_add(&testInfo->fileNamesDictionary,
+                           String_cString(fileName),
+                           String_length(fileName),
+                           NULL,
+                           0
+                          );
+          }
           FragmentList_discard(fragmentList,fragmentNode);
         }
       }
@@ -433,6 +476,8 @@ LOCAL Errors testFileEntry(TestInfo          *testInfo,
       printInfo(1,"FAIL!\n");
       printError(_("unexpected data at end of file entry '%s'!"),String_cString(fileName));
       (void)Archive_closeEntry(&archiveEntryInfo);
+      File_doneHoles(&fileHoleList);
+      String_delete(referenceName);
       String_delete(fileName);
       return error;
     }
@@ -472,11 +517,15 @@ LOCAL Errors testFileEntry(TestInfo          *testInfo,
     printError(_("closing 'file' entry fail (error: %s)!"),
                Error_getText(error)
               );
+    File_doneHoles(&fileHoleList);
+    String_delete(referenceName);
     String_delete(fileName);
     return error;
   }
 
   // free resources
+  File_doneHoles(&fileHoleList);
+  String_delete(referenceName);
   String_delete(fileName);
 
   return ERROR_NONE;
@@ -999,7 +1048,9 @@ LOCAL Errors testHardLinkEntry(TestInfo          *testInfo,
   StringList       fileNameList;
   StringList_init(&fileNameList);
   FileInfo         fileInfo;
+  FileHoleList     fileHoleList;
   uint64           fragmentOffset,fragmentSize;
+  File_initHoles(&fileHoleList);
   error = Archive_readHardLinkEntry(&archiveEntryInfo,
                                     archiveHandle,
                                     NULL,  // deltaCompressAlgorithm
@@ -1011,6 +1062,7 @@ LOCAL Errors testHardLinkEntry(TestInfo          *testInfo,
                                     &fileNameList,
                                     &fileInfo,
                                     NULL,  // fileExtendedAttributeList
+                                    &fileHoleList,
                                     NULL,  // deltaSourceName
                                     NULL,  // deltaSourceSize
                                     &fragmentOffset,
@@ -1022,6 +1074,7 @@ LOCAL Errors testHardLinkEntry(TestInfo          *testInfo,
                String_cString(archiveHandle->printableStorageName),
                Error_getText(error)
               );
+    File_doneHoles(&fileHoleList);
     StringList_done(&fileNameList);
     return error;
   }
@@ -1069,13 +1122,14 @@ LOCAL Errors testHardLinkEntry(TestInfo          *testInfo,
 
       if (!testedDataFlag && (error == ERROR_NONE))
       {
-        // read hard link content
+        // read hard link content (Note: data of holes is not stored)
+        uint64 dataSize = File_getDataSize(&fileHoleList,fragmentOffset,fragmentSize);
         uint64 length = 0LL;
         while (   ((testInfo->isAbortedFunction == NULL) || !testInfo->isAbortedFunction(testInfo->isAbortedUserData))
-               && (length < fragmentSize)
+               && (length < dataSize)
               )
         {
-          ulong n = (ulong)MIN(fragmentSize-length,bufferSize);
+          ulong n = (ulong)MIN(dataSize-length,bufferSize);
 
           // read archive file
           error = Archive_readData(&archiveEntryInfo,buffer,n);
@@ -1100,7 +1154,7 @@ LOCAL Errors testHardLinkEntry(TestInfo          *testInfo,
             updateRunningInfo(testInfo,FALSE);
           }
 
-          printInfo(2,"%3u%%\b\b\b\b",(uint)((length*100LL)/fragmentSize));
+          printInfo(2,"%3u%%\b\b\b\b",(uint)((length*100LL)/dataSize));
         }
         if (error != ERROR_NONE)
         {
@@ -1185,6 +1239,7 @@ LOCAL Errors testHardLinkEntry(TestInfo          *testInfo,
   if (error != ERROR_NONE)
   {
     (void)Archive_closeEntry(&archiveEntryInfo);
+    File_doneHoles(&fileHoleList);
     StringList_done(&fileNameList);
     return error;
   }
@@ -1196,11 +1251,13 @@ LOCAL Errors testHardLinkEntry(TestInfo          *testInfo,
     printError(_("closing 'hard link' entry fail (error: %s)!"),
                Error_getText(error)
               );
+    File_doneHoles(&fileHoleList);
     StringList_done(&fileNameList);
     return error;
   }
 
   // free resources
+  File_doneHoles(&fileHoleList);
   StringList_done(&fileNameList);
 
   return ERROR_NONE;
@@ -1408,6 +1465,7 @@ LOCAL Errors testEntry(ArchiveHandle     *archiveHandle,
       break;
     case ARCHIVE_ENTRY_TYPE_SALT:
     case ARCHIVE_ENTRY_TYPE_KEY:
+    case ARCHIVE_ENTRY_TYPE_SOLID:
     case ARCHIVE_ENTRY_TYPE_SIGNATURE:
       #ifndef NDEBUG
         HALT_INTERNAL_ERROR_UNREACHABLE();
@@ -1552,6 +1610,10 @@ LOCAL void testThreadCode(TestInfo *testInfo)
     freeEntryMsg(&entryMsg,NULL);
   }
 
+  // free pooled compress/crypt contexts of thread
+  Compress_doneThreadContexts();
+  Crypt_doneThreadContexts();
+
   // free resources
   free(buffer);
 }
@@ -1628,7 +1690,12 @@ LOCAL Errors testArchive(TestInfo         *testInfo,
                        &storageInfo,
                        archiveName,
                        &testInfo->jobOptions->deltaSourceList,
-                       isPrintInfo(3) ? ARCHIVE_FLAG_PRINT_UNKNOWN_CHUNKS : ARCHIVE_FLAG_NONE,
+                         (isPrintInfo(3) ? ARCHIVE_FLAG_PRINT_UNKNOWN_CHUNKS : ARCHIVE_FLAG_NONE)
+                       | (   !testInfo->jobOptions->skipVerifySignaturesFlag
+                          && !testInfo->jobOptions->forceVerifySignaturesFlag
+                           ? ARCHIVE_FLAG_VERIFY_SIGNATURES
+                           : ARCHIVE_FLAG_NONE
+                         ),
                        CALLBACK_(testInfo->getNamePasswordFunction,testInfo->getNamePasswordUserData),
                        testInfo->logHandle
                       );
@@ -1644,48 +1711,31 @@ LOCAL Errors testArchive(TestInfo         *testInfo,
   DEBUG_TESTCODE() { (void)Archive_close(&archiveHandle,FALSE); (void)Storage_done(&storageInfo); return DEBUG_TESTCODE_ERROR(); }
   AUTOFREE_ADD(&autoFreeList,&archiveHandle,{ (void)Archive_close(&archiveHandle,FALSE); });
 
-  // check signatures
-  if (!testInfo->jobOptions->skipVerifySignaturesFlag)
+  // check signatures before any entry is tested if verification is forced (Note: else signatures are checked while entries are read)
+  CryptSignatureStates allCryptSignatureState = CRYPT_SIGNATURE_STATE_NONE;
+  if (!testInfo->jobOptions->skipVerifySignaturesFlag && testInfo->jobOptions->forceVerifySignaturesFlag)
   {
-    CryptSignatureStates allCryptSignatureState;
     error = Archive_verifySignatures(&archiveHandle,
                                      &allCryptSignatureState
                                     );
     if (error != ERROR_NONE)
     {
-      if (!testInfo->jobOptions->forceVerifySignaturesFlag && (Error_getCode(error) == ERROR_CODE_NO_PUBLIC_SIGNATURE_KEY))
-      {
-        allCryptSignatureState = CRYPT_SIGNATURE_STATE_SKIPPED;
-      }
-      else
-      {
-        // signature error
-        printError(_("cannot verify signatures '%s' (error: %s)!"),
-                   String_cString(printableStorageName),
-                   Error_getText(error)
-                  );
-        AutoFree_cleanup(&autoFreeList);
-        return error;
-      }
+      // signature error
+      printError(_("cannot verify signatures '%s' (error: %s)!"),
+                 String_cString(printableStorageName),
+                 Error_getText(error)
+                );
+      AutoFree_cleanup(&autoFreeList);
+      return error;
     }
     if (!Crypt_isValidSignatureState(allCryptSignatureState))
     {
-      if (testInfo->jobOptions->forceVerifySignaturesFlag)
-      {
-        // signature error
-        printError(_("invalid signature in '%s'!"),
-                   String_cString(printableStorageName)
-                  );
-        AutoFree_cleanup(&autoFreeList);
-        return ERROR_INVALID_SIGNATURE;
-      }
-      else
-      {
-        // print signature warning
-        printWarning(_("invalid signature in '%s'"),
-                     String_cString(printableStorageName)
-                    );
-      }
+      // signature error
+      printError(_("invalid signature in '%s'!"),
+                 String_cString(printableStorageName)
+                );
+      AutoFree_cleanup(&autoFreeList);
+      return ERROR_INVALID_SIGNATURE;
     }
   }
 
@@ -1727,12 +1777,14 @@ LOCAL Errors testArchive(TestInfo         *testInfo,
     AUTOFREE_ADD(&autoFreeList,buffer,{ free(buffer); });
   }
 
-  // read archive entries
+  // read archive entries and check signatures (Note: signature hash is calculated while entries are read)
   error = ERROR_NONE;
-  CryptSignatureStates allCryptSignatureState = CRYPT_SIGNATURE_STATE_NONE;
-  uint64               lastSignatureOffset    = Archive_tell(&archiveHandle);
+  uint64 lastSignatureOffset = Archive_tell(&archiveHandle);
   while (   ((testInfo->failError == ERROR_NONE) || !testInfo->jobOptions->noStopOnErrorFlag)
-         && (testInfo->jobOptions->skipVerifySignaturesFlag || Crypt_isValidSignatureState(allCryptSignatureState))
+         && (   testInfo->jobOptions->skipVerifySignaturesFlag
+             || Crypt_isValidSignatureState(allCryptSignatureState)
+             || (allCryptSignatureState == CRYPT_SIGNATURE_STATE_SKIPPED)
+            )
          && !Archive_eof(&archiveHandle)
          && ((testInfo->isAbortedFunction == NULL) || !testInfo->isAbortedFunction(testInfo->isAbortedUserData))
         )
@@ -1791,14 +1843,38 @@ LOCAL Errors testArchive(TestInfo         *testInfo,
                           buffer,
                           BUFFER_SIZE
                          );
+        if (error != ERROR_NONE)
+        {
+          if (testInfo->failError == ERROR_NONE) testInfo->failError = error;
+          break;
+        }
       }
     }
     else
     {
-      if (!testInfo->jobOptions->skipVerifySignaturesFlag)
+      if (   !testInfo->jobOptions->skipVerifySignaturesFlag
+          && !testInfo->jobOptions->forceVerifySignaturesFlag
+          && (allCryptSignatureState != CRYPT_SIGNATURE_STATE_SKIPPED)
+         )
       {
         // check signature
         error = Archive_verifySignatureEntry(&archiveHandle,lastSignatureOffset,&allCryptSignatureState);
+        if (error != ERROR_NONE)
+        {
+          if (Error_getCode(error) == ERROR_CODE_NO_PUBLIC_SIGNATURE_KEY)
+          {
+            allCryptSignatureState = CRYPT_SIGNATURE_STATE_SKIPPED;
+            error = ERROR_NONE;
+          }
+          else
+          {
+            // signature error
+            printError(_("cannot verify signatures '%s' (error: %s)!"),
+                       String_cString(printableStorageName),
+                       Error_getText(error)
+                      );
+          }
+        }
       }
       else
       {
@@ -1847,6 +1923,7 @@ LOCAL Errors testArchive(TestInfo         *testInfo,
                  (testInfo->failError == ERROR_NONE)
               && (   testInfo->jobOptions->skipVerifySignaturesFlag
                   || Crypt_isValidSignatureState(allCryptSignatureState)
+                  || (allCryptSignatureState == CRYPT_SIGNATURE_STATE_SKIPPED)
                  )
                 ? "OK\n"
                 : "FAIL!\n"
@@ -2073,6 +2150,29 @@ NULL,  //               requestedAbortFlag,
     }
   }
 
+  if (   (testInfo.failError == ERROR_NONE)
+      && !jobOptions->noFragmentsCheckFlag
+      && List_isEmpty(includeEntryList)
+      && List_isEmpty(excludePatternList)
+     )
+  {
+    // check referenced entries of duplicates (Note: only if all entries are tested)
+    DictionaryIterator dictionaryIterator;
+    Dictionary_initIterator(&dictionaryIterator,&testInfo.referenceNamesDictionary);
+    const void *keyData;
+    ulong      keyLength;
+    void       *data;
+    while (Dictionary_getNext(&dictionaryIterator,&keyData,&keyLength,&data,NULL))
+    {
+      if (!Dictionary_contains(&testInfo.fileNamesDictionary,keyData,keyLength))
+      {
+        printInfo(0,"Warning: referenced entry '%.*s' of '%s' not found\n",(int)keyLength,(const char*)keyData,(const char*)data);
+        if (testInfo.failError == ERROR_NONE) testInfo.failError = ERROR_ENTRY_INCOMPLETE;
+      }
+    }
+    Dictionary_doneIterator(&dictionaryIterator);
+  }
+
   // get error
 // TODO:
 #if 0
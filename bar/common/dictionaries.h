@@ -483,7 +483,7 @@ static inline bool Dictionary_getNextValue(DictionaryIterator *dictionaryIterato
 {
   assert(dictionaryIterator != NULL);
 
-  return Dictionary_getNext(dictionaryIterator,(void*)key,0,(void**)value,0);
+  return Dictionary_getNext(dictionaryIterator,(const void**)key,0,(void**)value,0);
 }
 
 /***********************************************************************\
@@ -47,6 +47,14 @@
 #if   defined(PLATFORM_LINUX)
   #include <linux/fs.h>
   #include <linux/magic.h>
+  #ifdef HAVE_FALLOCATE
+    #include <linux/falloc.h>
+  #endif /* HAVE_FALLOCATE */
+  #ifdef HAVE_LINUX_BTRFS_H
+    #include <endian.h>
+    #include <linux/btrfs.h>
+    #include <linux/btrfs_tree.h>
+  #endif /* HAVE_LINUX_BTRFS_H */
 #elif defined(PLATFORM_WINDOWS)
   #include <fileapi.h>
   #include <winsock2.h>  // Windows brain dead
@@ -64,8 +72,10 @@
 #include "common/devices.h"
 #include "errors.h"
 
-#ifndef NDEBUG
+#if !defined(NDEBUG) || defined(HAVE_STATX)
   #include <pthread.h>
+#endif /* !NDEBUG || HAVE_STATX */
+#ifndef NDEBUG
   #include "common/lists.h"
 #endif /* not NDEBUG */
 
@@ -121,6 +131,25 @@ LOCAL const struct
 
 #define DEBUG_MAX_CLOSED_LIST 100
 
+// local buffer sizes for extended attribute names/data
+#define XATTR_NAMES_BUFFER_SIZE 1024
+#define XATTR_DATA_BUFFER_SIZE  4096
+
+#ifdef HAVE_STATX
+  // file attributes reported by statx()
+  #define STATX_FILE_ATTRIBUTES (STATX_ATTR_COMPRESSED|STATX_ATTR_IMMUTABLE|STATX_ATTR_APPEND|STATX_ATTR_NODUMP)
+
+  // max. number of cached file systems
+  #define MAX_FILE_SYSTEM_CACHE 16
+#endif /* HAVE_STATX */
+
+#define READ_AHEAD_SIZE (4*MB)  // size of asynchronous read-ahead window
+
+// btrfs change generation: sub-volume info/root refs are available since Linux 4.18
+#if defined(PLATFORM_LINUX) && defined(HAVE_LINUX_BTRFS_H) && defined(BTRFS_IOC_GET_SUBVOL_INFO) && defined(BTRFS_IOC_GET_SUBVOL_ROOTREF)
+  #define HAVE_BTRFS_CHANGE_GENERATION
+#endif
+
 /***************************** Datatypes *******************************/
 #ifdef HAVE_LSEEK64
   #define SEEK(handle,offset,mode) lseek64(handle,offset,mode)
@@ -219,6 +248,18 @@ LOCAL const struct
   LOCAL DebugFileList       debugClosedFileList;
 #endif /* not NDEBUG */
 
+#ifdef HAVE_STATX
+  // file systems with attributes not reported by statx() (no compress)
+  LOCAL pthread_mutex_t fileSystemCacheLock = PTHREAD_MUTEX_INITIALIZER;
+  LOCAL struct
+  {
+    uint32 major,minor;                                              // device major/minor number
+    bool   statxAttributesFlag;                                      // TRUE iff statx() attributes are complete
+  }                     fileSystemCache[MAX_FILE_SYSTEM_CACHE];
+  LOCAL uint            fileSystemCacheCount = 0;
+  LOCAL uint            fileSystemCacheNext  = 0;
+#endif /* HAVE_STATX */
+
 /****************************** Macros *********************************/
 #ifndef NDEBUG
   #define FILE_CHECK_VALID(fileHandle) \
@@ -598,8 +639,9 @@ LOCAL Errors initFileHandle(const char *__fileName__,
         break; /* not reached */
     #endif /* NDEBUG */
   }
-  fileHandle->name        = String_newCString(fileName);;
-  fileHandle->mode        = fileMode;
+  fileHandle->name           = String_newCString(fileName);;
+  fileHandle->mode           = fileMode;
+  fileHandle->readAheadIndex = fileHandle->index;
   #if   defined(PLATFORM_LINUX)
     #ifndef NDEBUG
       fileHandle->deleteOnCloseFlag = FALSE;
@@ -609,6 +651,14 @@ LOCAL Errors initFileHandle(const char *__fileName__,
   #endif /* PLATFORM_... */
   StringList_init(&fileHandle->lineBufferList);
 
+  #ifdef HAVE_POSIX_FADVISE
+    if (IS_SET(fileMode,FILE_OPEN_READ_AHEAD))
+    {
+      // sequential access: use larger read-ahead of operating system (ignore errors)
+      (void)posix_fadvise(fileDescriptor,0,0,POSIX_FADV_SEQUENTIAL);
+    }
+  #endif /* HAVE_POSIX_FADVISE */
+
   #ifndef NDEBUG
     pthread_once(&debugFileInitFlag,debugFileInit);
 
@@ -790,6 +840,32 @@ LOCAL Errors doneFileHandle(const char  *__fileName__,
   return error;
 }
 
+/***********************************************************************\
+* Name   : readAhead
+* Purpose: request next read-ahead window if required
+* Input  : fileHandle - file handle
+* Output : -
+* Return : -
+* Notes  : the next window is requested when half of the current
+*          window is read, thus the operating system read data while
+*          the caller process data already read
+\***********************************************************************/
+
+LOCAL void readAhead(FileHandle *fileHandle)
+{
+  assert(fileHandle != NULL);
+
+  if ((fileHandle->index+READ_AHEAD_SIZE/2) >= fileHandle->readAheadIndex)
+  {
+    if (fileHandle->readAheadIndex < fileHandle->index)
+    {
+      fileHandle->readAheadIndex = fileHandle->index;
+    }
+    (void)File_readAhead(fileHandle,fileHandle->readAheadIndex,READ_AHEAD_SIZE);
+    fileHandle->readAheadIndex += READ_AHEAD_SIZE;
+  }
+}
+
 /***********************************************************************\
 * Name   : setAccessTime
 * Purpose: set atime
@@ -908,6 +984,204 @@ LOCAL bool parseMountListEntry(char *mountPointName, uint maxMountPointNameSize,
 }
 #endif /* PLATFORM_... */
 
+#ifdef HAVE_STATX
+/***********************************************************************\
+* Name   : setStatxAttributesComplete
+* Purpose: store if statx() reports all file attributes of a file
+*          system
+* Input  : major               - device major number
+*          minor               - device minor number
+*          statxAttributesFlag - TRUE iff all file attributes are
+*                                reported by statx()
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void setStatxAttributesComplete(uint32 major, uint32 minor, bool statxAttributesFlag)
+{
+  pthread_mutex_lock(&fileSystemCacheLock);
+  {
+    uint i = 0;
+    while ((i < fileSystemCacheCount) && ((fileSystemCache[i].major != major) || (fileSystemCache[i].minor != minor)))
+    {
+      i++;
+    }
+    if (i >= fileSystemCacheCount)
+    {
+      if (fileSystemCacheCount < MAX_FILE_SYSTEM_CACHE)
+      {
+        i = fileSystemCacheCount;
+        fileSystemCacheCount++;
+      }
+      else
+      {
+        i = fileSystemCacheNext;
+        fileSystemCacheNext = (fileSystemCacheNext+1) % MAX_FILE_SYSTEM_CACHE;
+      }
+    }
+    fileSystemCache[i].major               = major;
+    fileSystemCache[i].minor               = minor;
+    fileSystemCache[i].statxAttributesFlag = statxAttributesFlag;
+  }
+  pthread_mutex_unlock(&fileSystemCacheLock);
+}
+
+/***********************************************************************\
+* Name   : isStatxAttributesComplete
+* Purpose: check if statx() reports all file attributes of a file
+*          system
+* Input  : fileName - file name
+*          major    - device major number
+*          minor    - device minor number
+* Output : -
+* Return : TRUE iff all file attributes are reported by statx()
+* Notes  : the no-compress attribute (btrfs, f2fs) is only reported by
+*          FS_IOC_GETFLAGS; result is cached per device
+\***********************************************************************/
+
+LOCAL bool isStatxAttributesComplete(const char *fileName, uint32 major, uint32 minor)
+{
+  assert(fileName != NULL);
+
+  bool statxAttributesFlag = TRUE;
+  bool foundFlag           = FALSE;
+
+  pthread_mutex_lock(&fileSystemCacheLock);
+  {
+    for (uint i = 0; (i < fileSystemCacheCount) && !foundFlag; i++)
+    {
+      if ((fileSystemCache[i].major == major) && (fileSystemCache[i].minor == minor))
+      {
+        statxAttributesFlag = fileSystemCache[i].statxAttributesFlag;
+        foundFlag           = TRUE;
+      }
+    }
+  }
+  pthread_mutex_unlock(&fileSystemCacheLock);
+
+  if (!foundFlag)
+  {
+    #ifdef HAVE_STATFS
+      struct statfs fileSystemStat;
+      if (statfs(fileName,&fileSystemStat) != 0)
+      {
+        return FALSE;
+      }
+      #ifdef BTRFS_SUPER_MAGIC
+        if (fileSystemStat.f_type == BTRFS_SUPER_MAGIC) statxAttributesFlag = FALSE;
+      #endif
+      #ifdef F2FS_SUPER_MAGIC
+        if (fileSystemStat.f_type == F2FS_SUPER_MAGIC) statxAttributesFlag = FALSE;
+      #endif
+    #else /* not HAVE_STATFS */
+      UNUSED_VARIABLE(fileName);
+
+      statxAttributesFlag = FALSE;
+    #endif /* HAVE_STATFS */
+
+    setStatxAttributesComplete(major,minor,statxAttributesFlag);
+  }
+
+  return statxAttributesFlag;
+}
+#endif /* HAVE_STATX */
+
+/***********************************************************************\
+* Name   : statFile
+* Purpose: get file meta data and file attributes
+* Input  : fileName - file name
+* Output : fileStat           - file meta data
+*          fileAttributes     - file attributes
+*          fileAttributesFlag - TRUE iff file attributes are valid,
+*                               FALSE if attributes have to be read
+*                               with File_getAttributes()
+* Return : ERROR_NONE or error code
+* Notes  : symbolic links are not followed; with statx() meta data and
+*          attributes are read with a single system call; if statx()
+*          fails for other reasons than a file lookup error, lstat() is
+*          used
+\***********************************************************************/
+
+LOCAL Errors statFile(const char     *fileName,
+                      FileStat       *fileStat,
+                      FileAttributes *fileAttributes,
+                      bool           *fileAttributesFlag
+                     )
+{
+  assert(fileName != NULL);
+  assert(fileStat != NULL);
+  assert(fileAttributes != NULL);
+  assert(fileAttributesFlag != NULL);
+
+  (*fileAttributes)     = FILE_ATTRIBUTE_NONE;
+  (*fileAttributesFlag) = FALSE;
+
+  #ifdef HAVE_STATX
+    struct statx statxData;
+    if (statx(AT_FDCWD,fileName,AT_SYMLINK_NOFOLLOW|AT_NO_AUTOMOUNT,STATX_BASIC_STATS,&statxData) == 0)
+    {
+      memClear(fileStat,sizeof(FileStat));
+      fileStat->st_dev   = makedev(statxData.stx_dev_major,statxData.stx_dev_minor);
+      fileStat->st_ino   = statxData.stx_ino;
+      fileStat->st_mode  = statxData.stx_mode;
+      fileStat->st_nlink = statxData.stx_nlink;
+      fileStat->st_uid   = statxData.stx_uid;
+      fileStat->st_gid   = statxData.stx_gid;
+      fileStat->st_rdev  = makedev(statxData.stx_rdev_major,statxData.stx_rdev_minor);
+      fileStat->st_size  = (off_t)statxData.stx_size;
+      fileStat->st_atime = statxData.stx_atime.tv_sec;
+      fileStat->st_mtime = statxData.stx_mtime.tv_sec;
+      fileStat->st_ctime = statxData.stx_ctime.tv_sec;
+      #ifdef HAVE_STAT_ATIM_TV_NSEC
+        fileStat->st_atim.tv_nsec = statxData.stx_atime.tv_nsec;
+      #endif
+      #ifdef HAVE_STAT_MTIM_TV_NSEC
+        fileStat->st_mtim.tv_nsec = statxData.stx_mtime.tv_nsec;
+      #endif
+      #ifdef HAVE_STAT_CTIM_TV_NSEC
+        fileStat->st_ctim.tv_nsec = statxData.stx_ctime.tv_nsec;
+      #endif
+
+      // get attributes if reported completely
+      if (   (S_ISREG(statxData.stx_mode) || S_ISDIR(statxData.stx_mode))
+          && ((statxData.stx_attributes_mask & STATX_FILE_ATTRIBUTES) == STATX_FILE_ATTRIBUTES)
+          && isStatxAttributesComplete(fileName,statxData.stx_dev_major,statxData.stx_dev_minor)
+         )
+      {
+        if ((statxData.stx_attributes & STATX_ATTR_COMPRESSED) != 0) (*fileAttributes) |= FILE_ATTRIBUTE_COMPRESS;
+        if ((statxData.stx_attributes & STATX_ATTR_IMMUTABLE ) != 0) (*fileAttributes) |= FILE_ATTRIBUTE_IMMUTABLE;
+        if ((statxData.stx_attributes & STATX_ATTR_APPEND    ) != 0) (*fileAttributes) |= FILE_ATTRIBUTE_APPEND;
+        if ((statxData.stx_attributes & STATX_ATTR_NODUMP    ) != 0) (*fileAttributes) |= FILE_ATTRIBUTE_NO_DUMP;
+        (*fileAttributesFlag) = TRUE;
+      }
+
+      return ERROR_NONE;
+    }
+    else if (   (errno == ENOENT)
+             || (errno == ENOTDIR)
+             || (errno == EACCES)
+             || (errno == ELOOP)
+             || (errno == ENAMETOOLONG)
+            )
+    {
+      return getLastError(ERROR_CODE_IO,fileName);
+    }
+  #endif /* HAVE_STATX */
+
+  // statx() not available or failed (e.g. ENOSYS, EPERM/EINVAL by a system call filter): use lstat()
+  if (LSTAT(fileName,fileStat) != 0)
+  {
+    return getLastError(ERROR_CODE_IO,fileName);
+  }
+  #ifdef HAVE_STATX
+    // do not use statx() attributes of this file system
+    setStatxAttributesComplete(major(fileStat->st_dev),minor(fileStat->st_dev),FALSE);
+  #endif /* HAVE_STATX */
+
+  return ERROR_NONE;
+}
+
 /***********************************************************************\
 * Name   : getFileInfo
 * Purpose: get file info (type, time, permissions, owner, attributes)
@@ -930,7 +1204,10 @@ LOCAL Errors getFileInfo(FileInfo   *fileInfo,
   assert(!stringIsEmpty(fileName));
 
   // get file meta data
-  FileStat fileStat;
+  FileStat       fileStat;
+  FileAttributes fileAttributes;
+  bool           fileAttributesFlag;
+  Errors         error;
   #ifndef NDEBUG
     const char *debugEmulateBlockDevice = debugGetEmulateBlockDevice();
     if (debugEmulateBlockDevice != NULL)
@@ -946,25 +1223,28 @@ LOCAL Errors getFileInfo(FileInfo   *fileInfo,
         const char *emulateFileName;
         if (stringGetNextToken(&stringTokenizer,&emulateFileName))
         {
-          if (LSTAT(emulateFileName,&fileStat) != 0)
+          error = statFile(emulateFileName,&fileStat,&fileAttributes,&fileAttributesFlag);
+          if (error != ERROR_NONE)
           {
-            return getLastError(ERROR_CODE_IO,emulateFileName);
+            return error;
           }
         }
         else
         {
-          if (LSTAT(emulateDeviceName,&fileStat) != 0)
+          error = statFile(emulateDeviceName,&fileStat,&fileAttributes,&fileAttributesFlag);
+          if (error != ERROR_NONE)
           {
-            return getLastError(ERROR_CODE_IO,emulateDeviceName);
+            return error;
           }
         }
       }
       else
       {
         // use block device
-        if (LSTAT(fileName,&fileStat) != 0)
+        error = statFile(fileName,&fileStat,&fileAttributes,&fileAttributesFlag);
+        if (error != ERROR_NONE)
         {
-          return getLastError(ERROR_CODE_IO,fileName);
+          return error;
         }
       }
       stringTokenizerDone(&stringTokenizer);
@@ -972,15 +1252,17 @@ LOCAL Errors getFileInfo(FileInfo   *fileInfo,
     else
     {
       // use block device
-      if (LSTAT(fileName,&fileStat) != 0)
+      error = statFile(fileName,&fileStat,&fileAttributes,&fileAttributesFlag);
+      if (error != ERROR_NONE)
       {
-        return getLastError(ERROR_CODE_IO,fileName);
+        return error;
       }
     }
   #else /* NDEBUG */
-    if (LSTAT(fileName,&fileStat) != 0)
+    error = statFile(fileName,&fileStat,&fileAttributes,&fileAttributesFlag);
+    if (error != ERROR_NONE)
     {
-      return getLastError(ERROR_CODE_IO,fileName);
+      return error;
     }
   #endif /* not NDEBUG */
   fileInfo->timeLastAccess  = fileStat.st_atime;
@@ -1042,7 +1324,14 @@ LOCAL Errors getFileInfo(FileInfo   *fileInfo,
     fileInfo->size = fileStat.st_size;
 
     // get file attributes
-    (void)File_getAttributesCString(&fileInfo->attributes,fileName);
+    if (fileAttributesFlag)
+    {
+      fileInfo->attributes = fileAttributes;
+    }
+    else
+    {
+      (void)File_getAttributesCString(&fileInfo->attributes,fileName);
+    }
   }
   else if (S_ISDIR(fileStat.st_mode))
   {
@@ -1050,7 +1339,14 @@ LOCAL Errors getFileInfo(FileInfo   *fileInfo,
     fileInfo->size = 0LL;
 
     // get file attributes
-    (void)File_getAttributesCString(&fileInfo->attributes,fileName);
+    if (fileAttributesFlag)
+    {
+      fileInfo->attributes = fileAttributes;
+    }
+    else
+    {
+      (void)File_getAttributesCString(&fileInfo->attributes,fileName);
+    }
   }
   #ifdef S_ISLNK
   else if (S_ISLNK(fileStat.st_mode))
@@ -1104,6 +1400,341 @@ LOCAL Errors getFileInfo(FileInfo   *fileInfo,
   return ERROR_NONE;
 }
 
+#ifdef HAVE_BTRFS_CHANGE_GENERATION
+/***********************************************************************\
+* Name   : openBtrfs
+* Purpose: open file/directory on btrfs file system
+* Input  : pathName - path name
+* Output : handle - file descriptor
+* Return : ERROR_NONE or error code
+* Notes  : ERROR_FUNCTION_NOT_SUPPORTED if not on a btrfs file system
+\***********************************************************************/
+
+LOCAL Errors openBtrfs(int *handle, const char *pathName)
+{
+  struct statfs fileSystemStat;
+
+  assert(handle != NULL);
+  assert(pathName != NULL);
+
+  (*handle) = open(pathName,O_RDONLY|O_NONBLOCK|O_BINARY);
+  if ((*handle) == -1)
+  {
+    return getLastError(ERROR_CODE_IO,pathName);
+  }
+  if (fstatfs(*handle,&fileSystemStat) != 0)
+  {
+    Errors error = getLastError(ERROR_CODE_IO,pathName);
+    close(*handle);
+    return error;
+  }
+  if (fileSystemStat.f_type != BTRFS_SUPER_MAGIC)
+  {
+    close(*handle);
+    return ERROR_FUNCTION_NOT_SUPPORTED;
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : getBtrfsDirectoryPath
+* Purpose: get path of directory inode relative to sub-volume root
+* Input  : handle   - file descriptor of entry in sub-volume
+*          inode    - directory inode number
+*          path     - path variable
+*          pathSize - size of path variable
+* Output : path - path with trailing '/' or empty for root
+* Return : TRUE iff path found
+* Notes  : -
+\***********************************************************************/
+
+LOCAL bool getBtrfsDirectoryPath(int handle, uint64 inode, char *path, uint pathSize)
+{
+  struct btrfs_ioctl_ino_lookup_args inoLookupArgs;
+
+  assert(path != NULL);
+
+  memClear(&inoLookupArgs,sizeof(inoLookupArgs));
+  inoLookupArgs.treeid   = 0;
+  inoLookupArgs.objectid = inode;
+  if (ioctl(handle,BTRFS_IOC_INO_LOOKUP,&inoLookupArgs) != 0)
+  {
+    return FALSE;
+  }
+  stringSet(path,pathSize,inoLookupArgs.name);
+
+  return TRUE;
+}
+
+/***********************************************************************\
+* Name   : nextBtrfsSearchKey
+* Purpose: set search key to next key after found item
+* Input  : searchKey    - search key
+*          searchHeader - header of last found item
+* Output : searchKey - search key
+* Return : TRUE iff more keys, FALSE if end of search range reached
+* Notes  : -
+\***********************************************************************/
+
+LOCAL bool nextBtrfsSearchKey(struct btrfs_ioctl_search_key          *searchKey,
+                              const struct btrfs_ioctl_search_header *searchHeader
+                             )
+{
+  assert(searchKey != NULL);
+  assert(searchHeader != NULL);
+
+  searchKey->min_objectid = searchHeader->objectid;
+  searchKey->min_type     = searchHeader->type;
+  searchKey->min_offset   = searchHeader->offset;
+  if      (searchKey->min_offset < (__u64)-1)
+  {
+    searchKey->min_offset++;
+  }
+  else if (searchKey->min_type < 0xFF)
+  {
+    searchKey->min_type++;
+    searchKey->min_offset = 0;
+  }
+  else
+  {
+    if (searchKey->min_objectid >= searchKey->max_objectid) return FALSE;
+    searchKey->min_objectid++;
+    searchKey->min_type   = 0;
+    searchKey->min_offset = 0;
+  }
+
+  return TRUE;
+}
+
+/***********************************************************************\
+* Name   : reportBtrfsInodeNames
+* Purpose: report all names of a btrfs inode below a directory
+* Input  : handle                   - file descriptor of directory
+*          inode                    - inode number
+*          basePath                 - path of directory relative to
+*                                     sub-volume root
+*          pathName                 - directory name
+*          fileChangedEntryFunction - changed entry call back
+*          fileChangedEntryUserData - user data for call back
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : names are read from the inode (ext) ref items
+\***********************************************************************/
+
+LOCAL Errors reportBtrfsInodeNames(int                      handle,
+                                   uint64                   inode,
+                                   const char               *basePath,
+                                   ConstString              pathName,
+                                   FileChangedEntryFunction fileChangedEntryFunction,
+                                   void                     *fileChangedEntryUserData
+                                  )
+{
+  struct btrfs_ioctl_search_args searchArgs;
+  uint64                         lastParentInode;
+  char                           parentPath[BTRFS_INO_LOOKUP_PATH_MAX+1];
+  char                           name[BTRFS_INO_LOOKUP_PATH_MAX+1];
+  size_t                         basePathLength;
+  String                         fileName;
+
+  assert(basePath != NULL);
+  assert(pathName != NULL);
+  assert(fileChangedEntryFunction != NULL);
+
+  basePathLength  = stringLength(basePath);
+  lastParentInode = 0LL;
+  fileName        = String_new();
+
+  memClear(&searchArgs,sizeof(searchArgs));
+  searchArgs.key.tree_id      = 0;
+  searchArgs.key.min_objectid = inode;
+  searchArgs.key.max_objectid = inode;
+  searchArgs.key.min_type     = BTRFS_INODE_REF_KEY;
+  searchArgs.key.max_type     = BTRFS_INODE_EXTREF_KEY;
+  searchArgs.key.min_offset   = 0;
+  searchArgs.key.max_offset   = (__u64)-1;
+  searchArgs.key.min_transid  = 0;
+  searchArgs.key.max_transid  = (__u64)-1;
+  bool moreFlag = TRUE;
+  while (moreFlag)
+  {
+    searchArgs.key.nr_items = 4096;
+    if (ioctl(handle,BTRFS_IOC_TREE_SEARCH,&searchArgs) != 0)
+    {
+      Errors error = getLastError(ERROR_CODE_IO,String_cString(pathName));
+      String_delete(fileName);
+      return error;
+    }
+    if (searchArgs.key.nr_items == 0)
+    {
+      break;
+    }
+
+    ulong offset = 0;
+    struct btrfs_ioctl_search_header searchHeader;
+    for (uint i = 0; i < searchArgs.key.nr_items; i++)
+    {
+      memcpy(&searchHeader,&searchArgs.buf[offset],sizeof(searchHeader));
+      offset += sizeof(searchHeader);
+      const byte *item = (const byte*)&searchArgs.buf[offset];
+      offset += searchHeader.len;
+
+      // get names: (parent inode, name)
+      ulong itemOffset = 0;
+      while (   (searchHeader.objectid == inode)
+             && (   (searchHeader.type == BTRFS_INODE_REF_KEY)
+                 || (searchHeader.type == BTRFS_INODE_EXTREF_KEY)
+                )
+             && (itemOffset < searchHeader.len)
+            )
+      {
+        uint64 parentInode;
+        uint   nameLength;
+        const char *s;
+        if (searchHeader.type == BTRFS_INODE_REF_KEY)
+        {
+          struct btrfs_inode_ref inodeRef;
+          if ((itemOffset+sizeof(inodeRef)) > searchHeader.len) break;
+          memcpy(&inodeRef,&item[itemOffset],sizeof(inodeRef));
+          parentInode = searchHeader.offset;
+          nameLength  = le16toh(inodeRef.name_len);
+          s           = (const char*)&item[itemOffset+sizeof(inodeRef)];
+          itemOffset += sizeof(inodeRef)+nameLength;
+        }
+        else
+        {
+          struct btrfs_inode_extref inodeExtRef;
+          if ((itemOffset+sizeof(inodeExtRef)) > searchHeader.len) break;
+          memcpy(&inodeExtRef,&item[itemOffset],sizeof(inodeExtRef));
+          parentInode = le64toh(inodeExtRef.parent_objectid);
+          nameLength  = le16toh(inodeExtRef.name_len);
+          s           = (const char*)&item[itemOffset+sizeof(inodeExtRef)];
+          itemOffset += sizeof(inodeExtRef)+nameLength;
+        }
+        if ((itemOffset > searchHeader.len) || (nameLength >= sizeof(name)))
+        {
+          break;
+        }
+
+        // get path of parent directory
+        if (parentInode != lastParentInode)
+        {
+          if (!getBtrfsDirectoryPath(handle,parentInode,parentPath,sizeof(parentPath)))
+          {
+            continue;
+          }
+          lastParentInode = parentInode;
+        }
+
+        // report name if below directory
+        stringSet(name,sizeof(name),parentPath);
+        stringAppendBuffer(name,sizeof(name),s,nameLength);
+        if (stringStartsWith(name,basePath) && (stringLength(name) > basePathLength))
+        {
+          String_set(fileName,pathName);
+          File_appendFileNameCString(fileName,&name[basePathLength]);
+          fileChangedEntryFunction(fileName,fileChangedEntryUserData);
+        }
+      }
+    }
+
+    moreFlag = nextBtrfsSearchKey(&searchArgs.key,&searchHeader);
+  }
+
+  String_delete(fileName);
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : hasBtrfsSubVolumes
+* Purpose: check if there are sub-volumes below directory
+* Input  : handle   - file descriptor of directory
+*          basePath - path of directory relative to sub-volume root
+* Output : -
+* Return : TRUE iff sub-volumes found or sub-volumes cannot be read
+* Notes  : -
+\***********************************************************************/
+
+LOCAL bool hasBtrfsSubVolumes(int handle, const char *basePath)
+{
+  struct btrfs_ioctl_get_subvol_rootref_args rootRefArgs;
+  char                                       path[BTRFS_INO_LOOKUP_PATH_MAX+1];
+  int                                        result;
+
+  assert(basePath != NULL);
+
+  memClear(&rootRefArgs,sizeof(rootRefArgs));
+  do
+  {
+    result = ioctl(handle,BTRFS_IOC_GET_SUBVOL_ROOTREF,&rootRefArgs);
+    if ((result != 0) && (errno != EOVERFLOW))
+    {
+      return TRUE;
+    }
+    for (uint i = 0; i < rootRefArgs.num_items; i++)
+    {
+      if (   !getBtrfsDirectoryPath(handle,rootRefArgs.rootref[i].dirid,path,sizeof(path))
+          || stringStartsWith(path,basePath)
+         )
+      {
+        return TRUE;
+      }
+    }
+  }
+  while (result != 0);
+
+  return FALSE;
+}
+
+/***********************************************************************\
+* Name   : hasMountPoints
+* Purpose: check if there are mount points below directory
+* Input  : pathName - directory name
+* Output : -
+* Return : TRUE iff mount points found or mount list cannot be read
+* Notes  : -
+\***********************************************************************/
+
+LOCAL bool hasMountPoints(const char *pathName)
+{
+  char absolutePath[PATH_MAX];
+  char line[1024];
+  char mountPointName[PATH_MAX];
+
+  assert(pathName != NULL);
+
+  if (realpath(pathName,absolutePath) == NULL)
+  {
+    return TRUE;
+  }
+  size_t absolutePathLength = stringLength(absolutePath);
+  if ((absolutePathLength > 0) && (absolutePath[absolutePathLength-1] == '/'))
+  {
+    absolutePathLength--;
+  }
+
+  FILE *handle = FOPEN(MOUNTS_FILENAME,"r");
+  if (handle == NULL)
+  {
+    return TRUE;
+  }
+  bool mountPointFlag = FALSE;
+  while (!mountPointFlag && (fgets(line,sizeof(line),handle) != NULL))
+  {
+    if (parseMountListEntry(mountPointName,sizeof(mountPointName),line,NULL))
+    {
+      mountPointFlag =    (strncmp(mountPointName,absolutePath,absolutePathLength) == 0)
+                       && (mountPointName[absolutePathLength] == '/')
+                       && (mountPointName[absolutePathLength+1] != NUL);
+    }
+  }
+  (void)fclose(handle);
+
+  return mountPointFlag;
+}
+#endif /* HAVE_BTRFS_CHANGE_GENERATION */
+
 /*---------------------------------------------------------------------*/
 
 String File_newFileName(void)
@@ -1957,8 +2588,9 @@ Errors __File_getTmpFileCString(const char *__fileName__,
   // init file handle
   fileHandle->name  = fileName;
   fileHandle->mode  = 0;
-  fileHandle->index = 0LL;
-  fileHandle->size  = 0LL;
+  fileHandle->index          = 0LL;
+  fileHandle->size           = 0LL;
+  fileHandle->readAheadIndex = 0LL;
   StringList_init(&fileHandle->lineBufferList);
 
   // free resources
@@ -2826,6 +3458,12 @@ Errors File_read(FileHandle *fileHandle,
   FILE_CHECK_VALID(fileHandle);
   assert(buffer != NULL);
 
+  // request asynchronous read of following data
+  if (IS_SET(fileHandle->mode,FILE_OPEN_READ_AHEAD))
+  {
+    readAhead(fileHandle);
+  }
+
   if (bytesRead != NULL)
   {
     // read as much data as possible
@@ -3085,43 +3723,91 @@ Errors File_transfer(FileHandle *fileHandle,
   FILE_CHECK_VALID(fileHandle);
   FILE_CHECK_VALID(fromFileHandle);
 
-  // allocate transfer buffer
-  buffer = (char*)malloc(BUFFER_SIZE);
-  if (buffer == NULL)
-  {
-    HALT_INSUFFICIENT_MEMORY();
-  }
-
   // get number of bytes to transfer
   if (length < 0)
   {
-    length = (long)(fromFileHandle->size-fromFileHandle->index);
+    length = (int64)(fromFileHandle->size-fromFileHandle->index);
   }
 
-  // transfer data
   if (bytesTransfered != NULL) (*bytesTransfered) = 0LL;
-  while (length > 0LL)
-  {
-    bufferLength = MIN(length,BUFFER_SIZE);
 
-    n = fread(buffer,1,bufferLength,fromFileHandle->file);
-    if (n != (ssize_t)bufferLength)
+  #ifdef HAVE_COPY_FILE_RANGE
+    // transfer data inside kernel (no copy via user space, shared blocks if supported by file system)
+    if (   (length > 0LL)
+        && !IS_SET(fileHandle->mode,FILE_SPARSE)
+        && (fflush(fileHandle->file) == 0)
+        && (fflush(fromFileHandle->file) == 0)
+       )
     {
-      error = getLastError(ERROR_CODE_IO,String_cString(fileHandle->name));
-      free(buffer);
-      return error;
+      off64_t fromOffset = (off64_t)fromFileHandle->index;
+      off64_t toOffset   = (off64_t)fileHandle->index;
+      do
+      {
+        n = copy_file_range(fileno(fromFileHandle->file),&fromOffset,
+                            fileno(fileHandle->file),&toOffset,
+                            (size_t)MIN(length,(int64)MAX_LONG),
+                            0
+                           );
+        if (n > 0)
+        {
+          length -= (int64)n;
+          if (bytesTransfered != NULL) (*bytesTransfered) += (uint64)n;
+        }
+      }
+      while ((n > 0) && (length > 0LL));
+
+      // set stream positions (Note: remaining data, e. g. if not supported by file system, is transfered via buffer)
+      if (   (FSEEK(fromFileHandle->file,fromOffset,SEEK_SET) == -1)
+          || (FSEEK(fileHandle->file,toOffset,SEEK_SET) == -1)
+         )
+      {
+        return getLastError(ERROR_CODE_IO,String_cString(fileHandle->name));
+      }
+      fromFileHandle->index = (uint64)fromOffset;
+      fileHandle->index     = (uint64)toOffset;
+      if (fileHandle->index > fileHandle->size) fileHandle->size = fileHandle->index;
     }
+  #endif /* HAVE_COPY_FILE_RANGE */
 
-    n = fwrite(buffer,1,bufferLength,fileHandle->file);
-    if (n != (ssize_t)bufferLength)
+  // transfer data
+  if (length > 0LL)
+  {
+    // allocate transfer buffer
+    buffer = (char*)malloc(BUFFER_SIZE);
+    if (buffer == NULL)
     {
-      error = getLastError(ERROR_CODE_IO,String_cString(fileHandle->name));
-      free(buffer);
-      return error;
+      HALT_INSUFFICIENT_MEMORY();
     }
 
-    length -= bufferLength;
-    if (bytesTransfered != NULL) (*bytesTransfered) += bufferLength;
+    while (length > 0LL)
+    {
+      bufferLength = MIN(length,BUFFER_SIZE);
+
+      n = fread(buffer,1,bufferLength,fromFileHandle->file);
+      if (n != (ssize_t)bufferLength)
+      {
+        error = getLastError(ERROR_CODE_IO,String_cString(fromFileHandle->name));
+        free(buffer);
+        return error;
+      }
+      fromFileHandle->index += (uint64)n;
+
+      n = fwrite(buffer,1,bufferLength,fileHandle->file);
+      if (n != (ssize_t)bufferLength)
+      {
+        error = getLastError(ERROR_CODE_IO,String_cString(fileHandle->name));
+        free(buffer);
+        return error;
+      }
+      fileHandle->index += (uint64)n;
+      if (fileHandle->index > fileHandle->size) fileHandle->size = fileHandle->index;
+
+      length -= bufferLength;
+      if (bytesTransfered != NULL) (*bytesTransfered) += bufferLength;
+    }
+
+    // free resources
+    free(buffer);
   }
 
   // free caches if requested
@@ -3134,9 +3820,6 @@ Errors File_transfer(FileHandle *fileHandle,
     (void)File_dropCaches(fileHandle,0LL,fileHandle->index,TRUE);
   }
 
-  // free resources
-  free(buffer);
-
   return ERROR_NONE;
 
   #undef BUFFER_SIZE
@@ -3245,7 +3928,12 @@ Errors File_seek(FileHandle *fileHandle,
 
   if (FSEEK(fileHandle->file,(off_t)offset,SEEK_SET) == -1)
   {
-    return getLastError(ERROR_CODE_IO,String_cString(fileHandle->name));
+    return getLastError(ERROR_CODE_IO,String_cString(fileHandle->name));
+  }
+  if ((offset < fileHandle->index) || (offset >= fileHandle->readAheadIndex))
+  {
+    // restart read-ahead at new position
+    fileHandle->readAheadIndex = offset;
   }
   fileHandle->index = offset;
 //TODO: not valid when file changed in the meantime
@@ -3281,6 +3969,77 @@ Errors File_truncate(FileHandle *fileHandle,
   return ERROR_NONE;
 }
 
+Errors File_punchHole(FileHandle *fileHandle,
+                      uint64     offset,
+                      uint64     length
+                     )
+{
+  #define BUFFER_SIZE (64*1024)
+
+  FILE_CHECK_VALID(fileHandle);
+
+  (void)fflush(fileHandle->file);
+
+  #if defined(HAVE_FALLOCATE) && defined(FALLOC_FL_PUNCH_HOLE)
+    if (fallocate(fileno(fileHandle->file),FALLOC_FL_PUNCH_HOLE|FALLOC_FL_KEEP_SIZE,(off_t)offset,(off_t)length) == 0)
+    {
+      return ERROR_NONE;
+    }
+    if ((errno != EOPNOTSUPP) && (errno != ENOSYS))
+    {
+      return getLastError(ERROR_CODE_IO,String_cString(fileHandle->name));
+    }
+  #endif /* defined(HAVE_FALLOCATE) && defined(FALLOC_FL_PUNCH_HOLE) */
+
+  // not supported: overwrite with 0-bytes (Note: bypass stream, position is not changed)
+  void *buffer = calloc(1,BUFFER_SIZE);
+  if (buffer == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  while (length > 0LL)
+  {
+    size_t  n = (size_t)MIN(length,BUFFER_SIZE);
+    ssize_t m = pwrite(fileno(fileHandle->file),buffer,n,(off_t)offset);
+    if (m <= 0)
+    {
+      Errors error = getLastError(ERROR_CODE_IO,String_cString(fileHandle->name));
+      free(buffer);
+      return error;
+    }
+    offset += (uint64)m;
+    length -= (uint64)m;
+  }
+  free(buffer);
+
+  return ERROR_NONE;
+
+  #undef BUFFER_SIZE
+}
+
+Errors File_readAhead(FileHandle *fileHandle,
+                      uint64     offset,
+                      uint64     length
+                     )
+{
+  FILE_CHECK_VALID(fileHandle);
+
+  #ifdef HAVE_POSIX_FADVISE
+    // Note: posix_fadvise() returns the error code and does not set errno
+    int result = posix_fadvise(fileno(fileHandle->file),offset,length,POSIX_FADV_WILLNEED);
+    if (result != 0)
+    {
+      return ERRORX_(IO,result,"%E: %s",result,String_cString(fileHandle->name));
+    }
+  #else
+    UNUSED_VARIABLE(fileHandle);
+    UNUSED_VARIABLE(offset);
+    UNUSED_VARIABLE(length);
+  #endif /* HAVE_POSIX_FADVISE */
+
+  return ERROR_NONE;
+}
+
 Errors File_dropCaches(FileHandle *fileHandle,
                        uint64     offset,
                        uint64     length,
@@ -3312,9 +4071,11 @@ Errors File_dropCaches(FileHandle *fileHandle,
 
 //TODO: use mincore() and only drop pages which are not used by other processes?
   #ifdef HAVE_POSIX_FADVISE
-    if (posix_fadvise(handle,offset,length,POSIX_FADV_DONTNEED) != 0)
+    // Note: posix_fadvise() returns the error code and does not set errno
+    int result = posix_fadvise(handle,offset,length,POSIX_FADV_DONTNEED);
+    if (result != 0)
     {
-      return getLastError(ERROR_CODE_IO,String_cString(fileHandle->name));
+      return ERRORX_(IO,result,"%E: %s",result,String_cString(fileHandle->name));
     }
   #else
     UNUSED_VARIABLE(offset);
@@ -3944,8 +4705,8 @@ Errors File_deleteCString(const char *fileName, bool recursiveFlag)
           emptyFlag = TRUE;
           while (((entry = readdir(dir)) != NULL) && (error == ERROR_NONE))
           {
-            if (   (stringEquals(entry->d_name,"." ))
-                && (stringEquals(entry->d_name,".."))
+            if (   !stringEquals(entry->d_name,"." )
+                && !stringEquals(entry->d_name,"..")
                )
             {
               String_set(name,directoryName);
@@ -4982,6 +5743,8 @@ Errors File_getExtendedAttributes(FileExtendedAttributeList *fileExtendedAttribu
                                  )
 {
   #ifdef HAVE_LLISTXATTR
+    char                      namesBuffer[XATTR_NAMES_BUFFER_SIZE];
+    char                      dataBuffer[XATTR_DATA_BUFFER_SIZE];
     int                       n;
     char                      *names;
     int                       namesLength;
@@ -5000,55 +5763,83 @@ Errors File_getExtendedAttributes(FileExtendedAttributeList *fileExtendedAttribu
   List_init(fileExtendedAttributeList,CALLBACK_(NULL,NULL),CALLBACK_((ListNodeFreeFunction)freeExtendedAttributeNode,NULL));
 
   #ifdef HAVE_LLISTXATTR
-    // allocate buffer for attribute names (Note: it is possible a value > 0 is returned here, but later 0 is returned)
-    n = llistxattr(String_cString(fileName),NULL,0);
-    if (n >= 0)
+    // get attribute names: try with local buffer first (usually no or few attributes)
+    names       = namesBuffer;
+    namesLength = llistxattr(String_cString(fileName),namesBuffer,sizeof(namesBuffer));
+    if ((namesLength < 0) && (errno == ERANGE))
     {
-      names = (char*)malloc(n);
-      if (names == NULL)
+      // allocate buffer for attribute names (Note: it is possible a value > 0 is returned here, but later 0 is returned)
+      n = llistxattr(String_cString(fileName),NULL,0);
+      if (n >= 0)
       {
-        List_done(fileExtendedAttributeList);
-        return ERROR_INSUFFICIENT_MEMORY;
-      }
+        names = (char*)malloc(n);
+        if (names == NULL)
+        {
+          List_done(fileExtendedAttributeList);
+          return ERROR_INSUFFICIENT_MEMORY;
+        }
 
-      // get attribute names
-      namesLength = llistxattr(String_cString(fileName),names,n);
-      if (namesLength < 0)
+        namesLength = llistxattr(String_cString(fileName),names,n);
+      }
+      else
       {
-        error = getLastError(ERROR_CODE_IO,String_cString(fileName));
-        free(names);
-        List_done(fileExtendedAttributeList);
-        return error;
+        names       = NULL;
+        namesLength = n;
       }
-
+    }
+    if (namesLength >= 0)
+    {
       // get attributes
       name = names;
       while ((name-names) < namesLength)
       {
-        // allocate buffer for data
-        n = lgetxattr(String_cString(fileName),name,NULL,0);
-        if (n < 0)
+        // get extended attribute: try with local buffer first
+        dataLength = lgetxattr(String_cString(fileName),name,dataBuffer,sizeof(dataBuffer));
+        if (dataLength >= 0)
         {
-          error = getLastError(ERROR_CODE_IO,String_cString(fileName));
-          free(names);
-          List_done(fileExtendedAttributeList);
-          return error;
+          data = malloc(dataLength);
+          if (data == NULL)
+          {
+            if (names != namesBuffer) free(names);
+            List_done(fileExtendedAttributeList);
+            return ERROR_INSUFFICIENT_MEMORY;
+          }
+          memCopyFast(data,dataLength,dataBuffer,dataLength);
         }
-        data = malloc(n);
-        if (data == NULL)
+        else if (errno == ERANGE)
         {
-          free(names);
-          List_done(fileExtendedAttributeList);
-          return ERROR_INSUFFICIENT_MEMORY;
-        }
+          // allocate buffer for data
+          n = lgetxattr(String_cString(fileName),name,NULL,0);
+          if (n < 0)
+          {
+            error = getLastError(ERROR_CODE_IO,String_cString(fileName));
+            if (names != namesBuffer) free(names);
+            List_done(fileExtendedAttributeList);
+            return error;
+          }
+          data = malloc(n);
+          if (data == NULL)
+          {
+            if (names != namesBuffer) free(names);
+            List_done(fileExtendedAttributeList);
+            return ERROR_INSUFFICIENT_MEMORY;
+          }
 
-        // get extended attribute
-        dataLength = lgetxattr(String_cString(fileName),name,data,n);
-        if (dataLength < 0)
+          // get extended attribute
+          dataLength = lgetxattr(String_cString(fileName),name,data,n);
+          if (dataLength < 0)
+          {
+            error = getLastError(ERROR_CODE_IO,String_cString(fileName));
+            free(data);
+            if (names != namesBuffer) free(names);
+            List_done(fileExtendedAttributeList);
+            return error;
+          }
+        }
+        else
         {
           error = getLastError(ERROR_CODE_IO,String_cString(fileName));
-          free(data);
-          free(names);
+          if (names != namesBuffer) free(names);
           List_done(fileExtendedAttributeList);
           return error;
         }
@@ -5058,7 +5849,7 @@ Errors File_getExtendedAttributes(FileExtendedAttributeList *fileExtendedAttribu
         if (fileExtendedAttributeNode == NULL)
         {
           free(data);
-          free(names);
+          if (names != namesBuffer) free(names);
           List_done(fileExtendedAttributeList);
           return ERROR_INSUFFICIENT_MEMORY;
         }
@@ -5072,15 +5863,17 @@ Errors File_getExtendedAttributes(FileExtendedAttributeList *fileExtendedAttribu
       }
 
       // free resources
-      free(names);
+      if (names != namesBuffer) free(names);
     }
     else if (errno == ENOTSUP)
     {
       // not supported -> nothing to do
+      if ((names != NULL) && (names != namesBuffer)) free(names);
     }
     else
     {
       error = getLastError(ERROR_CODE_IO,String_cString(fileName));
+      if ((names != NULL) && (names != namesBuffer)) free(names);
       List_done(fileExtendedAttributeList);
       return error;
     }
@@ -5126,6 +5919,218 @@ Errors File_setExtendedAttributes(ConstString                     fileName,
   return ERROR_NONE;
 }
 
+void File_initHoles(FileHoleList *fileHoleList)
+{
+  assert(fileHoleList != NULL);
+
+  List_init(fileHoleList,CALLBACK_(NULL,NULL),CALLBACK_(NULL,NULL));
+}
+
+void File_doneHoles(FileHoleList *fileHoleList)
+{
+  assert(fileHoleList != NULL);
+
+  List_done(fileHoleList);
+}
+
+void File_addHole(FileHoleList *fileHoleList,
+                  uint64       offset,
+                  uint64       size
+                 )
+{
+  FileHoleNode *fileHoleNode;
+
+  assert(fileHoleList != NULL);
+
+  // merge with last hole if adjacent
+  if ((fileHoleList->tail != NULL) && ((fileHoleList->tail->offset+fileHoleList->tail->size) == offset))
+  {
+    fileHoleList->tail->size += size;
+    return;
+  }
+
+  // allocate file hole node
+  fileHoleNode = LIST_NEW_NODE(FileHoleNode);
+  if (fileHoleNode == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  fileHoleNode->offset = offset;
+  fileHoleNode->size   = size;
+
+  // add hole to list
+  List_append(fileHoleList,fileHoleNode);
+}
+
+Errors File_getHoles(FileHoleList *fileHoleList,
+                     FileHandle   *fileHandle,
+                     uint64       offset,
+                     uint64       length,
+                     uint64       minHoleSize
+                    )
+{
+  assert(fileHoleList != NULL);
+  FILE_CHECK_VALID(fileHandle);
+
+  #if defined(SEEK_DATA) && defined(SEEK_HOLE)
+    Errors error;
+    int    handle;
+    off_t  savedIndex;
+    uint64 end;
+    uint64 index;
+    off_t  holeOffset,dataOffset;
+
+    // Note: seek on the descriptor only; stream position is restored afterwards
+    handle     = fileno(fileHandle->file);
+    savedIndex = TELL(handle);
+    if (savedIndex == (off_t)(-1))
+    {
+      return getLastError(ERROR_CODE_IO,String_cString(fileHandle->name));
+    }
+
+    error = ERROR_NONE;
+    end   = offset+length;
+    index = offset;
+    while ((error == ERROR_NONE) && (index < end))
+    {
+      // find start of next hole
+      holeOffset = SEEK(handle,(off_t)index,SEEK_HOLE);
+      if (holeOffset == (off_t)(-1))
+      {
+        // ENXIO: beyond end of file, EINVAL: not supported
+        if ((errno != ENXIO) && (errno != EINVAL))
+        {
+          error = getLastError(ERROR_CODE_IO,String_cString(fileHandle->name));
+        }
+        break;
+      }
+      if ((uint64)holeOffset >= end)
+      {
+        break;
+      }
+
+      // find end of hole
+      dataOffset = SEEK(handle,holeOffset,SEEK_DATA);
+      if (dataOffset == (off_t)(-1))
+      {
+        if (errno != ENXIO)
+        {
+          error = getLastError(ERROR_CODE_IO,String_cString(fileHandle->name));
+          break;
+        }
+
+        // hole until end of file
+        dataOffset = (off_t)end;
+      }
+      if ((uint64)dataOffset > end) dataOffset = (off_t)end;
+
+      // add hole
+      if ((uint64)(dataOffset-holeOffset) >= minHoleSize)
+      {
+        File_addHole(fileHoleList,(uint64)holeOffset,(uint64)(dataOffset-holeOffset));
+      }
+
+      index = (uint64)dataOffset;
+    }
+
+    // restore position
+    if (SEEK(handle,savedIndex,SEEK_SET) == (off_t)(-1))
+    {
+      if (error == ERROR_NONE) error = getLastError(ERROR_CODE_IO,String_cString(fileHandle->name));
+    }
+
+    return error;
+  #else /* not SEEK_DATA && SEEK_HOLE */
+    UNUSED_VARIABLE(fileHoleList);
+    UNUSED_VARIABLE(offset);
+    UNUSED_VARIABLE(length);
+    UNUSED_VARIABLE(minHoleSize);
+
+    return ERROR_NONE;
+  #endif /* SEEK_DATA && SEEK_HOLE */
+}
+
+uint64 File_getNextData(const FileHoleNode **fileHoleNode,
+                        uint64             offset,
+                        uint64             endOffset,
+                        uint64             *dataSize
+                       )
+{
+  assert(fileHoleNode != NULL);
+  assert(dataSize != NULL);
+
+  // skip holes before offset, skip hole at offset
+  while (   ((*fileHoleNode) != NULL)
+         && ((*fileHoleNode)->offset <= offset)
+        )
+  {
+    offset = MAX(offset,(*fileHoleNode)->offset+(*fileHoleNode)->size);
+    (*fileHoleNode) = (*fileHoleNode)->next;
+  }
+
+  // get data until next hole
+  if      (offset >= endOffset)
+  {
+    offset      = endOffset;
+    (*dataSize) = 0LL;
+  }
+  else if ((*fileHoleNode) != NULL)
+  {
+    (*dataSize) = MIN((*fileHoleNode)->offset,endOffset)-offset;
+  }
+  else
+  {
+    (*dataSize) = endOffset-offset;
+  }
+
+  return offset;
+}
+
+uint64 File_getDataSize(const FileHoleList *fileHoleList,
+                        uint64             offset,
+                        uint64             length
+                       )
+{
+  assert(fileHoleList != NULL);
+
+  uint64 dataSize = length;
+  const FileHoleNode *fileHoleNode;
+  LIST_ITERATE(fileHoleList,fileHoleNode)
+  {
+    uint64 holeStart = MAX(fileHoleNode->offset,offset);
+    uint64 holeEnd   = MIN(fileHoleNode->offset+fileHoleNode->size,offset+length);
+    if (holeStart < holeEnd)
+    {
+      dataSize -= holeEnd-holeStart;
+    }
+  }
+
+  return dataSize;
+}
+
+uint64 File_getRangeSize(const FileHoleList *fileHoleList,
+                         uint64             offset,
+                         uint64             dataSize
+                        )
+{
+  assert(fileHoleList != NULL);
+
+  uint64 endOffset = offset+dataSize;
+  const FileHoleNode *fileHoleNode;
+  LIST_ITERATE(fileHoleList,fileHoleNode)
+  {
+    // extend range by holes inside of range or adjacent to range (Note: holes are sorted)
+    uint64 holeStart = MAX(fileHoleNode->offset,offset);
+    uint64 holeEnd   = fileHoleNode->offset+fileHoleNode->size;
+    if ((holeEnd > offset) && (holeStart <= endOffset))
+    {
+      endOffset += holeEnd-holeStart;
+    }
+  }
+
+  return endOffset-offset;
+}
+
 uint64 File_getFileTimeModified(ConstString fileName)
 {
   FileStat fileStat;
@@ -5851,6 +6856,156 @@ Errors File_getFileSystemInfo(FileSystemInfo *fileSystemInfo,
   return ERROR_NONE;
 }
 
+Errors File_getChangeGeneration(FileChangeGeneration *fileChangeGeneration,
+                                ConstString          pathName
+                               )
+{
+  assert(fileChangeGeneration != NULL);
+  assert(pathName != NULL);
+  assert(!String_isEmpty(pathName));
+
+  #ifdef HAVE_BTRFS_CHANGE_GENERATION
+    struct btrfs_ioctl_get_subvol_info_args subVolumeInfoArgs;
+    Errors                                  error;
+    int                                     handle;
+
+    error = openBtrfs(&handle,String_cString(pathName));
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+
+    memClear(&subVolumeInfoArgs,sizeof(subVolumeInfoArgs));
+    if (ioctl(handle,BTRFS_IOC_GET_SUBVOL_INFO,&subVolumeInfoArgs) != 0)
+    {
+      error = getLastError(ERROR_CODE_IO,String_cString(pathName));
+      close(handle);
+      return error;
+    }
+    close(handle);
+
+    fileChangeGeneration->generation = subVolumeInfoArgs.generation;
+    assert(sizeof(fileChangeGeneration->uuid) == sizeof(subVolumeInfoArgs.uuid));
+    memcpy(fileChangeGeneration->uuid,subVolumeInfoArgs.uuid,sizeof(fileChangeGeneration->uuid));
+
+    return ERROR_NONE;
+  #else /* not HAVE_BTRFS_CHANGE_GENERATION */
+    UNUSED_VARIABLE(fileChangeGeneration);
+    UNUSED_VARIABLE(pathName);
+
+    return ERROR_FUNCTION_NOT_SUPPORTED;
+  #endif /* HAVE_BTRFS_CHANGE_GENERATION */
+}
+
+Errors File_getChangedEntries(ConstString              pathName,
+                              uint64                   generation,
+                              FileChangedEntryFunction fileChangedEntryFunction,
+                              void                     *fileChangedEntryUserData
+                             )
+{
+  assert(pathName != NULL);
+  assert(!String_isEmpty(pathName));
+  assert(fileChangedEntryFunction != NULL);
+
+  #ifdef HAVE_BTRFS_CHANGE_GENERATION
+    struct btrfs_ioctl_search_args searchArgs;
+    char                           basePath[BTRFS_INO_LOOKUP_PATH_MAX+1];
+    struct stat                    fileStat;
+    Errors                         error;
+    int                            handle;
+
+    error = openBtrfs(&handle,String_cString(pathName));
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+
+    // get path of directory relative to sub-volume root
+    if (   (fstat(handle,&fileStat) != 0)
+        || !S_ISDIR(fileStat.st_mode)
+        || !getBtrfsDirectoryPath(handle,fileStat.st_ino,basePath,sizeof(basePath))
+       )
+    {
+      close(handle);
+      return ERROR_FUNCTION_NOT_SUPPORTED;
+    }
+
+    // entries of other sub-volumes or file systems are not found
+    if (hasBtrfsSubVolumes(handle,basePath) || hasMountPoints(String_cString(pathName)))
+    {
+      close(handle);
+      return ERROR_FUNCTION_NOT_SUPPORTED;
+    }
+
+    // search inodes changed since generation
+    memClear(&searchArgs,sizeof(searchArgs));
+    searchArgs.key.tree_id      = 0;
+    searchArgs.key.min_objectid = BTRFS_FIRST_FREE_OBJECTID+1;
+    searchArgs.key.max_objectid = BTRFS_LAST_FREE_OBJECTID;
+    searchArgs.key.min_type     = BTRFS_INODE_ITEM_KEY;
+    searchArgs.key.max_type     = 0xFF;
+    searchArgs.key.min_offset   = 0;
+    searchArgs.key.max_offset   = (__u64)-1;
+    searchArgs.key.min_transid  = generation;
+    searchArgs.key.max_transid  = (__u64)-1;
+    bool moreFlag = TRUE;
+    while ((error == ERROR_NONE) && moreFlag)
+    {
+      searchArgs.key.nr_items = 4096;
+      if (ioctl(handle,BTRFS_IOC_TREE_SEARCH,&searchArgs) != 0)
+      {
+        error = getLastError(ERROR_CODE_IO,String_cString(pathName));
+        break;
+      }
+      if (searchArgs.key.nr_items == 0)
+      {
+        break;
+      }
+
+      ulong offset = 0;
+      struct btrfs_ioctl_search_header searchHeader;
+      for (uint i = 0; (i < searchArgs.key.nr_items) && (error == ERROR_NONE); i++)
+      {
+        memcpy(&searchHeader,&searchArgs.buf[offset],sizeof(searchHeader));
+        offset += sizeof(searchHeader);
+
+        // Note: the search only skips tree blocks older than generation; check inode transid
+        if (   (searchHeader.type == BTRFS_INODE_ITEM_KEY)
+            && (searchHeader.len >= sizeof(struct btrfs_inode_item))
+           )
+        {
+          struct btrfs_inode_item inodeItem;
+          memcpy(&inodeItem,&searchArgs.buf[offset],sizeof(inodeItem));
+          if (le64toh(inodeItem.transid) >= generation)
+          {
+            error = reportBtrfsInodeNames(handle,
+                                          searchHeader.objectid,
+                                          basePath,
+                                          pathName,
+                                          fileChangedEntryFunction,
+                                          fileChangedEntryUserData
+                                         );
+          }
+        }
+
+        offset += searchHeader.len;
+      }
+
+      moreFlag = nextBtrfsSearchKey(&searchArgs.key,&searchHeader);
+    }
+    close(handle);
+
+    return error;
+  #else /* not HAVE_BTRFS_CHANGE_GENERATION */
+    UNUSED_VARIABLE(pathName);
+    UNUSED_VARIABLE(generation);
+    UNUSED_VARIABLE(fileChangedEntryFunction);
+    UNUSED_VARIABLE(fileChangedEntryUserData);
+
+    return ERROR_FUNCTION_NOT_SUPPORTED;
+  #endif /* HAVE_BTRFS_CHANGE_GENERATION */
+}
+
 String File_castToString(String string, const FileCast *fileCast)
 {
   char      s[64];
@@ -97,10 +97,11 @@ typedef enum
 } FileModes;
 
 // additional file open flags
-#define FILE_SPARSE        (1 << 16)
-#define FILE_STREAM        (1 << 17)
-#define FILE_OPEN_NO_CACHE (1 << 18)
-#define FILE_OPEN_NO_ATIME (1 << 19)
+#define FILE_SPARSE          (1 << 16)
+#define FILE_STREAM          (1 << 17)
+#define FILE_OPEN_NO_CACHE   (1 << 18)
+#define FILE_OPEN_NO_ATIME   (1 << 19)
+#define FILE_OPEN_READ_AHEAD (1 << 20)  // asynchronous read-ahead of sequentially read data
 
 // special file descriptors
 #define FILE_DESCRIPTOR_STDIN  STDIN_FILENO
@@ -257,6 +258,7 @@ typedef struct
   FILE       *file;  // Note: use streamed i/o because for sparse files/hardlinks small data chunks may be written.
   uint64     index;
   uint64     size;
+  uint64     readAheadIndex;  // end of requested read-ahead data
   #if   defined(PLATFORM_LINUX)
     #ifndef NDEBUG
       bool deleteOnCloseFlag;
@@ -322,6 +324,20 @@ typedef struct
   LIST_HEADER(FileExtendedAttributeNode);
 } FileExtendedAttributeList;
 
+// file holes (sparse regions)
+typedef struct FileHoleNode
+{
+  LIST_NODE_HEADER(struct FileHoleNode);
+
+  uint64 offset;
+  uint64 size;
+} FileHoleNode;
+
+typedef struct
+{
+  LIST_HEADER(FileHoleNode);
+} FileHoleList;
+
 // file cast: change if file is modified in some way
 //typedef byte FileCast[FILE_CAST_SIZE];
 typedef struct
@@ -361,6 +377,27 @@ typedef struct
   uint   maxFileNameLength;
 } FileSystemInfo;
 
+// file system change generation
+typedef struct
+{
+  uint64 generation;                  // file system generation (transaction id)
+  byte   uuid[16];                    // file system/sub-volume UUID
+} FileChangeGeneration;
+
+/***********************************************************************\
+* Name   : FileChangedEntryFunction
+* Purpose: changed entry call back
+* Input  : name     - name of changed entry
+*          userData - user data
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+typedef void(*FileChangedEntryFunction)(ConstString name,
+                                        void        *userData
+                                       );
+
 typedef struct
 {
   StringTokenizer stringTokenizer;
@@ -1036,7 +1073,7 @@ Errors File_printLine(FileHandle *fileHandle,
 *          length         - number of bytes to transfer or -1
 * Output : bytesTransfered - bytes transfered (can be NULL)
 * Return : ERROR_NONE or error code
-* Notes  : -
+* Notes  : data is transfered inside the kernel if possible
 \***********************************************************************/
 
 Errors File_transfer(FileHandle *fileHandle,
@@ -1142,6 +1179,40 @@ Errors File_truncate(FileHandle *fileHandle,
                      uint64     size
                     );
 
+/***********************************************************************\
+* Name   : File_punchHole
+* Purpose: deallocate data of a file range (create hole)
+* Input  : fileHandle - file handle
+*          offset     - offset (0..n-1)
+*          length     - length of range [bytes]
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : file size is not changed; if not supported by the file
+*          system the range is overwritten with 0-bytes
+\***********************************************************************/
+
+Errors File_punchHole(FileHandle *fileHandle,
+                      uint64     offset,
+                      uint64     length
+                     );
+
+/***********************************************************************\
+* Name   : File_readAhead
+* Purpose: request asynchronous read of data into file system cache
+* Input  : fileHandle - file handle
+*          offset     - offset (0..n-1)
+*          length     - length of data to read
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : does not wait for data; data is read by the operating
+*          system while the caller process already read data
+\***********************************************************************/
+
+Errors File_readAhead(FileHandle *fileHandle,
+                      uint64     offset,
+                      uint64     length
+                     );
+
 /***********************************************************************\
 * Name   : File_dropCaches
 * Purpose: drop any data in file system cache when possible
@@ -1761,6 +1832,119 @@ Errors File_setExtendedAttributes(ConstString                     fileName,
                                   const FileExtendedAttributeList *fileExtendedAttributeList
                                  );
 
+/***********************************************************************\
+* Name   : File_initHoles
+* Purpose: initialize holes list
+* Input  : fileHoleList - holes list
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+void File_initHoles(FileHoleList *fileHoleList);
+
+/***********************************************************************\
+* Name   : File_doneHoles
+* Purpose: deinitialize holes list
+* Input  : fileHoleList - holes list
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+void File_doneHoles(FileHoleList *fileHoleList);
+
+/***********************************************************************\
+* Name   : File_addHole
+* Purpose: add hole to list
+* Input  : fileHoleList - holes list
+*          offset       - hole offset [bytes]
+*          size         - hole size [bytes]
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+void File_addHole(FileHoleList *fileHoleList,
+                  uint64       offset,
+                  uint64       size
+                 );
+
+/***********************************************************************\
+* Name   : File_getHoles
+* Purpose: get holes of sparse file
+* Input  : fileHoleList - holes list
+*          fileHandle   - file handle
+*          offset       - start offset [bytes]
+*          length       - length of range [bytes]
+*          minHoleSize  - min. size of hole [bytes]; smaller holes are
+*                         reported as data
+* Output : fileHoleList - holes list with holes in range offset..
+*                         offset+length-1
+* Return : ERROR_NONE or error code
+* Notes  : holes are detected with SEEK_DATA/SEEK_HOLE; if not supported
+*          by the system or file system no holes are reported
+*          file position is not changed
+\***********************************************************************/
+
+Errors File_getHoles(FileHoleList *fileHoleList,
+                     FileHandle   *fileHandle,
+                     uint64       offset,
+                     uint64       length,
+                     uint64       minHoleSize
+                    );
+
+/***********************************************************************\
+* Name   : File_getNextData
+* Purpose: get next data range of sparse file
+* Input  : fileHoleNode - next hole or NULL
+*          offset       - current offset [bytes]
+*          endOffset    - end offset of range [bytes]
+* Output : fileHoleNode - next hole after data or NULL
+*          dataSize     - size of data until next hole or end offset
+*                         [bytes]; 0 if end offset is reached
+* Return : offset of data [bytes]
+* Notes  : holes are sorted by offset; a hole at offset is skipped
+\***********************************************************************/
+
+uint64 File_getNextData(const FileHoleNode **fileHoleNode,
+                        uint64             offset,
+                        uint64             endOffset,
+                        uint64             *dataSize
+                       );
+
+/***********************************************************************\
+* Name   : File_getDataSize
+* Purpose: get size of data in range of sparse file
+* Input  : fileHoleList - holes list
+*          offset       - start offset [bytes]
+*          length       - length of range [bytes]
+* Output : -
+* Return : size of data without holes [bytes]
+* Notes  : -
+\***********************************************************************/
+
+uint64 File_getDataSize(const FileHoleList *fileHoleList,
+                        uint64             offset,
+                        uint64             length
+                       );
+
+/***********************************************************************\
+* Name   : File_getRangeSize
+* Purpose: get size of range in sparse file with data
+* Input  : fileHoleList - holes list
+*          offset       - start offset [bytes]
+*          dataSize     - size of data [bytes]
+* Output : -
+* Return : size of range with data and holes [bytes]
+* Notes  : holes at the start and at the end of the range are included
+\***********************************************************************/
+
+uint64 File_getRangeSize(const FileHoleList *fileHoleList,
+                         uint64             offset,
+                         uint64             dataSize
+                        );
+
 /***********************************************************************\
 * Name   : File_getFileTimeModified
 * Purpose: get file modified time
@@ -1941,6 +2125,42 @@ Errors File_getFileSystemInfo(FileSystemInfo *fileSystemInfo,
                               ConstString    pathName
                              );
 
+/***********************************************************************\
+* Name   : File_getChangeGeneration
+* Purpose: get current change generation of file system
+* Input  : pathName - path name
+* Output : fileChangeGeneration - change generation
+* Return : ERROR_NONE or error code
+* Notes  : only supported for btrfs (generation of sub-volume);
+*          ERROR_FUNCTION_NOT_SUPPORTED otherwise
+\***********************************************************************/
+
+Errors File_getChangeGeneration(FileChangeGeneration *fileChangeGeneration,
+                                ConstString          pathName
+                               );
+
+/***********************************************************************\
+* Name   : File_getChangedEntries
+* Purpose: get entries changed since change generation
+* Input  : pathName                 - directory name
+*          generation               - change generation
+*          fileChangedEntryFunction - changed entry call back
+*          fileChangedEntryUserData - user data for call back
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : reports all names of inodes below pathName created or
+*          modified since generation; deleted entries are not
+*          reported. Only supported for btrfs and root privileges;
+*          ERROR_FUNCTION_NOT_SUPPORTED if pathName contains other
+*          sub-volumes or mount points
+\***********************************************************************/
+
+Errors File_getChangedEntries(ConstString              pathName,
+                              uint64                   generation,
+                              FileChangedEntryFunction fileChangedEntryFunction,
+                              void                     *fileChangedEntryUserData
+                             );
+
 
 INLINE bool File_isEqualsCast(const FileCast *fileCast0, const FileCast *fileCast1);
 #if defined(NDEBUG) || defined(__FILES_IMPLEMENTATION__)
@@ -51,6 +51,7 @@
 #include <assert.h>
 
 #if   defined(PLATFORM_LINUX)
+  #include <sys/resource.h>
 #elif defined(PLATFORM_WINDOWS)
   #include <winsock2.h>  // Windows brain dead
   #include <windows.h>
@@ -1022,6 +1023,35 @@ uint64 Misc_getTimestamp(void)
   }
 }
 
+uint64 Misc_getThreadTime(void)
+{
+  #if   defined(PLATFORM_LINUX)
+    struct rusage rusage;
+    if (getrusage(RUSAGE_THREAD,&rusage) == 0)
+    {
+      return   (uint64)rusage.ru_utime.tv_usec+((uint64)rusage.ru_utime.tv_sec)*US_PER_S
+             + (uint64)rusage.ru_stime.tv_usec+((uint64)rusage.ru_stime.tv_sec)*US_PER_S;
+    }
+    else
+    {
+      return 0LL;
+    }
+  #elif defined(PLATFORM_WINDOWS)
+    FILETIME creationTime,exitTime,kernelTime,userTime;
+    if (GetThreadTimes(GetCurrentThread(),&creationTime,&exitTime,&kernelTime,&userTime))
+    {
+      // Note: FILETIME is in 100ns units
+      return   (  ((((uint64)kernelTime.dwHighDateTime) << 32) | (uint64)kernelTime.dwLowDateTime)
+                + ((((uint64)userTime.dwHighDateTime  ) << 32) | (uint64)userTime.dwLowDateTime  )
+               )/10LL;
+    }
+    else
+    {
+      return 0LL;
+    }
+  #endif /* PLATFORM_... */
+}
+
 uint64 Misc_getCurrentDateTime(void)
 {
   uint64 dateTime;
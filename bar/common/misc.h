@@ -648,6 +648,17 @@ uint64 Misc_getRandom(uint64 min, uint64 max);
 
 uint64 Misc_getTimestamp(void);
 
+/***********************************************************************\
+* Name   : Misc_getThreadTime
+* Purpose: get CPU time used by calling thread
+* Input  : -
+* Output : -
+* Return : user+system time of calling thread [us]
+* Notes  : -
+\***********************************************************************/
+
+uint64 Misc_getThreadTime(void);
+
 /***********************************************************************\
 * Name   : Misc_initTimeout
 * Purpose: init timeout
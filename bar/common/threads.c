@@ -744,6 +744,33 @@ LOCAL void *threadStartCode(void *userData)
   return NULL;
 }
 
+/***********************************************************************\
+* Name   : freeThreadLocalStorageInstance
+* Purpose: free thread local variable instance of terminated thread
+* Input  : userData - thread local storage instance node
+* Output : -
+* Return : -
+* Notes  : called by pthread on thread exit
+\***********************************************************************/
+
+LOCAL void freeThreadLocalStorageInstance(void *userData)
+{
+  ThreadLocalStorageInstanceNode *threadLocalStorageInstanceNode = (ThreadLocalStorageInstanceNode*)userData;
+  assert(threadLocalStorageInstanceNode != NULL);
+
+  ThreadLocalStorage *threadLocalStorage = threadLocalStorageInstanceNode->threadLocalStorage;
+  assert(threadLocalStorage != NULL);
+
+  pthread_mutex_lock(&threadLocalStorage->lock);
+  {
+    List_remove(&threadLocalStorage->instanceList,threadLocalStorageInstanceNode);
+  }
+  pthread_mutex_unlock(&threadLocalStorage->lock);
+
+  if (threadLocalStorage->freeFunction != NULL) threadLocalStorage->freeFunction(threadLocalStorageInstanceNode->p,threadLocalStorage->freeUserData);
+  LIST_DELETE_NODE(threadLocalStorageInstanceNode);
+}
+
 /*---------------------------------------------------------------------*/
 
 Errors Thread_initAll(void)
@@ -1011,77 +1038,96 @@ const char *Thread_getCurrentIdString(void)
   return Thread_getIdString(pthread_self());
 }
 
-void Thread_initLocalVariable(ThreadLocalStorage *threadLocalStorage, ThreadLocalStorageAllocFunction threadLocalStorageAllocFunction, void *threadLocalStorageAllocUserData)
+void Thread_initLocalVariable(ThreadLocalStorage              *threadLocalStorage,
+                              ThreadLocalStorageAllocFunction threadLocalStorageAllocFunction,
+                              void                            *threadLocalStorageAllocUserData,
+                              ThreadLocalStorageFreeFunction  threadLocalStorageFreeFunction,
+                              void                            *threadLocalStorageFreeUserData
+                             )
 {
   assert(threadLocalStorage != NULL);
 
   threadLocalStorage->allocFunction = threadLocalStorageAllocFunction;
   threadLocalStorage->allocUserData = threadLocalStorageAllocUserData;
+  threadLocalStorage->freeFunction  = threadLocalStorageFreeFunction;
+  threadLocalStorage->freeUserData  = threadLocalStorageFreeUserData;
+  if (pthread_key_create(&threadLocalStorage->key,freeThreadLocalStorageInstance) != 0)
+  {
+    HALT_INTERNAL_ERROR("cannot create thread local storage key");
+  }
   pthread_mutex_init(&threadLocalStorage->lock,NULL);
   List_init(&threadLocalStorage->instanceList,CALLBACK_(NULL,NULL),CALLBACK_(NULL,NULL));
 }
 
-void Thread_doneLocalVariable(ThreadLocalStorage *threadLocalStorage, ThreadLocalStorageFreeFunction threadLocalStorageFreeFunction, void *threadLocalStorageFreeUserData)
+void Thread_doneLocalVariable(ThreadLocalStorage *threadLocalStorage)
 {
   assert(threadLocalStorage != NULL);
 
+  // no more free on thread exit
+  pthread_key_delete(threadLocalStorage->key);
+
   pthread_mutex_lock(&threadLocalStorage->lock);
   {
     while (!List_isEmpty(&threadLocalStorage->instanceList))
     {
       ThreadLocalStorageInstanceNode *threadLocalStorageInstanceNode = (ThreadLocalStorageInstanceNode*)List_removeFirst(&threadLocalStorage->instanceList);
-      if (threadLocalStorageFreeFunction != NULL) threadLocalStorageFreeFunction(threadLocalStorageInstanceNode->p,threadLocalStorageFreeUserData);
+      if (threadLocalStorage->freeFunction != NULL) threadLocalStorage->freeFunction(threadLocalStorageInstanceNode->p,threadLocalStorage->freeUserData);
       LIST_DELETE_NODE(threadLocalStorageInstanceNode);
     }
   }
   pthread_mutex_unlock(&threadLocalStorage->lock);
+  pthread_mutex_destroy(&threadLocalStorage->lock);
+}
+
+void Thread_removeLocalVariable(ThreadLocalStorage *threadLocalStorage)
+{
+  assert(threadLocalStorage != NULL);
+
+  ThreadLocalStorageInstanceNode *threadLocalStorageInstanceNode = (ThreadLocalStorageInstanceNode*)pthread_getspecific(threadLocalStorage->key);
+  if (threadLocalStorageInstanceNode != NULL)
+  {
+    (void)pthread_setspecific(threadLocalStorage->key,NULL);
+    freeThreadLocalStorageInstance(threadLocalStorageInstanceNode);
+  }
 }
 
 void *Thread_getLocalVariable(ThreadLocalStorage *threadLocalStorage)
 {
   assert(threadLocalStorage != NULL);
 
-  void *p = NULL;
-  pthread_mutex_lock(&threadLocalStorage->lock);
+  // find instance
+  ThreadLocalStorageInstanceNode *threadLocalStorageInstanceNode = (ThreadLocalStorageInstanceNode*)pthread_getspecific(threadLocalStorage->key);
+  if (threadLocalStorageInstanceNode == NULL)
   {
-    // find instance
-    ThreadLocalStorageInstanceNode *threadLocalStorageInstanceNode = (ThreadLocalStorageInstanceNode*)List_first(&threadLocalStorage->instanceList);
-    ThreadId                       currentThreadId                 = Thread_getCurrentId();
-    while (   (threadLocalStorageInstanceNode != NULL)
-           && (pthread_equal(threadLocalStorageInstanceNode->threadId,currentThreadId) == 0)
-          )
+    // allocate new instance
+    threadLocalStorageInstanceNode = LIST_NEW_NODE(ThreadLocalStorageInstanceNode);
+    if (threadLocalStorageInstanceNode == NULL)
     {
-      threadLocalStorageInstanceNode = threadLocalStorageInstanceNode->next;
+      return NULL;
     }
-
-    if (threadLocalStorageInstanceNode == NULL)
+    threadLocalStorageInstanceNode->threadLocalStorage = threadLocalStorage;
+    threadLocalStorageInstanceNode->p                  = threadLocalStorage->allocFunction(threadLocalStorage->allocUserData);
+    if (threadLocalStorageInstanceNode->p == NULL)
     {
-      // allocate new instance
-      threadLocalStorageInstanceNode = LIST_NEW_NODE(ThreadLocalStorageInstanceNode);
-      if (threadLocalStorageInstanceNode == NULL)
-      {
-        pthread_mutex_unlock(&threadLocalStorage->lock);
-        return NULL;
-      }
-      threadLocalStorageInstanceNode->threadId = currentThreadId;
-
-      threadLocalStorageInstanceNode->p = threadLocalStorage->allocFunction(threadLocalStorage->allocUserData);
-      if (threadLocalStorageInstanceNode->p == NULL)
-      {
-        pthread_mutex_unlock(&threadLocalStorage->lock);
-        LIST_DELETE_NODE(threadLocalStorageInstanceNode);
-        return NULL;
-      }
+      LIST_DELETE_NODE(threadLocalStorageInstanceNode);
+      return NULL;
+    }
+    if (pthread_setspecific(threadLocalStorage->key,threadLocalStorageInstanceNode) != 0)
+    {
+      if (threadLocalStorage->freeFunction != NULL) threadLocalStorage->freeFunction(threadLocalStorageInstanceNode->p,threadLocalStorage->freeUserData);
+      LIST_DELETE_NODE(threadLocalStorageInstanceNode);
+      return NULL;
+    }
 
-      // add instance
+    // add instance
+    pthread_mutex_lock(&threadLocalStorage->lock);
+    {
       List_append(&threadLocalStorage->instanceList,threadLocalStorageInstanceNode);
     }
-
-    p = threadLocalStorageInstanceNode->p;
+    pthread_mutex_unlock(&threadLocalStorage->lock);
   }
-  pthread_mutex_unlock(&threadLocalStorage->lock);
 
-  return p;
+  return threadLocalStorageInstanceNode->p;
 }
 
 #ifdef __cplusplus
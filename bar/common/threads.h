@@ -49,10 +49,8 @@ typedef struct ThreadLocalStorageInstanceNode
 {
   LIST_NODE_HEADER(struct ThreadLocalStorageInstanceNode);
 
-  #ifndef HAVE__THREAD
-    ThreadId threadId;
-  #endif /* not HAVE__THREAD */
-  void *p;
+  struct ThreadLocalStorage *threadLocalStorage;
+  void                      *p;
 } ThreadLocalStorageInstanceNode;
 
 typedef struct
@@ -63,10 +61,13 @@ typedef struct
 typedef void*(*ThreadLocalStorageAllocFunction)(void *userData);
 typedef void(*ThreadLocalStorageFreeFunction)(void *variable, void *userData);
 
-typedef struct
+typedef struct ThreadLocalStorage
 {
   ThreadLocalStorageAllocFunction allocFunction;
   void                            *allocUserData;
+  ThreadLocalStorageFreeFunction  freeFunction;
+  void                            *freeUserData;
+  pthread_key_t                   key;                // key of instance of current thread
   pthread_mutex_t                 lock;
   ThreadLocalStorageInstanceList  instanceList;
 } ThreadLocalStorage;
@@ -476,26 +477,45 @@ INLINE uint64 Thread_getCurrentNumber(void)
 * Input  : threadLocalStorageAllocFunction - allocate new variable
 *                                            instance callback code
 *          threadLocalStorageAllocUserData - user data for callback
+*          threadLocalStorageFreeFunction - free variable instance
+*                                           callback code
+*          threadLocalStorageFreeUserData - user data for callback
 * Output : threadLocalStorage - initialized thread local storage handle
 * Return : -
-* Notes  : -
+* Notes  : the instance of a thread is freed automatically when the
+*          thread terminates
 \***********************************************************************/
 
-void Thread_initLocalVariable(ThreadLocalStorage *threadLocalStorage, ThreadLocalStorageAllocFunction threadLocalStorageAllocFunction, void *threadLocalStorageAllocUserData);
+void Thread_initLocalVariable(ThreadLocalStorage              *threadLocalStorage,
+                              ThreadLocalStorageAllocFunction threadLocalStorageAllocFunction,
+                              void                            *threadLocalStorageAllocUserData,
+                              ThreadLocalStorageFreeFunction  threadLocalStorageFreeFunction,
+                              void                            *threadLocalStorageFreeUserData
+                             );
 
 /***********************************************************************\
 * Name   : Thread_doneLocalVariable
 * Purpose: done thread local variable
 * Input  : threadLocalStorage - thread local storage handle
-*          threadLocalStorageFreeFunction - free variable instance
-*                                           callback code
-*          threadLocalStorageFreeUserData - user data for callback
 * Output : -
 * Return : -
-* Notes  : -
+* Notes  : frees the instances of all threads; threads using the
+*          variable must be terminated
+\***********************************************************************/
+
+void Thread_doneLocalVariable(ThreadLocalStorage *threadLocalStorage);
+
+/***********************************************************************\
+* Name   : Thread_removeLocalVariable
+* Purpose: remove thread local variable instance of current thread
+* Input  : threadLocalStorage - thread local storage handle
+* Output : -
+* Return : -
+* Notes  : free resources of thread local variable instance of a
+*          thread which continue to run, e. g. a pool thread
 \***********************************************************************/
 
-void Thread_doneLocalVariable(ThreadLocalStorage *threadLocalStorage, ThreadLocalStorageFreeFunction threadLocalStorageFreeFunction, void *threadLocalStorageFreeUserData);
+void Thread_removeLocalVariable(ThreadLocalStorage *threadLocalStorage);
 
 /***********************************************************************\
 * Name   : Thread_getLocalVariable
@@ -13,12 +13,14 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 #include <assert.h>
 
 #include "common/global.h"
 #include "common/ringbuffers.h"
 #include "common/lists.h"
 #include "common/files.h"
+#include "common/threads.h"
 
 #include "errors.h"
 #include "entrylists.h"
@@ -127,14 +129,43 @@ COMPRESS_ALGORITHMS[] =
   { "xdelta7",  COMPRESS_ALGORITHM_XDELTA_7  },
   { "xdelta8",  COMPRESS_ALGORITHM_XDELTA_8  },
   { "xdelta9",  COMPRESS_ALGORITHM_XDELTA_9  },
+
+  { "cdc",      COMPRESS_ALGORITHM_CDC       },
 };
 
 // size of compress buffers
 #define MAX_BUFFER_SIZE (64*1024)
 
+// adaptive compression: min. sample size and max. entropy [bits/byte] of compressible data
+#define MIN_ENTROPY_SAMPLE_SIZE  (4*1024)
+#define MAX_COMPRESSIBLE_ENTROPY 7.8
+
+// max. number of pooled compress contexts per thread
+#define MAX_COMPRESS_CONTEXT_POOL_SIZE 8
+
 /***************************** Datatypes *******************************/
 
+// free compress context function
+typedef void(*CompressContextFreeFunction)(CompressModes compressMode, void *context);
+
+// pooled compress context
+typedef struct CompressContextNode
+{
+  LIST_NODE_HEADER(struct CompressContextNode);
+
+  CompressModes               compressMode;
+  CompressAlgorithms          compressAlgorithm;
+  void                        *context;              // library context (z_stream, lzma_stream, ZSTD stream)
+  CompressContextFreeFunction freeFunction;          // function to free library context
+} CompressContextNode;
+
+typedef struct
+{
+  LIST_HEADER(CompressContextNode);
+} CompressContextList;
+
 /***************************** Variables *******************************/
+LOCAL ThreadLocalStorage compressContextPool;        // per thread pool of compress contexts
 
 /****************************** Macros *********************************/
 
@@ -185,6 +216,149 @@ LOCAL_INLINE uint32 getUINT32(byte *buffer)
 }
 #endif /* defined(HAVE_LZO) || defined(HAVE_LZ4) */
 
+/***********************************************************************\
+* Name   : freeCompressContextNode
+* Purpose: free pooled compress context node
+* Input  : compressContextNode - compress context node
+*          userData            - user data (not used)
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void freeCompressContextNode(CompressContextNode *compressContextNode, void *userData)
+{
+  assert(compressContextNode != NULL);
+  assert(compressContextNode->freeFunction != NULL);
+
+  UNUSED_VARIABLE(userData);
+
+  compressContextNode->freeFunction(compressContextNode->compressMode,compressContextNode->context);
+}
+
+/***********************************************************************\
+* Name   : newCompressContextList
+* Purpose: allocate compress context pool of a thread
+* Input  : userData - user data (not used)
+* Output : -
+* Return : compress context list or NULL
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void *newCompressContextList(void *userData)
+{
+  UNUSED_VARIABLE(userData);
+
+  CompressContextList *compressContextList = (CompressContextList*)malloc(sizeof(CompressContextList));
+  if (compressContextList == NULL)
+  {
+    return NULL;
+  }
+  List_init(compressContextList,CALLBACK_(NULL,NULL),CALLBACK_((ListNodeFreeFunction)freeCompressContextNode,NULL));
+
+  return compressContextList;
+}
+
+/***********************************************************************\
+* Name   : deleteCompressContextList
+* Purpose: free compress context pool of a thread
+* Input  : variable - compress context list
+*          userData - user data (not used)
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void deleteCompressContextList(void *variable, void *userData)
+{
+  CompressContextList *compressContextList = (CompressContextList*)variable;
+
+  assert(compressContextList != NULL);
+
+  UNUSED_VARIABLE(userData);
+
+  List_done(compressContextList);
+  free(compressContextList);
+}
+
+/***********************************************************************\
+* Name   : leaseCompressContext
+* Purpose: get compress context from pool of current thread
+* Input  : compressMode      - compress mode
+*          compressAlgorithm - compress algorithm
+* Output : -
+* Return : library context or NULL if no pooled context available
+* Notes  : context have to be reset by caller
+\***********************************************************************/
+
+LOCAL void *leaseCompressContext(CompressModes compressMode, CompressAlgorithms compressAlgorithm)
+{
+  CompressContextList *compressContextList = (CompressContextList*)Thread_getLocalVariable(&compressContextPool);
+  if (compressContextList == NULL)
+  {
+    return NULL;
+  }
+
+  CompressContextNode *compressContextNode;
+  LIST_ITERATE(compressContextList,compressContextNode)
+  {
+    if (   (compressContextNode->compressMode == compressMode)
+        && (compressContextNode->compressAlgorithm == compressAlgorithm)
+       )
+    {
+      void *context = compressContextNode->context;
+      List_remove(compressContextList,compressContextNode);
+      LIST_DELETE_NODE(compressContextNode);
+
+      return context;
+    }
+  }
+
+  return NULL;
+}
+
+/***********************************************************************\
+* Name   : releaseCompressContext
+* Purpose: return compress context into pool of current thread
+* Input  : compressMode      - compress mode
+*          compressAlgorithm - compress algorithm
+*          context           - library context
+*          freeFunction      - function to free library context
+* Output : -
+* Return : -
+* Notes  : context is freed if pool is full
+\***********************************************************************/
+
+LOCAL void releaseCompressContext(CompressModes               compressMode,
+                                  CompressAlgorithms          compressAlgorithm,
+                                  void                        *context,
+                                  CompressContextFreeFunction freeFunction
+                                 )
+{
+  assert(context != NULL);
+  assert(freeFunction != NULL);
+
+  CompressContextList *compressContextList = (CompressContextList*)Thread_getLocalVariable(&compressContextPool);
+  if (   (compressContextList != NULL)
+      && (List_count(compressContextList) < MAX_COMPRESS_CONTEXT_POOL_SIZE)
+     )
+  {
+    CompressContextNode *compressContextNode = LIST_NEW_NODE(CompressContextNode);
+    if (compressContextNode != NULL)
+    {
+      compressContextNode->compressMode      = compressMode;
+      compressContextNode->compressAlgorithm = compressAlgorithm;
+      compressContextNode->context           = context;
+      compressContextNode->freeFunction      = freeFunction;
+      List_append(compressContextList,compressContextNode);
+
+      return;
+    }
+  }
+
+  freeFunction(compressMode,context);
+}
+
 #ifdef HAVE_Z
   #include "compress_zip.c"
 #endif /* HAVE_Z */
@@ -206,6 +380,7 @@ LOCAL_INLINE uint32 getUINT32(byte *buffer)
 #ifdef HAVE_XDELTA3
   #include "compress_xd3.c"
 #endif /* HAVE_XDELTA3 */
+#include "compress_cdc.c"
 
 /***********************************************************************\
 * Name   : compressData
@@ -397,6 +572,10 @@ LOCAL Errors compressData(CompressInfo *compressInfo)
         return ERROR_COMPRESS_ALGORITHM_NOT_SUPPORTED;
       #endif /* HAVE_XDELTA3 */
       break;
+    case COMPRESS_ALGORITHM_CDC:
+      // compress with content-defined chunking
+      error = CompressCDC_compressData(compressInfo);
+      break;
     default:
       #ifndef NDEBUG
         HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
@@ -598,6 +777,10 @@ LOCAL Errors decompressData(CompressInfo *compressInfo)
         error = ERROR_COMPRESS_ALGORITHM_NOT_SUPPORTED;
       #endif /* HAVE_XDELTA3 */
       break;
+    case COMPRESS_ALGORITHM_CDC:
+      // decompress with content-defined chunking
+      error = CompressCDC_decompressData(compressInfo);
+      break;
     default:
       #ifndef NDEBUG
         HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
@@ -613,11 +796,20 @@ LOCAL Errors decompressData(CompressInfo *compressInfo)
 
 Errors Compress_initAll(void)
 {
+  Thread_initLocalVariable(&compressContextPool,newCompressContextList,NULL,deleteCompressContextList,NULL);
+  CompressCDC_initAll();
+
   return ERROR_NONE;
 }
 
 void Compress_doneAll(void)
 {
+  Thread_doneLocalVariable(&compressContextPool);
+}
+
+void Compress_doneThreadContexts(void)
+{
+  Thread_removeLocalVariable(&compressContextPool);
 }
 
 const char *Compress_algorithmToString(CompressAlgorithms compressAlgorithm, const char *defaultValue)
@@ -702,10 +894,6 @@ bool Compress_isValidAlgorithm(uint16 n)
 
   assert(compressInfo != NULL);
 
-  #ifndef HAVE_XDELTA3
-    UNUSED_VARIABLE(deltaSourceHandle);
-  #endif
-
   // init variables
   compressInfo->compressMode      = compressMode;
   compressInfo->compressAlgorithm = compressAlgorithm;
@@ -854,6 +1042,9 @@ bool Compress_isValidAlgorithm(uint16 n)
         error = ERROR_COMPRESS_ALGORITHM_NOT_SUPPORTED;
       #endif /* HAVE_XDELTA3 */
       break;
+    case COMPRESS_ALGORITHM_CDC:
+      error = CompressCDC_init(compressInfo,compressMode,deltaSourceHandle);
+      break;
     default:
       #ifndef NDEBUG
         HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
@@ -1013,6 +1204,9 @@ bool Compress_isValidAlgorithm(uint16 n)
         return;
       #endif /* HAVE_XDELTA3 */
       break;
+    case COMPRESS_ALGORITHM_CDC:
+      CompressCDC_done(compressInfo);
+      break;
     default:
       #ifndef NDEBUG
         HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
@@ -1164,6 +1358,9 @@ Errors Compress_reset(CompressInfo *compressInfo)
         error = ERROR_COMPRESS_ALGORITHM_NOT_SUPPORTED;
       #endif /* HAVE_XDELTA3 */
       break;
+    case COMPRESS_ALGORITHM_CDC:
+      error = CompressCDC_reset(compressInfo);
+      break;
     default:
       #ifndef NDEBUG
         HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
@@ -1175,6 +1372,57 @@ Errors Compress_reset(CompressInfo *compressInfo)
   return error;
 }
 
+Errors Compress_disable(CompressInfo *compressInfo)
+{
+  assert(compressInfo != NULL);
+  assert(compressInfo->compressState == COMPRESS_STATE_INIT);
+  assert(RingBuffer_isEmpty(&compressInfo->dataRingBuffer));
+
+  if (compressInfo->compressAlgorithm == COMPRESS_ALGORITHM_NONE)
+  {
+    return ERROR_NONE;
+  }
+
+  CompressModes compressMode = compressInfo->compressMode;
+  ulong         blockLength  = compressInfo->blockLength;
+  uint64        length       = compressInfo->length;
+  Compress_done(compressInfo);
+  return Compress_init(compressInfo,compressMode,COMPRESS_ALGORITHM_NONE,blockLength,length,NULL);
+}
+
+bool Compress_isCompressible(const void *buffer, ulong bufferLength)
+{
+  assert(buffer != NULL);
+
+  // too less data for a reliable estimation
+  if (bufferLength < MIN_ENTROPY_SAMPLE_SIZE)
+  {
+    return TRUE;
+  }
+
+  // get byte histogram
+  ulong histogram[256];
+  memClear(histogram,sizeof(histogram));
+  const byte *p = (const byte*)buffer;
+  for (ulong i = 0; i < bufferLength; i++)
+  {
+    histogram[p[i]]++;
+  }
+
+  // calculate entropy [bits/byte]
+  double entropy = 0.0;
+  for (uint i = 0; i < 256; i++)
+  {
+    if (histogram[i] > 0)
+    {
+      double probability = (double)histogram[i]/(double)bufferLength;
+      entropy -= probability*log2(probability);
+    }
+  }
+
+  return entropy < MAX_COMPRESSIBLE_ENTROPY;
+}
+
 Errors Compress_deflate(CompressInfo *compressInfo,
                         const byte   *buffer,
                         ulong        bufferLength,
@@ -1414,6 +1662,9 @@ uint64 Compress_getInputLength(CompressInfo *compressInfo)
         length = 0LL;
       #endif /* HAVE_XDELTA3 */
       break;
+    case COMPRESS_ALGORITHM_CDC:
+      length = CompressCDC_getInputLength(compressInfo);
+      break;
     default:
       #ifndef NDEBUG
         HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
@@ -1555,6 +1806,9 @@ uint64 Compress_getOutputLength(CompressInfo *compressInfo)
         length = 0LL;
       #endif /* HAVE_XDELTA3 */
       break;
+    case COMPRESS_ALGORITHM_CDC:
+      length = CompressCDC_getOutputLength(compressInfo);
+      break;
     default:
       #ifndef NDEBUG
         HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
@@ -37,6 +37,7 @@
 
 #include "common/global.h"
 #include "common/ringbuffers.h"
+#include "common/dictionaries.h"
 
 #include "archive_format_const.h"
 #include "errors.h"
@@ -139,6 +140,8 @@ typedef enum
   COMPRESS_ALGORITHM_ZSTD_18  = CHUNK_CONST_COMPRESS_ALGORITHM_ZSTD_18,
   COMPRESS_ALGORITHM_ZSTD_19  = CHUNK_CONST_COMPRESS_ALGORITHM_ZSTD_19,
 
+  COMPRESS_ALGORITHM_CDC      = CHUNK_CONST_COMPRESS_ALGORITHM_CDC,
+
   COMPRESS_ALGORITHM_XDELTA_1 = CHUNK_CONST_COMPRESS_ALGORITHM_XDELTA_1,
   COMPRESS_ALGORITHM_XDELTA_2 = CHUNK_CONST_COMPRESS_ALGORITHM_XDELTA_2,
   COMPRESS_ALGORITHM_XDELTA_3 = CHUNK_CONST_COMPRESS_ALGORITHM_XDELTA_3,
@@ -180,7 +183,7 @@ typedef struct
     } none;
     struct
     {
-      z_stream stream;
+      z_stream *stream;                         // ZIP stream (leased from thread context pool)
     } zlib;
     #ifdef HAVE_BZ2
       struct
@@ -193,7 +196,7 @@ typedef struct
       struct
       {
         uint        compressionLevel;           // used compression level (needed for reset)
-        lzma_stream stream;                     // LZMA stream
+        lzma_stream *stream;                    // LZMA stream (leased from thread context pool)
       } lzmalib;
     #endif /* HAVE_LZMA */
     #ifdef HAVE_LZO
@@ -291,6 +294,21 @@ typedef struct
         #endif /* HAVE_XDELTA3 */
       } xdelta;
     #endif /* HAVE_XDELTA3 */
+    struct
+    {
+      DeltaSourceHandle *deltaSourceHandle;     // delta source handle
+      Dictionary        chunkDictionary;        // fingerprints of delta source chunks (compress only)
+      byte              *chunkBuffer;           // data of current chunk (compress only)
+      ulong             chunkLength;            // length of current chunk [bytes]
+      uint64            hash;                   // rolling hash of current chunk
+      byte              *sourceBuffer;          // buffer for delta source data
+      RingBuffer        outputRingBuffer;       // encoded operations (compress only)
+      uint64            copyOffset;             // delta source offset of pending copy
+      ulong             copyLength;             // length of pending copy [bytes]
+      ulong             literalLength;          // remaining length of literal [bytes] (decompress only)
+      uint64            totalInputLength;       // total input length [bytes]
+      uint64            totalOutputLength;      // total output length [bytes]
+    } cdc;
   };
 
   RingBuffer         dataRingBuffer;            // buffer for uncompressed data
@@ -360,6 +378,18 @@ Errors Compress_initAll(void);
 
 void Compress_doneAll(void);
 
+/***********************************************************************\
+* Name   : Compress_doneThreadContexts
+* Purpose: free compress contexts pooled by current thread
+* Input  : -
+* Output : -
+* Return : -
+* Notes  : contexts of a terminated thread are freed automatically;
+*          call in pool threads at the end of a job
+\***********************************************************************/
+
+void Compress_doneThreadContexts(void);
+
 /***********************************************************************\
 * Name   : Compress_algorithmToString
 * Purpose: get name of compress algorithm
@@ -531,6 +561,23 @@ INLINE bool Compress_isXDeltaCompressed(CompressAlgorithms compressAlgorithm)
 }
 #endif /* NDEBUG || __COMPRESS_IMPLEMENTATION__ */
 
+/***********************************************************************\
+* Name   : Compress_isCDCCompressed
+* Purpose: check if content-defined chunking delta algorithm
+* Input  : compressAlgorithm - compress algorithm
+* Output : -
+* Return : TRUE iff CDC compress algorithm, FALSE otherwise
+* Notes  : -
+\***********************************************************************/
+
+INLINE bool Compress_isCDCCompressed(CompressAlgorithms compressAlgorithm);
+#if defined(NDEBUG) || defined(__COMPRESS_IMPLEMENTATION__)
+INLINE bool Compress_isCDCCompressed(CompressAlgorithms compressAlgorithm)
+{
+  return (compressAlgorithm == COMPRESS_ALGORITHM_CDC);
+}
+#endif /* NDEBUG || __COMPRESS_IMPLEMENTATION__ */
+
 /***********************************************************************\
 * Name   : Compress_isByteCompressed
 * Purpose: check if byte-compressed
@@ -566,7 +613,8 @@ INLINE bool Compress_isDeltaCompressed(CompressAlgorithms compressAlgorithm);
 #if defined(NDEBUG) || defined(__COMPRESS_IMPLEMENTATION__)
 INLINE bool Compress_isDeltaCompressed(CompressAlgorithms compressAlgorithm)
 {
-  return    Compress_isXDeltaCompressed(compressAlgorithm);
+  return    Compress_isXDeltaCompressed(compressAlgorithm)
+         || Compress_isCDCCompressed(compressAlgorithm);
 }
 #endif /* NDEBUG || __COMPRESS_IMPLEMENTATION__ */
 
@@ -632,6 +680,30 @@ INLINE bool Compress_isDeltaCompressed(CompressAlgorithms compressAlgorithm)
 
 Errors Compress_reset(CompressInfo *compressInfo);
 
+/***********************************************************************\
+* Name   : Compress_disable
+* Purpose: switch compress handle to no compression
+* Input  : compressInfo - compress info block
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : only allowed before any data is compressed
+\***********************************************************************/
+
+Errors Compress_disable(CompressInfo *compressInfo);
+
+/***********************************************************************\
+* Name   : Compress_isCompressible
+* Purpose: estimate if data is compressible
+* Input  : buffer       - data
+*          bufferLength - length of data
+* Output : -
+* Return : TRUE iff data is probably compressible, FALSE if data looks
+*          random (e. g. already compressed or encrypted data)
+* Notes  : estimation is done by byte entropy of the data
+\***********************************************************************/
+
+bool Compress_isCompressible(const void *buffer, ulong bufferLength);
+
 /***********************************************************************\
 * Name   : Compress_deflate
 * Purpose: deflate (compress) data
@@ -0,0 +1,771 @@
+/***********************************************************************\
+*
+* Contents: Backup ARchiver content-defined chunking delta functions
+* Systems: all
+*
+\***********************************************************************/
+
+/****************************** Includes *******************************/
+#include <config.h>  // use <...> to support separated build directory
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "common/global.h"
+#include "common/ringbuffers.h"
+#include "common/dictionaries.h"
+
+#include "errors.h"
+#include "deltasources.h"
+
+#include "compress.h"
+
+/****************** Conditional compilation switches *******************/
+
+/***************************** Constants *******************************/
+
+#define CDC_MIN_CHUNK_SIZE      (4*KB)                               // min. chunk size
+#define CDC_MAX_CHUNK_SIZE      (64*KB)                              // max. chunk size
+#define CDC_CHUNK_MASK          (((1ULL << 14)-1) << (64-14))        // chunk boundary mask: average chunk size ~16KiB
+
+#define CDC_MAX_OUTPUT_LENGTH   (2*CDC_MAX_CHUNK_SIZE)               // max. pending encoded output before more input is processed
+
+// operations
+#define CDC_OPERATION_LITERAL   0x01
+#define CDC_OPERATION_COPY      0x02
+
+#define CDC_LITERAL_HEADER_SIZE (1+4)
+#define CDC_COPY_HEADER_SIZE    (1+8+4)
+
+/***************************** Datatypes *******************************/
+
+// source chunk
+typedef struct
+{
+  uint64 offset;                                // offset in delta source
+  uint32 length;                                // chunk length [bytes]
+} CDCChunk;
+
+/***************************** Variables *******************************/
+LOCAL uint64 cdcGearTable[256];
+
+/****************************** Macros *********************************/
+
+/***************************** Forwards ********************************/
+
+/***************************** Functions *******************************/
+
+#ifdef __cplusplus
+  extern "C" {
+#endif
+
+/***********************************************************************\
+* Name   : getFingerprint
+* Purpose: get fingerprint of chunk
+* Input  : data   - chunk data
+*          length - chunk length
+* Output : -
+* Return : fingerprint (FNV-1a 64bit)
+* Notes  : -
+\***********************************************************************/
+
+LOCAL uint64 getFingerprint(const byte *data, ulong length)
+{
+  assert(data != NULL);
+
+  uint64 fingerprint = 0xCBF29CE484222325ULL;
+  for (ulong i = 0; i < length; i++)
+  {
+    fingerprint ^= (uint64)data[i];
+    fingerprint *= 0x00000100000001B3ULL;
+  }
+
+  return fingerprint;
+}
+
+/***********************************************************************\
+* Name   : readSource
+* Purpose: read delta source data
+* Input  : compressInfo - compress info block
+*          buffer       - buffer for data
+*          offset       - absolute offset in delta source
+*          length       - length of data to read [bytes]
+* Output : bytesRead - number of bytes read
+* Return : ERROR_NONE or errorcode
+* Notes  : the delta source adds its current base offset to all read
+*          requests; copy operations store absolute offsets, thus the
+*          base offset is subtracted here (uint64 wrap-around gives the
+*          absolute position again when added by the delta source)
+\***********************************************************************/
+
+LOCAL Errors readSource(CompressInfo *compressInfo, byte *buffer, uint64 offset, ulong length, ulong *bytesRead)
+{
+  assert(compressInfo != NULL);
+  assert(compressInfo->cdc.deltaSourceHandle != NULL);
+  assert(buffer != NULL);
+  assert(bytesRead != NULL);
+
+  return DeltaSource_getEntryDataBlock(compressInfo->cdc.deltaSourceHandle,
+                                       buffer,
+                                       offset-DeltaSource_getBaseOffset(compressInfo->cdc.deltaSourceHandle),
+                                       length,
+                                       bytesRead
+                                      );
+}
+
+/***********************************************************************\
+* Name   : putOperation
+* Purpose: put encoded operation into output buffer
+* Input  : compressInfo - compress info block
+*          header       - operation header
+*          headerLength - operation header length [bytes]
+*          data         - operation data or NULL
+*          dataLength   - operation data length [bytes]
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void putOperation(CompressInfo *compressInfo, const byte *header, ulong headerLength, const byte *data, ulong dataLength)
+{
+  assert(compressInfo != NULL);
+  assert(header != NULL);
+
+  if (RingBuffer_getFree(&compressInfo->cdc.outputRingBuffer) < (headerLength+dataLength))
+  {
+    if (!RingBuffer_resize(&compressInfo->cdc.outputRingBuffer,
+                           RingBuffer_getAvailable(&compressInfo->cdc.outputRingBuffer)+headerLength+dataLength
+                          )
+       )
+    {
+      HALT_INSUFFICIENT_MEMORY();
+    }
+  }
+  RingBuffer_put(&compressInfo->cdc.outputRingBuffer,header,headerLength);
+  if (dataLength > 0)
+  {
+    assert(data != NULL);
+    RingBuffer_put(&compressInfo->cdc.outputRingBuffer,data,dataLength);
+  }
+}
+
+/***********************************************************************\
+* Name   : flushCopy
+* Purpose: put pending copy operation into output buffer
+* Input  : compressInfo - compress info block
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void flushCopy(CompressInfo *compressInfo)
+{
+  byte header[CDC_COPY_HEADER_SIZE];
+
+  assert(compressInfo != NULL);
+
+  if (compressInfo->cdc.copyLength > 0)
+  {
+    header[ 0] = CDC_OPERATION_COPY;
+    header[ 1] = (byte)((compressInfo->cdc.copyOffset >> 56) & 0xFF);
+    header[ 2] = (byte)((compressInfo->cdc.copyOffset >> 48) & 0xFF);
+    header[ 3] = (byte)((compressInfo->cdc.copyOffset >> 40) & 0xFF);
+    header[ 4] = (byte)((compressInfo->cdc.copyOffset >> 32) & 0xFF);
+    header[ 5] = (byte)((compressInfo->cdc.copyOffset >> 24) & 0xFF);
+    header[ 6] = (byte)((compressInfo->cdc.copyOffset >> 16) & 0xFF);
+    header[ 7] = (byte)((compressInfo->cdc.copyOffset >>  8) & 0xFF);
+    header[ 8] = (byte)((compressInfo->cdc.copyOffset >>  0) & 0xFF);
+    header[ 9] = (byte)((compressInfo->cdc.copyLength >> 24) & 0xFF);
+    header[10] = (byte)((compressInfo->cdc.copyLength >> 16) & 0xFF);
+    header[11] = (byte)((compressInfo->cdc.copyLength >>  8) & 0xFF);
+    header[12] = (byte)((compressInfo->cdc.copyLength >>  0) & 0xFF);
+    putOperation(compressInfo,header,sizeof(header),NULL,0);
+
+    compressInfo->cdc.copyLength = 0L;
+  }
+}
+
+/***********************************************************************\
+* Name   : storeChunk
+* Purpose: store chunk as copy operation if it is found in the delta
+*          source, as literal otherwise
+* Input  : compressInfo - compress info block
+*          length       - chunk length [bytes]
+* Output : -
+* Return : ERROR_NONE or errorcode
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors storeChunk(CompressInfo *compressInfo, ulong length)
+{
+  uint64   fingerprint;
+  void     *data;
+  ulong    dataLength;
+  CDCChunk cdcChunk;
+  bool     foundFlag;
+  ulong    bytesRead;
+  Errors   error;
+  byte     header[CDC_LITERAL_HEADER_SIZE];
+
+  assert(compressInfo != NULL);
+  assert(length > 0);
+  assert(length <= CDC_MAX_CHUNK_SIZE);
+
+  // find chunk in delta source, verify data
+  fingerprint = getFingerprint(compressInfo->cdc.chunkBuffer,length);
+  foundFlag   = FALSE;
+  if (Dictionary_find(&compressInfo->cdc.chunkDictionary,&fingerprint,sizeof(fingerprint),&data,&dataLength))
+  {
+    assert(dataLength == sizeof(CDCChunk));
+    memCopyFast(&cdcChunk,sizeof(cdcChunk),data,sizeof(cdcChunk));
+    if (cdcChunk.length == length)
+    {
+      error = readSource(compressInfo,compressInfo->cdc.sourceBuffer,cdcChunk.offset,length,&bytesRead);
+      if (error != ERROR_NONE)
+      {
+        return error;
+      }
+      foundFlag =    (bytesRead == length)
+                  && (memcmp(compressInfo->cdc.sourceBuffer,compressInfo->cdc.chunkBuffer,length) == 0);
+    }
+  }
+
+  if (foundFlag)
+  {
+    // copy: append to pending copy if contiguous
+    if (   (compressInfo->cdc.copyLength > 0)
+        && ((compressInfo->cdc.copyOffset+compressInfo->cdc.copyLength) == cdcChunk.offset)
+        && ((compressInfo->cdc.copyLength+length) < MAX_UINT32)
+       )
+    {
+      compressInfo->cdc.copyLength += length;
+    }
+    else
+    {
+      flushCopy(compressInfo);
+      compressInfo->cdc.copyOffset = cdcChunk.offset;
+      compressInfo->cdc.copyLength = length;
+    }
+  }
+  else
+  {
+    // literal
+    flushCopy(compressInfo);
+
+    header[0] = CDC_OPERATION_LITERAL;
+    header[1] = (byte)((length >> 24) & 0xFF);
+    header[2] = (byte)((length >> 16) & 0xFF);
+    header[3] = (byte)((length >>  8) & 0xFF);
+    header[4] = (byte)((length >>  0) & 0xFF);
+    putOperation(compressInfo,header,sizeof(header),compressInfo->cdc.chunkBuffer,length);
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : chunkSource
+* Purpose: split delta source into chunks and store fingerprints
+* Input  : compressInfo - compress info block
+* Output : -
+* Return : ERROR_NONE or errorcode
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors chunkSource(CompressInfo *compressInfo)
+{
+  uint64   size;
+  uint64   offset;
+  uint64   chunkOffset;
+  ulong    chunkLength;
+  uint64   hash;
+  ulong    bytesRead;
+  uint64   fingerprint;
+  CDCChunk cdcChunk;
+  Errors   error;
+
+  assert(compressInfo != NULL);
+  assert(compressInfo->cdc.deltaSourceHandle != NULL);
+
+  // Note: read into source buffer, collect chunk data in chunk buffer
+  size        = DeltaSource_getSize(compressInfo->cdc.deltaSourceHandle);
+  offset      = 0LL;
+  chunkOffset = 0LL;
+  chunkLength = 0L;
+  hash        = 0LL;
+  while (offset < size)
+  {
+    error = readSource(compressInfo,
+                       compressInfo->cdc.sourceBuffer,
+                       offset,
+                       (ulong)MIN(size-offset,(uint64)CDC_MAX_CHUNK_SIZE),
+                       &bytesRead
+                      );
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+    if (bytesRead == 0L)
+    {
+      break;
+    }
+
+    for (ulong i = 0; i < bytesRead; i++)
+    {
+      compressInfo->cdc.chunkBuffer[chunkLength] = compressInfo->cdc.sourceBuffer[i];
+      chunkLength++;
+      hash = (hash << 1)+cdcGearTable[compressInfo->cdc.sourceBuffer[i]];
+      if (   ((chunkLength >= CDC_MIN_CHUNK_SIZE) && ((hash & CDC_CHUNK_MASK) == 0LL))
+          || (chunkLength >= CDC_MAX_CHUNK_SIZE)
+         )
+      {
+        fingerprint     = getFingerprint(compressInfo->cdc.chunkBuffer,chunkLength);
+        cdcChunk.offset = chunkOffset;
+        cdcChunk.length = (uint32)chunkLength;
+        if (!Dictionary_contains(&compressInfo->cdc.chunkDictionary,&fingerprint,sizeof(fingerprint)))
+        {
+          Dictionary_add(&compressInfo->cdc.chunkDictionary,&fingerprint,sizeof(fingerprint),&cdcChunk,sizeof(cdcChunk));
+        }
+
+        chunkOffset += (uint64)chunkLength;
+        chunkLength = 0L;
+        hash        = 0LL;
+      }
+    }
+    offset += (uint64)bytesRead;
+  }
+  if (chunkLength > 0L)
+  {
+    fingerprint     = getFingerprint(compressInfo->cdc.chunkBuffer,chunkLength);
+    cdcChunk.offset = chunkOffset;
+    cdcChunk.length = (uint32)chunkLength;
+    if (!Dictionary_contains(&compressInfo->cdc.chunkDictionary,&fingerprint,sizeof(fingerprint)))
+    {
+      Dictionary_add(&compressInfo->cdc.chunkDictionary,&fingerprint,sizeof(fingerprint),&cdcChunk,sizeof(cdcChunk));
+    }
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : CompressCDC_compressData
+* Purpose: compress data with content-defined chunking
+* Input  : compressInfo - compress info block
+* Output : -
+* Return : ERROR_NONE or errorcode
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors CompressCDC_compressData(CompressInfo *compressInfo)
+{
+  ulong  n;
+  ulong  scanIndex;
+  Errors error;
+
+  assert(compressInfo != NULL);
+
+  if (!compressInfo->endOfDataFlag)                                           // not end-of-data
+  {
+    // split available data into chunks
+    while (   !RingBuffer_isEmpty(&compressInfo->dataRingBuffer)
+           && (RingBuffer_getAvailable(&compressInfo->cdc.outputRingBuffer) < CDC_MAX_OUTPUT_LENGTH)
+          )
+    {
+      n = MIN(RingBuffer_getAvailable(&compressInfo->dataRingBuffer),CDC_MAX_CHUNK_SIZE-compressInfo->cdc.chunkLength);
+      RingBuffer_get(&compressInfo->dataRingBuffer,compressInfo->cdc.chunkBuffer+compressInfo->cdc.chunkLength,n);
+      scanIndex = compressInfo->cdc.chunkLength;
+      compressInfo->cdc.chunkLength      += n;
+      compressInfo->cdc.totalInputLength += (uint64)n;
+
+      while (scanIndex < compressInfo->cdc.chunkLength)
+      {
+        compressInfo->cdc.hash = (compressInfo->cdc.hash << 1)+cdcGearTable[compressInfo->cdc.chunkBuffer[scanIndex]];
+        scanIndex++;
+        if (   ((scanIndex >= CDC_MIN_CHUNK_SIZE) && ((compressInfo->cdc.hash & CDC_CHUNK_MASK) == 0LL))
+            || (scanIndex >= CDC_MAX_CHUNK_SIZE)
+           )
+        {
+          error = storeChunk(compressInfo,scanIndex);
+          if (error != ERROR_NONE)
+          {
+            return error;
+          }
+
+          memmove(compressInfo->cdc.chunkBuffer,
+                  compressInfo->cdc.chunkBuffer+scanIndex,
+                  compressInfo->cdc.chunkLength-scanIndex
+                 );
+          compressInfo->cdc.chunkLength -= scanIndex;
+          compressInfo->cdc.hash        = 0LL;
+          scanIndex = 0L;
+        }
+      }
+
+      compressInfo->compressState = COMPRESS_STATE_RUNNING;
+    }
+
+    // flush: store last chunk and pending copy
+    if (   compressInfo->flushFlag
+        && RingBuffer_isEmpty(&compressInfo->dataRingBuffer)
+       )
+    {
+      if (compressInfo->cdc.chunkLength > 0L)
+      {
+        error = storeChunk(compressInfo,compressInfo->cdc.chunkLength);
+        if (error != ERROR_NONE)
+        {
+          return error;
+        }
+        compressInfo->cdc.chunkLength = 0L;
+        compressInfo->cdc.hash        = 0LL;
+      }
+      flushCopy(compressInfo);
+    }
+
+    // transfer encoded operations -> compress buffer
+    n = MIN(RingBuffer_getAvailable(&compressInfo->cdc.outputRingBuffer),
+            RingBuffer_getFree(&compressInfo->compressRingBuffer)
+           );
+    if (n > 0L)
+    {
+      RingBuffer_move(&compressInfo->cdc.outputRingBuffer,&compressInfo->compressRingBuffer,n);
+      compressInfo->cdc.totalOutputLength += (uint64)n;
+    }
+
+    // check if end-of-data
+    if (   compressInfo->flushFlag
+        && (compressInfo->compressState == COMPRESS_STATE_RUNNING)
+        && RingBuffer_isEmpty(&compressInfo->dataRingBuffer)
+        && (compressInfo->cdc.chunkLength == 0L)
+        && (compressInfo->cdc.copyLength == 0L)
+        && RingBuffer_isEmpty(&compressInfo->cdc.outputRingBuffer)
+       )
+    {
+      compressInfo->endOfDataFlag = TRUE;
+    }
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : CompressCDC_decompressData
+* Purpose: decompress data with content-defined chunking
+* Input  : compressInfo - compress info block
+* Output : -
+* Return : ERROR_NONE or errorcode
+* Notes  : -
+\***********************************************************************/
+
+LOCAL Errors CompressCDC_decompressData(CompressInfo *compressInfo)
+{
+  bool   progressFlag;
+  ulong  n;
+  ulong  bytesRead;
+  byte   operation;
+  byte   header[CDC_COPY_HEADER_SIZE];
+  Errors error;
+
+  assert(compressInfo != NULL);
+
+  if (!compressInfo->endOfDataFlag)                                           // not end-of-data
+  {
+    do
+    {
+      progressFlag = FALSE;
+      if      (compressInfo->cdc.literalLength > 0L)
+      {
+        // literal: transfer compress buffer -> data buffer
+        n = MIN(compressInfo->cdc.literalLength,
+                MIN(RingBuffer_getAvailable(&compressInfo->compressRingBuffer),
+                    RingBuffer_getFree(&compressInfo->dataRingBuffer)
+                   )
+               );
+        if (n > 0L)
+        {
+          RingBuffer_move(&compressInfo->compressRingBuffer,&compressInfo->dataRingBuffer,n);
+          compressInfo->cdc.literalLength     -= n;
+          compressInfo->cdc.totalInputLength  += (uint64)n;
+          compressInfo->cdc.totalOutputLength += (uint64)n;
+          progressFlag = TRUE;
+        }
+      }
+      else if (compressInfo->cdc.copyLength > 0L)
+      {
+        // copy: transfer delta source -> data buffer
+        n = MIN(compressInfo->cdc.copyLength,
+                MIN(RingBuffer_getFree(&compressInfo->dataRingBuffer),
+                    (ulong)CDC_MAX_CHUNK_SIZE
+                   )
+               );
+        if (n > 0L)
+        {
+          error = readSource(compressInfo,compressInfo->cdc.sourceBuffer,compressInfo->cdc.copyOffset,n,&bytesRead);
+          if (error != ERROR_NONE)
+          {
+            return error;
+          }
+          if (bytesRead != n)
+          {
+            return ERRORX_(INFLATE,0,"delta source too short");
+          }
+          RingBuffer_put(&compressInfo->dataRingBuffer,compressInfo->cdc.sourceBuffer,n);
+          compressInfo->cdc.copyOffset        += (uint64)n;
+          compressInfo->cdc.copyLength        -= n;
+          compressInfo->cdc.totalOutputLength += (uint64)n;
+          progressFlag = TRUE;
+        }
+      }
+      else if (!RingBuffer_isEmpty(&compressInfo->compressRingBuffer))
+      {
+        // get next operation (Note: wait until complete header is available)
+        RingBuffer_first(&compressInfo->compressRingBuffer,&operation);
+        switch (operation)
+        {
+          case CDC_OPERATION_LITERAL:
+            if (RingBuffer_getAvailable(&compressInfo->compressRingBuffer) >= CDC_LITERAL_HEADER_SIZE)
+            {
+              RingBuffer_get(&compressInfo->compressRingBuffer,header,CDC_LITERAL_HEADER_SIZE);
+              compressInfo->cdc.literalLength =  ((ulong)header[1] << 24)
+                                                |((ulong)header[2] << 16)
+                                                |((ulong)header[3] <<  8)
+                                                |((ulong)header[4] <<  0);
+              compressInfo->cdc.totalInputLength += CDC_LITERAL_HEADER_SIZE;
+              progressFlag = TRUE;
+            }
+            break;
+          case CDC_OPERATION_COPY:
+            if (RingBuffer_getAvailable(&compressInfo->compressRingBuffer) >= CDC_COPY_HEADER_SIZE)
+            {
+              if (compressInfo->cdc.deltaSourceHandle == NULL)
+              {
+                return ERRORX_(INFLATE,0,"no delta source");
+              }
+              RingBuffer_get(&compressInfo->compressRingBuffer,header,CDC_COPY_HEADER_SIZE);
+              compressInfo->cdc.copyOffset =  ((uint64)header[1] << 56)
+                                             |((uint64)header[2] << 48)
+                                             |((uint64)header[3] << 40)
+                                             |((uint64)header[4] << 32)
+                                             |((uint64)header[5] << 24)
+                                             |((uint64)header[6] << 16)
+                                             |((uint64)header[7] <<  8)
+                                             |((uint64)header[8] <<  0);
+              compressInfo->cdc.copyLength =  ((ulong)header[ 9] << 24)
+                                             |((ulong)header[10] << 16)
+                                             |((ulong)header[11] <<  8)
+                                             |((ulong)header[12] <<  0);
+              compressInfo->cdc.totalInputLength += CDC_COPY_HEADER_SIZE;
+              progressFlag = TRUE;
+            }
+            break;
+          default:
+            return ERRORX_(INFLATE,operation,"invalid content-defined chunking operation");
+            break;
+        }
+      }
+
+      if (progressFlag)
+      {
+        compressInfo->compressState = COMPRESS_STATE_RUNNING;
+      }
+    }
+    while (progressFlag && !RingBuffer_isFull(&compressInfo->dataRingBuffer));
+
+    // check if end-of-data
+    if (   compressInfo->flushFlag
+        && (compressInfo->compressState == COMPRESS_STATE_RUNNING)
+        && RingBuffer_isEmpty(&compressInfo->compressRingBuffer)
+        && (compressInfo->cdc.literalLength == 0L)
+        && (compressInfo->cdc.copyLength == 0L)
+        && RingBuffer_isEmpty(&compressInfo->dataRingBuffer)
+       )
+    {
+      compressInfo->endOfDataFlag = TRUE;
+    }
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : CompressCDC_initAll
+* Purpose: initialize content-defined chunking
+* Input  : -
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void CompressCDC_initAll(void)
+{
+  uint64 x;
+
+  // init gear table with fixed pseudo random values (splitmix64)
+  x = 0LL;
+  for (uint i = 0; i < SIZE_OF_ARRAY(cdcGearTable); i++)
+  {
+    x += 0x9E3779B97F4A7C15ULL;
+    uint64 z = x;
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+    cdcGearTable[i] = z ^ (z >> 31);
+  }
+}
+
+/***********************************************************************\
+* Name   : CompressCDC_init
+* Purpose: init content-defined chunking compress info
+* Input  : compressInfo      - compress info block
+*          compressMode      - compress mode
+*          deltaSourceHandle - delta source handle
+* Output : -
+* Return : ERROR_NONE or errorcode
+* Notes  : for compress the delta source is split into chunks and the
+*          fingerprints of all chunks are stored; chunks are only
+*          referenced in the delta source of the entry, there is no
+*          persistent fingerprint index across storages
+\***********************************************************************/
+
+LOCAL Errors CompressCDC_init(CompressInfo      *compressInfo,
+                              CompressModes     compressMode,
+                              DeltaSourceHandle *deltaSourceHandle
+                             )
+{
+  Errors error;
+
+  assert(compressInfo != NULL);
+
+  // initialize variables
+  compressInfo->cdc.deltaSourceHandle = deltaSourceHandle;
+  compressInfo->cdc.chunkLength       = 0L;
+  compressInfo->cdc.hash              = 0LL;
+  compressInfo->cdc.copyOffset        = 0LL;
+  compressInfo->cdc.copyLength        = 0L;
+  compressInfo->cdc.literalLength     = 0L;
+  compressInfo->cdc.totalInputLength  = 0LL;
+  compressInfo->cdc.totalOutputLength = 0LL;
+  if (!Dictionary_init(&compressInfo->cdc.chunkDictionary,
+                       DICTIONARY_BYTE_INIT_ENTRY,
+                       DICTIONARY_BYTE_DONE_ENTRY,
+                       DICTIONARY_BYTE_COMPARE_ENTRY
+                      )
+     )
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  if (!RingBuffer_init(&compressInfo->cdc.outputRingBuffer,1,CDC_MAX_OUTPUT_LENGTH))
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  compressInfo->cdc.chunkBuffer = (byte*)malloc(CDC_MAX_CHUNK_SIZE);
+  if (compressInfo->cdc.chunkBuffer == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+  compressInfo->cdc.sourceBuffer = (byte*)malloc(CDC_MAX_CHUNK_SIZE);
+  if (compressInfo->cdc.sourceBuffer == NULL)
+  {
+    HALT_INSUFFICIENT_MEMORY();
+  }
+
+  // get fingerprints of delta source chunks
+  if ((compressMode == COMPRESS_MODE_DEFLATE) && (deltaSourceHandle != NULL))
+  {
+    error = chunkSource(compressInfo);
+    if (error != ERROR_NONE)
+    {
+      free(compressInfo->cdc.sourceBuffer);
+      free(compressInfo->cdc.chunkBuffer);
+      RingBuffer_done(&compressInfo->cdc.outputRingBuffer,NULL,NULL);
+      Dictionary_done(&compressInfo->cdc.chunkDictionary);
+      return error;
+    }
+  }
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : CompressCDC_done
+* Purpose: done content-defined chunking compress info
+* Input  : compressInfo - compress info block
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void CompressCDC_done(CompressInfo *compressInfo)
+{
+  assert(compressInfo != NULL);
+
+  free(compressInfo->cdc.sourceBuffer);
+  free(compressInfo->cdc.chunkBuffer);
+  RingBuffer_done(&compressInfo->cdc.outputRingBuffer,NULL,NULL);
+  Dictionary_done(&compressInfo->cdc.chunkDictionary);
+}
+
+/***********************************************************************\
+* Name   : CompressCDC_reset
+* Purpose: reset content-defined chunking compress info
+* Input  : compressInfo - compress info block
+* Output : -
+* Return : ERROR_NONE or errorcode
+* Notes  : fingerprints of delta source chunks are kept
+\***********************************************************************/
+
+LOCAL Errors CompressCDC_reset(CompressInfo *compressInfo)
+{
+  assert(compressInfo != NULL);
+
+  RingBuffer_clear(&compressInfo->cdc.outputRingBuffer,NULL,NULL);
+  compressInfo->cdc.chunkLength       = 0L;
+  compressInfo->cdc.hash              = 0LL;
+  compressInfo->cdc.copyOffset        = 0LL;
+  compressInfo->cdc.copyLength        = 0L;
+  compressInfo->cdc.literalLength     = 0L;
+  compressInfo->cdc.totalInputLength  = 0LL;
+  compressInfo->cdc.totalOutputLength = 0LL;
+
+  return ERROR_NONE;
+}
+
+/***********************************************************************\
+* Name   : CompressCDC_getInputLength
+* Purpose: get number of processed input bytes
+* Input  : compressInfo - compress info block
+* Output : -
+* Return : number of input bytes
+* Notes  : -
+\***********************************************************************/
+
+LOCAL uint64 CompressCDC_getInputLength(CompressInfo *compressInfo)
+{
+  assert(compressInfo != NULL);
+
+  return compressInfo->cdc.totalInputLength;
+}
+
+/***********************************************************************\
+* Name   : CompressCDC_getOutputLength
+* Purpose: get number of produced output bytes
+* Input  : compressInfo - compress info block
+* Output : -
+* Return : number of output bytes
+* Notes  : -
+\***********************************************************************/
+
+LOCAL uint64 CompressCDC_getOutputLength(CompressInfo *compressInfo)
+{
+  assert(compressInfo != NULL);
+
+  return compressInfo->cdc.totalOutputLength;
+}
+
+#ifdef __cplusplus
+  }
+#endif
+
+/* end of file */
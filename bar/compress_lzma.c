@@ -142,20 +142,20 @@ LOCAL Errors CompressLZMA_compressData(CompressInfo *compressInfo)
         ulong maxCompressBytes = RingBuffer_getFree(&compressInfo->compressRingBuffer);
 
         // compress: transfer data buffer -> compress buffer
-        compressInfo->lzmalib.stream.next_in   = (uint8_t*)RingBuffer_cArrayOut(&compressInfo->dataRingBuffer);
-        compressInfo->lzmalib.stream.avail_in  = maxDataBytes;
-        compressInfo->lzmalib.stream.next_out  = (uint8_t*)RingBuffer_cArrayIn(&compressInfo->compressRingBuffer);
-        compressInfo->lzmalib.stream.avail_out = maxCompressBytes;
-        lzma_ret lzmaResult = lzma_code(&compressInfo->lzmalib.stream,LZMA_RUN);
+        compressInfo->lzmalib.stream->next_in   = (uint8_t*)RingBuffer_cArrayOut(&compressInfo->dataRingBuffer);
+        compressInfo->lzmalib.stream->avail_in  = maxDataBytes;
+        compressInfo->lzmalib.stream->next_out  = (uint8_t*)RingBuffer_cArrayIn(&compressInfo->compressRingBuffer);
+        compressInfo->lzmalib.stream->avail_out = maxCompressBytes;
+        lzma_ret lzmaResult = lzma_code(compressInfo->lzmalib.stream,LZMA_RUN);
         if (lzmaResult != LZMA_OK)
         {
           return ERRORX_(DEFLATE,lzmaResult,"%s",CompressLZMA_getErrorText(lzmaResult));
         }
         RingBuffer_decrement(&compressInfo->dataRingBuffer,
-                             maxDataBytes-compressInfo->lzmalib.stream.avail_in
+                             maxDataBytes-compressInfo->lzmalib.stream->avail_in
                             );
         RingBuffer_increment(&compressInfo->compressRingBuffer,
-                             maxCompressBytes-compressInfo->lzmalib.stream.avail_out
+                             maxCompressBytes-compressInfo->lzmalib.stream->avail_out
                             );
 
         // update compress state, compress length
@@ -174,11 +174,11 @@ LOCAL Errors CompressLZMA_compressData(CompressInfo *compressInfo)
         ulong maxCompressBytes = RingBuffer_getFree(&compressInfo->compressRingBuffer);
 
         // compress with flush: transfer to compress buffer
-        compressInfo->lzmalib.stream.next_in   = NULL;
-        compressInfo->lzmalib.stream.avail_in  = 0;
-        compressInfo->lzmalib.stream.next_out  = (uint8_t*)RingBuffer_cArrayIn(&compressInfo->compressRingBuffer);
-        compressInfo->lzmalib.stream.avail_out = maxCompressBytes;
-        lzma_ret lzmaResult = lzma_code(&compressInfo->lzmalib.stream,LZMA_FINISH);
+        compressInfo->lzmalib.stream->next_in   = NULL;
+        compressInfo->lzmalib.stream->avail_in  = 0;
+        compressInfo->lzmalib.stream->next_out  = (uint8_t*)RingBuffer_cArrayIn(&compressInfo->compressRingBuffer);
+        compressInfo->lzmalib.stream->avail_out = maxCompressBytes;
+        lzma_ret lzmaResult = lzma_code(compressInfo->lzmalib.stream,LZMA_FINISH);
         if      (lzmaResult == LZMA_STREAM_END)
         {
           compressInfo->endOfDataFlag = TRUE;
@@ -188,7 +188,7 @@ LOCAL Errors CompressLZMA_compressData(CompressInfo *compressInfo)
           return ERRORX_(DEFLATE,lzmaResult,"%s",CompressLZMA_getErrorText(lzmaResult));
         }
         RingBuffer_increment(&compressInfo->compressRingBuffer,
-                             maxCompressBytes-compressInfo->lzmalib.stream.avail_out
+                             maxCompressBytes-compressInfo->lzmalib.stream->avail_out
                             );
       }
     }
@@ -222,11 +222,11 @@ LOCAL Errors CompressLZMA_decompressData(CompressInfo *compressInfo)
         ulong maxDataBytes     = RingBuffer_getFree(&compressInfo->dataRingBuffer);
 
         // decompress: transfer compress buffer -> data buffer
-        compressInfo->lzmalib.stream.next_in   = (uint8_t*)RingBuffer_cArrayOut(&compressInfo->compressRingBuffer);
-        compressInfo->lzmalib.stream.avail_in  = maxCompressBytes;
-        compressInfo->lzmalib.stream.next_out  = (uint8_t*)RingBuffer_cArrayIn(&compressInfo->dataRingBuffer);
-        compressInfo->lzmalib.stream.avail_out = maxDataBytes;
-        lzma_ret lzmaResult = lzma_code(&compressInfo->lzmalib.stream,LZMA_RUN);
+        compressInfo->lzmalib.stream->next_in   = (uint8_t*)RingBuffer_cArrayOut(&compressInfo->compressRingBuffer);
+        compressInfo->lzmalib.stream->avail_in  = maxCompressBytes;
+        compressInfo->lzmalib.stream->next_out  = (uint8_t*)RingBuffer_cArrayIn(&compressInfo->dataRingBuffer);
+        compressInfo->lzmalib.stream->avail_out = maxDataBytes;
+        lzma_ret lzmaResult = lzma_code(compressInfo->lzmalib.stream,LZMA_RUN);
         if      (lzmaResult == LZMA_STREAM_END)
         {
           compressInfo->endOfDataFlag = TRUE;
@@ -236,10 +236,10 @@ LOCAL Errors CompressLZMA_decompressData(CompressInfo *compressInfo)
           return ERRORX_(INFLATE,lzmaResult,"%s",CompressLZMA_getErrorText(lzmaResult));
         }
         RingBuffer_decrement(&compressInfo->compressRingBuffer,
-                             maxCompressBytes-compressInfo->lzmalib.stream.avail_in
+                             maxCompressBytes-compressInfo->lzmalib.stream->avail_in
                             );
         RingBuffer_increment(&compressInfo->dataRingBuffer,
-                             maxDataBytes-compressInfo->lzmalib.stream.avail_out
+                             maxDataBytes-compressInfo->lzmalib.stream->avail_out
                             );
 
         // update compress state
@@ -261,11 +261,11 @@ LOCAL Errors CompressLZMA_decompressData(CompressInfo *compressInfo)
         ulong maxDataBytes = RingBuffer_getFree(&compressInfo->dataRingBuffer);
 
         // decompress with flush: transfer rest of internal data -> data buffer
-        compressInfo->lzmalib.stream.next_in   = NULL;
-        compressInfo->lzmalib.stream.avail_in  = 0;
-        compressInfo->lzmalib.stream.next_out  = (uint8_t*)RingBuffer_cArrayIn(&compressInfo->dataRingBuffer);
-        compressInfo->lzmalib.stream.avail_out = maxDataBytes;
-        lzma_ret lzmaResult = lzma_code(&compressInfo->lzmalib.stream,LZMA_FINISH);
+        compressInfo->lzmalib.stream->next_in   = NULL;
+        compressInfo->lzmalib.stream->avail_in  = 0;
+        compressInfo->lzmalib.stream->next_out  = (uint8_t*)RingBuffer_cArrayIn(&compressInfo->dataRingBuffer);
+        compressInfo->lzmalib.stream->avail_out = maxDataBytes;
+        lzma_ret lzmaResult = lzma_code(compressInfo->lzmalib.stream,LZMA_FINISH);
         if      (lzmaResult == LZMA_STREAM_END)
         {
           compressInfo->endOfDataFlag = TRUE;
@@ -275,7 +275,7 @@ LOCAL Errors CompressLZMA_decompressData(CompressInfo *compressInfo)
           return ERRORX_(INFLATE,lzmaResult,"%s",CompressLZMA_getErrorText(lzmaResult));
         }
         RingBuffer_increment(&compressInfo->dataRingBuffer,
-                             maxDataBytes-compressInfo->lzmalib.stream.avail_out
+                             maxDataBytes-compressInfo->lzmalib.stream->avail_out
                             );
       }
     }
@@ -284,6 +284,28 @@ LOCAL Errors CompressLZMA_decompressData(CompressInfo *compressInfo)
   return ERROR_NONE;
 }
 
+/***********************************************************************\
+* Name   : freeLZMAStream
+* Purpose: free LZMA stream
+* Input  : compressMode - compress mode
+*          context      - LZMA stream
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void freeLZMAStream(CompressModes compressMode, void *context)
+{
+  lzma_stream *stream = (lzma_stream*)context;
+
+  assert(stream != NULL);
+
+  UNUSED_VARIABLE(compressMode);
+
+  lzma_end(stream);
+  free(stream);
+}
+
 /*---------------------------------------------------------------------*/
 
 LOCAL Errors CompressLZMA_init(CompressInfo       *compressInfo,
@@ -311,29 +333,43 @@ LOCAL Errors CompressLZMA_init(CompressInfo       *compressInfo,
       #endif /* NDEBUG */
       break;
   }
-  lzma_stream streamInit = LZMA_STREAM_INIT;
-  compressInfo->lzmalib.stream = streamInit;
-  #ifdef USE_ALLOCATOR
-    compressInfo->lzmalib.stream.allocator = &ALLOCATOR;
-  #else /* not USE_ALLOCATOR */
-    compressInfo->lzmalib.stream.allocator = NULL;
-  #endif /* USE_ALLOCATOR */
+  // get pooled LZMA stream or allocate new LZMA stream
+  compressInfo->lzmalib.stream = (lzma_stream*)leaseCompressContext(compressMode,compressAlgorithm);
+  if (compressInfo->lzmalib.stream == NULL)
+  {
+    compressInfo->lzmalib.stream = (lzma_stream*)malloc(sizeof(lzma_stream));
+    if (compressInfo->lzmalib.stream == NULL)
+    {
+      return ERROR_INSUFFICIENT_MEMORY;
+    }
+    lzma_stream streamInit = LZMA_STREAM_INIT;
+    (*compressInfo->lzmalib.stream) = streamInit;
+    #ifdef USE_ALLOCATOR
+      compressInfo->lzmalib.stream->allocator = &ALLOCATOR;
+    #else /* not USE_ALLOCATOR */
+      compressInfo->lzmalib.stream->allocator = NULL;
+    #endif /* USE_ALLOCATOR */
+  }
+
+  // init coder (Note: memory of a pooled stream is reused by lzma library)
   switch (compressMode)
   {
     case COMPRESS_MODE_DEFLATE:
       {
-        lzma_ret lzmaResult = lzma_easy_encoder(&compressInfo->lzmalib.stream,compressInfo->lzmalib.compressionLevel,LZMA_CHECK_NONE);
+        lzma_ret lzmaResult = lzma_easy_encoder(compressInfo->lzmalib.stream,compressInfo->lzmalib.compressionLevel,LZMA_CHECK_NONE);
         if (lzmaResult != LZMA_OK)
         {
+          freeLZMAStream(compressMode,compressInfo->lzmalib.stream);
           return ERRORX_(INIT_COMPRESS,lzmaResult,"%s",CompressLZMA_getErrorText(lzmaResult));
         }
       }
       break;
     case COMPRESS_MODE_INFLATE:
       {
-        lzma_ret lzmaResult = lzma_auto_decoder(&compressInfo->lzmalib.stream,0xFFFffffFFFFffffLL,0);
+        lzma_ret lzmaResult = lzma_auto_decoder(compressInfo->lzmalib.stream,0xFFFffffFFFFffffLL,0);
         if (lzmaResult != LZMA_OK)
         {
+          freeLZMAStream(compressMode,compressInfo->lzmalib.stream);
           return ERRORX_(INIT_DECOMPRESS,lzmaResult,"%s",CompressLZMA_getErrorText(lzmaResult));
         }
       }
@@ -351,41 +387,32 @@ LOCAL Errors CompressLZMA_init(CompressInfo       *compressInfo,
 LOCAL void CompressLZMA_done(CompressInfo *compressInfo)
 {
   assert(compressInfo != NULL);
+  assert(compressInfo->lzmalib.stream != NULL);
 
-  lzma_end(&compressInfo->lzmalib.stream);
+  releaseCompressContext(compressInfo->compressMode,
+                         compressInfo->compressAlgorithm,
+                         compressInfo->lzmalib.stream,
+                         freeLZMAStream
+                        );
 }
 
 LOCAL Errors CompressLZMA_reset(CompressInfo *compressInfo)
 {
   assert(compressInfo != NULL);
 
-  lzma_stream streamInit    = LZMA_STREAM_INIT;
-  int         lzmalibResult = LZMA_PROG_ERROR;
+  // re-init coder (Note: allocated coder memory is reused by lzma library)
+  int lzmalibResult = LZMA_PROG_ERROR;
   switch (compressInfo->compressMode)
   {
     case COMPRESS_MODE_DEFLATE:
-      lzma_end(&compressInfo->lzmalib.stream);
-      compressInfo->lzmalib.stream = streamInit;
-      #ifdef USE_ALLOCATOR
-        compressInfo->lzmalib.stream.allocator = &ALLOCATOR;
-      #else /* not USE_ALLOCATOR */
-        compressInfo->lzmalib.stream.allocator = NULL;
-      #endif /* USE_ALLOCATOR */
-      lzmalibResult = lzma_easy_encoder(&compressInfo->lzmalib.stream,compressInfo->lzmalib.compressionLevel,LZMA_CHECK_NONE);
+      lzmalibResult = lzma_easy_encoder(compressInfo->lzmalib.stream,compressInfo->lzmalib.compressionLevel,LZMA_CHECK_NONE);
       if (lzmalibResult != LZMA_OK)
       {
         return ERROR_(DEFLATE,lzmalibResult);;
       }
       break;
     case COMPRESS_MODE_INFLATE:
-      lzma_end(&compressInfo->lzmalib.stream);
-      compressInfo->lzmalib.stream = streamInit;
-      #ifdef USE_ALLOCATOR
-        compressInfo->lzmalib.stream.allocator = &ALLOCATOR;
-      #else /* not USE_ALLOCATOR */
-        compressInfo->lzmalib.stream.allocator = NULL;
-      #endif /* USE_ALLOCATOR */
-      lzmalibResult = lzma_auto_decoder(&compressInfo->lzmalib.stream,0xFFFffffFFFFffffLL,0);
+      lzmalibResult = lzma_auto_decoder(compressInfo->lzmalib.stream,0xFFFffffFFFFffffLL,0);
       if (lzmalibResult != LZMA_OK)
       {
         return ERROR_(INFLATE,lzmalibResult);
@@ -405,14 +432,14 @@ LOCAL uint64 CompressLZMA_getInputLength(CompressInfo *compressInfo)
 {
   assert(compressInfo != NULL);
 
-  return (uint64)compressInfo->lzmalib.stream.total_in;
+  return (uint64)compressInfo->lzmalib.stream->total_in;
 }
 
 LOCAL uint64 CompressLZMA_getOutputLength(CompressInfo *compressInfo)
 {
   assert(compressInfo != NULL);
 
-  return (uint64)compressInfo->lzmalib.stream.total_out;
+  return (uint64)compressInfo->lzmalib.stream->total_out;
 }
 
 #ifdef __cplusplus
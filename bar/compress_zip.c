@@ -69,11 +69,11 @@ LOCAL Errors CompressZIP_compressData(CompressInfo *compressInfo)
         ulong maxCompressBytes = RingBuffer_getFree(&compressInfo->compressRingBuffer);
 
         // compress: data buffer -> compress buffer
-        compressInfo->zlib.stream.next_in   = (Bytef*)RingBuffer_cArrayOut(&compressInfo->dataRingBuffer);
-        compressInfo->zlib.stream.avail_in  = maxDataBytes;
-        compressInfo->zlib.stream.next_out  = (Bytef*)RingBuffer_cArrayIn(&compressInfo->compressRingBuffer);
-        compressInfo->zlib.stream.avail_out = maxCompressBytes;
-        int zlibError = deflate(&compressInfo->zlib.stream,Z_NO_FLUSH);
+        compressInfo->zlib.stream->next_in   = (Bytef*)RingBuffer_cArrayOut(&compressInfo->dataRingBuffer);
+        compressInfo->zlib.stream->avail_in  = maxDataBytes;
+        compressInfo->zlib.stream->next_out  = (Bytef*)RingBuffer_cArrayIn(&compressInfo->compressRingBuffer);
+        compressInfo->zlib.stream->avail_out = maxCompressBytes;
+        int zlibError = deflate(compressInfo->zlib.stream,Z_NO_FLUSH);
         if (    (zlibError != Z_OK)
              && (zlibError != Z_BUF_ERROR)
            )
@@ -81,10 +81,10 @@ LOCAL Errors CompressZIP_compressData(CompressInfo *compressInfo)
           return ERROR_(DEFLATE,zlibError);
         }
         RingBuffer_decrement(&compressInfo->dataRingBuffer,
-                             maxDataBytes-compressInfo->zlib.stream.avail_in
+                             maxDataBytes-compressInfo->zlib.stream->avail_in
                             );
         RingBuffer_increment(&compressInfo->compressRingBuffer,
-                             maxCompressBytes-compressInfo->zlib.stream.avail_out
+                             maxCompressBytes-compressInfo->zlib.stream->avail_out
                             );
 
         // update compress state
@@ -103,11 +103,11 @@ LOCAL Errors CompressZIP_compressData(CompressInfo *compressInfo)
         ulong maxCompressBytes = RingBuffer_getFree(&compressInfo->compressRingBuffer);
 
         // compress with flush: transfer to compress buffer
-        compressInfo->zlib.stream.next_in   = NULL;
-        compressInfo->zlib.stream.avail_in  = 0;
-        compressInfo->zlib.stream.next_out  = (Bytef*)RingBuffer_cArrayIn(&compressInfo->compressRingBuffer);
-        compressInfo->zlib.stream.avail_out = maxCompressBytes;
-        int zlibError = deflate(&compressInfo->zlib.stream,Z_FINISH);
+        compressInfo->zlib.stream->next_in   = NULL;
+        compressInfo->zlib.stream->avail_in  = 0;
+        compressInfo->zlib.stream->next_out  = (Bytef*)RingBuffer_cArrayIn(&compressInfo->compressRingBuffer);
+        compressInfo->zlib.stream->avail_out = maxCompressBytes;
+        int zlibError = deflate(compressInfo->zlib.stream,Z_FINISH);
         if      (zlibError == Z_STREAM_END)
         {
           compressInfo->endOfDataFlag = TRUE;
@@ -119,7 +119,7 @@ LOCAL Errors CompressZIP_compressData(CompressInfo *compressInfo)
           return ERROR_(DEFLATE,zlibError);
         }
         RingBuffer_increment(&compressInfo->compressRingBuffer,
-                             maxCompressBytes-compressInfo->zlib.stream.avail_out
+                             maxCompressBytes-compressInfo->zlib.stream->avail_out
                             );
       }
     }
@@ -153,13 +153,13 @@ LOCAL Errors CompressZIP_decompressData(CompressInfo *compressInfo)
         ulong maxDataBytes     = RingBuffer_getFree(&compressInfo->dataRingBuffer);
 
         // decompress: transfer compress buffer -> data buffer
-        compressInfo->zlib.stream.next_in   = (Bytef*)RingBuffer_cArrayOut(&compressInfo->compressRingBuffer);
-        compressInfo->zlib.stream.avail_in  = maxCompressBytes;
-        compressInfo->zlib.stream.next_out  = (Bytef*)RingBuffer_cArrayIn(&compressInfo->dataRingBuffer);
-        compressInfo->zlib.stream.avail_out = maxDataBytes;
-//memClear(compressInfo->zlib.stream.next_in,compressInfo->zlib.stream.avail_in);
-//memClear(compressInfo->zlib.stream.next_out,compressInfo->zlib.stream.avail_out);
-        int zlibResult = inflate(&compressInfo->zlib.stream,Z_NO_FLUSH);
+        compressInfo->zlib.stream->next_in   = (Bytef*)RingBuffer_cArrayOut(&compressInfo->compressRingBuffer);
+        compressInfo->zlib.stream->avail_in  = maxCompressBytes;
+        compressInfo->zlib.stream->next_out  = (Bytef*)RingBuffer_cArrayIn(&compressInfo->dataRingBuffer);
+        compressInfo->zlib.stream->avail_out = maxDataBytes;
+//memClear(compressInfo->zlib.stream->next_in,compressInfo->zlib.stream->avail_in);
+//memClear(compressInfo->zlib.stream->next_out,compressInfo->zlib.stream->avail_out);
+        int zlibResult = inflate(compressInfo->zlib.stream,Z_NO_FLUSH);
         if      (zlibResult == Z_STREAM_END)
         {
           compressInfo->endOfDataFlag = TRUE;
@@ -171,10 +171,10 @@ LOCAL Errors CompressZIP_decompressData(CompressInfo *compressInfo)
           return ERROR_(INFLATE,zlibResult);
         }
         RingBuffer_decrement(&compressInfo->compressRingBuffer,
-                             maxCompressBytes-compressInfo->zlib.stream.avail_in
+                             maxCompressBytes-compressInfo->zlib.stream->avail_in
                             );
         RingBuffer_increment(&compressInfo->dataRingBuffer,
-                             maxDataBytes-compressInfo->zlib.stream.avail_out
+                             maxDataBytes-compressInfo->zlib.stream->avail_out
                             );
 
         // update compress state
@@ -193,11 +193,11 @@ LOCAL Errors CompressZIP_decompressData(CompressInfo *compressInfo)
         ulong maxDataBytes = RingBuffer_getFree(&compressInfo->dataRingBuffer);
 
         // decompress with flush: transfer rest of internal data -> data buffer
-        compressInfo->zlib.stream.next_in   = NULL;
-        compressInfo->zlib.stream.avail_in  = 0;
-        compressInfo->zlib.stream.next_out  = (Bytef*)RingBuffer_cArrayIn(&compressInfo->dataRingBuffer);
-        compressInfo->zlib.stream.avail_out = maxDataBytes;
-        int zlibResult = inflate(&compressInfo->zlib.stream,Z_FINISH);
+        compressInfo->zlib.stream->next_in   = NULL;
+        compressInfo->zlib.stream->avail_in  = 0;
+        compressInfo->zlib.stream->next_out  = (Bytef*)RingBuffer_cArrayIn(&compressInfo->dataRingBuffer);
+        compressInfo->zlib.stream->avail_out = maxDataBytes;
+        int zlibResult = inflate(compressInfo->zlib.stream,Z_FINISH);
         if      (zlibResult == Z_STREAM_END)
         {
           compressInfo->endOfDataFlag = TRUE;
@@ -209,7 +209,7 @@ LOCAL Errors CompressZIP_decompressData(CompressInfo *compressInfo)
           return ERROR_(INFLATE,zlibResult);
         }
         RingBuffer_increment(&compressInfo->dataRingBuffer,
-                             maxDataBytes-compressInfo->zlib.stream.avail_out
+                             maxDataBytes-compressInfo->zlib.stream->avail_out
                             );
       }
     }
@@ -218,6 +218,39 @@ LOCAL Errors CompressZIP_decompressData(CompressInfo *compressInfo)
   return ERROR_NONE;
 }
 
+/***********************************************************************\
+* Name   : freeZIPStream
+* Purpose: free ZIP stream
+* Input  : compressMode - compress mode
+*          context      - ZIP stream
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void freeZIPStream(CompressModes compressMode, void *context)
+{
+  z_stream *stream = (z_stream*)context;
+
+  assert(stream != NULL);
+
+  switch (compressMode)
+  {
+    case COMPRESS_MODE_DEFLATE:
+      deflateEnd(stream);
+      break;
+    case COMPRESS_MODE_INFLATE:
+      inflateEnd(stream);
+      break;
+    #ifndef NDEBUG
+      default:
+        HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+        break; /* not reached */
+    #endif /* NDEBUG */
+  }
+  free(stream);
+}
+
 /*---------------------------------------------------------------------*/
 
 LOCAL Errors CompressZIP_init(CompressInfo       *compressInfo,
@@ -246,34 +279,67 @@ LOCAL Errors CompressZIP_init(CompressInfo       *compressInfo,
       #endif /* NDEBUG */
       break;
   }
-  compressInfo->zlib.stream.zalloc = Z_NULL;
-  compressInfo->zlib.stream.zfree  = Z_NULL;
-  compressInfo->zlib.stream.opaque = Z_NULL;
-  switch (compressMode)
+  // get pooled ZIP stream
+  compressInfo->zlib.stream = (z_stream*)leaseCompressContext(compressMode,compressAlgorithm);
+  if (compressInfo->zlib.stream != NULL)
   {
-    case COMPRESS_MODE_DEFLATE:
-      {
-        int zlibResult = deflateInit(&compressInfo->zlib.stream,compressionLevel);
-        if (zlibResult != Z_OK)
+    int zlibResult = Z_OK;
+    switch (compressMode)
+    {
+      case COMPRESS_MODE_DEFLATE: zlibResult = deflateReset(compressInfo->zlib.stream); break;
+      case COMPRESS_MODE_INFLATE: zlibResult = inflateReset(compressInfo->zlib.stream); break;
+      #ifndef NDEBUG
+        default:
+          HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+          break; /* not reached */
+      #endif /* NDEBUG */
+    }
+    if (zlibResult != Z_OK)
+    {
+      freeZIPStream(compressMode,compressInfo->zlib.stream);
+      compressInfo->zlib.stream = NULL;
+    }
+  }
+
+  // allocate new ZIP stream
+  if (compressInfo->zlib.stream == NULL)
+  {
+    compressInfo->zlib.stream = (z_stream*)malloc(sizeof(z_stream));
+    if (compressInfo->zlib.stream == NULL)
+    {
+      return ERROR_INSUFFICIENT_MEMORY;
+    }
+    compressInfo->zlib.stream->zalloc = Z_NULL;
+    compressInfo->zlib.stream->zfree  = Z_NULL;
+    compressInfo->zlib.stream->opaque = Z_NULL;
+    switch (compressMode)
+    {
+      case COMPRESS_MODE_DEFLATE:
         {
-          return ERRORX_(INIT_COMPRESS,zlibResult,"%s",zError(zlibResult));
+          int zlibResult = deflateInit(compressInfo->zlib.stream,compressionLevel);
+          if (zlibResult != Z_OK)
+          {
+            free(compressInfo->zlib.stream);
+            return ERRORX_(INIT_COMPRESS,zlibResult,"%s",zError(zlibResult));
+          }
         }
-      }
-      break;
-    case COMPRESS_MODE_INFLATE:
-      {
-        int zlibResult = inflateInit(&compressInfo->zlib.stream);
-        if (zlibResult != Z_OK)
+        break;
+      case COMPRESS_MODE_INFLATE:
         {
-          return ERRORX_(INIT_DECOMPRESS,zlibResult,"%s",zError(zlibResult));
+          int zlibResult = inflateInit(compressInfo->zlib.stream);
+          if (zlibResult != Z_OK)
+          {
+            free(compressInfo->zlib.stream);
+            return ERRORX_(INIT_DECOMPRESS,zlibResult,"%s",zError(zlibResult));
+          }
         }
-      }
-      break;
-    #ifndef NDEBUG
-      default:
-        HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
-        break; /* not reached */
-    #endif /* NDEBUG */
+        break;
+      #ifndef NDEBUG
+        default:
+          HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+          break; /* not reached */
+      #endif /* NDEBUG */
+    }
   }
 
   return ERROR_NONE;
@@ -282,21 +348,13 @@ LOCAL Errors CompressZIP_init(CompressInfo       *compressInfo,
 LOCAL void CompressZIP_done(CompressInfo *compressInfo)
 {
   assert(compressInfo != NULL);
+  assert(compressInfo->zlib.stream != NULL);
 
-  switch (compressInfo->compressMode)
-  {
-    case COMPRESS_MODE_DEFLATE:
-      deflateEnd(&compressInfo->zlib.stream);
-      break;
-    case COMPRESS_MODE_INFLATE:
-      inflateEnd(&compressInfo->zlib.stream);
-      break;
-    #ifndef NDEBUG
-      default:
-        HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
-        break; /* not reached */
-    #endif /* NDEBUG */
-  }
+  releaseCompressContext(compressInfo->compressMode,
+                         compressInfo->compressAlgorithm,
+                         compressInfo->zlib.stream,
+                         freeZIPStream
+                        );
 }
 
 LOCAL Errors CompressZIP_reset(CompressInfo *compressInfo)
@@ -307,7 +365,7 @@ LOCAL Errors CompressZIP_reset(CompressInfo *compressInfo)
   {
     case COMPRESS_MODE_DEFLATE:
       {
-        int zlibResult = deflateReset(&compressInfo->zlib.stream);
+        int zlibResult = deflateReset(compressInfo->zlib.stream);
         if ((zlibResult != Z_OK) && (zlibResult != Z_STREAM_END))
         {
           return ERROR_(DEFLATE,zlibResult);
@@ -316,7 +374,7 @@ LOCAL Errors CompressZIP_reset(CompressInfo *compressInfo)
       break;
     case COMPRESS_MODE_INFLATE:
       {
-        int zlibResult = inflateReset(&compressInfo->zlib.stream);
+        int zlibResult = inflateReset(compressInfo->zlib.stream);
         if ((zlibResult != Z_OK) && (zlibResult != Z_STREAM_END))
         {
           return ERROR_(INFLATE,zlibResult);
@@ -337,14 +395,14 @@ LOCAL uint64 CompressZIP_getInputLength(CompressInfo *compressInfo)
 {
   assert(compressInfo != NULL);
 
-  return (uint64)compressInfo->zlib.stream.total_in;
+  return (uint64)compressInfo->zlib.stream->total_in;
 }
 
 LOCAL uint64 CompressZIP_getOutputLength(CompressInfo *compressInfo)
 {
   assert(compressInfo != NULL);
 
-  return (uint64)compressInfo->zlib.stream.total_out;
+  return (uint64)compressInfo->zlib.stream->total_out;
 }
 
 #ifdef __cplusplus
@@ -228,6 +228,36 @@ LOCAL Errors CompressZStd_decompressData(CompressInfo *compressInfo)
   return ERROR_NONE;
 }
 
+/***********************************************************************\
+* Name   : freeZStdStream
+* Purpose: free ZStd stream
+* Input  : compressMode - compress mode
+*          context      - ZStd stream
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void freeZStdStream(CompressModes compressMode, void *context)
+{
+  assert(context != NULL);
+
+  switch (compressMode)
+  {
+    case COMPRESS_MODE_DEFLATE:
+      ZSTD_freeCStream((ZSTD_CStream*)context);
+      break;
+    case COMPRESS_MODE_INFLATE:
+      ZSTD_freeDStream((ZSTD_DStream*)context);
+      break;
+    #ifndef NDEBUG
+      default:
+        HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
+        break; /* not reached */
+    #endif /* NDEBUG */
+  }
+}
+
 /*---------------------------------------------------------------------*/
 
 LOCAL Errors CompressZStd_init(CompressInfo       *compressInfo,
@@ -268,14 +298,19 @@ LOCAL Errors CompressZStd_init(CompressInfo       *compressInfo,
       #endif /* NDEBUG */
       break;
   }
+  // get pooled ZStd stream or allocate new ZStd stream, init stream
   switch (compressMode)
   {
     case COMPRESS_MODE_DEFLATE:
       {
-        compressInfo->zstd.cStream = ZSTD_createCStream();
+        compressInfo->zstd.cStream = (ZSTD_CStream*)leaseCompressContext(compressMode,compressAlgorithm);
         if (compressInfo->zstd.cStream == NULL)
         {
-          return ERROR_INIT_COMPRESS;
+          compressInfo->zstd.cStream = ZSTD_createCStream();
+          if (compressInfo->zstd.cStream == NULL)
+          {
+            return ERROR_INIT_COMPRESS;
+          }
         }
         size_t zstdResult = ZSTD_initCStream(compressInfo->zstd.cStream,compressInfo->zstd.compressionLevel);
         if (ZSTD_isError(zstdResult))
@@ -287,10 +322,14 @@ LOCAL Errors CompressZStd_init(CompressInfo       *compressInfo,
       break;
     case COMPRESS_MODE_INFLATE:
       {
-        compressInfo->zstd.dStream = ZSTD_createDStream();
+        compressInfo->zstd.dStream = (ZSTD_DStream*)leaseCompressContext(compressMode,compressAlgorithm);
         if (compressInfo->zstd.dStream == NULL)
         {
-          return ERROR_INIT_DECOMPRESS;
+          compressInfo->zstd.dStream = ZSTD_createDStream();
+          if (compressInfo->zstd.dStream == NULL)
+          {
+            return ERROR_INIT_DECOMPRESS;
+          }
         }
         size_t zstdResult = ZSTD_initDStream(compressInfo->zstd.dStream);
         if (ZSTD_isError(zstdResult))
@@ -317,10 +356,18 @@ LOCAL void CompressZStd_done(CompressInfo *compressInfo)
   switch (compressInfo->compressMode)
   {
     case COMPRESS_MODE_DEFLATE:
-      ZSTD_freeCStream(compressInfo->zstd.cStream);
+      releaseCompressContext(compressInfo->compressMode,
+                             compressInfo->compressAlgorithm,
+                             compressInfo->zstd.cStream,
+                             freeZStdStream
+                            );
       break;
     case COMPRESS_MODE_INFLATE:
-      ZSTD_freeDStream(compressInfo->zstd.dStream);
+      releaseCompressContext(compressInfo->compressMode,
+                             compressInfo->compressAlgorithm,
+                             compressInfo->zstd.dStream,
+                             freeZStdStream
+                            );
       break;
     #ifndef NDEBUG
       default:
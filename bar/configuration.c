@@ -138,6 +138,7 @@ LOCAL const CommandLineOptionSelect COMPRESS_ALGORITHMS_DELTA[] = CMD_VALUE_SELE
     {"xdelta8",COMPRESS_ALGORITHM_XDELTA_8,NULL},
     {"xdelta9",COMPRESS_ALGORITHM_XDELTA_9,NULL},
   #endif /* HAVE_XDELTA */
+  {"cdc",  COMPRESS_ALGORITHM_CDC,NULL},
 );
 
 LOCAL CommandLineOptionSelect COMPRESS_ALGORITHMS_BYTE[] = CMD_VALUE_SELECT_ARRAY
@@ -1753,8 +1754,12 @@ LOCAL void initGlobalOptions(void)
   globalOptions.barExecutable                                   = String_new();
   globalOptions.niceLevel                                       = 0;
   globalOptions.maxThreads                                      = 0;
+  globalOptions.singlePassCollectorFlag                         = FALSE;
+  globalOptions.collectorThreads                                = 0;
   globalOptions.tmpDirectory                                    = File_getSystemDirectory(String_new(),FILE_SYSTEM_PATH_TMP,NULL);
   globalOptions.maxTmpSize                                      = 0LL;
+  globalOptions.streamArchivesFlag                              = FALSE;
+  globalOptions.incrementalFileSystemGenerationFlag             = FALSE;
   globalOptions.jobsDirectory                                   = File_getSystemDirectoryCString(String_new(),FILE_SYSTEM_PATH_CONFIGURATION,DEFAULT_JOBS_SUB_DIRECTORY);
   globalOptions.incrementalDataDirectory                        = File_getSystemDirectoryCString(String_new(),FILE_SYSTEM_PATH_RUNTIME,DEFAULT_INCREMENTAL_DATA_SUB_DIRECTORY);
   globalOptions.masterInfo.pairingFileName                      = File_getSystemDirectoryCString(String_new(),FILE_SYSTEM_PATH_RUNTIME,DEFAULT_PAIRING_MASTER_FILE_NAME);
@@ -1917,6 +1922,10 @@ LOCAL void initGlobalOptions(void)
   globalOptions.volumeSize                                      = 0LL;
 
   globalOptions.compressMinFileSize                             = DEFAULT_COMPRESS_MIN_FILE_SIZE;
+  globalOptions.compressAdaptiveFlag                            = FALSE;
+  globalOptions.solidBlockSize                                  = 0LL;
+  globalOptions.deduplicateFlag                                 = FALSE;
+  globalOptions.tableOfContentsFlag                             = FALSE;
   globalOptions.continuousMaxSize                               = 0LL;
   globalOptions.continuousMinTimeDelta                          = 0LL;
 
@@ -8084,6 +8093,7 @@ CommandLineOption BAR_COMMAND_LINE_OPTIONS[] = CMD_VALUE_ARRAY
   CMD_OPTION_ENUM         ("full",                              'f',0,2,globalOptions.archiveType,                           ARCHIVE_TYPE_FULL,                                           "create full archive and incremental list file"                            ),
   CMD_OPTION_ENUM         ("incremental",                       'i',0,2,globalOptions.archiveType,                           ARCHIVE_TYPE_INCREMENTAL,                                    "create incremental archive"                                               ),
   CMD_OPTION_SPECIAL      ("incremental-list-file",             'I',1,2,&globalOptions.incrementalListFileName,              cmdOptionParseString,NULL,1,                                 "incremental list file name (default: <archive name>.bid)","file name"     ),
+  CMD_OPTION_BOOLEAN      ("incremental-fs-generation",         0,  1,2,globalOptions.incrementalFileSystemGenerationFlag,                                                                "find changed entries by file system generation (btrfs)"                   ),
   CMD_OPTION_ENUM         ("differential",                      0,  1,2,globalOptions.archiveType,                           ARCHIVE_TYPE_DIFFERENTIAL,                                   "create differential archive"                                              ),
 
   CMD_OPTION_SELECT       ("pattern-type",                      0,  1,2,globalOptions.patternType,                           BAR_COMMAND_LINE_OPTIONS_PATTERN_TYPES,                      "select pattern type","type","(default)"                                   ),
@@ -8110,6 +8120,7 @@ CommandLineOption BAR_COMMAND_LINE_OPTIONS[] = CMD_VALUE_ARRAY
 
   CMD_OPTION_STRING       ("tmp-directory",                     0,  1,1,globalOptions.tmpDirectory,                                                                                       "temporary directory (default: %default%)","path"                          ),
   CMD_OPTION_INTEGER64    ("max-tmp-size",                      0,  1,1,globalOptions.maxTmpSize,                            0,MAX_LONG_LONG,COMMAND_LINE_BYTES_UNITS,                    "max. size of temporary files"                                             ),
+  CMD_OPTION_BOOLEAN      ("stream-archives",                   0,  1,1,globalOptions.streamArchivesFlag,                                                                                 "stream archive files directly into storage without temporary files"       ),
 
   CMD_OPTION_INTEGER64    ("archive-part-size",                 's',0,2,globalOptions.archivePartSize,                       0,MAX_LONG_LONG,COMMAND_LINE_BYTES_UNITS,                    "approximated archive part size"                                           ),
   CMD_OPTION_INTEGER64    ("fragment-size",                     0,  0,3,globalOptions.fragmentSize,                          0,MAX_LONG_LONG,COMMAND_LINE_BYTES_UNITS,                    "fragment size (default: %default%)"                                       ),
@@ -8147,15 +8158,20 @@ CommandLineOption BAR_COMMAND_LINE_OPTIONS[] = CMD_VALUE_ARRAY
                                                                                                                                                                                           "\n"
                                                                                                                                                                                           "  zstd0..zstd19: ZStd compression level 0..19"
                                                                                                                                                                                           #endif
-                                                                                                                                                                                          #ifdef HAVE_XDELTA
                                                                                                                                                                                           "\n"
                                                                                                                                                                                           "additional select with '+':\n"
-                                                                                                                                                                                          "  xdelta1..xdelta9: XDELTA compression level 1..9"
+                                                                                                                                                                                          #ifdef HAVE_XDELTA
+                                                                                                                                                                                          "  xdelta1..xdelta9: XDELTA compression level 1..9\n"
                                                                                                                                                                                           #endif
+                                                                                                                                                                                          "  cdc             : content-defined chunking delta (requires delta source)"
                                                                                                                                                                                           ,
                                                                                                                                                                                           "algorithm|xdelta+algorithm"                                               ),
   CMD_OPTION_INTEGER      ("compress-min-size",                 0,  1,2,globalOptions.compressMinFileSize,                   0,MAX_INT,COMMAND_LINE_BYTES_UNITS,                          "minimal size of file for compression"                                     ),
   CMD_OPTION_SPECIAL      ("compress-exclude",                  0,  0,3,&globalOptions.compressExcludePatternList,           cmdOptionParsePattern,NULL,1,                                "exclude compression pattern","pattern"                                    ),
+  CMD_OPTION_BOOLEAN      ("compress-adaptive",                 0,  1,2,globalOptions.compressAdaptiveFlag,                                                                               "do not compress incompressible data"                                      ),
+  CMD_OPTION_INTEGER64    ("solid-block-size",                  0,  1,2,globalOptions.solidBlockSize,                        0,MAX_LONG_LONG,COMMAND_LINE_BYTES_UNITS,                    "max. size of solid block for small files (0 = disabled; archive is not readable by versions without solid blocks)"),
+  CMD_OPTION_BOOLEAN      ("deduplicate",                       0,  1,2,globalOptions.deduplicateFlag,                                                                                    "store files with identical content only once"                             ),
+  CMD_OPTION_BOOLEAN      ("table-of-contents",                 0,  1,2,globalOptions.tableOfContentsFlag,                                                                                "add table of contents to archive files (fast access, not readable by versions without TOC support)"),
 
   CMD_OPTION_SPECIAL      ("crypt-algorithm",                   'y',0,2,globalOptions.cryptAlgorithms,                       cmdOptionParseCryptAlgorithms,NULL,1,                        "select crypt algorithms to use\n"
                                                                                                                                                                                           "  none (default)"
@@ -8174,7 +8190,9 @@ CommandLineOption BAR_COMMAND_LINE_OPTIONS[] = CMD_VALUE_ARRAY
                                                                                                                                                                                           "  SERPENT256\n"
                                                                                                                                                                                           "  CAMELLIA128\n"
                                                                                                                                                                                           "  CAMELLIA192\n"
-                                                                                                                                                                                          "  CAMELLIA256"
+                                                                                                                                                                                          "  CAMELLIA256\n"
+                                                                                                                                                                                          "  AES128-GCM\n"
+                                                                                                                                                                                          "  AES256-GCM"
                                                                                                                                                                                           #endif
                                                                                                                                                                                           ,
                                                                                                                                                                                           "algorithm"                                                                ),
@@ -8241,6 +8259,8 @@ CommandLineOption BAR_COMMAND_LINE_OPTIONS[] = CMD_VALUE_ARRAY
 
   CMD_OPTION_INTEGER      ("nice-level",                        0,  1,1,globalOptions.niceLevel,                             0,19,NULL,                                                   "general nice level of processes/threads"                                  ),
   CMD_OPTION_INTEGER      ("max-threads",                       0,  1,1,globalOptions.maxThreads,                            0,65535,NULL,                                                "max. number of concurrent compress/encryption threads"                    ),
+  CMD_OPTION_BOOLEAN      ("single-pass-collector",             0,  1,1,globalOptions.singlePassCollectorFlag,                                                                            "collect entries and total sum in a single pass"                           ),
+  CMD_OPTION_INTEGER      ("collector-threads",                 0,  1,1,globalOptions.collectorThreads,                      0,65535,NULL,                                                "number of parallel directory scan threads for collector"                  ),
 
   CMD_OPTION_SPECIAL      ("max-band-width",                    0,  1,1,&globalOptions.maxBandWidthList,                     cmdOptionParseBandWidth,NULL,1,                              "max. network band width to use [bits/s]","number or file name"            ),
 
@@ -8395,7 +8415,7 @@ CommandLineOption BAR_COMMAND_LINE_OPTIONS[] = CMD_VALUE_ARRAY
   CMD_OPTION_SELECT       ("restore-entry-mode",                0,  1,2,globalOptions.restoreEntryMode,                      BAR_COMMAND_LINE_OPTIONS_RESTORE_ENTRY_MODES,                "restore entry mode","mode","(default)"                                    ),
   // Note: shortcut for --restore-entry-mode=overwrite
   CMD_OPTION_SPECIAL      ("overwrite-files",                   0,  0,2,&globalOptions.restoreEntryMode,                     cmdOptionParseRestoreEntryModeOverwrite,NULL,0,              "overwrite existing entries on restore",""                                 ),
-  CMD_OPTION_BOOLEAN      ("sparse",                            0,  1,2,globalOptions.sparseFlag,                                                                                         "create sparse files/images/hardlinks"                                     ),
+  CMD_OPTION_BOOLEAN      ("sparse",                            0,  1,2,globalOptions.sparseFlag,                                                                                         "store holes of sparse files, create sparse files/images/hardlinks"        ),
   CMD_OPTION_BOOLEAN      ("wait-first-volume",                 0,  1,2,globalOptions.waitFirstVolumeFlag,                                                                                "wait for first volume"                                                    ),
   CMD_OPTION_BOOLEAN      ("no-signature",                      0  ,1,2,globalOptions.noSignatureFlag,                                                                                    "do not create signatures"                                                 ),
   CMD_OPTION_BOOLEAN      ("skip-verify-signatures",            0,  0,2,globalOptions.skipVerifySignaturesFlag,                                                                           "do not verify signatures of archives"                                     ),
@@ -8486,12 +8506,17 @@ const ConfigValue BAR_CONFIG_VALUES[] = CONFIG_VALUE_ARRAY
   CONFIG_VALUE_STRING            ("tmp-directory",                    &globalOptions.tmpDirectory,-1,                                "<directory>"),
   CONFIG_VALUE_COMMENT("max. temporary space to use [K|M|G|T|P]"),
   CONFIG_VALUE_INTEGER64         ("max-tmp-size",                     &globalOptions.maxTmpSize,-1,                                  0LL,MAX_LONG_LONG,CONFIG_VALUE_BYTES_UNITS,"<size>"),
+  CONFIG_VALUE_BOOLEAN           ("stream-archives",                  &globalOptions.streamArchivesFlag,-1,                          "yes|no"),
   CONFIG_VALUE_SPACE(),
 
   CONFIG_VALUE_COMMENT("worker threads nice level [0..19]"),
   CONFIG_VALUE_INTEGER           ("nice-level",                       &globalOptions.niceLevel,-1,                                   0,19,NULL,"<level>"),
-  CONFIG_VALUE_COMMENT("max. number of worker threads (0 for number CPU cores)"),
+  CONFIG_VALUE_COMMENT("max. number of worker threads (0 for number CPU cores, adapted to CPU load)"),
   CONFIG_VALUE_INTEGER           ("max-threads",                      &globalOptions.maxThreads,-1,                                  0,65535,NULL,"<n>"),
+  CONFIG_VALUE_COMMENT("collect entries and total sum in a single pass"),
+  CONFIG_VALUE_BOOLEAN           ("single-pass-collector",            &globalOptions.singlePassCollectorFlag,-1,                     "yes|no"),
+  CONFIG_VALUE_COMMENT("number of parallel directory scan threads for collector (0 for none)"),
+  CONFIG_VALUE_INTEGER           ("collector-threads",                &globalOptions.collectorThreads,-1,                            0,65535,NULL,"<n>"),
   CONFIG_VALUE_SPACE(),
 
   CONFIG_VALUE_COMMENT("max. network band width to use [bits/s]"),
@@ -8571,6 +8596,7 @@ const ConfigValue BAR_CONFIG_VALUES[] = CONFIG_VALUE_ARRAY
   CONFIG_VALUE_STRING            ("archive-name",                     &globalOptions.storageName,-1,                                 "<file name>"),
   CONFIG_VALUE_SELECT            ("archive-type",                     &globalOptions.archiveType,-1,                                 CONFIG_VALUE_ARCHIVE_TYPES,"[normal|full|incremental|differential|continuous]"),
   CONFIG_VALUE_STRING            ("incremental-list-file",            &globalOptions.incrementalListFileName,-1,                     "<file name>"),
+  CONFIG_VALUE_BOOLEAN           ("incremental-fs-generation",        &globalOptions.incrementalFileSystemGenerationFlag,-1,         "yes|no"),
   CONFIG_VALUE_INTEGER64         ("archive-part-size",                &globalOptions.archivePartSize,-1,                             0LL,MAX_LONG_LONG,CONFIG_VALUE_BYTES_UNITS,"<size>"),
   CONFIG_VALUE_SPACE(),
 
@@ -8579,6 +8605,10 @@ const ConfigValue BAR_CONFIG_VALUES[] = CONFIG_VALUE_ARRAY
   CONFIG_VALUE_SPECIAL           ("compress-algorithm",               &globalOptions.compressAlgorithms,-1,                          configValueCompressAlgorithmsParse,configValueCompressAlgorithmsFormat,NULL),
   CONFIG_VALUE_INTEGER           ("compress-min-size",                &globalOptions.compressMinFileSize,-1,                         0,MAX_INT,CONFIG_VALUE_BYTES_UNITS,"<size>"),
   CONFIG_VALUE_SPECIAL           ("compress-exclude",                 &globalOptions.compressExcludePatternList,-1,                  configValuePatternParse,configValuePatternFormat,NULL),
+  CONFIG_VALUE_BOOLEAN           ("compress-adaptive",                &globalOptions.compressAdaptiveFlag,-1,                        "yes|no"),
+  CONFIG_VALUE_INTEGER64         ("solid-block-size",                 &globalOptions.solidBlockSize,-1,                              0LL,MAX_LONG_LONG,CONFIG_VALUE_BYTES_UNITS,"<size>"),
+  CONFIG_VALUE_BOOLEAN           ("deduplicate",                      &globalOptions.deduplicateFlag,-1,                             "yes|no"),
+  CONFIG_VALUE_BOOLEAN           ("table-of-contents",                &globalOptions.tableOfContentsFlag,-1,                         "yes|no"),
   CONFIG_VALUE_SPACE(),
 
   CONFIG_VALUE_COMMENT("encryption"),
@@ -1464,6 +1464,7 @@ LOCAL void connectorCommand_indexNewStorage(ConnectorInfo *connectorInfo, IndexH
 *            permission=<n>
 *            fragmentOffset=<n>
 *            fragmentSize=<n>
+*            archiveOffset=<n>
 *          Result:
 \***********************************************************************/
 
@@ -1571,6 +1572,9 @@ LOCAL void connectorCommand_indexAddFile(ConnectorInfo *connectorInfo, IndexHand
     return;
   }
 
+  uint64 archiveOffset;
+  StringMap_getUInt64(argumentMap,"archiveOffset",&archiveOffset,0LL);
+
   if (indexHandle != NULL)
   {
     // add index file entry
@@ -1587,7 +1591,8 @@ LOCAL void connectorCommand_indexAddFile(ConnectorInfo *connectorInfo, IndexHand
                                       groupId,
                                       permission,
                                       fragmentOffset,
-                                      fragmentSize
+                                      fragmentSize,
+                                      archiveOffset
                                      );
     if (error != ERROR_NONE)
     {
@@ -1633,6 +1638,7 @@ LOCAL void connectorCommand_indexAddFile(ConnectorInfo *connectorInfo, IndexHand
 *            permission=<n>
 *            fragmentOffset=<n>
 *            fragmentSize=<n>
+*            archiveOffset=<n>
 *          Result:
 \***********************************************************************/
 
@@ -1733,6 +1739,9 @@ LOCAL void connectorCommand_indexAddImage(ConnectorInfo *connectorInfo, IndexHan
     return;
   }
 
+  uint64 archiveOffset;
+  StringMap_getUInt64(argumentMap,"archiveOffset",&archiveOffset,0LL);
+
   if (indexHandle != NULL)
   {
     // add index image entry
@@ -1745,7 +1754,8 @@ LOCAL void connectorCommand_indexAddImage(ConnectorInfo *connectorInfo, IndexHan
                                        size,
                                        blockSize,
                                        blockOffset,
-                                       blockCount
+                                       blockCount,
+                                       archiveOffset
                                        );
     if (error != ERROR_NONE)
     {
@@ -1790,6 +1800,7 @@ LOCAL void connectorCommand_indexAddImage(ConnectorInfo *connectorInfo, IndexHan
 *            permission=<n>
 *            fragmentOffset=<n>
 *            fragmentSize=<n>
+*            archiveOffset=<n>
 *          Result:
 \***********************************************************************/
 
@@ -1876,6 +1887,9 @@ LOCAL void connectorCommand_indexAddDirectory(ConnectorInfo *connectorInfo, Inde
     return;
   }
 
+  uint64 archiveOffset;
+  StringMap_getUInt64(argumentMap,"archiveOffset",&archiveOffset,0LL);
+
   if (indexHandle != NULL)
   {
     // add index directory entry
@@ -1889,7 +1903,8 @@ LOCAL void connectorCommand_indexAddDirectory(ConnectorInfo *connectorInfo, Inde
                                            timeLastChanged,
                                            userId,
                                            groupId,
-                                           permission
+                                           permission,
+                                           archiveOffset
                                          );
     if (error != ERROR_NONE)
     {
@@ -1933,6 +1948,7 @@ LOCAL void connectorCommand_indexAddDirectory(ConnectorInfo *connectorInfo, Inde
 *            userId=<n>
 *            groupId=<n>
 *            permission=<n>
+*            archiveOffset=<n>
 *          Result:
 \***********************************************************************/
 
@@ -2034,6 +2050,9 @@ LOCAL void connectorCommand_indexAddLink(ConnectorInfo *connectorInfo, IndexHand
     return;
   }
 
+  uint64 archiveOffset;
+  StringMap_getUInt64(argumentMap,"archiveOffset",&archiveOffset,0LL);
+
   if (indexHandle != NULL)
   {
     // add index link entry
@@ -2048,7 +2067,8 @@ LOCAL void connectorCommand_indexAddLink(ConnectorInfo *connectorInfo, IndexHand
                                       timeLastChanged,
                                       userId,
                                       groupId,
-                                      permission
+                                      permission,
+                                      archiveOffset
                                      );
     if (error != ERROR_NONE)
     {
@@ -2095,6 +2115,7 @@ LOCAL void connectorCommand_indexAddLink(ConnectorInfo *connectorInfo, IndexHand
 *            permission=<n>
 *            fragmentOffset=<n>
 *            fragmentSize=<n>
+*            archiveOffset=<n>
 *          Result:
 \***********************************************************************/
 
@@ -2202,6 +2223,9 @@ LOCAL void connectorCommand_indexAddHardlink(ConnectorInfo *connectorInfo, Index
     return;
   }
 
+  uint64 archiveOffset;
+  StringMap_getUInt64(argumentMap,"archiveOffset",&archiveOffset,0LL);
+
   if (indexHandle != NULL)
   {
     // add index hardlink entry
@@ -2218,7 +2242,8 @@ LOCAL void connectorCommand_indexAddHardlink(ConnectorInfo *connectorInfo, Index
                                           groupId,
                                           permission,
                                           fragmentOffset,
-                                          fragmentSize
+                                          fragmentSize,
+                                          archiveOffset
                                          );
     if (error != ERROR_NONE)
     {
@@ -2263,6 +2288,7 @@ LOCAL void connectorCommand_indexAddHardlink(ConnectorInfo *connectorInfo, Index
 *            permission=<n>
 *            fragmentOffset=<n>
 *            fragmentSize=<n>
+*            archiveOffset=<n>
 *          Result:
 \***********************************************************************/
 
@@ -2390,6 +2416,9 @@ LOCAL void connectorCommand_indexAddSpecial(ConnectorInfo *connectorInfo, IndexH
     return;
   }
 
+  uint64 archiveOffset;
+  StringMap_getUInt64(argumentMap,"archiveOffset",&archiveOffset,0LL);
+
   if (indexHandle != NULL)
   {
     // add index special entry
@@ -2406,7 +2435,8 @@ LOCAL void connectorCommand_indexAddSpecial(ConnectorInfo *connectorInfo, IndexH
                                          groupId,
                                          permission,
                                          major,
-                                         minor
+                                         minor,
+                                         archiveOffset
                                         );
     if (error != ERROR_NONE)
     {
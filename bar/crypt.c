@@ -32,6 +32,7 @@
 #include "common/misc.h"
 #include "common/files.h"
 #include "common/passwords.h"
+#include "common/threads.h"
 
 #include "archive_format.h"
 #include "chunks.h"
@@ -48,6 +49,8 @@
 
 #define BLOCK_LENGTH_CRYPT_NONE 4       // block size if no encryption
 
+#define MAX_CIPHER_HANDLE_POOL_SIZE 4   // max. number of pooled cipher handles per thread
+
 // crypt algorithm names
 LOCAL const struct
 {
@@ -72,6 +75,8 @@ CRYPT_ALGORITHMS[] =
   { "CAMELLIA128",CRYPT_ALGORITHM_CAMELLIA128 },
   { "CAMELLIA192",CRYPT_ALGORITHM_CAMELLIA192 },
   { "CAMELLIA256",CRYPT_ALGORITHM_CAMELLIA256 },
+  { "AES128-GCM", CRYPT_ALGORITHM_AES128_GCM  },
+  { "AES256-GCM", CRYPT_ALGORITHM_AES256_GCM  },
 };
 
 // hash algorithm names
@@ -159,9 +164,29 @@ typedef struct ATTRIBUTE_PACKED
   byte   data[0];                 // encrypted key data
 } KeyImportExportInfo;
 
+#ifdef HAVE_GCRYPT
+// pooled cipher handle
+typedef struct CipherHandleNode
+{
+  LIST_NODE_HEADER(struct CipherHandleNode);
+
+  CryptAlgorithms  cryptAlgorithm;
+  int              gcryptMode;
+  gcry_cipher_hd_t gcry_cipher_hd;
+} CipherHandleNode;
+
+typedef struct
+{
+  LIST_HEADER(CipherHandleNode);
+} CipherHandleList;
+#endif /* HAVE_GCRYPT */
+
 /***************************** Variables *******************************/
 uint cryptKeyLengths[CRYPT_ALGORITHM_MAX+1];
 uint cryptBlockLengths[CRYPT_ALGORITHM_MAX+1];
+#ifdef HAVE_GCRYPT
+LOCAL ThreadLocalStorage cipherHandlePool;  // per thread pool of cipher handles
+#endif /* HAVE_GCRYPT */
 
 /****************************** Macros *********************************/
 
@@ -207,6 +232,8 @@ LOCAL Errors getCryptKeyLength(CryptAlgorithms cryptAlgorithm,
     case CRYPT_ALGORITHM_CAMELLIA128:
     case CRYPT_ALGORITHM_CAMELLIA192:
     case CRYPT_ALGORITHM_CAMELLIA256:
+    case CRYPT_ALGORITHM_AES128_GCM:
+    case CRYPT_ALGORITHM_AES256_GCM:
       #ifdef HAVE_GCRYPT
         {
           int          gcryptAlgorithm;
@@ -230,6 +257,8 @@ LOCAL Errors getCryptKeyLength(CryptAlgorithms cryptAlgorithm,
             case CRYPT_ALGORITHM_CAMELLIA128: gcryptAlgorithm = GCRY_CIPHER_CAMELLIA128; break;
             case CRYPT_ALGORITHM_CAMELLIA192: gcryptAlgorithm = GCRY_CIPHER_CAMELLIA192; break;
             case CRYPT_ALGORITHM_CAMELLIA256: gcryptAlgorithm = GCRY_CIPHER_CAMELLIA256; break;
+            case CRYPT_ALGORITHM_AES128_GCM:  gcryptAlgorithm = GCRY_CIPHER_AES;         break;
+            case CRYPT_ALGORITHM_AES256_GCM:  gcryptAlgorithm = GCRY_CIPHER_AES256;      break;
             default:
               #ifndef NDEBUG
                 HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
@@ -324,6 +353,8 @@ LOCAL Errors getCryptBlockLength(CryptAlgorithms cryptAlgorithm,
     case CRYPT_ALGORITHM_CAMELLIA128:
     case CRYPT_ALGORITHM_CAMELLIA192:
     case CRYPT_ALGORITHM_CAMELLIA256:
+    case CRYPT_ALGORITHM_AES128_GCM:
+    case CRYPT_ALGORITHM_AES256_GCM:
       #ifdef HAVE_GCRYPT
         {
           int          gcryptAlgorithm;
@@ -347,6 +378,8 @@ LOCAL Errors getCryptBlockLength(CryptAlgorithms cryptAlgorithm,
             case CRYPT_ALGORITHM_CAMELLIA128: gcryptAlgorithm = GCRY_CIPHER_CAMELLIA128; break;
             case CRYPT_ALGORITHM_CAMELLIA192: gcryptAlgorithm = GCRY_CIPHER_CAMELLIA192; break;
             case CRYPT_ALGORITHM_CAMELLIA256: gcryptAlgorithm = GCRY_CIPHER_CAMELLIA256; break;
+            case CRYPT_ALGORITHM_AES128_GCM:  gcryptAlgorithm = GCRY_CIPHER_AES;         break;
+            case CRYPT_ALGORITHM_AES256_GCM:  gcryptAlgorithm = GCRY_CIPHER_AES256;      break;
             default:
               #ifndef NDEBUG
                 HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
@@ -407,6 +440,220 @@ LOCAL Errors getCryptBlockLength(CryptAlgorithms cryptAlgorithm,
   return ERROR_NONE;
 }
 
+#ifdef HAVE_GCRYPT
+/***********************************************************************\
+* Name   : getGcryptMode
+* Purpose: get gcrypt cipher mode
+* Input  : cryptMode - crypt mode; see CRYPT_MODE_...
+* Output : -
+* Return : gcrypt cipher mode
+* Notes  : -
+\***********************************************************************/
+
+LOCAL_INLINE int getGcryptMode(CryptMode cryptMode)
+{
+  return ((cryptMode & CRYPT_MODE_CBC_) == CRYPT_MODE_CBC_) ? GCRY_CIPHER_MODE_CBC : GCRY_CIPHER_MODE_NONE;
+}
+
+/***********************************************************************\
+* Name   : freeCipherHandleNode
+* Purpose: free pooled cipher handle node
+* Input  : cipherHandleNode - cipher handle node
+*          userData         - user data (not used)
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void freeCipherHandleNode(CipherHandleNode *cipherHandleNode, void *userData)
+{
+  assert(cipherHandleNode != NULL);
+
+  UNUSED_VARIABLE(userData);
+
+  gcry_cipher_close(cipherHandleNode->gcry_cipher_hd);
+}
+
+/***********************************************************************\
+* Name   : newCipherHandleList
+* Purpose: allocate cipher handle pool of a thread
+* Input  : userData - user data (not used)
+* Output : -
+* Return : cipher handle list or NULL
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void *newCipherHandleList(void *userData)
+{
+  UNUSED_VARIABLE(userData);
+
+  CipherHandleList *cipherHandleList = (CipherHandleList*)malloc(sizeof(CipherHandleList));
+  if (cipherHandleList == NULL)
+  {
+    return NULL;
+  }
+  List_init(cipherHandleList,CALLBACK_(NULL,NULL),CALLBACK_((ListNodeFreeFunction)freeCipherHandleNode,NULL));
+
+  return cipherHandleList;
+}
+
+/***********************************************************************\
+* Name   : deleteCipherHandleList
+* Purpose: free cipher handle pool of a thread
+* Input  : variable - cipher handle list
+*          userData - user data (not used)
+* Output : -
+* Return : -
+* Notes  : -
+\***********************************************************************/
+
+LOCAL void deleteCipherHandleList(void *variable, void *userData)
+{
+  CipherHandleList *cipherHandleList = (CipherHandleList*)variable;
+
+  assert(cipherHandleList != NULL);
+
+  UNUSED_VARIABLE(userData);
+
+  List_done(cipherHandleList);
+  free(cipherHandleList);
+}
+
+/***********************************************************************\
+* Name   : leaseCipherHandle
+* Purpose: get cipher handle from pool of current thread
+* Input  : cryptAlgorithm - crypt algorithm
+*          gcryptMode     - gcrypt cipher mode
+* Output : gcry_cipher_hd - cipher handle
+* Return : TRUE iff pooled cipher handle available
+* Notes  : cipher handle is reset
+\***********************************************************************/
+
+LOCAL bool leaseCipherHandle(CryptAlgorithms  cryptAlgorithm,
+                             int              gcryptMode,
+                             gcry_cipher_hd_t *gcry_cipher_hd
+                            )
+{
+  assert(gcry_cipher_hd != NULL);
+
+  CipherHandleList *cipherHandleList = (CipherHandleList*)Thread_getLocalVariable(&cipherHandlePool);
+  if (cipherHandleList == NULL)
+  {
+    return FALSE;
+  }
+
+  CipherHandleNode *cipherHandleNode;
+  LIST_ITERATE(cipherHandleList,cipherHandleNode)
+  {
+    if (   (cipherHandleNode->cryptAlgorithm == cryptAlgorithm)
+        && (cipherHandleNode->gcryptMode == gcryptMode)
+       )
+    {
+      (*gcry_cipher_hd) = cipherHandleNode->gcry_cipher_hd;
+      List_remove(cipherHandleList,cipherHandleNode);
+      LIST_DELETE_NODE(cipherHandleNode);
+
+      gcry_cipher_reset(*gcry_cipher_hd);
+
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/***********************************************************************\
+* Name   : releaseCipherHandle
+* Purpose: return cipher handle into pool of current thread
+* Input  : cryptAlgorithm - crypt algorithm
+*          gcryptMode     - gcrypt cipher mode
+*          gcry_cipher_hd - cipher handle
+* Output : -
+* Return : -
+* Notes  : cipher handle is closed if pool is full
+\***********************************************************************/
+
+LOCAL void releaseCipherHandle(CryptAlgorithms  cryptAlgorithm,
+                               int              gcryptMode,
+                               gcry_cipher_hd_t gcry_cipher_hd
+                              )
+{
+  CipherHandleList *cipherHandleList = (CipherHandleList*)Thread_getLocalVariable(&cipherHandlePool);
+  if (   (cipherHandleList != NULL)
+      && (List_count(cipherHandleList) < MAX_CIPHER_HANDLE_POOL_SIZE)
+     )
+  {
+    CipherHandleNode *cipherHandleNode = LIST_NEW_NODE(CipherHandleNode);
+    if (cipherHandleNode != NULL)
+    {
+      cipherHandleNode->cryptAlgorithm = cryptAlgorithm;
+      cipherHandleNode->gcryptMode     = gcryptMode;
+      cipherHandleNode->gcry_cipher_hd = gcry_cipher_hd;
+      List_append(cipherHandleList,cipherHandleNode);
+
+      return;
+    }
+  }
+
+  gcry_cipher_close(gcry_cipher_hd);
+}
+
+/***********************************************************************\
+* Name   : initAuthenticatedBlock
+* Purpose: init authenticated cipher for data block
+* Input  : gcry_cipher_hd - authenticated cipher handle
+*          nonce          - nonce of data stream
+*          blockIndex     - block index in data stream
+*          lastFlag       - TRUE iff last block of data stream
+* Output : -
+* Return : ERROR_NONE or error code
+* Notes  : IV is nonce XOR block index (big endian), additional
+*          authenticated data is block index+last flag; this detects
+*          reordered, duplicated and truncated blocks
+\***********************************************************************/
+
+LOCAL Errors initAuthenticatedBlock(gcry_cipher_hd_t gcry_cipher_hd,
+                                    const byte       nonce[CRYPT_NONCE_LENGTH],
+                                    uint64           blockIndex,
+                                    bool             lastFlag
+                                   )
+{
+  byte         iv[CRYPT_NONCE_LENGTH];
+  byte         authenticatedData[8+1];
+  uint         i;
+  gcry_error_t gcryptError;
+
+  // get IV, additional authenticated data
+  memCopyFast(iv,sizeof(iv),nonce,CRYPT_NONCE_LENGTH);
+  for (i = 0; i < 8; i++)
+  {
+    iv[CRYPT_NONCE_LENGTH-1-i] ^= (byte)((blockIndex >> (i*8)) & 0xFF);
+    authenticatedData[8-1-i]    = (byte)((blockIndex >> (i*8)) & 0xFF);
+  }
+  authenticatedData[8] = lastFlag ? 1 : 0;
+
+  gcry_cipher_reset(gcry_cipher_hd);
+  gcryptError = gcry_cipher_setiv(gcry_cipher_hd,iv,sizeof(iv));
+  if (gcryptError != 0)
+  {
+    char buffer[128];
+
+    gpg_strerror_r(gcryptError,buffer,sizeof(buffer));
+    return ERRORX_(INIT_CIPHER,gcryptError,"set IV: %s",buffer);
+  }
+  gcryptError = gcry_cipher_authenticate(gcry_cipher_hd,authenticatedData,sizeof(authenticatedData));
+  if (gcryptError != 0)
+  {
+    char buffer[128];
+
+    gpg_strerror_r(gcryptError,buffer,sizeof(buffer));
+    return ERRORX_(INIT_CIPHER,gcryptError,"authenticate: %s",buffer);
+  }
+
+  return ERROR_NONE;
+}
+#endif /* HAVE_GCRYPT */
+
 #ifdef HAVE_GCRYPT
 //  GCRY_THREAD_OPTION_PTHREAD_IMPL;
 #endif /* HAVE_GCRYPT */
@@ -466,6 +713,10 @@ Errors Crypt_initAll(void)
     if (error != ERROR_NONE) return error;
     error = getCryptKeyLength(CRYPT_ALGORITHM_CAMELLIA256,&cryptKeyLengths[CRYPT_ALGORITHM_CAMELLIA256]);
     if (error != ERROR_NONE) return error;
+    error = getCryptKeyLength(CRYPT_ALGORITHM_AES128_GCM,&cryptKeyLengths[CRYPT_ALGORITHM_AES128_GCM]);
+    if (error != ERROR_NONE) return error;
+    error = getCryptKeyLength(CRYPT_ALGORITHM_AES256_GCM,&cryptKeyLengths[CRYPT_ALGORITHM_AES256_GCM]);
+    if (error != ERROR_NONE) return error;
 
     // get block lengths
     error = getCryptBlockLength(CRYPT_ALGORITHM_3DES,&cryptBlockLengths[CRYPT_ALGORITHM_3DES]);
@@ -496,6 +747,12 @@ Errors Crypt_initAll(void)
     if (error != ERROR_NONE) return error;
     error = getCryptBlockLength(CRYPT_ALGORITHM_CAMELLIA256,&cryptBlockLengths[CRYPT_ALGORITHM_CAMELLIA256]);
     if (error != ERROR_NONE) return error;
+    error = getCryptBlockLength(CRYPT_ALGORITHM_AES128_GCM,&cryptBlockLengths[CRYPT_ALGORITHM_AES128_GCM]);
+    if (error != ERROR_NONE) return error;
+    error = getCryptBlockLength(CRYPT_ALGORITHM_AES256_GCM,&cryptBlockLengths[CRYPT_ALGORITHM_AES256_GCM]);
+    if (error != ERROR_NONE) return error;
+
+    Thread_initLocalVariable(&cipherHandlePool,newCipherHandleList,NULL,deleteCipherHandleList,NULL);
   #endif /* HAVE_GCRYPT */
 
   return ERROR_NONE;
@@ -503,6 +760,16 @@ Errors Crypt_initAll(void)
 
 void Crypt_doneAll(void)
 {
+  #ifdef HAVE_GCRYPT
+    Thread_doneLocalVariable(&cipherHandlePool);
+  #endif /* HAVE_GCRYPT */
+}
+
+void Crypt_doneThreadContexts(void)
+{
+  #ifdef HAVE_GCRYPT
+    Thread_removeLocalVariable(&cipherHandlePool);
+  #endif /* HAVE_GCRYPT */
 }
 
 /*---------------------------------------------------------------------*/
@@ -862,6 +1129,8 @@ Errors __Crypt_init(const char      *__fileName__,
     case CRYPT_ALGORITHM_CAMELLIA128:
     case CRYPT_ALGORITHM_CAMELLIA192:
     case CRYPT_ALGORITHM_CAMELLIA256:
+    case CRYPT_ALGORITHM_AES128_GCM:
+    case CRYPT_ALGORITHM_AES256_GCM:
       #ifdef HAVE_GCRYPT
         {
           int          gcryptAlgorithm;
@@ -891,13 +1160,15 @@ Errors __Crypt_init(const char      *__fileName__,
             case CRYPT_ALGORITHM_CAMELLIA128: gcryptAlgorithm = GCRY_CIPHER_CAMELLIA128; break;
             case CRYPT_ALGORITHM_CAMELLIA192: gcryptAlgorithm = GCRY_CIPHER_CAMELLIA192; break;
             case CRYPT_ALGORITHM_CAMELLIA256: gcryptAlgorithm = GCRY_CIPHER_CAMELLIA256; break;
+            case CRYPT_ALGORITHM_AES128_GCM:  gcryptAlgorithm = GCRY_CIPHER_AES;         break;
+            case CRYPT_ALGORITHM_AES256_GCM:  gcryptAlgorithm = GCRY_CIPHER_AES256;      break;
             default:
               #ifndef NDEBUG
                 HALT_INTERNAL_ERROR_UNHANDLED_SWITCH_CASE();
               #endif /* NDEBUG */
               break; /* not reached */
           }
-          gcryptMode  = ((cryptMode & CRYPT_MODE_CBC_) == CRYPT_MODE_CBC_) ? GCRY_CIPHER_MODE_CBC : GCRY_CIPHER_MODE_NONE;
+          gcryptMode  = getGcryptMode(cryptMode);
           gcryptFlags = 0;
 
           // check if algorithm available
@@ -968,23 +1239,26 @@ Errors __Crypt_init(const char      *__fileName__,
             return ERROR_INVALID_KEY_LENGTH;
           }
 
-          // init cipher
-          gcryptError = gcry_cipher_open(&cryptInfo->gcry_cipher_hd,
-                                         gcryptAlgorithm,
-                                         gcryptMode,
-                                         gcryptFlags
-                                        );
-          if (gcryptError != 0)
+          // get pooled cipher or init new cipher
+          if (!leaseCipherHandle(cryptAlgorithm,gcryptMode,&cryptInfo->gcry_cipher_hd))
           {
-            char buffer[128];
+            gcryptError = gcry_cipher_open(&cryptInfo->gcry_cipher_hd,
+                                           gcryptAlgorithm,
+                                           gcryptMode,
+                                           gcryptFlags
+                                          );
+            if (gcryptError != 0)
+            {
+              char buffer[128];
 
-            gpg_strerror_r(gcryptError,buffer,sizeof(buffer));
-            return ERRORX_(INIT_CIPHER,
-                           gcryptError,
-                           "'%s': %s",
-                           gcry_cipher_algo_name(gcryptAlgorithm),
-                           buffer
-                          );
+              gpg_strerror_r(gcryptError,buffer,sizeof(buffer));
+              return ERRORX_(INIT_CIPHER,
+                             gcryptError,
+                             "'%s': %s",
+                             gcry_cipher_algo_name(gcryptAlgorithm),
+                             buffer
+                            );
+            }
           }
 
           // set key (Note: use correct key length which may be smaller than provided crypt key length)
@@ -1031,6 +1305,52 @@ Errors __Crypt_init(const char      *__fileName__,
               return ERRORX_(INIT_CIPHER,gcryptError,"set IV: %s",buffer);
             }
           }
+
+          // get pooled cipher or init new cipher for authenticated data blocks
+          if (Crypt_isAuthenticated(cryptAlgorithm))
+          {
+            if (!leaseCipherHandle(cryptAlgorithm,GCRY_CIPHER_MODE_GCM,&cryptInfo->gcry_authenticated_cipher_hd))
+            {
+              gcryptError = gcry_cipher_open(&cryptInfo->gcry_authenticated_cipher_hd,
+                                             gcryptAlgorithm,
+                                             GCRY_CIPHER_MODE_GCM,
+                                             0
+                                            );
+              if (gcryptError != 0)
+              {
+                char buffer[128];
+
+                gpg_strerror_r(gcryptError,buffer,sizeof(buffer));
+                gcry_cipher_close(cryptInfo->gcry_cipher_hd);
+                return ERRORX_(INIT_CIPHER,
+                               gcryptError,
+                               "'%s': %s",
+                               gcry_cipher_algo_name(gcryptAlgorithm),
+                               buffer
+                              );
+              }
+            }
+
+            gcryptError = gcry_cipher_setkey(cryptInfo->gcry_authenticated_cipher_hd,
+                                             cryptKey->data,
+                                             keyLength/8
+                                            );
+            if (gcryptError != 0)
+            {
+              char buffer[128];
+
+              gpg_strerror_r(gcryptError,buffer,sizeof(buffer));
+              gcry_cipher_close(cryptInfo->gcry_authenticated_cipher_hd);
+              gcry_cipher_close(cryptInfo->gcry_cipher_hd);
+              return ERRORX_(INIT_CIPHER,
+                             gcryptError,
+                             "set key for '%s' with %dbit: %s",
+                             gcry_cipher_algo_name(gcryptAlgorithm),
+                             cryptKey->dataLength*8,
+                             buffer
+                            );
+            }
+          }
         }
       #else /* not HAVE_GCRYPT */
         UNUSED_VARIABLE(cryptInfo);
@@ -1093,8 +1413,14 @@ void __Crypt_done(const char *__fileName__,
     case CRYPT_ALGORITHM_CAMELLIA128:
     case CRYPT_ALGORITHM_CAMELLIA192:
     case CRYPT_ALGORITHM_CAMELLIA256:
+    case CRYPT_ALGORITHM_AES128_GCM:
+    case CRYPT_ALGORITHM_AES256_GCM:
       #ifdef HAVE_GCRYPT
-        gcry_cipher_close(cryptInfo->gcry_cipher_hd);
+        if (Crypt_isAuthenticated(cryptInfo->cryptAlgorithm))
+        {
+          releaseCipherHandle(cryptInfo->cryptAlgorithm,GCRY_CIPHER_MODE_GCM,cryptInfo->gcry_authenticated_cipher_hd);
+        }
+        releaseCipherHandle(cryptInfo->cryptAlgorithm,getGcryptMode(cryptInfo->cryptMode),cryptInfo->gcry_cipher_hd);
       #endif /* HAVE_GCRYPT */
       break;
     default:
@@ -1180,6 +1506,8 @@ Errors Crypt_reset(CryptInfo *cryptInfo)
     case CRYPT_ALGORITHM_CAMELLIA128:
     case CRYPT_ALGORITHM_CAMELLIA192:
     case CRYPT_ALGORITHM_CAMELLIA256:
+    case CRYPT_ALGORITHM_AES128_GCM:
+    case CRYPT_ALGORITHM_AES256_GCM:
       #ifdef HAVE_GCRYPT
         {
           gcry_error_t gcryptError;
@@ -1252,6 +1580,8 @@ Errors Crypt_encrypt(CryptInfo *cryptInfo,
     case CRYPT_ALGORITHM_CAMELLIA128:
     case CRYPT_ALGORITHM_CAMELLIA192:
     case CRYPT_ALGORITHM_CAMELLIA256:
+    case CRYPT_ALGORITHM_AES128_GCM:
+    case CRYPT_ALGORITHM_AES256_GCM:
       #ifdef HAVE_GCRYPT
         assert(cryptInfo->blockLength > 0);
         assert((bufferLength%cryptInfo->blockLength) == 0);
@@ -1327,6 +1657,8 @@ Errors Crypt_decrypt(CryptInfo *cryptInfo,
     case CRYPT_ALGORITHM_CAMELLIA128:
     case CRYPT_ALGORITHM_CAMELLIA192:
     case CRYPT_ALGORITHM_CAMELLIA256:
+    case CRYPT_ALGORITHM_AES128_GCM:
+    case CRYPT_ALGORITHM_AES256_GCM:
       #ifdef HAVE_GCRYPT
         assert(cryptInfo->blockLength > 0);
         assert((bufferLength%cryptInfo->blockLength) == 0);
@@ -1389,6 +1721,10 @@ Errors Crypt_encryptBytes(CryptInfo *cryptInfo,
   {
     case CRYPT_ALGORITHM_NONE:
       break;
+    case CRYPT_ALGORITHM_AES128_GCM:
+    case CRYPT_ALGORITHM_AES256_GCM:
+      // Note: data is encrypted block-wise with Crypt_encryptAuthenticated()
+      break;
     case CRYPT_ALGORITHM_3DES:
     case CRYPT_ALGORITHM_CAST5:
     case CRYPT_ALGORITHM_BLOWFISH:
@@ -1464,6 +1800,10 @@ Errors Crypt_decryptBytes(CryptInfo *cryptInfo,
   {
     case CRYPT_ALGORITHM_NONE:
       break;
+    case CRYPT_ALGORITHM_AES128_GCM:
+    case CRYPT_ALGORITHM_AES256_GCM:
+      // Note: data is encrypted block-wise with Crypt_decryptAuthenticated()
+      break;
     case CRYPT_ALGORITHM_3DES:
     case CRYPT_ALGORITHM_CAST5:
     case CRYPT_ALGORITHM_BLOWFISH:
@@ -1523,6 +1863,135 @@ Errors Crypt_decryptBytes(CryptInfo *cryptInfo,
   return ERROR_NONE;
 }
 
+Errors Crypt_encryptAuthenticated(CryptInfo  *cryptInfo,
+                                  const byte nonce[CRYPT_NONCE_LENGTH],
+                                  uint64     blockIndex,
+                                  bool       lastFlag,
+                                  void       *buffer,
+                                  ulong      bufferLength,
+                                  byte       tag[CRYPT_TAG_LENGTH]
+                                 )
+{
+  #ifdef HAVE_GCRYPT
+    Errors       error;
+    gcry_error_t gcryptError;
+  #endif
+
+  assert(cryptInfo != NULL);
+  assert(Crypt_isAuthenticated(cryptInfo->cryptAlgorithm));
+  assert(nonce != NULL);
+  assert((buffer != NULL) || (bufferLength == 0L));
+  assert(tag != NULL);
+
+  #ifdef HAVE_GCRYPT
+    error = initAuthenticatedBlock(cryptInfo->gcry_authenticated_cipher_hd,nonce,blockIndex,lastFlag);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+
+    if (bufferLength > 0L)
+    {
+      gcryptError = gcry_cipher_encrypt(cryptInfo->gcry_authenticated_cipher_hd,
+                                        buffer,
+                                        bufferLength,
+                                        NULL,
+                                        0
+                                       );
+      if (gcryptError != 0)
+      {
+        char errorText[128];
+
+        gpg_strerror_r(gcryptError,errorText,sizeof(errorText));
+        return ERRORX_(ENCRYPT,gcryptError,"%s",errorText);
+      }
+    }
+
+    gcryptError = gcry_cipher_gettag(cryptInfo->gcry_authenticated_cipher_hd,tag,CRYPT_TAG_LENGTH);
+    if (gcryptError != 0)
+    {
+      char errorText[128];
+
+      gpg_strerror_r(gcryptError,errorText,sizeof(errorText));
+      return ERRORX_(ENCRYPT,gcryptError,"get tag: %s",errorText);
+    }
+
+    return ERROR_NONE;
+  #else /* not HAVE_GCRYPT */
+    UNUSED_VARIABLE(nonce);
+    UNUSED_VARIABLE(blockIndex);
+    UNUSED_VARIABLE(lastFlag);
+    UNUSED_VARIABLE(buffer);
+    UNUSED_VARIABLE(bufferLength);
+    UNUSED_VARIABLE(tag);
+
+    return ERROR_FUNCTION_NOT_SUPPORTED;
+  #endif /* HAVE_GCRYPT */
+}
+
+Errors Crypt_decryptAuthenticated(CryptInfo  *cryptInfo,
+                                  const byte nonce[CRYPT_NONCE_LENGTH],
+                                  uint64     blockIndex,
+                                  bool       lastFlag,
+                                  void       *buffer,
+                                  ulong      bufferLength,
+                                  const byte tag[CRYPT_TAG_LENGTH]
+                                 )
+{
+  #ifdef HAVE_GCRYPT
+    Errors       error;
+    gcry_error_t gcryptError;
+  #endif
+
+  assert(cryptInfo != NULL);
+  assert(Crypt_isAuthenticated(cryptInfo->cryptAlgorithm));
+  assert(nonce != NULL);
+  assert((buffer != NULL) || (bufferLength == 0L));
+  assert(tag != NULL);
+
+  #ifdef HAVE_GCRYPT
+    error = initAuthenticatedBlock(cryptInfo->gcry_authenticated_cipher_hd,nonce,blockIndex,lastFlag);
+    if (error != ERROR_NONE)
+    {
+      return error;
+    }
+
+    if (bufferLength > 0L)
+    {
+      gcryptError = gcry_cipher_decrypt(cryptInfo->gcry_authenticated_cipher_hd,
+                                        buffer,
+                                        bufferLength,
+                                        NULL,
+                                        0
+                                       );
+      if (gcryptError != 0)
+      {
+        char errorText[128];
+
+        gpg_strerror_r(gcryptError,errorText,sizeof(errorText));
+        return ERRORX_(DECRYPT,gcryptError,"%s",errorText);
+      }
+    }
+
+    gcryptError = gcry_cipher_checktag(cryptInfo->gcry_authenticated_cipher_hd,tag,CRYPT_TAG_LENGTH);
+    if (gcryptError != 0)
+    {
+      return ERRORX_(DECRYPT,gcryptError,"authentication of data block %"PRIu64" failed",blockIndex);
+    }
+
+    return ERROR_NONE;
+  #else /* not HAVE_GCRYPT */
+    UNUSED_VARIABLE(nonce);
+    UNUSED_VARIABLE(blockIndex);
+    UNUSED_VARIABLE(lastFlag);
+    UNUSED_VARIABLE(buffer);
+    UNUSED_VARIABLE(bufferLength);
+    UNUSED_VARIABLE(tag);
+
+    return ERROR_FUNCTION_NOT_SUPPORTED;
+  #endif /* HAVE_GCRYPT */
+}
+
 /*---------------------------------------------------------------------*/
 
 #ifdef NDEBUG
@@ -53,12 +53,19 @@ typedef enum
   CRYPT_ALGORITHM_CAMELLIA128 = CHUNK_CONST_CRYPT_ALGORITHM_CAMELLIA128,
   CRYPT_ALGORITHM_CAMELLIA192 = CHUNK_CONST_CRYPT_ALGORITHM_CAMELLIA192,
   CRYPT_ALGORITHM_CAMELLIA256 = CHUNK_CONST_CRYPT_ALGORITHM_CAMELLIA256,
+  CRYPT_ALGORITHM_AES128_GCM  = CHUNK_CONST_CRYPT_ALGORITHM_AES128_GCM,
+  CRYPT_ALGORITHM_AES256_GCM  = CHUNK_CONST_CRYPT_ALGORITHM_AES256_GCM,
 
   CRYPT_ALGORITHM_UNKNOWN     = 0xFFFF
 } CryptAlgorithms;
 
 #define CRYPT_ALGORITHM_MIN CRYPT_ALGORITHM_NONE
-#define CRYPT_ALGORITHM_MAX CRYPT_ALGORITHM_CAMELLIA256
+#define CRYPT_ALGORITHM_MAX CRYPT_ALGORITHM_AES256_GCM
+
+// authenticated encryption: nonce length, authentication tag length, max. data length of an authenticated block
+#define CRYPT_NONCE_LENGTH          12
+#define CRYPT_TAG_LENGTH            16
+#define CRYPT_AUTHENTICATED_BLOCK_LENGTH (64*KB)
 
 #define MIN_ASYMMETRIC_CRYPT_KEY_BITS 1024
 #define MAX_ASYMMETRIC_CRYPT_KEY_BITS 3072
@@ -165,6 +172,7 @@ typedef struct
   uint             blockLength;
   #ifdef HAVE_GCRYPT
     gcry_cipher_hd_t gcry_cipher_hd;
+    gcry_cipher_hd_t gcry_authenticated_cipher_hd;  // cipher handle for authenticated blocks (AEAD algorithms only)
   #endif /* HAVE_GCRYPT */
 } CryptInfo;
 
@@ -337,6 +345,18 @@ Errors Crypt_initAll(void);
 
 void Crypt_doneAll(void);
 
+/***********************************************************************\
+* Name   : Crypt_doneThreadContexts
+* Purpose: free cipher handles pooled by current thread
+* Input  : -
+* Output : -
+* Return : -
+* Notes  : contexts of a terminated thread are freed automatically;
+*          call in pool threads at the end of a job
+\***********************************************************************/
+
+void Crypt_doneThreadContexts(void);
+
 /***********************************************************************\
 * Name   : Crypt_isSymmetricSupported
 * Purpose: check if symmetric encryption is supported
@@ -507,6 +527,26 @@ INLINE bool Crypt_isEncrypted(CryptAlgorithms cryptAlgorithm)
 }
 #endif /* NDEBUG || __CRYPT_IMPLEMENTATION__ */
 
+/***********************************************************************\
+* Name   : Crypt_isAuthenticated
+* Purpose: check if crypt algorithm is an authenticated encryption
+*          algorithm (AEAD)
+* Input  : cryptAlgorithm - crypt algorithm
+* Output : -
+* Return : TRUE iff authenticated encryption algorithm
+* Notes  : data of authenticated algorithms is encrypted with
+*          Crypt_encryptAuthenticated()/Crypt_decryptAuthenticated()
+\***********************************************************************/
+
+INLINE bool Crypt_isAuthenticated(CryptAlgorithms cryptAlgorithm);
+#if defined(NDEBUG) || defined(__CRYPT_IMPLEMENTATION__)
+INLINE bool Crypt_isAuthenticated(CryptAlgorithms cryptAlgorithm)
+{
+  return    (cryptAlgorithm == CRYPT_ALGORITHM_AES128_GCM)
+         || (cryptAlgorithm == CRYPT_ALGORITHM_AES256_GCM);
+}
+#endif /* NDEBUG || __CRYPT_IMPLEMENTATION__ */
+
 /***********************************************************************\
 * Name   : Crypt_randomize
 * Purpose: fill buffer with randomized data
@@ -874,6 +914,55 @@ Errors Crypt_decryptBytes(CryptInfo *cryptInfo,
                           ulong      bufferLength
                          );
 
+/***********************************************************************\
+* Name   : Crypt_encryptAuthenticated
+* Purpose: encrypt authenticated block
+* Input  : cryptInfo    - crypt info block
+*          nonce        - nonce of data stream
+*          blockIndex   - block index in data stream
+*          lastFlag     - TRUE iff last block of data stream
+*          buffer       - data
+*          bufferLength - length of data (max. CRYPT_AUTHENTICATED_BLOCK_LENGTH)
+* Output : buffer - encrypted data
+*          tag    - authentication tag
+* Return : ERROR_NONE or error code
+* Notes  : block nonce is nonce XOR block index, thus blocks can be
+*          encrypted independent of each other
+\***********************************************************************/
+
+Errors Crypt_encryptAuthenticated(CryptInfo  *cryptInfo,
+                                  const byte nonce[CRYPT_NONCE_LENGTH],
+                                  uint64     blockIndex,
+                                  bool       lastFlag,
+                                  void       *buffer,
+                                  ulong      bufferLength,
+                                  byte       tag[CRYPT_TAG_LENGTH]
+                                 );
+
+/***********************************************************************\
+* Name   : Crypt_decryptAuthenticated
+* Purpose: decrypt and verify authenticated block
+* Input  : cryptInfo    - crypt info block
+*          nonce        - nonce of data stream
+*          blockIndex   - block index in data stream
+*          lastFlag     - TRUE iff last block of data stream
+*          buffer       - encrypted data
+*          bufferLength - length of data (max. CRYPT_AUTHENTICATED_BLOCK_LENGTH)
+*          tag          - authentication tag
+* Output : buffer - data
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+Errors Crypt_decryptAuthenticated(CryptInfo  *cryptInfo,
+                                  const byte nonce[CRYPT_NONCE_LENGTH],
+                                  uint64     blockIndex,
+                                  bool       lastFlag,
+                                  void       *buffer,
+                                  ulong      bufferLength,
+                                  const byte tag[CRYPT_TAG_LENGTH]
+                                 );
+
 /*---------------------------------------------------------------------*/
 
 /***********************************************************************\
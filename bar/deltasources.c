@@ -220,9 +220,12 @@ NULL, // masterIO
   }
 
   // read archive entries
-  bool   restoredFlag = FALSE;
-  Errors failError    = ERROR_NONE;
+  bool   restoredFlag  = FALSE;
+  Errors failError     = ERROR_NONE;
+  String referenceName = String_new();
+  bool   duplicateFlag = FALSE;
   while (   !restoredFlag
+         && !duplicateFlag
          && ((requestedAbortFlag == NULL) || !(*requestedAbortFlag))
          && !Archive_eof(&archiveHandle)
          && (failError == ERROR_NONE)
@@ -270,6 +273,8 @@ NULL, // masterIO
                                         fileName,
                                         NULL,  // fileInfo
                                         NULL,  // fileExtendedAttributeList
+                                        NULL,  // fileHoleList
+                                        referenceName,
                                         NULL,  // deltaSourceHandleName
                                         NULL,  // deltaSourceHandleSize
                                         &fragmentOffset,
@@ -282,7 +287,12 @@ NULL, // masterIO
             continue;
           }
 
-          if (String_equals(name,fileName))
+          if (String_equals(name,fileName) && !String_isEmpty(referenceName))
+          {
+            // duplicate file: restore referenced file instead
+            duplicateFlag = TRUE;
+          }
+          else if (String_equals(name,fileName))
           {
 //            abortFlag = !updateStatusInfo(&restoreInfo);
 
@@ -541,6 +551,7 @@ NULL, // masterIO
                                             &fileNameList,
                                             NULL,  // fileInfo
                                             NULL,  // fileExtendedAttributeList
+                                            NULL,  // fileHoleList
                                             NULL,  // deltaSourceHandleName
                                             NULL,  // deltaSourceHandleSize
                                             &fragmentOffset,
@@ -682,6 +693,7 @@ NULL, // masterIO
           error = Archive_skipNextEntry(&archiveHandle);
         #endif /* NDEBUG */
         break;
+      case ARCHIVE_ENTRY_TYPE_SOLID:
       case ARCHIVE_ENTRY_TYPE_SIGNATURE:
         error = Archive_skipNextEntry(&archiveHandle);
         if (error != ERROR_NONE)
@@ -707,6 +719,25 @@ NULL, // masterIO
   free(buffer);
   String_delete(printableStorageName);
 
+  // restore referenced file of a duplicate file
+  if (duplicateFlag && (failError == ERROR_NONE))
+  {
+    failError = restoreFile(storageSpecifier,
+                            referenceName,
+                            deltaSourceList,
+                            jobOptions,
+                            destinationFileName,
+                            fragmentNode,
+                            getNamePasswordFunction,
+                            getNamePasswordUserData,
+                            pauseFlag,
+                            requestedAbortFlag,
+                            logHandle
+                           );
+    restoredFlag = (failError == ERROR_NONE);
+  }
+  String_delete(referenceName);
+
   if      (failError != ERROR_NONE)
   {
     return failError;
@@ -1169,6 +1200,13 @@ void DeltaSource_setBaseOffset(DeltaSourceHandle *deltaSourceHandle, uint64 offs
   deltaSourceHandle->baseOffset = offset;
 }
 
+uint64 DeltaSource_getBaseOffset(const DeltaSourceHandle *deltaSourceHandle)
+{
+  assert(deltaSourceHandle != NULL);
+
+  return deltaSourceHandle->baseOffset;
+}
+
 Errors DeltaSource_getEntryDataBlock(DeltaSourceHandle *deltaSourceHandle,
                                      void              *buffer,
                                      uint64            offset,
@@ -173,6 +173,17 @@ uint64 DeltaSource_getSize(const DeltaSourceHandle *sourceHandle);
 
 void DeltaSource_setBaseOffset(DeltaSourceHandle *sourceHandle, uint64 offset);
 
+/***********************************************************************\
+* Name   : DeltaSource_getBaseOffset
+* Purpose: get base offset for read blocks
+* Input  : sourceHandle - source handle
+* Output : -
+* Return : base offset
+* Notes  : -
+\***********************************************************************/
+
+uint64 DeltaSource_getBaseOffset(const DeltaSourceHandle *sourceHandle);
+
 /***********************************************************************\
 * Name   : DeltaSource_getEntryDataBlock
 * Purpose: get source entry data block
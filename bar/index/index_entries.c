@@ -604,7 +604,8 @@ Errors IndexEntry_addFile(IndexHandle *indexHandle,
                           uint32      groupId,
                           uint32      permission,
                           uint64      fragmentOffset,
-                          uint64      fragmentSize
+                          uint64      fragmentSize,
+                          uint64      archiveOffset
                          )
 {
   Errors error;
@@ -667,7 +668,8 @@ Errors IndexEntry_addFile(IndexHandle *indexHandle,
                                     DATABASE_VALUE_UINT    ("permission",      permission),
 
                                     DATABASE_VALUE_KEY     ("uuidId",          INDEX_DATABASE_ID(uuidId)),
-                                    DATABASE_VALUE_UINT64  ("size",            size)
+                                    DATABASE_VALUE_UINT64  ("size",            size),
+                                    DATABASE_VALUE_UINT64  ("archiveOffset",   archiveOffset)
                                   ),
                                   DATABASE_COLUMNS_NONE,
                                   DATABASE_FILTERS_NONE
@@ -814,7 +816,7 @@ Errors IndexEntry_addFile(IndexHandle *indexHandle,
                                     SERVER_IO_DEBUG_LEVEL,
                                     SERVER_IO_TIMEOUT,
                                     CALLBACK_(NULL,NULL),  // commandResultFunction
-                                    "INDEX_ADD_FILE uuidId=%"PRIi64" entityId=%"PRIi64" storageId=%"PRIu64" name=%'S size=%"PRIu64" timeLastAccess=%"PRIu64" timeModified=%"PRIu64" timeLastChanged=%"PRIu64" userId=%u groupId=%u permission=%o fragmentOffset=%"PRIu64" fragmentSize=%"PRIu64,
+                                    "INDEX_ADD_FILE uuidId=%"PRIi64" entityId=%"PRIi64" storageId=%"PRIu64" name=%'S size=%"PRIu64" timeLastAccess=%"PRIu64" timeModified=%"PRIu64" timeLastChanged=%"PRIu64" userId=%u groupId=%u permission=%o fragmentOffset=%"PRIu64" fragmentSize=%"PRIu64" archiveOffset=%"PRIu64,
                                     uuidId,
                                     entityId,
                                     storageId,
@@ -827,7 +829,8 @@ Errors IndexEntry_addFile(IndexHandle *indexHandle,
                                     groupId,
                                     permission,
                                     fragmentOffset,
-                                    fragmentSize
+                                    fragmentSize,
+                                    archiveOffset
                                    );
   }
 
@@ -843,7 +846,8 @@ Errors IndexEntry_addImage(IndexHandle     *indexHandle,
                            int64           size,
                            uint            blockSize,
                            uint64          blockOffset,
-                           uint64          blockCount
+                           uint64          blockCount,
+                           uint64          archiveOffset
                           )
 {
   Errors error;
@@ -906,7 +910,8 @@ Errors IndexEntry_addImage(IndexHandle     *indexHandle,
                                     DATABASE_VALUE_UINT    ("permission",      0),
 
                                     DATABASE_VALUE_KEY     ("uuidId",          INDEX_DATABASE_ID(uuidId)),
-                                    DATABASE_VALUE_UINT64  ("size",            size)
+                                    DATABASE_VALUE_UINT64  ("size",            size),
+                                    DATABASE_VALUE_UINT64  ("archiveOffset",   archiveOffset)
                                   ),
                                   DATABASE_COLUMNS_NONE,
                                   DATABASE_FILTERS_NONE
@@ -1049,7 +1054,7 @@ Errors IndexEntry_addImage(IndexHandle     *indexHandle,
                                     SERVER_IO_DEBUG_LEVEL,
                                     SERVER_IO_TIMEOUT,
                                     CALLBACK_(NULL,NULL),  // commandResultFunction
-                                    "INDEX_ADD_IMAGE uuidId=%"PRIi64" entityId=%"PRIi64" storageId=%"PRIu64" type=IMAGE name=%'S fileSystemType=%'s size=%"PRIu64" blockSize=%lu blockOffset=%"PRIu64" blockCount=%"PRIu64,
+                                    "INDEX_ADD_IMAGE uuidId=%"PRIi64" entityId=%"PRIi64" storageId=%"PRIu64" type=IMAGE name=%'S fileSystemType=%'s size=%"PRIu64" blockSize=%lu blockOffset=%"PRIu64" blockCount=%"PRIu64" archiveOffset=%"PRIu64,
                                     uuidId,
                                     entityId,
                                     storageId,
@@ -1058,7 +1063,8 @@ Errors IndexEntry_addImage(IndexHandle     *indexHandle,
                                     size,
                                     blockSize,
                                     blockOffset,
-                                    blockCount
+                                    blockCount,
+                                    archiveOffset
                                    );
   }
 
@@ -1075,7 +1081,8 @@ Errors IndexEntry_addDirectory(IndexHandle *indexHandle,
                                uint64      timeLastChanged,
                                uint32      userId,
                                uint32      groupId,
-                               uint32      permission
+                               uint32      permission,
+                               uint64      archiveOffset
                               )
 {
   Errors error;
@@ -1117,7 +1124,8 @@ Errors IndexEntry_addDirectory(IndexHandle *indexHandle,
                                 DATABASE_VALUE_UINT    ("permission",      permission),
 
                                 DATABASE_VALUE_KEY     ("uuidId",          INDEX_DATABASE_ID(uuidId)),
-                                DATABASE_VALUE_UINT64  ("size",            0)
+                                DATABASE_VALUE_UINT64  ("size",            0),
+                                DATABASE_VALUE_UINT64  ("archiveOffset",   archiveOffset)
                               ),
                               DATABASE_COLUMNS_NONE,
                               DATABASE_FILTERS_NONE
@@ -1235,7 +1243,7 @@ Errors IndexEntry_addDirectory(IndexHandle *indexHandle,
                                     SERVER_IO_DEBUG_LEVEL,
                                     SERVER_IO_TIMEOUT,
                                     CALLBACK_(NULL,NULL),  // commandResultFunction
-                                    "INDEX_ADD_DIRECTORY uuidId=%"PRIi64" entityId=%"PRIi64" storageId=%"PRIu64" type=DIRECTORY name=%'S timeLastAccess=%"PRIu64" timeModified=%"PRIu64" timeLastChanged=%"PRIu64" userId=%u groupId=%u permission=%o",
+                                    "INDEX_ADD_DIRECTORY uuidId=%"PRIi64" entityId=%"PRIi64" storageId=%"PRIu64" type=DIRECTORY name=%'S timeLastAccess=%"PRIu64" timeModified=%"PRIu64" timeLastChanged=%"PRIu64" userId=%u groupId=%u permission=%o archiveOffset=%"PRIu64,
                                     uuidId,
                                     entityId,
                                     storageId,
@@ -1245,7 +1253,8 @@ Errors IndexEntry_addDirectory(IndexHandle *indexHandle,
                                     timeLastChanged,
                                     userId,
                                     groupId,
-                                    permission
+                                    permission,
+                                    archiveOffset
                                    );
   }
 
@@ -1263,7 +1272,8 @@ Errors IndexEntry_addLink(IndexHandle *indexHandle,
                           uint64      timeLastChanged,
                           uint32      userId,
                           uint32      groupId,
-                          uint32      permission
+                          uint32      permission,
+                          uint64      archiveOffset
                          )
 {
   Errors error;
@@ -1308,7 +1318,8 @@ Errors IndexEntry_addLink(IndexHandle *indexHandle,
                                 DATABASE_VALUE_UINT    ("permission",      permission),
 
                                 DATABASE_VALUE_KEY     ("uuidId",          INDEX_DATABASE_ID(uuidId)),
-                                DATABASE_VALUE_UINT64  ("size",            0)
+                                DATABASE_VALUE_UINT64  ("size",            0),
+                                DATABASE_VALUE_UINT64  ("archiveOffset",   archiveOffset)
                               ),
                               DATABASE_COLUMNS_NONE,
                               DATABASE_FILTERS_NONE
@@ -1422,7 +1433,7 @@ Errors IndexEntry_addLink(IndexHandle *indexHandle,
                                     SERVER_IO_DEBUG_LEVEL,
                                     SERVER_IO_TIMEOUT,
                                     CALLBACK_(NULL,NULL),  // commandResultFunction
-                                    "INDEX_ADD_LINK uuidId=%"PRIi64" entityId=%"PRIi64" storageId=%"PRIi64" type=LINK name=%'S destinationName=%'S timeLastAccess=%"PRIu64" timeModified=%"PRIu64" timeLastChanged=%"PRIu64" userId=%u groupId=%u permission=%o",
+                                    "INDEX_ADD_LINK uuidId=%"PRIi64" entityId=%"PRIi64" storageId=%"PRIi64" type=LINK name=%'S destinationName=%'S timeLastAccess=%"PRIu64" timeModified=%"PRIu64" timeLastChanged=%"PRIu64" userId=%u groupId=%u permission=%o archiveOffset=%"PRIu64,
                                     uuidId,
                                     entityId,
                                     storageId,
@@ -1433,7 +1444,8 @@ Errors IndexEntry_addLink(IndexHandle *indexHandle,
                                     timeLastChanged,
                                     userId,
                                     groupId,
-                                    permission
+                                    permission,
+                                    archiveOffset
                                    );
   }
 
@@ -1453,7 +1465,8 @@ Errors IndexEntry_addHardlink(IndexHandle *indexHandle,
                               uint32      groupId,
                               uint32      permission,
                               uint64      fragmentOffset,
-                              uint64      fragmentSize
+                              uint64      fragmentSize,
+                              uint64      archiveOffset
                              )
 {
   Errors error;
@@ -1516,7 +1529,8 @@ Errors IndexEntry_addHardlink(IndexHandle *indexHandle,
                                     DATABASE_VALUE_UINT    ("permission",      permission),
 
                                     DATABASE_VALUE_KEY     ("uuidId",          INDEX_DATABASE_ID(uuidId)),
-                                    DATABASE_VALUE_UINT64  ("size",            size)
+                                    DATABASE_VALUE_UINT64  ("size",            size),
+                                    DATABASE_VALUE_UINT64  ("archiveOffset",   archiveOffset)
                                   ),
                                   DATABASE_COLUMNS_NONE,
                                   DATABASE_FILTERS_NONE
@@ -1660,7 +1674,7 @@ Errors IndexEntry_addHardlink(IndexHandle *indexHandle,
                                     SERVER_IO_DEBUG_LEVEL,
                                     SERVER_IO_TIMEOUT,
                                     CALLBACK_(NULL,NULL),  // commandResultFunction
-                                    "INDEX_ADD_HARDLINK uuidId=%"PRIi64" entityId=%"PRIi64" storageId=%"PRIi64" type=HARDLINK name=%'S size=%"PRIu64" timeLastAccess=%"PRIu64" timeModified=%"PRIu64" timeLastChanged=%"PRIu64" userId=%u groupId=%u permission=%o fragmentOffset=%"PRIu64" fragmentSize=%"PRIu64,
+                                    "INDEX_ADD_HARDLINK uuidId=%"PRIi64" entityId=%"PRIi64" storageId=%"PRIi64" type=HARDLINK name=%'S size=%"PRIu64" timeLastAccess=%"PRIu64" timeModified=%"PRIu64" timeLastChanged=%"PRIu64" userId=%u groupId=%u permission=%o fragmentOffset=%"PRIu64" fragmentSize=%"PRIu64" archiveOffset=%"PRIu64,
                                     uuidId,
                                     entityId,
                                     storageId,
@@ -1673,7 +1687,8 @@ Errors IndexEntry_addHardlink(IndexHandle *indexHandle,
                                     groupId,
                                     permission,
                                     fragmentOffset,
-                                    fragmentSize
+                                    fragmentSize,
+                                    archiveOffset
                                    );
   }
 
@@ -1693,7 +1708,8 @@ Errors IndexEntry_addSpecial(IndexHandle      *indexHandle,
                              uint32           groupId,
                              uint32           permission,
                              uint32           major,
-                             uint32           minor
+                             uint32           minor,
+                             uint64           archiveOffset
                             )
 {
   Errors error;
@@ -1735,7 +1751,8 @@ Errors IndexEntry_addSpecial(IndexHandle      *indexHandle,
                                 DATABASE_VALUE_UINT    ("permission",      permission),
 
                                 DATABASE_VALUE_KEY     ("uuidId",          INDEX_DATABASE_ID(uuidId)),
-                                DATABASE_VALUE_UINT64  ("size",            0)
+                                DATABASE_VALUE_UINT64  ("size",            0),
+                                DATABASE_VALUE_UINT64  ("archiveOffset",   archiveOffset)
                               ),
                               DATABASE_COLUMNS_NONE,
                               DATABASE_FILTERS_NONE
@@ -1850,7 +1867,7 @@ Errors IndexEntry_addSpecial(IndexHandle      *indexHandle,
                                     SERVER_IO_DEBUG_LEVEL,
                                     SERVER_IO_TIMEOUT,
                                     CALLBACK_(NULL,NULL),  // commandResultFunction
-                                    "INDEX_ADD_SPECIAL uuidId=%"PRIi64" entityId=%"PRIi64" storageId=%"PRIi64" type=SPECIAL name=%'S specialType=%s timeLastAccess=%"PRIu64" timeModified=%"PRIu64" timeLastChanged=%"PRIu64" userId=%u groupId=%u permission=%o major=%u minor=%u",
+                                    "INDEX_ADD_SPECIAL uuidId=%"PRIi64" entityId=%"PRIi64" storageId=%"PRIi64" type=SPECIAL name=%'S specialType=%s timeLastAccess=%"PRIu64" timeModified=%"PRIu64" timeLastChanged=%"PRIu64" userId=%u groupId=%u permission=%o major=%u minor=%u archiveOffset=%"PRIu64,
                                     uuidId,
                                     entityId,
                                     storageId,
@@ -1863,7 +1880,8 @@ Errors IndexEntry_addSpecial(IndexHandle      *indexHandle,
                                     groupId,
                                     permission,
                                     major,
-                                    minor
+                                    minor,
+                                    archiveOffset
                                    );
   }
 
@@ -4872,6 +4890,51 @@ Errors IndexEntry_getInfo(IndexHandle   *indexHandle,
   return ERROR_NONE;
 }
 
+Errors IndexEntry_getArchiveOffset(IndexHandle *indexHandle,
+                                   IndexId     entryId,
+                                   uint64      *archiveOffset
+                                  )
+{
+  Errors error;
+
+  assert(indexHandle != NULL);
+  assert(archiveOffset != NULL);
+
+  (*archiveOffset) = 0LL;
+
+  // check init error
+  if (indexHandle->upgradeError != ERROR_NONE)
+  {
+    return indexHandle->upgradeError;
+  }
+
+  if (indexHandle->masterIO == NULL)
+  {
+    INDEX_DOX(error,
+              indexHandle,
+    {
+      return Database_getUInt64(&indexHandle->databaseHandle,
+                                archiveOffset,
+                                "entries",
+                                "COALESCE(archiveOffset,0)",
+                                "id=?",
+                                DATABASE_FILTERS
+                                (
+                                  DATABASE_FILTER_KEY(INDEX_DATABASE_ID(entryId))
+                                ),
+                                NULL  // group
+                               );
+    });
+  }
+  else
+  {
+    // slave mode: offset unknown
+    error = ERROR_NONE;
+  }
+
+  return error;
+}
+
 Errors IndexEntry_collectIds(Array        *entryIds,
                              IndexHandle  *indexHandle,
                              IndexId      storageId,
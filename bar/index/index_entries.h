@@ -57,6 +57,7 @@
 *          permission      - permission flags
 *          fragmentOffset  - fragment offset [bytes]
 *          fragmentSize    - fragment size [bytes]
+*          archiveOffset   - offset of entry chunks in archive [bytes]
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
@@ -75,7 +76,8 @@ Errors IndexEntry_addFile(IndexHandle *indexHandle,
                           uint32      groupId,
                           uint32      permission,
                           uint64      fragmentOffset,
-                          uint64      fragmentSize
+                          uint64      fragmentSize,
+                          uint64      archiveOffset
                          );
 
 /***********************************************************************\
@@ -91,6 +93,7 @@ Errors IndexEntry_addFile(IndexHandle *indexHandle,
 *          blockSize      - block size [bytes]
 *          blockOffset    - block offset [blocks]
 *          blockCount     - number of blocks
+*          archiveOffset  - offset of entry chunks in archive [bytes]
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
@@ -105,7 +108,8 @@ Errors IndexEntry_addImage(IndexHandle     *indexHandle,
                            int64           size,
                            uint            blockSize,
                            uint64          blockOffset,
-                           uint64          blockCount
+                           uint64          blockCount,
+                           uint64          archiveOffset
                           );
 
 /***********************************************************************\
@@ -122,6 +126,7 @@ Errors IndexEntry_addImage(IndexHandle     *indexHandle,
 *          userId          - user id
 *          groupId         - group id
 *          permission      - permission flags
+*          archiveOffset   - offset of entry chunks in archive [bytes]
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
@@ -137,7 +142,8 @@ Errors IndexEntry_addDirectory(IndexHandle *indexHandle,
                                uint64      timeLastChanged,
                                uint32      userId,
                                uint32      groupId,
-                               uint32      permission
+                               uint32      permission,
+                               uint64      archiveOffset
                               );
 
 /***********************************************************************\
@@ -155,6 +161,7 @@ Errors IndexEntry_addDirectory(IndexHandle *indexHandle,
 *          userId          - user id
 *          groupId         - group id
 *          permission      - permission flags
+*          archiveOffset   - offset of entry chunks in archive [bytes]
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
@@ -171,7 +178,8 @@ Errors IndexEntry_addLink(IndexHandle *indexHandle,
                           uint64      timeLastChanged,
                           uint32      userId,
                           uint32      groupId,
-                          uint32      permission
+                          uint32      permission,
+                          uint64      archiveOffset
                          );
 
 /***********************************************************************\
@@ -191,6 +199,7 @@ Errors IndexEntry_addLink(IndexHandle *indexHandle,
 *          permission      - permission flags
 *          fragmentOffset  - fragment offset [bytes]
 *          fragmentSize    - fragment size [bytes]
+*          archiveOffset   - offset of entry chunks in archive [bytes]
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
@@ -209,7 +218,8 @@ Errors IndexEntry_addHardlink(IndexHandle *indexHandle,
                               uint32      groupId,
                               uint32      permission,
                               uint64      fragmentOffset,
-                              uint64      fragmentSize
+                              uint64      fragmentSize,
+                              uint64      archiveOffset
                              );
 
 /***********************************************************************\
@@ -228,6 +238,7 @@ Errors IndexEntry_addHardlink(IndexHandle *indexHandle,
 *          groupId         - group id
 *          permission      - permission flags
 *          major,minor     - major,minor number
+*          archiveOffset   - offset of entry chunks in archive [bytes]
 * Output : -
 * Return : ERROR_NONE or error code
 * Notes  : -
@@ -246,7 +257,8 @@ Errors IndexEntry_addSpecial(IndexHandle      *indexHandle,
                              uint32           groupId,
                              uint32           permission,
                              uint32           major,
-                             uint32           minor
+                             uint32           minor,
+                             uint64           archiveOffset
                             );
 
 /***********************************************************************\
@@ -828,6 +840,22 @@ Errors IndexEntry_getInfo(IndexHandle   *indexHandle,
                           uint64        *totalEntrySize
                          );
 
+/***********************************************************************\
+* Name   : IndexEntry_getArchiveOffset
+* Purpose: get offset of entry chunks in archive
+* Input  : indexHandle - index handle
+*          entryId     - index id of entry
+* Output : archiveOffset - offset of entry chunks in archive [bytes] or
+*                          0 if unknown
+* Return : ERROR_NONE or error code
+* Notes  : -
+\***********************************************************************/
+
+Errors IndexEntry_getArchiveOffset(IndexHandle *indexHandle,
+                                   IndexId     entryId,
+                                   uint64      *archiveOffset
+                                  );
+
 /***********************************************************************\
 * Name   : IndexEntry_collectIds
 * Purpose: collect entry ids for storage
@@ -6699,6 +6699,7 @@ LOCAL void jobThreadCode(void)
                 jobNode->runningInfo.error = Command_restore(&storageNameList,
                                                              &includeEntryList,
                                                              &excludePatternList,
+                                                             NULL,  // restoreEntryOffsetList
                                                              &jobOptions,
                                                              CALLBACK_(restoreRunningInfo,jobNode),
                                                              CALLBACK_(NULL,NULL),  // restoreErrorHandler
@@ -16535,6 +16536,8 @@ LOCAL void serverCommand_archiveList(ClientInfo *clientInfo, IndexHandle *indexH
                                           fileName,
                                           &fileInfo,
                                           NULL, // fileExtendedAttributeList
+                                          NULL, // fileHoleList
+                                          NULL, // referenceName
                                           deltaSourceName,
                                           &deltaSourceSize,
                                           &fragmentOffset,
@@ -16759,6 +16762,7 @@ LOCAL void serverCommand_archiveList(ClientInfo *clientInfo, IndexHandle *indexH
                                               &fileNameList,
                                               &fileInfo,
                                               NULL,  // fileExtendedAttributeList
+                                              NULL,  // fileHoleList
                                               deltaSourceName,
                                               &deltaSourceSize,
                                               &fragmentOffset,
@@ -16849,6 +16853,7 @@ LOCAL void serverCommand_archiveList(ClientInfo *clientInfo, IndexHandle *indexH
         case ARCHIVE_ENTRY_TYPE_META:
         case ARCHIVE_ENTRY_TYPE_SALT:
         case ARCHIVE_ENTRY_TYPE_KEY:
+        case ARCHIVE_ENTRY_TYPE_SOLID:
         case ARCHIVE_ENTRY_TYPE_SIGNATURE:
           error = Archive_skipNextEntry(&archiveHandle);
           if (error != ERROR_NONE)
@@ -21355,6 +21360,7 @@ LOCAL void serverCommand_restore(ClientInfo *clientInfo, IndexHandle *indexHandl
     String  storageName;
     IndexId entryId;
     String  entryName;
+    uint64  archiveOffset;                 // offset of entry in archive or 0
   } RestoreNode;
 
   typedef struct
@@ -21513,10 +21519,11 @@ LOCAL void serverCommand_restore(ClientInfo *clientInfo, IndexHandle *indexHandl
               {
                 HALT_INSUFFICIENT_MEMORY();
               }
-              restoreNode->jobUUID     = String_duplicate(jobUUID);
-              restoreNode->storageName = String_duplicate(storageName);
-              restoreNode->entryId     = INDEX_ID_NONE;
-              restoreNode->entryName   = NULL;
+              restoreNode->jobUUID       = String_duplicate(jobUUID);
+              restoreNode->storageName   = String_duplicate(storageName);
+              restoreNode->entryId       = INDEX_ID_NONE;
+              restoreNode->entryName     = NULL;
+              restoreNode->archiveOffset = 0LL;
               List_append(&restoreList,restoreNode);
             }
           }
@@ -21537,7 +21544,7 @@ LOCAL void serverCommand_restore(ClientInfo *clientInfo, IndexHandle *indexHandl
                                     INDEX_TYPE_ANY,
                                     NULL, // name
                                     FALSE,  // newestOnly,
-                                    FALSE,  //fragments
+                                    TRUE,  // fragmentsCount
                                     INDEX_ENTRY_SORT_MODE_NONE,
                                     DATABASE_ORDERING_NONE,
                                     0,
@@ -21549,6 +21556,7 @@ LOCAL void serverCommand_restore(ClientInfo *clientInfo, IndexHandle *indexHandl
           IndexId entryId;
           String  storageName = String_new();
           String  entryName   = String_new();
+          uint    fragmentCount;
           while (   !isCommandAborted(clientInfo,id)
                  && !isQuit()
                  && (error == ERROR_NONE)
@@ -21569,13 +21577,22 @@ LOCAL void serverCommand_restore(ClientInfo *clientInfo, IndexHandle *indexHandl
                                        NULL,  // userId
                                        NULL,  // groupId
                                        NULL,  // permission
-                                       NULL,  // fragmentCount
+                                       &fragmentCount,
                                        NULL,  // destinationName
                                        NULL,  // fileSystemType
                                        NULL  // blockSize
                                       )
                 )
           {
+            // get offset of entry in archive (Note: only known for entries stored in a single archive)
+            uint64 archiveOffset;
+            if (   (fragmentCount > 1)
+                || (IndexEntry_getArchiveOffset(indexHandle,entryId,&archiveOffset) != ERROR_NONE)
+               )
+            {
+              archiveOffset = 0LL;
+            }
+
             if (!String_isEmpty(storageName))
             {
               RestoreNode *restoreNode;
@@ -21592,10 +21609,11 @@ LOCAL void serverCommand_restore(ClientInfo *clientInfo, IndexHandle *indexHandl
                 {
                   HALT_INSUFFICIENT_MEMORY();
                 }
-                restoreNode->jobUUID     = String_duplicate(jobUUID);
-                restoreNode->storageName = String_duplicate(storageName);
-                restoreNode->entryId     = entryId;
-                restoreNode->entryName   = String_duplicate(entryName);
+                restoreNode->jobUUID       = String_duplicate(jobUUID);
+                restoreNode->storageName   = String_duplicate(storageName);
+                restoreNode->entryId       = entryId;
+                restoreNode->entryName     = String_duplicate(entryName);
+                restoreNode->archiveOffset = archiveOffset;
                 List_append(&restoreList,restoreNode);
               }
             }
@@ -21639,9 +21657,11 @@ LOCAL void serverCommand_restore(ClientInfo *clientInfo, IndexHandle *indexHandl
                     {
                       HALT_INSUFFICIENT_MEMORY();
                     }
-                    restoreNode->jobUUID     = String_duplicate(jobUUID);
-                    restoreNode->storageName = String_duplicate(storageName);
-                    restoreNode->entryName   = String_duplicate(entryName);
+                    restoreNode->jobUUID       = String_duplicate(jobUUID);
+                    restoreNode->storageName   = String_duplicate(storageName);
+                    restoreNode->entryId       = entryId;
+                    restoreNode->entryName     = String_duplicate(entryName);
+                    restoreNode->archiveOffset = archiveOffset;
                     List_append(&restoreList,restoreNode);
                   }
                 }
@@ -21683,6 +21703,8 @@ LOCAL void serverCommand_restore(ClientInfo *clientInfo, IndexHandle *indexHandl
   EntryList  includeEntryList;
   StringList_init(&storageNameList);
   EntryList_init(&includeEntryList);
+  RestoreEntryOffsetList restoreEntryOffsetList;
+  Command_initRestoreEntryOffsetList(&restoreEntryOffsetList);
   String entryName = String_new();
   while (   !List_isEmpty(&restoreList)
          && (error == ERROR_NONE)
@@ -21693,6 +21715,7 @@ LOCAL void serverCommand_restore(ClientInfo *clientInfo, IndexHandle *indexHandl
     // get storages/entries from job to restore
     StringList_clear(&storageNameList);
     EntryList_clear(&includeEntryList);
+    List_clear(&restoreEntryOffsetList);
     StaticString (jobUUID,MISC_UUID_STRING_LENGTH);
     String_set(jobUUID,LIST_HEAD(&restoreList)->jobUUID);
     while (   !List_isEmpty(&restoreList)
@@ -21717,8 +21740,34 @@ LOCAL void serverCommand_restore(ClientInfo *clientInfo, IndexHandle *indexHandl
           {
             EntryList_append(&includeEntryList,ENTRY_STORE_TYPE_FILE,entryName,PATTERN_TYPE_GLOB,NULL);
           }
+
+          // directory content may be stored in front of directory
+          restoreNode->archiveOffset = 0LL;
         }
       }
+
+      // add offset of entry to restore (0 if unknown: all entries of storage are read)
+      ArchiveEntryTypes archiveEntryType;
+      switch (INDEX_TYPE(restoreNode->entryId))
+      {
+        case INDEX_TYPE_FILE:      archiveEntryType = ARCHIVE_ENTRY_TYPE_FILE;      break;
+        case INDEX_TYPE_IMAGE:     archiveEntryType = ARCHIVE_ENTRY_TYPE_IMAGE;     break;
+        case INDEX_TYPE_DIRECTORY: archiveEntryType = ARCHIVE_ENTRY_TYPE_DIRECTORY; break;
+        case INDEX_TYPE_LINK:      archiveEntryType = ARCHIVE_ENTRY_TYPE_LINK;      break;
+        case INDEX_TYPE_HARDLINK:  archiveEntryType = ARCHIVE_ENTRY_TYPE_HARDLINK;  break;
+        case INDEX_TYPE_SPECIAL:   archiveEntryType = ARCHIVE_ENTRY_TYPE_SPECIAL;   break;
+        default:
+          archiveEntryType           = ARCHIVE_ENTRY_TYPE_NONE;
+          restoreNode->archiveOffset = 0LL;
+          break;
+      }
+      Command_addRestoreEntryOffset(&restoreEntryOffsetList,
+                                    restoreNode->storageName,
+                                    archiveEntryType,
+                                    (restoreNode->entryName != NULL) ? restoreNode->entryName : restoreNode->storageName,
+                                    restoreNode->archiveOffset
+                                   );
+
       deleteRestoreNode(restoreNode);
     }
 
@@ -21756,6 +21805,7 @@ LIST_ITERATE(&includeEntryList,e)
     error = Command_restore(&storageNameList,
                             &includeEntryList,
                             NULL,  // excludePatternList
+                            &restoreEntryOffsetList,
                             &jobOptions,
                             CALLBACK_(restoreRunningInfo,&restoreCommandInfo),
                             CALLBACK_(restoreErrorHandler,&restoreCommandInfo),
@@ -21790,6 +21840,7 @@ LIST_ITERATE(&includeEntryList,e)
     Job_doneOptions(&jobOptions);
   }
   String_delete(entryName);
+  Command_doneRestoreEntryOffsetList(&restoreEntryOffsetList);
   EntryList_done(&includeEntryList);
   StringList_done(&storageNameList);
   Semaphore_done(&restoreCommandInfo.lock);
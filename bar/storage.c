@@ -402,6 +402,7 @@ LOCAL void initBandWidthLimiter(StorageBandWidthLimiter *storageBandWidthLimiter
 
   ulong maxBandWidth = (maxBandWidthList != NULL) ? getBandWidth(maxBandWidthList) : 0L;
 
+  Semaphore_init(&storageBandWidthLimiter->lock,SEMAPHORE_TYPE_BINARY);
   storageBandWidthLimiter->maxBandWidthList     = maxBandWidthList;
   storageBandWidthLimiter->maxBlockSize         = 64*1024;
   storageBandWidthLimiter->blockSize            = 64*1024;
@@ -412,6 +413,7 @@ LOCAL void initBandWidthLimiter(StorageBandWidthLimiter *storageBandWidthLimiter
   storageBandWidthLimiter->measurementCount     = 0;
   storageBandWidthLimiter->measurementNextIndex = 0;
   storageBandWidthLimiter->measurementBytes     = 0L;
+  storageBandWidthLimiter->measurementTimestamp = 0LL;
   storageBandWidthLimiter->measurementTime      = 0LL;
 }
 
@@ -428,7 +430,7 @@ LOCAL void doneBandWidthLimiter(StorageBandWidthLimiter *storageBandWidthLimiter
 {
   assert(storageBandWidthLimiter != NULL);
 
-  UNUSED_VARIABLE(storageBandWidthLimiter);
+  Semaphore_done(&storageBandWidthLimiter->lock);
 }
 
 /***********************************************************************\
@@ -451,8 +453,18 @@ LOCAL void limitBandWidth(StorageBandWidthLimiter *storageBandWidthLimiter,
 
   if (storageBandWidthLimiter->maxBandWidthList != NULL)
   {
+    // lock: transmissions of concurrent storage handles share the limiter
+    Semaphore_lock(&storageBandWidthLimiter->lock,SEMAPHORE_LOCK_TYPE_READ_WRITE,WAIT_FOREVER);
+
+    // accumulate; use elapsed time since start of measurement, because
+    // transmissions may overlap
+    uint64 timestamp = Misc_getTimestamp();
+    if (storageBandWidthLimiter->measurementBytes == 0L)
+    {
+      storageBandWidthLimiter->measurementTimestamp = timestamp-transmissionTime;
+    }
     storageBandWidthLimiter->measurementBytes += transmittedBytes;
-    storageBandWidthLimiter->measurementTime  += transmissionTime;
+    storageBandWidthLimiter->measurementTime  = timestamp-storageBandWidthLimiter->measurementTimestamp;
 //fprintf(stderr,"%s, %d: sum %lu bytes %"PRIu64" us\n",__FILE__,__LINE__,storageBandWidthLimiter->measurementBytes,storageBandWidthLimiter->measurementTime);
 
     // too small sizes/time values are not reliable, thus accumulate
@@ -537,6 +549,9 @@ LOCAL void limitBandWidth(StorageBandWidthLimiter *storageBandWidthLimiter,
       storageBandWidthLimiter->measurementBytes = 0L;
       storageBandWidthLimiter->measurementTime  = 0LL;
     }
+
+    // unlock
+    Semaphore_unlock(&storageBandWidthLimiter->lock);
   }
 }
 #endif /* defined(HAVE_CURL) || defined(HAVE_FTP) || defined(HAVE_SSH2) */
@@ -1372,7 +1387,7 @@ LOCAL Errors transferFileToStorage(FileHandle                  *fileHandle,
     }
 // TODO: remove
 // TODO: replace by storageTransferInfoFunction
-    storageHandle->storageInfo->progress.storageDoneBytes += (uint64)n;
+    (void)atomicIncrement64(&storageHandle->storageInfo->progress.storageDoneBytes,(int)n);
     if (!updateStorageRunningInfo(storageHandle->storageInfo))
     {
       free(buffer);
@@ -222,6 +222,7 @@ typedef enum
 // bandwidth data
 typedef struct
 {
+  Semaphore     lock;                                         // lock for concurrent transmissions
   BandWidthList *maxBandWidthList;                            // list with max. band width [bits/s] to use or NULL
   ulong         maxBlockSize;                                 // max. block size [bytes]
   ulong         blockSize;                                    // current block size [bytes]
@@ -229,7 +230,8 @@ typedef struct
   uint          measurementNextIndex;
   uint          measurementCount;
   ulong         measurementBytes;                             // measurement sum of transmitted bytes
-  uint64        measurementTime;                              // measurement sum of time for transmission [us]
+  uint64        measurementTimestamp;                         // measurement start timestamp [us]
+  uint64        measurementTime;                              // measurement time for transmission [us]
 } StorageBandWidthLimiter;
 
 // storage info
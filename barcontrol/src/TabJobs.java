@@ -2590,7 +2590,9 @@ public class TabJobs
                                                                                                                        "SERPENT256",
                                                                                                                        "CAMELLIA128",
                                                                                                                        "CAMELLIA192",
-                                                                                                                       "CAMELLIA256"
+                                                                                                                       "CAMELLIA256",
+                                                                                                                       "AES128-GCM",
+                                                                                                                       "AES256-GCM"
                                                                                                                       },
                                                                                                           "none"
                                                                                                          );
@@ -5751,7 +5753,9 @@ public class TabJobs
                                                "SERPENT256", "SERPENT256",
                                                "CAMELLIA128","CAMELLIA128",
                                                "CAMELLIA192","CAMELLIA192",
-                                               "CAMELLIA256","CAMELLIA256"
+                                               "CAMELLIA256","CAMELLIA256",
+                                               "AES128-GCM", "AES128-GCM",
+                                               "AES256-GCM", "AES256-GCM"
                                               }
                                  );
             Widgets.layout(widgetCryptAlgorithms[i],0,i,TableLayoutData.W);